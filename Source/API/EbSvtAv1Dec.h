@@ -113,7 +113,9 @@ typedef struct EbSvtAv1DecConfiguration {
     uint32_t threads;
 
     /* Number of frames that can be processed
-       in parallel. Default is 1 */
+       in parallel. Default is 1. Values above 1 are supported only
+       with threads set to 1 and delay the output by one frame, see
+       svt_av1_dec_frame() */
     uint32_t num_p_frames;
 
     // Application Specific parameters
@@ -140,8 +142,32 @@ typedef struct EbSvtAv1DecConfiguration {
  *
  * Default is 0. */
     Bool is_16bit_pipeline;
+
+    /* External frame buffer allocator. When both callbacks are set, the
+     * picture planes of every reference and output frame are allocated with
+     * allocate_frame_buffer() when the frame is started and given back with
+     * release_frame_buffer() once the decoder no longer uses the frame.
+     * frame_buffer_priv is passed to both callbacks.
+     *
+     * Default is NULL, pictures are allocated by the decoder. */
+    EbAllocateFrameBuffer allocate_frame_buffer;
+    EbReleaseFrameBuffer  release_frame_buffer;
+    void                 *frame_buffer_priv;
+
+    /* Zero copy output. svt_av1_dec_get_picture() sets the planes of the
+     * output EbSvtIOFormat to read-only pointers into the decoded picture
+     * instead of copying it, and the picture is held until
+     * svt_av1_dec_release_picture() is called. At most
+     * SVT_AV1_DEC_MAX_HELD_PICTURES pictures can be held at a time.
+     *
+     * Default is 0. */
+    Bool zero_copy_output;
 } EbSvtAv1DecConfiguration;
 
+/* Maximum number of output pictures held by the application in zero copy
+ * output mode */
+#define SVT_AV1_DEC_MAX_HELD_PICTURES 4
+
 /* STEP 1: Call the library to construct a Component Handle.
      *
      * Parameter:
@@ -177,6 +203,10 @@ EB_API EbErrorType svt_av1_dec_init(EbComponentType *svt_dec_component);
      * @ *data                  Buffer with data
      * @ data_size              Data size in bytes
      *
+     *  When num_p_frames is above 1, the picture shown by a call is returned
+     *  by svt_av1_dec_get_picture() after the next call. Calling with
+     *  data_size 0 at the end of the stream flushes the last picture.
+     *
      *  Returns EB_ErrorNone if the coded data has been processed successfully. */
 EB_API EbErrorType svt_av1_dec_frame(EbComponentType *svt_dec_component, const uint8_t *data, const size_t data_size,
                                      uint32_t is_annexb);
@@ -195,10 +225,24 @@ EB_API EbErrorType svt_av1_dec_frame(EbComponentType *svt_dec_component, const u
      *
      *  Returns EB_ErrorNone if the picture has been returned successfully.
      *  Returns EB_DecNoOutputPicture if the next output picture has not
-     *  been generated yet. Calling a decoding function is needed to generate more pictures. */
+     *  been generated yet. Calling a decoding function is needed to generate more pictures.
+     *  Returns EB_ErrorInsufficientResources in zero copy output mode while
+     *  SVT_AV1_DEC_MAX_HELD_PICTURES pictures are held, the picture is then
+     *  returned once one of them is released with svt_av1_dec_release_picture(). */
 EB_API EbErrorType svt_av1_dec_get_picture(EbComponentType *svt_dec_component, EbBufferHeaderType *p_buffer,
                                            EbAV1StreamInfo *stream_info, EbAV1FrameInfo *frame_info);
 
+/* Release a picture returned by svt_av1_dec_get_picture() in zero copy
+     * output mode. Its planes must not be accessed after this call. Must be
+     * called from the thread driving the decoder.
+     *
+     * Parameter:
+     * @ *svt_dec_component     Decoder handle.
+     * @ *p_buffer              Header pointer filled by svt_av1_dec_get_picture().
+     *
+     *  Returns EB_ErrorBadParameter if p_buffer does not hold a picture. */
+EB_API EbErrorType svt_av1_dec_release_picture(EbComponentType *svt_dec_component, EbBufferHeaderType *p_buffer);
+
 /* STEP 6: Deinitialize decoder library.
      *
      * Parameter:
@@ -67,8 +67,10 @@ typedef enum ATTRIBUTE_PACKED {
 #define EB_BUFFERFLAG_SHOW_EXT 0x00000002 // signals that the packet contains a show existing frame at the end
 #define EB_BUFFERFLAG_HAS_TD 0x00000004 // signals that the packet contains a TD
 #define EB_BUFFERFLAG_IS_ALT_REF 0x00000008 // signals that the packet contains an ALT_REF frame
+#define EB_BUFFERFLAG_PARTIAL_FRAME \
+    0x00000010 // signals that the packet holds the leading OBUs of a frame, the rest follows in the next packets
 #define EB_BUFFERFLAG_ERROR_MASK \
-    0xFFFFFFF0 // mask for signalling error assuming top flags fit in 4 bits. To be changed, if more flags are added.
+    0xFFFFFFE0 // mask for signalling error assuming top flags fit in 5 bits. To be changed, if more flags are added.
 
 /*
  * Struct for storing content light level information
@@ -933,9 +935,156 @@ typedef struct EbSvtAv1EncConfiguration {
     /* Stores the optional film grain synthesis info */
     AomFilmGrain *fgs_table;
 
-    uint8_t padding[64 - sizeof(Bool) - sizeof(AomFilmGrain *)];
+    /* Called by the library, from one of its threads, once it no longer reads the
+     * planes of a picture sent in zero copy input mode. p_buffer->p_buffer points to
+     * an EbSvtIOFormat with the plane pointers and strides the picture was sent with,
+     * p_buffer->pts and p_buffer->wrapper_ptr are the values it was sent with. The
+     * callback must not block on, nor call back into, the encoder. */
+    void (*release_input_picture)(void *priv, EbBufferHeaderType *p_buffer);
+    /* Opaque pointer passed back to release_input_picture */
+    void *release_input_picture_priv;
+
+    /* Pipeline trace file
+    *
+    * When set, the library records the time each picture waits for and spends in
+    * every stage of the pipeline, writes them to this file as Chrome trace-event
+    * JSON (chrome://tracing, Perfetto) and logs a per-stage summary once the
+    * encoder is deinitialized. The path is copied by svt_av1_enc_init.
+    *
+    *  Default is NULL (no profiling). */
+    const char *pipeline_trace_file;
+
+    /* Share of the shared thread pool workers given to the instance, relative to the
+    * weights of the other instances. Workers go to the instances with the fewest
+    * running tasks per unit of weight first.
+    *
+    * Min value is 1.
+    * Max value is 64.
+    * Default is 1. */
+    uint32_t thread_pool_weight;
+
+    /* Number of workers of the shared thread pool running at a time, set by the
+    * instance creating the pool and ignored by the instances joining it.
+    *
+    * 0 = number of logical processors of the system
+    *  Default is 0. */
+    uint32_t thread_pool_workers;
+
+    /* Ladder group of the instance. The instances of the process encoding the same
+    * source at several resolutions or bitrates join the same group: the leader runs
+    * the TPL model and the other instances of the group reuse its results, resampled
+    * to their picture size, instead of running their own. The instances of a group
+    * must be sent the same pictures in lockstep, the leader first, and use the same
+    * mini-GOP settings (hierarchical levels, intra period and lookahead).
+    *
+    * 0 = no ladder group
+    *  Default is 0. */
+    uint32_t ladder_group;
+
+    /* Chunk of a chunked two-pass encode
+    *
+    * When rc_stats_buffer holds the first-pass statistics of a whole input split
+    * in chunks encoded by separate instances, the final pass of the instance
+    * encoding rc_stats_chunk_frames frames from frame rc_stats_chunk_start on reads
+    * the statistics of its frames, and gets the share of the bit budget of the
+    * whole input they earned in the first pass. The library keeps a copy of them,
+    * so the instances may share one buffer.
+    *
+    * 0 frames = rc_stats_buffer holds the statistics of the frames encoded
+    *  Default is 0. */
+    uint32_t rc_stats_chunk_start;
+    uint32_t rc_stats_chunk_frames;
+
+    /* Zero copy input
+    *
+    * When enabled, svt_av1_enc_send_picture wraps the planes of the input picture
+    * instead of copying them into the library buffers. Each plane must be surrounded
+    * by a border of SVT_AV1_ENC_INPUT_BORDER luma samples (subsampled for chroma)
+    * that the library fills with padding, and the cb and cr strides must be equal.
+    * The library may write to the planes and the border until the picture is handed
+    * back through release_input_picture. Only supported for 8-bit 4:2:0 input and
+    * not in the first pass of a multi-pass encode.
+    *
+    * 0 = copy the input picture
+    * 1 = wrap the input picture
+    *  Default is 0. */
+    Bool zero_copy_input;
+
+    /* Tile group output
+    *
+    * When enabled, the tile groups of a frame are returned by svt_av1_enc_get_packet
+    * as soon as they are entropy coded, in packets flagged EB_BUFFERFLAG_PARTIAL_FRAME.
+    * The first of them carries the temporal delimiter, the sequence header and the
+    * frame header, each of the others a single tile. The packet without the flag
+    * completes the frame and carries its frame statistics. Frames with a single tile
+    * or going through the super-resolution recode loop are returned whole. Only
+    * supported with the low delay prediction structure and without overlays.
+    *
+    * 0 = return whole frames
+    * 1 = return tile groups as they complete
+    *  Default is 0. */
+    Bool enable_tile_group_output;
+
+    /* Shared thread pool
+    *
+    * When enabled, the parallel stages of the instance (picture analysis, motion
+    * estimation, mode decision, loop filters, entropy coding) run on a worker pool
+    * shared by the instances of the process enabling it, instead of on workers of
+    * their own. The serial stages keep their threads. At most 64 instances share
+    * the pool.
+    *
+    * 0 = workers of the instance
+    * 1 = process-wide worker pool
+    *  Default is 0. */
+    Bool shared_thread_pool;
+
+    /* Instance leading its ladder group, at most one per group.
+    *
+    * 0 = follower
+    * 1 = leader
+    *  Default is 0. */
+    Bool ladder_leader;
+
+    /* Cache domain placement
+    *
+    * When enabled, the workers running the parallel stages are each bound to the
+    * logical processors sharing one L3 cache (e.g. one CCX), read from the Linux
+    * sysfs cache topology, and the stages of a picture preferably run in the same
+    * domain. Without several cache domains, the workers are left as is.
+    *
+    * 0 = workers unbound to cache domains
+    * 1 = workers bound to cache domains
+    *  Default is 0. */
+    Bool cache_domain_placement;
+
+    /* NUMA picture pools
+    *
+    * When enabled on a machine with several NUMA nodes, the picture buffers of the
+    * input, analysis, TPL and reference pools are spread over the nodes the
+    * encoder may run on, each picture preferably getting buffers of the node of
+    * its picture number. Without several nodes, the pools are left as is.
+    *
+    * 0 = pools allocated without node binding
+    * 1 = pools spread over the NUMA nodes
+    *  Default is 0. */
+    Bool numa_picture_pools;
+
+    /* The fields above are ordered pointers, uint32_t, then Bool so that no alignment
+    * hole opens before the padding, which keeps the structure at 560 bytes on 64-bit
+    * targets. 5 bytes of padding are left for new fields. */
+    uint8_t padding[64 - 7 * sizeof(Bool) - 5 * sizeof(uint32_t) - sizeof(AomFilmGrain *) -
+                    sizeof(void (*)(void *, EbBufferHeaderType *)) - sizeof(void *) - sizeof(const char *)];
 } EbSvtAv1EncConfiguration;
 
+/* Compile-time check that EbSvtAv1EncConfiguration keeps its size of 560 bytes on
+ * 64-bit targets: new fields must be taken from the padding */
+typedef char
+    svt_av1_enc_configuration_size_check[(sizeof(void *) != 8 || sizeof(EbSvtAv1EncConfiguration) == 560) ? 1 : -1];
+
+/* Border, in luma samples, required around each plane of an input picture sent
+ * in zero copy input mode */
+#define SVT_AV1_ENC_INPUT_BORDER 144
+
 /**
  * Returns a string containing "v$tag-$commit_count-g$hash${dirty:+-dirty}"
  * @param[out] SVT_AV1_CVS_VERSION
@@ -241,6 +241,17 @@ int32_t main(int32_t argc, char *argv[]) {
                 } else
                     break;
             }
+            /* Frame parallel decoding holds back the last picture */
+            if (config_ptr->num_p_frames > 1) {
+                return_error |= svt_av1_dec_frame(p_handle, NULL, 0, obu_ctx.is_annexb);
+                if (svt_av1_dec_get_picture(p_handle, recon_buffer, stream_info, frame_info) !=
+                    EB_DecNoOutputPicture) {
+                    if (enable_md5)
+                        write_md5(recon_buffer, &md5_ctx);
+                    if (cli.out_file != NULL)
+                        write_frame(recon_buffer, &cli);
+                }
+            }
             if (fps_summary || fps_frm) {
                 assert(dx_time > 0);
                 show_progress(in_frame, dx_time);
@@ -60,8 +60,8 @@ static void set_num_thread(const char *value, EbSvtAv1DecConfiguration *cfg) {
 };
 static void set_num_pframes(const char *value, EbSvtAv1DecConfiguration *cfg) {
     cfg->num_p_frames = strtoul(value, NULL, 0);
-    if (cfg->num_p_frames != 1) {
-        fprintf(stderr, "Warning : Multi frame parallelism not supported. Setting parallel frames to 1. \n");
+    if (cfg->num_p_frames < 1) {
+        fprintf(stderr, "Warning : Invalid number of parallel frames. Setting parallel frames to 1. \n");
         cfg->num_p_frames = 1;
     }
 };
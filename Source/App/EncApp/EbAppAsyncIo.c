@@ -0,0 +1,365 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+/***************************************
+ * Includes
+ ***************************************/
+#include <stdlib.h>
+#include <string.h>
+
+#include "EbAppAsyncIo.h"
+#include "EbTime.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+typedef CRITICAL_SECTION   AppMutex;
+typedef CONDITION_VARIABLE AppCond;
+typedef HANDLE             AppThread;
+#else
+#include <pthread.h>
+typedef pthread_mutex_t AppMutex;
+typedef pthread_cond_t  AppCond;
+typedef pthread_t       AppThread;
+#endif
+
+/***************************************
+ * Threads
+ ***************************************/
+#ifdef _WIN32
+static void app_mutex_init(AppMutex *mutex) { InitializeCriticalSection(mutex); }
+static void app_mutex_destroy(AppMutex *mutex) { DeleteCriticalSection(mutex); }
+static void app_mutex_lock(AppMutex *mutex) { EnterCriticalSection(mutex); }
+static void app_mutex_unlock(AppMutex *mutex) { LeaveCriticalSection(mutex); }
+static void app_cond_init(AppCond *cond) { InitializeConditionVariable(cond); }
+static void app_cond_destroy(AppCond *cond) { (void)cond; }
+static void app_cond_wait(AppCond *cond, AppMutex *mutex) { SleepConditionVariableCS(cond, mutex, INFINITE); }
+static void app_cond_broadcast(AppCond *cond) { WakeAllConditionVariable(cond); }
+static Bool app_thread_create(AppThread *thread, DWORD(WINAPI *function)(void *), void *context) {
+    *thread = CreateThread(NULL, 0, function, context, 0, NULL);
+    return *thread != NULL;
+}
+static void app_thread_join(AppThread thread) {
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+}
+#define APP_THREAD_FUNCTION(name) static DWORD WINAPI name(void *context)
+#define APP_THREAD_RETURN return 0
+#else
+static void app_mutex_init(AppMutex *mutex) { pthread_mutex_init(mutex, NULL); }
+static void app_mutex_destroy(AppMutex *mutex) { pthread_mutex_destroy(mutex); }
+static void app_mutex_lock(AppMutex *mutex) { pthread_mutex_lock(mutex); }
+static void app_mutex_unlock(AppMutex *mutex) { pthread_mutex_unlock(mutex); }
+static void app_cond_init(AppCond *cond) { pthread_cond_init(cond, NULL); }
+static void app_cond_destroy(AppCond *cond) { pthread_cond_destroy(cond); }
+static void app_cond_wait(AppCond *cond, AppMutex *mutex) { pthread_cond_wait(cond, mutex); }
+static void app_cond_broadcast(AppCond *cond) { pthread_cond_broadcast(cond); }
+static Bool app_thread_create(AppThread *thread, void *(*function)(void *), void *context) {
+    return pthread_create(thread, NULL, function, context) == 0;
+}
+static void app_thread_join(AppThread thread) { pthread_join(thread, NULL); }
+#define APP_THREAD_FUNCTION(name) static void *name(void *context)
+#define APP_THREAD_RETURN return NULL
+#endif
+
+double app_io_time(void) {
+    uint64_t seconds, useconds;
+    app_svt_av1_get_time(&seconds, &useconds);
+    return (double)seconds + (double)useconds / 1000000;
+}
+
+/***************************************
+ * Reader
+ ***************************************/
+typedef struct AppReadSlot {
+    EbBufferHeaderType header;
+    EbSvtIOFormat      io;
+} AppReadSlot;
+
+struct AppAsyncReader {
+    EbConfig    *app_cfg;
+    AppReadFrame read_frame;
+    AppReadSlot *slot_array;
+    uint8_t     *frame_buffer;
+    uint32_t     depth;
+    // Slots filled, from the head slot on, the next one handed to the encoder
+    uint32_t head;
+    uint32_t count;
+    // Frames left to read
+    uint64_t frame_count;
+    Bool     first_frame;
+    // Set once the reader thread is done, quit once asked to be
+    Bool end;
+    Bool quit;
+    // Handed out once the reader is done
+    EbBufferHeaderType end_header;
+    double             read_time;
+    AppMutex           mutex;
+    AppCond            cond;
+    AppThread          thread;
+};
+
+APP_THREAD_FUNCTION(app_reader_thread) {
+    AppAsyncReader *reader   = (AppAsyncReader *)context;
+    const uint8_t   is_16bit = (uint8_t)(reader->app_cfg->config.encoder_bit_depth > 8);
+
+    app_mutex_lock(&reader->mutex);
+    while (reader->frame_count) {
+        while (!reader->quit && reader->count == reader->depth) app_cond_wait(&reader->cond, &reader->mutex);
+        if (reader->quit)
+            break;
+        AppReadSlot *slot = &reader->slot_array[(reader->head + reader->count) % reader->depth];
+        app_mutex_unlock(&reader->mutex);
+
+        // The slot is not handed out until counted
+        const double start_time = app_io_time();
+        const Bool   eof = reader->read_frame(reader->app_cfg, is_16bit, &slot->header, reader->first_frame);
+        reader->read_time += app_io_time() - start_time;
+        reader->first_frame = FALSE;
+
+        app_mutex_lock(&reader->mutex);
+        if (!slot->header.n_filled_len)
+            break;
+        ++reader->count;
+        --reader->frame_count;
+        app_cond_broadcast(&reader->cond);
+        if (eof)
+            break;
+    }
+    reader->end = TRUE;
+    app_cond_broadcast(&reader->cond);
+    app_mutex_unlock(&reader->mutex);
+    APP_THREAD_RETURN;
+}
+
+AppAsyncReader *app_async_reader_start(EbConfig *app_cfg, uint32_t depth, AppReadFrame read_frame,
+                                       uint64_t frame_count) {
+    const uint8_t  color_format  = app_cfg->config.encoder_color_format;
+    const uint8_t  subsampling_x = (color_format == EB_YUV444 ? 1 : 2) - 1;
+    const size_t   luma_size     = ((size_t)app_cfg->input_padded_width * app_cfg->input_padded_height)
+        << (app_cfg->config.encoder_bit_depth > 8);
+    const size_t   chroma_size   = luma_size >> (3 - color_format);
+    const size_t   frame_size    = luma_size + 2 * chroma_size;
+    AppAsyncReader *reader       = (AppAsyncReader *)calloc(1, sizeof(*reader));
+
+    if (!reader)
+        return NULL;
+    reader->slot_array   = (AppReadSlot *)calloc(depth, sizeof(*reader->slot_array));
+    reader->frame_buffer = (uint8_t *)malloc(frame_size * depth);
+    if (!reader->slot_array || !reader->frame_buffer) {
+        free(reader->slot_array);
+        free(reader->frame_buffer);
+        free(reader);
+        return NULL;
+    }
+    for (uint32_t slot_index = 0; slot_index < depth; ++slot_index) {
+        AppReadSlot *slot         = &reader->slot_array[slot_index];
+        uint8_t     *base         = reader->frame_buffer + frame_size * slot_index;
+        slot->io.luma             = base;
+        slot->io.cb               = base + luma_size;
+        slot->io.cr               = base + luma_size + chroma_size;
+        slot->io.y_stride         = app_cfg->input_padded_width;
+        slot->io.cb_stride        = app_cfg->input_padded_width >> subsampling_x;
+        slot->io.cr_stride        = app_cfg->input_padded_width >> subsampling_x;
+        slot->header.size         = sizeof(slot->header);
+        slot->header.p_buffer     = (uint8_t *)&slot->io;
+        slot->header.n_alloc_len  = (uint32_t)frame_size;
+        slot->header.pic_type     = EB_AV1_INVALID_PICTURE;
+    }
+    reader->end_header.size     = sizeof(reader->end_header);
+    reader->end_header.pic_type = EB_AV1_INVALID_PICTURE;
+    reader->app_cfg             = app_cfg;
+    reader->read_frame          = read_frame;
+    reader->depth               = depth;
+    reader->frame_count         = frame_count;
+    reader->first_frame         = app_cfg->processed_frame_count == 0;
+    app_mutex_init(&reader->mutex);
+    app_cond_init(&reader->cond);
+    if (!app_thread_create(&reader->thread, app_reader_thread, reader)) {
+        app_cond_destroy(&reader->cond);
+        app_mutex_destroy(&reader->mutex);
+        free(reader->slot_array);
+        free(reader->frame_buffer);
+        free(reader);
+        return NULL;
+    }
+    return reader;
+}
+
+EbBufferHeaderType *app_async_reader_get(AppAsyncReader *reader, double *wait_time) {
+    EbBufferHeaderType *header_ptr;
+    const double        start_time = app_io_time();
+
+    app_mutex_lock(&reader->mutex);
+    while (!reader->count && !reader->end) app_cond_wait(&reader->cond, &reader->mutex);
+    header_ptr = reader->count ? &reader->slot_array[reader->head].header : &reader->end_header;
+    app_mutex_unlock(&reader->mutex);
+    *wait_time += app_io_time() - start_time;
+    return header_ptr;
+}
+
+void app_async_reader_release(AppAsyncReader *reader) {
+    app_mutex_lock(&reader->mutex);
+    reader->head = (reader->head + 1) % reader->depth;
+    --reader->count;
+    app_cond_broadcast(&reader->cond);
+    app_mutex_unlock(&reader->mutex);
+}
+
+static void app_async_reader_stop(AppAsyncReader *reader, double *read_time) {
+    app_mutex_lock(&reader->mutex);
+    reader->quit = TRUE;
+    app_cond_broadcast(&reader->cond);
+    app_mutex_unlock(&reader->mutex);
+    app_thread_join(reader->thread);
+    *read_time += reader->read_time;
+    app_cond_destroy(&reader->cond);
+    app_mutex_destroy(&reader->mutex);
+    free(reader->slot_array);
+    free(reader->frame_buffer);
+    free(reader);
+}
+
+/***************************************
+ * Writer
+ ***************************************/
+typedef struct AppWriteItem {
+    FILE    *file;
+    int64_t  offset;
+    uint8_t *data;
+    size_t   size;
+} AppWriteItem;
+
+struct AppAsyncWriter {
+    AppWriteItem *item_array;
+    uint32_t      depth;
+    // Writes queued, from the head item on
+    uint32_t  head;
+    uint32_t  count;
+    Bool      quit;
+    Bool      failed;
+    double    write_time;
+    AppMutex  mutex;
+    AppCond   cond;
+    AppThread thread;
+};
+
+static Bool app_write(FILE *file, int64_t offset, const void *data, size_t size) {
+    if (offset >= 0 && fseeko(file, offset, SEEK_SET) != 0)
+        return FALSE;
+    return fwrite(data, 1, size, file) == size;
+}
+
+APP_THREAD_FUNCTION(app_writer_thread) {
+    AppAsyncWriter *writer = (AppAsyncWriter *)context;
+
+    app_mutex_lock(&writer->mutex);
+    for (;;) {
+        while (!writer->quit && !writer->count) app_cond_wait(&writer->cond, &writer->mutex);
+        // The queued writes are done before quitting
+        if (!writer->count)
+            break;
+        const AppWriteItem item = writer->item_array[writer->head];
+        app_mutex_unlock(&writer->mutex);
+
+        const double start_time = app_io_time();
+        const Bool   written    = app_write(item.file, item.offset, item.data, item.size);
+        writer->write_time += app_io_time() - start_time;
+        free(item.data);
+
+        app_mutex_lock(&writer->mutex);
+        writer->failed |= !written;
+        writer->head = (writer->head + 1) % writer->depth;
+        --writer->count;
+        app_cond_broadcast(&writer->cond);
+    }
+    app_mutex_unlock(&writer->mutex);
+    APP_THREAD_RETURN;
+}
+
+AppAsyncWriter *app_async_writer_start(uint32_t depth) {
+    AppAsyncWriter *writer = (AppAsyncWriter *)calloc(1, sizeof(*writer));
+
+    if (!writer)
+        return NULL;
+    writer->item_array = (AppWriteItem *)calloc(depth, sizeof(*writer->item_array));
+    if (!writer->item_array) {
+        free(writer);
+        return NULL;
+    }
+    writer->depth = depth;
+    app_mutex_init(&writer->mutex);
+    app_cond_init(&writer->cond);
+    if (!app_thread_create(&writer->thread, app_writer_thread, writer)) {
+        app_cond_destroy(&writer->cond);
+        app_mutex_destroy(&writer->mutex);
+        free(writer->item_array);
+        free(writer);
+        return NULL;
+    }
+    return writer;
+}
+
+void app_output_write(EbConfig *app_cfg, FILE *file, int64_t offset, const void *data, size_t size) {
+    AppAsyncWriter       *writer      = app_cfg->async_writer;
+    EbPerformanceContext *perf        = &app_cfg->performance_context;
+    const double          start_time = app_io_time();
+
+    if (!writer) {
+        // The encoder is not fed while writing
+        app_write(file, offset, data, size);
+        const double write_time = app_io_time() - start_time;
+        perf->output_write_time += write_time;
+        perf->output_wait_time += write_time;
+        return;
+    }
+    uint8_t *copy = (uint8_t *)malloc(size ? size : 1);
+    app_mutex_lock(&writer->mutex);
+    if (!copy)
+        writer->failed = TRUE;
+    else {
+        memcpy(copy, data, size);
+        while (writer->count == writer->depth) app_cond_wait(&writer->cond, &writer->mutex);
+        writer->item_array[(writer->head + writer->count) % writer->depth] = (AppWriteItem){file, offset, copy, size};
+        ++writer->count;
+        app_cond_broadcast(&writer->cond);
+    }
+    app_mutex_unlock(&writer->mutex);
+    perf->output_wait_time += app_io_time() - start_time;
+}
+
+static Bool app_async_writer_stop(AppAsyncWriter *writer, double *write_time) {
+    app_mutex_lock(&writer->mutex);
+    writer->quit = TRUE;
+    app_cond_broadcast(&writer->cond);
+    app_mutex_unlock(&writer->mutex);
+    app_thread_join(writer->thread);
+    const Bool written = !writer->failed;
+    *write_time += writer->write_time;
+    app_cond_destroy(&writer->cond);
+    app_mutex_destroy(&writer->mutex);
+    free(writer->item_array);
+    free(writer);
+    return written;
+}
+
+Bool app_async_io_stop(EbConfig *app_cfg) {
+    Bool written = TRUE;
+    if (app_cfg->async_reader) {
+        app_async_reader_stop(app_cfg->async_reader, &app_cfg->performance_context.input_read_time);
+        app_cfg->async_reader = NULL;
+    }
+    if (app_cfg->async_writer) {
+        written = app_async_writer_stop(app_cfg->async_writer, &app_cfg->performance_context.output_write_time);
+        app_cfg->async_writer = NULL;
+    }
+    return written;
+}
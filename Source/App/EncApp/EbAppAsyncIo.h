@@ -0,0 +1,55 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbAppAsyncIo_h
+#define EbAppAsyncIo_h
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "EbAppConfig.h"
+
+/* Asynchronous I/O (--async-io n)
+ * A reader thread per channel reads up to n input frames ahead of the
+ * encoder, and a writer thread writes the IVF stream and the recon frames
+ * behind it, so the thread feeding the encoder does not wait on fread and
+ * fwrite, e.g. with a pipe or a network file system. */
+
+// Reads one frame, returns TRUE once the end of a pipe was reached
+typedef Bool (*AppReadFrame)(EbConfig *app_cfg, uint8_t is_16bit, EbBufferHeaderType *header_ptr, Bool first_frame);
+
+typedef struct AppAsyncReader AppAsyncReader;
+typedef struct AppAsyncWriter AppAsyncWriter;
+
+/* Starts the reader thread reading up to frame_count frames with read_frame,
+ * UINT64_MAX for frames until the end of a pipe */
+AppAsyncReader *app_async_reader_start(EbConfig *app_cfg, uint32_t depth, AppReadFrame read_frame,
+                                       uint64_t frame_count);
+/* Waits for the next frame read. The frame returned is empty once the reader
+ * is done, else it is kept by the caller until app_async_reader_release() */
+EbBufferHeaderType *app_async_reader_get(AppAsyncReader *reader, double *wait_time);
+void                app_async_reader_release(AppAsyncReader *reader);
+
+AppAsyncWriter *app_async_writer_start(uint32_t depth);
+
+/* Writes size bytes of data to file at offset, or after the previous write
+ * when offset is negative: queued to the writer thread of the channel if any,
+ * written right away otherwise. The writer thread works on a copy. */
+void app_output_write(EbConfig *app_cfg, FILE *file, int64_t offset, const void *data, size_t size);
+
+/* Stops the reader and writer threads of a channel once the pending writes are
+ * done, adding their read and write times to the performance context.
+ * Returns FALSE when a write failed. */
+Bool app_async_io_stop(EbConfig *app_cfg);
+
+double app_io_time(void);
+
+#endif // EbAppAsyncIo_h
@@ -40,6 +40,7 @@
 #define HELP_TOKEN "--help"
 #define VERSION_TOKEN "--version"
 #define CHANNEL_NUMBER_TOKEN "--nch"
+#define CHUNKS_TOKEN "--chunks"
 #define COMMAND_LINE_MAX_SIZE 2048
 #define CONFIG_FILE_TOKEN "-c"
 #define CONFIG_FILE_LONG_TOKEN "--config"
@@ -53,10 +54,12 @@
 #define TWO_PASS_STATS_TOKEN "--stats"
 #define PASSES_TOKEN "--passes"
 #define STAT_FILE_TOKEN "--stat-file"
+#define PIPELINE_TRACE_TOKEN "--pipeline-trace"
 #define WIDTH_TOKEN "-w"
 #define HEIGHT_TOKEN "-h"
 #define NUMBER_OF_PICTURES_TOKEN "-n"
 #define BUFFERED_INPUT_TOKEN "--nb"
+#define ASYNC_IO_TOKEN "--async-io"
 #define NO_PROGRESS_TOKEN "--no-progress" // tbd if it should be removed
 #define PROGRESS_TOKEN "--progress"
 #define QP_TOKEN "-q"
@@ -134,6 +137,7 @@
 #define ENABLE_TPL_LA_TOKEN "--enable-tpl-la"
 #define TILE_ROW_TOKEN "--tile-rows"
 #define TILE_COL_TOKEN "--tile-columns"
+#define TILE_GROUP_OUTPUT_TOKEN "--tile-group-output"
 
 #define SCENE_CHANGE_DETECTION_TOKEN "--scd"
 #define INJECTOR_TOKEN "--inj" // no Eval
@@ -142,6 +146,13 @@
 #define THREAD_MGMNT "--lp"
 #define PIN_TOKEN "--pin"
 #define TARGET_SOCKET "--ss"
+#define SHARED_THREAD_POOL_TOKEN "--shared-thread-pool"
+#define THREAD_POOL_WEIGHT_TOKEN "--thread-pool-weight"
+#define THREAD_POOL_WORKERS_TOKEN "--thread-pool-workers"
+#define LADDER_GROUP_TOKEN "--ladder-group"
+#define LADDER_LEADER_TOKEN "--ladder-leader"
+#define CACHE_DOMAIN_PLACEMENT_TOKEN "--cache-domain-placement"
+#define NUMA_PICTURE_POOLS_TOKEN "--numa-picture-pools"
 #define RESTRICTED_MOTION_VECTOR "--rmv"
 
 //double dash
@@ -401,6 +412,10 @@ static EbErrorType set_two_pass_stats(EbConfig *cfg, const char *token, const ch
     return str_to_str(value, (char **)&cfg->stats, token);
 }
 
+static EbErrorType set_cfg_pipeline_trace(EbConfig *cfg, const char *token, const char *value) {
+    return str_to_str(value, (char **)&cfg->config.pipeline_trace_file, token);
+}
+
 static EbErrorType set_passes(EbConfig *cfg, const char *token, const char *value) {
     (void)cfg;
     (void)token;
@@ -421,6 +436,9 @@ static EbErrorType set_cfg_frames_to_be_skipped(EbConfig *cfg, const char *token
 static EbErrorType set_buffered_input(EbConfig *cfg, const char *token, const char *value) {
     return str_to_int(token, value, &cfg->buffered_input);
 }
+static EbErrorType set_async_io(EbConfig *cfg, const char *token, const char *value) {
+    return str_to_int(token, value, &cfg->async_io);
+}
 static EbErrorType set_cfg_force_key_frames(EbConfig *cfg, const char *token, const char *value) {
     (void)token;
     struct forced_key_frames fkf;
@@ -639,6 +657,10 @@ ConfigEntry config_entry_options[] = {
      STAT_FILE_TOKEN,
      "PSNR / SSIM per picture stat output file path, requires `--enable-stat-report 1`",
      set_cfg_stat_file},
+    {SINGLE_INPUT,
+     PIPELINE_TRACE_TOKEN,
+     "Per-stage pipeline timings output file path (Chrome trace-event JSON), a summary is printed at the end",
+     set_cfg_pipeline_trace},
 
     {SINGLE_INPUT,
      PROGRESS_TOKEN,
@@ -714,6 +736,11 @@ ConfigEntry config_entry_global_options[] = {
      "Buffer `n` input frames into memory and use them to encode, default is -1 [-1: no frames "
      "buffered, 1-`(2^31)-1`]",
      set_buffered_input},
+    {SINGLE_INPUT,
+     ASYNC_IO_TOKEN,
+     "Read up to `n` input frames ahead of the encoder and write the output behind it on their own "
+     "threads, default is 0 [0: off, 1-256]",
+     set_async_io},
     {SINGLE_INPUT,
      ENCODER_COLOR_FORMAT,
      "Color format, only yuv420 is supported at this time, default is 1 [0: yuv400, 1: yuv420, 2: "
@@ -785,6 +812,39 @@ ConfigEntry config_entry_global_options[] = {
      "Specifies which socket to run on, assumes a max of two sockets. Refer to Appendix A.1 of the "
      "user guide, default is -1 [-1, 0, -1]",
      set_cfg_generic_token},
+    {SINGLE_INPUT,
+     SHARED_THREAD_POOL_TOKEN,
+     "Run the parallel stages on a worker pool shared by the channels of the process, default is 0 [0-1]",
+     set_cfg_generic_token},
+    {SINGLE_INPUT,
+     THREAD_POOL_WEIGHT_TOKEN,
+     "Share of the shared thread pool workers, relative to the other channels, default is 1 [1-64]",
+     set_cfg_generic_token},
+    {SINGLE_INPUT,
+     THREAD_POOL_WORKERS_TOKEN,
+     "Number of workers of the shared thread pool, set by the first channel. 0 means the number of logical "
+     "processors, default is 0 [0, core count of the machine]",
+     set_cfg_generic_token},
+    {SINGLE_INPUT,
+     LADDER_GROUP_TOKEN,
+     "Ladder group of the channel, the channels of a group reuse the TPL model of the group leader. 0 means "
+     "no group, default is 0 [0-2^32-1]",
+     set_cfg_generic_token},
+    {SINGLE_INPUT,
+     LADDER_LEADER_TOKEN,
+     "Channel leading its ladder group, sent the pictures before the other channels of the group, default is 0 "
+     "[0-1]",
+     set_cfg_generic_token},
+    {SINGLE_INPUT,
+     CACHE_DOMAIN_PLACEMENT_TOKEN,
+     "Bind the workers of the parallel stages to L3 cache domains and run the stages of a picture in one "
+     "domain, default is 0 [0-1]",
+     set_cfg_generic_token},
+    {SINGLE_INPUT,
+     NUMA_PICTURE_POOLS_TOKEN,
+     "Spread the picture buffer pools over the NUMA nodes, a picture getting buffers of its node, default is 0 "
+     "[0-1]",
+     set_cfg_generic_token},
     // Termination
     {SINGLE_INPUT, NULL, NULL, NULL}};
 
@@ -1004,6 +1064,10 @@ ConfigEntry config_entry_specific[] = {
      "Number of tile columns to use, `TileCol == log2(x)`, default changes per resolution but is 1 "
      "[0-4]",
      set_cfg_generic_token},
+    {SINGLE_INPUT,
+     TILE_GROUP_OUTPUT_TOKEN,
+     "Output the tile groups of a frame as soon as they are coded, low delay only, default is 0 [0-1]",
+     set_cfg_generic_token},
 
     // DLF
     {SINGLE_INPUT, LOOP_FILTER_ENABLE, "Deblocking loop filter control, default is 1 [0-1]", set_cfg_generic_token},
@@ -1184,6 +1248,7 @@ ConfigEntry config_entry[] = {
     {SINGLE_INPUT, OUTPUT_RECON_TOKEN, "ReconFile", set_cfg_recon_file},
     {SINGLE_INPUT, OUTPUT_RECON_LONG_TOKEN, "ReconFile", set_cfg_recon_file},
     {SINGLE_INPUT, STAT_FILE_TOKEN, "StatFile", set_cfg_stat_file},
+    {SINGLE_INPUT, PIPELINE_TRACE_TOKEN, "PipelineTrace", set_cfg_pipeline_trace},
     {SINGLE_INPUT, PROGRESS_TOKEN, "Progress", set_progress},
     {SINGLE_INPUT, NO_PROGRESS_TOKEN, "NoProgress", set_no_progress},
     {SINGLE_INPUT, PRESET_TOKEN, "EncoderMode", set_cfg_generic_token},
@@ -1201,6 +1266,7 @@ ConfigEntry config_entry[] = {
     {SINGLE_INPUT, NUMBER_OF_PICTURES_TOKEN, "FrameToBeEncoded", set_cfg_frames_to_be_encoded},
     {SINGLE_INPUT, NUMBER_OF_PICTURES_LONG_TOKEN, "FrameToBeEncoded", set_cfg_frames_to_be_encoded},
     {SINGLE_INPUT, BUFFERED_INPUT_TOKEN, "BufferedInput", set_buffered_input},
+    {SINGLE_INPUT, ASYNC_IO_TOKEN, "AsyncIo", set_async_io},
 
     {SINGLE_INPUT, NUMBER_OF_PICTURES_TO_SKIP, "FrameToBeSkipped", set_cfg_frames_to_be_skipped},
 
@@ -1232,6 +1298,13 @@ ConfigEntry config_entry[] = {
     {SINGLE_INPUT, THREAD_MGMNT, "LogicalProcessors", set_cfg_generic_token},
     {SINGLE_INPUT, PIN_TOKEN, "PinnedExecution", set_cfg_generic_token},
     {SINGLE_INPUT, TARGET_SOCKET, "TargetSocket", set_cfg_generic_token},
+    {SINGLE_INPUT, SHARED_THREAD_POOL_TOKEN, "SharedThreadPool", set_cfg_generic_token},
+    {SINGLE_INPUT, THREAD_POOL_WEIGHT_TOKEN, "ThreadPoolWeight", set_cfg_generic_token},
+    {SINGLE_INPUT, THREAD_POOL_WORKERS_TOKEN, "ThreadPoolWorkers", set_cfg_generic_token},
+    {SINGLE_INPUT, LADDER_GROUP_TOKEN, "LadderGroup", set_cfg_generic_token},
+    {SINGLE_INPUT, LADDER_LEADER_TOKEN, "LadderLeader", set_cfg_generic_token},
+    {SINGLE_INPUT, CACHE_DOMAIN_PLACEMENT_TOKEN, "CacheDomainPlacement", set_cfg_generic_token},
+    {SINGLE_INPUT, NUMA_PICTURE_POOLS_TOKEN, "NumaPicturePools", set_cfg_generic_token},
 
     // Rate Control Options
     {SINGLE_INPUT, RATE_CONTROL_ENABLE_TOKEN, "RateControlMode", set_cfg_generic_token},
@@ -1296,6 +1369,7 @@ ConfigEntry config_entry[] = {
     // AV1 Specific Options
     {SINGLE_INPUT, TILE_ROW_TOKEN, "TileRow", set_cfg_generic_token},
     {SINGLE_INPUT, TILE_COL_TOKEN, "TileCol", set_cfg_generic_token},
+    {SINGLE_INPUT, TILE_GROUP_OUTPUT_TOKEN, "TileGroupOutput", set_cfg_generic_token},
     {SINGLE_INPUT, LOOP_FILTER_ENABLE, "LoopFilterEnable", set_cfg_generic_token},
     {SINGLE_INPUT, CDEF_ENABLE_TOKEN, "CDEFLevel", set_cdef_enable},
     {SINGLE_INPUT, ENABLE_RESTORATION_TOKEN, "EnableRestoration", set_cfg_generic_token},
@@ -1428,6 +1502,8 @@ void svt_config_dtor(EbConfig *app_cfg) {
     free(app_cfg->forced_keyframes.frames);
 
     free((void *)app_cfg->stats);
+    free((void *)app_cfg->config.pipeline_trace_file);
+    free(app_cfg->partial_frame_buffer);
     free(app_cfg);
     return;
 }
@@ -1741,6 +1817,13 @@ static EbErrorType app_verify_config(EbConfig *app_cfg, uint32_t channel_number)
         return_error = EB_ErrorBadParameter;
     }
 
+    if (app_cfg->async_io < 0 || app_cfg->async_io > 256) {
+        fprintf(app_cfg->error_log_file,
+                "Error instance %u: Invalid async_io. async_io must be between 0 and 256\n",
+                channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
     if (app_cfg->config.use_qp_file == TRUE && app_cfg->qp_file == NULL) {
         fprintf(app_cfg->error_log_file,
                 "Error instance %u: Could not find QP file, UseQpFile is set to 1\n",
@@ -2003,6 +2086,20 @@ uint32_t get_number_of_channels(int32_t argc, char *const argv[]) {
     return 1;
 }
 
+uint32_t get_number_of_chunks(int32_t argc, char *const argv[]) {
+    char config_string[COMMAND_LINE_MAX_SIZE];
+    if (find_token(argc, argv, CHUNKS_TOKEN, config_string) == 0) {
+        uint32_t chunk_count = strtol(config_string, NULL, 0);
+        if ((chunk_count > MAX_CHANNEL_NUMBER) || chunk_count == 0) {
+            fprintf(
+                stderr, "[SVT-Error]: The number of chunks has to be within the range [1,%u]\n", MAX_CHANNEL_NUMBER);
+            return 0;
+        }
+        return chunk_count;
+    }
+    return 1;
+}
+
 static Bool check_two_pass_conflicts(int32_t argc, char *const argv[]) {
     char        config_string[COMMAND_LINE_MAX_SIZE];
     const char *conflicts[] = {
@@ -2416,8 +2513,9 @@ EbErrorType read_command_line(int32_t argc, char *const argv[], EncChannel *chan
         }
     }
 
-    // First handle --nch and --passes as a single argument options
+    // First handle --nch, --chunks and --passes as a single argument options
     find_token_multiple_inputs(1, argc, argv, CHANNEL_NUMBER_TOKEN, config_strings, cmd_copy, arg_copy);
+    find_token_multiple_inputs(1, argc, argv, CHUNKS_TOKEN, config_strings, cmd_copy, arg_copy);
     find_token_multiple_inputs(1, argc, argv, PASSES_TOKEN, config_strings, cmd_copy, arg_copy);
 
     /***************************************************************************************************/
@@ -90,6 +90,12 @@ typedef struct EbPerformanceContext {
 
     uint64_t sum_qp;
 
+    // Seconds spent reading the input and writing the output, and seconds the
+    // thread feeding the encoder waited on them
+    double input_read_time;
+    double input_wait_time;
+    double output_write_time;
+    double output_wait_time;
 } EbPerformanceContext;
 
 typedef struct MemMapFile {
@@ -162,6 +168,21 @@ typedef struct EbConfig {
 
     uint64_t ivf_count;
 
+    // Chunk of a chunked encode (--chunks): index, number of chunks and first frame in the input
+    uint32_t chunk_idx;
+    uint32_t chunk_count;
+    int64_t  chunk_start;
+
+    // Depth of the read-ahead and write-behind rings, 0 for synchronous I/O
+    int32_t                async_io;
+    struct AppAsyncReader *async_reader;
+    struct AppAsyncWriter *async_writer;
+
+    // Tile groups of the current frame, written once its last packet gives the IVF frame size
+    uint8_t *partial_frame_buffer;
+    uint32_t partial_frame_size;
+    uint32_t partial_frame_alloc;
+
     struct forced_key_frames forced_keyframes;
 
     /****************************************
@@ -206,6 +227,8 @@ typedef enum MultiPassModes {
 
 typedef struct EncApp {
     SvtAv1FixedBuf rc_twopasses_stats;
+    // First-pass statistics of each chunk of a chunked encode, merged into rc_twopasses_stats
+    SvtAv1FixedBuf chunk_stats[MAX_CHANNEL_NUMBER];
 } EncApp;
 EbConfig *svt_config_ctor();
 void      svt_config_dtor(EbConfig *app_cfg);
@@ -216,6 +239,7 @@ EbErrorType     read_command_line(int32_t argc, char *const argv[], EncChannel *
 int             get_version(int argc, char *argv[]);
 extern uint32_t get_help(int32_t argc, char *const argv[]);
 extern uint32_t get_number_of_channels(int32_t argc, char *const argv[]);
+extern uint32_t get_number_of_chunks(int32_t argc, char *const argv[]);
 uint32_t        get_passes(int32_t argc, char *const argv[], EncPass enc_pass[MAX_ENC_PASS]);
 EbErrorType     handle_stats_file(EbConfig *app_cfg, EncPass pass, const SvtAv1FixedBuf *rc_stats_buffer,
                                   uint32_t channel_number);
@@ -21,6 +21,7 @@
 #include "EbSvtAv1.h"
 #include "EbAppContext.h"
 #include "EbAppConfig.h"
+#include "EbAppAsyncIo.h"
 #if DEBUG_ROI
 #include <inttypes.h>
 #endif
@@ -356,6 +357,8 @@ fail:
     return ret;
 }
 static void deallocate_buffers(EbConfig *app_cfg) {
+    // Threads of a channel which did not finish
+    app_async_io_stop(app_cfg);
     // Deallocate input buffers
     if (app_cfg->input_buffer_pool) {
         if (app_cfg->buffered_input == -1 && !app_cfg->mmap.enable) {
@@ -28,6 +28,8 @@
 #include <string.h>
 #include "EbAppConfig.h"
 #include "EbAppContext.h"
+#include "EbAppAsyncIo.h"
+#include "EbAppOutputivf.h"
 #include "EbTime.h"
 #include <fcntl.h>
 #ifdef _WIN32
@@ -100,7 +102,8 @@ typedef struct EncContext {
 
 //initilize memory mapped file handler
 static void init_memory_file_map(EbConfig* app_cfg) {
-    app_cfg->mmap.enable = app_cfg->buffered_input == -1 && !app_cfg->input_file_is_fifo;
+    // The reader thread of --async-io reads the input with fread
+    app_cfg->mmap.enable = app_cfg->buffered_input == -1 && !app_cfg->input_file_is_fifo && !app_cfg->async_io;
 
     if (!app_cfg->mmap.enable)
         return;
@@ -150,6 +153,207 @@ static int compar_uint64(const void* a, const void* b) {
     return (x < y) ? -1 : (x > y) ? 1 : 0;
 }
 
+// set force_key_frames frames
+static void set_forced_keyframes(EbConfig* app_cfg) {
+    const double fps = (double)app_cfg->config.frame_rate_numerator / app_cfg->config.frame_rate_denominator;
+    struct forced_key_frames* forced_keyframes = &app_cfg->forced_keyframes;
+
+    for (size_t i = 0; i < forced_keyframes->count; ++i) {
+        char*  p;
+        double val = strtod(forced_keyframes->specifiers[i], &p);
+        switch (*p) {
+        case 'f':
+        case 'F': break;
+        case 's':
+        case 'S':
+        default: val *= fps; break;
+        }
+        forced_keyframes->frames[i] = (uint64_t)val;
+    }
+    // frames of a chunk count from its first frame, those before it never match
+    if (app_cfg->chunk_start)
+        for (size_t i = 0; i < forced_keyframes->count; ++i)
+            forced_keyframes->frames[i] = forced_keyframes->frames[i] >= (uint64_t)app_cfg->chunk_start
+                ? forced_keyframes->frames[i] - app_cfg->chunk_start
+                : UINT64_MAX;
+    qsort(forced_keyframes->frames, forced_keyframes->count, sizeof(forced_keyframes->frames[0]), compar_uint64);
+}
+
+static uint32_t get_processor_count(void) {
+#ifdef _WIN32
+    SYSTEM_INFO sys_info;
+    GetSystemInfo(&sys_info);
+    return sys_info.dwNumberOfProcessors;
+#else
+    const long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (uint32_t)count : 1;
+#endif
+}
+
+/* Splits the frames to encode in up to chunk_count chunks of about the same
+ * length, each starting at the forced key frame or, when the keyint is known,
+ * at the multiple of the keyint closest to its even split. Returns the number
+ * of chunks, fewer when the input is too short. */
+static uint32_t plan_chunks(EbConfig* app_cfg, uint32_t chunk_count, int64_t starts[MAX_CHANNEL_NUMBER]) {
+    const int64_t frames = app_cfg->frames_to_be_encoded;
+    int64_t       period = 0;
+    if (app_cfg->config.intra_period_length >= 0) {
+        const double fps = (double)app_cfg->config.frame_rate_numerator / app_cfg->config.frame_rate_denominator;
+        period           = 1 +
+            (app_cfg->config.multiply_keyint ? (int64_t)(fps * app_cfg->config.intra_period_length)
+                                             : app_cfg->config.intra_period_length);
+    }
+    if (app_cfg->config.force_key_frames)
+        set_forced_keyframes(app_cfg);
+    uint32_t count = 0;
+    starts[count++] = 0;
+    for (uint32_t k = 1; k < chunk_count; ++k) {
+        const int64_t prev  = starts[count - 1];
+        const int64_t ideal = frames * k / chunk_count;
+        int64_t       start = -1;
+        if (period > 1) {
+            start = (ideal + period / 2) / period * period;
+            if (start <= prev)
+                start = (prev / period + 1) * period;
+        }
+        for (size_t i = 0; app_cfg->config.force_key_frames && i < app_cfg->forced_keyframes.count; ++i) {
+            const int64_t frame = (int64_t)app_cfg->forced_keyframes.frames[i];
+            if (frame > prev && frame < frames && (start < 0 || llabs(frame - ideal) < llabs(start - ideal)))
+                start = frame;
+        }
+        if (start < 0)
+            start = ideal;
+        if (start > prev && start < frames)
+            starts[count++] = start;
+    }
+    return count;
+}
+
+/* Chunked encoding (--chunks): the channels encode consecutive chunks of the input
+ * of the first channel, each from a key frame on and on its share of the logical
+ * processors, their streams being appended to the stream of the first chunk */
+static EbErrorType setup_chunks(EncContext* enc_context, int32_t argc, char* argv[], uint32_t chunk_count) {
+    EbConfig* app_cfg = enc_context->channels[0].app_cfg;
+    if (enc_context->channels[0].return_error != EB_ErrorNone)
+        return enc_context->channels[0].return_error;
+    if (app_cfg->input_file_is_fifo || app_cfg->frames_to_be_encoded <= 0 || app_cfg->buffered_input != -1 ||
+        app_cfg->recon_file || (enc_context->passes == 1 && app_cfg->config.pass != ENC_SINGLE_PASS)) {
+        fprintf(stderr,
+                "[SVT-Error]: --chunks needs an input file, and is not supported with --nb, -o and --pass, use "
+                "--passes 2 for a two-pass encode\n");
+        return EB_ErrorBadParameter;
+    }
+
+    int64_t        starts[MAX_CHANNEL_NUMBER];
+    const uint32_t count  = plan_chunks(app_cfg, chunk_count, starts);
+    const int64_t  frames = app_cfg->frames_to_be_encoded;
+    const uint32_t lps    = app_cfg->config.logical_processors ? app_cfg->config.logical_processors
+                                                               : get_processor_count();
+    for (uint32_t k = 1; k < count; ++k) {
+        EncChannel* c             = enc_context->channels + k;
+        EbErrorType return_error  = enc_channel_ctor(c);
+        enc_context->num_channels = k + 1;
+        if (return_error == EB_ErrorNone)
+            return_error = read_command_line(argc, argv, c, 1);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+    }
+    for (uint32_t k = 0; k < count; ++k) {
+        EbConfig* cfg    = enc_context->channels[k].app_cfg;
+        cfg->chunk_idx   = k;
+        cfg->chunk_count = count;
+        cfg->chunk_start = starts[k];
+        cfg->frames_to_be_skipped += starts[k];
+        cfg->need_to_skip                   = cfg->frames_to_be_skipped > 0;
+        cfg->frames_to_be_encoded           = (k + 1 < count ? starts[k + 1] : frames) - starts[k];
+        cfg->config.logical_processors      = lps / count ? lps / count : 1;
+        if (!k)
+            continue;
+        // The other chunks write to temporary streams and leave the files shared with the first one
+        if (cfg->bitstream_file != stdout)
+            fclose(cfg->bitstream_file);
+        cfg->bitstream_file = tmpfile();
+        if (!cfg->bitstream_file) {
+            fprintf(stderr, "[SVT-Error]: Could not create the stream of chunk %u\n", k + 1);
+            return EB_ErrorInsufficientResources;
+        }
+        if (cfg->stat_file) {
+            fclose(cfg->stat_file);
+            cfg->stat_file = NULL;
+        }
+        if (cfg->error_log_file != stderr) {
+            fclose(cfg->error_log_file);
+            cfg->error_log_file = stderr;
+        }
+        free((void*)cfg->stats);
+        cfg->stats = NULL;
+    }
+    if (count < chunk_count)
+        fprintf(stderr, "[SVT-Warning]: The input is split in %u chunks only\n", count);
+    return EB_ErrorNone;
+}
+
+/* Merges the first-pass statistics of the chunks into those of the whole input,
+ * each chunk giving the statistics of its frames followed by their totals */
+static EbErrorType merge_chunk_stats(EncApp* enc_app, const EncContext* enc_context) {
+    size_t packet_sz = 0;
+    size_t sz        = 0;
+    for (uint32_t k = 0; k < enc_context->num_channels; ++k) {
+        const SvtAv1FixedBuf* stats   = &enc_app->chunk_stats[k];
+        const uint64_t        packets = enc_context->channels[k].app_cfg->frames_to_be_encoded + 1;
+        if (!stats->sz || stats->sz % packets || (packet_sz && stats->sz / packets != packet_sz)) {
+            fprintf(stderr, "[SVT-Error]: Could not merge the first-pass statistics of the chunks\n");
+            return EB_ErrorBadParameter;
+        }
+        packet_sz = (size_t)(stats->sz / packets);
+        sz += (size_t)stats->sz - packet_sz;
+    }
+    uint8_t* buf = (uint8_t*)realloc(enc_app->rc_twopasses_stats.buf, sz + packet_sz);
+    if (!buf)
+        return EB_ErrorInsufficientResources;
+    enc_app->rc_twopasses_stats.buf = buf;
+    enc_app->rc_twopasses_stats.sz  = sz + packet_sz;
+    for (uint32_t k = 0; k < enc_context->num_channels; ++k) {
+        SvtAv1FixedBuf* stats = &enc_app->chunk_stats[k];
+        memcpy(buf, stats->buf, (size_t)stats->sz - packet_sz);
+        buf += stats->sz - packet_sz;
+        free(stats->buf);
+        stats->buf = NULL;
+        stats->sz  = 0;
+    }
+    // The final pass accumulates the totals of the input in the last packet
+    memset(buf, 0, packet_sz);
+    if (enc_context->channels[0].app_cfg->output_stat_file)
+        fwrite(enc_app->rc_twopasses_stats.buf,
+               1,
+               enc_app->rc_twopasses_stats.sz,
+               enc_context->channels[0].app_cfg->output_stat_file);
+    return EB_ErrorNone;
+}
+
+// Appends the streams of the other chunks to the stream of the first one
+static EbErrorType stitch_chunks(const EncContext* enc_context) {
+    EbConfig* app_cfg = enc_context->channels[0].app_cfg;
+    for (uint32_t k = 0; k < enc_context->num_channels; ++k) {
+        const EncChannel* c = enc_context->channels + k;
+        if (c->exit_cond != APP_ExitConditionFinished || c->app_cfg->stop_encoder) {
+            fprintf(stderr, "[SVT-Error]: Chunk %u did not finish, the chunks are not stitched\n", k + 1);
+            return EB_ErrorBadParameter;
+        }
+    }
+    for (uint32_t k = 1; k < enc_context->num_channels; ++k) {
+        EbConfig* cfg = enc_context->channels[k].app_cfg;
+        fflush(cfg->bitstream_file);
+        if (!append_ivf_frames(app_cfg, cfg->bitstream_file)) {
+            fprintf(stderr, "[SVT-Error]: Could not append the stream of chunk %u\n", k + 1);
+            return EB_ErrorBadParameter;
+        }
+        app_cfg->frames_encoded += cfg->frames_encoded;
+    }
+    fprintf(stderr, "Stitched %u chunks, %d frames\n", enc_context->num_channels, app_cfg->frames_encoded);
+    return EB_ErrorNone;
+}
+
 static EbErrorType enc_context_ctor(EncApp* enc_app, EncContext* enc_context, int32_t argc, char* argv[],
                                     EncPass enc_pass, int32_t passes) {
 #if LOG_ENC_DONE
@@ -157,9 +361,14 @@ static EbErrorType enc_context_ctor(EncApp* enc_app, EncContext* enc_context, in
 #endif
 
     memset(enc_context, 0, sizeof(*enc_context));
-    uint32_t num_channels = get_number_of_channels(argc, argv);
-    if (num_channels == 0)
+    uint32_t       num_channels = get_number_of_channels(argc, argv);
+    const uint32_t num_chunks   = get_number_of_chunks(argc, argv);
+    if (num_channels == 0 || num_chunks == 0)
+        return EB_ErrorBadParameter;
+    if (num_channels > 1 && num_chunks > 1) {
+        fprintf(stderr, "[SVT-Error]: --chunks is not supported with several channels\n");
         return EB_ErrorBadParameter;
+    }
     enc_context->enc_pass    = enc_pass;
     enc_context->passes      = passes;
     EbErrorType return_error = EB_ErrorNone;
@@ -188,6 +397,12 @@ static EbErrorType enc_context_ctor(EncApp* enc_app, EncContext* enc_context, in
         fprintf(stderr, "Run %s --help for a list of options\n", argv[0]);
         return return_error;
     }
+    if (num_chunks > 1) {
+        return_error = setup_chunks(enc_context, argc, argv, num_chunks);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+        num_channels = enc_context->num_channels;
+    }
     // Set main thread affinity
     if (enc_context->channels[0].app_cfg->config.target_socket != -1)
         assign_app_thread_group(enc_context->channels[0].app_cfg->config.target_socket);
@@ -201,29 +416,8 @@ static EbErrorType enc_context_ctor(EncApp* enc_app, EncContext* enc_context, in
             app_cfg->config.channel_id           = inst_cnt;
             app_cfg->config.recon_enabled        = app_cfg->recon_file ? TRUE : FALSE;
 
-            // set force_key_frames frames
-            if (app_cfg->config.force_key_frames) {
-                const double fps = (double)app_cfg->config.frame_rate_numerator /
-                    app_cfg->config.frame_rate_denominator;
-                struct forced_key_frames* forced_keyframes = &app_cfg->forced_keyframes;
-
-                for (size_t i = 0; i < forced_keyframes->count; ++i) {
-                    char*  p;
-                    double val = strtod(forced_keyframes->specifiers[i], &p);
-                    switch (*p) {
-                    case 'f':
-                    case 'F': break;
-                    case 's':
-                    case 'S':
-                    default: val *= fps; break;
-                    }
-                    forced_keyframes->frames[i] = (uint64_t)val;
-                }
-                qsort(forced_keyframes->frames,
-                      forced_keyframes->count,
-                      sizeof(forced_keyframes->frames[0]),
-                      compar_uint64);
-            }
+            if (app_cfg->config.force_key_frames)
+                set_forced_keyframes(app_cfg);
             init_memory_file_map(app_cfg);
             init_reader(app_cfg);
 
@@ -234,6 +428,11 @@ static EbErrorType enc_context_ctor(EncApp* enc_app, EncContext* enc_context, in
                                                : (int)enc_pass; // Multi-Pass
 
             c->return_error = handle_stats_file(app_cfg, enc_pass, &enc_app->rc_twopasses_stats, num_channels);
+            // Each chunk gets its frames of the statistics of the whole input
+            if (app_cfg->chunk_count > 1 && enc_pass == ENC_SECOND_PASS) {
+                app_cfg->config.rc_stats_chunk_start  = (uint32_t)app_cfg->chunk_start;
+                app_cfg->config.rc_stats_chunk_frames = (uint32_t)app_cfg->frames_to_be_encoded;
+            }
             if (c->return_error == EB_ErrorNone) {
                 c->return_error = init_encoder(app_cfg, inst_cnt);
             }
@@ -372,6 +571,13 @@ static void print_performance(const EncContext* const enc_context) {
                             app_cfg->performance_context.total_execution_time * 1000,
                             app_cfg->performance_context.average_latency,
                             (uint32_t)(app_cfg->performance_context.max_latency));
+                fprintf(stderr,
+                        "Input Read Time:\t%.0f ms\nInput Wait Time:\t%.0f ms\nOutput Write Time:\t%.0f "
+                        "ms\nOutput Wait Time:\t%.0f ms\n",
+                        app_cfg->performance_context.input_read_time * 1000,
+                        app_cfg->performance_context.input_wait_time * 1000,
+                        app_cfg->performance_context.output_write_time * 1000,
+                        app_cfg->performance_context.output_wait_time * 1000);
             } else
                 fprintf(stderr, "\nChannel %u Encoding Interrupted\n", (uint32_t)(inst_cnt + 1));
         } else if (c->return_error == EB_ErrorInsufficientResources)
@@ -434,6 +640,11 @@ static void enc_channel_step(EncChannel* c, EncApp* enc_app, EncContext* enc_con
             c->exit_cond = (AppExitConditionType)(c->exit_cond_recon | c->exit_cond_output | c->exit_cond_input);
         else
             c->exit_cond = (AppExitConditionType)(c->exit_cond_output | c->exit_cond_input);
+        // Finish the writes left behind
+        if (!app_async_io_stop(app_cfg)) {
+            fprintf(stderr, "\n[SVT-Error]: Could not write the output of channel %u\n", app_cfg->instance_idx + 1);
+            c->exit_cond = APP_ExitConditionError;
+        }
     }
 }
 static const char* get_pass_name(EncPass enc_pass) {
@@ -451,6 +662,11 @@ static void enc_channel_start(EncChannel* c) {
         c->exit_cond_recon  = app_cfg->recon_file ? APP_ExitConditionNone : APP_ExitConditionError;
         c->exit_cond_input  = APP_ExitConditionNone;
         c->active           = TRUE;
+        if (app_cfg->async_io) {
+            app_cfg->async_writer = app_async_writer_start(app_cfg->async_io);
+            if (!app_cfg->async_writer)
+                fprintf(stderr, "[SVT-Warning]: Could not start the output writer thread, writing synchronously\n");
+        }
         app_svt_av1_get_time(&app_cfg->performance_context.encode_start_time[0],
                              &app_cfg->performance_context.encode_start_time[1]);
     }
@@ -486,7 +702,10 @@ EbErrorType enc_app_ctor(EncApp* enc_app) {
     return EB_ErrorNone;
 }
 
-void enc_app_dctor(EncApp* enc_app) { free(enc_app->rc_twopasses_stats.buf); }
+void enc_app_dctor(EncApp* enc_app) {
+    free(enc_app->rc_twopasses_stats.buf);
+    for (uint32_t k = 0; k < MAX_CHANNEL_NUMBER; ++k) free(enc_app->chunk_stats[k].buf);
+}
 
 /***************************************
  * Encoder App Main
@@ -517,6 +736,9 @@ int32_t main(int32_t argc, char* argv[]) {
 
         if (return_error == EB_ErrorNone)
             return_error = encode(&enc_app, &enc_context);
+        if (return_error == EB_ErrorNone && enc_context.channels[0].app_cfg->chunk_count > 1)
+            return_error = enc_pass[pass_idx] == ENC_FIRST_PASS ? merge_chunk_stats(&enc_app, &enc_context)
+                                                                : stitch_chunks(&enc_context);
 
         enc_context_dctor(&enc_context);
         if (return_error != EB_ErrorNone)
@@ -11,9 +11,11 @@
 
 #include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 
 #include "EbAppConfig.h"
 #include "EbAppOutputivf.h"
+#include "EbAppAsyncIo.h"
 
 #define AV1_FOURCC 0x31305641 // used for ivf header
 #define IVF_STREAM_HEADER_SIZE 32
@@ -35,6 +37,12 @@ static __inline void mem_put_le16(void *vmem, int32_t val) {
     mem[1] = (uint8_t)((val >> 8) & 0xff);
 }
 
+static __inline uint32_t mem_get_le32(const void *vmem) {
+    const uint8_t *mem = (const uint8_t *)vmem;
+
+    return (uint32_t)mem[0] | ((uint32_t)mem[1] << 8) | ((uint32_t)mem[2] << 16) | ((uint32_t)mem[3] << 24);
+}
+
 void write_ivf_stream_header(EbConfig *app_cfg, int32_t length) {
     char header[IVF_STREAM_HEADER_SIZE] = {'D', 'K', 'I', 'F'};
     mem_put_le16(header + 4, 0); // version
@@ -46,7 +54,7 @@ void write_ivf_stream_header(EbConfig *app_cfg, int32_t length) {
     mem_put_le32(header + 20, app_cfg->config.frame_rate_denominator); // scale
     mem_put_le32(header + 24, length); // length
     mem_put_le32(header + 28, 0); // unused
-    fwrite(header, 1, IVF_STREAM_HEADER_SIZE, app_cfg->bitstream_file);
+    app_output_write(app_cfg, app_cfg->bitstream_file, -1, header, IVF_STREAM_HEADER_SIZE);
 }
 
 void write_ivf_frame_header(EbConfig *app_cfg, uint32_t byte_count) {
@@ -57,5 +65,35 @@ void write_ivf_frame_header(EbConfig *app_cfg, uint32_t byte_count) {
     mem_put_le32(&header[8], (int32_t)(app_cfg->ivf_count >> 32));
 
     app_cfg->ivf_count++;
-    fwrite(header, 1, IVF_FRAME_HEADER_SIZE, app_cfg->bitstream_file);
+    app_output_write(app_cfg, app_cfg->bitstream_file, -1, header, IVF_FRAME_HEADER_SIZE);
+}
+
+/* Appends the frames of the IVF stream in stream to the bitstream, numbered after
+ * the frames written so far, e.g. the stream of the next chunk of a chunked encode */
+Bool append_ivf_frames(EbConfig *app_cfg, FILE *stream) {
+    uint8_t  header[IVF_FRAME_HEADER_SIZE];
+    uint8_t *frame = NULL;
+    uint32_t alloc = 0;
+    Bool     ok    = fseeko(stream, IVF_STREAM_HEADER_SIZE, SEEK_SET) == 0;
+
+    while (ok && fread(header, 1, IVF_FRAME_HEADER_SIZE, stream) == IVF_FRAME_HEADER_SIZE) {
+        const uint32_t size = mem_get_le32(header);
+        if (size > alloc) {
+            uint8_t *buffer = (uint8_t *)realloc(frame, size);
+            if (!buffer) {
+                ok = FALSE;
+                break;
+            }
+            frame = buffer;
+            alloc = size;
+        }
+        if (fread(frame, 1, size, stream) != size) {
+            ok = FALSE;
+            break;
+        }
+        write_ivf_frame_header(app_cfg, size);
+        app_output_write(app_cfg, app_cfg->bitstream_file, -1, frame, size);
+    }
+    free(frame);
+    return ok && !ferror(stream) && !ferror(app_cfg->bitstream_file);
 }
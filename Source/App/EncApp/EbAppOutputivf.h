@@ -13,10 +13,12 @@
 #define EbAppOutputivf_h
 
 #include <stdint.h>
+#include <stdio.h>
 
 #include "EbAppConfig.h"
 
 void write_ivf_stream_header(EbConfig *app_cfg, int32_t length);
 void write_ivf_frame_header(EbConfig *app_cfg, uint32_t byte_count);
+Bool append_ivf_frames(EbConfig *app_cfg, FILE *stream);
 
 #endif
@@ -33,6 +33,7 @@
 #endif
 
 #include "EbAppOutputivf.h"
+#include "EbAppAsyncIo.h"
 
 /***************************************
  * Macros
@@ -106,6 +107,8 @@ void log_error_output(FILE *error_log_file, uint32_t error_code) {
 }
 
 static void (*read_input)(EbConfig *app_cfg, uint8_t is_16bit, EbBufferHeaderType *header_ptr);
+static Bool fread_input_frame(EbConfig *app_cfg, uint8_t is_16bit, EbBufferHeaderType *header_ptr, Bool first_frame);
+static void normal_read_input_frames(EbConfig *app_cfg, uint8_t is_16bit, EbBufferHeaderType *header_ptr);
 
 /* returns a RAM address from a memory mapped file  */
 static void *svt_mmap(MemMapFile *h, size_t offset, size_t size) {
@@ -221,6 +224,25 @@ static void injector(uint64_t processed_frame_count, uint32_t injector_frame_rat
     }
 }
 
+/* Keeps the first-pass statistics for the final pass, those of a chunk of a chunked
+ * encode being merged with the ones of the other chunks once they are all done */
+static void keep_first_pass_stats(EbConfig *app_cfg, EncApp *enc_app, EbComponentType *component_handle) {
+    SvtAv1FixedBuf first_pass_stat;
+    if (svt_av1_enc_get_stream_info(component_handle, SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_OUT, &first_pass_stat) !=
+        EB_ErrorNone)
+        return;
+    SvtAv1FixedBuf *stats = &enc_app->rc_twopasses_stats;
+    if (app_cfg->chunk_count > 1)
+        stats = &enc_app->chunk_stats[app_cfg->chunk_idx];
+    else if (app_cfg->output_stat_file)
+        fwrite(first_pass_stat.buf, 1, first_pass_stat.sz, app_cfg->output_stat_file);
+    stats->buf = realloc(stats->buf, first_pass_stat.sz);
+    if (stats->buf) {
+        memcpy(stats->buf, first_pass_stat.buf, first_pass_stat.sz);
+        stats->sz = first_pass_stat.sz;
+    }
+}
+
 static bool is_forced_keyframe(const EbConfig *app_cfg, uint64_t pts) {
     if (app_cfg->forced_keyframes.frames) {
         for (size_t i = 0; i < app_cfg->forced_keyframes.count; ++i) {
@@ -491,14 +513,40 @@ void process_input_buffer(EncChannel *channel) {
         return;
     if (app_cfg->injector)
         injector(app_cfg->processed_frame_count, app_cfg->injector_frame_rate);
+    // The reader thread starts once the skipped frames are read
+    if (app_cfg->async_io && !app_cfg->async_reader && read_input == normal_read_input_frames) {
+        app_cfg->async_reader = app_async_reader_start(app_cfg,
+                                                       app_cfg->async_io,
+                                                       fread_input_frame,
+                                                       app_cfg->frames_to_be_encoded < 0
+                                                           ? UINT64_MAX
+                                                           : frames_to_be_encoded - app_cfg->processed_frame_count);
+        if (!app_cfg->async_reader) {
+            fprintf(stderr, "\n[SVT-Warning]: Could not start the input reader thread, reading synchronously\n");
+            app_cfg->async_io = 0;
+        }
+    }
 
     if (frames_to_be_encoded != app_cfg->processed_frame_count && app_cfg->stop_encoder == FALSE) {
+        if (app_cfg->async_reader) {
+            // Frame read ahead by the reader thread, empty once the reader is done
+            header_ptr = app_async_reader_get(app_cfg->async_reader, &app_cfg->performance_context.input_wait_time);
+            if (!header_ptr->n_filled_len)
+                app_cfg->frames_to_be_encoded = app_cfg->frames_encoded;
+        }
         header_ptr->p_app_private = NULL;
         header_ptr->pic_type      = EB_AV1_INVALID_PICTURE;
 #if FTR_RES_ON_FLY_SAMPLE
         test_update_input_pic_def(app_cfg->processed_frame_count, header_ptr, app_cfg);
 #endif
-        read_input(app_cfg, is_16bit, header_ptr);
+        if (!app_cfg->async_reader) {
+            // The encoder is not fed while reading
+            const double start_time = app_io_time();
+            read_input(app_cfg, is_16bit, header_ptr);
+            const double read_time = app_io_time() - start_time;
+            app_cfg->performance_context.input_read_time += read_time;
+            app_cfg->performance_context.input_wait_time += read_time;
+        }
 
         if (header_ptr->n_filled_len) {
             // Update the context parameters
@@ -536,9 +584,11 @@ void process_input_buffer(EncChannel *channel) {
 
             if (app_cfg->mmap.enable)
                 release_memory_mapped_file(app_cfg, is_16bit, header_ptr);
+            if (app_cfg->async_reader)
+                app_async_reader_release(app_cfg->async_reader);
         }
         if ((app_cfg->processed_frame_count == (uint64_t)app_cfg->frames_to_be_encoded) || app_cfg->stop_encoder) {
-            header_ptr->flags = EB_BUFFERFLAG_EOS;
+            app_cfg->input_buffer_pool->flags = EB_BUFFERFLAG_EOS;
             svt_av1_enc_send_picture(component_handle,
                                      &(EbBufferHeaderType){
                                          .flags    = EB_BUFFERFLAG_EOS,
@@ -619,7 +669,10 @@ static void mmap_read_input_frames(EbConfig *app_cfg, uint8_t is_16bit, EbBuffer
     }
 }
 
-static void normal_read_input_frames(EbConfig *app_cfg, uint8_t is_16bit, EbBufferHeaderType *header_ptr) {
+/* Reads a frame with fread, first_frame being the first frame of the encode.
+ * Returns TRUE once the end of a pipe was reached, the frame being left empty
+ * unless complete. Also run by the reader thread of --async-io. */
+static Bool fread_input_frame(EbConfig *app_cfg, uint8_t is_16bit, EbBufferHeaderType *header_ptr, Bool first_frame) {
     const uint32_t input_padded_width  = app_cfg->input_padded_width;
     const uint32_t input_padded_height = app_cfg->input_padded_height;
     FILE          *input_file          = app_cfg->input_file;
@@ -643,8 +696,7 @@ static void normal_read_input_frames(EbConfig *app_cfg, uint8_t is_16bit, EbBuff
     }
     uint64_t luma_read_size = (uint64_t)input_padded_width * input_padded_height << is_16bit;
     uint8_t *eb_input_ptr   = input_ptr->luma;
-    if (!app_cfg->y4m_input && app_cfg->processed_frame_count == 0 &&
-        (app_cfg->input_file == stdin || app_cfg->input_file_is_fifo)) {
+    if (!app_cfg->y4m_input && first_frame && (app_cfg->input_file == stdin || app_cfg->input_file_is_fifo)) {
         /* 9 bytes were already buffered during the the YUV4MPEG2 header probe */
         memcpy(eb_input_ptr, app_cfg->y4m_buf, YUV4MPEG2_IND_SIZE);
         header_ptr->n_filled_len += YUV4MPEG2_IND_SIZE;
@@ -670,17 +722,24 @@ static void normal_read_input_frames(EbConfig *app_cfg, uint8_t is_16bit, EbBuff
 
     if (feof(input_file) != 0) {
         if ((input_file == stdin) || (app_cfg->input_file_is_fifo)) {
-            //for a fifo, we only know this when we reach eof
-            app_cfg->frames_to_be_encoded = app_cfg->frames_encoded;
             if (header_ptr->n_filled_len != read_size) {
                 // not a completed frame
                 header_ptr->n_filled_len = 0;
             }
+            return TRUE;
         } else {
             // If we reached the end of file, loop over again
             fseek(input_file, 0, SEEK_SET);
         }
     }
+    return FALSE;
+}
+
+static void normal_read_input_frames(EbConfig *app_cfg, uint8_t is_16bit, EbBufferHeaderType *header_ptr) {
+    if (fread_input_frame(app_cfg, is_16bit, header_ptr, app_cfg->processed_frame_count == 0)) {
+        //for a fifo, we only know this when we reach eof
+        app_cfg->frames_to_be_encoded = app_cfg->frames_encoded;
+    }
 }
 
 static void buffered_read_input_frames(EbConfig *app_cfg, uint8_t is_16bit, EbBufferHeaderType *header_ptr) {
@@ -828,21 +887,29 @@ void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t
                 // Release the output buffer
                 svt_av1_enc_release_out_buffer(&header_ptr);
 
-                if (app_cfg->config.pass == ENC_FIRST_PASS) {
-                    SvtAv1FixedBuf first_pass_stat;
-                    EbErrorType    ret = svt_av1_enc_get_stream_info(
-                        component_handle, SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_OUT, &first_pass_stat);
-                    if (ret == EB_ErrorNone) {
-                        if (app_cfg->output_stat_file) {
-                            fwrite(first_pass_stat.buf, 1, first_pass_stat.sz, app_cfg->output_stat_file);
-                        }
-                        enc_app->rc_twopasses_stats.buf = realloc(enc_app->rc_twopasses_stats.buf, first_pass_stat.sz);
-                        if (enc_app->rc_twopasses_stats.buf) {
-                            memcpy(enc_app->rc_twopasses_stats.buf, first_pass_stat.buf, first_pass_stat.sz);
-                            enc_app->rc_twopasses_stats.sz = first_pass_stat.sz;
-                        }
+                if (app_cfg->config.pass == ENC_FIRST_PASS)
+                    keep_first_pass_stats(app_cfg, enc_app, component_handle);
+            } else if (flags & EB_BUFFERFLAG_PARTIAL_FRAME) {
+                // Keep the leading tile groups until the packet closing the frame
+                const uint32_t size = app_cfg->partial_frame_size + header_ptr->n_filled_len;
+                if (size > app_cfg->partial_frame_alloc) {
+                    uint8_t *buffer = (uint8_t *)realloc(app_cfg->partial_frame_buffer, size);
+                    if (!buffer) {
+                        svt_av1_enc_release_out_buffer(&header_ptr);
+                        channel->exit_cond_output = APP_ExitConditionError;
+                        return;
                     }
+                    app_cfg->partial_frame_buffer = buffer;
+                    app_cfg->partial_frame_alloc  = size;
                 }
+                memcpy(app_cfg->partial_frame_buffer + app_cfg->partial_frame_size,
+                       header_ptr->p_buffer,
+                       header_ptr->n_filled_len);
+                app_cfg->partial_frame_size = size;
+                svt_av1_enc_release_out_buffer(&header_ptr);
+                // The rest of the frame may follow right away
+                is_alt_ref = 1;
+                continue;
             } else {
                 is_alt_ref = (flags & EB_BUFFERFLAG_IS_ALT_REF);
                 if (!(flags & EB_BUFFERFLAG_IS_ALT_REF))
@@ -871,11 +938,15 @@ void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t
                         write_ivf_stream_header(
                             app_cfg, app_cfg->frames_to_be_encoded == -1 ? 0 : (int32_t)app_cfg->frames_to_be_encoded);
                     }
-                    write_ivf_frame_header(app_cfg, header_ptr->n_filled_len);
-                    fwrite(header_ptr->p_buffer, 1, header_ptr->n_filled_len, stream_file);
+                    write_ivf_frame_header(app_cfg, app_cfg->partial_frame_size + header_ptr->n_filled_len);
+                    if (app_cfg->partial_frame_size)
+                        app_output_write(
+                            app_cfg, stream_file, -1, app_cfg->partial_frame_buffer, app_cfg->partial_frame_size);
+                    app_output_write(app_cfg, stream_file, -1, header_ptr->p_buffer, header_ptr->n_filled_len);
                 }
 
-                app_cfg->performance_context.byte_count += header_ptr->n_filled_len;
+                app_cfg->performance_context.byte_count += app_cfg->partial_frame_size + header_ptr->n_filled_len;
+                app_cfg->partial_frame_size = 0;
 
                 if (app_cfg->config.stat_report && !(flags & EB_BUFFERFLAG_IS_ALT_REF))
                     process_output_statistics_buffer(header_ptr, app_cfg);
@@ -946,7 +1017,7 @@ void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t
                         app_cfg, app_cfg->frames_to_be_encoded == -1 ? 0 : (int32_t)app_cfg->frames_to_be_encoded);
                 }
                 write_ivf_frame_header(app_cfg, header_ptr->n_filled_len);
-                fwrite(header_ptr->p_buffer, 1, header_ptr->n_filled_len, stream_file);
+                app_output_write(app_cfg, stream_file, -1, header_ptr->p_buffer, header_ptr->n_filled_len);
             }
 
             app_cfg->performance_context.byte_count += header_ptr->n_filled_len;
@@ -961,21 +1032,8 @@ void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t
             svt_av1_enc_release_out_buffer(&header_ptr);
 
             if (flags & EB_BUFFERFLAG_EOS) {
-                if (app_cfg->config.pass == ENC_FIRST_PASS) {
-                    SvtAv1FixedBuf first_pass_stat;
-                    EbErrorType    ret = svt_av1_enc_get_stream_info(
-                        component_handle, SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_OUT, &first_pass_stat);
-                    if (ret == EB_ErrorNone) {
-                        if (app_cfg->output_stat_file) {
-                            fwrite(first_pass_stat.buf, 1, first_pass_stat.sz, app_cfg->output_stat_file);
-                        }
-                        enc_app->rc_twopasses_stats.buf = realloc(enc_app->rc_twopasses_stats.buf, first_pass_stat.sz);
-                        if (enc_app->rc_twopasses_stats.buf) {
-                            memcpy(enc_app->rc_twopasses_stats.buf, first_pass_stat.buf, first_pass_stat.sz);
-                            enc_app->rc_twopasses_stats.sz = first_pass_stat.sz;
-                        }
-                    }
-                }
+                if (app_cfg->config.pass == ENC_FIRST_PASS)
+                    keep_first_pass_stats(app_cfg, enc_app, component_handle);
             }
             ++*frame_count;
 
@@ -1031,7 +1089,16 @@ void process_output_recon_buffer(EncChannel *channel) {
         log_error_output(app_cfg->error_log_file, header_ptr->flags);
         channel->exit_cond_recon = APP_ExitConditionError;
         return;
+    } else if (recon_status != EB_NoErrorEmptyQueue && app_cfg->async_writer) {
+        // Written behind at the offset of the frame
+        app_output_write(app_cfg,
+                         app_cfg->recon_file,
+                         (int64_t)(header_ptr->pts * header_ptr->n_filled_len),
+                         header_ptr->p_buffer,
+                         header_ptr->n_filled_len);
+        return_value = (header_ptr->flags & EB_BUFFERFLAG_EOS) ? APP_ExitConditionFinished : APP_ExitConditionNone;
     } else if (recon_status != EB_NoErrorEmptyQueue) {
+        const double start_time = app_io_time();
         //Sets the File position to the beginning of the file.
         rewind(app_cfg->recon_file);
         uint64_t frame_num = header_ptr->pts;
@@ -1047,6 +1114,9 @@ void process_output_recon_buffer(EncChannel *channel) {
         }
 
         fwrite(header_ptr->p_buffer, 1, header_ptr->n_filled_len, app_cfg->recon_file);
+        const double write_time = app_io_time() - start_time;
+        app_cfg->performance_context.output_write_time += write_time;
+        app_cfg->performance_context.output_wait_time += write_time;
 
         // Update Output Port Activity State
         return_value = (header_ptr->flags & EB_BUFFERFLAG_EOS) ? APP_ExitConditionFinished : APP_ExitConditionNone;
@@ -0,0 +1,78 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <immintrin.h>
+#include "EbDefinitions.h"
+#include "common_dsp_rtcd.h"
+#include "EbBitstreamUnit.h"
+
+/* Same layout as the SSE2 kernels, with both overlapping 8-lane halves of a CDF (icdf[0..7]
+ * and the 8 entries ending at icdf[min(nsyms, 15)]) processed in one register. Alphabets of
+ * up to 6 symbols fit in a single 128-bit register and are left to the SSE2 kernels. */
+
+#define OD_EC_HI_HALF_START(nsyms) (AOMMIN(nsyms, 15) - 7)
+
+static INLINE __m256i od_ec_load_cdf_8x2_avx2(const uint16_t *icdf, int nsyms) {
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)icdf)),
+                                   _mm_loadu_si128((const __m128i *)(icdf + OD_EC_HI_HALF_START(nsyms))),
+                                   1);
+}
+
+static INLINE __m256i od_ec_lane_idx_8x2_avx2(int nsyms) {
+    const int16_t o = (int16_t)OD_EC_HI_HALF_START(nsyms);
+    return _mm256_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7, o, o + 1, o + 2, o + 3, o + 4, o + 5, o + 6, o + 7);
+}
+
+int svt_od_ec_find_symbol_avx2(const uint16_t *icdf, int nsyms, uint32_t c, uint32_t r) {
+    if (nsyms <= 6)
+        return svt_od_ec_find_symbol_sse2(icdf, nsyms, c, r);
+    const __m256i n   = _mm256_set1_epi16((int16_t)(nsyms - 1));
+    const __m256i idx = od_ec_lane_idx_8x2_avx2(nsyms);
+    /* ((r >> 8) * (icdf >> EC_PROB_SHIFT)) >> 1, as the high half of ((r >> 8) << 8) * ((icdf >> 6) << 7) */
+    const __m256i p = _mm256_slli_epi16(_mm256_srli_epi16(od_ec_load_cdf_8x2_avx2(icdf, nsyms), EC_PROB_SHIFT), 7);
+    __m256i       v = _mm256_mulhi_epu16(p, _mm256_set1_epi16((int16_t)(r & 0xFF00)));
+    v               = _mm256_add_epi16(v, _mm256_slli_epi16(_mm256_sub_epi16(n, idx), 2));
+    /* c < v, unsigned, on the symbols of the alphabet only */
+    const __m256i below = _mm256_cmpeq_epi16(_mm256_subs_epu16(_mm256_set1_epi16((int16_t)(c + 1)), v),
+                                             _mm256_setzero_si256());
+    const __m256i valid = _mm256_cmpgt_epi16(n, idx);
+    const __m256i sym   = _mm256_and_si256(_mm256_and_si256(below, valid),
+                                         _mm256_add_epi16(idx, _mm256_set1_epi16(1)));
+    /* The decoded symbol is the largest lane as the bounds decrease monotonically */
+    __m128i m = _mm_max_epi16(_mm256_castsi256_si128(sym), _mm256_extracti128_si256(sym, 1));
+    m         = _mm_max_epi16(m, _mm_srli_si128(m, 8));
+    m         = _mm_max_epi16(m, _mm_srli_si128(m, 4));
+    m         = _mm_max_epi16(m, _mm_srli_si128(m, 2));
+    return _mm_extract_epi16(m, 0);
+}
+
+void svt_od_ec_update_cdf_avx2(uint16_t *cdf, int val, int nsyms) {
+    static const int nsymbs2speed[17] = {0, 0, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2};
+    if (nsyms <= 6) {
+        svt_od_ec_update_cdf_sse2(cdf, val, nsyms);
+        return;
+    }
+    assert(nsyms < 17);
+    const int     rate = 3 + (cdf[nsyms] > 15) + (cdf[nsyms] > 31) + nsymbs2speed[nsyms];
+    const __m128i sh   = _mm_cvtsi32_si128(rate);
+    const __m256i idx  = od_ec_lane_idx_8x2_avx2(nsyms);
+    const __m256i x    = od_ec_load_cdf_8x2_avx2(cdf, nsyms);
+    /* Symbols below val move towards 32768, the others towards 0 */
+    const __m256i below = _mm256_cmpgt_epi16(_mm256_set1_epi16((int16_t)val), idx);
+    const __m256i valid = _mm256_cmpgt_epi16(_mm256_set1_epi16((int16_t)(nsyms - 1)), idx);
+    const __m256i up    = _mm256_srl_epi16(_mm256_sub_epi16(_mm256_set1_epi16((int16_t)AOM_ICDF(0)), x), sh);
+    const __m256i down  = _mm256_sub_epi16(_mm256_setzero_si256(), _mm256_srl_epi16(x, sh));
+    const __m256i delta = _mm256_blendv_epi8(down, up, below);
+    const __m256i res   = _mm256_add_epi16(x, _mm256_and_si256(valid, delta));
+    _mm_storeu_si128((__m128i *)(cdf + OD_EC_HI_HALF_START(nsyms)), _mm256_extracti128_si256(res, 1));
+    _mm_storeu_si128((__m128i *)cdf, _mm256_castsi256_si128(res));
+    cdf[nsyms] += (cdf[nsyms] < 32);
+}
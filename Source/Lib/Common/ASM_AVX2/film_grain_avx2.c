@@ -0,0 +1,175 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <immintrin.h>
+#include "EbDefinitions.h"
+#include "common_dsp_rtcd.h"
+
+/* The kernels blend 8 samples at a time in 32-bit lanes, the scaling LUT being read with gathers. The columns
+ * left over are blended by the C kernels. */
+
+/* scaling_lut[index] for 8-bit video */
+static INLINE __m256i fgn_scale_lut_avx2(const int32_t *scaling_lut, __m256i index) {
+    return _mm256_i32gather_epi32((const int *)scaling_lut, index, 4);
+}
+
+/* scaling_lut[index >> (bit_depth - 8)], interpolated with the next entry on the bits shifted out */
+static INLINE __m256i fgn_scale_lut_hbd_avx2(const int32_t *scaling_lut, __m256i index, int32_t bit_depth) {
+    const int32_t shift = bit_depth - 8;
+    const __m128i sh    = _mm_cvtsi32_si128(shift);
+    const __m256i x     = _mm256_srl_epi32(index, sh);
+    const __m256i x1    = _mm256_min_epi32(_mm256_add_epi32(x, _mm256_set1_epi32(1)), _mm256_set1_epi32(255));
+    const __m256i lut0  = _mm256_i32gather_epi32((const int *)scaling_lut, x, 4);
+    const __m256i lut1  = _mm256_i32gather_epi32((const int *)scaling_lut, x1, 4);
+    const __m256i frac  = _mm256_and_si256(index, _mm256_set1_epi32((1 << shift) - 1));
+    const __m256i round = _mm256_set1_epi32(shift ? 1 << (shift - 1) : 0);
+    /* The last entry has no next one, its difference is 0 */
+    const __m256i delta = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(lut1, lut0), frac), round);
+    return _mm256_add_epi32(lut0, _mm256_sra_epi32(delta, sh));
+}
+
+/* clamp(pel + ((scale * grain + round) >> scaling_shift), min_val, max_val) */
+static INLINE __m256i fgn_blend_avx2(__m256i pel, __m256i scale, const int32_t *grain, const FgnPlaneParams *pp) {
+    const __m256i g     = _mm256_loadu_si256((const __m256i *)grain);
+    const __m256i round = _mm256_set1_epi32(1 << (pp->scaling_shift - 1));
+    const __m256i noise = _mm256_sra_epi32(_mm256_add_epi32(_mm256_mullo_epi32(scale, g), round),
+                                           _mm_cvtsi32_si128(pp->scaling_shift));
+    const __m256i res   = _mm256_add_epi32(pel, noise);
+    return _mm256_min_epi32(_mm256_max_epi32(res, _mm256_set1_epi32(pp->min_val)), _mm256_set1_epi32(pp->max_val));
+}
+
+static INLINE void fgn_store_8x8(uint8_t *dst, __m256i v) {
+    const __m128i w = _mm_packs_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    _mm_storel_epi64((__m128i *)dst, _mm_packus_epi16(w, w));
+}
+
+static INLINE void fgn_store_16x8(uint16_t *dst, __m256i v) {
+    _mm_storeu_si128((__m128i *)dst, _mm_packus_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1)));
+}
+
+/* Mix of the chroma and the co-located luma the chroma LUT is indexed by, clamped to [0, max_index] */
+static INLINE __m256i fgn_chroma_index_avx2(__m256i chroma, __m256i average_luma, const FgnPlaneParams *pp,
+                                            int32_t max_index) {
+    const __m256i mix = _mm256_add_epi32(_mm256_mullo_epi32(average_luma, _mm256_set1_epi32(pp->luma_mult)),
+                                         _mm256_mullo_epi32(chroma, _mm256_set1_epi32(pp->mult)));
+    const __m256i idx = _mm256_add_epi32(_mm256_srai_epi32(mix, 6), _mm256_set1_epi32(pp->offset));
+    return _mm256_min_epi32(_mm256_max_epi32(idx, _mm256_setzero_si256()), _mm256_set1_epi32(max_index));
+}
+
+/* Rounded average of the luma sample pairs, from 16 16-bit samples */
+static INLINE __m256i fgn_average_luma_pairs_avx2(__m256i luma) {
+    const __m256i sum = _mm256_madd_epi16(luma, _mm256_set1_epi16(1));
+    return _mm256_srli_epi32(_mm256_add_epi32(sum, _mm256_set1_epi32(1)), 1);
+}
+
+void svt_av1_fgn_add_noise_luma_avx2(uint8_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride,
+                                     int32_t width, int32_t height, const FgnPlaneParams *pp) {
+    const int32_t w8 = width & ~7;
+
+    for (int32_t i = 0; i < height; i++) {
+        uint8_t       *l = luma + i * luma_stride;
+        const int32_t *g = grain + i * grain_stride;
+        for (int32_t j = 0; j < w8; j += 8) {
+            const __m256i pel = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(l + j)));
+            fgn_store_8x8(l + j, fgn_blend_avx2(pel, fgn_scale_lut_avx2(pp->scaling_lut, pel), g + j, pp));
+        }
+    }
+    if (w8 < width)
+        svt_av1_fgn_add_noise_luma_c(luma + w8, luma_stride, grain + w8, grain_stride, width - w8, height, pp);
+}
+
+void svt_av1_fgn_add_noise_luma_hbd_avx2(uint16_t *luma, int32_t luma_stride, const int32_t *grain,
+                                         int32_t grain_stride, int32_t width, int32_t height, int32_t bit_depth,
+                                         const FgnPlaneParams *pp) {
+    const int32_t w8 = width & ~7;
+
+    for (int32_t i = 0; i < height; i++) {
+        uint16_t      *l = luma + i * luma_stride;
+        const int32_t *g = grain + i * grain_stride;
+        for (int32_t j = 0; j < w8; j += 8) {
+            const __m256i pel = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(l + j)));
+            fgn_store_16x8(l + j,
+                           fgn_blend_avx2(pel, fgn_scale_lut_hbd_avx2(pp->scaling_lut, pel, bit_depth), g + j, pp));
+        }
+    }
+    if (w8 < width)
+        svt_av1_fgn_add_noise_luma_hbd_c(
+            luma + w8, luma_stride, grain + w8, grain_stride, width - w8, height, bit_depth, pp);
+}
+
+void svt_av1_fgn_add_noise_chroma_avx2(uint8_t *chroma, int32_t chroma_stride, const uint8_t *luma,
+                                       int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width,
+                                       int32_t height, int32_t subsamp_x, int32_t subsamp_y,
+                                       const FgnPlaneParams *pp) {
+    const int32_t w8 = width & ~7;
+
+    for (int32_t i = 0; i < height; i++) {
+        uint8_t       *c = chroma + i * chroma_stride;
+        const uint8_t *l = luma + (i << subsamp_y) * luma_stride;
+        const int32_t *g = grain + i * grain_stride;
+        for (int32_t j = 0; j < w8; j += 8) {
+            const __m256i pel = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(c + j)));
+            const __m256i avg = subsamp_x ? fgn_average_luma_pairs_avx2(_mm256_cvtepu8_epi16(
+                                                _mm_loadu_si128((const __m128i *)(l + (j << 1)))))
+                                          : _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(l + j)));
+            const __m256i idx = fgn_chroma_index_avx2(pel, avg, pp, 255);
+            fgn_store_8x8(c + j, fgn_blend_avx2(pel, fgn_scale_lut_avx2(pp->scaling_lut, idx), g + j, pp));
+        }
+    }
+    if (w8 < width)
+        svt_av1_fgn_add_noise_chroma_c(chroma + w8,
+                                       chroma_stride,
+                                       luma + (w8 << subsamp_x),
+                                       luma_stride,
+                                       grain + w8,
+                                       grain_stride,
+                                       width - w8,
+                                       height,
+                                       subsamp_x,
+                                       subsamp_y,
+                                       pp);
+}
+
+void svt_av1_fgn_add_noise_chroma_hbd_avx2(uint16_t *chroma, int32_t chroma_stride, const uint16_t *luma,
+                                           int32_t luma_stride, const int32_t *grain, int32_t grain_stride,
+                                           int32_t width, int32_t height, int32_t subsamp_x, int32_t subsamp_y,
+                                           int32_t bit_depth, const FgnPlaneParams *pp) {
+    const int32_t w8        = width & ~7;
+    const int32_t max_index = (256 << (bit_depth - 8)) - 1;
+
+    for (int32_t i = 0; i < height; i++) {
+        uint16_t       *c = chroma + i * chroma_stride;
+        const uint16_t *l = luma + (i << subsamp_y) * luma_stride;
+        const int32_t  *g = grain + i * grain_stride;
+        for (int32_t j = 0; j < w8; j += 8) {
+            const __m256i pel = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(c + j)));
+            const __m256i avg = subsamp_x
+                ? fgn_average_luma_pairs_avx2(_mm256_loadu_si256((const __m256i *)(l + (j << 1))))
+                : _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(l + j)));
+            const __m256i idx = fgn_chroma_index_avx2(pel, avg, pp, max_index);
+            fgn_store_16x8(c + j,
+                           fgn_blend_avx2(pel, fgn_scale_lut_hbd_avx2(pp->scaling_lut, idx, bit_depth), g + j, pp));
+        }
+    }
+    if (w8 < width)
+        svt_av1_fgn_add_noise_chroma_hbd_c(chroma + w8,
+                                           chroma_stride,
+                                           luma + (w8 << subsamp_x),
+                                           luma_stride,
+                                           grain + w8,
+                                           grain_stride,
+                                           width - w8,
+                                           height,
+                                           subsamp_x,
+                                           subsamp_y,
+                                           bit_depth,
+                                           pp);
+}
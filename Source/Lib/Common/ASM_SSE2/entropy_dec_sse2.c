@@ -0,0 +1,115 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <emmintrin.h>
+#include "EbDefinitions.h"
+#include "common_dsp_rtcd.h"
+#include "EbBitstreamUnit.h"
+
+/* The CDF arrays are CDF_SIZE(nsyms) = nsyms + 1 entries long, the last one being the
+ * adaptation counter. To never touch memory past it, a CDF is loaded as two overlapping
+ * halves: the low half starts at icdf[0] and the high half ends at icdf[nsyms] (icdf[15] for
+ * 16 symbols, as the last symbol needs no lane). Lanes of
+ * the high half that duplicate low-half entries compute the same result, and lanes at or
+ * beyond the last symbol are masked out. */
+#define OD_EC_HI_HALF_START(nsyms) (AOMMIN(nsyms, 15) - 7)
+
+/* Packs icdf[0..3] in the low lanes and icdf[nsyms - 3..nsyms] in the high lanes, for nsyms <= 6. */
+static INLINE __m128i od_ec_load_cdf_4x2_sse2(const uint16_t *icdf, int nsyms) {
+    return _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)icdf),
+                              _mm_loadl_epi64((const __m128i *)(icdf + nsyms - 3)));
+}
+
+/* Lane to symbol index offsets matching od_ec_load_cdf_4x2_sse2(). */
+static INLINE __m128i od_ec_hi_offset_4x2_sse2(int nsyms) {
+    return _mm_unpacklo_epi64(_mm_setzero_si128(), _mm_set1_epi16((int16_t)(nsyms - 7)));
+}
+
+static INLINE int hmax_epi16_sse2(__m128i x) {
+    x = _mm_max_epi16(x, _mm_srli_si128(x, 8));
+    x = _mm_max_epi16(x, _mm_srli_si128(x, 4));
+    x = _mm_max_epi16(x, _mm_srli_si128(x, 2));
+    return _mm_extract_epi16(x, 0);
+}
+
+/* Returns, per lane, idx + 1 if the window is below the bound of symbol idx, otherwise 0. The
+ * largest lane is the decoded symbol as the bounds decrease monotonically. */
+static INLINE __m128i od_ec_search_sse2(__m128i icdf, __m128i idx, __m128i n, __m128i rng, __m128i c1) {
+    /* ((r >> 8) * (icdf >> EC_PROB_SHIFT)) >> 1, as the high half of ((r >> 8) << 8) * ((icdf >> 6) << 7) */
+    const __m128i p = _mm_slli_epi16(_mm_srli_epi16(icdf, EC_PROB_SHIFT), 7);
+    __m128i       v = _mm_mulhi_epu16(p, rng);
+    v               = _mm_add_epi16(v, _mm_slli_epi16(_mm_sub_epi16(n, idx), 2)); /* EC_MIN_PROB * (N - idx) */
+    /* c < v, unsigned */
+    const __m128i below = _mm_cmpeq_epi16(_mm_subs_epu16(c1, v), _mm_setzero_si128());
+    const __m128i valid = _mm_cmplt_epi16(idx, n);
+    return _mm_and_si128(_mm_and_si128(below, valid), _mm_add_epi16(idx, _mm_set1_epi16(1)));
+}
+
+int svt_od_ec_find_symbol_sse2(const uint16_t *icdf, int nsyms, uint32_t c, uint32_t r) {
+    if (nsyms < 3)
+        return svt_od_ec_find_symbol_c(icdf, nsyms, c, r);
+    const __m128i n    = _mm_set1_epi16((int16_t)(nsyms - 1));
+    const __m128i rng  = _mm_set1_epi16((int16_t)(r & 0xFF00));
+    const __m128i c1   = _mm_set1_epi16((int16_t)(c + 1));
+    const __m128i lane = _mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7);
+
+    if (nsyms <= 6) {
+        const __m128i cdf = od_ec_load_cdf_4x2_sse2(icdf, nsyms);
+        const __m128i idx = _mm_add_epi16(lane, od_ec_hi_offset_4x2_sse2(nsyms));
+        return hmax_epi16_sse2(od_ec_search_sse2(cdf, idx, n, rng, c1));
+    }
+    const int     o      = OD_EC_HI_HALF_START(nsyms);
+    const __m128i lo     = _mm_loadu_si128((const __m128i *)icdf);
+    const __m128i hi     = _mm_loadu_si128((const __m128i *)(icdf + o));
+    const __m128i idx_hi = _mm_add_epi16(lane, _mm_set1_epi16((int16_t)o));
+    return hmax_epi16_sse2(
+        _mm_max_epi16(od_ec_search_sse2(lo, lane, n, rng, c1), od_ec_search_sse2(hi, idx_hi, n, rng, c1)));
+}
+
+/* Moves the symbols below val towards 32768 and the others towards 0 by 1 / 2^rate of the
+ * distance, leaving the lanes at or beyond the last symbol untouched. */
+static INLINE __m128i od_ec_adapt_sse2(__m128i cdf, __m128i idx, __m128i n, __m128i val, __m128i rate) {
+    const __m128i below = _mm_cmplt_epi16(idx, val);
+    const __m128i valid = _mm_cmplt_epi16(idx, n);
+    const __m128i up    = _mm_srl_epi16(_mm_sub_epi16(_mm_set1_epi16((int16_t)AOM_ICDF(0)), cdf), rate);
+    const __m128i down  = _mm_sub_epi16(_mm_setzero_si128(), _mm_srl_epi16(cdf, rate));
+    const __m128i delta = _mm_or_si128(_mm_and_si128(below, up), _mm_andnot_si128(below, down));
+    return _mm_add_epi16(cdf, _mm_and_si128(valid, delta));
+}
+
+void svt_od_ec_update_cdf_sse2(uint16_t *cdf, int val, int nsyms) {
+    static const int nsymbs2speed[17] = {0, 0, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2};
+    if (nsyms < 3) {
+        svt_od_ec_update_cdf_c(cdf, val, nsyms);
+        return;
+    }
+    assert(nsyms < 17);
+    const int     rate = 3 + (cdf[nsyms] > 15) + (cdf[nsyms] > 31) + nsymbs2speed[nsyms];
+    const __m128i sh   = _mm_cvtsi32_si128(rate);
+    const __m128i n    = _mm_set1_epi16((int16_t)(nsyms - 1));
+    const __m128i v    = _mm_set1_epi16((int16_t)val);
+    const __m128i lane = _mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7);
+
+    if (nsyms <= 6) {
+        const __m128i idx = _mm_add_epi16(lane, od_ec_hi_offset_4x2_sse2(nsyms));
+        const __m128i res = od_ec_adapt_sse2(od_ec_load_cdf_4x2_sse2(cdf, nsyms), idx, n, v, sh);
+        _mm_storel_epi64((__m128i *)(cdf + nsyms - 3), _mm_srli_si128(res, 8));
+        _mm_storel_epi64((__m128i *)cdf, res);
+    } else {
+        const int     o      = OD_EC_HI_HALF_START(nsyms);
+        const __m128i idx_hi = _mm_add_epi16(lane, _mm_set1_epi16((int16_t)o));
+        const __m128i lo     = od_ec_adapt_sse2(_mm_loadu_si128((const __m128i *)cdf), lane, n, v, sh);
+        const __m128i hi     = od_ec_adapt_sse2(_mm_loadu_si128((const __m128i *)(cdf + o)), idx_hi, n, v, sh);
+        _mm_storeu_si128((__m128i *)(cdf + o), hi);
+        _mm_storeu_si128((__m128i *)cdf, lo);
+    }
+    cdf[nsyms] += (cdf[nsyms] < 32);
+}
@@ -0,0 +1,95 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <stdlib.h>
+
+#include "EbArena.h"
+#include "EbMalloc.h"
+#include "EbUtility.h"
+#include "EbLog.h"
+
+#define ARENA_ALIGN(x) (((x) + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1))
+
+// Header at the start of each block, the data follows it
+struct EbArenaBlock {
+    EbArenaBlock *prev;
+    size_t        size;
+    size_t        offset;
+};
+
+#define ARENA_HEADER_SIZE ARENA_ALIGN(sizeof(EbArenaBlock))
+
+static void arena_dctor(EbPtr p) {
+    EbArena *obj = (EbArena *)p;
+    while (obj->block) {
+        EbArenaBlock *prev = obj->block->prev;
+        EB_FREE(obj->block);
+        obj->block = prev;
+    }
+}
+
+EbErrorType svt_arena_ctor(EbArena *arena, EbArenaStats *stats, size_t block_size) {
+    arena->dctor      = arena_dctor;
+    arena->stats      = stats;
+    arena->block_size = ARENA_ALIGN(block_size);
+    if (stats) {
+        arena->block_size = MAX(arena->block_size, stats->high_water);
+        stats->arena_count++;
+    }
+    return EB_ErrorNone;
+}
+
+static EbArenaBlock *arena_new_block(EbArena *arena, size_t size) {
+    EbArenaBlock *block;
+    const size_t  data_size = MAX(arena->block_size, size);
+    EB_NO_THROW_MALLOC(block, ARENA_HEADER_SIZE + data_size);
+    if (!block)
+        return NULL;
+    block->prev   = arena->block;
+    block->size   = data_size;
+    block->offset = 0;
+    arena->block  = block;
+    if (arena->stats) {
+        arena->stats->block_count++;
+        arena->stats->reserved += data_size;
+    }
+    return block;
+}
+
+void *svt_arena_alloc(EbArena *arena, size_t size) {
+    EbArenaBlock *block = arena->block;
+    size                = ARENA_ALIGN(size);
+    if (!block || block->size - block->offset < size) {
+        block = arena_new_block(arena, size);
+        if (!block)
+            return NULL;
+    }
+    uint8_t *p = (uint8_t *)block + ARENA_HEADER_SIZE + block->offset;
+    block->offset += size;
+    arena->used += size;
+    if (arena->stats) {
+        arena->stats->alloc_count++;
+        arena->stats->high_water = MAX(arena->stats->high_water, arena->used);
+    }
+    return p;
+}
+
+void svt_arena_stats_report(const EbArenaStats *stats) {
+    if (!stats->arena_count)
+        return;
+    SVT_DEBUG("%s arenas: %u arenas, %u blocks, %llu allocations, high-water %.2f KB, reserved %.2f KB\n",
+              stats->name,
+              stats->arena_count,
+              stats->block_count,
+              (unsigned long long)stats->alloc_count,
+              stats->high_water / 1024.0,
+              stats->reserved / 1024.0);
+}
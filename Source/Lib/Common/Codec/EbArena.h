@@ -0,0 +1,107 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbArena_h
+#define EbArena_h
+
+#include <string.h>
+
+#include "EbDefinitions.h"
+#include "EbObject.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Alignment of every arena allocation, the one malloc guarantees
+#define ARENA_ALIGNMENT 16
+// Size of the first block of an arena whose type has no high-water mark yet
+#define ARENA_DEFAULT_BLOCK_SIZE (256 * 1024)
+
+/*********************************************************************
+ * Arena Statistics
+ *   Shared by all the arenas of one object type, e.g. the arenas of the
+ *   picture control sets of a pool. The high-water mark sizes the first
+ *   block of the next arenas of the type so that they need a single
+ *   block. Only updated while the arenas are built, which the resource
+ *   pools do one object at a time, so no lock is taken.
+ *********************************************************************/
+typedef struct EbArenaStats {
+    const char *name;
+    uint32_t    arena_count;
+    uint32_t    block_count;
+    uint64_t    alloc_count;
+    // Most bytes handed out by a single arena
+    size_t high_water;
+    // Bytes of the blocks of all the arenas
+    size_t reserved;
+} EbArenaStats;
+
+typedef struct EbArenaBlock EbArenaBlock;
+
+/*********************************************************************
+ * Arena
+ *   Bump allocator for the many small buffers that live as long as their
+ *   owner: they are carved out of a few large blocks and all released by
+ *   the arena dctor, with no per-buffer free or memory entry.
+ *********************************************************************/
+typedef struct EbArena {
+    EbDctor       dctor;
+    EbArenaStats *stats;
+    EbArenaBlock *block;
+    size_t        block_size;
+    size_t        used;
+} EbArena;
+
+/*********************************************************************
+ * svt_arena_ctor
+ *   stats
+ *     Statistics of the object type, may be NULL.
+ *
+ *   block_size
+ *     Minimum size of the blocks, raised to the high-water mark of stats.
+ *********************************************************************/
+extern EbErrorType svt_arena_ctor(EbArena *arena, EbArenaStats *stats, size_t block_size);
+
+// Returns size bytes aligned on ARENA_ALIGNMENT, NULL when out of memory
+extern void *svt_arena_alloc(EbArena *arena, size_t size);
+
+// Logs the statistics of an object type (debug level)
+extern void svt_arena_stats_report(const EbArenaStats *stats);
+
+#define EB_ARENA_MALLOC_ARRAY(arena, pa, count)                      \
+    do {                                                             \
+        (pa) = svt_arena_alloc((arena), sizeof(*(pa)) * (count));    \
+        if (!(pa))                                                   \
+            return EB_ErrorInsufficientResources;                    \
+    } while (0)
+
+#define EB_ARENA_CALLOC_ARRAY(arena, pa, count)                      \
+    do {                                                             \
+        EB_ARENA_MALLOC_ARRAY(arena, pa, count);                     \
+        memset((pa), 0, sizeof(*(pa)) * (count));                    \
+    } while (0)
+
+// Builds an object in the arena. The ctor must take its buffers from the
+// same arena and leave dctor NULL: the object is never deleted on its own.
+#define EB_ARENA_NEW(arena, pobj, ctor, ...)                 \
+    do {                                                     \
+        EbErrorType err;                                     \
+        EB_ARENA_CALLOC_ARRAY(arena, pobj, 1);               \
+        err = ctor(pobj EB_VA_ARGS(__VA_ARGS__));            \
+        if (err != EB_ErrorNone)                             \
+            return err;                                      \
+    } while (0)
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbArena_h
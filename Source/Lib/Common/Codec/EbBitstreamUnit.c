@@ -407,3 +407,38 @@ int32_t svt_od_ec_enc_tell(const OdEcEnc *enc) {
 /********************************************************************************************************************************/
 /********************************************************************************************************************************/
 /********************************************************************************************************************************/
+//entdec.c kernels, dispatched through rtcd by the decoder's daala reader
+
+/*Finds the symbol the decoder window falls in.
+icdf: 32768 minus the CDF, monotonically decreasing, with icdf[nsyms - 1] == 0.
+c: The top 16 bits of the decoder window (dif).
+r: The current range, 32768 <= r < 65536.
+Return: The first index s for which c is not below the scaled bound of icdf[s].*/
+int svt_od_ec_find_symbol_c(const uint16_t *icdf, int nsyms, uint32_t c, uint32_t r) {
+    const int N = nsyms - 1;
+    uint32_t  v;
+    int       ret = -1;
+    do {
+        v = ((r >> 8) * (uint32_t)(icdf[++ret] >> EC_PROB_SHIFT) >> (7 - EC_PROB_SHIFT - CDF_SHIFT));
+        v += EC_MIN_PROB * (N - ret);
+    } while (c < v);
+    return ret;
+}
+
+/*Adapts an inverse CDF towards the decoded symbol val, including the counter
+stored at icdf[nsyms].*/
+void svt_od_ec_update_cdf_c(uint16_t *cdf, int val, int nsyms) {
+    static const int nsymbs2speed[17] = {0, 0, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2};
+    assert(nsyms < 17);
+    const int rate = 3 + (cdf[nsyms] > 15) + (cdf[nsyms] > 31) + nsymbs2speed[nsyms];
+    int       tmp  = AOM_ICDF(0);
+
+    for (int i = 0; i < nsyms - 1; ++i) {
+        tmp = (i == val) ? 0 : tmp;
+        if (tmp < cdf[i])
+            cdf[i] -= (uint16_t)((cdf[i] - tmp) >> rate);
+        else
+            cdf[i] += (uint16_t)((tmp - cdf[i]) >> rate);
+    }
+    cdf[nsyms] += (cdf[nsyms] < 32);
+}
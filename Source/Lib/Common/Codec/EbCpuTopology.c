@@ -0,0 +1,267 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "EbThreads.h"
+#include "EbCpuTopology.h"
+
+#define CPU_MASK_WORD(cpu) ((cpu) >> 6)
+#define CPU_MASK_BIT(cpu) ((uint64_t)1 << ((cpu)&63))
+
+static Bool cpu_mask_has(const uint64_t *mask, uint32_t cpu) {
+    return (mask[CPU_MASK_WORD(cpu)] & CPU_MASK_BIT(cpu)) != 0;
+}
+
+static uint32_t cpu_mask_count(const uint64_t *mask) {
+    uint32_t count = 0;
+    for (uint32_t cpu = 0; cpu < EB_CPU_TOPOLOGY_MAX_CPUS; ++cpu) count += cpu_mask_has(mask, cpu);
+    return count;
+}
+
+#if defined(__linux__) && !defined(__ANDROID__)
+
+#include <stdlib.h>
+
+/*********************************************************************
+ * parse_cpu_list
+ *   Parses a sysfs cpu list, e.g. "0-7,64-71", into mask.
+ *********************************************************************/
+static Bool parse_cpu_list(const char *list, uint64_t *mask) {
+    const char *ptr = list;
+
+    memset(mask, 0, EB_CPU_TOPOLOGY_MAX_CPUS / 8);
+    while (*ptr >= '0' && *ptr <= '9') {
+        char         *end;
+        unsigned long first = strtoul(ptr, &end, 10);
+        unsigned long last  = first;
+        if (*end == '-')
+            last = strtoul(end + 1, &end, 10);
+        if (last < first || last >= EB_CPU_TOPOLOGY_MAX_CPUS)
+            return FALSE;
+        for (unsigned long cpu = first; cpu <= last; ++cpu) mask[CPU_MASK_WORD(cpu)] |= CPU_MASK_BIT(cpu);
+        ptr = *end == ',' ? end + 1 : end;
+    }
+    return cpu_mask_count(mask) != 0;
+}
+
+/*********************************************************************
+ * read_l3_cpu_list
+ *   Reads the processors sharing the L3 cache of cpu. Returns FALSE when
+ *   the cache topology of cpu does not list an L3 cache.
+ *********************************************************************/
+static Bool read_l3_cpu_list(uint32_t cpu, uint64_t *mask) {
+    for (uint32_t index = 0;; ++index) {
+        char  path[128];
+        char  line[4096];
+        FILE *file;
+        int   level = 0;
+
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/cache/index%u/level", cpu, index);
+        if (!(file = fopen(path, "r")))
+            return FALSE;
+        if (fscanf(file, "%d", &level) != 1)
+            level = 0;
+        fclose(file);
+        if (level != 3)
+            continue;
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/cache/index%u/shared_cpu_list", cpu, index);
+        if (!(file = fopen(path, "r")))
+            return FALSE;
+        const Bool read = fgets(line, sizeof(line), file) != NULL;
+        fclose(file);
+        return read && parse_cpu_list(line, mask);
+    }
+}
+
+static void get_allowed_cpus(EbHandle thread_handle, uint64_t *mask) {
+    cpu_set_t cpu_set;
+
+    CPU_ZERO(&cpu_set);
+    memset(mask, 0, EB_CPU_TOPOLOGY_MAX_CPUS / 8);
+    if (thread_handle ? pthread_getaffinity_np(*(pthread_t *)thread_handle, sizeof(cpu_set), &cpu_set)
+                      : sched_getaffinity(0, sizeof(cpu_set), &cpu_set))
+        return;
+    for (uint32_t cpu = 0; cpu < EB_CPU_TOPOLOGY_MAX_CPUS && cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &cpu_set))
+            mask[CPU_MASK_WORD(cpu)] |= CPU_MASK_BIT(cpu);
+    }
+}
+
+/*********************************************************************
+ * build_l3_domains
+ *   One domain per L3 cache, restricted to the allowed processors.
+ *   Returns FALSE when a processor does not list its L3 cache.
+ *********************************************************************/
+static Bool build_l3_domains(EbCpuTopology *topology_ptr, const uint64_t *allowed) {
+    uint64_t assigned[EB_CPU_TOPOLOGY_MAX_CPUS / 64] = {0};
+    uint64_t l3_mask[EB_CPU_TOPOLOGY_MAX_CPUS / 64];
+
+    topology_ptr->domain_count = 0;
+    for (uint32_t cpu = 0; cpu < EB_CPU_TOPOLOGY_MAX_CPUS; ++cpu) {
+        if (!cpu_mask_has(allowed, cpu) || cpu_mask_has(assigned, cpu))
+            continue;
+        if (!read_l3_cpu_list(cpu, l3_mask) || !cpu_mask_has(l3_mask, cpu) ||
+            topology_ptr->domain_count == EB_CPU_TOPOLOGY_MAX_DOMAINS)
+            return FALSE;
+        EbCpuDomain *domain_ptr = &topology_ptr->domain_array[topology_ptr->domain_count++];
+        for (uint32_t word = 0; word < EB_CPU_TOPOLOGY_MAX_CPUS / 64; ++word) {
+            domain_ptr->cpu_mask[word] = l3_mask[word] & allowed[word] & ~assigned[word];
+            assigned[word] |= domain_ptr->cpu_mask[word];
+        }
+        domain_ptr->cpu_count = cpu_mask_count(domain_ptr->cpu_mask);
+    }
+    return topology_ptr->domain_count != 0;
+}
+
+/*********************************************************************
+ * read_nodes
+ *   Sets the NUMA node of the domains and lists the nodes of their
+ *   processors. Without the node topology, every processor is on node 0.
+ *********************************************************************/
+static void read_nodes(EbCpuTopology *topology_ptr) {
+    uint64_t node_mask[EB_CPU_TOPOLOGY_MAX_CPUS / 64];
+    Bool     listed[EB_CPU_TOPOLOGY_MAX_NODES] = {FALSE};
+
+    for (uint32_t domain_index = 0; domain_index < topology_ptr->domain_count; ++domain_index)
+        topology_ptr->domain_array[domain_index].node_id = 0;
+    for (uint32_t node_id = 0; node_id < EB_CPU_TOPOLOGY_MAX_NODES; ++node_id) {
+        char  path[64];
+        char  line[4096];
+        FILE *file;
+
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%u/cpulist", node_id);
+        if (!(file = fopen(path, "r")))
+            continue;
+        const Bool read = fgets(line, sizeof(line), file) != NULL;
+        fclose(file);
+        if (!read || !parse_cpu_list(line, node_mask))
+            continue;
+        for (uint32_t domain_index = 0; domain_index < topology_ptr->domain_count; ++domain_index) {
+            EbCpuDomain *domain_ptr = &topology_ptr->domain_array[domain_index];
+            Bool         first      = TRUE;
+            for (uint32_t cpu = 0; cpu < EB_CPU_TOPOLOGY_MAX_CPUS; ++cpu) {
+                if (!cpu_mask_has(domain_ptr->cpu_mask, cpu))
+                    continue;
+                if (cpu_mask_has(node_mask, cpu)) {
+                    listed[node_id] = TRUE;
+                    if (first)
+                        domain_ptr->node_id = node_id;
+                    break;
+                }
+                first = FALSE;
+            }
+        }
+    }
+    topology_ptr->node_count = 0;
+    for (uint32_t node_id = 0; node_id < EB_CPU_TOPOLOGY_MAX_NODES; ++node_id) {
+        if (listed[node_id])
+            topology_ptr->node_array[topology_ptr->node_count++] = node_id;
+    }
+    if (!topology_ptr->node_count)
+        topology_ptr->node_array[topology_ptr->node_count++] = 0;
+}
+
+/*********************************************************************
+ * svt_cpu_topology_ctor
+ *********************************************************************/
+EbErrorType svt_cpu_topology_ctor(EbCpuTopology *topology_ptr, EbHandle thread_handle) {
+    uint64_t allowed[EB_CPU_TOPOLOGY_MAX_CPUS / 64];
+
+    get_allowed_cpus(thread_handle, allowed);
+    if (!cpu_mask_count(allowed) || !build_l3_domains(topology_ptr, allowed)) {
+        // Single domain, the threads are not bound
+        memset(topology_ptr->domain_array, 0, sizeof(topology_ptr->domain_array[0]));
+        memcpy(topology_ptr->domain_array[0].cpu_mask, allowed, sizeof(allowed));
+        topology_ptr->domain_array[0].cpu_count = cpu_mask_count(allowed);
+        topology_ptr->domain_count              = 1;
+    }
+    read_nodes(topology_ptr);
+    topology_ptr->cpu_count = 0;
+    for (uint32_t domain_index = 0; domain_index < topology_ptr->domain_count; ++domain_index)
+        topology_ptr->cpu_count += topology_ptr->domain_array[domain_index].cpu_count;
+    if (!topology_ptr->cpu_count) {
+        topology_ptr->domain_array[0].cpu_count = 1;
+        topology_ptr->cpu_count                 = 1;
+    }
+    return EB_ErrorNone;
+}
+
+/*********************************************************************
+ * svt_cpu_topology_bind_thread
+ *********************************************************************/
+Bool svt_cpu_topology_bind_thread(const EbCpuTopology *topology_ptr, uint32_t domain_index, EbHandle thread_handle) {
+    if (topology_ptr->domain_count < 2 || domain_index >= topology_ptr->domain_count || !thread_handle)
+        return FALSE;
+    const EbCpuDomain *domain_ptr = &topology_ptr->domain_array[domain_index];
+    cpu_set_t          cpu_set;
+
+    CPU_ZERO(&cpu_set);
+    for (uint32_t cpu = 0; cpu < EB_CPU_TOPOLOGY_MAX_CPUS && cpu < CPU_SETSIZE; ++cpu) {
+        if (cpu_mask_has(domain_ptr->cpu_mask, cpu))
+            CPU_SET(cpu, &cpu_set);
+    }
+    return CPU_COUNT(&cpu_set) && !pthread_setaffinity_np(*(pthread_t *)thread_handle, sizeof(cpu_set), &cpu_set);
+}
+
+#else
+
+/*********************************************************************
+ * svt_cpu_topology_ctor
+ *********************************************************************/
+EbErrorType svt_cpu_topology_ctor(EbCpuTopology *topology_ptr, EbHandle thread_handle) {
+    (void)thread_handle;
+    // The processors are not listed, the single domain only weights the workers
+    memset(topology_ptr->domain_array, 0, sizeof(topology_ptr->domain_array[0]));
+    topology_ptr->domain_array[0].cpu_count = 1;
+    topology_ptr->domain_count              = 1;
+    topology_ptr->cpu_count                 = 1;
+    topology_ptr->node_array[0]             = 0;
+    topology_ptr->node_count                = 1;
+    return EB_ErrorNone;
+}
+
+/*********************************************************************
+ * svt_cpu_topology_bind_thread
+ *********************************************************************/
+Bool svt_cpu_topology_bind_thread(const EbCpuTopology *topology_ptr, uint32_t domain_index, EbHandle thread_handle) {
+    (void)topology_ptr;
+    (void)domain_index;
+    (void)thread_handle;
+    return FALSE;
+}
+
+#endif
+
+/*********************************************************************
+ * svt_cpu_topology_format_domain
+ *********************************************************************/
+void svt_cpu_topology_format_domain(const EbCpuTopology *topology_ptr, uint32_t domain_index, char *string,
+                                    size_t size) {
+    const uint64_t *mask   = topology_ptr->domain_array[domain_index].cpu_mask;
+    size_t          length = 0;
+
+    string[0] = '\0';
+    for (uint32_t cpu = 0; cpu < EB_CPU_TOPOLOGY_MAX_CPUS && length < size; ++cpu) {
+        if (!cpu_mask_has(mask, cpu))
+            continue;
+        uint32_t last = cpu;
+        while (last + 1 < EB_CPU_TOPOLOGY_MAX_CPUS && cpu_mask_has(mask, last + 1)) ++last;
+        const int written = last == cpu
+            ? snprintf(string + length, size - length, "%s%u", length ? "," : "", cpu)
+            : snprintf(string + length, size - length, "%s%u-%u", length ? "," : "", cpu, last);
+        if (written < 0)
+            break;
+        length += (size_t)written;
+        cpu = last;
+    }
+}
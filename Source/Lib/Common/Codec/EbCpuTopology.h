@@ -0,0 +1,79 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbCpuTopology_h
+#define EbCpuTopology_h
+
+#include "EbDefinitions.h"
+#include "EbObject.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************************************************************
+ * CPU Topology
+ *   Splits the logical processors a thread may run on into cache domains,
+ *   the processors sharing the same last level (L3) cache, e.g. the CCXs
+ *   of a multi-CCX part. The domains are read from the Linux sysfs cache
+ *   topology; elsewhere, or when the topology can not be read, all the
+ *   processors form a single domain. The NUMA nodes of the processors are
+ *   read from the sysfs node topology, a single node 0 otherwise.
+ *********************************************************************/
+// Logical processors, cache domains and NUMA nodes tracked at most
+#define EB_CPU_TOPOLOGY_MAX_CPUS 1024
+#define EB_CPU_TOPOLOGY_MAX_DOMAINS 64
+#define EB_CPU_TOPOLOGY_MAX_NODES 64
+
+typedef struct EbCpuDomain {
+    uint64_t cpu_mask[EB_CPU_TOPOLOGY_MAX_CPUS / 64];
+    uint32_t cpu_count;
+    // NUMA node of the first processor of the domain
+    uint32_t node_id;
+} EbCpuDomain;
+
+typedef struct EbCpuTopology {
+    EbDctor     dctor;
+    EbCpuDomain domain_array[EB_CPU_TOPOLOGY_MAX_DOMAINS];
+    uint32_t    domain_count;
+    // Sum of the processor counts of the domains
+    uint32_t cpu_count;
+    // NUMA nodes of the processors of the domains, by increasing id
+    uint32_t node_array[EB_CPU_TOPOLOGY_MAX_NODES];
+    uint32_t node_count;
+} EbCpuTopology;
+
+/*********************************************************************
+ * svt_cpu_topology_ctor
+ *   Builds the cache domains of the processors thread_handle may run on,
+ *   the ones of the calling thread when thread_handle is NULL.
+ *********************************************************************/
+extern EbErrorType svt_cpu_topology_ctor(EbCpuTopology *topology_ptr, EbHandle thread_handle);
+
+/*********************************************************************
+ * svt_cpu_topology_bind_thread
+ *   Restricts thread_handle to the processors of a domain. Returns FALSE
+ *   when the thread is left as is.
+ *********************************************************************/
+extern Bool svt_cpu_topology_bind_thread(const EbCpuTopology *topology_ptr, uint32_t domain_index,
+                                         EbHandle thread_handle);
+
+/*********************************************************************
+ * svt_cpu_topology_format_domain
+ *   Writes the processor list of a domain, e.g. "0-7,64-71", to string.
+ *********************************************************************/
+extern void svt_cpu_topology_format_domain(const EbCpuTopology *topology_ptr, uint32_t domain_index, char *string,
+                                           size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbCpuTopology_h
@@ -589,6 +589,18 @@ typedef struct ConvolveParams {
     int32_t      use_dist_wtd_comp_avg;
 } ConvolveParams;
 
+/* Film grain blending constants of one plane, see grainSynthesis.c */
+typedef struct FgnPlaneParams {
+    const int32_t *scaling_lut; // 256 entries
+    int32_t        scaling_shift;
+    int32_t        min_val;
+    int32_t        max_val;
+    // chroma only, mix of the chroma and the co-located luma indexing the LUT
+    int32_t mult;
+    int32_t luma_mult;
+    int32_t offset;
+} FgnPlaneParams;
+
 // texture component type
 typedef enum ATTRIBUTE_PACKED {
     COMPONENT_LUMA      = 0, // luma
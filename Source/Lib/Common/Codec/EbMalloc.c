@@ -13,6 +13,10 @@
 
 #include "EbMalloc.h"
 #include "EbThreads.h"
+#if defined(__linux__) && !defined(__ANDROID__)
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
 #define LOG_TAG "SvtMalloc"
 #include "EbLog.h"
 
@@ -20,6 +24,68 @@ void svt_print_alloc_fail_impl(const char* file, int line) {
     SVT_FATAL("allocate memory failed, at %s:%d\n", file, line);
 }
 
+#ifdef _MSC_VER
+#define MALLOC_THREAD_LOCAL __declspec(thread)
+#else
+#define MALLOC_THREAD_LOCAL __thread
+#endif
+
+// Node of the aligned allocations of the thread, plus one, 0 for none
+static MALLOC_THREAD_LOCAL uint32_t g_numa_node_plus_one;
+static MALLOC_THREAD_LOCAL uint64_t g_numa_bound_bytes;
+static MALLOC_THREAD_LOCAL uint64_t g_numa_unbound_bytes;
+
+void svt_numa_set_allocation_node(int32_t node_id) { g_numa_node_plus_one = node_id < 0 ? 0 : (uint32_t)node_id + 1; }
+
+void svt_numa_get_allocation_bytes(uint64_t* bound_bytes, uint64_t* unbound_bytes) {
+    *bound_bytes   = g_numa_bound_bytes;
+    *unbound_bytes = g_numa_unbound_bytes;
+}
+
+#if defined(__linux__) && !defined(__ANDROID__) && defined(SYS_mbind)
+// Preferred node policy, moving the pages already touched
+#define NUMA_MPOL_PREFERRED 1
+#define NUMA_MPOL_MF_MOVE (1 << 1)
+
+/*********************************************************************
+ * svt_numa_bind_allocation
+ *   Binds the whole pages of an aligned allocation to the node of the
+ *   thread, the pages shared with other allocations are left as is.
+ *********************************************************************/
+void svt_numa_bind_allocation(void* ptr, size_t size) {
+    if (!g_numa_node_plus_one || !ptr)
+        return;
+    const uint32_t node_id = g_numa_node_plus_one - 1;
+    const long     page    = sysconf(_SC_PAGESIZE);
+    if (page <= 0 || node_id >= 64) {
+        g_numa_unbound_bytes += size;
+        return;
+    }
+    const uintptr_t start = ((uintptr_t)ptr + (uintptr_t)page - 1) & ~((uintptr_t)page - 1);
+    const uintptr_t end   = ((uintptr_t)ptr + size) & ~((uintptr_t)page - 1);
+    if (end <= start) {
+        g_numa_unbound_bytes += size;
+        return;
+    }
+    unsigned long node_mask = 1UL << node_id;
+    if (syscall(SYS_mbind,
+                (void*)start,
+                (unsigned long)(end - start),
+                NUMA_MPOL_PREFERRED,
+                &node_mask,
+                sizeof(node_mask) * 8 + 1,
+                NUMA_MPOL_MF_MOVE))
+        g_numa_unbound_bytes += size;
+    else
+        g_numa_bound_bytes += size;
+}
+#else
+void svt_numa_bind_allocation(void* ptr, size_t size) {
+    if (g_numa_node_plus_one && ptr)
+        g_numa_unbound_bytes += size;
+}
+#endif
+
 #ifdef DEBUG_MEMORY_USAGE
 
 static EbHandle g_malloc_mutex;
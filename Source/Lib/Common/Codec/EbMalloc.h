@@ -27,6 +27,13 @@
 #endif
 void svt_print_alloc_fail_impl(const char* file, int line);
 
+/* NUMA node the aligned allocations of the calling thread are bound to, -1 for
+ * none. The bytes bound, or left unbound when binding failed, are summed per
+ * thread. */
+void svt_numa_set_allocation_node(int32_t node_id);
+void svt_numa_bind_allocation(void* ptr, size_t size);
+void svt_numa_get_allocation_bytes(uint64_t* bound_bytes, uint64_t* unbound_bytes);
+
 #ifdef DEBUG_MEMORY_USAGE
 void svt_print_memory_usage(void);
 void svt_increase_component_count(void);
@@ -170,6 +177,7 @@ void svt_remove_mem_entry(void* ptr, EbPtrType type);
     do {                                          \
         pointer = _aligned_malloc(size, ALVALUE); \
         EB_ADD_MEM(pointer, size, EB_A_PTR);      \
+        svt_numa_bind_allocation(pointer, size);  \
     } while (0)
 
 #define EB_FREE_ALIGNED(pointer)                \
@@ -184,6 +192,7 @@ void svt_remove_mem_entry(void* ptr, EbPtrType type);
         if (posix_memalign((void**)&(pointer), ALVALUE, size) != 0) \
             return EB_ErrorInsufficientResources;                   \
         EB_ADD_MEM(pointer, size, EB_A_PTR);                        \
+        svt_numa_bind_allocation(pointer, size);                    \
     } while (0)
 
 #define EB_FREE_ALIGNED(pointer)                \
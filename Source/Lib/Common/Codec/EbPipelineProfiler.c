@@ -0,0 +1,245 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "EbPipelineProfiler.h"
+#include "EbThreads.h"
+#include "EbUtility.h"
+#include "EbTime.h"
+#include "EbLog.h"
+
+#ifdef _MSC_VER
+#define PROFILER_THREAD_LOCAL __declspec(thread)
+#else
+#define PROFILER_THREAD_LOCAL __thread
+#endif
+
+#define PIPELINE_EVENT_MASK ((1u << PIPELINE_EVENT_COUNT_LOG2) - 1)
+
+// Index of the calling thread in the trace, 0 until its first event
+static PROFILER_THREAD_LOCAL uint32_t current_thread_index;
+static volatile int32_t               thread_total_count;
+
+static uint32_t pipeline_profiler_thread_index(void) {
+    if (!current_thread_index)
+        current_thread_index = (uint32_t)svt_atomic_fetch_add_i32(&thread_total_count, 1) + 1;
+    return current_thread_index;
+}
+
+typedef struct PictureLatency {
+    uint64_t picture_number;
+    uint64_t start_time;
+    uint64_t end_time;
+} PictureLatency;
+
+static int picture_latency_cmp(const void *a, const void *b) {
+    const PictureLatency *latency_a = (const PictureLatency *)a;
+    const PictureLatency *latency_b = (const PictureLatency *)b;
+    if (latency_a->picture_number != latency_b->picture_number)
+        return latency_a->picture_number < latency_b->picture_number ? -1 : 1;
+    return 0;
+}
+
+/*********************************************************************
+ * pipeline_profiler_export
+ *   Writes the events kept as a Chrome trace-event JSON file and logs the
+ *   summary: per-stage compute and queue wait times, per-thread
+ *   utilization and per-picture latency, from the first post of the
+ *   picture to any stage to the end of its last event.
+ *********************************************************************/
+static void pipeline_profiler_export(EbPipelineProfiler *obj) {
+    const uint32_t event_total = obj->event_count;
+    const uint32_t event_count = MIN(event_total, PIPELINE_EVENT_MASK + 1);
+    const uint32_t first_event = event_total - event_count;
+    const uint32_t thread_count = (uint32_t)thread_total_count + 1;
+    uint64_t      *stage_run_array, *stage_queue_array, *thread_run_array;
+    uint32_t      *stage_count_array;
+    PictureLatency *latency_array;
+    uint32_t        latency_count = 0;
+    uint64_t        first_time = (uint64_t)~0, last_time = 0;
+
+    if (!event_count)
+        return;
+    stage_run_array   = (uint64_t *)calloc(obj->stage_count, sizeof(*stage_run_array));
+    stage_queue_array = (uint64_t *)calloc(obj->stage_count, sizeof(*stage_queue_array));
+    stage_count_array = (uint32_t *)calloc(obj->stage_count, sizeof(*stage_count_array));
+    thread_run_array  = (uint64_t *)calloc(thread_count, sizeof(*thread_run_array));
+    latency_array     = (PictureLatency *)malloc(event_count * sizeof(*latency_array));
+    if (!stage_run_array || !stage_queue_array || !stage_count_array || !thread_run_array || !latency_array) {
+        free(stage_run_array);
+        free(stage_queue_array);
+        free(stage_count_array);
+        free(thread_run_array);
+        free(latency_array);
+        return;
+    }
+
+    FILE *trace = NULL;
+    FOPEN(trace, obj->trace_file, "w");
+    if (!trace)
+        SVT_WARN("Pipeline profiler: could not open %s\n", obj->trace_file);
+    else
+        fprintf(trace, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+    for (uint32_t event_index = first_event; event_index != event_total; ++event_index) {
+        const EbPipelineEvent *event    = &obj->event_array[event_index & PIPELINE_EVENT_MASK];
+        const uint64_t         end_time = event->start_time + event->run_time;
+
+        stage_run_array[event->stage_index] += event->run_time;
+        stage_queue_array[event->stage_index] += event->queue_time;
+        stage_count_array[event->stage_index]++;
+        if (event->thread_index < thread_count)
+            thread_run_array[event->thread_index] += event->run_time;
+        first_time = MIN(first_time, event->start_time - event->queue_time);
+        last_time  = MAX(last_time, end_time);
+
+        if (event->picture_number != PIPELINE_NO_PICTURE) {
+            latency_array[latency_count].picture_number = event->picture_number;
+            latency_array[latency_count].start_time     = event->start_time - event->queue_time;
+            latency_array[latency_count].end_time       = end_time;
+            latency_count++;
+        }
+        if (trace) {
+            fprintf(trace,
+                    "{\"name\":\"%s\",\"cat\":\"stage\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%llu,\"dur\":%u,"
+                    "\"args\":{\"picture\":%lld,\"queue_us\":%u}},\n",
+                    obj->stage_name_array[event->stage_index],
+                    event->thread_index,
+                    (unsigned long long)event->start_time,
+                    event->run_time,
+                    event->picture_number == PIPELINE_NO_PICTURE ? -1LL : (long long)event->picture_number,
+                    event->queue_time);
+        }
+    }
+
+    // Merge the events of each picture
+    uint64_t latency_total = 0, latency_max = 0;
+    uint32_t picture_count = 0;
+    qsort(latency_array, latency_count, sizeof(*latency_array), picture_latency_cmp);
+    for (uint32_t latency_index = 0; latency_index < latency_count;) {
+        PictureLatency picture = latency_array[latency_index++];
+        while (latency_index < latency_count &&
+               latency_array[latency_index].picture_number == picture.picture_number) {
+            picture.start_time = MIN(picture.start_time, latency_array[latency_index].start_time);
+            picture.end_time   = MAX(picture.end_time, latency_array[latency_index].end_time);
+            latency_index++;
+        }
+        latency_total += picture.end_time - picture.start_time;
+        latency_max = MAX(latency_max, picture.end_time - picture.start_time);
+        picture_count++;
+        if (trace) {
+            fprintf(trace,
+                    "{\"name\":\"picture\",\"cat\":\"latency\",\"ph\":\"b\",\"id\":%llu,\"pid\":1,\"tid\":0,"
+                    "\"ts\":%llu},\n"
+                    "{\"name\":\"picture\",\"cat\":\"latency\",\"ph\":\"e\",\"id\":%llu,\"pid\":1,\"tid\":0,"
+                    "\"ts\":%llu},\n",
+                    (unsigned long long)picture.picture_number,
+                    (unsigned long long)picture.start_time,
+                    (unsigned long long)picture.picture_number,
+                    (unsigned long long)picture.end_time);
+        }
+    }
+
+    if (trace) {
+        for (uint32_t thread_index = 1; thread_index < thread_count; ++thread_index)
+            fprintf(trace,
+                    "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"svt thread %u\"}},\n",
+                    thread_index,
+                    thread_index);
+        fprintf(trace, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"SVT-AV1 encoder\"}}\n]}\n");
+        fclose(trace);
+    }
+
+    const uint64_t span = last_time > first_time ? last_time - first_time : 1;
+    SVT_LOG("\nSVT [pipeline profiler]: %u events over %.3f s%s\n",
+            event_count,
+            (double)span / 1000000,
+            event_total != event_count ? ", oldest events overwritten" : "");
+    SVT_LOG("SVT [pipeline profiler]: %-8s %8s %12s %12s %12s\n", "stage", "count", "run avg us", "queue avg us",
+            "run total ms");
+    for (uint32_t stage_index = 0; stage_index < obj->stage_count; ++stage_index) {
+        const uint32_t count = stage_count_array[stage_index];
+        if (!count)
+            continue;
+        SVT_LOG("SVT [pipeline profiler]: %-8s %8u %12.1f %12.1f %12.1f\n",
+                obj->stage_name_array[stage_index],
+                count,
+                (double)stage_run_array[stage_index] / count,
+                (double)stage_queue_array[stage_index] / count,
+                (double)stage_run_array[stage_index] / 1000);
+    }
+    for (uint32_t thread_index = 1; thread_index < thread_count; ++thread_index) {
+        if (thread_run_array[thread_index])
+            SVT_LOG("SVT [pipeline profiler]: thread %u busy %.1f%%\n",
+                    thread_index,
+                    100.0 * (double)thread_run_array[thread_index] / span);
+    }
+    if (picture_count)
+        SVT_LOG("SVT [pipeline profiler]: %u pictures, latency avg %.3f ms, max %.3f ms\n",
+                picture_count,
+                (double)latency_total / picture_count / 1000,
+                (double)latency_max / 1000);
+
+    free(stage_run_array);
+    free(stage_queue_array);
+    free(stage_count_array);
+    free(thread_run_array);
+    free(latency_array);
+}
+
+static void svt_pipeline_profiler_dctor(EbPtr p) {
+    EbPipelineProfiler *obj = (EbPipelineProfiler *)p;
+
+    if (obj->event_array && obj->trace_file)
+        pipeline_profiler_export(obj);
+    EB_FREE_ARRAY(obj->event_array);
+    EB_FREE_ARRAY(obj->trace_file);
+}
+
+/*********************************************************************
+ * svt_pipeline_profiler_ctor
+ *********************************************************************/
+EbErrorType svt_pipeline_profiler_ctor(EbPipelineProfiler *profiler_ptr, const char *trace_file,
+                                       const char *const *stage_name_array, uint32_t stage_count) {
+    const size_t trace_file_size = strlen(trace_file) + 1;
+
+    profiler_ptr->dctor            = svt_pipeline_profiler_dctor;
+    profiler_ptr->stage_name_array = stage_name_array;
+    profiler_ptr->stage_count      = stage_count;
+    EB_MALLOC_ARRAY(profiler_ptr->trace_file, trace_file_size);
+    memcpy(profiler_ptr->trace_file, trace_file, trace_file_size);
+    EB_MALLOC_ARRAY(profiler_ptr->event_array, PIPELINE_EVENT_MASK + 1);
+    svt_av1_get_time(&profiler_ptr->start_seconds, &profiler_ptr->start_useconds);
+
+    return EB_ErrorNone;
+}
+
+uint64_t svt_pipeline_profiler_now(const EbPipelineProfiler *profiler_ptr) {
+    uint64_t seconds, useconds;
+    svt_av1_get_time(&seconds, &useconds);
+    return (seconds - profiler_ptr->start_seconds) * 1000000 + useconds - profiler_ptr->start_useconds + 1;
+}
+
+void svt_pipeline_profiler_record(EbPipelineProfiler *profiler_ptr, uint32_t stage_index, uint64_t picture_number,
+                                  uint64_t post_time, uint64_t get_time, uint64_t end_time) {
+    const uint32_t   event_index = (uint32_t)svt_atomic_fetch_add_i32((volatile int32_t *)&profiler_ptr->event_count, 1);
+    EbPipelineEvent *event       = &profiler_ptr->event_array[event_index & PIPELINE_EVENT_MASK];
+
+    event->start_time     = get_time;
+    event->picture_number = picture_number;
+    event->run_time       = (uint32_t)(end_time - get_time);
+    event->queue_time     = post_time && post_time < get_time ? (uint32_t)(get_time - post_time) : 0;
+    event->stage_index    = (uint16_t)stage_index;
+    event->thread_index   = (uint16_t)pipeline_profiler_thread_index();
+}
@@ -0,0 +1,82 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbPipelineProfiler_h
+#define EbPipelineProfiler_h
+
+#include "EbDefinitions.h"
+#include "EbObject.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Picture number of the objects not related to a picture
+#define PIPELINE_NO_PICTURE ((uint64_t)~0)
+// Number of events kept, the oldest ones are overwritten past that count
+#define PIPELINE_EVENT_COUNT_LOG2 18
+
+/*********************************************************************
+ * Pipeline Profiler
+ *   Records one event per object going through a stage of the pipeline:
+ *   the time the object waited in the stage fullFifo and the time the
+ *   stage spent on it, from svt_get_full_object to svt_release_object.
+ *   The events are kept in a ring buffer and exported at destruction as
+ *   a Chrome trace-event JSON file, along with a per-stage summary.
+ *********************************************************************/
+typedef struct EbPipelineEvent {
+    // Times in microseconds since the profiler creation
+    uint64_t start_time;
+    uint64_t picture_number;
+    uint32_t run_time;
+    uint32_t queue_time;
+    uint16_t stage_index;
+    uint16_t thread_index;
+} EbPipelineEvent;
+
+typedef struct EbPipelineProfiler {
+    EbDctor             dctor;
+    char               *trace_file;
+    const char *const  *stage_name_array;
+    uint32_t            stage_count;
+    EbPipelineEvent    *event_array;
+    volatile uint32_t   event_count;
+    uint64_t            start_seconds;
+    uint64_t            start_useconds;
+} EbPipelineProfiler;
+
+/*********************************************************************
+ * svt_pipeline_profiler_ctor
+ *   trace_file
+ *     Path of the JSON file written at destruction, copied.
+ *
+ *   stage_name_array
+ *     Names of the stage_count stages, kept by reference.
+ *********************************************************************/
+extern EbErrorType svt_pipeline_profiler_ctor(EbPipelineProfiler *profiler_ptr, const char *trace_file,
+                                              const char *const *stage_name_array, uint32_t stage_count);
+
+// Time in microseconds since the profiler creation, never 0
+extern uint64_t svt_pipeline_profiler_now(const EbPipelineProfiler *profiler_ptr);
+
+/*********************************************************************
+ * svt_pipeline_profiler_record
+ *   Records an object posted at post_time, taken by the calling thread at
+ *   get_time and done with at end_time. Lock-free.
+ *********************************************************************/
+extern void svt_pipeline_profiler_record(EbPipelineProfiler *profiler_ptr, uint32_t stage_index,
+                                         uint64_t picture_number, uint64_t post_time, uint64_t get_time,
+                                         uint64_t end_time);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbPipelineProfiler_h
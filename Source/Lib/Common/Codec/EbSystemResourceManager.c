@@ -11,174 +11,40 @@
 */
 
 #include <stdlib.h>
+#include <string.h>
 
 #include "EbSystemResourceManager.h"
 #include "EbDefinitions.h"
 #include "EbThreads.h"
+#include "EbTaskScheduler.h"
+#include "EbPipelineProfiler.h"
 #if SRM_REPORT
 #include "EbLog.h"
 #endif
-static void svt_fifo_dctor(EbPtr p) {
-    EbFifo *obj = (EbFifo *)p;
-    EB_DESTROY_SEMAPHORE(obj->counting_semaphore);
-    EB_DESTROY_MUTEX(obj->lockout_mutex);
-}
+/* Number of times a consumer polls an empty queue before it parks,
+   spinning is useless when the producer can not run meanwhile */
+#define SRM_SPIN_COUNT 2048
+/* Number of retries on a cell being accessed by a preempted thread before yielding */
+#define SRM_RETRY_COUNT 64
+
 /**************************************
  * svt_fifo_ctor
  **************************************/
-static EbErrorType svt_fifo_ctor(EbFifo *fifoPtr, uint32_t initial_count, uint32_t max_count,
-                                 EbObjectWrapper *firstWrapperPtr, EbObjectWrapper *lastWrapperPtr,
-                                 EbMuxingQueue *queue_ptr) {
-    fifoPtr->dctor = svt_fifo_dctor;
-    // Create Counting Semaphore
-    EB_CREATE_SEMAPHORE(fifoPtr->counting_semaphore, initial_count, max_count);
-
-    // Create Buffer Pool Mutex
-    EB_CREATE_MUTEX(fifoPtr->lockout_mutex);
-
-    // Initialize Fifo First & Last ptrs
-    fifoPtr->first_ptr = firstWrapperPtr;
-    fifoPtr->last_ptr  = lastWrapperPtr;
-
+static EbErrorType svt_fifo_ctor(EbFifo *fifoPtr, EbMuxingQueue *queue_ptr) {
     // Copy the Muxing Queue ptr this Fifo belongs to
     fifoPtr->queue_ptr = queue_ptr;
 
     return EB_ErrorNone;
 }
 
-/**************************************
- * svt_fifo_push_back
- **************************************/
-static EbErrorType svt_fifo_push_back(EbFifo *fifoPtr, EbObjectWrapper *wrapper_ptr) {
-    EbErrorType return_error = EB_ErrorNone;
-
-    // If FIFO is empty
-    if (fifoPtr->first_ptr == (EbObjectWrapper *)NULL) {
-        fifoPtr->first_ptr = wrapper_ptr;
-        fifoPtr->last_ptr  = wrapper_ptr;
-    } else {
-        fifoPtr->last_ptr->next_ptr = wrapper_ptr;
-        fifoPtr->last_ptr           = wrapper_ptr;
-    }
-
-    fifoPtr->last_ptr->next_ptr = (EbObjectWrapper *)NULL;
-
-    return return_error;
-}
-
-/**************************************
- * svt_fifo_pop_front
- **************************************/
-static EbErrorType svt_fifo_pop_front(EbFifo *fifoPtr, EbObjectWrapper **wrapper_ptr) {
-    EbErrorType return_error = EB_ErrorNone;
-
-    // Set wrapper_ptr to head of BufferPool
-    *wrapper_ptr = fifoPtr->first_ptr;
-
-    // Update tail of BufferPool if the BufferPool is now empty
-    fifoPtr->last_ptr = (fifoPtr->first_ptr == fifoPtr->last_ptr) ? (EbObjectWrapper *)NULL : fifoPtr->last_ptr;
-
-    // Update head of BufferPool
-    fifoPtr->first_ptr = fifoPtr->first_ptr->next_ptr;
-
-    return return_error;
-}
+static void svt_muxing_queue_wake(EbMuxingQueue *queue_ptr);
 
 static EbErrorType svt_fifo_shutdown(EbFifo *fifo_ptr) {
     EbErrorType return_error = EB_ErrorNone;
 
-    // Acquire lockout Mutex
-    svt_block_on_mutex(fifo_ptr->lockout_mutex);
-    fifo_ptr->quit_signal = TRUE;
-    // Release Mutex
-    svt_release_mutex(fifo_ptr->lockout_mutex);
+    svt_atomic_store_u32((volatile uint32_t *)&fifo_ptr->quit_signal, TRUE);
     //Wake up the waiting process if any
-    svt_post_semaphore(fifo_ptr->counting_semaphore);
-
-    return return_error;
-}
-
-static void svt_circular_buffer_dctor(EbPtr p) {
-    EbCircularBuffer *obj = (EbCircularBuffer *)p;
-    EB_FREE(obj->array_ptr);
-}
-
-/**************************************
- * svt_circular_buffer_ctor
- **************************************/
-static EbErrorType svt_circular_buffer_ctor(EbCircularBuffer *bufferPtr, uint32_t buffer_total_count) {
-    bufferPtr->dctor = svt_circular_buffer_dctor;
-
-    bufferPtr->buffer_total_count = buffer_total_count;
-
-    EB_CALLOC(bufferPtr->array_ptr, bufferPtr->buffer_total_count, sizeof(EbPtr));
-
-    return EB_ErrorNone;
-}
-
-/**************************************
- * svt_circular_buffer_empty_check
- **************************************/
-static Bool svt_circular_buffer_empty_check(EbCircularBuffer *bufferPtr) {
-    return ((bufferPtr->head_index == bufferPtr->tail_index) && (bufferPtr->array_ptr[bufferPtr->head_index] == NULL))
-        ? TRUE
-        : FALSE;
-}
-
-/**************************************
- * svt_circular_buffer_pop_front
- **************************************/
-static EbErrorType svt_circular_buffer_pop_front(EbCircularBuffer *bufferPtr, EbPtr *object_ptr) {
-    EbErrorType return_error = EB_ErrorNone;
-
-    // Copy the head of the buffer into the object_ptr
-    *object_ptr                                 = bufferPtr->array_ptr[bufferPtr->head_index];
-    bufferPtr->array_ptr[bufferPtr->head_index] = NULL;
-
-    // Increment the head & check for rollover
-    bufferPtr->head_index = (bufferPtr->head_index == bufferPtr->buffer_total_count - 1) ? 0
-                                                                                         : bufferPtr->head_index + 1;
-
-    // Decrement the Current Count
-    --bufferPtr->current_count;
-
-    return return_error;
-}
-
-/**************************************
- * svt_circular_buffer_push_back
- **************************************/
-static EbErrorType svt_circular_buffer_push_back(EbCircularBuffer *bufferPtr, EbPtr object_ptr) {
-    EbErrorType return_error = EB_ErrorNone;
-
-    // Copy the pointer into the array
-    bufferPtr->array_ptr[bufferPtr->tail_index] = object_ptr;
-
-    // Increment the tail & check for rollover
-    bufferPtr->tail_index = (bufferPtr->tail_index == bufferPtr->buffer_total_count - 1) ? 0
-                                                                                         : bufferPtr->tail_index + 1;
-
-    // Increment the Current Count
-    ++bufferPtr->current_count;
-
-    return return_error;
-}
-
-/**************************************
- * svt_circular_buffer_push_front
- **************************************/
-static EbErrorType svt_circular_buffer_push_front(EbCircularBuffer *bufferPtr, EbPtr object_ptr) {
-    EbErrorType return_error = EB_ErrorNone;
-
-    // Decrement the head_index
-    bufferPtr->head_index = (bufferPtr->head_index == 0) ? bufferPtr->buffer_total_count - 1
-                                                         : bufferPtr->head_index - 1;
-
-    // Copy the pointer into the array
-    bufferPtr->array_ptr[bufferPtr->head_index] = object_ptr;
-
-    // Increment the Current Count
-    ++bufferPtr->current_count;
+    svt_muxing_queue_wake(fifo_ptr->queue_ptr);
 
     return return_error;
 }
@@ -186,8 +52,8 @@ static EbErrorType svt_circular_buffer_push_front(EbCircularBuffer *bufferPtr, E
 void svt_muxing_queue_dctor(EbPtr p) {
     EbMuxingQueue *obj = (EbMuxingQueue *)p;
     EB_DELETE_PTR_ARRAY(obj->process_fifo_ptr_array, obj->process_total_count);
-    EB_DELETE(obj->object_queue);
-    EB_DELETE(obj->process_queue);
+    EB_FREE_ARRAY(obj->cell_array);
+    EB_DESTROY_SEMAPHORE(obj->park_semaphore);
     EB_DESTROY_MUTEX(obj->lockout_mutex);
 }
 
@@ -197,6 +63,7 @@ void svt_muxing_queue_dctor(EbPtr p) {
 static EbErrorType svt_muxing_queue_ctor(EbMuxingQueue *queue_ptr, uint32_t object_total_count,
                                          uint32_t process_total_count) {
     uint32_t    process_index;
+    uint32_t    cell_count = 1;
     EbErrorType return_error = EB_ErrorNone;
 
     queue_ptr->dctor               = svt_muxing_queue_dctor;
@@ -204,84 +71,147 @@ static EbErrorType svt_muxing_queue_ctor(EbMuxingQueue *queue_ptr, uint32_t obje
 
     // Lockout Mutex
     EB_CREATE_MUTEX(queue_ptr->lockout_mutex);
+    // Semaphore the waiting processes park on, posted at most once per parked thread
+    EB_CREATE_SEMAPHORE(queue_ptr->park_semaphore, 0, INT32_MAX);
+    queue_ptr->spin_count = svt_get_num_online_processors() > 1 ? SRM_SPIN_COUNT : 0;
+
+    // Construct the cells, each one is ready to be written at its own position
+    while (cell_count < object_total_count) cell_count <<= 1;
+    EB_CALLOC_ARRAY(queue_ptr->cell_array, cell_count);
+    for (uint32_t cell_index = 0; cell_index < cell_count; ++cell_index)
+        queue_ptr->cell_array[cell_index].sequence = cell_index;
+    queue_ptr->cell_mask = cell_count - 1;
 
-    // Construct Object Circular Buffer
-    EB_NEW(queue_ptr->object_queue, svt_circular_buffer_ctor, object_total_count);
-    // Construct Process Circular Buffer
-    EB_NEW(queue_ptr->process_queue, svt_circular_buffer_ctor, queue_ptr->process_total_count);
     // Construct the Process Fifos
     EB_ALLOC_PTR_ARRAY(queue_ptr->process_fifo_ptr_array, queue_ptr->process_total_count);
 
-    for (process_index = 0; process_index < queue_ptr->process_total_count; ++process_index) {
-        EB_NEW(queue_ptr->process_fifo_ptr_array[process_index],
-               svt_fifo_ctor,
-               0,
-               object_total_count,
-               (EbObjectWrapper *)NULL,
-               (EbObjectWrapper *)NULL,
-               queue_ptr);
-    }
+    for (process_index = 0; process_index < queue_ptr->process_total_count; ++process_index)
+        EB_NEW(queue_ptr->process_fifo_ptr_array[process_index], svt_fifo_ctor, queue_ptr);
 
     return return_error;
 }
 
 /**************************************
- * svt_muxing_queue_assignation
+ * svt_muxing_queue_wake
+ *   Hands one token of the available count to the waiting processes,
+ *   unparking one of them if any is parked.
  **************************************/
-static EbErrorType svt_muxing_queue_assignation(EbMuxingQueue *queue_ptr) {
-    EbErrorType      return_error = EB_ErrorNone;
-    EbFifo          *process_fifo_ptr;
-    EbObjectWrapper *wrapper_ptr;
-
-    // while loop
-    while ((svt_circular_buffer_empty_check(queue_ptr->object_queue) == FALSE) &&
-           (svt_circular_buffer_empty_check(queue_ptr->process_queue) == FALSE)) {
-        // Get the next process
-        svt_circular_buffer_pop_front(queue_ptr->process_queue, (void **)&process_fifo_ptr);
-
-        // Get the next object
-        svt_circular_buffer_pop_front(queue_ptr->object_queue, (void **)&wrapper_ptr);
-
-        // Block on the Process Fifo's Mutex
-        svt_block_on_mutex(process_fifo_ptr->lockout_mutex);
-
-        // Put the object on the fifo
-        svt_fifo_push_back(process_fifo_ptr, wrapper_ptr);
-
-        // Release the Process Fifo's Mutex
-        svt_release_mutex(process_fifo_ptr->lockout_mutex);
+static void svt_muxing_queue_wake(EbMuxingQueue *queue_ptr) {
+    if (svt_atomic_fetch_add_i32(&queue_ptr->available, 1) < 0)
+        svt_post_semaphore(queue_ptr->park_semaphore);
+}
 
-        // Post the semaphore
-        svt_post_semaphore(process_fifo_ptr->counting_semaphore);
+/**************************************
+ * svt_muxing_queue_wait
+ *   Takes one token of the available count, spinning for spin_count
+ *   polls before parking on the semaphore.
+ **************************************/
+static void svt_muxing_queue_wait(EbMuxingQueue *queue_ptr) {
+    for (uint32_t spin = 0; spin < queue_ptr->spin_count; ++spin) {
+        int32_t available = (int32_t)svt_atomic_load_u32((volatile uint32_t *)&queue_ptr->available);
+        if (available > 0 &&
+            svt_atomic_cas_u32(
+                (volatile uint32_t *)&queue_ptr->available, (uint32_t)available, (uint32_t)(available - 1)))
+            return;
+        svt_cpu_relax();
+    }
+    if (svt_atomic_fetch_add_i32(&queue_ptr->available, -1) <= 0) {
+        // A task scheduler worker hands its slot over while it is parked
+        svt_task_scheduler_block_begin();
+        svt_block_on_semaphore(queue_ptr->park_semaphore);
+        svt_task_scheduler_block_end();
     }
-
-    return return_error;
 }
 
 /**************************************
- * svt_muxing_queue_object_push_back
+ * svt_muxing_queue_try_wait
+ *   Takes one token of the available count if any, without waiting.
  **************************************/
-static EbErrorType svt_muxing_queue_object_push_back(EbMuxingQueue *queue_ptr, EbObjectWrapper *object_ptr) {
-    EbErrorType return_error = EB_ErrorNone;
-
-    svt_circular_buffer_push_back(queue_ptr->object_queue, object_ptr);
-
-    svt_muxing_queue_assignation(queue_ptr);
-
-    return return_error;
+static Bool svt_muxing_queue_try_wait(EbMuxingQueue *queue_ptr) {
+    int32_t available = (int32_t)svt_atomic_load_u32((volatile uint32_t *)&queue_ptr->available);
+    while (available > 0) {
+        if (svt_atomic_cas_u32(
+                (volatile uint32_t *)&queue_ptr->available, (uint32_t)available, (uint32_t)(available - 1)))
+            return TRUE;
+        available = (int32_t)svt_atomic_load_u32((volatile uint32_t *)&queue_ptr->available);
+    }
+    return FALSE;
 }
 
 /**************************************
-* svt_muxing_queue_object_push_front
-**************************************/
-static EbErrorType svt_muxing_queue_object_push_front(EbMuxingQueue *queue_ptr, EbObjectWrapper *object_ptr) {
-    EbErrorType return_error = EB_ErrorNone;
+ * svt_muxing_queue_backoff
+ *   Waits for a cell being accessed by another thread, yielding the CPU
+ *   in case that thread got preempted.
+ **************************************/
+static void svt_muxing_queue_backoff(uint32_t *retry) {
+    if (++*retry < SRM_RETRY_COUNT)
+        svt_cpu_relax();
+    else
+        svt_yield_thread();
+}
 
-    svt_circular_buffer_push_front(queue_ptr->object_queue, object_ptr);
+/**************************************
+ * svt_muxing_queue_enqueue
+ **************************************/
+static void svt_muxing_queue_enqueue(EbMuxingQueue *queue_ptr, EbObjectWrapper *wrapper_ptr) {
+    EbMuxingCell *cell;
+    uint32_t      pos   = svt_atomic_load_u32(&queue_ptr->enqueue_pos);
+    uint32_t      retry = 0;
+
+    for (;;) {
+        cell          = &queue_ptr->cell_array[pos & queue_ptr->cell_mask];
+        int32_t delta = (int32_t)(svt_atomic_load_u32(&cell->sequence) - pos);
+        if (delta == 0) {
+            // The cell is free, claim it
+            if (svt_atomic_cas_u32(&queue_ptr->enqueue_pos, pos, pos + 1))
+                break;
+            pos = svt_atomic_load_u32(&queue_ptr->enqueue_pos);
+        } else if (delta < 0) {
+            // The cell is still being read by a consumer which claimed it a lap earlier
+            svt_muxing_queue_backoff(&retry);
+            pos = svt_atomic_load_u32(&queue_ptr->enqueue_pos);
+        } else
+            pos = svt_atomic_load_u32(&queue_ptr->enqueue_pos);
+    }
+    cell->wrapper_ptr = wrapper_ptr;
+    svt_atomic_store_u32(&cell->sequence, pos + 1);
+}
 
-    svt_muxing_queue_assignation(queue_ptr);
+/**************************************
+ * svt_muxing_queue_dequeue
+ *   Returns NULL when the head cell is not written yet. Only called once a
+ *   token of the available count is taken, hence the caller retries until an
+ *   object comes out, unless the token came from a shutdown.
+ **************************************/
+static EbObjectWrapper *svt_muxing_queue_dequeue(EbMuxingQueue *queue_ptr) {
+    EbMuxingCell *cell;
+    uint32_t      pos = svt_atomic_load_u32(&queue_ptr->dequeue_pos);
+
+    for (;;) {
+        cell          = &queue_ptr->cell_array[pos & queue_ptr->cell_mask];
+        int32_t delta = (int32_t)(svt_atomic_load_u32(&cell->sequence) - (pos + 1));
+        if (delta == 0) {
+            // The cell is written, claim it
+            if (svt_atomic_cas_u32(&queue_ptr->dequeue_pos, pos, pos + 1))
+                break;
+            pos = svt_atomic_load_u32(&queue_ptr->dequeue_pos);
+        } else if (delta < 0) {
+            // The producer which claimed the cell is still writing it
+            return NULL;
+        } else
+            pos = svt_atomic_load_u32(&queue_ptr->dequeue_pos);
+    }
+    EbObjectWrapper *wrapper_ptr = cell->wrapper_ptr;
+    svt_atomic_store_u32(&cell->sequence, pos + queue_ptr->cell_mask + 1);
+    return wrapper_ptr;
+}
 
-    return return_error;
+/**************************************
+ * svt_muxing_queue_object_push_back
+ **************************************/
+static void svt_muxing_queue_object_push_back(EbMuxingQueue *queue_ptr, EbObjectWrapper *object_ptr) {
+    svt_muxing_queue_enqueue(queue_ptr, object_ptr);
+    svt_muxing_queue_wake(queue_ptr);
 }
 
 static EbFifo *svt_muxing_queue_get_fifo(EbMuxingQueue *queue_ptr, uint32_t index) {
@@ -388,16 +318,31 @@ void svt_object_wrapper_dctor(EbPtr p) {
     }
 }
 
+/* node_slot - index in the node_array of the resource of the node the
+   object memory is bound to, ignored when the resource has no nodes */
 static EbErrorType svt_object_wrapper_ctor(EbObjectWrapper *wrapper, EbSystemResource *resource,
                                            EbCreator object_creator, EbPtr object_init_data_ptr,
-                                           EbDctor object_destroyer) {
+                                           EbDctor object_destroyer, uint32_t node_slot) {
     EbErrorType ret;
+    uint64_t    bound_bytes = 0, unbound_bytes = 0;
 
     wrapper->dctor               = svt_object_wrapper_dctor;
     wrapper->release_enable      = TRUE;
     wrapper->system_resource_ptr = resource;
     wrapper->object_destroyer    = object_destroyer;
-    ret                          = object_creator(&wrapper->object_ptr, object_init_data_ptr);
+    if (resource->node_count) {
+        wrapper->node_id = resource->node_array[node_slot];
+        svt_numa_get_allocation_bytes(&bound_bytes, &unbound_bytes);
+        svt_numa_set_allocation_node((int32_t)wrapper->node_id);
+    }
+    ret = object_creator(&wrapper->object_ptr, object_init_data_ptr);
+    if (resource->node_count) {
+        uint64_t bound_total, unbound_total;
+        svt_numa_set_allocation_node(-1);
+        svt_numa_get_allocation_bytes(&bound_total, &unbound_total);
+        resource->node_bytes[node_slot] += bound_total - bound_bytes;
+        resource->unbound_bytes += unbound_total - unbound_bytes;
+    }
     if (ret != EB_ErrorNone)
         return ret;
     return EB_ErrorNone;
@@ -408,6 +353,8 @@ static void svt_system_resource_dctor(EbPtr p) {
     EB_DELETE(obj->full_queue);
     EB_DELETE(obj->empty_queue);
     EB_DELETE_PTR_ARRAY(obj->wrapper_ptr_pool, obj->object_total_count);
+    EB_FREE_ARRAY(obj->node_array);
+    EB_FREE_ARRAY(obj->node_bytes);
 }
 
 /*********************************************************************
@@ -454,7 +401,8 @@ EbErrorType svt_system_resource_ctor(EbSystemResource *resource_ptr, uint32_t ob
                resource_ptr,
                object_creator,
                object_init_data_ptr,
-               object_destroyer);
+               object_destroyer,
+               resource_ptr->node_count ? wrapper_index % resource_ptr->node_count : 0);
 
 #if SRM_REPORT
         resource_ptr->wrapper_ptr_pool[wrapper_index]->pic_number = 99999999;
@@ -488,6 +436,27 @@ EbErrorType svt_system_resource_ctor(EbSystemResource *resource_ptr, uint32_t ob
     return return_error;
 }
 
+EbErrorType svt_system_resource_numa_ctor(EbSystemResource *resource_ptr, uint32_t node_count,
+                                          const uint32_t *node_array, uint32_t object_total_count,
+                                          uint32_t producer_process_total_count, uint32_t consumer_process_total_count,
+                                          EbCreator object_creator, EbPtr object_init_data_ptr,
+                                          EbDctor object_destroyer) {
+    resource_ptr->dctor = svt_system_resource_dctor;
+    if (node_count > 1) {
+        EB_MALLOC_ARRAY(resource_ptr->node_array, node_count);
+        EB_CALLOC_ARRAY(resource_ptr->node_bytes, node_count);
+        memcpy(resource_ptr->node_array, node_array, node_count * sizeof(*node_array));
+        resource_ptr->node_count = node_count;
+    }
+    return svt_system_resource_ctor(resource_ptr,
+                                    object_total_count,
+                                    producer_process_total_count,
+                                    consumer_process_total_count,
+                                    object_creator,
+                                    object_init_data_ptr,
+                                    object_destroyer);
+}
+
 EbFifo *svt_system_resource_get_producer_fifo(const EbSystemResource *resource_ptr, uint32_t index) {
     return svt_muxing_queue_get_fifo(resource_ptr->empty_queue, index);
 }
@@ -509,29 +478,10 @@ EbErrorType svt_shutdown_process(const EbSystemResource *resource_ptr) {
     return EB_ErrorNone;
 }
 
-/*********************************************************************
- * EbSystemResourceReleaseProcess
- *********************************************************************/
-static EbErrorType svt_release_process(EbFifo *process_fifo_ptr) {
-    EbErrorType return_error = EB_ErrorNone;
-
-    svt_block_on_mutex(process_fifo_ptr->queue_ptr->lockout_mutex);
-
-    svt_circular_buffer_push_front(process_fifo_ptr->queue_ptr->process_queue, process_fifo_ptr);
-
-    svt_muxing_queue_assignation(process_fifo_ptr->queue_ptr);
-
-    svt_release_mutex(process_fifo_ptr->queue_ptr->lockout_mutex);
-
-    return return_error;
-}
-
 /*********************************************************************
  * EbSystemResourcePostObject
- *   Queues a full EbObjectWrapper to the SystemResource. This
- *   function posts the SystemResource fullFifo counting_semaphore.
- *   This function is write protected by the SystemResource fullFifo
- *   lockout_mutex.
+ *   Queues a full EbObjectWrapper to the SystemResource and wakes up
+ *   a parked consumer if any.
  *
  *   resource_ptr
  *      pointer to the SystemResource that the EbObjectWrapper is
@@ -543,29 +493,45 @@ static EbErrorType svt_release_process(EbFifo *process_fifo_ptr) {
 EbErrorType svt_post_full_object(EbObjectWrapper *object_ptr) {
     EbErrorType return_error = EB_ErrorNone;
 
-    svt_block_on_mutex(object_ptr->system_resource_ptr->full_queue->lockout_mutex);
-
-    svt_muxing_queue_object_push_back(object_ptr->system_resource_ptr->full_queue, object_ptr);
+    EbSystemResource *resource_ptr = object_ptr->system_resource_ptr;
 
-    svt_release_mutex(object_ptr->system_resource_ptr->full_queue->lockout_mutex);
+    if (resource_ptr->profiler_ptr)
+        object_ptr->post_time = svt_pipeline_profiler_now(resource_ptr->profiler_ptr);
+    svt_muxing_queue_object_push_back(resource_ptr->full_queue, object_ptr);
+    if (resource_ptr->object_post_cb)
+        resource_ptr->object_post_cb(resource_ptr->object_post_ctx);
 
     return return_error;
 }
 
 /*********************************************************************
  * EbSystemResourceReleaseObject
- *   Queues an empty EbObjectWrapper to the SystemResource. This
- *   function posts the SystemResource emptyFifo counting_semaphore.
- *   This function is write protected by the SystemResource emptyFifo
- *   lockout_mutex.
+ *   Queues an empty EbObjectWrapper to the SystemResource once its
+ *   live_count drops to 0. The live_count is write protected by the
+ *   SystemResource emptyFifo lockout_mutex.
  *
  *   object_ptr
  *      pointer to EbObjectWrapper to be released.
  *********************************************************************/
+static void push_empty_object(EbObjectWrapper *object_ptr) {
+#if SRM_REPORT
+    object_ptr->pic_number = 99999999;
+    //increment the fullness
+    object_ptr->system_resource_ptr->empty_queue->curr_count++;
+    if (object_ptr->system_resource_ptr->empty_queue->log)
+        SVT_LOG("SRM fullness+: %i/%i\n",
+                object_ptr->system_resource_ptr->empty_queue->curr_count,
+                object_ptr->system_resource_ptr->object_total_count);
+#endif
+    svt_muxing_queue_object_push_back(object_ptr->system_resource_ptr->empty_queue, object_ptr);
+}
+
 EbErrorType svt_release_object(EbObjectWrapper *object_ptr) {
-    EbErrorType return_error = EB_ErrorNone;
+    EbErrorType       return_error = EB_ErrorNone;
+    EbSystemResource *resource_ptr = object_ptr->system_resource_ptr;
+    Bool              released     = FALSE;
 
-    svt_block_on_mutex(object_ptr->system_resource_ptr->empty_queue->lockout_mutex);
+    svt_block_on_mutex(resource_ptr->empty_queue->lockout_mutex);
 
     svt_aom_assert_err(object_ptr->live_count != EB_ObjectWrapperReleasedValue,
                        "live_count should not be EB_ObjectWrapperReleasedValue when release");
@@ -576,26 +542,36 @@ EbErrorType svt_release_object(EbObjectWrapper *object_ptr) {
     if ((object_ptr->release_enable == TRUE) && (object_ptr->live_count == 0)) {
         // Set live_count to EB_ObjectWrapperReleasedValue
         object_ptr->live_count = EB_ObjectWrapperReleasedValue;
-
-        svt_muxing_queue_object_push_front(object_ptr->system_resource_ptr->empty_queue, object_ptr);
-#if SRM_REPORT
-        object_ptr->pic_number = 99999999;
-        //increment the fullness
-        object_ptr->system_resource_ptr->empty_queue->curr_count++;
-        if (object_ptr->system_resource_ptr->empty_queue->log)
-            SVT_LOG("SRM fullness+: %i/%i\n",
-                    object_ptr->system_resource_ptr->empty_queue->curr_count,
-                    object_ptr->system_resource_ptr->object_total_count);
-#endif
+        released               = TRUE;
     }
 
-    svt_release_mutex(object_ptr->system_resource_ptr->empty_queue->lockout_mutex);
+    svt_release_mutex(resource_ptr->empty_queue->lockout_mutex);
+
+    // The object is queued once the release callback returned, nobody can pick
+    // it up in the meantime as it is not in the empty queue yet
+    if (released) {
+        if (resource_ptr->profiler_ptr && object_ptr->get_time) {
+            svt_pipeline_profiler_record(resource_ptr->profiler_ptr,
+                                         resource_ptr->profiler_stage,
+                                         resource_ptr->object_picture_number_cb
+                                             ? resource_ptr->object_picture_number_cb(object_ptr->object_ptr)
+                                             : PIPELINE_NO_PICTURE,
+                                         object_ptr->post_time,
+                                         object_ptr->get_time,
+                                         svt_pipeline_profiler_now(resource_ptr->profiler_ptr));
+            object_ptr->post_time = object_ptr->get_time = 0;
+        }
+        if (resource_ptr->object_release_cb)
+            resource_ptr->object_release_cb(resource_ptr->object_release_ctx, object_ptr->object_ptr);
+        push_empty_object(object_ptr);
+    }
 
     return return_error;
 }
 
 EbErrorType svt_release_dual_object(EbObjectWrapper *object_ptr, EbObjectWrapper *sec_object_ptr) {
     EbErrorType return_error = EB_ErrorNone;
+    Bool        released     = FALSE;
 
     svt_block_on_mutex(object_ptr->system_resource_ptr->empty_queue->lockout_mutex);
 
@@ -603,29 +579,23 @@ EbErrorType svt_release_dual_object(EbObjectWrapper *object_ptr, EbObjectWrapper
     object_ptr->live_count = (object_ptr->live_count == 0) ? object_ptr->live_count : object_ptr->live_count - 1;
 
     if ((object_ptr->release_enable == TRUE) && (object_ptr->live_count == 0)) {
-        //release the second object
-        svt_release_object(sec_object_ptr);
-
         // Set live_count to EB_ObjectWrapperReleasedValue
         object_ptr->live_count = EB_ObjectWrapperReleasedValue;
+        released               = TRUE;
+    }
 
-        svt_muxing_queue_object_push_front(object_ptr->system_resource_ptr->empty_queue, object_ptr);
+    svt_release_mutex(object_ptr->system_resource_ptr->empty_queue->lockout_mutex);
 
+    if (released) {
+        //release the second object
+        svt_release_object(sec_object_ptr);
 #if SRM_REPORT
-
         if (object_ptr->system_resource_ptr->empty_queue->log)
             SVT_LOG("SRM RELEASE: %lld\n", object_ptr->pic_number);
-
-        object_ptr->pic_number = 99999999;
-        //increment the fullness
-        object_ptr->system_resource_ptr->empty_queue->curr_count++;
-        //  if (object_ptr->system_resource_ptr->empty_queue->log)
-        //      SVT_LOG("SRM fullness+: %i/%i\n", object_ptr->system_resource_ptr->empty_queue->curr_count, object_ptr->system_resource_ptr->object_total_count);
 #endif
+        push_empty_object(object_ptr);
     }
 
-    svt_release_mutex(object_ptr->system_resource_ptr->empty_queue->lockout_mutex);
-
     return return_error;
 }
 #if SRM_REPORT
@@ -646,9 +616,8 @@ EbErrorType dump_srm_content(EbSystemResource *resource_ptr, uint8_t log) {
 /*********************************************************************
  * EbSystemResourceGetEmptyObject
  *   Dequeues an empty EbObjectWrapper from the SystemResource.  This
- *   function blocks on the SystemResource emptyFifo counting_semaphore.
- *   This function is write protected by the SystemResource emptyFifo
- *   lockout_mutex.
+ *   function spins, then blocks, until the SystemResource emptyFifo
+ *   holds an object.
  *
  *   resource_ptr
  *      pointer to the SystemResource that provides the empty
@@ -659,51 +628,99 @@ EbErrorType dump_srm_content(EbSystemResource *resource_ptr, uint8_t log) {
  *      EbObjectWrapper pointer.
  *********************************************************************/
 EbErrorType svt_get_empty_object(EbFifo *empty_fifo_ptr, EbObjectWrapper **wrapper_dbl_ptr) {
-    EbErrorType return_error = EB_ErrorNone;
-
-    // Queue the Fifo requesting the empty fifo
-    svt_release_process(empty_fifo_ptr);
-
-    // Block on the counting Semaphore until an empty buffer is available
-    svt_block_on_semaphore(empty_fifo_ptr->counting_semaphore);
+    EbErrorType      return_error = EB_ErrorNone;
+    EbMuxingQueue   *queue_ptr    = empty_fifo_ptr->queue_ptr;
+    EbObjectWrapper *wrapper_ptr;
 
-    // Acquire lockout Mutex
-    svt_block_on_mutex(empty_fifo_ptr->lockout_mutex);
+    // Wait until an empty buffer is available
+    svt_muxing_queue_wait(queue_ptr);
 
     // Get the empty object
-    svt_fifo_pop_front(empty_fifo_ptr, wrapper_dbl_ptr);
+    uint32_t retry = 0;
+    while ((wrapper_ptr = svt_muxing_queue_dequeue(queue_ptr)) == NULL) svt_muxing_queue_backoff(&retry);
+    *wrapper_dbl_ptr = wrapper_ptr;
 
 #if SRM_REPORT
     //decrement the fullness
-    empty_fifo_ptr->queue_ptr->curr_count--;
-    if (empty_fifo_ptr->queue_ptr->log)
-        printf("SRM fullness-: %i/%i\n",
-               empty_fifo_ptr->queue_ptr->curr_count,
-               (*wrapper_dbl_ptr)->system_resource_ptr->object_total_count);
+    queue_ptr->curr_count--;
+    if (queue_ptr->log)
+        printf("SRM fullness-: %i/%i\n", queue_ptr->curr_count, wrapper_ptr->system_resource_ptr->object_total_count);
 #endif
 
-    svt_aom_assert_err(
-        (*wrapper_dbl_ptr)->live_count == 0 || (*wrapper_dbl_ptr)->live_count == EB_ObjectWrapperReleasedValue,
-        "live_count should be 0 or EB_ObjectWrapperReleasedValue when get");
+    svt_aom_assert_err(wrapper_ptr->live_count == 0 || wrapper_ptr->live_count == EB_ObjectWrapperReleasedValue,
+                       "live_count should be 0 or EB_ObjectWrapperReleasedValue when get");
 
     // Reset the wrapper's live_count
-    (*wrapper_dbl_ptr)->live_count = 0;
+    wrapper_ptr->live_count = 0;
 
     // Object release enable
-    (*wrapper_dbl_ptr)->release_enable = TRUE;
+    wrapper_ptr->release_enable = TRUE;
 
-    // Release Mutex
-    svt_release_mutex(empty_fifo_ptr->lockout_mutex);
+    return return_error;
+}
 
+EbErrorType svt_get_empty_picture_object(EbFifo *empty_fifo_ptr, uint64_t picture_number,
+                                         EbObjectWrapper **wrapper_dbl_ptr) {
+    EbErrorType       return_error = svt_get_empty_object(empty_fifo_ptr, wrapper_dbl_ptr);
+    EbObjectWrapper  *wrapper_ptr  = *wrapper_dbl_ptr;
+    EbSystemResource *resource_ptr = wrapper_ptr->system_resource_ptr;
+    EbMuxingQueue    *queue_ptr    = empty_fifo_ptr->queue_ptr;
+
+    if (!resource_ptr->node_count)
+        return return_error;
+    const uint32_t node_id = resource_ptr->node_array[picture_number % resource_ptr->node_count];
+
+    // Only the head of the queue can be dequeued: trade the object for the next
+    // empty one, if any is there already, until one of the node comes out. Each
+    // empty object is looked at once at most.
+    for (uint32_t count = resource_ptr->object_total_count;
+         wrapper_ptr->node_id != node_id && count && svt_muxing_queue_try_wait(queue_ptr);
+         --count) {
+        EbObjectWrapper *next_ptr;
+        uint32_t         retry = 0;
+        while ((next_ptr = svt_muxing_queue_dequeue(queue_ptr)) == NULL) svt_muxing_queue_backoff(&retry);
+        svt_muxing_queue_object_push_back(queue_ptr, wrapper_ptr);
+        wrapper_ptr = next_ptr;
+    }
+    svt_aom_assert_err(wrapper_ptr->live_count == 0 || wrapper_ptr->live_count == EB_ObjectWrapperReleasedValue,
+                       "live_count should be 0 or EB_ObjectWrapperReleasedValue when get");
+    wrapper_ptr->live_count     = 0;
+    wrapper_ptr->release_enable = TRUE;
+    svt_atomic_fetch_add_i32(
+        wrapper_ptr->node_id == node_id ? &resource_ptr->node_local_count : &resource_ptr->node_remote_count, 1);
+    *wrapper_dbl_ptr = wrapper_ptr;
     return return_error;
 }
 
+/*********************************************************************
+ * svt_get_full_object_after_wait
+ *   Dequeues the full EbObjectWrapper a token of the available count was
+ *   taken for, unless the consumer is shut down.
+ *********************************************************************/
+static EbErrorType svt_get_full_object_after_wait(EbFifo *full_fifo_ptr, EbObjectWrapper **wrapper_dbl_ptr) {
+    EbMuxingQueue *queue_ptr = full_fifo_ptr->queue_ptr;
+    uint32_t       retry     = 0;
+
+    // The token may come from the shutdown of another consumer of the queue,
+    // in which case there is no object and this consumer is shut down next
+    while (!svt_atomic_load_u32((volatile uint32_t *)&full_fifo_ptr->quit_signal)) {
+        if ((*wrapper_dbl_ptr = svt_muxing_queue_dequeue(queue_ptr)) != NULL) {
+            EbSystemResource *resource_ptr = (*wrapper_dbl_ptr)->system_resource_ptr;
+            if (resource_ptr->profiler_ptr)
+                (*wrapper_dbl_ptr)->get_time = svt_pipeline_profiler_now(resource_ptr->profiler_ptr);
+            return EB_ErrorNone;
+        }
+        svt_muxing_queue_backoff(&retry);
+    }
+    *wrapper_dbl_ptr = NULL;
+    return EB_NoErrorFifoShutdown;
+}
+
 /*********************************************************************
  * EbSystemResourceGetFullObject
  *   Dequeues an full EbObjectWrapper from the SystemResource. This
- *   function blocks on the SystemResource fullFifo counting_semaphore.
- *   This function is write protected by the SystemResource fullFifo
- *   lockout_mutex.
+ *   function spins, then blocks, until the SystemResource fullFifo
+ *   holds an object or the consumer is shut down.
  *
  *   resource_ptr
  *      pointer to the SystemResource that provides the full
@@ -714,63 +731,21 @@ EbErrorType svt_get_empty_object(EbFifo *empty_fifo_ptr, EbObjectWrapper **wrapp
  *      EbObjectWrapper pointer.
  *********************************************************************/
 EbErrorType svt_get_full_object(EbFifo *full_fifo_ptr, EbObjectWrapper **wrapper_dbl_ptr) {
-    EbErrorType return_error = EB_ErrorNone;
-
-    // Queue the Fifo requesting the full fifo
-    svt_release_process(full_fifo_ptr);
+    // Wait until a full buffer is available
+    svt_muxing_queue_wait(full_fifo_ptr->queue_ptr);
 
-    // Block on the counting Semaphore until an empty buffer is available
-    svt_block_on_semaphore(full_fifo_ptr->counting_semaphore);
-
-    // Acquire lockout Mutex
-    svt_block_on_mutex(full_fifo_ptr->lockout_mutex);
-
-    if (!full_fifo_ptr->quit_signal) {
-        svt_fifo_pop_front(full_fifo_ptr, wrapper_dbl_ptr);
-    } else {
-        *wrapper_dbl_ptr = NULL;
-        return_error     = EB_NoErrorFifoShutdown;
-    }
-
-    // Release Mutex
-    svt_release_mutex(full_fifo_ptr->lockout_mutex);
-
-    return return_error;
-}
-
-/**************************************
-* svt_fifo_pop_front
-**************************************/
-static Bool svt_fifo_peak_front(EbFifo *fifoPtr) {
-    // Set wrapper_ptr to head of BufferPool
-    if (fifoPtr->first_ptr == (EbObjectWrapper *)NULL)
-        return TRUE;
-    else
-        return FALSE;
+    return svt_get_full_object_after_wait(full_fifo_ptr, wrapper_dbl_ptr);
 }
 
 EbErrorType svt_get_full_object_non_blocking(EbFifo *full_fifo_ptr, EbObjectWrapper **wrapper_dbl_ptr) {
-    EbErrorType return_error = EB_ErrorNone;
-    Bool        fifo_empty;
-    // Queue the Fifo requesting the full fifo
-    svt_release_process(full_fifo_ptr);
-
-    // Acquire lockout Mutex
-    svt_block_on_mutex(full_fifo_ptr->lockout_mutex);
-
     //if the fifo is shutting down, we will not give any buffer to caller
-    if (!full_fifo_ptr->quit_signal)
-        fifo_empty = svt_fifo_peak_front(full_fifo_ptr);
-    else
-        fifo_empty = TRUE;
-
-    // Release Mutex
-    svt_release_mutex(full_fifo_ptr->lockout_mutex);
-
-    if (fifo_empty == FALSE)
-        svt_get_full_object(full_fifo_ptr, wrapper_dbl_ptr);
-    else
+    if (svt_atomic_load_u32((volatile uint32_t *)&full_fifo_ptr->quit_signal) ||
+        !svt_muxing_queue_try_wait(full_fifo_ptr->queue_ptr)) {
         *wrapper_dbl_ptr = (EbObjectWrapper *)NULL;
+        return EB_ErrorNone;
+    }
 
-    return return_error;
+    svt_get_full_object_after_wait(full_fifo_ptr, wrapper_dbl_ptr);
+
+    return EB_ErrorNone;
 }
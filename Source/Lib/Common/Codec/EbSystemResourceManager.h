@@ -49,9 +49,15 @@ typedef struct EbObjectWrapper {
     //   that the object belongs to.
     struct EbSystemResource *system_resource_ptr;
 
-    // next_ptr - a pointer to a different EbObjectWrapper.  Used
-    //   only in the implemenation of a single-linked Fifo.
-    struct EbObjectWrapper *next_ptr;
+    // post_time, get_time - times the object was last posted to and taken
+    //   from the fullFifo, set when the SystemResource is profiled.
+    uint64_t post_time;
+    uint64_t get_time;
+
+    // node_id - NUMA node the object memory is bound to, when the
+    //   SystemResource spreads its objects over nodes.
+    uint32_t node_id;
+
 #if SRM_REPORT
     uint64_t pic_number;
 #endif
@@ -59,28 +65,12 @@ typedef struct EbObjectWrapper {
 
 /*********************************************************************
      * Fifo
-     *   Defines a static (i.e. no dynamic memory allocation) single
-     *   linked-list, constant time fifo implmentation. The fifo uses
-     *   the EbObjectWrapper member next_ptr to create the linked-list.
-     *   The Fifo also contains a counting_semaphore for OS thread-blocking
-     *   and dynamic EbObjectWrapper counting.
+     *   Per process handle on a MuxingQueue. Every process taking objects
+     *   out of a MuxingQueue owns one EbFifo, which carries the shutdown
+     *   signal of that process.
      *********************************************************************/
 typedef struct EbFifo {
     EbDctor dctor;
-    // counting_semaphore - used for OS thread-blocking & dynamically
-    //   counting the number of EbObjectWrappers currently in the
-    //   EbFifo.
-    EbHandle counting_semaphore;
-
-    // lockout_mutex - used to prevent more than one thread from
-    //   modifying EbFifo simultaneously.
-    EbHandle lockout_mutex;
-
-    // first_ptr - pointer the the head of the Fifo
-    EbObjectWrapper *first_ptr;
-
-    // last_ptr - pointer to the tail of the Fifo
-    EbObjectWrapper *last_ptr;
 
     // quit_signal - a flag that main thread sets to break out from kernels
     Bool quit_signal;
@@ -90,28 +80,51 @@ typedef struct EbFifo {
     struct EbMuxingQueue *queue_ptr;
 } EbFifo;
 
-/*********************************************************************
-     * CircularBuffer
-     *********************************************************************/
-typedef struct EbCircularBuffer {
-    EbDctor  dctor;
-    EbPtr   *array_ptr;
-    uint32_t head_index;
-    uint32_t tail_index;
-    uint32_t buffer_total_count;
-    uint32_t current_count;
-} EbCircularBuffer;
-
 /*********************************************************************
      * MuxingQueue
+     *   Bounded lock-free multi-producer multi-consumer queue of
+     *   EbObjectWrappers. Each cell carries a sequence number telling
+     *   whether it is ready to be written (sequence == position) or read
+     *   (sequence == position + 1), so producers and consumers only
+     *   contend on a compare-and-swap of their respective position.
+     *
+     *   Consumers wait on the available count: they spin for a while on
+     *   multi-core systems, then park on park_semaphore once the count goes
+     *   negative. Producers only post the semaphore when a consumer is parked.
      *********************************************************************/
+typedef struct EbMuxingCell {
+    volatile uint32_t sequence;
+    EbObjectWrapper  *wrapper_ptr;
+} EbMuxingCell;
+
 typedef struct EbMuxingQueue {
-    EbDctor           dctor;
-    EbHandle          lockout_mutex;
-    EbCircularBuffer *object_queue;
-    EbCircularBuffer *process_queue;
-    uint32_t          process_total_count;
-    EbFifo          **process_fifo_ptr_array;
+    EbDctor dctor;
+    // lockout_mutex - protects the live_count and release_enable members of
+    //   the EbObjectWrappers of the emptyFifo's SystemResource.
+    EbHandle lockout_mutex;
+
+    // cell_array - cell_mask + 1 cells, a power of 2 not smaller than the
+    //   number of objects of the SystemResource, so the queue never fills up.
+    EbMuxingCell *cell_array;
+    uint32_t      cell_mask;
+
+    // enqueue_pos / dequeue_pos - producer and consumer positions, kept on
+    //   separate cache lines.
+    uint8_t           pad0[64];
+    volatile uint32_t enqueue_pos;
+    uint8_t           pad1[64];
+    volatile uint32_t dequeue_pos;
+    uint8_t           pad2[64];
+
+    // available - number of objects in the queue not yet claimed by a
+    //   consumer, minus the number of parked consumers when negative.
+    volatile int32_t available;
+    EbHandle         park_semaphore;
+    // spin_count - number of polls of the available count before parking
+    uint32_t spin_count;
+
+    uint32_t process_total_count;
+    EbFifo **process_fifo_ptr_array;
 #if SRM_REPORT
     uint32_t curr_count; //run time fullness
     uint8_t  log; //if set monitor out the queue size
@@ -142,6 +155,40 @@ typedef struct EbSystemResource {
 
     // The full FIFO contains a queue of completed buffers
     EbMuxingQueue *full_queue;
+
+    // object_release_cb - optional, called with object_release_ctx and the
+    //   object each time svt_release_object releases an EbObjectWrapper for
+    //   reuse, before it is queued back to the emptyFifo and outside of the
+    //   lockout_mutex.
+    void (*object_release_cb)(void *ctx, void *object_ptr);
+    void *object_release_ctx;
+
+    // object_post_cb - optional, called with object_post_ctx each time
+    //   svt_post_full_object queues an EbObjectWrapper to the fullFifo, so
+    //   that consumers not waiting on the fullFifo (e.g. the task scheduler
+    //   workers) get notified.
+    void (*object_post_cb)(void *ctx);
+    void *object_post_ctx;
+
+    // profiler_ptr - optional, records the queue wait and processing time
+    //   of each object taken from the fullFifo under the profiler_stage, and
+    //   the picture number object_picture_number_cb returns for the object.
+    struct EbPipelineProfiler *profiler_ptr;
+    uint32_t                   profiler_stage;
+    uint64_t (*object_picture_number_cb)(void *object_ptr);
+
+    // node_count - optional, number of NUMA nodes the objects are spread
+    //   over, the objects being bound to node_array[index % node_count] in
+    //   turn. node_bytes holds the bytes bound to each node, unbound_bytes
+    //   the ones binding failed for. The node_local_count and
+    //   node_remote_count empty objects were handed out on the node asked
+    //   for, and on another node.
+    uint32_t          node_count;
+    uint32_t         *node_array;
+    uint64_t         *node_bytes;
+    uint64_t          unbound_bytes;
+    volatile int32_t  node_local_count;
+    volatile int32_t  node_remote_count;
 } EbSystemResource;
 
 /*********************************************************************
@@ -222,6 +269,19 @@ extern EbErrorType svt_system_resource_ctor(EbSystemResource *resource_ptr, uint
                                             uint32_t consumer_process_total_count, EbCreator object_ctor,
                                             EbPtr object_init_data_ptr, EbDctor object_destroyer);
 
+/*********************************************************************
+     * svt_system_resource_numa_ctor
+     *   Constructs a SystemResource whose objects are spread over the
+     *   node_count NUMA nodes of node_array: the aligned allocations of
+     *   each object are bound to its node. Same as
+     *   svt_system_resource_ctor when node_count is below 2.
+     *********************************************************************/
+extern EbErrorType svt_system_resource_numa_ctor(EbSystemResource *resource_ptr, uint32_t node_count,
+                                                 const uint32_t *node_array, uint32_t object_total_count,
+                                                 uint32_t producer_process_total_count,
+                                                 uint32_t consumer_process_total_count, EbCreator object_ctor,
+                                                 EbPtr object_init_data_ptr, EbDctor object_destroyer);
+
 /*********************************************************************
      * svt_system_resource_get_producer_fifo
      *   get producer fifo
@@ -250,9 +310,8 @@ EbFifo *svt_system_resource_get_consumer_fifo(const EbSystemResource *resource_p
      * EbSystemResourceGetEmptyObject
      *   Dequeues an empty EbObjectWrapper from the SystemResource.  The
      *   new EbObjectWrapper will be populated with the contents of the
-     *   wrapperCopyPtr if wrapperCopyPtr is not NULL. This function blocks
-     *   on the SystemResource emptyFifo counting_semaphore. This function
-     *   is write protected by the SystemResource emptyFifo lockout_mutex.
+     *   wrapperCopyPtr if wrapperCopyPtr is not NULL. This function spins,
+     *   then blocks, until the SystemResource emptyFifo holds an object.
      *
      *   resource_ptr
      *      pointer to the SystemResource that provides the empty
@@ -263,6 +322,16 @@ EbFifo *svt_system_resource_get_consumer_fifo(const EbSystemResource *resource_p
      *      EbObjectWrapper pointer.
      *********************************************************************/
 extern EbErrorType svt_get_empty_object(EbFifo *empty_fifo_ptr, EbObjectWrapper **wrapper_dbl_ptr);
+
+/*********************************************************************
+     * svt_get_empty_picture_object
+     *   svt_get_empty_object, preferring the empty objects bound to the
+     *   NUMA node of picture_number, node_array[picture_number %
+     *   node_count], when the SystemResource spreads its objects over
+     *   nodes. Waits for one empty object only.
+     *********************************************************************/
+extern EbErrorType svt_get_empty_picture_object(EbFifo *empty_fifo_ptr, uint64_t picture_number,
+                                                EbObjectWrapper **wrapper_dbl_ptr);
 #if SRM_REPORT
 /*
   dump pictures occuping the SRM
@@ -271,10 +340,8 @@ EbErrorType dump_srm_content(EbSystemResource *resource_ptr, uint8_t log);
 #endif
 /*********************************************************************
      * EbSystemResourcePostObject
-     *   Queues a full EbObjectWrapper to the SystemResource. This
-     *   function posts the SystemResource fullFifo counting_semaphore.
-     *   This function is write protected by the SystemResource fullFifo
-     *   lockout_mutex.
+     *   Queues a full EbObjectWrapper to the SystemResource and wakes up
+     *   a parked consumer if any.
      *
      *   resource_ptr
      *      pointer to the SystemResource that the EbObjectWrapper is
@@ -288,9 +355,8 @@ extern EbErrorType svt_post_full_object(EbObjectWrapper *object_ptr);
 /*********************************************************************
      * EbSystemResourceGetFullObject
      *   Dequeues an full EbObjectWrapper from the SystemResource. This
-     *   function blocks on the SystemResource fullFifo counting_semaphore.
-     *   This function is write protected by the SystemResource fullFifo
-     *   lockout_mutex.
+     *   function spins, then blocks, until the SystemResource fullFifo
+     *   holds an object or the consumer is shut down.
      *
      *   resource_ptr
      *      pointer to the SystemResource that provides the full
@@ -306,10 +372,9 @@ extern EbErrorType svt_get_full_object_non_blocking(EbFifo *full_fifo_ptr, EbObj
 
 /*********************************************************************
      * EbSystemResourceReleaseObject
-     *   Queues an empty EbObjectWrapper to the SystemResource. This
-     *   function posts the SystemResource emptyFifo counting_semaphore.
-     *   This function is write protected by the SystemResource emptyFifo
-     *   lockout_mutex.
+     *   Queues an empty EbObjectWrapper to the SystemResource once its
+     *   live_count drops to 0. The live_count is write protected by the
+     *   SystemResource emptyFifo lockout_mutex.
      *
      *   object_ptr
      *      pointer to EbObjectWrapper to be released.
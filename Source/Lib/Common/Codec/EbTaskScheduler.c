@@ -0,0 +1,873 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "EbTaskScheduler.h"
+#include "EbCpuTopology.h"
+#include "EbLog.h"
+#include "EbThreads.h"
+#include "EbUtility.h"
+
+#ifdef _MSC_VER
+#define TASK_THREAD_LOCAL __declspec(thread)
+#else
+#define TASK_THREAD_LOCAL __thread
+#endif
+
+// Set in the reference count of a client while its scheduler is attached
+#define TASK_CLIENT_ATTACHED 0x80000000u
+
+typedef struct EbTaskClient {
+    EbTaskScheduler *scheduler_ptr;
+    // Workers using the scheduler, plus TASK_CLIENT_ATTACHED
+    volatile uint32_t ref_count;
+} EbTaskClient;
+
+/*********************************************************************
+ * Task Pool
+ *   Workers running the tasks of the schedulers attached to the pool.
+ *********************************************************************/
+typedef struct EbTaskPool {
+    EbDctor dctor;
+    // Number of workers running tasks at a time
+    uint32_t worker_count;
+    // Number of workers created at most, including the ones taking over the
+    // slot of a blocked worker
+    uint32_t          worker_total_count;
+    EbTaskWorker     *worker_list;
+    volatile uint32_t created_count;
+    // Workers neither parked nor blocked
+    volatile int32_t active_count;
+    // Wake-up tokens, negative when workers are parked on park_semaphore
+    volatile int32_t    wake_count;
+    EbHandle            park_semaphore;
+    EbHandle            create_mutex;
+    volatile uint32_t   quit_signal;
+    EbTaskThreadCreator create_thread;
+    // Schedulers attached, in the first client_count clients
+    EbTaskClient      client_array[EB_TASK_POOL_CLIENT_COUNT];
+    volatile uint32_t client_count;
+    uint32_t          attached_count;
+    // Cache domains the workers are bound to, NULL unless placed on several domains
+    EbCpuTopology *topology_ptr;
+    // Domains the worker slots are bound to, the home domains of the routed objects,
+    // grouped by NUMA node: the domains of the home node n are the ones from
+    // home_node_first[n] to home_node_first[n + 1]
+    uint32_t home_domain_array[EB_CPU_TOPOLOGY_MAX_DOMAINS];
+    uint32_t home_domain_count;
+    uint32_t home_node_first[EB_CPU_TOPOLOGY_MAX_NODES + 1];
+    uint32_t home_node_count;
+} EbTaskPool;
+
+// Worker run by the calling thread, NULL outside of the task scheduler workers
+static TASK_THREAD_LOCAL EbTaskWorker *current_worker;
+
+// Pool shared by the schedulers of the process, guarded by shared_pool_mutex
+static EbTaskPool *shared_pool;
+static EbHandle    shared_pool_mutex;
+
+static void shared_pool_mutex_cleanup(void) { svt_destroy_mutex(shared_pool_mutex); }
+static void create_shared_pool_mutex(void) {
+    shared_pool_mutex = svt_create_mutex();
+    atexit(shared_pool_mutex_cleanup);
+}
+
+#ifdef _WIN32
+
+#include <windows.h>
+
+static INIT_ONCE shared_pool_once = INIT_ONCE_STATIC_INIT;
+
+static BOOL CALLBACK create_shared_pool_mutex_wrapper(PINIT_ONCE InitOnce, PVOID Parameter, PVOID *lpContext) {
+    (void)InitOnce;
+    (void)Parameter;
+    (void)lpContext;
+    create_shared_pool_mutex();
+    return TRUE;
+}
+
+static EbHandle get_shared_pool_mutex(void) {
+    InitOnceExecuteOnce(&shared_pool_once, create_shared_pool_mutex_wrapper, NULL, NULL);
+    return shared_pool_mutex;
+}
+#else
+#include <pthread.h>
+
+static pthread_once_t shared_pool_once = PTHREAD_ONCE_INIT;
+
+static EbHandle get_shared_pool_mutex(void) {
+    pthread_once(&shared_pool_once, create_shared_pool_mutex);
+    return shared_pool_mutex;
+}
+#endif // _WIN32
+
+static void task_pool_dctor(EbPtr p) {
+    EbTaskPool *obj           = (EbTaskPool *)p;
+    uint32_t    created_count = 0;
+
+    if (obj->create_mutex) {
+        // No worker is created past the quit signal
+        svt_block_on_mutex(obj->create_mutex);
+        svt_atomic_store_u32(&obj->quit_signal, TRUE);
+        created_count = obj->created_count;
+        svt_release_mutex(obj->create_mutex);
+    }
+    // Unpark every worker, each of them quits once there is no task left
+    for (uint32_t worker_index = 0; worker_index < created_count; ++worker_index)
+        svt_post_semaphore(obj->park_semaphore);
+    while (obj->worker_list) {
+        EbTaskWorker *worker_ptr = obj->worker_list;
+        obj->worker_list         = worker_ptr->next_ptr;
+        EB_DESTROY_THREAD(worker_ptr->thread_handle);
+        EB_FREE(worker_ptr);
+    }
+    EB_DESTROY_SEMAPHORE(obj->park_semaphore);
+    EB_DESTROY_MUTEX(obj->create_mutex);
+    EB_DELETE(obj->topology_ptr);
+}
+
+/*********************************************************************
+ * task_pool_wake
+ *   Hands a wake-up token to the workers, unparking one of them if any is
+ *   parked. Tokens are capped to the worker count: that many workers
+ *   looking for input again can not miss the object just posted.
+ *********************************************************************/
+static void task_pool_wake(EbTaskPool *pool_ptr) {
+    int32_t wake_count = (int32_t)svt_atomic_load_u32((volatile uint32_t *)&pool_ptr->wake_count);
+
+    for (;;) {
+        if (wake_count >= (int32_t)pool_ptr->worker_count)
+            return;
+        if (svt_atomic_cas_u32(
+                (volatile uint32_t *)&pool_ptr->wake_count, (uint32_t)wake_count, (uint32_t)(wake_count + 1)))
+            break;
+        wake_count = (int32_t)svt_atomic_load_u32((volatile uint32_t *)&pool_ptr->wake_count);
+    }
+    if (wake_count < 0)
+        svt_post_semaphore(pool_ptr->park_semaphore);
+}
+
+/*********************************************************************
+ * task_pool_park
+ *   Takes a wake-up token, parking the worker until one is handed.
+ *********************************************************************/
+static void task_pool_park(EbTaskPool *pool_ptr, EbTaskWorker *worker_ptr) {
+    svt_atomic_fetch_add_i32(&pool_ptr->active_count, -1);
+    if (svt_atomic_fetch_add_i32(&pool_ptr->wake_count, -1) <= 0)
+        svt_block_on_semaphore(pool_ptr->park_semaphore);
+    svt_atomic_fetch_add_i32(&pool_ptr->active_count, 1);
+    worker_ptr->scan_pending = TRUE;
+}
+
+/*********************************************************************
+ * task_pool_park_excess
+ *   Parks the worker if more than worker_count workers are active. The
+ *   active count is decremented with a compare-and-swap, so that a worker
+ *   blocking at the same time, and counting on this one to run the tasks,
+ *   hands its slot over instead. A worker woken since its last scan
+ *   without task keeps running: the other workers may have scanned before
+ *   the objects it was woken for were posted.
+ *********************************************************************/
+static void task_pool_park_excess(EbTaskPool *pool_ptr, EbTaskWorker *worker_ptr) {
+    if (worker_ptr->scan_pending)
+        return;
+    int32_t active_count = (int32_t)svt_atomic_load_u32((volatile uint32_t *)&pool_ptr->active_count);
+
+    for (;;) {
+        if (active_count <= (int32_t)pool_ptr->worker_count)
+            return;
+        if (svt_atomic_cas_u32((volatile uint32_t *)&pool_ptr->active_count,
+                               (uint32_t)active_count,
+                               (uint32_t)(active_count - 1)))
+            break;
+        active_count = (int32_t)svt_atomic_load_u32((volatile uint32_t *)&pool_ptr->active_count);
+    }
+    if (svt_atomic_fetch_add_i32(&pool_ptr->wake_count, -1) <= 0)
+        svt_block_on_semaphore(pool_ptr->park_semaphore);
+    svt_atomic_fetch_add_i32(&pool_ptr->active_count, 1);
+    worker_ptr->scan_pending = TRUE;
+}
+
+/*********************************************************************
+ * task_pool_acquire_client
+ *   Returns the scheduler of a client, NULL unless attached. The
+ *   scheduler stays attached until task_pool_release_client.
+ *********************************************************************/
+static EbTaskScheduler *task_pool_acquire_client(EbTaskClient *client_ptr) {
+    uint32_t ref_count = svt_atomic_load_u32(&client_ptr->ref_count);
+
+    while (ref_count & TASK_CLIENT_ATTACHED) {
+        if (svt_atomic_cas_u32(&client_ptr->ref_count, ref_count, ref_count + 1))
+            return client_ptr->scheduler_ptr;
+        ref_count = svt_atomic_load_u32(&client_ptr->ref_count);
+    }
+    return NULL;
+}
+
+static void task_pool_release_client(EbTaskClient *client_ptr) {
+    svt_atomic_fetch_add_i32((volatile int32_t *)&client_ptr->ref_count, -1);
+}
+
+static Bool task_mailbox_push(EbTaskMailbox *mailbox_ptr, EbObjectWrapper *wrapper_ptr) {
+    Bool pushed = FALSE;
+
+    svt_block_on_mutex(mailbox_ptr->mutex);
+    if (mailbox_ptr->count < EB_TASK_MAILBOX_SIZE) {
+        mailbox_ptr->wrapper_array[(mailbox_ptr->head + mailbox_ptr->count) % EB_TASK_MAILBOX_SIZE] = wrapper_ptr;
+        svt_atomic_store_u32(&mailbox_ptr->count, mailbox_ptr->count + 1);
+        pushed = TRUE;
+    }
+    svt_release_mutex(mailbox_ptr->mutex);
+    return pushed;
+}
+
+static EbObjectWrapper *task_mailbox_pop(EbTaskMailbox *mailbox_ptr) {
+    EbObjectWrapper *wrapper_ptr = NULL;
+
+    if (!svt_atomic_load_u32(&mailbox_ptr->count))
+        return NULL;
+    svt_block_on_mutex(mailbox_ptr->mutex);
+    if (mailbox_ptr->count) {
+        wrapper_ptr       = mailbox_ptr->wrapper_array[mailbox_ptr->head];
+        mailbox_ptr->head = (mailbox_ptr->head + 1) % EB_TASK_MAILBOX_SIZE;
+        svt_atomic_store_u32(&mailbox_ptr->count, mailbox_ptr->count - 1);
+    }
+    svt_release_mutex(mailbox_ptr->mutex);
+    return wrapper_ptr;
+}
+
+/*********************************************************************
+ * task_scheduler_route
+ *   Posts an object taken from a fifo to the mailbox of its home domain.
+ *   The affinity key picks the home NUMA node first, as the picture pools
+ *   do, then a domain of that node. Returns FALSE when the worker runs it:
+ *   the worker is in the home domain, or the mailbox is full.
+ *********************************************************************/
+static Bool task_scheduler_route(EbTaskScheduler *scheduler_ptr, EbTaskType *type_ptr, EbTaskWorker *worker_ptr,
+                                 EbObjectWrapper *wrapper_ptr) {
+    EbTaskPool    *pool_ptr     = worker_ptr->pool_ptr;
+    const uint64_t key          = type_ptr->affinity(wrapper_ptr);
+    const uint32_t node_slot    = (uint32_t)(key % pool_ptr->home_node_count);
+    const uint32_t first        = pool_ptr->home_node_first[node_slot];
+    const uint32_t count        = pool_ptr->home_node_first[node_slot + 1] - first;
+    const uint32_t domain_index = pool_ptr->home_domain_array[first + key / pool_ptr->home_node_count % count];
+
+    if (domain_index == worker_ptr->domain_index) {
+        svt_atomic_fetch_add_i32(&scheduler_ptr->home_count, 1);
+        return FALSE;
+    }
+    if (!task_mailbox_push(&type_ptr->mailbox_array[domain_index], wrapper_ptr)) {
+        svt_atomic_fetch_add_i32(&scheduler_ptr->away_count, 1);
+        return FALSE;
+    }
+    svt_atomic_fetch_add_i32(&scheduler_ptr->routed_count, 1);
+    task_pool_wake(pool_ptr);
+    return TRUE;
+}
+
+/*********************************************************************
+ * task_scheduler_take_input
+ *   Takes an input object of a task type: the first pass takes the
+ *   objects routed to the domain of the worker, then the fifo ones,
+ *   routing them; the second pass takes the objects routed to the other
+ *   domains. Sets routed when an object was posted to another domain.
+ *********************************************************************/
+static EbObjectWrapper *task_scheduler_take_input(EbTaskScheduler *scheduler_ptr, EbTaskType *type_ptr,
+                                                  EbTaskWorker *worker_ptr, uint32_t pass, Bool *routed) {
+    EbObjectWrapper *wrapper_ptr = NULL;
+
+    if (!type_ptr->mailbox_array) {
+        svt_get_full_object_non_blocking(type_ptr->input_fifo_ptr, &wrapper_ptr);
+        return wrapper_ptr;
+    }
+    if (pass) {
+        const uint32_t domain_count = scheduler_ptr->domain_count;
+        for (uint32_t offset = 1; offset < domain_count && !wrapper_ptr; ++offset)
+            wrapper_ptr = task_mailbox_pop(
+                &type_ptr->mailbox_array[(worker_ptr->domain_index + offset) % domain_count]);
+        if (wrapper_ptr)
+            svt_atomic_fetch_add_i32(&scheduler_ptr->away_count, 1);
+        return wrapper_ptr;
+    }
+    if ((wrapper_ptr = task_mailbox_pop(&type_ptr->mailbox_array[worker_ptr->domain_index])))
+        return wrapper_ptr;
+    svt_get_full_object_non_blocking(type_ptr->input_fifo_ptr, &wrapper_ptr);
+    if (wrapper_ptr && task_scheduler_route(scheduler_ptr, type_ptr, worker_ptr, wrapper_ptr)) {
+        *routed = TRUE;
+        return NULL;
+    }
+    return wrapper_ptr;
+}
+
+/*********************************************************************
+ * task_type_has_input
+ *   Tells whether task_scheduler_take_input may find an object, without
+ *   taking it.
+ *********************************************************************/
+static Bool task_type_has_input(EbTaskScheduler *scheduler_ptr, EbTaskType *type_ptr, EbTaskWorker *worker_ptr,
+                                uint32_t pass) {
+    if (pass) {
+        const uint32_t domain_count = scheduler_ptr->domain_count;
+        for (uint32_t offset = 1; offset < domain_count; ++offset) {
+            if (svt_atomic_load_u32(
+                    &type_ptr->mailbox_array[(worker_ptr->domain_index + offset) % domain_count].count))
+                return TRUE;
+        }
+        return FALSE;
+    }
+    if (type_ptr->mailbox_array && svt_atomic_load_u32(&type_ptr->mailbox_array[worker_ptr->domain_index].count))
+        return TRUE;
+    return !svt_atomic_load_u32((volatile uint32_t *)&type_ptr->input_fifo_ptr->quit_signal) &&
+        (int32_t)svt_atomic_load_u32((volatile uint32_t *)&type_ptr->input_fifo_ptr->queue_ptr->available) > 0;
+}
+
+/*********************************************************************
+ * task_scheduler_run_task
+ *   Runs one task of a scheduler, looking for input on the home stage of
+ *   the worker first, then on the other stages from the last one. The
+ *   objects routed to other cache domains are taken last. Returns FALSE
+ *   when no stage has both an input object and a free context, and no
+ *   object was routed.
+ *
+ *   A worker skips a stage whose contexts are all taken, so a worker
+ *   finding no input in the context it took looks for input again once it
+ *   gave the context back: an object posted meanwhile would otherwise be
+ *   left to the workers parking.
+ *********************************************************************/
+static Bool task_scheduler_run_task(EbTaskScheduler *scheduler_ptr, EbTaskWorker *worker_ptr) {
+    const uint32_t type_count = scheduler_ptr->task_type_count;
+    const uint32_t home_index = worker_ptr->worker_index % type_count;
+    const uint32_t pass_count = scheduler_ptr->domain_count > 1 ? 2 : 1;
+    Bool           routed     = FALSE;
+
+    for (uint32_t pass = 0; pass < pass_count; ++pass) {
+        for (uint32_t scan_index = 0; scan_index <= type_count; ++scan_index) {
+            uint32_t type_index;
+            if (scan_index == 0)
+                type_index = home_index;
+            else if ((type_index = type_count - scan_index) == home_index)
+                continue;
+            EbTaskType *type_ptr = &scheduler_ptr->task_type_array[type_index];
+            if (pass && !type_ptr->mailbox_array)
+                continue;
+
+            while (task_type_has_input(scheduler_ptr, type_ptr, worker_ptr, pass)) {
+                uint32_t context_index;
+                for (context_index = 0; context_index < type_ptr->context_count; ++context_index) {
+                    if (!svt_atomic_load_u32(&type_ptr->context_busy_array[context_index]) &&
+                        svt_atomic_cas_u32(&type_ptr->context_busy_array[context_index], FALSE, TRUE))
+                        break;
+                }
+                if (context_index == type_ptr->context_count)
+                    break;
+
+                EbObjectWrapper *wrapper_ptr = task_scheduler_take_input(
+                    scheduler_ptr, type_ptr, worker_ptr, pass, &routed);
+                if (wrapper_ptr) {
+                    svt_atomic_fetch_add_i32(&scheduler_ptr->running_count, 1);
+                    worker_ptr->in_task = TRUE;
+                    type_ptr->task_function(type_ptr->context_ptr_array[context_index], wrapper_ptr);
+                    worker_ptr->in_task = FALSE;
+                    svt_atomic_fetch_add_i32(&scheduler_ptr->running_count, -1);
+                }
+                // Sequentially consistent, ordered before the input is looked at again
+                svt_atomic_cas_u32(&type_ptr->context_busy_array[context_index], TRUE, FALSE);
+                if (wrapper_ptr)
+                    return TRUE;
+            }
+        }
+    }
+    return routed;
+}
+
+/*********************************************************************
+ * task_pool_run_task
+ *   Runs one task of the attached schedulers, taken by increasing share
+ *   of the workers: running task count over weight. Schedulers with the
+ *   same share are taken from the worker index on, spreading the workers.
+ *********************************************************************/
+static Bool task_pool_run_task(EbTaskPool *pool_ptr, EbTaskWorker *worker_ptr) {
+    const uint32_t client_count = svt_atomic_load_u32(&pool_ptr->client_count);
+    uint32_t       order[EB_TASK_POOL_CLIENT_COUNT];
+    uint32_t       share[EB_TASK_POOL_CLIENT_COUNT];
+    uint32_t       order_count = 0;
+
+    for (uint32_t scan_index = 0; scan_index < client_count; ++scan_index) {
+        const uint32_t   client_index  = (worker_ptr->worker_index + scan_index) % client_count;
+        EbTaskClient    *client_ptr    = &pool_ptr->client_array[client_index];
+        EbTaskScheduler *scheduler_ptr = task_pool_acquire_client(client_ptr);
+        if (!scheduler_ptr)
+            continue;
+        const int32_t  running_count = svt_atomic_fetch_add_i32(&scheduler_ptr->running_count, 0);
+        const uint32_t client_share  = (uint32_t)AOMMAX(running_count, 0) * EB_TASK_SCHEDULER_MAX_WEIGHT /
+            scheduler_ptr->weight;
+        task_pool_release_client(client_ptr);
+
+        uint32_t insert_index = order_count++;
+        for (; insert_index > 0 && share[insert_index - 1] > client_share; --insert_index) {
+            order[insert_index] = order[insert_index - 1];
+            share[insert_index] = share[insert_index - 1];
+        }
+        order[insert_index] = client_index;
+        share[insert_index] = client_share;
+    }
+    for (uint32_t order_index = 0; order_index < order_count; ++order_index) {
+        EbTaskClient    *client_ptr    = &pool_ptr->client_array[order[order_index]];
+        EbTaskScheduler *scheduler_ptr = task_pool_acquire_client(client_ptr);
+        if (!scheduler_ptr)
+            continue;
+        const Bool ran = task_scheduler_run_task(scheduler_ptr, worker_ptr);
+        task_pool_release_client(client_ptr);
+        if (ran)
+            return TRUE;
+    }
+    return FALSE;
+}
+
+static void *task_worker_kernel(void *input_ptr) {
+    EbTaskWorker *worker_ptr = (EbTaskWorker *)input_ptr;
+    EbTaskPool   *pool_ptr   = worker_ptr->pool_ptr;
+
+    current_worker = worker_ptr;
+    for (;;) {
+        if (task_pool_run_task(pool_ptr, worker_ptr)) {
+            // Park the workers in excess once the blocked ones are back
+            task_pool_park_excess(pool_ptr, worker_ptr);
+            continue;
+        }
+        worker_ptr->scan_pending = FALSE;
+        if (svt_atomic_load_u32(&pool_ptr->quit_signal))
+            break;
+        task_pool_park(pool_ptr, worker_ptr);
+    }
+    return NULL;
+}
+
+/*********************************************************************
+ * task_pool_worker_domain
+ *   Spreads the worker slots over the cache domains by processor count.
+ *   The workers taking over the slot of a blocked worker share the domain
+ *   of the slot.
+ *********************************************************************/
+static uint32_t task_pool_worker_domain(const EbTaskPool *pool_ptr, uint32_t worker_index) {
+    const EbCpuTopology *topology_ptr = pool_ptr->topology_ptr;
+    if (!topology_ptr)
+        return 0;
+    const uint32_t slot_index   = worker_index % pool_ptr->worker_count;
+    uint32_t       cpu_index    = (uint32_t)((uint64_t)slot_index * topology_ptr->cpu_count / pool_ptr->worker_count);
+    uint32_t       domain_index = 0;
+
+    while (cpu_index >= topology_ptr->domain_array[domain_index].cpu_count)
+        cpu_index -= topology_ptr->domain_array[domain_index++].cpu_count;
+    return domain_index;
+}
+
+static void task_pool_bind_worker(EbTaskPool *pool_ptr, EbTaskWorker *worker_ptr) {
+    char cpu_list[256];
+
+    svt_cpu_topology_format_domain(pool_ptr->topology_ptr, worker_ptr->domain_index, cpu_list, sizeof(cpu_list));
+    if (svt_cpu_topology_bind_thread(pool_ptr->topology_ptr, worker_ptr->domain_index, worker_ptr->thread_handle))
+        SVT_DEBUG("task pool worker %u bound to cache domain %u (cpus %s)\n",
+                  worker_ptr->worker_index,
+                  worker_ptr->domain_index,
+                  cpu_list);
+    else
+        SVT_DEBUG("task pool worker %u of cache domain %u could not be bound (cpus %s)\n",
+                  worker_ptr->worker_index,
+                  worker_ptr->domain_index,
+                  cpu_list);
+}
+
+/*********************************************************************
+ * task_pool_create_worker
+ *   Creates one more worker, up to worker_total_count.
+ *********************************************************************/
+static EbErrorType task_pool_create_worker(EbTaskPool *pool_ptr) {
+    EbErrorType return_error = EB_ErrorNone;
+
+    svt_block_on_mutex(pool_ptr->create_mutex);
+    if (!pool_ptr->quit_signal && pool_ptr->created_count < pool_ptr->worker_total_count) {
+        EbTaskWorker *worker_ptr;
+        EB_NO_THROW_MALLOC(worker_ptr, sizeof(*worker_ptr));
+        if (!worker_ptr) {
+            svt_release_mutex(pool_ptr->create_mutex);
+            return EB_ErrorInsufficientResources;
+        }
+        memset(worker_ptr, 0, sizeof(*worker_ptr));
+        worker_ptr->pool_ptr     = pool_ptr;
+        worker_ptr->worker_index = pool_ptr->created_count;
+        worker_ptr->domain_index = task_pool_worker_domain(pool_ptr, worker_ptr->worker_index);
+        worker_ptr->scan_pending = TRUE;
+        svt_atomic_fetch_add_i32(&pool_ptr->active_count, 1);
+        return_error = pool_ptr->create_thread(&worker_ptr->thread_handle, task_worker_kernel, worker_ptr);
+        if (return_error == EB_ErrorNone) {
+            if (pool_ptr->topology_ptr)
+                task_pool_bind_worker(pool_ptr, worker_ptr);
+            worker_ptr->next_ptr  = pool_ptr->worker_list;
+            pool_ptr->worker_list = worker_ptr;
+            pool_ptr->created_count++;
+        } else {
+            svt_atomic_fetch_add_i32(&pool_ptr->active_count, -1);
+            EB_FREE(worker_ptr);
+        }
+    }
+    svt_release_mutex(pool_ptr->create_mutex);
+    return return_error;
+}
+
+/*********************************************************************
+ * task_pool_place
+ *   Reads the cache domains of the processors the first worker may run
+ *   on, i.e. the ones left by the thread pinning settings, and binds the
+ *   first worker. The pool is not placed when its worker slots fall in a
+ *   single domain.
+ *********************************************************************/
+static EbErrorType task_pool_place(EbTaskPool *pool_ptr) {
+    EbTaskWorker *worker_ptr = pool_ptr->worker_list;
+    Bool          home[EB_CPU_TOPOLOGY_MAX_DOMAINS] = {FALSE};
+    char          cpu_list[256];
+
+    EB_NEW(pool_ptr->topology_ptr, svt_cpu_topology_ctor, worker_ptr->thread_handle);
+    for (uint32_t domain_index = 0; domain_index < pool_ptr->topology_ptr->domain_count; ++domain_index) {
+        svt_cpu_topology_format_domain(pool_ptr->topology_ptr, domain_index, cpu_list, sizeof(cpu_list));
+        SVT_DEBUG("task pool cache domain %u: cpus %s\n", domain_index, cpu_list);
+    }
+    for (uint32_t slot_index = 0; slot_index < pool_ptr->worker_count; ++slot_index)
+        home[task_pool_worker_domain(pool_ptr, slot_index)] = TRUE;
+    pool_ptr->home_domain_count = 0;
+    pool_ptr->home_node_count   = 0;
+    for (uint32_t node_slot = 0; node_slot < pool_ptr->topology_ptr->node_count; ++node_slot) {
+        const uint32_t first = pool_ptr->home_domain_count;
+        for (uint32_t domain_index = 0; domain_index < pool_ptr->topology_ptr->domain_count; ++domain_index) {
+            if (home[domain_index] &&
+                pool_ptr->topology_ptr->domain_array[domain_index].node_id ==
+                    pool_ptr->topology_ptr->node_array[node_slot])
+                pool_ptr->home_domain_array[pool_ptr->home_domain_count++] = domain_index;
+        }
+        if (pool_ptr->home_domain_count > first)
+            pool_ptr->home_node_first[pool_ptr->home_node_count++] = first;
+    }
+    pool_ptr->home_node_first[pool_ptr->home_node_count] = pool_ptr->home_domain_count;
+    if (pool_ptr->home_domain_count < 2) {
+        SVT_DEBUG("task pool workers in a single cache domain, not placed\n");
+        EB_DELETE(pool_ptr->topology_ptr);
+        pool_ptr->home_domain_count  = 1;
+        pool_ptr->home_node_count    = 1;
+        pool_ptr->home_node_first[1] = 1;
+        return EB_ErrorNone;
+    }
+    SVT_DEBUG("task pool workers in %u cache domains over %u numa nodes\n",
+              pool_ptr->home_domain_count,
+              pool_ptr->home_node_count);
+    // The first worker ran unbound until the domains were known
+    task_pool_bind_worker(pool_ptr, worker_ptr);
+    return EB_ErrorNone;
+}
+
+/*********************************************************************
+ * task_pool_ctor
+ *   Creates the pool and its worker_count workers, bound to cache domains
+ *   when placed.
+ *********************************************************************/
+static EbErrorType task_pool_ctor(EbTaskPool *pool_ptr, uint32_t worker_count, EbTaskThreadCreator create_thread,
+                                  Bool placement) {
+    pool_ptr->dctor              = task_pool_dctor;
+    pool_ptr->worker_count       = worker_count ? worker_count : 1;
+    pool_ptr->worker_total_count = pool_ptr->worker_count;
+    pool_ptr->create_thread      = create_thread;
+    pool_ptr->home_domain_count  = 1;
+    pool_ptr->home_node_count    = 1;
+    pool_ptr->home_node_first[1] = 1;
+
+    EB_CREATE_SEMAPHORE(pool_ptr->park_semaphore, 0, INT32_MAX);
+    EB_CREATE_MUTEX(pool_ptr->create_mutex);
+
+    for (uint32_t worker_index = 0; worker_index < pool_ptr->worker_count; ++worker_index) {
+        if (worker_index == 1 && placement) {
+            EbErrorType return_error = task_pool_place(pool_ptr);
+            if (return_error != EB_ErrorNone)
+                return return_error;
+        }
+        EbErrorType return_error = task_pool_create_worker(pool_ptr);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+    }
+    return EB_ErrorNone;
+}
+
+/*********************************************************************
+ * task_pool_attach
+ *   Attaches a scheduler to the first free client of the pool.
+ *********************************************************************/
+static EbErrorType task_pool_attach(EbTaskPool *pool_ptr, EbTaskScheduler *scheduler_ptr) {
+    EbErrorType return_error = EB_ErrorInsufficientResources;
+
+    svt_block_on_mutex(pool_ptr->create_mutex);
+    for (uint32_t client_index = 0; client_index < EB_TASK_POOL_CLIENT_COUNT; ++client_index) {
+        EbTaskClient *client_ptr = &pool_ptr->client_array[client_index];
+        // Workers may still release a client detached last
+        if (svt_atomic_load_u32(&client_ptr->ref_count))
+            continue;
+        client_ptr->scheduler_ptr   = scheduler_ptr;
+        scheduler_ptr->pool_ptr     = pool_ptr;
+        scheduler_ptr->client_index = client_index;
+        svt_atomic_store_u32(&client_ptr->ref_count, TASK_CLIENT_ATTACHED);
+        if (client_index >= pool_ptr->client_count)
+            svt_atomic_store_u32(&pool_ptr->client_count, client_index + 1);
+        // A task may wait on a SystemResource while holding its context, each
+        // context can hold one blocked worker
+        pool_ptr->worker_total_count += scheduler_ptr->context_count;
+        pool_ptr->attached_count++;
+        return_error = EB_ErrorNone;
+        break;
+    }
+    svt_release_mutex(pool_ptr->create_mutex);
+    return return_error;
+}
+
+/*********************************************************************
+ * task_pool_detach
+ *   Detaches a scheduler, once no worker uses it anymore. Returns the
+ *   number of schedulers still attached.
+ *********************************************************************/
+static uint32_t task_pool_detach(EbTaskPool *pool_ptr, EbTaskScheduler *scheduler_ptr) {
+    EbTaskClient *client_ptr = &pool_ptr->client_array[scheduler_ptr->client_index];
+    uint32_t      attached_count;
+
+    uint32_t ref_count = svt_atomic_load_u32(&client_ptr->ref_count);
+    while (!svt_atomic_cas_u32(&client_ptr->ref_count, ref_count, ref_count & ~TASK_CLIENT_ATTACHED))
+        ref_count = svt_atomic_load_u32(&client_ptr->ref_count);
+    // The tasks in flight return as the fifos of the scheduler are shut down
+    while (svt_atomic_load_u32(&client_ptr->ref_count)) svt_yield_thread();
+
+    svt_block_on_mutex(pool_ptr->create_mutex);
+    pool_ptr->worker_total_count -= scheduler_ptr->context_count;
+    attached_count = --pool_ptr->attached_count;
+    svt_release_mutex(pool_ptr->create_mutex);
+    scheduler_ptr->pool_ptr = NULL;
+    return attached_count;
+}
+
+static void svt_task_scheduler_dctor(EbPtr p) {
+    EbTaskScheduler *obj = (EbTaskScheduler *)p;
+
+    if (obj->pool_ptr) {
+        if (obj->shared) {
+            EbHandle mutex = get_shared_pool_mutex();
+            svt_block_on_mutex(mutex);
+            if (!task_pool_detach(obj->pool_ptr, obj))
+                EB_DELETE(shared_pool);
+            svt_release_mutex(mutex);
+        } else {
+            EbTaskPool *pool_ptr = obj->pool_ptr;
+            task_pool_detach(pool_ptr, obj);
+            EB_DELETE(pool_ptr);
+        }
+    }
+    if (obj->domain_count > 1)
+        SVT_DEBUG("task scheduler placement: %d tasks run in the cache domain of their picture, %d routed there, "
+                  "%d run in another domain\n",
+                  obj->home_count,
+                  obj->routed_count,
+                  obj->away_count);
+    if (obj->task_type_array) {
+        for (uint32_t type_index = 0; type_index < obj->task_type_count; ++type_index) {
+            EbTaskType *type_ptr = &obj->task_type_array[type_index];
+            EB_FREE_ARRAY(type_ptr->context_busy_array);
+            if (type_ptr->mailbox_array) {
+                for (uint32_t domain_index = 0; domain_index < obj->domain_count; ++domain_index)
+                    EB_DESTROY_MUTEX(type_ptr->mailbox_array[domain_index].mutex);
+                EB_FREE_ARRAY(type_ptr->mailbox_array);
+            }
+        }
+    }
+    EB_FREE_ARRAY(obj->task_type_array);
+}
+
+/*********************************************************************
+ * svt_task_scheduler_ctor
+ *********************************************************************/
+EbErrorType svt_task_scheduler_ctor(EbTaskScheduler *scheduler_ptr, uint32_t worker_count,
+                                    uint32_t task_type_total_count) {
+    scheduler_ptr->dctor                 = svt_task_scheduler_dctor;
+    scheduler_ptr->worker_count          = worker_count ? worker_count : 1;
+    scheduler_ptr->task_type_total_count = task_type_total_count;
+    scheduler_ptr->weight                = 1;
+
+    EB_CALLOC_ARRAY(scheduler_ptr->task_type_array, task_type_total_count);
+
+    return EB_ErrorNone;
+}
+
+/*********************************************************************
+ * task_scheduler_wake
+ *   Posting callback of the stage inputs.
+ *********************************************************************/
+static void task_scheduler_wake(void *ctx) {
+    EbTaskScheduler *scheduler_ptr = (EbTaskScheduler *)ctx;
+    if (scheduler_ptr->pool_ptr)
+        task_pool_wake(scheduler_ptr->pool_ptr);
+}
+
+/*********************************************************************
+ * svt_task_scheduler_add_task_type
+ *********************************************************************/
+EbErrorType svt_task_scheduler_add_task_type(EbTaskScheduler *scheduler_ptr, EbSystemResource *input_resource_ptr,
+                                             EbTaskFunction task_function, EbPtr *context_ptr_array,
+                                             uint32_t context_count) {
+    if (scheduler_ptr->task_type_count == scheduler_ptr->task_type_total_count || !context_count)
+        return EB_ErrorBadParameter;
+    EbTaskType *type_ptr = &scheduler_ptr->task_type_array[scheduler_ptr->task_type_count];
+
+    type_ptr->input_fifo_ptr    = svt_system_resource_get_consumer_fifo(input_resource_ptr, 0);
+    type_ptr->task_function     = task_function;
+    type_ptr->context_ptr_array = context_ptr_array;
+    type_ptr->context_count     = context_count;
+    EB_CALLOC_ARRAY(type_ptr->context_busy_array, context_count);
+    scheduler_ptr->task_type_count++;
+    scheduler_ptr->context_count += context_count;
+
+    input_resource_ptr->object_post_cb  = task_scheduler_wake;
+    input_resource_ptr->object_post_ctx = scheduler_ptr;
+    return EB_ErrorNone;
+}
+
+/*********************************************************************
+ * svt_task_scheduler_set_affinity
+ *********************************************************************/
+EbErrorType svt_task_scheduler_set_affinity(EbTaskScheduler *scheduler_ptr, EbSystemResource *input_resource_ptr,
+                                            EbTaskAffinity affinity) {
+    EbFifo *input_fifo_ptr = svt_system_resource_get_consumer_fifo(input_resource_ptr, 0);
+
+    for (uint32_t type_index = 0; type_index < scheduler_ptr->task_type_count; ++type_index) {
+        if (scheduler_ptr->task_type_array[type_index].input_fifo_ptr == input_fifo_ptr) {
+            scheduler_ptr->task_type_array[type_index].affinity = affinity;
+            return EB_ErrorNone;
+        }
+    }
+    return EB_ErrorBadParameter;
+}
+
+/*********************************************************************
+ * svt_task_scheduler_place
+ *********************************************************************/
+void svt_task_scheduler_place(EbTaskScheduler *scheduler_ptr) { scheduler_ptr->placement = TRUE; }
+
+/*********************************************************************
+ * task_scheduler_create_mailboxes
+ *   One mailbox per cache domain of the pool for the task types with an
+ *   affinity, when the scheduler and the pool are placed.
+ *********************************************************************/
+static EbErrorType task_scheduler_create_mailboxes(EbTaskScheduler *scheduler_ptr, EbTaskPool *pool_ptr) {
+    if (!scheduler_ptr->placement || !pool_ptr->topology_ptr)
+        return EB_ErrorNone;
+    scheduler_ptr->domain_count = pool_ptr->topology_ptr->domain_count;
+    for (uint32_t type_index = 0; type_index < scheduler_ptr->task_type_count; ++type_index) {
+        EbTaskType *type_ptr = &scheduler_ptr->task_type_array[type_index];
+        if (!type_ptr->affinity)
+            continue;
+        // The shared pool mutex may be held, nothing returns early
+        EB_NO_THROW_CALLOC(type_ptr->mailbox_array, scheduler_ptr->domain_count, sizeof(*type_ptr->mailbox_array));
+        if (!type_ptr->mailbox_array)
+            return EB_ErrorInsufficientResources;
+        for (uint32_t domain_index = 0; domain_index < scheduler_ptr->domain_count; ++domain_index) {
+            EbTaskMailbox *mailbox_ptr = &type_ptr->mailbox_array[domain_index];
+            mailbox_ptr->mutex         = svt_create_mutex();
+            EB_NO_THROW_ADD_MEM(mailbox_ptr->mutex, 1, EB_MUTEX);
+            if (!mailbox_ptr->mutex)
+                return EB_ErrorInsufficientResources;
+        }
+    }
+    return EB_ErrorNone;
+}
+
+/*********************************************************************
+ * svt_task_scheduler_share
+ *********************************************************************/
+void svt_task_scheduler_share(EbTaskScheduler *scheduler_ptr, uint32_t weight, uint32_t pool_worker_count) {
+    scheduler_ptr->shared       = TRUE;
+    scheduler_ptr->weight       = CLIP3(1, EB_TASK_SCHEDULER_MAX_WEIGHT, weight);
+    scheduler_ptr->worker_count = pool_worker_count ? pool_worker_count : 1;
+}
+
+/*********************************************************************
+ * svt_task_scheduler_start
+ *********************************************************************/
+EbErrorType svt_task_scheduler_start(EbTaskScheduler *scheduler_ptr, EbTaskThreadCreator create_thread) {
+    EbErrorType return_error;
+
+    if (!scheduler_ptr->task_type_count)
+        return EB_ErrorBadParameter;
+    if (!scheduler_ptr->shared) {
+        EbTaskPool *pool_ptr;
+        EB_NEW(pool_ptr, task_pool_ctor, scheduler_ptr->worker_count, create_thread, scheduler_ptr->placement);
+        return_error = task_scheduler_create_mailboxes(scheduler_ptr, pool_ptr);
+        if (return_error == EB_ErrorNone)
+            return_error = task_pool_attach(pool_ptr, scheduler_ptr);
+        if (return_error != EB_ErrorNone)
+            EB_DELETE(pool_ptr);
+        return return_error;
+    }
+
+    EbHandle mutex = get_shared_pool_mutex();
+    svt_block_on_mutex(mutex);
+    if (!shared_pool) {
+        EbTaskPool *pool_ptr;
+        EB_NO_THROW_NEW(pool_ptr, task_pool_ctor, scheduler_ptr->worker_count, create_thread, scheduler_ptr->placement);
+        shared_pool = pool_ptr;
+    }
+    return_error = shared_pool ? task_scheduler_create_mailboxes(scheduler_ptr, shared_pool)
+                               : EB_ErrorInsufficientResources;
+    if (return_error == EB_ErrorNone)
+        return_error = task_pool_attach(shared_pool, scheduler_ptr);
+    if (return_error != EB_ErrorNone && shared_pool && !shared_pool->attached_count)
+        EB_DELETE(shared_pool);
+    svt_release_mutex(mutex);
+    return return_error;
+}
+
+/*********************************************************************
+ * svt_task_scheduler_block_begin
+ *   Hands the slot of the blocked worker over to a parked worker, or to a
+ *   new one when none is parked. With enough workers still active, only
+ *   the scan pending on the blocked worker is handed over.
+ *********************************************************************/
+void svt_task_scheduler_block_begin(void) {
+    EbTaskWorker *worker_ptr = current_worker;
+    if (!worker_ptr || !worker_ptr->in_task)
+        return;
+    EbTaskPool *pool_ptr     = worker_ptr->pool_ptr;
+    const Bool  scan_pending = worker_ptr->scan_pending;
+
+    worker_ptr->scan_pending = FALSE;
+    if (svt_atomic_fetch_add_i32(&pool_ptr->active_count, -1) > (int32_t)pool_ptr->worker_count) {
+        if (scan_pending)
+            task_pool_wake(pool_ptr);
+        return;
+    }
+    if ((int32_t)svt_atomic_load_u32((volatile uint32_t *)&pool_ptr->wake_count) < 0)
+        task_pool_wake(pool_ptr);
+    else
+        task_pool_create_worker(pool_ptr);
+}
+
+/*********************************************************************
+ * svt_task_scheduler_block_end
+ *   The worker is back, possibly in excess until it completes its task.
+ *********************************************************************/
+void svt_task_scheduler_block_end(void) {
+    EbTaskWorker *worker_ptr = current_worker;
+    if (!worker_ptr || !worker_ptr->in_task)
+        return;
+    svt_atomic_fetch_add_i32(&worker_ptr->pool_ptr->active_count, 1);
+}
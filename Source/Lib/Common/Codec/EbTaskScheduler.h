@@ -0,0 +1,186 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbTaskScheduler_h
+#define EbTaskScheduler_h
+
+#include "EbDefinitions.h"
+#include "EbObject.h"
+#include "EbSystemResourceManager.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************************************************************
+ * Task Scheduler
+ *   Runs the parallel stages of the pipeline on a pool of worker threads
+ *   instead of one thread per stage process. Each stage registers a task
+ *   type: the fullFifo it consumes, the function processing one input
+ *   object and the contexts the function runs with. A worker looks for
+ *   input on its home stage first, then steals from the other stages,
+ *   starting from the end of the pipeline to drain the pictures in flight.
+ *
+ *   Tasks may still block on the SystemResource fifos (e.g. backpressure
+ *   on the output objects), the blocked worker then hands its slot over to
+ *   a parked or a newly created worker, so that worker_count workers keep
+ *   running tasks.
+ *
+ *   With cache domain placement, each worker of the pool is bound to the
+ *   processors of one cache domain (the ones sharing an L3 cache). The
+ *   objects of the task types with an affinity are routed by picture to
+ *   a home domain, so the stages of a picture run where its data is
+ *   cached. The fifos only hand their oldest object out, so the routing
+ *   is a preference: a worker taking an object of another domain posts
+ *   it to that domain mailbox, which the workers of the domain look at
+ *   before the fifos and the other workers only once they have no input.
+ *
+ *   The pool is owned by the scheduler, or shared with the schedulers of
+ *   the other encoder instances of the process. The workers of a shared
+ *   pool serve the schedulers by increasing share of the workers in use,
+ *   the running task count of a scheduler being weighted by its weight.
+ *********************************************************************/
+typedef void (*EbTaskFunction)(void *context_ptr, EbObjectWrapper *wrapper_ptr);
+// Key of the data an input object works on, e.g. its picture number
+typedef uint64_t (*EbTaskAffinity)(EbObjectWrapper *wrapper_ptr);
+typedef EbErrorType (*EbTaskThreadCreator)(EbHandle *thread_handle, void *thread_function(void *),
+                                           void *thread_context);
+
+// Schedulers attached to a pool at most
+#define EB_TASK_POOL_CLIENT_COUNT 64
+// Weight of a scheduler at most
+#define EB_TASK_SCHEDULER_MAX_WEIGHT 64
+// Objects routed to a cache domain and not taken yet, per task type, at most
+#define EB_TASK_MAILBOX_SIZE 16
+
+typedef struct EbTaskMailbox {
+    EbHandle          mutex;
+    EbObjectWrapper  *wrapper_array[EB_TASK_MAILBOX_SIZE];
+    uint32_t          head;
+    volatile uint32_t count;
+} EbTaskMailbox;
+
+typedef struct EbTaskType {
+    // Fifo of the consumer processes of the stage input SystemResource
+    EbFifo        *input_fifo_ptr;
+    EbTaskFunction task_function;
+    // One context per task of the stage running at a time
+    EbPtr             *context_ptr_array;
+    uint32_t          *context_busy_array;
+    uint32_t           context_count;
+    EbTaskAffinity     affinity;
+    // One mailbox per cache domain of the pool, when the objects are routed
+    EbTaskMailbox *mailbox_array;
+} EbTaskType;
+
+typedef struct EbTaskWorker {
+    struct EbTaskPool   *pool_ptr;
+    struct EbTaskWorker *next_ptr;
+    EbHandle             thread_handle;
+    uint32_t             worker_index;
+    uint32_t             domain_index;
+    Bool                 in_task;
+    // Woken since its last scan without task, the worker has to look at
+    // every client before it parks
+    Bool scan_pending;
+} EbTaskWorker;
+
+typedef struct EbTaskScheduler {
+    EbDctor     dctor;
+    EbTaskType *task_type_array;
+    uint32_t    task_type_count;
+    uint32_t    task_type_total_count;
+    // Number of workers of the pool owned by the scheduler
+    uint32_t worker_count;
+    // Sum of the context counts of the task types
+    uint32_t context_count;
+    // Share of the workers of a shared pool, relative to the other schedulers
+    uint32_t         weight;
+    volatile int32_t running_count;
+    Bool             shared;
+    struct EbTaskPool *pool_ptr;
+    uint32_t           client_index;
+    // Cache domain placement, and the domain count of the routing
+    Bool     placement;
+    uint32_t domain_count;
+    // Tasks run in the home domain of their object, routed there, or run in another domain
+    volatile int32_t home_count;
+    volatile int32_t routed_count;
+    volatile int32_t away_count;
+} EbTaskScheduler;
+
+/*********************************************************************
+ * svt_task_scheduler_ctor
+ *   worker_count
+ *     Number of workers running tasks at a time, when the scheduler owns
+ *     its pool.
+ *
+ *   task_type_total_count
+ *     Number of task types registered at most.
+ *********************************************************************/
+extern EbErrorType svt_task_scheduler_ctor(EbTaskScheduler *scheduler_ptr, uint32_t worker_count,
+                                           uint32_t task_type_total_count);
+
+/*********************************************************************
+ * svt_task_scheduler_add_task_type
+ *   Registers a stage; task_function is called with one of the
+ *   context_count contexts of context_ptr_array and each object posted to
+ *   input_resource_ptr. Must be called before svt_task_scheduler_start.
+ *********************************************************************/
+extern EbErrorType svt_task_scheduler_add_task_type(EbTaskScheduler *scheduler_ptr, EbSystemResource *input_resource_ptr,
+                                                    EbTaskFunction task_function, EbPtr *context_ptr_array,
+                                                    uint32_t context_count);
+
+/*********************************************************************
+ * svt_task_scheduler_set_affinity
+ *   Routes the objects posted to input_resource_ptr, a task type input,
+ *   by the key affinity returns. Must be called before
+ *   svt_task_scheduler_start.
+ *********************************************************************/
+extern EbErrorType svt_task_scheduler_set_affinity(EbTaskScheduler *scheduler_ptr, EbSystemResource *input_resource_ptr,
+                                                   EbTaskAffinity affinity);
+
+/*********************************************************************
+ * svt_task_scheduler_place
+ *   Binds the workers of the pool the scheduler creates to cache domains
+ *   and routes the objects of the task types with an affinity. A shared
+ *   pool is placed when the scheduler creating it is. Must be called
+ *   before svt_task_scheduler_start.
+ *********************************************************************/
+extern void svt_task_scheduler_place(EbTaskScheduler *scheduler_ptr);
+
+/*********************************************************************
+ * svt_task_scheduler_share
+ *   Makes svt_task_scheduler_start attach the scheduler to the pool
+ *   shared by the process, created with pool_worker_count workers if it
+ *   does not exist yet. weight is in [1, EB_TASK_SCHEDULER_MAX_WEIGHT].
+ *   Must be called before svt_task_scheduler_start.
+ *********************************************************************/
+extern void svt_task_scheduler_share(EbTaskScheduler *scheduler_ptr, uint32_t weight, uint32_t pool_worker_count);
+
+/*********************************************************************
+ * svt_task_scheduler_start
+ *   Attaches the scheduler to its pool, whose workers are created through
+ *   create_thread, also used for the workers created later on.
+ *********************************************************************/
+extern EbErrorType svt_task_scheduler_start(EbTaskScheduler *scheduler_ptr, EbTaskThreadCreator create_thread);
+
+/*********************************************************************
+ * svt_task_scheduler_block_begin / svt_task_scheduler_block_end
+ *   Called around a blocking wait, no-op unless called from a task.
+ *********************************************************************/
+extern void svt_task_scheduler_block_begin(void);
+extern void svt_task_scheduler_block_end(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbTaskScheduler_h
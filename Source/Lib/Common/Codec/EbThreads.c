@@ -239,6 +239,31 @@ EbErrorType svt_destroy_thread(EbHandle thread_handle) {
     return error_return;
 }
 
+/***************************************
+ * svt_yield_thread
+ ***************************************/
+void svt_yield_thread(void) {
+#ifdef _WIN32
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
+
+/***************************************
+ * svt_get_num_online_processors
+ ***************************************/
+uint32_t svt_get_num_online_processors(void) {
+#ifdef _WIN32
+    SYSTEM_INFO sysinfo;
+    GetSystemInfo(&sysinfo);
+    return sysinfo.dwNumberOfProcessors;
+#else
+    long num = sysconf(_SC_NPROCESSORS_ONLN);
+    return num > 0 ? (uint32_t)num : 1;
+#endif
+}
+
 /***************************************
  * svt_create_semaphore
  ***************************************/
@@ -469,3 +494,39 @@ EbErrorType svt_wait_cond_var(CondVar *cond_var, int32_t input) {
 #endif
     return return_error;
 }
+/*
+    add delta to a condition variable and wake up its waiters,
+    used as a progress counter that threads block on
+*/
+EbErrorType svt_add_cond_var(CondVar *cond_var, int32_t delta) {
+    EbErrorType return_error;
+#ifdef _WIN32
+    EnterCriticalSection(&cond_var->cs);
+    cond_var->val += delta;
+    WakeAllConditionVariable(&cond_var->cv);
+    LeaveCriticalSection(&cond_var->cs);
+    return_error = EB_ErrorNone;
+#else
+    return_error = pthread_mutex_lock(&cond_var->m_mutex);
+    cond_var->val += delta;
+    return_error |= pthread_cond_broadcast(&cond_var->m_cond);
+    return_error |= pthread_mutex_unlock(&cond_var->m_mutex);
+#endif
+    return return_error;
+}
+/*
+    read the current value of a condition variable
+*/
+int32_t svt_get_cond_var(CondVar *cond_var) {
+    int32_t val;
+#ifdef _WIN32
+    EnterCriticalSection(&cond_var->cs);
+    val = cond_var->val;
+    LeaveCriticalSection(&cond_var->cs);
+#else
+    pthread_mutex_lock(&cond_var->m_mutex);
+    val = cond_var->val;
+    pthread_mutex_unlock(&cond_var->m_mutex);
+#endif
+    return val;
+}
@@ -36,6 +36,10 @@ extern EbErrorType svt_stop_thread(EbHandle thread_handle);
 
 extern EbErrorType svt_destroy_thread(EbHandle thread_handle);
 
+extern void svt_yield_thread(void);
+
+extern uint32_t svt_get_num_online_processors(void);
+
 /**************************************
      * Semaphores
      **************************************/
@@ -118,6 +122,45 @@ extern EbErrorType svt_destroy_mutex(EbHandle mutex_handle);
 
 void svt_aom_atomic_set_u32(AtomicVarU32 *var, uint32_t in);
 
+/**************************************
+     * Lock-free atomics
+     *   Loads have acquire semantics, stores have release semantics,
+     *   read-modify-write operations are sequentially consistent.
+     **************************************/
+#ifdef _MSC_VER
+static INLINE uint32_t svt_atomic_load_u32(volatile uint32_t *ptr) {
+    return (uint32_t)InterlockedOr((volatile LONG *)ptr, 0);
+}
+static INLINE void svt_atomic_store_u32(volatile uint32_t *ptr, uint32_t val) {
+    InterlockedExchange((volatile LONG *)ptr, (LONG)val);
+}
+static INLINE Bool svt_atomic_cas_u32(volatile uint32_t *ptr, uint32_t expected, uint32_t desired) {
+    return (uint32_t)InterlockedCompareExchange((volatile LONG *)ptr, (LONG)desired, (LONG)expected) == expected;
+}
+static INLINE int32_t svt_atomic_fetch_add_i32(volatile int32_t *ptr, int32_t val) {
+    return (int32_t)InterlockedExchangeAdd((volatile LONG *)ptr, (LONG)val);
+}
+static INLINE void svt_cpu_relax(void) { YieldProcessor(); }
+#else
+static INLINE uint32_t svt_atomic_load_u32(volatile uint32_t *ptr) { return __atomic_load_n(ptr, __ATOMIC_ACQUIRE); }
+static INLINE void     svt_atomic_store_u32(volatile uint32_t *ptr, uint32_t val) {
+    __atomic_store_n(ptr, val, __ATOMIC_RELEASE);
+}
+static INLINE Bool svt_atomic_cas_u32(volatile uint32_t *ptr, uint32_t expected, uint32_t desired) {
+    return __atomic_compare_exchange_n(ptr, &expected, desired, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+static INLINE int32_t svt_atomic_fetch_add_i32(volatile int32_t *ptr, int32_t val) {
+    return __atomic_fetch_add(ptr, val, __ATOMIC_SEQ_CST);
+}
+static INLINE void svt_cpu_relax(void) {
+#if defined(__i386__) || defined(__x86_64__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+#endif
+
 /*
  Condition variable
 */
@@ -135,6 +178,8 @@ typedef struct CondVar {
 EbErrorType svt_set_cond_var(CondVar *cond_var, int32_t newval);
 EbErrorType svt_wait_cond_var(CondVar *cond_var, int32_t input);
 EbErrorType svt_create_cond_var(CondVar *cond_var);
+EbErrorType svt_add_cond_var(CondVar *cond_var, int32_t delta);
+int32_t     svt_get_cond_var(CondVar *cond_var);
 
 #ifdef __cplusplus
 }
@@ -824,6 +824,12 @@ void svt_aom_setup_common_rtcd_internal(EbCpuFlags flags) {
     SET_AVX2(svt_aom_hadamard_32x32, svt_aom_hadamard_32x32_c, svt_aom_hadamard_32x32_avx2);
     SET_AVX2(svt_aom_hadamard_16x16, svt_aom_hadamard_16x16_c, svt_aom_hadamard_16x16_avx2);
     SET_SSE2(svt_aom_hadamard_8x8, svt_aom_hadamard_8x8_c, svt_aom_hadamard_8x8_sse2);
+    SET_SSE2_AVX2(svt_od_ec_find_symbol, svt_od_ec_find_symbol_c, svt_od_ec_find_symbol_sse2, svt_od_ec_find_symbol_avx2);
+    SET_SSE2_AVX2(svt_od_ec_update_cdf, svt_od_ec_update_cdf_c, svt_od_ec_update_cdf_sse2, svt_od_ec_update_cdf_avx2);
+    SET_AVX2(svt_av1_fgn_add_noise_luma, svt_av1_fgn_add_noise_luma_c, svt_av1_fgn_add_noise_luma_avx2);
+    SET_AVX2(svt_av1_fgn_add_noise_luma_hbd, svt_av1_fgn_add_noise_luma_hbd_c, svt_av1_fgn_add_noise_luma_hbd_avx2);
+    SET_AVX2(svt_av1_fgn_add_noise_chroma, svt_av1_fgn_add_noise_chroma_c, svt_av1_fgn_add_noise_chroma_avx2);
+    SET_AVX2(svt_av1_fgn_add_noise_chroma_hbd, svt_av1_fgn_add_noise_chroma_hbd_c, svt_av1_fgn_add_noise_chroma_hbd_avx2);
 #elif defined ARCH_AARCH64
     SET_NEON(svt_aom_blend_a64_mask, svt_aom_blend_a64_mask_c, svt_aom_blend_a64_mask_neon);
     SET_NEON(svt_aom_blend_a64_hmask, svt_aom_blend_a64_hmask_c, svt_aom_blend_a64_hmask_neon);
@@ -1352,6 +1358,12 @@ void svt_aom_setup_common_rtcd_internal(EbCpuFlags flags) {
     SET_NEON(svt_aom_hadamard_32x32, svt_aom_hadamard_32x32_c, svt_aom_hadamard_32x32_neon);
     SET_NEON(svt_aom_hadamard_16x16, svt_aom_hadamard_16x16_c, svt_aom_hadamard_16x16_neon);
     SET_NEON(svt_aom_hadamard_8x8, svt_aom_hadamard_8x8_c, svt_aom_hadamard_8x8_neon);
+    SET_ONLY_C(svt_od_ec_find_symbol, svt_od_ec_find_symbol_c);
+    SET_ONLY_C(svt_od_ec_update_cdf, svt_od_ec_update_cdf_c);
+    SET_ONLY_C(svt_av1_fgn_add_noise_luma, svt_av1_fgn_add_noise_luma_c);
+    SET_ONLY_C(svt_av1_fgn_add_noise_luma_hbd, svt_av1_fgn_add_noise_luma_hbd_c);
+    SET_ONLY_C(svt_av1_fgn_add_noise_chroma, svt_av1_fgn_add_noise_chroma_c);
+    SET_ONLY_C(svt_av1_fgn_add_noise_chroma_hbd, svt_av1_fgn_add_noise_chroma_hbd_c);
 #else
     SET_ONLY_C(svt_aom_blend_a64_mask, svt_aom_blend_a64_mask_c);
     SET_ONLY_C(svt_aom_blend_a64_hmask, svt_aom_blend_a64_hmask_c);
@@ -1877,6 +1889,12 @@ void svt_aom_setup_common_rtcd_internal(EbCpuFlags flags) {
     SET_ONLY_C(svt_aom_hadamard_32x32, svt_aom_hadamard_32x32_c);
     SET_ONLY_C(svt_aom_hadamard_16x16, svt_aom_hadamard_16x16_c);
     SET_ONLY_C(svt_aom_hadamard_8x8, svt_aom_hadamard_8x8_c);
+    SET_ONLY_C(svt_od_ec_find_symbol, svt_od_ec_find_symbol_c);
+    SET_ONLY_C(svt_od_ec_update_cdf, svt_od_ec_update_cdf_c);
+    SET_ONLY_C(svt_av1_fgn_add_noise_luma, svt_av1_fgn_add_noise_luma_c);
+    SET_ONLY_C(svt_av1_fgn_add_noise_luma_hbd, svt_av1_fgn_add_noise_luma_hbd_c);
+    SET_ONLY_C(svt_av1_fgn_add_noise_chroma, svt_av1_fgn_add_noise_chroma_c);
+    SET_ONLY_C(svt_av1_fgn_add_noise_chroma_hbd, svt_av1_fgn_add_noise_chroma_hbd_c);
 
 #endif
 
@@ -1091,6 +1091,20 @@ extern "C" {
     void svt_aom_hadamard_4x4_c(const int16_t* src_diff, ptrdiff_t src_stride, int32_t* coeff);
     #define svt_aom_hadamard_4x4 svt_aom_hadamard_4x4_c
 
+    int svt_od_ec_find_symbol_c(const uint16_t *icdf, int nsyms, uint32_t c, uint32_t r);
+    RTCD_EXTERN int (*svt_od_ec_find_symbol)(const uint16_t *icdf, int nsyms, uint32_t c, uint32_t r);
+    void svt_od_ec_update_cdf_c(uint16_t *cdf, int val, int nsyms);
+    RTCD_EXTERN void (*svt_od_ec_update_cdf)(uint16_t *cdf, int val, int nsyms);
+
+    void svt_av1_fgn_add_noise_luma_c(uint8_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, const FgnPlaneParams *pp);
+    RTCD_EXTERN void (*svt_av1_fgn_add_noise_luma)(uint8_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, const FgnPlaneParams *pp);
+    void svt_av1_fgn_add_noise_luma_hbd_c(uint16_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, int32_t bit_depth, const FgnPlaneParams *pp);
+    RTCD_EXTERN void (*svt_av1_fgn_add_noise_luma_hbd)(uint16_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, int32_t bit_depth, const FgnPlaneParams *pp);
+    void svt_av1_fgn_add_noise_chroma_c(uint8_t *chroma, int32_t chroma_stride, const uint8_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, int32_t subsamp_x, int32_t subsamp_y, const FgnPlaneParams *pp);
+    RTCD_EXTERN void (*svt_av1_fgn_add_noise_chroma)(uint8_t *chroma, int32_t chroma_stride, const uint8_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, int32_t subsamp_x, int32_t subsamp_y, const FgnPlaneParams *pp);
+    void svt_av1_fgn_add_noise_chroma_hbd_c(uint16_t *chroma, int32_t chroma_stride, const uint16_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, int32_t subsamp_x, int32_t subsamp_y, int32_t bit_depth, const FgnPlaneParams *pp);
+    RTCD_EXTERN void (*svt_av1_fgn_add_noise_chroma_hbd)(uint16_t *chroma, int32_t chroma_stride, const uint16_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, int32_t subsamp_x, int32_t subsamp_y, int32_t bit_depth, const FgnPlaneParams *pp);
+
 #ifdef ARCH_AARCH64
     void svt_av1_convolve_2d_sr_neon(const uint8_t *src, int32_t src_stride, uint8_t *dst, int32_t dst_stride, int32_t w, int32_t h, InterpFilterParams *filter_params_x, InterpFilterParams *filter_params_y, const int32_t subpel_x_q4, const int32_t subpel_y_q4, ConvolveParams *conv_params);
 
@@ -2550,6 +2564,16 @@ extern "C" {
 
     void svt_aom_lpf_vertical_8_sse2(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
 
+    int svt_od_ec_find_symbol_sse2(const uint16_t *icdf, int nsyms, uint32_t c, uint32_t r);
+    int svt_od_ec_find_symbol_avx2(const uint16_t *icdf, int nsyms, uint32_t c, uint32_t r);
+    void svt_od_ec_update_cdf_sse2(uint16_t *cdf, int val, int nsyms);
+    void svt_od_ec_update_cdf_avx2(uint16_t *cdf, int val, int nsyms);
+
+    void svt_av1_fgn_add_noise_luma_avx2(uint8_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, const FgnPlaneParams *pp);
+    void svt_av1_fgn_add_noise_luma_hbd_avx2(uint16_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, int32_t bit_depth, const FgnPlaneParams *pp);
+    void svt_av1_fgn_add_noise_chroma_avx2(uint8_t *chroma, int32_t chroma_stride, const uint8_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, int32_t subsamp_x, int32_t subsamp_y, const FgnPlaneParams *pp);
+    void svt_av1_fgn_add_noise_chroma_hbd_avx2(uint16_t *chroma, int32_t chroma_stride, const uint16_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, int32_t subsamp_x, int32_t subsamp_y, int32_t bit_depth, const FgnPlaneParams *pp);
+
     uint32_t Log2f_ASM(uint32_t x);
 
     extern void svt_memcpy_intrin_sse (void  *dst_ptr, void  const *src_ptr, size_t size);
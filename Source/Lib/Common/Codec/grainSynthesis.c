@@ -155,11 +155,8 @@ static const int32_t gaussian_sequence[2048] = {
 
 static const int32_t gauss_bits = 11;
 
-static int32_t luma_subblock_size_y = 32;
-static int32_t luma_subblock_size_x = 32;
-
-static int32_t chroma_subblock_size_y = 16;
-static int32_t chroma_subblock_size_x = 16;
+static const int32_t luma_subblock_size_y = 32;
+static const int32_t luma_subblock_size_x = 32;
 
 static const int32_t min_luma_legal_range = 16;
 static const int32_t max_luma_legal_range = 235;
@@ -167,16 +164,6 @@ static const int32_t max_luma_legal_range = 235;
 static const int32_t min_chroma_legal_range = 16;
 static const int32_t max_chroma_legal_range = 240;
 
-static int32_t scaling_lut_y[256];
-static int32_t scaling_lut_cb[256];
-static int32_t scaling_lut_cr[256];
-
-static int32_t grain_center;
-static int32_t grain_min;
-static int32_t grain_max;
-
-static uint16_t random_register = 0; // random number generator register
-
 //----------------------------------------------------------------------
 // todo: aomlib memory functions (to be replaced by Eb functions)
 /*
@@ -240,15 +227,9 @@ void svt_aom_free(void *memblk) {
 */
 //--------------------------------------------------------------------
 
-static void init_arrays(AomFilmGrain *params, int32_t luma_stride, int32_t chroma_stride, int32_t ***pred_pos_luma_p,
-                        int32_t ***pred_pos_chroma_p, int32_t **luma_grain_block, int32_t **cb_grain_block,
-                        int32_t **cr_grain_block, int32_t **y_line_buf, int32_t **cb_line_buf, int32_t **cr_line_buf,
-                        int32_t **y_col_buf, int32_t **cb_col_buf, int32_t **cr_col_buf, int32_t luma_grain_samples,
-                        int32_t chroma_grain_samples, int32_t chroma_subsamp_y, int32_t chroma_subsamp_x) {
-    memset(scaling_lut_y, 0, sizeof(*scaling_lut_y) * 256);
-    memset(scaling_lut_cb, 0, sizeof(*scaling_lut_cb) * 256);
-    memset(scaling_lut_cr, 0, sizeof(*scaling_lut_cr) * 256);
-
+static void init_arrays(AomFilmGrain *params, int32_t ***pred_pos_luma_p, int32_t ***pred_pos_chroma_p,
+                        int32_t **luma_grain_block, int32_t **cb_grain_block, int32_t **cr_grain_block,
+                        int32_t luma_grain_samples, int32_t chroma_grain_samples) {
     int32_t num_pos_luma   = 2 * params->ar_coeff_lag * (params->ar_coeff_lag + 1);
     int32_t num_pos_chroma = num_pos_luma;
     if (params->num_y_points > 0)
@@ -307,25 +288,12 @@ static void init_arrays(AomFilmGrain *params, int32_t luma_stride, int32_t chrom
     *pred_pos_luma_p   = pred_pos_luma;
     *pred_pos_chroma_p = pred_pos_chroma;
 
-    *y_line_buf  = (int32_t *)malloc(sizeof(**y_line_buf) * luma_stride * 2);
-    *cb_line_buf = (int32_t *)malloc(sizeof(**cb_line_buf) * chroma_stride * (2 >> chroma_subsamp_y));
-    *cr_line_buf = (int32_t *)malloc(sizeof(**cr_line_buf) * chroma_stride * (2 >> chroma_subsamp_y));
-
-    *y_col_buf  = (int32_t *)malloc(sizeof(**y_col_buf) * (luma_subblock_size_y + 2) * 2);
-    *cb_col_buf = (int32_t *)malloc(sizeof(**cb_col_buf) * (chroma_subblock_size_y + (2 >> chroma_subsamp_y)) *
-                                    (2 >> chroma_subsamp_x));
-    *cr_col_buf = (int32_t *)malloc(sizeof(**cr_col_buf) * (chroma_subblock_size_y + (2 >> chroma_subsamp_y)) *
-                                    (2 >> chroma_subsamp_x));
-
     *luma_grain_block = (int32_t *)malloc(sizeof(**luma_grain_block) * luma_grain_samples);
     *cb_grain_block   = (int32_t *)malloc(sizeof(**cb_grain_block) * chroma_grain_samples);
     *cr_grain_block   = (int32_t *)malloc(sizeof(**cr_grain_block) * chroma_grain_samples);
 }
 
-static void dealloc_arrays(AomFilmGrain *params, int32_t ***pred_pos_luma, int32_t ***pred_pos_chroma,
-                           int32_t **luma_grain_block, int32_t **cb_grain_block, int32_t **cr_grain_block,
-                           int32_t **y_line_buf, int32_t **cb_line_buf, int32_t **cr_line_buf, int32_t **y_col_buf,
-                           int32_t **cb_col_buf, int32_t **cr_col_buf) {
+static void dealloc_arrays(AomFilmGrain *params, int32_t ***pred_pos_luma, int32_t ***pred_pos_chroma) {
     int32_t num_pos_luma   = 2 * params->ar_coeff_lag * (params->ar_coeff_lag + 1);
     int32_t num_pos_chroma = num_pos_luma;
     if (params->num_y_points > 0)
@@ -336,52 +304,37 @@ static void dealloc_arrays(AomFilmGrain *params, int32_t ***pred_pos_luma, int32
 
     for (int32_t row = 0; row < num_pos_chroma; row++) free((*pred_pos_chroma)[row]);
     free((*pred_pos_chroma));
-
-    free(*y_line_buf);
-
-    free(*cb_line_buf);
-
-    free(*cr_line_buf);
-
-    free(*y_col_buf);
-
-    free(*cb_col_buf);
-
-    free(*cr_col_buf);
-
-    free(*luma_grain_block);
-
-    free(*cb_grain_block);
-
-    free(*cr_grain_block);
 }
 
 // get a number between 0 and 2^bits - 1
-static INLINE int32_t get_random_number(int32_t bits) {
+static INLINE int32_t get_random_number(uint16_t *random_register, int32_t bits) {
     uint16_t bit;
-    bit = ((random_register >> 0) ^ (random_register >> 1) ^ (random_register >> 3) ^ (random_register >> 12)) & 1;
-    random_register = (random_register >> 1) | (bit << 15);
-    return (random_register >> (16 - bits)) & ((1 << bits) - 1);
+    bit = ((*random_register >> 0) ^ (*random_register >> 1) ^ (*random_register >> 3) ^ (*random_register >> 12)) &
+        1;
+    *random_register = (*random_register >> 1) | (bit << 15);
+    return (*random_register >> (16 - bits)) & ((1 << bits) - 1);
 }
 
-static void init_random_generator(int32_t luma_line, uint16_t seed) {
+static uint16_t init_random_generator(int32_t luma_line, uint16_t seed) {
     // same for the picture
 
     uint16_t msb = (seed >> 8) & 255;
     uint16_t lsb = seed & 255;
 
-    random_register = (msb << 8) + lsb;
+    uint16_t random_register = (msb << 8) + lsb;
 
     //  changes for each row
     int32_t luma_num = luma_line >> 5;
 
     random_register ^= ((luma_num * 37 + 178) & 255) << 8;
     random_register ^= ((luma_num * 173 + 105) & 255);
+    return random_register;
 }
 
 static void generate_luma_grain_block(AomFilmGrain *params, int32_t **pred_pos_luma, int32_t *luma_grain_block,
                                       int32_t luma_block_size_y, int32_t luma_block_size_x, int32_t luma_grain_stride,
-                                      int32_t left_pad, int32_t top_pad, int32_t right_pad, int32_t bottom_pad) {
+                                      int32_t left_pad, int32_t top_pad, int32_t right_pad, int32_t bottom_pad,
+                                      int32_t grain_min, int32_t grain_max) {
     if (params->num_y_points == 0)
         return;
 
@@ -391,10 +344,12 @@ static void generate_luma_grain_block(AomFilmGrain *params, int32_t **pred_pos_l
     int32_t num_pos_luma    = 2 * params->ar_coeff_lag * (params->ar_coeff_lag + 1);
     int32_t rounding_offset = (1 << (params->ar_coeff_shift - 1));
 
+    uint16_t random_register = params->random_seed;
+
     for (int32_t i = 0; i < luma_block_size_y; i++)
         for (int32_t j = 0; j < luma_block_size_x; j++)
-            luma_grain_block[i * luma_grain_stride + j] = (gaussian_sequence[get_random_number(gauss_bits)] +
-                                                           ((1 << gauss_sec_shift) >> 1)) >>
+            luma_grain_block[i * luma_grain_stride + j] =
+                (gaussian_sequence[get_random_number(&random_register, gauss_bits)] + ((1 << gauss_sec_shift) >> 1)) >>
                 gauss_sec_shift;
 
     for (int32_t i = top_pad; i < luma_block_size_y - bottom_pad; i++)
@@ -419,7 +374,7 @@ static void generate_chroma_grain_blocks(AomFilmGrain *params,
                                          int32_t chroma_block_size_y, int32_t chroma_block_size_x,
                                          int32_t chroma_grain_stride, int32_t left_pad, int32_t top_pad,
                                          int32_t right_pad, int32_t bottom_pad, int32_t chroma_subsamp_y,
-                                         int32_t chroma_subsamp_x) {
+                                         int32_t chroma_subsamp_x, int32_t grain_min, int32_t grain_max) {
     int32_t bit_depth       = params->bit_depth;
     int32_t gauss_sec_shift = 12 - bit_depth + params->grain_scale_shift;
 
@@ -431,23 +386,25 @@ static void generate_chroma_grain_blocks(AomFilmGrain *params,
     int chroma_grain_block_size = chroma_block_size_y * chroma_grain_stride;
 
     if (params->num_cb_points || params->chroma_scaling_from_luma) {
-        init_random_generator(7 << 5, params->random_seed);
+        uint16_t random_register = init_random_generator(7 << 5, params->random_seed);
 
         for (int32_t i = 0; i < chroma_block_size_y; i++)
             for (int32_t j = 0; j < chroma_block_size_x; j++)
-                cb_grain_block[i * chroma_grain_stride + j] = (gaussian_sequence[get_random_number(gauss_bits)] +
-                                                               ((1 << gauss_sec_shift) >> 1)) >>
+                cb_grain_block[i * chroma_grain_stride + j] =
+                    (gaussian_sequence[get_random_number(&random_register, gauss_bits)] +
+                     ((1 << gauss_sec_shift) >> 1)) >>
                     gauss_sec_shift;
     } else {
         memset(cb_grain_block, 0, sizeof(*cb_grain_block) * chroma_grain_block_size);
     }
     if (params->num_cr_points || params->chroma_scaling_from_luma) {
-        init_random_generator(11 << 5, params->random_seed);
+        uint16_t random_register = init_random_generator(11 << 5, params->random_seed);
 
         for (int32_t i = 0; i < chroma_block_size_y; i++)
             for (int32_t j = 0; j < chroma_block_size_x; j++)
-                cr_grain_block[i * chroma_grain_stride + j] = (gaussian_sequence[get_random_number(gauss_bits)] +
-                                                               ((1 << gauss_sec_shift) >> 1)) >>
+                cr_grain_block[i * chroma_grain_stride + j] =
+                    (gaussian_sequence[get_random_number(&random_register, gauss_bits)] +
+                     ((1 << gauss_sec_shift) >> 1)) >>
                     gauss_sec_shift;
     } else {
         memset(cr_grain_block, 0, sizeof(*cr_grain_block) * chroma_grain_block_size);
@@ -523,10 +480,9 @@ static void init_scaling_function(int32_t scaling_points[][2], int32_t num_point
     for (int32_t i = scaling_points[num_points - 1][0]; i < 256; i++)
         scaling_lut[i] = scaling_points[num_points - 1][1];
 }
-
 // function that extracts samples from a lut (and interpolates intemediate
 // frames for 10- and 12-bit video)
-static int32_t scale_lut(int32_t *scaling_lut, int32_t index, int32_t bit_depth) {
+static INLINE int32_t scale_lut(const int32_t *scaling_lut, int32_t index, int32_t bit_depth) {
     int32_t x = index >> (bit_depth - 8);
 
     if (!(bit_depth - 8) || x == 255)
@@ -538,204 +494,264 @@ static int32_t scale_lut(int32_t *scaling_lut, int32_t index, int32_t bit_depth)
              (bit_depth - 8));
 }
 
-static void add_noise_to_block(AomFilmGrain *params, uint8_t *luma, uint8_t *cb, uint8_t *cr, int32_t luma_stride,
-                               int32_t chroma_stride, int32_t *luma_grain, int32_t *cb_grain, int32_t *cr_grain,
-                               int32_t luma_grain_stride, int32_t chroma_grain_stride, int32_t half_luma_height,
-                               int32_t half_luma_width, int32_t bit_depth, int32_t chroma_subsamp_y,
-                               int32_t chroma_subsamp_x) {
-    int32_t cb_mult      = params->cb_mult - 128; // fixed scale
-    int32_t cb_luma_mult = params->cb_luma_mult - 128; // fixed scale
-    int32_t cb_offset    = params->cb_offset - 256;
-
-    int32_t cr_mult      = params->cr_mult - 128; // fixed scale
-    int32_t cr_luma_mult = params->cr_luma_mult - 128; // fixed scale
-    int32_t cr_offset    = params->cr_offset - 256;
-
-    int32_t rounding_offset = (1 << (params->scaling_shift - 1));
-
-    int32_t apply_y  = params->num_y_points > 0 ? 1 : 0;
-    int32_t apply_cb = (params->num_cb_points > 0 || params->chroma_scaling_from_luma) ? 1 : 0;
-    int32_t apply_cr = (params->num_cr_points > 0 || params->chroma_scaling_from_luma) ? 1 : 0;
-
-    if (params->chroma_scaling_from_luma) {
-        cb_mult      = 0; // fixed scale
-        cb_luma_mult = 64; // fixed scale
-        cb_offset    = 0;
-
-        cr_mult      = 0; // fixed scale
-        cr_luma_mult = 64; // fixed scale
-        cr_offset    = 0;
+void svt_av1_fgn_add_noise_luma_c(uint8_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride,
+                                  int32_t width, int32_t height, const FgnPlaneParams *pp) {
+    int32_t rounding_offset = (1 << (pp->scaling_shift - 1));
+
+    for (int32_t i = 0; i < height; i++) {
+        for (int32_t j = 0; j < width; j++) {
+            luma[i * luma_stride + j] = clamp(luma[i * luma_stride + j] +
+                                                  ((scale_lut(pp->scaling_lut, luma[i * luma_stride + j], 8) *
+                                                        grain[i * grain_stride + j] +
+                                                    rounding_offset) >>
+                                                   pp->scaling_shift),
+                                              pp->min_val,
+                                              pp->max_val);
+        }
     }
+}
 
-    int32_t min_luma, max_luma, min_chroma, max_chroma;
-
-    if (params->clip_to_restricted_range) {
-        min_luma = min_luma_legal_range;
-        max_luma = max_luma_legal_range;
-
-        min_chroma = min_chroma_legal_range;
-        max_chroma = max_chroma_legal_range;
-    } else {
-        min_luma = min_chroma = 0;
-        max_luma = max_chroma = 255;
+void svt_av1_fgn_add_noise_luma_hbd_c(uint16_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride,
+                                      int32_t width, int32_t height, int32_t bit_depth, const FgnPlaneParams *pp) {
+    int32_t rounding_offset = (1 << (pp->scaling_shift - 1));
+
+    for (int32_t i = 0; i < height; i++) {
+        for (int32_t j = 0; j < width; j++) {
+            luma[i * luma_stride + j] = clamp(luma[i * luma_stride + j] +
+                                                  ((scale_lut(pp->scaling_lut, luma[i * luma_stride + j], bit_depth) *
+                                                        grain[i * grain_stride + j] +
+                                                    rounding_offset) >>
+                                                   pp->scaling_shift),
+                                              pp->min_val,
+                                              pp->max_val);
+        }
     }
+}
+
+void svt_av1_fgn_add_noise_chroma_c(uint8_t *chroma, int32_t chroma_stride, const uint8_t *luma, int32_t luma_stride,
+                                    const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height,
+                                    int32_t subsamp_x, int32_t subsamp_y, const FgnPlaneParams *pp) {
+    int32_t rounding_offset = (1 << (pp->scaling_shift - 1));
 
-    for (int32_t i = 0; i < (half_luma_height << (1 - chroma_subsamp_y)); i++) {
-        for (int32_t j = 0; j < (half_luma_width << (1 - chroma_subsamp_x)); j++) {
+    for (int32_t i = 0; i < height; i++) {
+        for (int32_t j = 0; j < width; j++) {
             int32_t average_luma = 0;
-            if (chroma_subsamp_x) {
-                average_luma = (luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x)] +
-                                luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x) + 1] + 1) >>
+            if (subsamp_x) {
+                average_luma = (luma[(i << subsamp_y) * luma_stride + (j << subsamp_x)] +
+                                luma[(i << subsamp_y) * luma_stride + (j << subsamp_x) + 1] + 1) >>
                     1;
             } else
-                average_luma = luma[(i << chroma_subsamp_y) * luma_stride + j];
-            if (apply_cb) {
-                cb[i * chroma_stride + j] = clamp(
-                    cb[i * chroma_stride + j] +
-                        ((scale_lut(scaling_lut_cb,
-                                    clamp(((average_luma * cb_luma_mult + cb_mult * cb[i * chroma_stride + j]) >> 6) +
-                                              cb_offset,
-                                          0,
-                                          (256 << (bit_depth - 8)) - 1),
-                                    8) *
-                              cb_grain[i * chroma_grain_stride + j] +
-                          rounding_offset) >>
-                         params->scaling_shift),
-                    min_chroma,
-                    max_chroma);
-            }
-
-            if (apply_cr) {
-                cr[i * chroma_stride + j] = clamp(
-                    cr[i * chroma_stride + j] +
-                        ((scale_lut(scaling_lut_cr,
-                                    clamp(((average_luma * cr_luma_mult + cr_mult * cr[i * chroma_stride + j]) >> 6) +
-                                              cr_offset,
-                                          0,
-                                          (256 << (bit_depth - 8)) - 1),
-                                    8) *
-                              cr_grain[i * chroma_grain_stride + j] +
-                          rounding_offset) >>
-                         params->scaling_shift),
-                    min_chroma,
-                    max_chroma);
-            }
+                average_luma = luma[(i << subsamp_y) * luma_stride + j];
+            chroma[i * chroma_stride + j] = clamp(
+                chroma[i * chroma_stride + j] +
+                    ((scale_lut(pp->scaling_lut,
+                                clamp(((average_luma * pp->luma_mult + pp->mult * chroma[i * chroma_stride + j]) >> 6) +
+                                          pp->offset,
+                                      0,
+                                      255),
+                                8) *
+                          grain[i * grain_stride + j] +
+                      rounding_offset) >>
+                     pp->scaling_shift),
+                pp->min_val,
+                pp->max_val);
         }
     }
+}
 
-    if (apply_y) {
-        for (int32_t i = 0; i < (half_luma_height << 1); i++) {
-            for (int32_t j = 0; j < (half_luma_width << 1); j++) {
-                luma[i * luma_stride + j] = clamp(luma[i * luma_stride + j] +
-                                                      ((scale_lut(scaling_lut_y, luma[i * luma_stride + j], 8) *
-                                                            luma_grain[i * luma_grain_stride + j] +
-                                                        rounding_offset) >>
-                                                       params->scaling_shift),
-                                                  min_luma,
-                                                  max_luma);
-            }
+void svt_av1_fgn_add_noise_chroma_hbd_c(uint16_t *chroma, int32_t chroma_stride, const uint16_t *luma,
+                                        int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width,
+                                        int32_t height, int32_t subsamp_x, int32_t subsamp_y, int32_t bit_depth,
+                                        const FgnPlaneParams *pp) {
+    int32_t rounding_offset = (1 << (pp->scaling_shift - 1));
+
+    for (int32_t i = 0; i < height; i++) {
+        for (int32_t j = 0; j < width; j++) {
+            int32_t average_luma = 0;
+            if (subsamp_x) {
+                average_luma = (luma[(i << subsamp_y) * luma_stride + (j << subsamp_x)] +
+                                luma[(i << subsamp_y) * luma_stride + (j << subsamp_x) + 1] + 1) >>
+                    1;
+            } else
+                average_luma = luma[(i << subsamp_y) * luma_stride + j];
+            chroma[i * chroma_stride + j] = clamp(
+                chroma[i * chroma_stride + j] +
+                    ((scale_lut(pp->scaling_lut,
+                                clamp(((average_luma * pp->luma_mult + pp->mult * chroma[i * chroma_stride + j]) >> 6) +
+                                          pp->offset,
+                                      0,
+                                      (256 << (bit_depth - 8)) - 1),
+                                bit_depth) *
+                          grain[i * grain_stride + j] +
+                      rounding_offset) >>
+                     pp->scaling_shift),
+                pp->min_val,
+                pp->max_val);
         }
     }
 }
 
-static void add_noise_to_block_hbd(AomFilmGrain *params, uint16_t *luma, uint16_t *cb, uint16_t *cr,
-                                   int32_t luma_stride, int32_t chroma_stride, int32_t *luma_grain, int32_t *cb_grain,
-                                   int32_t *cr_grain, int32_t luma_grain_stride, int32_t chroma_grain_stride,
-                                   int32_t half_luma_height, int32_t half_luma_width, int32_t bit_depth,
-                                   int32_t chroma_subsamp_y, int32_t chroma_subsamp_x) {
-    int32_t cb_mult      = params->cb_mult - 128; // fixed scale
-    int32_t cb_luma_mult = params->cb_luma_mult - 128; // fixed scale
-    // offset value depends on the bit depth
-    int32_t cb_offset = (params->cb_offset << (bit_depth - 8)) - (1 << bit_depth);
-
-    int32_t cr_mult      = params->cr_mult - 128; // fixed scale
-    int32_t cr_luma_mult = params->cr_luma_mult - 128; // fixed scale
-    // offset value depends on the bit depth
-    int32_t cr_offset = (params->cr_offset << (bit_depth - 8)) - (1 << bit_depth);
-
-    int32_t rounding_offset = (1 << (params->scaling_shift - 1));
-
-    int32_t apply_y  = params->num_y_points > 0 ? 1 : 0;
-    int32_t apply_cb = params->num_cb_points > 0 ? 1 : 0;
-    int32_t apply_cr = params->num_cr_points > 0 ? 1 : 0;
+typedef struct FgnNoiseParams {
+    FgnPlaneParams y;
+    FgnPlaneParams cb;
+    FgnPlaneParams cr;
+    int32_t        apply_y;
+    int32_t        apply_cb;
+    int32_t        apply_cr;
+} FgnNoiseParams;
+
+// State of the threads adding the grain to a band of block rows
+typedef struct FgnRowCtxt {
+    const FilmGrainSynth *synth;
+    FgnNoiseParams        noise;
+    uint8_t              *luma;
+    uint8_t              *cb;
+    uint8_t              *cr;
+    int32_t               height;
+    int32_t               width;
+    int32_t               luma_stride;
+    int32_t               chroma_stride;
+    int32_t               use_high_bit_depth;
+    // grain of the overlap with the block row above and the block on the left
+    int32_t *y_line_buf;
+    int32_t *cb_line_buf;
+    int32_t *cr_line_buf;
+    int32_t *y_col_buf;
+    int32_t *cb_col_buf;
+    int32_t *cr_col_buf;
+} FgnRowCtxt;
 
-    if (params->chroma_scaling_from_luma) {
-        cb_mult      = 0; // fixed scale
-        cb_luma_mult = 64; // fixed scale
-        cb_offset    = 0;
+static void init_noise_params(const FilmGrainSynth *synth, int32_t use_high_bit_depth, FgnNoiseParams *noise) {
+    AomFilmGrain *params    = synth->params;
+    int32_t       bit_depth = params->bit_depth;
 
-        cr_mult      = 0; // fixed scale
-        cr_luma_mult = 64; // fixed scale
-        cr_offset    = 0;
-    }
+    noise->apply_y = params->num_y_points > 0 ? 1 : 0;
+    // the high bit depth path does not apply chroma_scaling_from_luma without chroma points
+    noise->apply_cb = (params->num_cb_points > 0 || (params->chroma_scaling_from_luma && !use_high_bit_depth)) ? 1
+                                                                                                                : 0;
+    noise->apply_cr = (params->num_cr_points > 0 || (params->chroma_scaling_from_luma && !use_high_bit_depth)) ? 1
+                                                                                                                : 0;
 
-    int32_t min_luma, max_luma, min_chroma, max_chroma;
+    noise->y.scaling_lut   = synth->scaling_lut_y;
+    noise->cb.scaling_lut  = synth->scaling_lut_cb;
+    noise->cr.scaling_lut  = synth->scaling_lut_cr;
+    noise->y.scaling_shift = noise->cb.scaling_shift = noise->cr.scaling_shift = params->scaling_shift;
 
     if (params->clip_to_restricted_range) {
-        min_luma = min_luma_legal_range << (bit_depth - 8);
-        max_luma = max_luma_legal_range << (bit_depth - 8);
+        noise->y.min_val = min_luma_legal_range << (bit_depth - 8);
+        noise->y.max_val = max_luma_legal_range << (bit_depth - 8);
 
-        min_chroma = min_chroma_legal_range << (bit_depth - 8);
-        max_chroma = max_chroma_legal_range << (bit_depth - 8);
+        noise->cb.min_val = noise->cr.min_val = min_chroma_legal_range << (bit_depth - 8);
+        noise->cb.max_val = noise->cr.max_val = max_chroma_legal_range << (bit_depth - 8);
     } else {
-        min_luma = min_chroma = 0;
-        max_luma = max_chroma = (256 << (bit_depth - 8)) - 1;
+        noise->y.min_val = noise->cb.min_val = noise->cr.min_val = 0;
+        noise->y.max_val = noise->cb.max_val = noise->cr.max_val = (256 << (bit_depth - 8)) - 1;
     }
 
-    for (int32_t i = 0; i < (half_luma_height << (1 - chroma_subsamp_y)); i++) {
-        for (int32_t j = 0; j < (half_luma_width << (1 - chroma_subsamp_x)); j++) {
-            int32_t average_luma = 0;
-            if (chroma_subsamp_x) {
-                average_luma = (luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x)] +
-                                luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x) + 1] + 1) >>
-                    1;
-            } else
-                average_luma = luma[(i << chroma_subsamp_y) * luma_stride + j];
-            if (apply_cb) {
-                cb[i * chroma_stride + j] = clamp(
-                    cb[i * chroma_stride + j] +
-                        ((scale_lut(scaling_lut_cb,
-                                    clamp(((average_luma * cb_luma_mult + cb_mult * cb[i * chroma_stride + j]) >> 6) +
-                                              cb_offset,
-                                          0,
-                                          (256 << (bit_depth - 8)) - 1),
-                                    bit_depth) *
-                              cb_grain[i * chroma_grain_stride + j] +
-                          rounding_offset) >>
-                         params->scaling_shift),
-                    min_chroma,
-                    max_chroma);
-            }
-            if (apply_cr) {
-                cr[i * chroma_stride + j] = clamp(
-                    cr[i * chroma_stride + j] +
-                        ((scale_lut(scaling_lut_cr,
-                                    clamp(((average_luma * cr_luma_mult + cr_mult * cr[i * chroma_stride + j]) >> 6) +
-                                              cr_offset,
-                                          0,
-                                          (256 << (bit_depth - 8)) - 1),
-                                    bit_depth) *
-                              cr_grain[i * chroma_grain_stride + j] +
-                          rounding_offset) >>
-                         params->scaling_shift),
-                    min_chroma,
-                    max_chroma);
-            }
-        }
+    if (params->chroma_scaling_from_luma) {
+        noise->cb.mult      = 0; // fixed scale
+        noise->cb.luma_mult = 64; // fixed scale
+        noise->cb.offset    = 0;
+
+        noise->cr.mult      = 0; // fixed scale
+        noise->cr.luma_mult = 64; // fixed scale
+        noise->cr.offset    = 0;
+    } else {
+        noise->cb.mult      = params->cb_mult - 128; // fixed scale
+        noise->cb.luma_mult = params->cb_luma_mult - 128; // fixed scale
+        // offset value depends on the bit depth
+        noise->cb.offset = (params->cb_offset << (bit_depth - 8)) - (1 << bit_depth);
+
+        noise->cr.mult      = params->cr_mult - 128; // fixed scale
+        noise->cr.luma_mult = params->cr_luma_mult - 128; // fixed scale
+        // offset value depends on the bit depth
+        noise->cr.offset = (params->cr_offset << (bit_depth - 8)) - (1 << bit_depth);
     }
+}
 
-    if (apply_y) {
-        for (int32_t i = 0; i < (half_luma_height << 1); i++) {
-            for (int32_t j = 0; j < (half_luma_width << 1); j++) {
-                luma[i * luma_stride + j] = clamp(luma[i * luma_stride + j] +
-                                                      ((scale_lut(scaling_lut_y, luma[i * luma_stride + j], bit_depth) *
-                                                            luma_grain[i * luma_grain_stride + j] +
-                                                        rounding_offset) >>
-                                                       params->scaling_shift),
-                                                  min_luma,
-                                                  max_luma);
-            }
-        }
+// luma_pos and chroma_pos are the sample offsets of the block in the planes
+static void add_noise_to_block(const FgnRowCtxt *ctx, int32_t luma_pos, int32_t chroma_pos, int32_t *luma_grain,
+                               int32_t *cb_grain, int32_t *cr_grain, int32_t luma_grain_stride,
+                               int32_t chroma_grain_stride, int32_t half_luma_height, int32_t half_luma_width) {
+    const FgnNoiseParams *noise            = &ctx->noise;
+    int32_t               chroma_subsamp_y = ctx->synth->chroma_subsamp_y;
+    int32_t               chroma_subsamp_x = ctx->synth->chroma_subsamp_x;
+    int32_t               bit_depth        = ctx->synth->params->bit_depth;
+    int32_t               chroma_height    = half_luma_height << (1 - chroma_subsamp_y);
+    int32_t               chroma_width     = half_luma_width << (1 - chroma_subsamp_x);
+
+    // The chroma is scaled from the luma before its grain is added
+    if (ctx->use_high_bit_depth) {
+        uint16_t *luma = (uint16_t *)ctx->luma + luma_pos;
+        if (noise->apply_cb)
+            svt_av1_fgn_add_noise_chroma_hbd((uint16_t *)ctx->cb + chroma_pos,
+                                             ctx->chroma_stride,
+                                             luma,
+                                             ctx->luma_stride,
+                                             cb_grain,
+                                             chroma_grain_stride,
+                                             chroma_width,
+                                             chroma_height,
+                                             chroma_subsamp_x,
+                                             chroma_subsamp_y,
+                                             bit_depth,
+                                             &noise->cb);
+        if (noise->apply_cr)
+            svt_av1_fgn_add_noise_chroma_hbd((uint16_t *)ctx->cr + chroma_pos,
+                                             ctx->chroma_stride,
+                                             luma,
+                                             ctx->luma_stride,
+                                             cr_grain,
+                                             chroma_grain_stride,
+                                             chroma_width,
+                                             chroma_height,
+                                             chroma_subsamp_x,
+                                             chroma_subsamp_y,
+                                             bit_depth,
+                                             &noise->cr);
+        if (noise->apply_y)
+            svt_av1_fgn_add_noise_luma_hbd(luma,
+                                           ctx->luma_stride,
+                                           luma_grain,
+                                           luma_grain_stride,
+                                           half_luma_width << 1,
+                                           half_luma_height << 1,
+                                           bit_depth,
+                                           &noise->y);
+    } else {
+        uint8_t *luma = ctx->luma + luma_pos;
+        if (noise->apply_cb)
+            svt_av1_fgn_add_noise_chroma(ctx->cb + chroma_pos,
+                                         ctx->chroma_stride,
+                                         luma,
+                                         ctx->luma_stride,
+                                         cb_grain,
+                                         chroma_grain_stride,
+                                         chroma_width,
+                                         chroma_height,
+                                         chroma_subsamp_x,
+                                         chroma_subsamp_y,
+                                         &noise->cb);
+        if (noise->apply_cr)
+            svt_av1_fgn_add_noise_chroma(ctx->cr + chroma_pos,
+                                         ctx->chroma_stride,
+                                         luma,
+                                         ctx->luma_stride,
+                                         cr_grain,
+                                         chroma_grain_stride,
+                                         chroma_width,
+                                         chroma_height,
+                                         chroma_subsamp_x,
+                                         chroma_subsamp_y,
+                                         &noise->cr);
+        if (noise->apply_y)
+            svt_av1_fgn_add_noise_luma(luma,
+                                       ctx->luma_stride,
+                                       luma_grain,
+                                       luma_grain_stride,
+                                       half_luma_width << 1,
+                                       half_luma_height << 1,
+                                       &noise->y);
     }
 }
 
@@ -827,7 +843,8 @@ static void copy_area(int32_t *src, int32_t src_stride, int32_t *dst, int32_t ds
 }
 
 static void ver_boundary_overlap(int32_t *left_block, int32_t left_stride, int32_t *right_block, int32_t right_stride,
-                                 int32_t *dst_block, int32_t dst_stride, int32_t width, int32_t height) {
+                                 int32_t *dst_block, int32_t dst_stride, int32_t width, int32_t height,
+                                 int32_t grain_min, int32_t grain_max) {
     if (width == 1) {
         while (height) {
             *dst_block = clamp((*left_block * 23 + *right_block * 22 + 16) >> 5, grain_min, grain_max);
@@ -851,7 +868,8 @@ static void ver_boundary_overlap(int32_t *left_block, int32_t left_stride, int32
 }
 
 static void hor_boundary_overlap(int32_t *top_block, int32_t top_stride, int32_t *bottom_block, int32_t bottom_stride,
-                                 int32_t *dst_block, int32_t dst_stride, int32_t width, int32_t height) {
+                                 int32_t *dst_block, int32_t dst_stride, int32_t width, int32_t height,
+                                 int32_t grain_min, int32_t grain_max) {
     if (height == 1) {
         while (width) {
             *dst_block = clamp((*top_block * 23 + *bottom_block * 22 + 16) >> 5, grain_min, grain_max);
@@ -875,24 +893,290 @@ static void hor_boundary_overlap(int32_t *top_block, int32_t top_stride, int32_t
     }
 }
 
-void svt_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb, uint8_t *cr, int32_t height,
-                                int32_t width, int32_t luma_stride, int32_t chroma_stride, int32_t use_high_bit_depth,
-                                int32_t chroma_subsamp_y, int32_t chroma_subsamp_x) {
-    int32_t **pred_pos_luma;
-    int32_t **pred_pos_chroma;
-    int32_t  *luma_grain_block;
-    int32_t  *cb_grain_block;
-    int32_t  *cr_grain_block;
+/* Adds the grain to the blocks of the luma rows [y << 1, (y + 16) << 1). With apply unset, only the line buffer
+ * the next block row overlaps with is filled in. */
+static void add_film_grain_block_row(FgnRowCtxt *ctx, int32_t y, Bool apply) {
+    const FilmGrainSynth *synth  = ctx->synth;
+    AomFilmGrain         *params = synth->params;
 
-    int32_t *y_line_buf;
-    int32_t *cb_line_buf;
-    int32_t *cr_line_buf;
+    int32_t left_pad   = 3;
+    int32_t top_pad    = 3;
+    int32_t ar_padding = 3; // maximum lag used for stabilization of AR coefficients
 
-    int32_t *y_col_buf;
-    int32_t *cb_col_buf;
-    int32_t *cr_col_buf;
+    int32_t chroma_subsamp_y       = synth->chroma_subsamp_y;
+    int32_t chroma_subsamp_x       = synth->chroma_subsamp_x;
+    int32_t chroma_subblock_size_y = synth->chroma_subblock_size_y;
+    int32_t chroma_subblock_size_x = synth->chroma_subblock_size_x;
+    int32_t luma_grain_stride      = synth->luma_grain_stride;
+    int32_t chroma_grain_stride    = synth->chroma_grain_stride;
+    int32_t grain_min              = synth->grain_min;
+    int32_t grain_max              = synth->grain_max;
+    int32_t *luma_grain_block      = synth->luma_grain_block;
+    int32_t *cb_grain_block        = synth->cb_grain_block;
+    int32_t *cr_grain_block        = synth->cr_grain_block;
+
+    int32_t *y_line_buf  = ctx->y_line_buf;
+    int32_t *cb_line_buf = ctx->cb_line_buf;
+    int32_t *cr_line_buf = ctx->cr_line_buf;
+    int32_t *y_col_buf   = ctx->y_col_buf;
+    int32_t *cb_col_buf  = ctx->cb_col_buf;
+    int32_t *cr_col_buf  = ctx->cr_col_buf;
+
+    int32_t height        = ctx->height;
+    int32_t width         = ctx->width;
+    int32_t luma_stride   = ctx->luma_stride;
+    int32_t chroma_stride = ctx->chroma_stride;
+    int32_t overlap       = params->overlap_flag;
+
+    uint16_t random_register = init_random_generator(y * 2, params->random_seed);
+
+    for (int32_t x = 0; x < width / 2; x += (luma_subblock_size_x >> 1)) {
+        int32_t offset_y = get_random_number(&random_register, 8);
+        int32_t offset_x = (offset_y >> 4) & 15;
+        offset_y &= 15;
+
+        int32_t luma_offset_y = left_pad + 2 * ar_padding + (offset_y << 1);
+        int32_t luma_offset_x = top_pad + 2 * ar_padding + (offset_x << 1);
+
+        int32_t chroma_offset_y = top_pad + (2 >> chroma_subsamp_y) * ar_padding + offset_y * (2 >> chroma_subsamp_y);
+        int32_t chroma_offset_x = left_pad + (2 >> chroma_subsamp_x) * ar_padding + offset_x * (2 >> chroma_subsamp_x);
+
+        if (overlap && x) {
+            ver_boundary_overlap(y_col_buf,
+                                 2,
+                                 luma_grain_block + luma_offset_y * luma_grain_stride + luma_offset_x,
+                                 luma_grain_stride,
+                                 y_col_buf,
+                                 2,
+                                 2,
+                                 AOMMIN(luma_subblock_size_y + 2, height - (y << 1)),
+                                 grain_min,
+                                 grain_max);
+
+            ver_boundary_overlap(
+                cb_col_buf,
+                2 >> chroma_subsamp_x,
+                cb_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x,
+                chroma_grain_stride,
+                cb_col_buf,
+                2 >> chroma_subsamp_x,
+                2 >> chroma_subsamp_x,
+                AOMMIN(chroma_subblock_size_y + (2 >> chroma_subsamp_y), (height - (y << 1)) >> chroma_subsamp_y),
+                grain_min,
+                grain_max);
+
+            ver_boundary_overlap(
+                cr_col_buf,
+                2 >> chroma_subsamp_x,
+                cr_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x,
+                chroma_grain_stride,
+                cr_col_buf,
+                2 >> chroma_subsamp_x,
+                2 >> chroma_subsamp_x,
+                AOMMIN(chroma_subblock_size_y + (2 >> chroma_subsamp_y), (height - (y << 1)) >> chroma_subsamp_y),
+                grain_min,
+                grain_max);
 
-    random_register = params->random_seed;
+            if (apply) {
+                int32_t i = y ? 1 : 0;
+
+                add_noise_to_block(ctx,
+                                   ((y + i) << 1) * luma_stride + (x << 1),
+                                   ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride + (x << (1 - chroma_subsamp_x)),
+                                   y_col_buf + i * 4,
+                                   cb_col_buf + i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
+                                   cr_col_buf + i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
+                                   2,
+                                   (2 - chroma_subsamp_x),
+                                   AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i,
+                                   1);
+            }
+        }
+
+        // The line buffer parts overlapped here are overwritten by the copies below
+        if (overlap && y && apply) {
+            if (x) {
+                ASSERT(y_col_buf != NULL);
+                hor_boundary_overlap(y_line_buf + (x << 1),
+                                     luma_stride,
+                                     y_col_buf,
+                                     2,
+                                     y_line_buf + (x << 1),
+                                     luma_stride,
+                                     2,
+                                     2,
+                                     grain_min,
+                                     grain_max);
+
+                hor_boundary_overlap(cb_line_buf + x * (2 >> chroma_subsamp_x),
+                                     chroma_stride,
+                                     cb_col_buf,
+                                     2 >> chroma_subsamp_x,
+                                     cb_line_buf + x * (2 >> chroma_subsamp_x),
+                                     chroma_stride,
+                                     2 >> chroma_subsamp_x,
+                                     2 >> chroma_subsamp_y,
+                                     grain_min,
+                                     grain_max);
+
+                hor_boundary_overlap(cr_line_buf + x * (2 >> chroma_subsamp_x),
+                                     chroma_stride,
+                                     cr_col_buf,
+                                     2 >> chroma_subsamp_x,
+                                     cr_line_buf + x * (2 >> chroma_subsamp_x),
+                                     chroma_stride,
+                                     2 >> chroma_subsamp_x,
+                                     2 >> chroma_subsamp_y,
+                                     grain_min,
+                                     grain_max);
+            }
+
+            hor_boundary_overlap(y_line_buf + ((x ? x + 1 : 0) << 1),
+                                 luma_stride,
+                                 luma_grain_block + luma_offset_y * luma_grain_stride + luma_offset_x + (x ? 2 : 0),
+                                 luma_grain_stride,
+                                 y_line_buf + ((x ? x + 1 : 0) << 1),
+                                 luma_stride,
+                                 AOMMIN(luma_subblock_size_x - ((x ? 1 : 0) << 1), width - ((x ? x + 1 : 0) << 1)),
+                                 2,
+                                 grain_min,
+                                 grain_max);
+
+            hor_boundary_overlap(cb_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
+                                 chroma_stride,
+                                 cb_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x +
+                                     ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
+                                 chroma_grain_stride,
+                                 cb_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
+                                 chroma_stride,
+                                 AOMMIN(chroma_subblock_size_x - ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
+                                        (width - ((x ? x + 1 : 0) << 1)) >> chroma_subsamp_x),
+                                 2 >> chroma_subsamp_y,
+                                 grain_min,
+                                 grain_max);
+
+            hor_boundary_overlap(cr_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
+                                 chroma_stride,
+                                 cr_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x +
+                                     ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
+                                 chroma_grain_stride,
+                                 cr_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
+                                 chroma_stride,
+                                 AOMMIN(chroma_subblock_size_x - ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
+                                        (width - ((x ? x + 1 : 0) << 1)) >> chroma_subsamp_x),
+                                 2 >> chroma_subsamp_y,
+                                 grain_min,
+                                 grain_max);
+
+            add_noise_to_block(ctx,
+                               (y << 1) * luma_stride + (x << 1),
+                               (y << (1 - chroma_subsamp_y)) * chroma_stride + (x << (1 - chroma_subsamp_x)),
+                               y_line_buf + (x << 1),
+                               cb_line_buf + (x << (1 - chroma_subsamp_x)),
+                               cr_line_buf + (x << (1 - chroma_subsamp_x)),
+                               luma_stride,
+                               chroma_stride,
+                               1,
+                               AOMMIN(luma_subblock_size_x >> 1, width / 2 - x));
+        }
+
+        if (apply) {
+            int32_t i = overlap && y ? 1 : 0;
+            int32_t j = overlap && x ? 1 : 0;
+
+            add_noise_to_block(
+                ctx,
+                ((y + i) << 1) * luma_stride + ((x + j) << 1),
+                ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride + ((x + j) << (1 - chroma_subsamp_x)),
+                luma_grain_block + (luma_offset_y + (i << 1)) * luma_grain_stride + luma_offset_x + (j << 1),
+                cb_grain_block + (chroma_offset_y + (i << (1 - chroma_subsamp_y))) * chroma_grain_stride +
+                    chroma_offset_x + (j << (1 - chroma_subsamp_x)),
+                cr_grain_block + (chroma_offset_y + (i << (1 - chroma_subsamp_y))) * chroma_grain_stride +
+                    chroma_offset_x + (j << (1 - chroma_subsamp_x)),
+                luma_grain_stride,
+                chroma_grain_stride,
+                AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i,
+                AOMMIN(luma_subblock_size_x >> 1, width / 2 - x) - j);
+        }
+
+        if (overlap) {
+            if (x) {
+                // Copy overlapped column bufer to line buffer
+                copy_area(y_col_buf + (luma_subblock_size_y << 1), 2, y_line_buf + (x << 1), luma_stride, 2, 2);
+
+                copy_area(cb_col_buf + (chroma_subblock_size_y << (1 - chroma_subsamp_x)),
+                          2 >> chroma_subsamp_x,
+                          cb_line_buf + (x << (1 - chroma_subsamp_x)),
+                          chroma_stride,
+                          2 >> chroma_subsamp_x,
+                          2 >> chroma_subsamp_y);
+
+                copy_area(cr_col_buf + (chroma_subblock_size_y << (1 - chroma_subsamp_x)),
+                          2 >> chroma_subsamp_x,
+                          cr_line_buf + (x << (1 - chroma_subsamp_x)),
+                          chroma_stride,
+                          2 >> chroma_subsamp_x,
+                          2 >> chroma_subsamp_y);
+            }
+
+            // Copy grain to the line buffer for overlap with a bottom block
+            copy_area(luma_grain_block + (luma_offset_y + luma_subblock_size_y) * luma_grain_stride + luma_offset_x +
+                          ((x ? 2 : 0)),
+                      luma_grain_stride,
+                      y_line_buf + ((x ? x + 1 : 0) << 1),
+                      luma_stride,
+                      AOMMIN(luma_subblock_size_x, width - (x << 1)) - (x ? 2 : 0),
+                      2);
+
+            copy_area(cb_grain_block + (chroma_offset_y + chroma_subblock_size_y) * chroma_grain_stride +
+                          chroma_offset_x + (x ? 2 >> chroma_subsamp_x : 0),
+                      chroma_grain_stride,
+                      cb_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
+                      chroma_stride,
+                      AOMMIN(chroma_subblock_size_x, ((width - (x << 1)) >> chroma_subsamp_x)) -
+                          (x ? 2 >> chroma_subsamp_x : 0),
+                      2 >> chroma_subsamp_y);
+
+            copy_area(cr_grain_block + (chroma_offset_y + chroma_subblock_size_y) * chroma_grain_stride +
+                          chroma_offset_x + (x ? 2 >> chroma_subsamp_x : 0),
+                      chroma_grain_stride,
+                      cr_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
+                      chroma_stride,
+                      AOMMIN(chroma_subblock_size_x, ((width - (x << 1)) >> chroma_subsamp_x)) -
+                          (x ? 2 >> chroma_subsamp_x : 0),
+                      2 >> chroma_subsamp_y);
+
+            // Copy grain to the column buffer for overlap with the next block to
+            // the right
+
+            copy_area(luma_grain_block + luma_offset_y * luma_grain_stride + luma_offset_x + luma_subblock_size_x,
+                      luma_grain_stride,
+                      y_col_buf,
+                      2,
+                      2,
+                      AOMMIN(luma_subblock_size_y + 2, height - (y << 1)));
+
+            copy_area(cb_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x + chroma_subblock_size_x,
+                      chroma_grain_stride,
+                      cb_col_buf,
+                      2 >> chroma_subsamp_x,
+                      2 >> chroma_subsamp_x,
+                      AOMMIN(chroma_subblock_size_y + (2 >> chroma_subsamp_y), (height - (y << 1)) >> chroma_subsamp_y));
+
+            copy_area(cr_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x + chroma_subblock_size_x,
+                      chroma_grain_stride,
+                      cr_col_buf,
+                      2 >> chroma_subsamp_x,
+                      2 >> chroma_subsamp_x,
+                      AOMMIN(chroma_subblock_size_y + (2 >> chroma_subsamp_y), (height - (y << 1)) >> chroma_subsamp_y));
+        }
+    }
+}
+
+void svt_av1_film_grain_synth_init(FilmGrainSynth *synth, AomFilmGrain *params, int32_t chroma_subsamp_y,
+                                   int32_t chroma_subsamp_x) {
+    int32_t **pred_pos_luma;
+    int32_t **pred_pos_chroma;
 
     int32_t left_pad   = 3;
     int32_t right_pad  = 3; // padding to offset for AR coefficients
@@ -901,11 +1185,11 @@ void svt_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb
 
     int32_t ar_padding = 3; // maximum lag used for stabilization of AR coefficients
 
-    luma_subblock_size_y = 32;
-    luma_subblock_size_x = 32;
-
-    chroma_subblock_size_y = luma_subblock_size_y >> chroma_subsamp_y;
-    chroma_subblock_size_x = luma_subblock_size_x >> chroma_subsamp_x;
+    synth->params                 = params;
+    synth->chroma_subsamp_y       = chroma_subsamp_y;
+    synth->chroma_subsamp_x       = chroma_subsamp_x;
+    synth->chroma_subblock_size_y = luma_subblock_size_y >> chroma_subsamp_y;
+    synth->chroma_subblock_size_x = luma_subblock_size_x >> chroma_subsamp_x;
 
     // Initial padding is only needed for generation of
     // film grain templates (to stabilize the AR process)
@@ -915,396 +1199,154 @@ void svt_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb
     int32_t luma_block_size_y = top_pad + 2 * ar_padding + luma_subblock_size_y * 2 + bottom_pad;
     int32_t luma_block_size_x = left_pad + 2 * ar_padding + luma_subblock_size_x * 2 + 2 * ar_padding + right_pad;
 
-    int32_t chroma_block_size_y = top_pad + (2 >> chroma_subsamp_y) * ar_padding + chroma_subblock_size_y * 2 +
+    int32_t chroma_block_size_y = top_pad + (2 >> chroma_subsamp_y) * ar_padding + synth->chroma_subblock_size_y * 2 +
         bottom_pad;
-    int32_t chroma_block_size_x = left_pad + (2 >> chroma_subsamp_x) * ar_padding + chroma_subblock_size_x * 2 +
+    int32_t chroma_block_size_x = left_pad + (2 >> chroma_subsamp_x) * ar_padding + synth->chroma_subblock_size_x * 2 +
         (2 >> chroma_subsamp_x) * ar_padding + right_pad;
 
-    int32_t luma_grain_stride   = luma_block_size_x;
-    int32_t chroma_grain_stride = chroma_block_size_x;
-
-    int32_t overlap   = params->overlap_flag;
-    int32_t bit_depth = params->bit_depth;
+    synth->luma_grain_stride   = luma_block_size_x;
+    synth->chroma_grain_stride = chroma_block_size_x;
 
-    grain_center = 128 << (bit_depth - 8);
-    grain_min    = 0 - grain_center;
-    grain_max    = (256 << (bit_depth - 8)) - 1 - grain_center;
+    int32_t bit_depth    = params->bit_depth;
+    int32_t grain_center = 128 << (bit_depth - 8);
+    synth->grain_min     = 0 - grain_center;
+    synth->grain_max     = (256 << (bit_depth - 8)) - 1 - grain_center;
 
     init_arrays(params,
-                luma_stride,
-                chroma_stride,
                 &pred_pos_luma,
                 &pred_pos_chroma,
-                &luma_grain_block,
-                &cb_grain_block,
-                &cr_grain_block,
-                &y_line_buf,
-                &cb_line_buf,
-                &cr_line_buf,
-                &y_col_buf,
-                &cb_col_buf,
-                &cr_col_buf,
+                &synth->luma_grain_block,
+                &synth->cb_grain_block,
+                &synth->cr_grain_block,
                 luma_block_size_y * luma_block_size_x,
-                chroma_block_size_y * chroma_block_size_x,
-                chroma_subsamp_y,
-                chroma_subsamp_x);
+                chroma_block_size_y * chroma_block_size_x);
 
     generate_luma_grain_block(params,
                               pred_pos_luma,
-                              luma_grain_block,
+                              synth->luma_grain_block,
                               luma_block_size_y,
                               luma_block_size_x,
-                              luma_grain_stride,
+                              synth->luma_grain_stride,
                               left_pad,
                               top_pad,
                               right_pad,
-                              bottom_pad);
+                              bottom_pad,
+                              synth->grain_min,
+                              synth->grain_max);
 
     generate_chroma_grain_blocks(params,
                                  //                               pred_pos_luma,
                                  pred_pos_chroma,
-                                 luma_grain_block,
-                                 cb_grain_block,
-                                 cr_grain_block,
-                                 luma_grain_stride,
+                                 synth->luma_grain_block,
+                                 synth->cb_grain_block,
+                                 synth->cr_grain_block,
+                                 synth->luma_grain_stride,
                                  chroma_block_size_y,
                                  chroma_block_size_x,
-                                 chroma_grain_stride,
+                                 synth->chroma_grain_stride,
                                  left_pad,
                                  top_pad,
                                  right_pad,
                                  bottom_pad,
                                  chroma_subsamp_y,
-                                 chroma_subsamp_x);
+                                 chroma_subsamp_x,
+                                 synth->grain_min,
+                                 synth->grain_max);
+
+    dealloc_arrays(params, &pred_pos_luma, &pred_pos_chroma);
+
+    memset(synth->scaling_lut_y, 0, sizeof(synth->scaling_lut_y));
+    memset(synth->scaling_lut_cb, 0, sizeof(synth->scaling_lut_cb));
+    memset(synth->scaling_lut_cr, 0, sizeof(synth->scaling_lut_cr));
 
-    init_scaling_function(params->scaling_points_y, params->num_y_points, scaling_lut_y);
+    init_scaling_function(params->scaling_points_y, params->num_y_points, synth->scaling_lut_y);
 
     if (params->chroma_scaling_from_luma) {
-        svt_memcpy(scaling_lut_cb, scaling_lut_y, sizeof(*scaling_lut_y) * 256);
-        svt_memcpy(scaling_lut_cr, scaling_lut_y, sizeof(*scaling_lut_y) * 256);
+        svt_memcpy(synth->scaling_lut_cb, synth->scaling_lut_y, sizeof(synth->scaling_lut_y));
+        svt_memcpy(synth->scaling_lut_cr, synth->scaling_lut_y, sizeof(synth->scaling_lut_y));
     } else {
-        init_scaling_function(params->scaling_points_cb, params->num_cb_points, scaling_lut_cb);
-        init_scaling_function(params->scaling_points_cr, params->num_cr_points, scaling_lut_cr);
+        init_scaling_function(params->scaling_points_cb, params->num_cb_points, synth->scaling_lut_cb);
+        init_scaling_function(params->scaling_points_cr, params->num_cr_points, synth->scaling_lut_cr);
     }
-    for (int32_t y = 0; y < height / 2; y += (luma_subblock_size_y >> 1)) {
-        init_random_generator(y * 2, params->random_seed);
-
-        for (int32_t x = 0; x < width / 2; x += (luma_subblock_size_x >> 1)) {
-            int32_t offset_y = get_random_number(8);
-            int32_t offset_x = (offset_y >> 4) & 15;
-            offset_y &= 15;
-
-            int32_t luma_offset_y = left_pad + 2 * ar_padding + (offset_y << 1);
-            int32_t luma_offset_x = top_pad + 2 * ar_padding + (offset_x << 1);
-
-            int32_t chroma_offset_y = top_pad + (2 >> chroma_subsamp_y) * ar_padding +
-                offset_y * (2 >> chroma_subsamp_y);
-            int32_t chroma_offset_x = left_pad + (2 >> chroma_subsamp_x) * ar_padding +
-                offset_x * (2 >> chroma_subsamp_x);
-
-            if (overlap && x) {
-                ver_boundary_overlap(y_col_buf,
-                                     2,
-                                     luma_grain_block + luma_offset_y * luma_grain_stride + luma_offset_x,
-                                     luma_grain_stride,
-                                     y_col_buf,
-                                     2,
-                                     2,
-                                     AOMMIN(luma_subblock_size_y + 2, height - (y << 1)));
-
-                ver_boundary_overlap(
-                    cb_col_buf,
-                    2 >> chroma_subsamp_x,
-                    cb_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x,
-                    chroma_grain_stride,
-                    cb_col_buf,
-                    2 >> chroma_subsamp_x,
-                    2 >> chroma_subsamp_x,
-                    AOMMIN(chroma_subblock_size_y + (2 >> chroma_subsamp_y), (height - (y << 1)) >> chroma_subsamp_y));
-
-                ver_boundary_overlap(
-                    cr_col_buf,
-                    2 >> chroma_subsamp_x,
-                    cr_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x,
-                    chroma_grain_stride,
-                    cr_col_buf,
-                    2 >> chroma_subsamp_x,
-                    2 >> chroma_subsamp_x,
-                    AOMMIN(chroma_subblock_size_y + (2 >> chroma_subsamp_y), (height - (y << 1)) >> chroma_subsamp_y));
-
-                int32_t i = y ? 1 : 0;
-
-                if (use_high_bit_depth) {
-                    add_noise_to_block_hbd(params,
-                                           (uint16_t *)luma + ((y + i) << 1) * luma_stride + (x << 1),
-                                           (uint16_t *)cb + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                                               (x << (1 - chroma_subsamp_x)),
-                                           (uint16_t *)cr + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                                               (x << (1 - chroma_subsamp_x)),
-                                           luma_stride,
-                                           chroma_stride,
-                                           y_col_buf + i * 4,
-                                           cb_col_buf + i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
-                                           cr_col_buf + i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
-                                           2,
-                                           (2 - chroma_subsamp_x),
-                                           AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i,
-                                           1,
-                                           bit_depth,
-                                           chroma_subsamp_y,
-                                           chroma_subsamp_x);
-                } else {
-                    add_noise_to_block(
-                        params,
-                        luma + ((y + i) << 1) * luma_stride + (x << 1),
-                        cb + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride + (x << (1 - chroma_subsamp_x)),
-                        cr + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride + (x << (1 - chroma_subsamp_x)),
-                        luma_stride,
-                        chroma_stride,
-                        y_col_buf + i * 4,
-                        cb_col_buf + i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
-                        cr_col_buf + i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
-                        2,
-                        (2 - chroma_subsamp_x),
-                        AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i,
-                        1,
-                        bit_depth,
-                        chroma_subsamp_y,
-                        chroma_subsamp_x);
-                }
-            }
-
-            if (overlap && y) {
-                if (x) {
-                    ASSERT(y_col_buf != NULL);
-                    hor_boundary_overlap(
-                        y_line_buf + (x << 1), luma_stride, y_col_buf, 2, y_line_buf + (x << 1), luma_stride, 2, 2);
-
-                    hor_boundary_overlap(cb_line_buf + x * (2 >> chroma_subsamp_x),
-                                         chroma_stride,
-                                         cb_col_buf,
-                                         2 >> chroma_subsamp_x,
-                                         cb_line_buf + x * (2 >> chroma_subsamp_x),
-                                         chroma_stride,
-                                         2 >> chroma_subsamp_x,
-                                         2 >> chroma_subsamp_y);
-
-                    hor_boundary_overlap(cr_line_buf + x * (2 >> chroma_subsamp_x),
-                                         chroma_stride,
-                                         cr_col_buf,
-                                         2 >> chroma_subsamp_x,
-                                         cr_line_buf + x * (2 >> chroma_subsamp_x),
-                                         chroma_stride,
-                                         2 >> chroma_subsamp_x,
-                                         2 >> chroma_subsamp_y);
-                }
-
-                hor_boundary_overlap(y_line_buf + ((x ? x + 1 : 0) << 1),
-                                     luma_stride,
-                                     luma_grain_block + luma_offset_y * luma_grain_stride + luma_offset_x + (x ? 2 : 0),
-                                     luma_grain_stride,
-                                     y_line_buf + ((x ? x + 1 : 0) << 1),
-                                     luma_stride,
-                                     AOMMIN(luma_subblock_size_x - ((x ? 1 : 0) << 1), width - ((x ? x + 1 : 0) << 1)),
-                                     2);
-
-                hor_boundary_overlap(cb_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
-                                     chroma_stride,
-                                     cb_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x +
-                                         ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
-                                     chroma_grain_stride,
-                                     cb_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
-                                     chroma_stride,
-                                     AOMMIN(chroma_subblock_size_x - ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
-                                            (width - ((x ? x + 1 : 0) << 1)) >> chroma_subsamp_x),
-                                     2 >> chroma_subsamp_y);
-
-                hor_boundary_overlap(cr_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
-                                     chroma_stride,
-                                     cr_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x +
-                                         ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
-                                     chroma_grain_stride,
-                                     cr_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
-                                     chroma_stride,
-                                     AOMMIN(chroma_subblock_size_x - ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
-                                            (width - ((x ? x + 1 : 0) << 1)) >> chroma_subsamp_x),
-                                     2 >> chroma_subsamp_y);
-
-                if (use_high_bit_depth) {
-                    add_noise_to_block_hbd(params,
-                                           (uint16_t *)luma + (y << 1) * luma_stride + (x << 1),
-                                           (uint16_t *)cb + (y << (1 - chroma_subsamp_y)) * chroma_stride +
-                                               (x << ((1 - chroma_subsamp_x))),
-                                           (uint16_t *)cr + (y << (1 - chroma_subsamp_y)) * chroma_stride +
-                                               (x << ((1 - chroma_subsamp_x))),
-                                           luma_stride,
-                                           chroma_stride,
-                                           y_line_buf + (x << 1),
-                                           cb_line_buf + (x << (1 - chroma_subsamp_x)),
-                                           cr_line_buf + (x << (1 - chroma_subsamp_x)),
-                                           luma_stride,
-                                           chroma_stride,
-                                           1,
-                                           AOMMIN(luma_subblock_size_x >> 1, width / 2 - x),
-                                           bit_depth,
-                                           chroma_subsamp_y,
-                                           chroma_subsamp_x);
-                } else {
-                    add_noise_to_block(
-                        params,
-                        luma + (y << 1) * luma_stride + (x << 1),
-                        cb + (y << (1 - chroma_subsamp_y)) * chroma_stride + (x << ((1 - chroma_subsamp_x))),
-                        cr + (y << (1 - chroma_subsamp_y)) * chroma_stride + (x << ((1 - chroma_subsamp_x))),
-                        luma_stride,
-                        chroma_stride,
-                        y_line_buf + (x << 1),
-                        cb_line_buf + (x << (1 - chroma_subsamp_x)),
-                        cr_line_buf + (x << (1 - chroma_subsamp_x)),
-                        luma_stride,
-                        chroma_stride,
-                        1,
-                        AOMMIN(luma_subblock_size_x >> 1, width / 2 - x),
-                        bit_depth,
-                        chroma_subsamp_y,
-                        chroma_subsamp_x);
-                }
-            }
-
-            int32_t i = overlap && y ? 1 : 0;
-            int32_t j = overlap && x ? 1 : 0;
-
-            if (use_high_bit_depth) {
-                add_noise_to_block_hbd(
-                    params,
-                    (uint16_t *)luma + ((y + i) << 1) * luma_stride + ((x + j) << 1),
-                    (uint16_t *)cb + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                        ((x + j) << (1 - chroma_subsamp_x)),
-                    (uint16_t *)cr + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                        ((x + j) << (1 - chroma_subsamp_x)),
-                    luma_stride,
-                    chroma_stride,
-                    luma_grain_block + (luma_offset_y + (i << 1)) * luma_grain_stride + luma_offset_x + (j << 1),
-                    cb_grain_block + (chroma_offset_y + (i << (1 - chroma_subsamp_y))) * chroma_grain_stride +
-                        chroma_offset_x + (j << (1 - chroma_subsamp_x)),
-                    cr_grain_block + (chroma_offset_y + (i << (1 - chroma_subsamp_y))) * chroma_grain_stride +
-                        chroma_offset_x + (j << (1 - chroma_subsamp_x)),
-                    luma_grain_stride,
-                    chroma_grain_stride,
-                    AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i,
-                    AOMMIN(luma_subblock_size_x >> 1, width / 2 - x) - j,
-                    bit_depth,
-                    chroma_subsamp_y,
-                    chroma_subsamp_x);
-            } else {
-                add_noise_to_block(
-                    params,
-                    luma + ((y + i) << 1) * luma_stride + ((x + j) << 1),
-                    cb + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride + ((x + j) << (1 - chroma_subsamp_x)),
-                    cr + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride + ((x + j) << (1 - chroma_subsamp_x)),
-                    luma_stride,
-                    chroma_stride,
-                    luma_grain_block + (luma_offset_y + (i << 1)) * luma_grain_stride + luma_offset_x + (j << 1),
-                    cb_grain_block + (chroma_offset_y + (i << (1 - chroma_subsamp_y))) * chroma_grain_stride +
-                        chroma_offset_x + (j << (1 - chroma_subsamp_x)),
-                    cr_grain_block + (chroma_offset_y + (i << (1 - chroma_subsamp_y))) * chroma_grain_stride +
-                        chroma_offset_x + (j << (1 - chroma_subsamp_x)),
-                    luma_grain_stride,
-                    chroma_grain_stride,
-                    AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i,
-                    AOMMIN(luma_subblock_size_x >> 1, width / 2 - x) - j,
-                    bit_depth,
-                    chroma_subsamp_y,
-                    chroma_subsamp_x);
-            }
-
-            if (overlap) {
-                if (x) {
-                    // Copy overlapped column bufer to line buffer
-                    copy_area(y_col_buf + (luma_subblock_size_y << 1), 2, y_line_buf + (x << 1), luma_stride, 2, 2);
-
-                    copy_area(cb_col_buf + (chroma_subblock_size_y << (1 - chroma_subsamp_x)),
-                              2 >> chroma_subsamp_x,
-                              cb_line_buf + (x << (1 - chroma_subsamp_x)),
-                              chroma_stride,
-                              2 >> chroma_subsamp_x,
-                              2 >> chroma_subsamp_y);
-
-                    copy_area(cr_col_buf + (chroma_subblock_size_y << (1 - chroma_subsamp_x)),
-                              2 >> chroma_subsamp_x,
-                              cr_line_buf + (x << (1 - chroma_subsamp_x)),
-                              chroma_stride,
-                              2 >> chroma_subsamp_x,
-                              2 >> chroma_subsamp_y);
-                }
+}
 
-                // Copy grain to the line buffer for overlap with a bottom block
-                copy_area(luma_grain_block + (luma_offset_y + luma_subblock_size_y) * luma_grain_stride +
-                              luma_offset_x + ((x ? 2 : 0)),
-                          luma_grain_stride,
-                          y_line_buf + ((x ? x + 1 : 0) << 1),
-                          luma_stride,
-                          AOMMIN(luma_subblock_size_x, width - (x << 1)) - (x ? 2 : 0),
-                          2);
-
-                copy_area(cb_grain_block + (chroma_offset_y + chroma_subblock_size_y) * chroma_grain_stride +
-                              chroma_offset_x + (x ? 2 >> chroma_subsamp_x : 0),
-                          chroma_grain_stride,
-                          cb_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
-                          chroma_stride,
-                          AOMMIN(chroma_subblock_size_x, ((width - (x << 1)) >> chroma_subsamp_x)) -
-                              (x ? 2 >> chroma_subsamp_x : 0),
-                          2 >> chroma_subsamp_y);
+void svt_av1_film_grain_synth_free(FilmGrainSynth *synth) {
+    free(synth->luma_grain_block);
+    free(synth->cb_grain_block);
+    free(synth->cr_grain_block);
+    synth->luma_grain_block = NULL;
+    synth->cb_grain_block   = NULL;
+    synth->cr_grain_block   = NULL;
+}
 
-                copy_area(cr_grain_block + (chroma_offset_y + chroma_subblock_size_y) * chroma_grain_stride +
-                              chroma_offset_x + (x ? 2 >> chroma_subsamp_x : 0),
-                          chroma_grain_stride,
-                          cr_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
-                          chroma_stride,
-                          AOMMIN(chroma_subblock_size_x, ((width - (x << 1)) >> chroma_subsamp_x)) -
-                              (x ? 2 >> chroma_subsamp_x : 0),
-                          2 >> chroma_subsamp_y);
+int32_t svt_av1_film_grain_block_rows(int32_t height) {
+    int32_t half_block_height = luma_subblock_size_y >> 1;
+    return (height / 2 + half_block_height - 1) / half_block_height;
+}
 
-                // Copy grain to the column buffer for overlap with the next block to
-                // the right
-
-                copy_area(luma_grain_block + luma_offset_y * luma_grain_stride + luma_offset_x + luma_subblock_size_x,
-                          luma_grain_stride,
-                          y_col_buf,
-                          2,
-                          2,
-                          AOMMIN(luma_subblock_size_y + 2, height - (y << 1)));
-
-                copy_area(
-                    cb_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x + chroma_subblock_size_x,
-                    chroma_grain_stride,
-                    cb_col_buf,
-                    2 >> chroma_subsamp_x,
-                    2 >> chroma_subsamp_x,
-                    AOMMIN(chroma_subblock_size_y + (2 >> chroma_subsamp_y), (height - (y << 1)) >> chroma_subsamp_y));
-
-                copy_area(
-                    cr_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x + chroma_subblock_size_x,
-                    chroma_grain_stride,
-                    cr_col_buf,
-                    2 >> chroma_subsamp_x,
-                    2 >> chroma_subsamp_x,
-                    AOMMIN(chroma_subblock_size_y + (2 >> chroma_subsamp_y), (height - (y << 1)) >> chroma_subsamp_y));
-            }
-        }
-    }
+void svt_av1_add_film_grain_rows(const FilmGrainSynth *synth, uint8_t *luma, uint8_t *cb, uint8_t *cr, int32_t height,
+                                 int32_t width, int32_t luma_stride, int32_t chroma_stride, int32_t use_high_bit_depth,
+                                 int32_t row_start, int32_t row_end) {
+    int32_t    chroma_subsamp_y = synth->chroma_subsamp_y;
+    int32_t    chroma_subsamp_x = synth->chroma_subsamp_x;
+    FgnRowCtxt ctx;
+
+    ctx.synth              = synth;
+    ctx.luma               = luma;
+    ctx.cb                 = cb;
+    ctx.cr                 = cr;
+    ctx.height             = height;
+    ctx.width              = width;
+    ctx.luma_stride        = luma_stride;
+    ctx.chroma_stride      = chroma_stride;
+    ctx.use_high_bit_depth = use_high_bit_depth;
+    init_noise_params(synth, use_high_bit_depth, &ctx.noise);
+
+    ctx.y_line_buf  = (int32_t *)malloc(sizeof(*ctx.y_line_buf) * luma_stride * 2);
+    ctx.cb_line_buf = (int32_t *)malloc(sizeof(*ctx.cb_line_buf) * chroma_stride * (2 >> chroma_subsamp_y));
+    ctx.cr_line_buf = (int32_t *)malloc(sizeof(*ctx.cr_line_buf) * chroma_stride * (2 >> chroma_subsamp_y));
+
+    ctx.y_col_buf  = (int32_t *)malloc(sizeof(*ctx.y_col_buf) * (luma_subblock_size_y + 2) * 2);
+    ctx.cb_col_buf = (int32_t *)malloc(sizeof(*ctx.cb_col_buf) *
+                                       (synth->chroma_subblock_size_y + (2 >> chroma_subsamp_y)) *
+                                       (2 >> chroma_subsamp_x));
+    ctx.cr_col_buf = (int32_t *)malloc(sizeof(*ctx.cr_col_buf) *
+                                       (synth->chroma_subblock_size_y + (2 >> chroma_subsamp_y)) *
+                                       (2 >> chroma_subsamp_x));
+
+    // The overlap needs the line buffer of the block row above, which only depends on that row: it is rebuilt
+    // rather than waited for, so that the bands are independent
+    if (synth->params->overlap_flag && row_start > 0)
+        add_film_grain_block_row(&ctx, (row_start - 1) * (luma_subblock_size_y >> 1), FALSE);
+    for (int32_t row = row_start; row < row_end; row++)
+        add_film_grain_block_row(&ctx, row * (luma_subblock_size_y >> 1), TRUE);
+
+    free(ctx.y_line_buf);
+    free(ctx.cb_line_buf);
+    free(ctx.cr_line_buf);
+    free(ctx.y_col_buf);
+    free(ctx.cb_col_buf);
+    free(ctx.cr_col_buf);
+}
 
-    dealloc_arrays(params,
-                   &pred_pos_luma,
-                   &pred_pos_chroma,
-                   &luma_grain_block,
-                   &cb_grain_block,
-                   &cr_grain_block,
-                   &y_line_buf,
-                   &cb_line_buf,
-                   &cr_line_buf,
-                   &y_col_buf,
-                   &cb_col_buf,
-                   &cr_col_buf);
+void svt_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb, uint8_t *cr, int32_t height,
+                                int32_t width, int32_t luma_stride, int32_t chroma_stride, int32_t use_high_bit_depth,
+                                int32_t chroma_subsamp_y, int32_t chroma_subsamp_x) {
+    FilmGrainSynth synth;
+
+    svt_av1_film_grain_synth_init(&synth, params, chroma_subsamp_y, chroma_subsamp_x);
+    svt_av1_add_film_grain_rows(&synth,
+                                luma,
+                                cb,
+                                cr,
+                                height,
+                                width,
+                                luma_stride,
+                                chroma_stride,
+                                use_high_bit_depth,
+                                0,
+                                svt_av1_film_grain_block_rows(height));
+    svt_av1_film_grain_synth_free(&synth);
 }
 
 /*
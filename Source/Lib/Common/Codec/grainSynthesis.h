@@ -26,6 +26,49 @@ extern "C" {
 
 int32_t svt_aom_film_grain_params_equal(AomFilmGrain *pars_a, AomFilmGrain *pars_b);
 
+/*!\brief Grain templates and scaling functions of a picture
+     *
+     * Built by svt_av1_film_grain_synth_init() and only read afterwards, so
+     * that several threads can add the grain to different block rows.
+     */
+typedef struct FilmGrainSynth {
+    AomFilmGrain *params;
+    int32_t       chroma_subsamp_y;
+    int32_t       chroma_subsamp_x;
+    int32_t       chroma_subblock_size_y;
+    int32_t       chroma_subblock_size_x;
+    int32_t       grain_min;
+    int32_t       grain_max;
+    int32_t      *luma_grain_block;
+    int32_t      *cb_grain_block;
+    int32_t      *cr_grain_block;
+    int32_t       luma_grain_stride;
+    int32_t       chroma_grain_stride;
+    int32_t       scaling_lut_y[256];
+    int32_t       scaling_lut_cb[256];
+    int32_t       scaling_lut_cr[256];
+} FilmGrainSynth;
+
+void svt_av1_film_grain_synth_init(FilmGrainSynth *synth, AomFilmGrain *params, int32_t chroma_subsamp_y,
+                                   int32_t chroma_subsamp_x);
+void svt_av1_film_grain_synth_free(FilmGrainSynth *synth);
+
+/*!\brief Number of block rows the grain is added by, for a luma plane height */
+int32_t svt_av1_film_grain_block_rows(int32_t height);
+
+/*!\brief Add film grain to block rows
+     *
+     * Adds the grain to the block rows [row_start, row_end) of an image. The
+     * bands of block rows of an image can be processed concurrently.
+     *
+     * \param[in]    synth            Grain templates of the image
+     * \param[in]    row_start        first block row
+     * \param[in]    row_end          block row past the last one
+     */
+void svt_av1_add_film_grain_rows(const FilmGrainSynth *synth, uint8_t *luma, uint8_t *cb, uint8_t *cr, int32_t height,
+                                 int32_t width, int32_t luma_stride, int32_t chroma_stride, int32_t use_high_bit_depth,
+                                 int32_t row_start, int32_t row_end);
+
 /*!\brief Add film grain
      *
      * Add film grain to an image
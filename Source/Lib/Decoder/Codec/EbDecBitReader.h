@@ -53,7 +53,11 @@ static INLINE int aom_read_(SvtReader *r, int prob ACCT_STR_PARAM) {
 
 static INLINE int aom_read_bit_(SvtReader *r ACCT_STR_PARAM) {
     int ret;
+#if CONFIG_BITSTREAM_DEBUG || ENABLE_ENTROPY_TRACE
     ret = svt_read(r, 128, NULL); // aom_prob_half
+#else
+    ret = od_ec_decode_bool_equi(&r->ec);
+#endif
     return ret;
 }
 
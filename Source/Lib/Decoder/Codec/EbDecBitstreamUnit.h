@@ -15,6 +15,7 @@
 
 #include "EbCabacContextModel.h"
 #include "EbBitstreamUnit.h"
+#include "common_dsp_rtcd.h"
 //Added this EbBitstreamUnit.h because OdEcWindow is defined in it, but
 //we also defining it, so it leads to warning,  so i commented our defination & added EbBitstreamUnit.h file.
 
@@ -71,23 +72,18 @@ extern int   enable_dump;
 #define AOM_ICDF(x) (CDF_PROB_TOP - (x))
 
 static INLINE void dec_update_cdf(AomCdfProb *cdf, int8_t val, int nsymbs) {
-    int rate;
-    int i, tmp;
-
-    static const int nsymbs2speed[17] = {0, 0, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2};
     assert(nsymbs < 17);
-    rate = 3 + (cdf[nsymbs] > 15) + (cdf[nsymbs] > 31) + nsymbs2speed[nsymbs]; // + get_msb(nsymbs);
-    tmp  = AOM_ICDF(0);
-
-    // Single loop (faster)
-    for (i = 0; i < nsymbs - 1; ++i) {
-        tmp = (i == val) ? 0 : tmp;
-        if (tmp < cdf[i]) {
-            cdf[i] -= (AomCdfProb)((cdf[i] - tmp) >> rate);
-        } else
-            cdf[i] += (AomCdfProb)((tmp - cdf[i]) >> rate);
+    if (nsymbs == 2) {
+        // Binary symbols are the most frequent ones and have a single probability to adapt
+        const int rate = 4 + (cdf[2] > 15) + (cdf[2] > 31);
+        if (val)
+            cdf[0] += (AomCdfProb)((AOM_ICDF(0) - cdf[0]) >> rate);
+        else
+            cdf[0] -= (AomCdfProb)(cdf[0] >> rate);
+        cdf[2] += (cdf[2] < 32);
+        return;
     }
-    cdf[nsymbs] += (cdf[nsymbs] < 32);
+    svt_od_ec_update_cdf(cdf, val, nsymbs);
 }
 
 /********************************************************************************************************************************/
@@ -196,7 +192,6 @@ static int od_ec_decode_cdf_q15(OdEcDec *dec, const uint16_t *icdf, int nsyms) {
     unsigned   u;
     unsigned   v;
     int        ret;
-    (void)nsyms;
     dif         = dec->dif;
     r           = dec->rng;
     const int N = nsyms - 1;
@@ -205,14 +200,22 @@ static int od_ec_decode_cdf_q15(OdEcDec *dec, const uint16_t *icdf, int nsyms) {
     assert(icdf[nsyms - 1] == OD_ICDF(CDF_PROB_TOP));
     assert(32768U <= r);
     assert(7 - EC_PROB_SHIFT - CDF_SHIFT >= 0);
-    c   = (unsigned)(dif >> (OD_EC_WINDOW_SIZE - 16));
-    v   = r;
-    ret = -1;
-    do {
-        u = v;
-        v = ((r >> 8) * (uint32_t)(icdf[++ret] >> EC_PROB_SHIFT) >> (7 - EC_PROB_SHIFT - CDF_SHIFT));
-        v += EC_MIN_PROB * (N - ret);
-    } while (c < v);
+    c = (unsigned)(dif >> (OD_EC_WINDOW_SIZE - 16));
+    if (nsyms == 2) {
+        // Same as od_ec_decode_bool_q15() with the probability taken from the CDF
+        v   = ((r >> 8) * (uint32_t)(icdf[0] >> EC_PROB_SHIFT) >> (7 - EC_PROB_SHIFT - CDF_SHIFT)) + EC_MIN_PROB;
+        ret = c < v;
+        u   = ret ? v : r;
+        v   = ret ? 0 : v;
+    } else {
+        // The vectorized search compares the window with all the symbol bounds at once
+        ret = svt_od_ec_find_symbol(icdf, nsyms, c, r);
+        u   = ret ? ((r >> 8) * (uint32_t)(icdf[ret - 1] >> EC_PROB_SHIFT) >> (7 - EC_PROB_SHIFT - CDF_SHIFT)) +
+                  EC_MIN_PROB * (N - ret + 1)
+                  : r;
+        v = ((r >> 8) * (uint32_t)(icdf[ret] >> EC_PROB_SHIFT) >> (7 - EC_PROB_SHIFT - CDF_SHIFT)) +
+            EC_MIN_PROB * (N - ret);
+    }
     assert(v < u);
     assert(u <= r);
     r = u - v;
@@ -220,6 +223,18 @@ static int od_ec_decode_cdf_q15(OdEcDec *dec, const uint16_t *icdf, int nsyms) {
     return od_ec_dec_normalize(dec, dif, r, ret);
 }
 
+/*Decodes an equiprobable bit, i.e. od_ec_decode_bool_q15() with f = 16384.*/
+static INLINE int od_ec_decode_bool_equi(OdEcDec *dec) {
+    const OdEcWindow dif = dec->dif;
+    const unsigned   r   = dec->rng;
+    const unsigned   v   = ((r >> 8) << 7) + EC_MIN_PROB;
+    const OdEcWindow vw  = (OdEcWindow)v << (OD_EC_WINDOW_SIZE - 16);
+    assert(dif >> (OD_EC_WINDOW_SIZE - 16) < r);
+    if (dif >= vw)
+        return od_ec_dec_normalize(dec, dif - vw, r - v, 0);
+    return od_ec_dec_normalize(dec, dif, v, 1);
+}
+
 /********************************************************************************************************************************/
 /********************************************************************************************************************************/
 /********************************************************************************************************************************/
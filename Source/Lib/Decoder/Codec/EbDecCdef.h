@@ -21,8 +21,27 @@
 extern "C" {
 #endif
 
+/* State carried across 64x64 filter block rows by the single thread CDEF */
+typedef struct DecCdefCtxt {
+    uint16_t *linebuf[3];
+    uint16_t *colbuf[3];
+    uint8_t  *row_cdef;
+    uint8_t  *prev_row_cdef;
+    uint8_t  *curr_row_cdef;
+    uint8_t  *curr_blk_recon_buf[MAX_MB_PLANE];
+    int32_t   curr_recon_stride[MAX_MB_PLANE];
+    int32_t   mi_wide_l2[3];
+    int32_t   mi_high_l2[3];
+    int32_t   stride;
+    int32_t   num_planes;
+} DecCdefCtxt;
+
 void svt_cdef_frame(EbDecHandle *dec_handle, int enable_flag);
 
+void svt_cdef_frame_init(EbDecHandle *dec_handle, DecCdefCtxt *cdef_ctxt);
+void svt_cdef_fb_row(EbDecHandle *dec_handle, DecCdefCtxt *cdef_ctxt, int32_t fbr);
+void svt_cdef_frame_free(DecCdefCtxt *cdef_ctxt);
+
 void svt_cdef_sb_row_mt(EbDecHandle *dec_handle, int32_t *mi_wide_l2, int32_t *mi_high_l2, uint16_t **colbuf,
                         int32_t sb_fbr, uint16_t *src, int32_t *curr_recon_stride, uint8_t **curr_blk_recon_buf);
 
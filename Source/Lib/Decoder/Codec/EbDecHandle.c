@@ -71,6 +71,14 @@ void        svt_aom_asm_set_convolve_hbd_asm_table(void);
 void        svt_aom_init_intra_predictors_internal(void);
 extern void svt_av1_init_wedge_masks(void);
 void        dec_sync_all_threads(EbDecHandle *dec_handle_ptr);
+EbErrorType svt_aom_dec_frm_prll_init(EbDecHandle *dec_handle_ptr);
+void        svt_aom_dec_frm_prll_deinit(EbDecHandle *dec_handle_ptr);
+EbErrorType svt_aom_dec_fg_init(EbDecHandle *dec_handle_ptr);
+void        svt_aom_dec_fg_deinit(EbDecHandle *dec_handle_ptr);
+void        svt_aom_dec_add_film_grain(EbDecHandle *dec_handle_ptr, AomFilmGrain *film_grain_ptr, uint8_t *luma,
+                                       uint8_t *cb, uint8_t *cr, int32_t height, int32_t width, int32_t luma_stride,
+                                       int32_t chroma_stride, int32_t use_high_bit_depth, int32_t chroma_subsamp_y,
+                                       int32_t chroma_subsamp_x);
 
 EbErrorType svt_aom_decode_multiple_obu(EbDecHandle *dec_handle_ptr, uint8_t **data, size_t data_size,
                                         uint32_t is_annexb);
@@ -106,6 +114,9 @@ static EbErrorType svt_dec_handle_ctor(EbDecHandle **decHandleDblPtr, EbComponen
     svt_dec_lib_malloc_count = 0;
 
     dec_handle_ptr->start_thread_process = FALSE;
+    dec_handle_ptr->pv_frm_prll_ctxt     = NULL;
+    dec_handle_ptr->pv_fg_ctxt           = NULL;
+    dec_handle_ptr->pv_pic_mgr           = NULL;
     svt_aom_memory_map_start_address     = NULL;
     svt_aom_memory_map_end_address       = NULL;
 
@@ -127,63 +138,64 @@ static void copy_even(uint8_t *luma, uint32_t wd, uint32_t ht, uint32_t stride,
             &luma[ht * (stride << use_hbd)], &luma[(ht - 1) * (stride << use_hbd)], sizeof(*luma) * (wd << use_hbd));
     }
 }
-/* Copy from recon buffer to out buffer! */
-int svt_dec_out_buf(EbDecHandle *dec_handle_ptr, EbBufferHeaderType *p_buffer) {
-    EbPictureBufferDesc *recon_picture_buf = dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf;
-    EbSvtIOFormat       *out_img           = (EbSvtIOFormat *)p_buffer->p_buffer;
-
-    uint8_t *luma = NULL;
-    uint8_t *cb   = NULL;
-    uint8_t *cr   = NULL;
+/* Output plane strides and sizes for a wd x ht picture */
+static int dec_out_img_layout(EbPictureBufferDesc *recon_picture_buf, uint32_t wd, uint32_t ht, int size,
+                              EbSvtIOFormat *out_img, int *luma_size, int *chroma_size) {
+    /* FilmGrain module req. even dim. for internal operation */
+    int even_w = (wd & 1) ? (wd + 1) : wd;
+    int even_h = (ht & 1) ? (ht + 1) : ht;
 
-    /* TODO: Should add logic for show_existing_frame */
-    if (0 == dec_handle_ptr->show_frame) {
-        assert(0 == dec_handle_ptr->show_existing_frame);
-        return 0;
+    *luma_size         = size * even_w * even_h;
+    *chroma_size       = -1;
+    out_img->color_fmt = recon_picture_buf->color_format;
+    switch (recon_picture_buf->color_format) {
+    case EB_YUV400:
+        out_img->cb_stride = INT32_MAX;
+        out_img->cr_stride = INT32_MAX;
+        break;
+    case EB_YUV420:
+        out_img->cb_stride = (wd + 1) >> 1;
+        out_img->cr_stride = (wd + 1) >> 1;
+        *chroma_size       = size * (((wd + 1) >> 1) * ((ht + 1) >> 1));
+        break;
+    case EB_YUV422:
+        out_img->cb_stride = (wd + 1) >> 1;
+        out_img->cr_stride = (wd + 1) >> 1;
+        *chroma_size       = size * (((wd + 1) >> 1) * ht);
+        break;
+    case EB_YUV444:
+        out_img->cb_stride = wd;
+        out_img->cr_stride = wd;
+        *chroma_size       = size * ht * wd;
+        break;
+    default: SVT_ERROR("Unsupported colour format.\n"); return 0;
     }
 
-    uint32_t wd = dec_handle_ptr->frame_header.frame_size.superres_upscaled_width;
-    uint32_t ht = dec_handle_ptr->frame_header.frame_size.frame_height;
-    int      sx = 0, sy = 0;
     /* FilmGrain module req. even dim. for internal operation */
-    int even_w = (wd & 1) ? (wd + 1) : wd;
-    int even_h = (ht & 1) ? (ht + 1) : ht;
+    out_img->y_stride = even_w;
+    out_img->width    = wd;
+    out_img->height   = ht;
+    return 1;
+}
+
+static void dec_copy_out_pic(EbDecHandle *dec_handle_ptr, DecOutPic *out_pic, EbSvtIOFormat *out_img);
+
+/* Copy from recon buffer to out buffer! */
+static int svt_dec_out_buf(EbDecHandle *dec_handle_ptr, DecOutPic *out_pic, EbBufferHeaderType *p_buffer) {
+    EbPictureBufferDesc *recon_picture_buf = out_pic->pic_buf->ps_pic_buf;
+    EbSvtIOFormat       *out_img           = (EbSvtIOFormat *)p_buffer->p_buffer;
+
+    uint32_t wd = out_pic->width;
+    uint32_t ht = out_pic->height;
 
     if (out_img->height != ht || out_img->width != wd || out_img->color_fmt != recon_picture_buf->color_format ||
         out_img->bit_depth != (EbBitDepth)recon_picture_buf->bit_depth) {
         int size = (dec_handle_ptr->seq_header.color_config.bit_depth == EB_EIGHT_BIT) ? sizeof(uint8_t)
                                                                                        : sizeof(uint16_t);
+        int luma_size, chroma_size;
 
-        int luma_size      = size * even_w * even_h;
-        int chroma_size    = -1;
-        out_img->color_fmt = recon_picture_buf->color_format;
-        switch (recon_picture_buf->color_format) {
-        case EB_YUV400:
-            out_img->cb_stride = INT32_MAX;
-            out_img->cr_stride = INT32_MAX;
-            break;
-        case EB_YUV420:
-            out_img->cb_stride = (wd + 1) >> 1;
-            out_img->cr_stride = (wd + 1) >> 1;
-            chroma_size        = size * (((wd + 1) >> 1) * ((ht + 1) >> 1));
-            break;
-        case EB_YUV422:
-            out_img->cb_stride = (wd + 1) >> 1;
-            out_img->cr_stride = (wd + 1) >> 1;
-            chroma_size        = size * (((wd + 1) >> 1) * ht);
-            break;
-        case EB_YUV444:
-            out_img->cb_stride = wd;
-            out_img->cr_stride = wd;
-            chroma_size        = size * ht * wd;
-            break;
-        default: SVT_ERROR("Unsupported colour format.\n"); return 0;
-        }
-
-        /* FilmGrain module req. even dim. for internal operation */
-        out_img->y_stride = even_w;
-        out_img->width    = wd;
-        out_img->height   = ht;
+        if (!dec_out_img_layout(recon_picture_buf, wd, ht, size, out_img, &luma_size, &chroma_size))
+            return 0;
         if (out_img->bit_depth != (EbBitDepth)recon_picture_buf->bit_depth) {
             SVT_WARN("Output bit depth conversion not supported. Output depth set to %d.\n",
                      recon_picture_buf->bit_depth);
@@ -202,6 +214,91 @@ int svt_dec_out_buf(EbDecHandle *dec_handle_ptr, EbBufferHeaderType *p_buffer) {
         }
     }
 
+    dec_copy_out_pic(dec_handle_ptr, out_pic, out_img);
+    return 1;
+}
+
+/* Zero copy output : the output planes point to the decoded picture, which
+   stays pinned until svt_av1_dec_release_picture(). Film grain and the 8-bit
+   output of the 16-bit pipeline are written to an output buffer of the picture */
+static EbErrorType dec_zero_copy_out_buf(EbDecHandle *dec_handle_ptr, DecOutPic *out_pic, EbSvtIOFormat *out_img) {
+    EbDecPicBuf         *pic_buf           = out_pic->pic_buf;
+    EbPictureBufferDesc *recon_picture_buf = pic_buf->ps_pic_buf;
+
+    Bool apply_grain  = !dec_handle_ptr->dec_config.skip_film_grain && out_pic->film_grain_params.apply_grain;
+    Bool down_convert = recon_picture_buf->bit_depth == EB_EIGHT_BIT && dec_handle_ptr->is_16bit_pipeline;
+
+    out_img->bit_depth = (EbBitDepth)recon_picture_buf->bit_depth;
+    out_img->org_x     = 0;
+    out_img->org_y     = 0;
+
+    if (apply_grain || down_convert) {
+        int size = (recon_picture_buf->bit_depth == EB_EIGHT_BIT) ? sizeof(uint8_t) : sizeof(uint16_t);
+        int luma_size, chroma_size;
+
+        if (!dec_out_img_layout(
+                recon_picture_buf, out_pic->width, out_pic->height, size, out_img, &luma_size, &chroma_size))
+            return EB_ErrorBadParameter;
+        size_t out_buf_size = luma_size + 2 * AOMMAX(chroma_size, 0);
+        if (pic_buf->out_buf_size < out_buf_size) {
+            /* Not in the memory map, so that the smaller buffer can be freed */
+            free(pic_buf->out_buf);
+            pic_buf->out_buf_size = 0;
+            pic_buf->out_buf      = (uint8_t *)malloc(out_buf_size);
+            if (pic_buf->out_buf == NULL)
+                return EB_ErrorInsufficientResources;
+            pic_buf->out_buf_size = out_buf_size;
+        }
+        out_img->luma = pic_buf->out_buf;
+        out_img->cb   = chroma_size > 0 ? pic_buf->out_buf + luma_size : NULL;
+        out_img->cr   = chroma_size > 0 ? pic_buf->out_buf + luma_size + chroma_size : NULL;
+        dec_copy_out_pic(dec_handle_ptr, out_pic, out_img);
+        return EB_ErrorNone;
+    }
+
+    int32_t shift = recon_picture_buf->bit_depth == EB_EIGHT_BIT ? 0 : 1;
+    int32_t sx    = dec_handle_ptr->seq_header.color_config.subsampling_x;
+    int32_t sy    = dec_handle_ptr->seq_header.color_config.subsampling_y;
+
+    out_img->color_fmt = recon_picture_buf->color_format;
+    out_img->width     = out_pic->width;
+    out_img->height    = out_pic->height;
+    out_img->y_stride  = recon_picture_buf->stride_y;
+    out_img->luma      = recon_picture_buf->buffer_y +
+        ((recon_picture_buf->org_x + recon_picture_buf->org_y * recon_picture_buf->stride_y) << shift);
+    if (recon_picture_buf->color_format != EB_YUV400) {
+        out_img->cb_stride = recon_picture_buf->stride_cb;
+        out_img->cr_stride = recon_picture_buf->stride_cr;
+        out_img->cb        = recon_picture_buf->buffer_cb +
+            (((recon_picture_buf->org_x >> sx) + (recon_picture_buf->org_y >> sy) * recon_picture_buf->stride_cb)
+             << shift);
+        out_img->cr = recon_picture_buf->buffer_cr +
+            (((recon_picture_buf->org_x >> sx) + (recon_picture_buf->org_y >> sy) * recon_picture_buf->stride_cr)
+             << shift);
+    } else {
+        out_img->cb_stride = INT32_MAX;
+        out_img->cr_stride = INT32_MAX;
+        out_img->cb        = NULL;
+        out_img->cr        = NULL;
+    }
+    return EB_ErrorNone;
+}
+
+/* Copies the picture to the output planes and applies film grain */
+static void dec_copy_out_pic(EbDecHandle *dec_handle_ptr, DecOutPic *out_pic, EbSvtIOFormat *out_img) {
+    EbPictureBufferDesc *recon_picture_buf = out_pic->pic_buf->ps_pic_buf;
+
+    uint8_t *luma = NULL;
+    uint8_t *cb   = NULL;
+    uint8_t *cr   = NULL;
+
+    uint32_t wd = out_pic->width;
+    uint32_t ht = out_pic->height;
+    int      sx = 0, sy = 0;
+    /* FilmGrain module req. even dim. for internal operation */
+    int even_w = (wd & 1) ? (wd + 1) : wd;
+    int even_h = (ht & 1) ? (ht + 1) : ht;
+
     switch (recon_picture_buf->color_format) {
     case EB_YUV400:
         sx = -1;
@@ -357,7 +454,7 @@ int svt_dec_out_buf(EbDecHandle *dec_handle_ptr, EbBufferHeaderType *p_buffer) {
 
     if (!dec_handle_ptr->dec_config.skip_film_grain) {
         /* Need to fill the dst buf with recon data before calling film_grain */
-        AomFilmGrain *film_grain_ptr = &dec_handle_ptr->cur_pic_buf[0]->film_grain_params;
+        AomFilmGrain *film_grain_ptr = &out_pic->film_grain_params;
         if (film_grain_ptr->apply_grain) {
             switch (recon_picture_buf->bit_depth) {
             case EB_EIGHT_BIT: film_grain_ptr->bit_depth = 8; break;
@@ -365,7 +462,8 @@ int svt_dec_out_buf(EbDecHandle *dec_handle_ptr, EbBufferHeaderType *p_buffer) {
             default: assert(0);
             }
             copy_even(luma, wd, ht, out_img->y_stride, use_high_bit_depth);
-            svt_av1_add_film_grain_run(film_grain_ptr,
+            svt_aom_dec_add_film_grain(dec_handle_ptr,
+                                       film_grain_ptr,
                                        luma,
                                        cb,
                                        cr,
@@ -378,8 +476,6 @@ int svt_dec_out_buf(EbDecHandle *dec_handle_ptr, EbBufferHeaderType *p_buffer) {
                                        sx);
         }
     }
-
-    return 1;
 }
 
 /**********************************
@@ -415,6 +511,13 @@ EbErrorType svt_svt_dec_set_default_parameter(EbSvtAv1DecConfiguration *config_p
     config_ptr->threads      = 1;
     config_ptr->num_p_frames = 1;
 
+    /* External frame buffer allocator */
+    config_ptr->allocate_frame_buffer = NULL;
+    config_ptr->release_frame_buffer  = NULL;
+    config_ptr->frame_buffer_priv     = NULL;
+
+    config_ptr->zero_copy_output = 0;
+
     return return_error;
 }
 
@@ -495,6 +598,10 @@ EB_API EbErrorType svt_av1_dec_set_parameter(EbComponentType          *svt_dec_c
 
     EbDecHandle *dec_handle_ptr = (EbDecHandle *)svt_dec_component->p_component_private;
 
+    /* External frame buffer callbacks come in pairs */
+    if ((config_struct->allocate_frame_buffer == NULL) != (config_struct->release_frame_buffer == NULL))
+        return EB_ErrorBadParameter;
+
     dec_handle_ptr->dec_config        = *config_struct;
     dec_handle_ptr->is_16bit_pipeline = config_struct->is_16bit_pipeline;
 
@@ -513,7 +620,10 @@ EB_API EbErrorType svt_av1_dec_init(EbComponentType *svt_dec_component) {
     EbCpuFlags cpu_flags = 0;
 #endif
     dec_handle_ptr->dec_cnt       = -1;
-    dec_handle_ptr->num_frms_prll = 1;
+    dec_handle_ptr->num_frms_prll = dec_handle_ptr->dec_config.num_p_frames;
+    /* Frame parallel decoding is supported only with tile/row level MT off */
+    if (dec_handle_ptr->num_frms_prll < 1 || dec_handle_ptr->dec_config.threads > 1)
+        dec_handle_ptr->num_frms_prll = 1;
     if (dec_handle_ptr->num_frms_prll > DEC_MAX_NUM_FRM_PRLL)
         dec_handle_ptr->num_frms_prll = DEC_MAX_NUM_FRM_PRLL;
     dec_handle_ptr->seq_header_done = 0;
@@ -524,6 +634,7 @@ EB_API EbErrorType svt_av1_dec_init(EbComponentType *svt_dec_component) {
     dec_handle_ptr->show_frame          = 0;
     dec_handle_ptr->showable_frame      = 0;
     dec_handle_ptr->seq_header.sb_size  = 0;
+    dec_handle_ptr->num_held_pics       = 0;
 
     svt_aom_setup_common_rtcd_internal(cpu_flags);
 
@@ -539,6 +650,17 @@ EB_API EbErrorType svt_av1_dec_init(EbComponentType *svt_dec_component) {
 #endif
     svt_av1_init_wedge_masks();
 
+    if (dec_handle_ptr->num_frms_prll > 1) {
+        return_error = svt_aom_dec_frm_prll_init(dec_handle_ptr);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+    }
+    if (dec_handle_ptr->dec_config.threads > 1) {
+        return_error = svt_aom_dec_fg_init(dec_handle_ptr);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+    }
+
     /************************************
     * Decoder Memory Init
     ************************************/
@@ -555,11 +677,25 @@ EB_API EbErrorType svt_av1_dec_frame(EbComponentType *svt_dec_component, const u
     if (svt_dec_component == NULL)
         return EB_ErrorBadParameter;
 
-    EbDecHandle *dec_handle_ptr       = (EbDecHandle *)svt_dec_component->p_component_private;
-    uint8_t     *data_start           = (uint8_t *)data;
-    uint8_t     *data_end             = (uint8_t *)data + data_size;
+    EbDecHandle    *dec_handle_ptr    = (EbDecHandle *)svt_dec_component->p_component_private;
+    DecFrmPrllCtxt *frm_prll_ctxt     = (DecFrmPrllCtxt *)dec_handle_ptr->pv_frm_prll_ctxt;
+    uint8_t        *data_start        = (uint8_t *)data;
+    uint8_t        *data_end          = (uint8_t *)data + data_size;
     dec_handle_ptr->seen_frame_header = 0;
 
+    /* In frame parallel mode output is delayed by one call : the frame
+       shown by the previous call is output after this one */
+    DecOutPic prev_out = {0};
+    if (frm_prll_ctxt != NULL) {
+        /* Drop the output of the previous call if it was not fetched */
+        svt_aom_dec_pic_mgr_release_pic(frm_prll_ctxt->ready_out.pic_buf);
+        frm_prll_ctxt->ready_out.pic_buf   = NULL;
+        prev_out                           = frm_prll_ctxt->pending_out;
+        frm_prll_ctxt->pending_out.pic_buf = NULL;
+    }
+    /* The previous output picture is no longer accessible */
+    svt_aom_dec_pic_mgr_release_ext_bufs(dec_handle_ptr, FALSE);
+
     while (data_start < data_end) {
         /*TODO : Remove or move. For Test purpose only */
         dec_handle_ptr->dec_cnt++;
@@ -569,11 +705,24 @@ EB_API EbErrorType svt_av1_dec_frame(EbComponentType *svt_dec_component, const u
         frame_size          = data_end - data_start;
         return_error        = svt_aom_decode_multiple_obu(dec_handle_ptr, &data_start, frame_size, is_annexb);
 
-        if (return_error != EB_ErrorNone)
-            assert(0);
+        /* The rest of the temporal unit cannot be decoded: drop the frame and stop */
+        if (return_error != EB_ErrorNone) {
+            svt_aom_dec_pic_mgr_update_ref_pic(dec_handle_ptr, 0, dec_handle_ptr->frame_header.refresh_frame_flags);
+            break;
+        }
+
+        /* Keep the shown frame alive until it is output */
+        if (frm_prll_ctxt != NULL && dec_handle_ptr->show_frame) {
+            DecOutPic *out_pic = &frm_prll_ctxt->pending_out;
+            svt_aom_dec_pic_mgr_release_pic(out_pic->pic_buf);
+            out_pic->pic_buf           = dec_handle_ptr->cur_pic_buf[0];
+            out_pic->width             = dec_handle_ptr->frame_header.frame_size.superres_upscaled_width;
+            out_pic->height            = dec_handle_ptr->frame_header.frame_size.frame_height;
+            out_pic->film_grain_params = dec_handle_ptr->cur_pic_buf[0]->film_grain_params;
+            svt_aom_dec_pic_mgr_hold_pic(out_pic->pic_buf);
+        }
 
-        svt_aom_dec_pic_mgr_update_ref_pic(
-            dec_handle_ptr, (EB_ErrorNone == return_error) ? 1 : 0, dec_handle_ptr->frame_header.refresh_frame_flags);
+        svt_aom_dec_pic_mgr_update_ref_pic(dec_handle_ptr, 1, dec_handle_ptr->frame_header.refresh_frame_flags);
 
         // Allow extra zero bytes after the frame end
         while (data < data_end) {
@@ -590,6 +739,9 @@ EB_API EbErrorType svt_av1_dec_frame(EbComponentType *svt_dec_component, const u
             dec_handle_ptr->frame_header.frame_type);*/
     }
 
+    if (frm_prll_ctxt != NULL)
+        frm_prll_ctxt->ready_out = prev_out;
+
     return return_error;
 }
 
@@ -602,13 +754,67 @@ EB_API EbErrorType svt_av1_dec_get_picture(EbComponentType *svt_dec_component, E
     if (svt_dec_component == NULL)
         return EB_ErrorBadParameter;
 
-    EbDecHandle *dec_handle_ptr = (EbDecHandle *)svt_dec_component->p_component_private;
-    /* Copy from recon pointer and return! TODO: Should remove the svt_memcpy! */
-    if (0 == svt_dec_out_buf(dec_handle_ptr, p_buffer))
+    EbDecHandle    *dec_handle_ptr = (EbDecHandle *)svt_dec_component->p_component_private;
+    DecFrmPrllCtxt *frm_prll_ctxt  = (DecFrmPrllCtxt *)dec_handle_ptr->pv_frm_prll_ctxt;
+
+    /* The picture stays ready for output until the application releases one */
+    if (dec_handle_ptr->dec_config.zero_copy_output && dec_handle_ptr->num_held_pics >= SVT_AV1_DEC_MAX_HELD_PICTURES)
+        return EB_ErrorInsufficientResources;
+
+    DecOutPic out_pic;
+    if (frm_prll_ctxt != NULL) {
+        if (frm_prll_ctxt->ready_out.pic_buf == NULL)
+            return EB_DecNoOutputPicture;
+        /* The reference to the picture moves to out_pic */
+        out_pic                          = frm_prll_ctxt->ready_out;
+        frm_prll_ctxt->ready_out.pic_buf = NULL;
+        svt_aom_dec_wait_pic_rows(out_pic.pic_buf, INT32_MAX);
+    } else {
+        /* TODO: Should add logic for show_existing_frame */
+        if (0 == dec_handle_ptr->show_frame) {
+            assert(0 == dec_handle_ptr->show_existing_frame);
+            return EB_DecNoOutputPicture;
+        }
+        out_pic.pic_buf           = dec_handle_ptr->cur_pic_buf[0];
+        out_pic.width             = dec_handle_ptr->frame_header.frame_size.superres_upscaled_width;
+        out_pic.height            = dec_handle_ptr->frame_header.frame_size.frame_height;
+        out_pic.film_grain_params = dec_handle_ptr->cur_pic_buf[0]->film_grain_params;
+        svt_aom_dec_pic_mgr_hold_pic(out_pic.pic_buf);
+    }
+
+    if (dec_handle_ptr->dec_config.zero_copy_output) {
+        /* The reference to the picture is handed over to the application */
+        return_error = dec_zero_copy_out_buf(dec_handle_ptr, &out_pic, (EbSvtIOFormat *)p_buffer->p_buffer);
+        if (return_error != EB_ErrorNone) {
+            svt_aom_dec_pic_mgr_release_pic(out_pic.pic_buf);
+            return return_error;
+        }
+        p_buffer->wrapper_ptr = out_pic.pic_buf;
+        dec_handle_ptr->num_held_pics++;
+        return EB_ErrorNone;
+    }
+
+    /* Copy from recon pointer and return! */
+    if (0 == svt_dec_out_buf(dec_handle_ptr, &out_pic, p_buffer))
         return_error = EB_DecNoOutputPicture;
+    svt_aom_dec_pic_mgr_release_pic(out_pic.pic_buf);
     return return_error;
 }
 
+EB_API EbErrorType svt_av1_dec_release_picture(EbComponentType *svt_dec_component, EbBufferHeaderType *p_buffer) {
+    if (svt_dec_component == NULL || p_buffer == NULL || p_buffer->wrapper_ptr == NULL)
+        return EB_ErrorBadParameter;
+
+    EbDecHandle *dec_handle_ptr = (EbDecHandle *)svt_dec_component->p_component_private;
+    if (!dec_handle_ptr->dec_config.zero_copy_output || dec_handle_ptr->num_held_pics == 0)
+        return EB_ErrorBadParameter;
+
+    svt_aom_dec_pic_mgr_release_pic((EbDecPicBuf *)p_buffer->wrapper_ptr);
+    dec_handle_ptr->num_held_pics--;
+    p_buffer->wrapper_ptr = NULL;
+    return EB_ErrorNone;
+}
+
 EB_API EbErrorType svt_av1_dec_deinit(EbComponentType *svt_dec_component) {
     if (svt_dec_component == NULL)
         return EB_ErrorBadParameter;
@@ -619,6 +825,12 @@ EB_API EbErrorType svt_av1_dec_deinit(EbComponentType *svt_dec_component) {
         return EB_ErrorNone;
     if (dec_handle_ptr->dec_config.threads > 1)
         dec_sync_all_threads(dec_handle_ptr);
+    if (dec_handle_ptr->pv_frm_prll_ctxt != NULL)
+        svt_aom_dec_frm_prll_deinit(dec_handle_ptr);
+    if (dec_handle_ptr->pv_fg_ctxt != NULL)
+        svt_aom_dec_fg_deinit(dec_handle_ptr);
+    svt_aom_dec_pic_mgr_release_ext_bufs(dec_handle_ptr, TRUE);
+    svt_aom_dec_pic_mgr_free_out_bufs(dec_handle_ptr);
     if (!svt_dec_memory_map)
         return EB_ErrorNone;
 
@@ -23,6 +23,7 @@ extern "C" {
 #include "EbCabacContextModel.h"
 #include "Av1Common.h"
 #include "EbThreads.h"
+#include "grainSynthesis.h"
 
 /* This value is set to 72 to make
    DEC_PAD_VALUE a multiple of 16. */
@@ -30,9 +31,9 @@ extern "C" {
 #define DEC_PAD_VALUE (DYNIMIC_PAD_VALUE + 8)
 
 /* Maximum number of frames in parallel */
-#define DEC_MAX_NUM_FRM_PRLL 1
+#define DEC_MAX_NUM_FRM_PRLL 2
 /** Maximum picture buffers needed **/
-#define MAX_PIC_BUFS (REF_FRAMES + 1 + DEC_MAX_NUM_FRM_PRLL)
+#define MAX_PIC_BUFS (REF_FRAMES + 1 + DEC_MAX_NUM_FRM_PRLL + SVT_AV1_DEC_MAX_HELD_PICTURES)
 
 /** Picture Structure **/
 typedef struct EbDecPicBuf {
@@ -80,8 +81,31 @@ typedef struct EbDecPicBuf {
     int8_t ref_deltas[REF_FRAMES];
     // 0 = ZERO_MV, MV
     int8_t mode_deltas[MAX_MODE_LF_DELTAS];
+
+    /* Picture planes from the external frame buffer allocator */
+    EbExtFrameBuf ext_frame_buf;
+
+    /* Zero copy output with film grain or 8-bit output of the
+       16-bit pipeline : decoder side output planes, freed with
+       svt_aom_dec_pic_mgr_free_out_bufs() */
+    uint8_t *out_buf;
+    size_t   out_buf_size;
+
+    /* Number of SB rows of this frame which are fully post-filtered
+       and padded, INT32_MAX once the whole frame is done.
+       Used only in frame parallel mode */
+    CondVar rows_done;
 } EbDecPicBuf;
 
+/* Picture queued for output in frame parallel mode */
+typedef struct DecOutPic {
+    EbDecPicBuf *pic_buf;
+    /*!< Output width (SuperRes upscaled) and height of the frame */
+    uint32_t     width;
+    uint32_t     height;
+    AomFilmGrain film_grain_params;
+} DecOutPic;
+
 /* Frame level buffers */
 typedef struct CurFrameBuf {
     SBInfo *sb_info;
@@ -189,6 +213,12 @@ typedef struct EbDecHandle {
     /** Pointer to Picture manager structure **/
     void *pv_pic_mgr;
 
+    /** Frame parallel context, NULL when num_frms_prll is 1 **/
+    void *pv_frm_prll_ctxt;
+
+    /** Film grain context, NULL when threads is 1 **/
+    void *pv_fg_ctxt;
+
     // * 'remapped_ref_idx[i - 1]' maps reference type 'i' (range: LAST_FRAME ...
     // EXTREF_FRAME) to a remapped index 'j' (in range: 0 ... REF_FRAMES - 1)
     // * Later, 'cm->ref_frame_map[j]' maps the remapped index 'j' to a pointer to
@@ -248,6 +278,9 @@ typedef struct EbDecHandle {
     // internal bit-depth: when equals 1 internal bit-depth is 16bits regardless of the input
     // bit-depth
     Bool is_16bit_pipeline;
+
+    /* Number of pictures held by the application in zero copy output mode */
+    uint32_t num_held_pics;
 } EbDecHandle;
 
 /* Thread level context data */
@@ -266,6 +299,60 @@ typedef struct DecThreadCtxt {
     uint8_t *dst;
 } DecThreadCtxt;
 
+/* Frame parallel context : the post-filter stage (LF, CDEF, SR, LR & pad)
+   of frame N runs in its own thread while frame N+1 is parsed & decoded */
+typedef struct DecFrmPrllCtxt {
+    EbHandle thread_handle;
+    EbHandle thread_semaphore;
+    /* 1 while the post-filter thread owns a frame */
+    CondVar busy;
+    Bool    end_flag;
+
+    /* Copy of the decoder handle state for the frame being post-filtered */
+    EbDecHandle pf_handle;
+
+    /* Frame level buffers not in use by the parse & decode stage */
+    FrameMiMap frame_mi_map;
+    void      *pv_lf_ctxt;
+    void      *pv_lr_ctxt;
+
+    /* Shown frame of the current temporal unit */
+    DecOutPic pending_out;
+    /* Shown frame of the previous temporal unit, returned by get_picture */
+    DecOutPic ready_out;
+} DecFrmPrllCtxt;
+
+/* Film grain helper thread context */
+typedef struct DecFgThrdCtxt {
+    struct DecFgCtxt *fg_ctxt;
+    EbHandle          thread_handle;
+    EbHandle          thread_semaphore;
+    /* Band of block rows grained by the thread */
+    int32_t band;
+} DecFgThrdCtxt;
+
+/* Film grain context : the grain of an output picture is added by bands of
+   block rows, the calling thread taking the first band and threads - 1 helper
+   threads the others */
+typedef struct DecFgCtxt {
+    DecFgThrdCtxt *thrd_ctxt_pa;
+    uint32_t       num_thrds;
+    EbHandle       done_semaphore;
+    Bool           end_flag;
+
+    /* Picture being grained */
+    const FilmGrainSynth *synth;
+    uint8_t              *luma;
+    uint8_t              *cb;
+    uint8_t              *cr;
+    int32_t               height;
+    int32_t               width;
+    int32_t               luma_stride;
+    int32_t               chroma_stride;
+    int32_t               use_high_bit_depth;
+    int32_t               num_bands;
+} DecFgCtxt;
+
 #ifdef __cplusplus
 }
 #endif
@@ -751,6 +751,19 @@ static void av1_build_interintra_predictors(DecModCtxt *dec_mod_ctxt, PartitionI
     }
 }
 
+static void dec_wait_ref_rows(EbDecHandle *dec_hdl, PartitionInfo *part_info, EbDecPicBuf *ref_buf, int32_t ref,
+                              int32_t pre_y, int32_t bh, int32_t ss_y, int32_t do_warp) {
+    int32_t num_rows = INT32_MAX;
+    if (!do_warp && !av1_is_scaled(part_info->block_ref_sf[ref])) {
+        /* Bottom most luma row read, including the interpolation taps */
+        const MV mv    = part_info->mi->mv[ref].as_mv;
+        int32_t  y_max = ((pre_y + bh + AOM_INTERP_EXTEND) << ss_y) + (mv.row >> 3) + 1;
+        if (y_max < ref_buf->frame_height)
+            num_rows = AOMMAX(1, (y_max >> dec_hdl->seq_header.sb_size_log2) + 1);
+    }
+    svt_aom_dec_wait_pic_rows(ref_buf, num_rows);
+}
+
 void svt_aom_svtav1_predict_inter_block_plane(DecModCtxt *dec_mod_ctx, EbDecHandle *dec_hdl, PartitionInfo *part_info,
                                               int32_t plane, int32_t build_for_obmc, int32_t mi_x, int32_t mi_y,
                                               void *dst, int32_t dst_stride, int32_t some_use_intra,
@@ -843,6 +856,11 @@ void svt_aom_svtav1_predict_inter_block_plane(DecModCtxt *dec_mod_ctx, EbDecHand
                            (((mode == GLOBALMV || mode == GLOBAL_GLOBALMV) && (wm_global->wmtype > TRANSLATION)) ||
                             (mi->motion_mode == WARPED_CAUSAL)));
 
+        /* In frame parallel mode the reference can still be under
+           post-filtering, wait for the SB rows the prediction reads */
+        if (dec_hdl->pv_frm_prll_ctxt != NULL && !is_intrabc)
+            dec_wait_ref_rows(dec_hdl, part_info, ref_buf, ref, pre_y, bh, ss_y, do_warp);
+
         void   *src;
         int32_t src_stride;
 
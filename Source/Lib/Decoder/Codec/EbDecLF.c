@@ -658,7 +658,8 @@ void svt_aom_dec_loop_filter_row(EbDecHandle *dec_handle_ptr, EbPictureBufferDes
     uint32_t      sb_origin_y     = y_sb_index << sb_size_log2;
 
     volatile int32_t *sb_lf_completed_in_prev_row = NULL;
-    DecMtlfFrameInfo *lf_frame_info = &dec_handle_ptr->main_frame_buf.cur_frame_bufs[0].dec_mt_frame_data.lf_frame_info;
+    DecMtFrameData   *dec_mt_frame_data = &dec_handle_ptr->main_frame_buf.cur_frame_bufs[0].dec_mt_frame_data;
+    DecMtlfFrameInfo *lf_frame_info     = &dec_mt_frame_data->lf_frame_info;
     if (y_sb_index) {
         sb_lf_completed_in_prev_row = (volatile int32_t *)&lf_frame_info->sb_lf_completed_in_row[y_sb_index - 1];
     }
@@ -672,8 +673,8 @@ void svt_aom_dec_loop_filter_row(EbDecHandle *dec_handle_ptr, EbPictureBufferDes
 
         /* Top-Right Sync*/
         if (y_sb_index) {
-            while (*sb_lf_completed_in_prev_row < MIN((x_sb_index + 2), pic_width_in_sb - 1))
-                ;
+            DEC_WAIT_PROGRESS(&dec_mt_frame_data->lf_progress,
+                              *sb_lf_completed_in_prev_row >= MIN((x_sb_index + 2), pic_width_in_sb - 1));
         }
         /*LF function for a SB*/
         dec_loop_filter_sb(dec_handle_ptr,
@@ -690,28 +691,17 @@ void svt_aom_dec_loop_filter_row(EbDecHandle *dec_handle_ptr, EbPictureBufferDes
                            sb_info->sb_delta_lf);
         /* Update Top-Right Sync*/
         *sb_lf_completed_in_row = x_sb_index;
+        svt_add_cond_var(&dec_mt_frame_data->lf_progress, 1);
     }
 }
 
-/*Frame level function to trigger loop filter for each superblock*/
-void svt_aom_dec_av1_loop_filter_frame(EbDecHandle *dec_handle_ptr, EbPictureBufferDesc *recon_picture_buf,
-                                       LfCtxt *lf_ctxt, int32_t plane_start, int32_t plane_end, int32_t is_mt,
-                                       int enable_flag) {
-    if (!enable_flag)
-        return;
-
-    FrameHeader *frm_hdr      = &dec_handle_ptr->frame_header;
-    SeqHeader   *seq_header   = &dec_handle_ptr->seq_header;
-    uint8_t      sb_size_log2 = seq_header->sb_size_log2;
-
+/*Frame level init of the loop filter params, done before filtering any SB row*/
+void svt_aom_dec_av1_loop_filter_frame_init(EbDecHandle *dec_handle_ptr, LfCtxt *lf_ctxt, int32_t plane_start,
+                                            int32_t plane_end) {
+    FrameHeader     *frm_hdr = &dec_handle_ptr->frame_header;
     LoopFilterInfoN *lf_info = &lf_ctxt->lf_info;
     lf_ctxt->delta_lf_stride = dec_handle_ptr->main_frame_buf.sb_cols * FRAME_LF_COUNT;
 
-    int32_t  sb_size_w            = block_size_wide[seq_header->sb_size];
-    int32_t  sb_size_h            = block_size_high[seq_header->sb_size];
-    uint32_t pic_width_in_sb      = (frm_hdr->frame_size.frame_width + sb_size_w - 1) / sb_size_w;
-    uint32_t picture_height_in_sb = (frm_hdr->frame_size.frame_height + sb_size_h - 1) / sb_size_h;
-
     frm_hdr->loop_filter_params.combine_vert_horz_lf = 1;
     /*init hev threshold const vectors*/
     for (int lvl = 0; lvl <= MAX_LOOP_FILTER; lvl++) memset(lf_info->lfthr[lvl].hev_thr, (lvl >> 4), SIMD_WIDTH);
@@ -720,6 +710,57 @@ void svt_aom_dec_av1_loop_filter_frame(EbDecHandle *dec_handle_ptr, EbPictureBuf
 
     svt_aom_set_lbd_lf_filter_tap_functions();
     svt_aom_set_hbd_lf_filter_tap_functions();
+}
+
+/*Single thread LF of one SB row, rows have to be filtered in raster order*/
+void svt_aom_dec_av1_loop_filter_sb_row(EbDecHandle *dec_handle_ptr, EbPictureBufferDesc *recon_picture_buf,
+                                        LfCtxt *lf_ctxt, uint32_t y_sb_index, int32_t plane_start,
+                                        int32_t plane_end) {
+    FrameHeader  *frm_hdr         = &dec_handle_ptr->frame_header;
+    SeqHeader    *seq_header      = &dec_handle_ptr->seq_header;
+    uint8_t       sb_size_log2    = seq_header->sb_size_log2;
+    int32_t       sb_size_w       = block_size_wide[seq_header->sb_size];
+    uint32_t      pic_width_in_sb = (frm_hdr->frame_size.frame_width + sb_size_w - 1) / sb_size_w;
+    MainFrameBuf *main_frame_buf  = &dec_handle_ptr->main_frame_buf;
+    CurFrameBuf  *frame_buf       = &main_frame_buf->cur_frame_bufs[0];
+
+    for (uint32_t x_sb_index = 0; x_sb_index < pic_width_in_sb; ++x_sb_index) {
+        uint32_t sb_origin_x     = x_sb_index << sb_size_log2;
+        uint32_t sb_origin_y     = y_sb_index << sb_size_log2;
+        Bool     end_of_row_flag = x_sb_index == pic_width_in_sb - 1;
+
+        SBInfo *sb_info = frame_buf->sb_info + (((y_sb_index * main_frame_buf->sb_cols) + x_sb_index));
+
+        /*LF function for a SB*/
+        dec_loop_filter_sb(dec_handle_ptr,
+                           sb_info,
+                           frm_hdr,
+                           seq_header,
+                           recon_picture_buf,
+                           lf_ctxt,
+                           sb_origin_y >> 2,
+                           sb_origin_x >> 2,
+                           plane_start,
+                           plane_end,
+                           end_of_row_flag,
+                           sb_info->sb_delta_lf);
+    }
+}
+
+/*Frame level function to trigger loop filter for each superblock*/
+void svt_aom_dec_av1_loop_filter_frame(EbDecHandle *dec_handle_ptr, EbPictureBufferDesc *recon_picture_buf,
+                                       LfCtxt *lf_ctxt, int32_t plane_start, int32_t plane_end, int32_t is_mt,
+                                       int enable_flag) {
+    if (!enable_flag)
+        return;
+
+    FrameHeader *frm_hdr    = &dec_handle_ptr->frame_header;
+    SeqHeader   *seq_header = &dec_handle_ptr->seq_header;
+
+    int32_t  sb_size_h            = block_size_high[seq_header->sb_size];
+    uint32_t picture_height_in_sb = (frm_hdr->frame_size.frame_height + sb_size_h - 1) / sb_size_h;
+
+    svt_aom_dec_av1_loop_filter_frame_init(dec_handle_ptr, lf_ctxt, plane_start, plane_end);
 
     if (is_mt) {
         for (uint32_t y_sb_index = 0; y_sb_index < picture_height_in_sb; ++y_sb_index) {
@@ -728,33 +769,8 @@ void svt_aom_dec_av1_loop_filter_frame(EbDecHandle *dec_handle_ptr, EbPictureBuf
     } else {
         /*Loop over a frame : tregger dec_loop_filter_sb for each SB*/
         for (uint32_t y_sb_index = 0; y_sb_index < picture_height_in_sb; ++y_sb_index) {
-            for (uint32_t x_sb_index = 0; x_sb_index < pic_width_in_sb; ++x_sb_index) {
-                uint32_t sb_origin_x     = x_sb_index << sb_size_log2;
-                uint32_t sb_origin_y     = y_sb_index << sb_size_log2;
-                Bool     end_of_row_flag = x_sb_index == pic_width_in_sb - 1;
-
-                MainFrameBuf *main_frame_buf = &dec_handle_ptr->main_frame_buf;
-                CurFrameBuf  *frame_buf      = &main_frame_buf->cur_frame_bufs[0];
-
-                SBInfo *sb_info = frame_buf->sb_info + (((y_sb_index * main_frame_buf->sb_cols) + x_sb_index));
-
-                /*sb_info->sb_delta_lf = frame_buf->delta_lf + (FRAME_LF_COUNT *
-                    ((y_sb_index * main_frame_buf->sb_cols) + x_sb_index));*/
-
-                /*LF function for a SB*/
-                dec_loop_filter_sb(dec_handle_ptr,
-                                   sb_info,
-                                   frm_hdr,
-                                   seq_header,
-                                   recon_picture_buf,
-                                   lf_ctxt,
-                                   sb_origin_y >> 2,
-                                   sb_origin_x >> 2,
-                                   plane_start,
-                                   plane_end,
-                                   end_of_row_flag,
-                                   sb_info->sb_delta_lf);
-            }
+            svt_aom_dec_av1_loop_filter_sb_row(
+                dec_handle_ptr, recon_picture_buf, lf_ctxt, y_sb_index, plane_start, plane_end);
         }
     }
 }
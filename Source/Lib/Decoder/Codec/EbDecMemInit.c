@@ -36,6 +36,8 @@
 
 #include "EbUtility.h"
 
+void svt_aom_dec_frm_prll_sync(EbDecHandle *dec_handle_ptr);
+
 /*TODO: Remove and harmonize with encoder. Globals prevent harmonization now! */
 /*****************************************
  * svt_recon_picture_buffer_desc_ctor
@@ -124,6 +126,25 @@ EbErrorType svt_aom_dec_eb_recon_picture_buffer_desc_ctor(
     return EB_ErrorNone;
 }
 
+static EbErrorType init_frame_mi_map(FrameMiMap *frame_mi_map,
+    int32_t sb_cols, int32_t sb_rows, int32_t sb_size_log2)
+{
+    frame_mi_map->sb_cols = sb_cols;
+    frame_mi_map->sb_rows = sb_rows;
+    frame_mi_map->mi_cols_algnsb = sb_cols * (1 << (sb_size_log2 - MI_SIZE_LOG2));
+    frame_mi_map->mi_rows_algnsb = sb_rows * (1 << (sb_size_log2 - MI_SIZE_LOG2));
+    /* SBInfo pointers for entire frame */
+    EB_MALLOC_DEC(SBInfo**, frame_mi_map->pps_sb_info,
+        sb_rows * sb_cols * sizeof(SBInfo *));
+    /* ModeInfo offset wrt it's SB start for entire frame at 4x4 lvl */
+    EB_MALLOC_DEC(uint16_t*, frame_mi_map->p_mi_offset, frame_mi_map->
+    mi_rows_algnsb * frame_mi_map->mi_cols_algnsb * sizeof(uint16_t));
+    frame_mi_map->sb_size_log2 = sb_size_log2;
+    frame_mi_map->num_mis_in_sb_wd = (1 << (sb_size_log2 - MI_SIZE_LOG2));
+
+    return EB_ErrorNone;
+}
+
 /**********************************
 * Main Frame Buffer containing all frame level bufs like ModeInfo
 for all the frames in parallel
@@ -291,24 +312,24 @@ static EbErrorType init_main_frame_ctxt(EbDecHandle  *dec_handle_ptr) {
         for (int32_t plane = 0; plane <= AOM_PLANE_V; plane++) {
             EB_MALLOC_DEC(RestorationUnitInfo *, cur_frame_buf->lr_unit[plane],
                 (num_sb * sizeof(RestorationUnitInfo)));
-            lr_ctxt->lr_unit[plane] = cur_frame_buf->lr_unit[plane];
-            lr_ctxt->lr_stride[plane] = sb_cols;
+            /* In frame parallel mode the LR ctxt of the other frame
+               is pointed to its lr_unit when the frame is handed over */
+            if (i == 0) {
+                lr_ctxt->lr_unit[plane] = cur_frame_buf->lr_unit[plane];
+                lr_ctxt->lr_stride[plane] = sb_cols;
+            }
         }
     }
-    FrameMiMap *frame_mi_map = &main_frame_buf->frame_mi_map;
-    frame_mi_map->sb_cols = sb_cols;
-    frame_mi_map->sb_rows = sb_rows;
-    frame_mi_map->mi_cols_algnsb = sb_cols * (1 << (sb_size_log2 - MI_SIZE_LOG2));
-    frame_mi_map->mi_rows_algnsb = sb_rows * (1 << (sb_size_log2 - MI_SIZE_LOG2));
-    /* SBInfo pointers for entire frame */
-    EB_MALLOC_DEC(SBInfo**, frame_mi_map->pps_sb_info,
-        sb_rows * sb_cols * sizeof(SBInfo *));
-    /* ModeInfo offset wrt it's SB start for entire frame at 4x4 lvl */
-    EB_MALLOC_DEC(uint16_t*, frame_mi_map->p_mi_offset, frame_mi_map->
-    mi_rows_algnsb * frame_mi_map->mi_cols_algnsb * sizeof(uint16_t));
-    frame_mi_map->sb_size_log2 = sb_size_log2;
-    frame_mi_map->num_mis_in_sb_wd = (1 << (sb_size_log2 - MI_SIZE_LOG2));
-
+    return_error |= init_frame_mi_map(&main_frame_buf->frame_mi_map,
+        sb_cols, sb_rows, sb_size_log2);
+
+    /* Spare FrameMiMap for the frame under post-filtering */
+    DecFrmPrllCtxt *frm_prll_ctxt =
+        (DecFrmPrllCtxt *)dec_handle_ptr->pv_frm_prll_ctxt;
+    if (frm_prll_ctxt != NULL) {
+        return_error |= init_frame_mi_map(&frm_prll_ctxt->frame_mi_map,
+            sb_cols, sb_rows, sb_size_log2);
+    }
 
     main_frame_buf->tpl_mvs = NULL;
     main_frame_buf->tpl_mvs_size = 0;
@@ -492,12 +513,37 @@ static EbErrorType init_lr_ctxt(EbDecHandle  *dec_handle_ptr)
     return return_error;
 }
 
+/* Second set of LF & LR ctxts, for the frame under post-filtering
+   in frame parallel mode */
+static EbErrorType init_frm_prll_ctxt(EbDecHandle  *dec_handle_ptr) {
+    EbErrorType return_error = EB_ErrorNone;
+    DecFrmPrllCtxt *frm_prll_ctxt =
+        (DecFrmPrllCtxt *)dec_handle_ptr->pv_frm_prll_ctxt;
+    void *pv_lf_ctxt = dec_handle_ptr->pv_lf_ctxt;
+    void *pv_lr_ctxt = dec_handle_ptr->pv_lr_ctxt;
+
+    return_error |= init_lf_ctxt(dec_handle_ptr);
+
+    return_error |= init_lr_ctxt(dec_handle_ptr);
+
+    frm_prll_ctxt->pv_lf_ctxt = dec_handle_ptr->pv_lf_ctxt;
+    frm_prll_ctxt->pv_lr_ctxt = dec_handle_ptr->pv_lr_ctxt;
+    dec_handle_ptr->pv_lf_ctxt = pv_lf_ctxt;
+    dec_handle_ptr->pv_lr_ctxt = pv_lr_ctxt;
+
+    return return_error;
+}
+
 EbErrorType svt_aom_dec_mem_init(EbDecHandle  *dec_handle_ptr) {
     EbErrorType return_error = EB_ErrorNone;
 
     if (0 == dec_handle_ptr->seq_header_done)
         return EB_ErrorNone;
 
+    /* Previous frame can still be under post-filtering */
+    if (dec_handle_ptr->pv_frm_prll_ctxt != NULL)
+        svt_aom_dec_frm_prll_sync(dec_handle_ptr);
+
     /* init module ctxts */
     return_error |= svt_aom_dec_pic_mgr_init(dec_handle_ptr);
 
@@ -510,6 +556,9 @@ EbErrorType svt_aom_dec_mem_init(EbDecHandle  *dec_handle_ptr) {
 
     return_error |= init_lr_ctxt(dec_handle_ptr);
 
+    if (dec_handle_ptr->pv_frm_prll_ctxt != NULL)
+        return_error |= init_frm_prll_ctxt(dec_handle_ptr);
+
     /* init frame buffers */
     return_error |= init_main_frame_ctxt(dec_handle_ptr);
 
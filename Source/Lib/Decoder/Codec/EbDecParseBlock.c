@@ -904,28 +904,18 @@ static void motion_field_projections_row(EbDecHandle *dec_handle, int sb_row, co
 void svt_setup_motion_field(EbDecHandle *dec_handle, DecThreadCtxt *thread_ctxt) {
     DecMtFrameData *dec_mt_frame_data = &dec_handle->main_frame_buf.cur_frame_bufs[0].dec_mt_frame_data;
     Bool            is_mt             = dec_handle->dec_config.threads > 1;
-    Bool            do_memset         = TRUE;
+    /* ref_frame_side is set up by the main thread, ahead of its parse, the
+       worker threads only share the projection rows */
+    Bool is_main = thread_ctxt == NULL;
 
     if (is_mt) {
         volatile Bool *start_motion_proj = &dec_mt_frame_data->start_motion_proj;
 
         while (*start_motion_proj != TRUE)
             svt_block_on_semaphore(NULL == thread_ctxt ? dec_handle->thread_semaphore : thread_ctxt->thread_semaphore);
-
-        DecMtMotionProjInfo *motion_proj_info = &dec_mt_frame_data->motion_proj_info;
-        do_memset                             = FALSE;
-        //lock mutex
-        svt_block_on_mutex(motion_proj_info->motion_proj_mutex);
-        //Check memset needed
-        if (motion_proj_info->motion_proj_init_done == FALSE) {
-            do_memset                               = TRUE;
-            motion_proj_info->motion_proj_init_done = TRUE;
-        }
-        //unlock mutex
-        svt_release_mutex(motion_proj_info->motion_proj_mutex);
     }
 
-    if (do_memset) {
+    if (is_main) {
         memset(dec_handle->main_frame_buf.ref_frame_side, 0, sizeof(dec_handle->main_frame_buf.ref_frame_side));
     }
 
@@ -953,6 +943,8 @@ void svt_setup_motion_field(EbDecHandle *dec_handle, DecThreadCtxt *thread_ctxt)
         ref_buf[ref_idx]        = buf;
         ref_order_hint[ref_idx] = order_hint;
 
+        if (!is_main)
+            continue;
         if (get_relative_dist(order_hint_info, order_hint, cur_order_hint) > 0)
             dec_handle->main_frame_buf.ref_frame_side[ref_frame] = 1;
         else if (order_hint == cur_order_hint)
@@ -961,8 +953,7 @@ void svt_setup_motion_field(EbDecHandle *dec_handle, DecThreadCtxt *thread_ctxt)
     if (!no_proj_flag) {
         //branch of point for MT
         if (is_mt) {
-            DecMtMotionProjInfo *motion_proj_info =
-                &dec_handle->main_frame_buf.cur_frame_bufs[0].dec_mt_frame_data.motion_proj_info;
+            DecMtMotionProjInfo *motion_proj_info = &dec_mt_frame_data->motion_proj_info;
 
             while (1) {
                 int32_t proj_row = -1;
@@ -979,14 +970,15 @@ void svt_setup_motion_field(EbDecHandle *dec_handle, DecThreadCtxt *thread_ctxt)
                 //unlock mutex
                 svt_release_mutex(motion_proj_info->motion_proj_mutex);
 
-                //wait for parse
-                if (-1 != proj_row)
-                    motion_field_projections_row(dec_handle, proj_row, ref_buf, ref_order_hint);
-
                 /*if all sb rows have been picked up for processing then break the while loop */
-                if (motion_proj_info->motion_proj_row_to_process == motion_proj_info->num_motion_proj_rows) {
+                if (-1 == proj_row)
                     break;
-                }
+
+                motion_field_projections_row(dec_handle, proj_row, ref_buf, ref_order_hint);
+
+                /* Update motion projection done map, for the parse */
+                motion_proj_info->motion_proj_row_map[proj_row] = 1;
+                svt_add_cond_var(&dec_mt_frame_data->motion_proj_progress, 1);
             }
         } else {
             const int mvs_rows    = (dec_handle->frame_header.mi_rows + 1) >> 1; //8x8 unit level
@@ -995,18 +987,23 @@ void svt_setup_motion_field(EbDecHandle *dec_handle, DecThreadCtxt *thread_ctxt)
                 motion_field_projections_row(dec_handle, sb_row, ref_buf, ref_order_hint);
         }
     }
+}
 
-    if (is_mt) {
-        svt_block_on_mutex(dec_mt_frame_data->temp_mutex);
-        dec_mt_frame_data->num_threads_header++;
-        if (dec_handle->dec_config.threads == dec_mt_frame_data->num_threads_header) {
-            dec_mt_frame_data->start_motion_proj = FALSE;
-        }
-        svt_release_mutex(dec_mt_frame_data->temp_mutex);
+/* Blocks the parse of the SB row at mi_row until the projection of the
+   64x64 rows it covers is over */
+void svt_wait_motion_field_rows(EbDecHandle *dec_handle, uint32_t mi_row) {
+    DecMtFrameData      *dec_mt_frame_data = &dec_handle->main_frame_buf.cur_frame_bufs[0].dec_mt_frame_data;
+    DecMtMotionProjInfo *motion_proj_info  = &dec_mt_frame_data->motion_proj_info;
+
+    if (!dec_handle->frame_header.use_ref_frame_mvs)
+        return;
 
-        volatile uint32_t *num_threads_header = &dec_mt_frame_data->num_threads_header;
-        while (*num_threads_header != dec_handle->dec_config.threads && (FALSE == dec_mt_frame_data->end_flag))
-            ;
+    const int32_t first_row = mi_row / MI_SIZE_64X64;
+    const int32_t end_row   = AOMMIN((int32_t)((mi_row + dec_handle->seq_header.sb_mi_size) / MI_SIZE_64X64),
+                                   motion_proj_info->num_motion_proj_rows);
+    for (int32_t row = first_row; row < end_row; row++) {
+        volatile uint32_t *row_done = &motion_proj_info->motion_proj_row_map[row];
+        DEC_WAIT_PROGRESS(&dec_mt_frame_data->motion_proj_progress, *row_done);
     }
 }
 
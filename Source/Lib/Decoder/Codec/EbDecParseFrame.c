@@ -26,6 +26,7 @@
 
 #include "EbDecParseFrame.h"
 #include "EbDecParseHelper.h"
+#include "EbObuParse.h"
 
 /* Inititalizes prms for current tile from main TilesInfo ! */
 void svt_tile_init(TileInfo *cur_tile_info, FrameHeader *frame_header, int32_t tile_row, int32_t tile_col) {
@@ -183,6 +184,10 @@ EbErrorType parse_tile(EbDecHandle *dec_handle_ptr, ParseCtxt *parse_ctx, TilesI
 
         clear_left_context(parse_ctx);
 
+        /* The temporal MVs of the row are projected by all the threads */
+        if (is_mt)
+            svt_wait_motion_field_rows(dec_handle_ptr, mi_row);
+
         /*TODO: Move CFL to thread ctxt! We need to access DecModCtxt
           from parse_tile function . Add tile level cfl init. */
         if (!is_mt) {
@@ -277,6 +282,7 @@ EbErrorType parse_tile(EbDecHandle *dec_handle_ptr, ParseCtxt *parse_ctx, TilesI
             assert(sb_row >= sb_row_tile_start);
             dec_mt_frame_data->parse_recon_tile_info_array[tile_num].sb_recon_row_parsed[sb_row - sb_row_tile_start] =
                 1;
+            svt_add_cond_var(&dec_mt_frame_data->parse_progress, 1);
         }
     }
 
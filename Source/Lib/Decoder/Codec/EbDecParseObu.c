@@ -56,6 +56,8 @@ void svt_cdef_frame_mt(EbDecHandle *dec_handle_ptr, DecThreadCtxt *thread_ctxt);
 void svt_av1_queue_lr_jobs(EbDecHandle *dec_handle_ptr);
 void svt_aom_dec_av1_loop_restoration_filter_frame_mt(EbDecHandle *dec_handle, DecThreadCtxt *thread_ctxt);
 
+void svt_aom_dec_frm_prll_post_filter(EbDecHandle *dec_handle_ptr);
+
 #define CONFIG_MAX_DECODE_PROFILE 2
 
 void dec_init_intra_predictors_12b_internal(void);
@@ -1955,6 +1957,8 @@ void read_uncompressed_header(Bitstrm *bs, EbDecHandle *dec_handle_ptr, ObuHeade
         dec_handle_ptr->dec_config.max_color_format = EB_YUV444;
 
     dec_handle_ptr->cur_pic_buf[0] = svt_aom_dec_pic_mgr_get_cur_pic(dec_handle_ptr);
+    if (dec_handle_ptr->cur_pic_buf[0] == NULL)
+        return; // EB_ErrorInsufficientResources, checked by read_frame_header_obu
 
     svt_setup_frame_buf_refs(dec_handle_ptr);
     /*Temporal MVs allocation */
@@ -2083,6 +2087,9 @@ static EbErrorType read_frame_header_obu(Bitstrm *bs, EbDecHandle *dec_handle_pt
 
     start_position = svt_aom_get_position(bs);
     read_uncompressed_header(bs, dec_handle_ptr, obu_header, num_planes);
+    /* No free picture buffer, or no frame buffer from the application */
+    if (dec_handle_ptr->cur_pic_buf[0] == NULL)
+        return EB_ErrorInsufficientResources;
 
     if (allow_intrabc(dec_handle_ptr)) {
         svt_av1_setup_scale_factors_for_frame(&dec_handle_ptr->sf_identity,
@@ -2224,8 +2231,7 @@ static EbErrorType read_tile_group_obu(Bitstrm *bs, EbDecHandle *dec_handle_ptr,
         const int sb_mvs_rows = (mvs_rows + 7) >> 3; //64x64 unit level
         dec_mt_frame_data->motion_proj_info.num_motion_proj_rows       = sb_mvs_rows;
         dec_mt_frame_data->motion_proj_info.motion_proj_row_to_process = 0;
-        dec_mt_frame_data->motion_proj_info.motion_proj_init_done      = FALSE;
-        dec_mt_frame_data->num_threads_header                          = 0;
+        memset(dec_mt_frame_data->motion_proj_info.motion_proj_row_map, 0, sb_mvs_rows * sizeof(uint32_t));
 
         svt_block_on_mutex(dec_mt_frame_data->temp_mutex);
         dec_mt_frame_data->start_motion_proj = TRUE;
@@ -2240,10 +2246,6 @@ static EbErrorType read_tile_group_obu(Bitstrm *bs, EbDecHandle *dec_handle_ptr,
 
         svt_block_on_mutex(dec_mt_frame_data->temp_mutex);
         dec_mt_frame_data->start_parse_frame = TRUE;
-
-        dec_mt_frame_data->num_threads_cdefed = 0;
-        dec_mt_frame_data->num_threads_lred   = 0;
-
         svt_release_mutex(dec_mt_frame_data->temp_mutex);
         svt_post_semaphore(dec_handle_ptr->thread_semaphore);
         for (uint32_t lib_thrd = 0; lib_thrd < num_threads - 1; lib_thrd++)
@@ -2262,10 +2264,16 @@ static EbErrorType read_tile_group_obu(Bitstrm *bs, EbDecHandle *dec_handle_ptr,
         svt_post_semaphore(dec_handle_ptr->thread_semaphore);
         for (uint32_t lib_thrd = 0; lib_thrd < num_threads - 1; lib_thrd++)
             svt_post_semaphore(dec_handle_ptr->thread_ctxt_pa[lib_thrd].thread_semaphore);
-        svt_release_mutex(dec_mt_frame_data->temp_mutex);
-
-        if (!do_upscale)
+        /* Without upscaling each LR row only waits for its CDEF row, so the
+           threads done with CDEF move on to LR instead of the whole frame */
+        if (!do_upscale) {
             svt_av1_queue_lr_jobs(dec_handle_ptr);
+            dec_mt_frame_data->start_lr_frame = TRUE;
+            svt_post_semaphore(dec_handle_ptr->thread_semaphore);
+            for (uint32_t lib_thrd = 0; lib_thrd < num_threads - 1; lib_thrd++)
+                svt_post_semaphore(dec_handle_ptr->thread_ctxt_pa[lib_thrd].thread_semaphore);
+        }
+        svt_release_mutex(dec_mt_frame_data->temp_mutex);
 
         svt_aom_parse_frame_tiles(dec_handle_ptr, 0);
 
@@ -2300,6 +2308,16 @@ static EbErrorType read_tile_group_obu(Bitstrm *bs, EbDecHandle *dec_handle_ptr,
     if ((tg_end + 1) != num_tiles)
         return 0;
 
+    /* Frame parallel : post-filters run in their own thread */
+    if (dec_handle_ptr->pv_frm_prll_ctxt != NULL) {
+        assert(!is_mt);
+        /* Save CDF */
+        if (frame_header->disable_frame_end_update_cdf)
+            dec_handle_ptr->cur_pic_buf[0]->final_frm_ctx = main_parse_ctxt->init_frm_ctx;
+        svt_aom_dec_frm_prll_post_filter(dec_handle_ptr);
+        return status;
+    }
+
     if (is_mt) {
         svt_aom_dec_av1_loop_filter_frame_mt(dec_handle_ptr,
                                              dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf,
@@ -2338,12 +2356,13 @@ static EbErrorType read_tile_group_obu(Bitstrm *bs, EbDecHandle *dec_handle_ptr,
         svt_aom_dec_av1_loop_restoration_save_boundary_lines(dec_handle_ptr, 1);
 
     if (is_mt) {
-        if (do_upscale)
+        if (do_upscale) {
             svt_av1_queue_lr_jobs(dec_handle_ptr);
-        dec_handle_ptr->main_frame_buf.cur_frame_bufs[0].dec_mt_frame_data.start_lr_frame = TRUE;
-        svt_post_semaphore(dec_handle_ptr->thread_semaphore);
-        for (uint32_t lib_thrd = 0; lib_thrd < num_threads - 1; lib_thrd++)
-            svt_post_semaphore(dec_handle_ptr->thread_ctxt_pa[lib_thrd].thread_semaphore);
+            dec_handle_ptr->main_frame_buf.cur_frame_bufs[0].dec_mt_frame_data.start_lr_frame = TRUE;
+            svt_post_semaphore(dec_handle_ptr->thread_semaphore);
+            for (uint32_t lib_thrd = 0; lib_thrd < num_threads - 1; lib_thrd++)
+                svt_post_semaphore(dec_handle_ptr->thread_ctxt_pa[lib_thrd].thread_semaphore);
+        }
         svt_aom_dec_av1_loop_restoration_filter_frame_mt(dec_handle_ptr, NULL);
     } else
         svt_aom_dec_av1_loop_restoration_filter_frame(dec_handle_ptr, 0, /*opt_lr*/ do_lr);
@@ -2463,6 +2482,8 @@ EbErrorType svt_aom_decode_multiple_obu(EbDecHandle *dec_handle_ptr, uint8_t **d
             if (!dec_handle_ptr->seen_frame_header) {
                 dec_handle_ptr->seen_frame_header = 1;
                 status = read_frame_header_obu(&bs, dec_handle_ptr, &obu_header, obu_header.obu_type != OBU_FRAME);
+                if (status != EB_ErrorNone)
+                    return status;
             }
             /*else {
                  For OBU_REDUNDANT_FRAME_HEADER, previous frame_header is taken from dec_handle_ptr->frame_header
@@ -27,6 +27,7 @@
 #include "EbDecUtils.h"
 
 #include "EbDecPicMgr.h"
+#include "EbLog.h"
 
 #define NUM_REF_FRAMES 8 // TODO: remove (reuse EbObuParse.h macro)
 
@@ -68,6 +69,11 @@ EbErrorType svt_aom_dec_pic_mgr_init(EbDecHandle *dec_handle_ptr) {
         ps_pic_mgr->as_dec_pic[i].size       = 0;
         ps_pic_mgr->as_dec_pic[i].ref_count  = 0;
         ps_pic_mgr->as_dec_pic[i].mvs        = NULL;
+        memset(&ps_pic_mgr->as_dec_pic[i].ext_frame_buf, 0, sizeof(EbExtFrameBuf));
+        ps_pic_mgr->as_dec_pic[i].out_buf      = NULL;
+        ps_pic_mgr->as_dec_pic[i].out_buf_size = 0;
+        svt_create_cond_var(&ps_pic_mgr->as_dec_pic[i].rows_done);
+        ps_pic_mgr->as_dec_pic[i].rows_done.val = INT32_MAX;
         EB_MALLOC_DEC(uint8_t *, ps_pic_mgr->as_dec_pic[i].segment_maps, size * sizeof(uint8_t));
         memset(ps_pic_mgr->as_dec_pic[i].segment_maps, 0, size);
     }
@@ -87,6 +93,46 @@ static INLINE EbErrorType mvs_8x8_memory_alloc(TemporalMvRef **mvs, FrameHeader
     return EB_ErrorNone;
 }
 
+/* Gives the picture planes back to the external frame buffer allocator */
+static void dec_pic_mgr_release_ext_buf(EbDecHandle *dec_handle_ptr, EbDecPicBuf *ps_pic_buf) {
+    EbSvtAv1DecConfiguration *dec_config = &dec_handle_ptr->dec_config;
+    EbPictureBufferDesc      *recon_pic  = ps_pic_buf->ps_pic_buf;
+
+    if (ps_pic_buf->ext_frame_buf.buffer == NULL)
+        return;
+    dec_config->release_frame_buffer(&ps_pic_buf->ext_frame_buf, dec_config->frame_buffer_priv);
+    memset(&ps_pic_buf->ext_frame_buf, 0, sizeof(EbExtFrameBuf));
+    recon_pic->buffer_y  = NULL;
+    recon_pic->buffer_cb = NULL;
+    recon_pic->buffer_cr = NULL;
+}
+
+/* Allocates the picture planes with the external frame buffer allocator.
+   Each plane starts at an ALVALUE aligned offset of the external buffer */
+static EbErrorType dec_pic_mgr_alloc_ext_buf(EbDecHandle *dec_handle_ptr, EbDecPicBuf *ps_pic_buf) {
+    EbSvtAv1DecConfiguration *dec_config = &dec_handle_ptr->dec_config;
+    EbPictureBufferDesc      *recon_pic  = ps_pic_buf->ps_pic_buf;
+    EbExtFrameBuf            *frame_buf  = &ps_pic_buf->ext_frame_buf;
+
+    uint32_t bytes_per_pixel = (recon_pic->bit_depth > EB_EIGHT_BIT || recon_pic->is_16bit_pipeline) ? 2 : 1;
+    uint32_t luma_size   = ALIGN_POWER_OF_TWO(recon_pic->luma_size * bytes_per_pixel, 6);
+    uint32_t chroma_size = ALIGN_POWER_OF_TWO(recon_pic->chroma_size * bytes_per_pixel, 6);
+    uint32_t min_size    = luma_size + 2 * chroma_size + ALVALUE - 1;
+
+    if (dec_config->allocate_frame_buffer(frame_buf, min_size, dec_config->frame_buffer_priv) != 0 ||
+        frame_buf->buffer == NULL || frame_buf->buffer_size < min_size) {
+        SVT_ERROR("External frame buffer allocation of %u bytes failed\n", min_size);
+        memset(frame_buf, 0, sizeof(EbExtFrameBuf));
+        return EB_ErrorInsufficientResources;
+    }
+
+    EbByte buffer        = (EbByte)(((uintptr_t)frame_buf->buffer + ALVALUE - 1) & ~(uintptr_t)(ALVALUE - 1));
+    recon_pic->buffer_y  = buffer;
+    recon_pic->buffer_cb = chroma_size ? buffer + luma_size : NULL;
+    recon_pic->buffer_cr = chroma_size ? buffer + luma_size + chroma_size : NULL;
+    return EB_ErrorNone;
+}
+
 /**
 *******************************************************************************
 *
@@ -124,6 +170,13 @@ EbDecPicBuf *svt_aom_dec_pic_mgr_get_cur_pic(EbDecHandle *dec_handle_ptr) {
     if (i >= MAX_PIC_BUFS)
         return NULL;
 
+    /* A released buffer can still be under post-filtering in
+       frame parallel mode, wait for it before reuse */
+    if (dec_handle_ptr->pv_frm_prll_ctxt != NULL) {
+        svt_aom_dec_wait_pic_rows(&ps_pic_mgr->as_dec_pic[i], INT32_MAX);
+        svt_set_cond_var(&ps_pic_mgr->as_dec_pic[i].rows_done, 0);
+    }
+
     uint16_t       frame_width  = frame_info->frame_size.frame_width;
     uint16_t       frame_height = frame_info->frame_size.frame_height;
     EbColorConfig *cc           = &seq_header->color_config;
@@ -132,6 +185,11 @@ EbDecPicBuf *svt_aom_dec_pic_mgr_get_cur_pic(EbDecHandle *dec_handle_ptr) {
                                                   : (((frame_width + 2 * DEC_PAD_VALUE) >> cc->subsampling_x) *
                                         ((frame_height + 2 * DEC_PAD_VALUE) >> cc->subsampling_y));
     size_t         frame_size   = y_size + uv_size;
+    Bool           ext_buf      = dec_handle_ptr->dec_config.allocate_frame_buffer != NULL;
+
+    /* Planes of the previous use of the picture */
+    if (ext_buf)
+        dec_pic_mgr_release_ext_buf(dec_handle_ptr, &ps_pic_mgr->as_dec_pic[i]);
 
     if (ps_pic_mgr->as_dec_pic[i].size < frame_size) {
         /* allocate the buffer. TODO: Should add free and allocate logic */
@@ -145,6 +203,9 @@ EbDecPicBuf *svt_aom_dec_pic_mgr_get_cur_pic(EbDecHandle *dec_handle_ptr) {
         input_pic_buf_desc_init_data.color_format       = cc->mono_chrome ? EB_YUV400 : color_format;
         input_pic_buf_desc_init_data.buffer_enable_mask = cc->mono_chrome ? PICTURE_BUFFER_DESC_LUMA_MASK
                                                                           : PICTURE_BUFFER_DESC_FULL_MASK;
+        /* Planes come from the external allocator for each frame */
+        if (ext_buf)
+            input_pic_buf_desc_init_data.buffer_enable_mask = 0;
 
         input_pic_buf_desc_init_data.left_padding  = DEC_PAD_VALUE;
         input_pic_buf_desc_init_data.right_padding = DEC_PAD_VALUE;
@@ -172,6 +233,9 @@ EbDecPicBuf *svt_aom_dec_pic_mgr_get_cur_pic(EbDecHandle *dec_handle_ptr) {
     } else
         assert(ps_pic_mgr->as_dec_pic[i].ps_pic_buf != NULL);
 
+    if (ext_buf && dec_pic_mgr_alloc_ext_buf(dec_handle_ptr, &ps_pic_mgr->as_dec_pic[i]) != EB_ErrorNone)
+        return NULL;
+
     ps_pic_mgr->as_dec_pic[i].is_free   = 0;
     ps_pic_mgr->as_dec_pic[i].ref_count = 1;
 
@@ -188,6 +252,50 @@ static INLINE void dec_ref_count_and_rel(EbDecPicBuf *ps_pic_buf) {
     }
 }
 
+void svt_aom_dec_pic_mgr_release_pic(EbDecPicBuf *ps_pic_buf) { dec_ref_count_and_rel(ps_pic_buf); }
+
+/* Takes an extra reference to the picture, for its output */
+void svt_aom_dec_pic_mgr_hold_pic(EbDecPicBuf *ps_pic_buf) {
+    ps_pic_buf->ref_count++;
+    ps_pic_buf->is_free = 0;
+}
+
+/* Gives back the external frame buffers of the free pictures, or of all
+   the pictures when release_all is set. A free picture can still be the
+   last output picture or under post-filtering, so its planes are kept
+   until the next decode call or its post-filters are over */
+void svt_aom_dec_pic_mgr_release_ext_bufs(EbDecHandle *dec_handle_ptr, Bool release_all) {
+    EbDecPicMgr *ps_pic_mgr = (EbDecPicMgr *)dec_handle_ptr->pv_pic_mgr;
+
+    if (ps_pic_mgr == NULL || dec_handle_ptr->dec_config.release_frame_buffer == NULL)
+        return;
+    for (int32_t i = 0; i < MAX_PIC_BUFS; i++) {
+        EbDecPicBuf *ps_pic_buf = &ps_pic_mgr->as_dec_pic[i];
+        if (release_all || (ps_pic_buf->is_free && ps_pic_buf->rows_done.val == INT32_MAX))
+            dec_pic_mgr_release_ext_buf(dec_handle_ptr, ps_pic_buf);
+    }
+}
+
+/* Frees the decoder side output planes of the pictures */
+void svt_aom_dec_pic_mgr_free_out_bufs(EbDecHandle *dec_handle_ptr) {
+    EbDecPicMgr *ps_pic_mgr = (EbDecPicMgr *)dec_handle_ptr->pv_pic_mgr;
+
+    if (ps_pic_mgr == NULL)
+        return;
+    for (int32_t i = 0; i < MAX_PIC_BUFS; i++) {
+        free(ps_pic_mgr->as_dec_pic[i].out_buf);
+        ps_pic_mgr->as_dec_pic[i].out_buf      = NULL;
+        ps_pic_mgr->as_dec_pic[i].out_buf_size = 0;
+    }
+}
+
+/* Block until the first num_rows SB rows of the picture are final */
+void svt_aom_dec_wait_pic_rows(EbDecPicBuf *ps_pic_buf, int32_t num_rows) {
+    volatile int32_t *rows_done = &ps_pic_buf->rows_done.val;
+    int32_t           cur_rows;
+    while ((cur_rows = *rows_done) < num_rows) svt_wait_cond_var(&ps_pic_buf->rows_done, cur_rows);
+}
+
 /**
 *******************************************************************************
 *
@@ -37,6 +37,16 @@ EbErrorType svt_aom_dec_pic_mgr_init(EbDecHandle *dec_handle_ptr);
 
 EbDecPicBuf *svt_aom_dec_pic_mgr_get_cur_pic(EbDecHandle *dec_handle_ptr);
 
+void svt_aom_dec_pic_mgr_release_pic(EbDecPicBuf *ps_pic_buf);
+
+void svt_aom_dec_pic_mgr_hold_pic(EbDecPicBuf *ps_pic_buf);
+
+void svt_aom_dec_pic_mgr_release_ext_bufs(EbDecHandle *dec_handle_ptr, Bool release_all);
+
+void svt_aom_dec_pic_mgr_free_out_bufs(EbDecHandle *dec_handle_ptr);
+
+void svt_aom_dec_wait_pic_rows(EbDecPicBuf *ps_pic_buf, int32_t num_rows);
+
 void svt_aom_dec_pic_mgr_update_ref_pic(EbDecHandle *dec_handle_ptr, int32_t frame_decoded,
                                         int32_t refresh_frame_flags);
 
@@ -34,6 +34,7 @@
 #include "EbTime.h"
 
 #include "EbDecInverseQuantize.h"
+#include "grainSynthesis.h"
 #include "EbLog.h"
 
 #include "EbUtility.h"
@@ -143,6 +144,9 @@ EbErrorType dec_system_resource_init(EbDecHandle *dec_handle_ptr, TilesInfo *til
     /* Motion Filed Projection*/
     dec_mt_frame_data->motion_proj_info.num_motion_proj_rows = -1;
     EB_CREATE_MUTEX(dec_mt_frame_data->motion_proj_info.motion_proj_mutex);
+    EB_MALLOC_DEC(uint32_t *,
+                  dec_mt_frame_data->motion_proj_info.motion_proj_row_map,
+                  ((dec_handle_ptr->seq_header.max_frame_height + 63) >> 6) * sizeof(uint32_t));
 
     int32_t  sb_size_h            = block_size_high[dec_handle_ptr->seq_header.sb_size];
     uint32_t picture_height_in_sb = (dec_handle_ptr->frame_header.frame_size.frame_height + sb_size_h - 1) / sb_size_h;
@@ -300,8 +304,9 @@ EbErrorType dec_system_resource_init(EbDecHandle *dec_handle_ptr, TilesInfo *til
     dec_mt_frame_data->start_lf_frame     = FALSE;
     dec_mt_frame_data->start_cdef_frame   = FALSE;
     dec_mt_frame_data->start_lr_frame     = FALSE;
-    dec_mt_frame_data->num_threads_cdefed = 0;
-    dec_mt_frame_data->num_threads_lred   = 0;
+
+    dec_mt_frame_data->cdef_barrier.count = 0;
+    dec_mt_frame_data->lr_barrier.count   = 0;
 
     /************************************
     * Thread Handles
@@ -323,8 +328,15 @@ EbErrorType dec_system_resource_init(EbDecHandle *dec_handle_ptr, TilesInfo *til
     svt_aom_memory_map_end_address = svt_dec_memory_map;
 
     if (FALSE == dec_handle_ptr->start_thread_process) {
-        dec_mt_frame_data->end_flag           = FALSE;
-        dec_mt_frame_data->num_threads_exited = 0;
+        dec_mt_frame_data->end_flag = FALSE;
+        svt_create_cond_var(&dec_mt_frame_data->cdef_barrier.generation);
+        svt_create_cond_var(&dec_mt_frame_data->lr_barrier.generation);
+        svt_create_cond_var(&dec_mt_frame_data->motion_proj_progress);
+        svt_create_cond_var(&dec_mt_frame_data->parse_progress);
+        svt_create_cond_var(&dec_mt_frame_data->recon_progress);
+        svt_create_cond_var(&dec_mt_frame_data->lf_progress);
+        svt_create_cond_var(&dec_mt_frame_data->cdef_progress);
+        svt_create_cond_var(&dec_mt_frame_data->lr_progress);
 
         if (num_lib_threads > 0) {
             DecThreadCtxt *thread_ctxt_pa;
@@ -662,6 +674,50 @@ static INLINE void dec_save_CDEF_boundary_lines_SB_row(EbDecHandle *dec_handle,
     }
 }
 
+/* Blocks until all the threads reach the barrier, or right away once the
+   threads are being closed. last_fn, if set, is run by the last thread to
+   arrive before the others are released */
+void dec_barrier_wait(DecMtFrameData *dec_mt_frame_data, DecBarrier *barrier, uint32_t num_threads,
+                      void (*last_fn)(DecMtFrameData *dec_mt_frame_data)) {
+    svt_block_on_mutex(dec_mt_frame_data->temp_mutex);
+    if (dec_mt_frame_data->end_flag) {
+        svt_release_mutex(dec_mt_frame_data->temp_mutex);
+        return;
+    }
+    const int32_t generation = svt_get_cond_var(&barrier->generation);
+    if (++barrier->count == num_threads) {
+        barrier->count = 0;
+        if (last_fn)
+            last_fn(dec_mt_frame_data);
+        svt_release_mutex(dec_mt_frame_data->temp_mutex);
+        svt_add_cond_var(&barrier->generation, 1);
+        return;
+    }
+    svt_release_mutex(dec_mt_frame_data->temp_mutex);
+    svt_wait_cond_var(&barrier->generation, generation);
+}
+
+/* Run once all the threads are done with the frame */
+static void dec_frame_done(DecMtFrameData *dec_mt_frame_data) {
+    dec_mt_frame_data->start_motion_proj  = FALSE;
+    dec_mt_frame_data->start_parse_frame  = FALSE;
+    dec_mt_frame_data->start_decode_frame = FALSE;
+    dec_mt_frame_data->start_lf_frame     = FALSE;
+    dec_mt_frame_data->start_cdef_frame   = FALSE;
+    dec_mt_frame_data->start_lr_frame     = FALSE;
+}
+
+/* Checks the recon of all the tiles of the 3 SB rows of row_index is over */
+static Bool lf_recon_rows_done(DecMtFrameData *dec_mt_frame_data, const int32_t *row_index, int32_t tile_cols) {
+    volatile uint32_t *sb_recon_row_map = dec_mt_frame_data->sb_recon_row_map;
+    for (int i = 0; i < tile_cols; i++) {
+        if (!sb_recon_row_map[row_index[0] + i] || !sb_recon_row_map[row_index[1] + i] ||
+            !sb_recon_row_map[row_index[2] + i])
+            return FALSE;
+    }
+    return TRUE;
+}
+
 /*Frame level function to trigger loop filter for each superblock*/
 void svt_aom_dec_av1_loop_filter_frame_mt(EbDecHandle *dec_handle, EbPictureBufferDesc *recon_picture_buf,
                                           LfCtxt *lf_ctxt, int32_t plane_start, int32_t plane_end,
@@ -741,7 +797,6 @@ void svt_aom_dec_av1_loop_filter_frame_mt(EbDecHandle *dec_handle, EbPictureBuff
             /* row-1 : To ensure line buf copy with TopR sync if LF skips row  */
             /* This prevent issues across Tiles where recon sync is not ensured*/
             /* row+1 : This is for CDEF actually, should be moved to CDEF stage*/
-            int32_t start_lf[3] = {0};
             int32_t row_index[3];
             row_index[0] = (sb_row)*tiles_info->tile_cols;
             row_index[1] = (sb_row - (sb_row == 0 ? 0 : 1)) * tiles_info->tile_cols;
@@ -749,16 +804,8 @@ void svt_aom_dec_av1_loop_filter_frame_mt(EbDecHandle *dec_handle, EbPictureBuff
 #if MT_WAIT_PROFILE
             dec_timer_start(&timer);
 #endif
-            while ((!start_lf[0]) || (!start_lf[1]) || (!start_lf[2])) {
-                start_lf[0] = 1;
-                start_lf[1] = 1;
-                start_lf[2] = 1;
-                for (int i = 0; i < tiles_info->tile_cols; i++) {
-                    start_lf[0] &= dec_mt_frame_data->sb_recon_row_map[row_index[0] + i];
-                    start_lf[1] &= dec_mt_frame_data->sb_recon_row_map[row_index[1] + i];
-                    start_lf[2] &= dec_mt_frame_data->sb_recon_row_map[row_index[2] + i];
-                }
-            }
+            DEC_WAIT_PROGRESS(&dec_mt_frame_data->recon_progress,
+                              lf_recon_rows_done(dec_mt_frame_data, row_index, tiles_info->tile_cols));
 #if MT_WAIT_PROFILE
             dec_display_timer("LFWR", &timer, th_cnt, fp);
 #endif
@@ -778,12 +825,14 @@ void svt_aom_dec_av1_loop_filter_frame_mt(EbDecHandle *dec_handle, EbPictureBuff
 
                 /* Update LF done map */
                 dec_mt_frame_data1->lf_row_map[sb_row - 1] = 1;
+                svt_add_cond_var(&dec_mt_frame_data1->lf_progress, 1);
             }
             if (sb_row == dec_mt_frame_data->sb_rows - 1) {
                 dec_save_lf_boundary_lines_sb_row(dec_handle, tile_rect_p, sb_row, src, stride, num_planes);
 
                 /* Update LF done map */
                 dec_mt_frame_data1->lf_row_map[sb_row] = 1;
+                svt_add_cond_var(&dec_mt_frame_data1->lf_progress, 1);
             }
         } else
             break;
@@ -885,8 +934,7 @@ void svt_cdef_frame_mt(EbDecHandle *dec_handle_ptr, DecThreadCtxt *thread_ctxt)
             dec_timer_start(&timer);
 #endif
             volatile int32_t *start_cdef = (volatile int32_t *)&dec_mt_frame_data->lf_row_map[sb_row + offset];
-            while (!*start_cdef)
-                ;
+            DEC_WAIT_PROGRESS(&dec_mt_frame_data->lf_progress, *start_cdef);
             assert(*start_cdef == 1);
 #if MT_WAIT_PROFILE
             dec_display_timer("CWLF", &timer, th_cnt, fp);
@@ -922,6 +970,7 @@ void svt_cdef_frame_mt(EbDecHandle *dec_handle_ptr, DecThreadCtxt *thread_ctxt)
             }
             /* Update CDEF done map */
             dec_mt_frame_data1->cdef_completed_for_row_map[sb_row] = 1;
+            svt_add_cond_var(&dec_mt_frame_data1->cdef_progress, 1);
 
         } else
             break;
@@ -933,14 +982,9 @@ void svt_cdef_frame_mt(EbDecHandle *dec_handle_ptr, DecThreadCtxt *thread_ctxt)
     } else
         for (int32_t pli = 0; pli < num_planes; pli++) { svt_aom_free(colbuf[pli]); }
 
-    svt_block_on_mutex(dec_mt_frame_data->temp_mutex);
-    dec_mt_frame_data->num_threads_cdefed++;
-    svt_release_mutex(dec_mt_frame_data->temp_mutex);
-    if (do_upscale) {
-        volatile uint32_t *num_threads_cdefed = &dec_mt_frame_data->num_threads_cdefed;
-        while (*num_threads_cdefed != dec_handle_ptr->dec_config.threads)
-            ;
-    }
+    /* The whole frame is upscaled before LR */
+    if (do_upscale)
+        dec_barrier_wait(dec_mt_frame_data, &dec_mt_frame_data->cdef_barrier, dec_handle_ptr->dec_config.threads, NULL);
 }
 
 void svt_av1_queue_lr_jobs(EbDecHandle *dec_handle_ptr) {
@@ -1084,8 +1128,7 @@ void svt_aom_dec_av1_loop_restoration_filter_frame_mt(EbDecHandle *dec_handle, D
         if (-1 != sb_row) {
             /* Ensure all CDEF jobs are over for row_index row  */
             volatile int32_t *start_lr = (volatile int32_t *)&dec_mt_frame_data->cdef_completed_for_row_map[sb_row];
-            while (!*start_lr)
-                ;
+            DEC_WAIT_PROGRESS(&dec_mt_frame_data->cdef_progress, *start_lr);
 
             LrCtxt *lr_ctxt = (LrCtxt *)dec_handle->pv_lr_ctxt;
 
@@ -1145,21 +1188,8 @@ void svt_aom_dec_av1_loop_restoration_filter_frame_mt(EbDecHandle *dec_handle, D
             break;
     }
 
-    svt_block_on_mutex(dec_mt_frame_data->temp_mutex);
-    dec_mt_frame_data->num_threads_lred++;
-    if (dec_handle->dec_config.threads == dec_mt_frame_data->num_threads_lred) {
-        dec_mt_frame_data->start_motion_proj  = FALSE;
-        dec_mt_frame_data->start_parse_frame  = FALSE;
-        dec_mt_frame_data->start_decode_frame = FALSE;
-        dec_mt_frame_data->start_lf_frame     = FALSE;
-        dec_mt_frame_data->start_cdef_frame   = FALSE;
-        dec_mt_frame_data->start_lr_frame     = FALSE;
-    }
-    svt_release_mutex(dec_mt_frame_data->temp_mutex);
-
-    volatile uint32_t *num_threads_lred = &dec_mt_frame_data->num_threads_lred;
-    while (*num_threads_lred != dec_handle->dec_config.threads && FALSE == dec_mt_frame_data->end_flag)
-        ;
+    /* End of frame, the frame data is reused by the next one */
+    dec_barrier_wait(dec_mt_frame_data, &dec_mt_frame_data->lr_barrier, dec_handle->dec_config.threads, dec_frame_done);
 }
 
 static void *dec_all_stage_kernel(void *input_ptr) {
@@ -1167,9 +1197,6 @@ static void *dec_all_stage_kernel(void *input_ptr) {
     DecThreadCtxt  *thread_ctxt       = (DecThreadCtxt *)input_ptr;
     EbDecHandle    *dec_handle_ptr    = thread_ctxt->dec_handle_ptr;
     DecMtFrameData *dec_mt_frame_data = &dec_handle_ptr->main_frame_buf.cur_frame_bufs[0].dec_mt_frame_data;
-    volatile Bool  *start_thread      = (volatile Bool *)&dec_handle_ptr->start_thread_process;
-    while (*start_thread == FALSE)
-        ;
 
     while (1) {
         /* Motion Field Projection */
@@ -1190,36 +1217,23 @@ static void *dec_all_stage_kernel(void *input_ptr) {
         /*Frame LR */
         svt_aom_dec_av1_loop_restoration_filter_frame_mt(dec_handle_ptr, thread_ctxt);
 
-        if (TRUE == dec_mt_frame_data->end_flag) {
-            svt_block_on_mutex(dec_mt_frame_data->temp_mutex);
-            dec_mt_frame_data->num_threads_exited++;
-            svt_release_mutex(dec_mt_frame_data->temp_mutex);
+        if (TRUE == dec_mt_frame_data->end_flag)
             break;
-        }
     }
     return NULL;
 }
 
-static void svt_av1_sleep(const int milliseconds) {
-    if (!milliseconds)
-        return;
-#ifdef _WIN32
-    Sleep(milliseconds);
-#else
-    nanosleep(&(struct timespec){milliseconds / 1000, (milliseconds % 1000) * 1000000}, NULL);
-#endif
-}
-
 void dec_sync_all_threads(EbDecHandle *dec_handle_ptr) {
     DecMtFrameData *dec_mt_frame_data = &dec_handle_ptr->main_frame_buf.cur_frame_bufs[0].dec_mt_frame_data;
-    dec_mt_frame_data->end_flag       = TRUE;
 
-    /* To make all worker exit except main thread! */
-    dec_mt_frame_data->num_threads_cdefed = 1;
-    dec_mt_frame_data->num_threads_lred   = 1;
+    /* To make all worker exit except main thread! Release the threads
+       blocked on the barriers, the barriers are skipped from now on */
+    svt_block_on_mutex(dec_mt_frame_data->temp_mutex);
+    dec_mt_frame_data->end_flag = TRUE;
+    svt_release_mutex(dec_mt_frame_data->temp_mutex);
+    svt_add_cond_var(&dec_mt_frame_data->cdef_barrier.generation, 1);
+    svt_add_cond_var(&dec_mt_frame_data->lr_barrier.generation, 1);
 
-    /* To make all worker exit except main thread! */
-    dec_mt_frame_data->num_threads_header          = 1;
     dec_handle_ptr->frame_header.use_ref_frame_mvs = 0;
     dec_mt_frame_data->start_motion_proj           = TRUE;
 
@@ -1244,8 +1258,380 @@ void dec_sync_all_threads(EbDecHandle *dec_handle_ptr) {
     for (uint32_t lib_thrd = 0; lib_thrd < dec_handle_ptr->dec_config.threads - 1; lib_thrd++)
         svt_post_semaphore(dec_handle_ptr->thread_ctxt_pa[lib_thrd].thread_semaphore);
 
-    while (dec_mt_frame_data->num_threads_exited != dec_handle_ptr->dec_config.threads - 1) svt_av1_sleep(5);
-
-    /*Destroying lib created thread's*/
+    /*Destroying lib created thread's, joining them waits for their exit*/
     EB_DESTROY_THREAD_ARRAY(dec_handle_ptr->decode_thread_handle_array, dec_handle_ptr->dec_config.threads - 1);
 }
+
+/* LR & padding of one SB row in frame parallel mode. The row above is
+   final after it, so it is released to the frames referring to this one */
+static void dec_frm_prll_lr_sb_row(EbDecHandle *dec_handle, int32_t sb_row, int32_t num_rows, Bool do_lr,
+                                   Bool do_upscale) {
+    uint8_t *curr_blk_recon_buf[MAX_MB_PLANE];
+    int32_t  curr_recon_stride[MAX_MB_PLANE];
+
+    Av1PixelRect  tile_rect[MAX_MB_PLANE];
+    Av1PixelRect  cdef_tile_rect[MAX_MB_PLANE];
+    Av1PixelRect *cdef_tile_rect_p[MAX_MB_PLANE];
+
+    EbPictureBufferDesc *recon_picture_buf = dec_handle->cur_pic_buf[0]->ps_pic_buf;
+    const int32_t        num_planes        = av1_num_planes(&dec_handle->seq_header.color_config);
+
+    int sx = dec_handle->seq_header.color_config.subsampling_x;
+    int sy = dec_handle->seq_header.color_config.subsampling_y;
+
+    for (int32_t pli = 0; pli < num_planes; pli++) {
+        int32_t sub_x = (pli == 0) ? 0 : sx;
+        int32_t sub_y = (pli == 0) ? 0 : sy;
+
+        svt_aom_derive_blk_pointers(
+            recon_picture_buf, pli, 0, 0, (void *)&curr_blk_recon_buf[pli], &curr_recon_stride[pli], sub_x, sub_y);
+
+        tile_rect[pli]        = svt_aom_whole_frame_rect(&dec_handle->frame_header.frame_size, sub_x, sub_y, pli > 0);
+        cdef_tile_rect[pli]   = svt_aom_whole_frame_rect(&dec_handle->cm.frm_size, sub_x, sub_y, pli > 0);
+        cdef_tile_rect_p[pli] = &cdef_tile_rect[pli];
+    }
+
+    uint32_t frame_width  = dec_handle->frame_header.frame_size.superres_upscaled_width;
+    uint32_t frame_height = dec_handle->frame_header.frame_size.frame_height;
+    int32_t  sb_size      = dec_handle->seq_header.use_128x128_superblock ? 128 : 64;
+
+    uint32_t pad_width  = recon_picture_buf->org_x;
+    uint32_t pad_height = recon_picture_buf->org_y;
+
+    int32_t shift = 0;
+    if ((recon_picture_buf->bit_depth != EB_EIGHT_BIT) || recon_picture_buf->is_16bit_pipeline)
+        shift = 1;
+
+    int32_t recon_stride[MAX_MB_PLANE];
+    recon_stride[AOM_PLANE_Y] = recon_picture_buf->stride_y << shift;
+    recon_stride[AOM_PLANE_U] = recon_picture_buf->stride_cb << shift;
+    recon_stride[AOM_PLANE_V] = recon_picture_buf->stride_cr << shift;
+
+    if (do_lr && !do_upscale) {
+        if (sb_row == 0 || sb_row == num_rows - 1) {
+            dec_save_CDEF_boundary_lines_SB_row(
+                dec_handle, cdef_tile_rect_p, sb_row, curr_blk_recon_buf, curr_recon_stride, num_planes);
+        }
+    }
+
+    pad_pre_lr(recon_picture_buf,
+               sb_row,
+               sb_size,
+               num_rows,
+               &curr_blk_recon_buf[AOM_PLANE_Y],
+               &recon_stride[AOM_PLANE_Y],
+               frame_width,
+               frame_height,
+               sx,
+               sy);
+
+    if (do_lr) {
+        LrCtxt *lr_ctxt = (LrCtxt *)dec_handle->pv_lr_ctxt;
+        svt_aom_dec_av1_loop_restoration_filter_row(dec_handle,
+                                                    sb_row,
+                                                    &curr_blk_recon_buf[AOM_PLANE_Y],
+                                                    &curr_recon_stride[AOM_PLANE_Y],
+                                                    tile_rect,
+                                                    0 /*opt_lr*/,
+                                                    lr_ctxt->dst,
+                                                    0);
+    }
+
+    pad_post_lr(recon_picture_buf,
+                sb_row,
+                sb_size,
+                num_rows,
+                &recon_stride[AOM_PLANE_Y],
+                pad_width,
+                pad_height,
+                shift,
+                frame_width,
+                frame_height,
+                sx,
+                sy);
+
+    svt_set_cond_var(&dec_handle->cur_pic_buf[0]->rows_done, sb_row == num_rows - 1 ? INT32_MAX : sb_row);
+}
+
+/* Post-filter stage of a frame in frame parallel mode. Same ordering as the
+   MT post-filters (LF -> CDEF -> SR -> LR -> pad), run as a single thread
+   SB row wavefront on a copy of the decoder handle */
+static void dec_frm_prll_post_filter_frame(EbDecHandle *dec_handle) {
+    FrameHeader         *frame_header      = &dec_handle->frame_header;
+    EbPictureBufferDesc *recon_picture_buf = dec_handle->cur_pic_buf[0]->ps_pic_buf;
+    LfCtxt              *lf_ctxt           = (LfCtxt *)dec_handle->pv_lf_ctxt;
+    const int32_t        num_planes        = av1_num_planes(&dec_handle->seq_header.color_config);
+
+    Bool      no_ibc  = !frame_header->allow_intrabc;
+    Bool      do_lf   = no_ibc &&
+        (frame_header->loop_filter_params.filter_level[0] || frame_header->loop_filter_params.filter_level[1]);
+    Bool      do_cdef = no_ibc &&
+        (!frame_header->coded_lossless &&
+         (frame_header->cdef_params.cdef_bits || frame_header->cdef_params.cdef_y_strength[0] ||
+          frame_header->cdef_params.cdef_uv_strength[0]));
+    Bool      do_upscale = no_ibc && !av1_superres_unscaled(&frame_header->frame_size);
+    LrParams *lr_param   = frame_header->lr_params;
+    Bool      do_lr      = no_ibc &&
+        (lr_param[AOM_PLANE_Y].frame_restoration_type != RESTORE_NONE ||
+         lr_param[AOM_PLANE_U].frame_restoration_type != RESTORE_NONE ||
+         lr_param[AOM_PLANE_V].frame_restoration_type != RESTORE_NONE);
+
+    Av1PixelRect  tile_rect[MAX_MB_PLANE];
+    Av1PixelRect *tile_rect_p[MAX_MB_PLANE];
+    uint8_t      *src[MAX_MB_PLANE];
+    int32_t       stride[MAX_MB_PLANE];
+    for (int p = 0; p < num_planes; ++p) {
+        int32_t is_uv  = p ? 1 : 0;
+        int32_t sx     = is_uv ? dec_handle->cm.subsampling_x : 0;
+        int32_t sy     = is_uv ? dec_handle->cm.subsampling_y : 0;
+        tile_rect[p]   = svt_aom_whole_frame_rect(&dec_handle->cm.frm_size, sx, sy, is_uv);
+        tile_rect_p[p] = &tile_rect[p];
+        svt_aom_derive_blk_pointers(recon_picture_buf, p, 0, 0, (void *)&src[p], &stride[p], sx, sy);
+    }
+
+    int32_t sb_size_log2 = dec_handle->seq_header.sb_size_log2;
+    int32_t num_rows     = ALIGN_POWER_OF_TWO(frame_header->frame_size.frame_height, sb_size_log2) >> sb_size_log2;
+    int32_t fb_shift     = dec_handle->seq_header.sb_size == BLOCK_128X128 ? 1 : 0;
+    int32_t nvfb         = (frame_header->mi_rows + MI_SIZE_64X64 - 1) / MI_SIZE_64X64;
+
+    DecCdefCtxt cdef_ctxt;
+    if (do_lf)
+        svt_aom_dec_av1_loop_filter_frame_init(dec_handle, lf_ctxt, AOM_PLANE_Y, MAX_MB_PLANE);
+    if (do_cdef)
+        svt_cdef_frame_init(dec_handle, &cdef_ctxt);
+
+    int32_t cdef_row = 0;
+    for (int32_t sb_row = 0; sb_row < num_rows; sb_row++) {
+        if (do_lf)
+            svt_aom_dec_av1_loop_filter_sb_row(
+                dec_handle, recon_picture_buf, lf_ctxt, sb_row, AOM_PLANE_Y, MAX_MB_PLANE);
+
+        /* Bottom lines of the row above are final only after LF of this row */
+        if (do_lr) {
+            if (sb_row != 0)
+                dec_save_lf_boundary_lines_sb_row(dec_handle, tile_rect_p, sb_row - 1, src, stride, num_planes);
+            if (sb_row == num_rows - 1)
+                dec_save_lf_boundary_lines_sb_row(dec_handle, tile_rect_p, sb_row, src, stride, num_planes);
+        }
+
+        /* CDEF of a row reads the deblocked lines of the row below, and
+           must not run before the LR boundary lines of the row below
+           (taken from its bottom lines) are saved */
+        int32_t cdef_end = sb_row == num_rows - 1 ? num_rows : sb_row - 1;
+        for (; cdef_row < cdef_end; cdef_row++) {
+            if (do_cdef) {
+                for (int32_t fbr = cdef_row << fb_shift; fbr < AOMMIN((cdef_row + 1) << fb_shift, nvfb); fbr++)
+                    svt_cdef_fb_row(dec_handle, &cdef_ctxt, fbr);
+            }
+            if (!do_upscale)
+                dec_frm_prll_lr_sb_row(dec_handle, cdef_row, num_rows, do_lr, do_upscale);
+        }
+    }
+    if (do_cdef)
+        svt_cdef_frame_free(&cdef_ctxt);
+
+    if (do_upscale) {
+        svt_av1_superres_upscale(
+            &dec_handle->cm, &dec_handle->frame_header, &dec_handle->seq_header, recon_picture_buf, do_upscale);
+        dec_handle->cm.frm_size.frame_width = dec_handle->frame_header.frame_size.frame_width;
+
+        if (do_lr)
+            svt_aom_dec_av1_loop_restoration_save_boundary_lines(dec_handle, 1);
+
+        for (int32_t sb_row = 0; sb_row < num_rows; sb_row++)
+            dec_frm_prll_lr_sb_row(dec_handle, sb_row, num_rows, do_lr, do_upscale);
+    }
+}
+
+static void *dec_frm_prll_kernel(void *input_ptr) {
+    DecFrmPrllCtxt *frm_prll_ctxt = (DecFrmPrllCtxt *)input_ptr;
+
+    while (1) {
+        svt_block_on_semaphore(frm_prll_ctxt->thread_semaphore);
+        if (frm_prll_ctxt->end_flag)
+            break;
+        dec_frm_prll_post_filter_frame(&frm_prll_ctxt->pf_handle);
+        svt_set_cond_var(&frm_prll_ctxt->busy, 0);
+    }
+    return NULL;
+}
+
+/* Frame parallel mode : creates the post-filter thread */
+EbErrorType svt_aom_dec_frm_prll_init(EbDecHandle *dec_handle_ptr) {
+    DecFrmPrllCtxt *frm_prll_ctxt;
+    EB_MALLOC_DEC(DecFrmPrllCtxt *, frm_prll_ctxt, sizeof(DecFrmPrllCtxt));
+    memset(frm_prll_ctxt, 0, sizeof(DecFrmPrllCtxt));
+    dec_handle_ptr->pv_frm_prll_ctxt = frm_prll_ctxt;
+
+    frm_prll_ctxt->end_flag = FALSE;
+    svt_create_cond_var(&frm_prll_ctxt->busy);
+    EB_CREATE_SEMAPHORE(frm_prll_ctxt->thread_semaphore, 0, 1);
+    EB_CREATE_THREAD(frm_prll_ctxt->thread_handle, dec_frm_prll_kernel, frm_prll_ctxt);
+    return EB_ErrorNone;
+}
+
+/* Frame parallel mode : waits for the post-filter thread to go idle */
+void svt_aom_dec_frm_prll_sync(EbDecHandle *dec_handle_ptr) {
+    DecFrmPrllCtxt *frm_prll_ctxt = (DecFrmPrllCtxt *)dec_handle_ptr->pv_frm_prll_ctxt;
+    svt_wait_cond_var(&frm_prll_ctxt->busy, 1);
+}
+
+/* Frame parallel mode : hands the current frame over to the post-filter
+   thread. Parse & decode of the next frame continue in the other set of
+   frame level buffers */
+void svt_aom_dec_frm_prll_post_filter(EbDecHandle *dec_handle_ptr) {
+    DecFrmPrllCtxt *frm_prll_ctxt  = (DecFrmPrllCtxt *)dec_handle_ptr->pv_frm_prll_ctxt;
+    MainFrameBuf   *main_frame_buf = &dec_handle_ptr->main_frame_buf;
+
+    svt_aom_dec_frm_prll_sync(dec_handle_ptr);
+    frm_prll_ctxt->pf_handle = *dec_handle_ptr;
+
+    CurFrameBuf cur_frame_buf         = main_frame_buf->cur_frame_bufs[0];
+    main_frame_buf->cur_frame_bufs[0] = main_frame_buf->cur_frame_bufs[1];
+    main_frame_buf->cur_frame_bufs[1] = cur_frame_buf;
+
+    FrameMiMap frame_mi_map      = main_frame_buf->frame_mi_map;
+    main_frame_buf->frame_mi_map = frm_prll_ctxt->frame_mi_map;
+    frm_prll_ctxt->frame_mi_map  = frame_mi_map;
+
+    void *pv_lf_ctxt           = dec_handle_ptr->pv_lf_ctxt;
+    dec_handle_ptr->pv_lf_ctxt = frm_prll_ctxt->pv_lf_ctxt;
+    frm_prll_ctxt->pv_lf_ctxt  = pv_lf_ctxt;
+
+    LrCtxt *pf_lr_ctxt         = (LrCtxt *)dec_handle_ptr->pv_lr_ctxt;
+    LrCtxt *lr_ctxt            = (LrCtxt *)frm_prll_ctxt->pv_lr_ctxt;
+    dec_handle_ptr->pv_lr_ctxt = lr_ctxt;
+    frm_prll_ctxt->pv_lr_ctxt  = pf_lr_ctxt;
+    for (int32_t plane = 0; plane <= AOM_PLANE_V; plane++) {
+        lr_ctxt->lr_unit[plane]   = main_frame_buf->cur_frame_bufs[0].lr_unit[plane];
+        lr_ctxt->lr_stride[plane] = pf_lr_ctxt->lr_stride[plane];
+    }
+
+    svt_set_cond_var(&frm_prll_ctxt->busy, 1);
+    svt_post_semaphore(frm_prll_ctxt->thread_semaphore);
+}
+
+void svt_aom_dec_frm_prll_deinit(EbDecHandle *dec_handle_ptr) {
+    DecFrmPrllCtxt *frm_prll_ctxt = (DecFrmPrllCtxt *)dec_handle_ptr->pv_frm_prll_ctxt;
+
+    svt_aom_dec_frm_prll_sync(dec_handle_ptr);
+    frm_prll_ctxt->end_flag = TRUE;
+    svt_post_semaphore(frm_prll_ctxt->thread_semaphore);
+    EB_DESTROY_THREAD(frm_prll_ctxt->thread_handle);
+    EB_DESTROY_SEMAPHORE(frm_prll_ctxt->thread_semaphore);
+}
+
+static void *dec_fg_kernel(void *input_ptr) {
+    DecFgThrdCtxt *thrd_ctxt = (DecFgThrdCtxt *)input_ptr;
+    DecFgCtxt     *fg_ctxt   = thrd_ctxt->fg_ctxt;
+
+    while (1) {
+        svt_block_on_semaphore(thrd_ctxt->thread_semaphore);
+        if (fg_ctxt->end_flag)
+            break;
+        const int32_t rows = svt_av1_film_grain_block_rows(fg_ctxt->height);
+        svt_av1_add_film_grain_rows(fg_ctxt->synth,
+                                    fg_ctxt->luma,
+                                    fg_ctxt->cb,
+                                    fg_ctxt->cr,
+                                    fg_ctxt->height,
+                                    fg_ctxt->width,
+                                    fg_ctxt->luma_stride,
+                                    fg_ctxt->chroma_stride,
+                                    fg_ctxt->use_high_bit_depth,
+                                    rows * thrd_ctxt->band / fg_ctxt->num_bands,
+                                    rows * (thrd_ctxt->band + 1) / fg_ctxt->num_bands);
+        svt_post_semaphore(fg_ctxt->done_semaphore);
+    }
+    return NULL;
+}
+
+/* Film grain : creates the helper threads adding the grain to the bands of
+   block rows of the output pictures */
+EbErrorType svt_aom_dec_fg_init(EbDecHandle *dec_handle_ptr) {
+    DecFgCtxt *fg_ctxt;
+    EB_MALLOC_DEC(DecFgCtxt *, fg_ctxt, sizeof(DecFgCtxt));
+    memset(fg_ctxt, 0, sizeof(DecFgCtxt));
+    dec_handle_ptr->pv_fg_ctxt = fg_ctxt;
+
+    fg_ctxt->end_flag  = FALSE;
+    fg_ctxt->num_thrds = dec_handle_ptr->dec_config.threads - 1;
+    EB_MALLOC_DEC(DecFgThrdCtxt *, fg_ctxt->thrd_ctxt_pa, fg_ctxt->num_thrds * sizeof(DecFgThrdCtxt));
+    EB_CREATE_SEMAPHORE(fg_ctxt->done_semaphore, 0, fg_ctxt->num_thrds);
+    for (uint32_t i = 0; i < fg_ctxt->num_thrds; i++) {
+        DecFgThrdCtxt *thrd_ctxt = &fg_ctxt->thrd_ctxt_pa[i];
+        thrd_ctxt->fg_ctxt       = fg_ctxt;
+        thrd_ctxt->band          = i + 1;
+        EB_CREATE_SEMAPHORE(thrd_ctxt->thread_semaphore, 0, 1);
+        EB_CREATE_THREAD(thrd_ctxt->thread_handle, dec_fg_kernel, thrd_ctxt);
+    }
+    return EB_ErrorNone;
+}
+
+/* Film grain : adds the grain to an output picture, by bands of block rows
+   when the helper threads exist */
+void svt_aom_dec_add_film_grain(EbDecHandle *dec_handle_ptr, AomFilmGrain *film_grain_ptr, uint8_t *luma, uint8_t *cb,
+                                uint8_t *cr, int32_t height, int32_t width, int32_t luma_stride, int32_t chroma_stride,
+                                int32_t use_high_bit_depth, int32_t chroma_subsamp_y, int32_t chroma_subsamp_x) {
+    DecFgCtxt *fg_ctxt = (DecFgCtxt *)dec_handle_ptr->pv_fg_ctxt;
+
+    if (fg_ctxt == NULL) {
+        svt_av1_add_film_grain_run(film_grain_ptr,
+                                   luma,
+                                   cb,
+                                   cr,
+                                   height,
+                                   width,
+                                   luma_stride,
+                                   chroma_stride,
+                                   use_high_bit_depth,
+                                   chroma_subsamp_y,
+                                   chroma_subsamp_x);
+        return;
+    }
+
+    FilmGrainSynth synth;
+    svt_av1_film_grain_synth_init(&synth, film_grain_ptr, chroma_subsamp_y, chroma_subsamp_x);
+
+    const int32_t rows          = svt_av1_film_grain_block_rows(height);
+    fg_ctxt->synth              = &synth;
+    fg_ctxt->luma               = luma;
+    fg_ctxt->cb                 = cb;
+    fg_ctxt->cr                 = cr;
+    fg_ctxt->height             = height;
+    fg_ctxt->width              = width;
+    fg_ctxt->luma_stride        = luma_stride;
+    fg_ctxt->chroma_stride      = chroma_stride;
+    fg_ctxt->use_high_bit_depth = use_high_bit_depth;
+    fg_ctxt->num_bands          = AOMMAX(AOMMIN((int32_t)fg_ctxt->num_thrds + 1, rows), 1);
+
+    for (int32_t band = 1; band < fg_ctxt->num_bands; band++)
+        svt_post_semaphore(fg_ctxt->thrd_ctxt_pa[band - 1].thread_semaphore);
+    svt_av1_add_film_grain_rows(&synth,
+                                luma,
+                                cb,
+                                cr,
+                                height,
+                                width,
+                                luma_stride,
+                                chroma_stride,
+                                use_high_bit_depth,
+                                0,
+                                rows / fg_ctxt->num_bands);
+    for (int32_t band = 1; band < fg_ctxt->num_bands; band++)
+        svt_block_on_semaphore(fg_ctxt->done_semaphore);
+
+    svt_av1_film_grain_synth_free(&synth);
+}
+
+void svt_aom_dec_fg_deinit(EbDecHandle *dec_handle_ptr) {
+    DecFgCtxt *fg_ctxt = (DecFgCtxt *)dec_handle_ptr->pv_fg_ctxt;
+
+    fg_ctxt->end_flag = TRUE;
+    for (uint32_t i = 0; i < fg_ctxt->num_thrds; i++) {
+        svt_post_semaphore(fg_ctxt->thrd_ctxt_pa[i].thread_semaphore);
+        EB_DESTROY_THREAD(fg_ctxt->thrd_ctxt_pa[i].thread_handle);
+        EB_DESTROY_SEMAPHORE(fg_ctxt->thrd_ctxt_pa[i].thread_semaphore);
+    }
+    EB_DESTROY_SEMAPHORE(fg_ctxt->done_semaphore);
+}
@@ -17,6 +17,7 @@ extern "C" {
 #endif
 #include "EbDefinitions.h"
 #include "EbSystemResourceManager.h"
+#include "EbThreads.h"
 
 #define MT_WAIT_PROFILE 0
 
@@ -85,7 +86,9 @@ typedef struct DecMtMotionProjInfo {
     /* Motion Projection row state context */
     int32_t motion_proj_row_to_process;
 
-    Bool motion_proj_init_done;
+    /* 64x64 rows whose projection is over. The projection of a row only
+       writes in the row, so the parse of a SB row waits for its rows only */
+    uint32_t *motion_proj_row_map;
 
 } DecMtMotionProjInfo;
 
@@ -137,6 +140,26 @@ typedef struct DecMtRowInfo {
     int32_t sb_row_to_process;
 } DecMtRowInfo;
 
+/* Reusable barrier of all the decoder threads, see dec_barrier_wait() */
+typedef struct DecBarrier {
+    /* Threads arrived in the current generation, under temp_mutex */
+    uint32_t count;
+    /* Bumped by the last thread to arrive, to release the others */
+    CondVar generation;
+} DecBarrier;
+
+/* Blocks until cond holds. progress is the CondVar bumped by the producers of
+   cond, it is sampled before cond is checked again so no wake up is missed */
+#define DEC_WAIT_PROGRESS(progress, cond)                        \
+    do {                                                         \
+        while (!(cond)) {                                        \
+            const int32_t dec_seen = svt_get_cond_var(progress); \
+            if (cond)                                            \
+                break;                                           \
+            svt_wait_cond_var(progress, dec_seen);               \
+        }                                                        \
+    } while (0)
+
 typedef struct DecMtlfFrameInfo {
     /* Flag to check lf_info initialization done or not.
        First thread entering LF stage should do the init */
@@ -169,10 +192,9 @@ typedef struct PrevFrameMtCheck {
 
 /* MT State information for each frame in parallel */
 typedef struct DecMTFrameData {
-    uint32_t num_threads_cdefed; /*Should be Removed after PAD MT*/
-    uint32_t num_threads_lred; /*Should be Removed after PAD MT*/
-    uint32_t num_threads_exited;
-    Bool     end_flag;
+    DecBarrier cdef_barrier; /*Should be Removed after PAD MT*/
+    DecBarrier lr_barrier; /*Should be Removed after PAD MT*/
+    Bool       end_flag;
     Bool     start_motion_proj;
     Bool     start_parse_frame;
     Bool     start_decode_frame;
@@ -186,7 +208,6 @@ typedef struct DecMTFrameData {
 
     /* Motion Field Projection Info*/
     DecMtMotionProjInfo motion_proj_info;
-    uint32_t            num_threads_header; /*ToDo : should remove */
 
     DecMtRowInfo parse_tile_info;
     DecMtRowInfo recon_tile_info;
@@ -241,11 +262,23 @@ typedef struct DecMTFrameData {
     int32_t sb_cols;
     int32_t sb_rows;
 
+    /* Progress of each stage, bumped after every update of its row maps and
+       top-right sync arrays so that the threads waiting on them can sleep */
+    CondVar motion_proj_progress;
+    CondVar parse_progress;
+    CondVar recon_progress;
+    CondVar lf_progress;
+    CondVar cdef_progress;
+    CondVar lr_progress;
+
 #if MT_WAIT_PROFILE
     FILE *fp;
 #endif
 } DecMtFrameData;
 
+void dec_barrier_wait(DecMtFrameData *dec_mt_frame_data, DecBarrier *barrier, uint32_t num_threads,
+                      void (*last_fn)(DecMtFrameData *dec_mt_frame_data));
+
 #ifdef __cplusplus
 }
 #endif
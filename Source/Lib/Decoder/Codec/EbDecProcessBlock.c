@@ -199,8 +199,7 @@ void svt_aom_decode_block(DecModCtxt *dec_mod_ctxt, BlockModeInfo *mode_info, in
                 volatile int32_t *ref_sb_completed = (volatile int32_t *)&dec_mt_frame_data
                                                          ->parse_recon_tile_info_array[tiles_ctr]
                                                          .sb_recon_completed_in_row[ref_sb_tile_row];
-                while (*ref_sb_completed < ref_sb_tile_col + 1)
-                    ;
+                DEC_WAIT_PROGRESS(&dec_mt_frame_data->recon_progress, *ref_sb_completed >= ref_sb_tile_col + 1);
             }
         }
     }
@@ -76,7 +76,8 @@ static EbErrorType decode_tile_row(DecModCtxt *dec_mod_ctxt, TilesInfo *tile_inf
     int32_t sb_row_tile_start = (parse_recon_tile_info_array->tile_info.mi_row_start << MI_SIZE_LOG2) >>
         dec_mod_ctxt->seq_header->sb_size_log2;
 
-    int32_t sb_row_in_tile = sb_row - sb_row_tile_start;
+    int32_t         sb_row_in_tile = sb_row - sb_row_tile_start;
+    DecMtFrameData *mt_frame_data  = &frame_buf->dec_mt_frame_data;
 
     if (0 != sb_row_in_tile) {
         sb_completed_in_prev_row =
@@ -105,23 +106,25 @@ static EbErrorType decode_tile_row(DecModCtxt *dec_mod_ctxt, TilesInfo *tile_inf
         dec_mod_ctxt->cur_coeff[AOM_PLANE_V] = sb_info->sb_coeff[AOM_PLANE_V];
         /* Top-Right Sync*/
         if (sb_row_in_tile) {
-            while (*sb_completed_in_prev_row < MIN((sb_col + 2), tile_wd_in_sb))
-                ;
-            //Sleep(5); /* ToDo : Change */
+            DEC_WAIT_PROGRESS(&mt_frame_data->recon_progress,
+                              *sb_completed_in_prev_row >= MIN((sb_col + 2), tile_wd_in_sb));
         }
 
         svt_aom_decode_super_block(dec_mod_ctxt, mi_row, mi_col, sb_info);
         *sb_completed_in_row = (uint32_t)(sb_col + 1);
+        svt_add_cond_var(&mt_frame_data->recon_progress, 1);
     }
 
-    DecMtFrameData *mt_frame_data = &frame_buf->dec_mt_frame_data;
-    int             index         = mi_row / dec_mod_ctxt->seq_header->sb_mi_size;
+    int index = mi_row / dec_mod_ctxt->seq_header->sb_mi_size;
     mt_frame_data->sb_recon_row_map[(index * tile_info->tile_cols) + tile_col] = 1;
+    svt_add_cond_var(&mt_frame_data->recon_progress, 1);
     return status;
 }
 EbErrorType decode_tile(DecModCtxt *dec_mod_ctxt, TilesInfo *tile_info,
                         DecMtParseReconTileInfo *parse_recon_tile_info_array, int32_t tile_col) {
-    EbErrorType status = EB_ErrorNone;
+    EbErrorType     status            = EB_ErrorNone;
+    EbDecHandle    *dec_handle_ptr    = (EbDecHandle *)(dec_mod_ctxt->dec_handle_ptr);
+    DecMtFrameData *dec_mt_frame_data = &dec_handle_ptr->main_frame_buf.cur_frame_bufs[0].dec_mt_frame_data;
 
     while (1) {
         int32_t sb_row_in_tile = -1;
@@ -145,8 +148,7 @@ EbErrorType decode_tile(DecModCtxt *dec_mod_ctxt, TilesInfo *tile_info,
         if (-1 != sb_row_in_tile) {
             volatile int32_t *sb_row_parsed =
                 (volatile int32_t *)&parse_recon_tile_info_array->sb_recon_row_parsed[sb_row_in_tile];
-            while (0 == *sb_row_parsed)
-                ;
+            DEC_WAIT_PROGRESS(&dec_mt_frame_data->parse_progress, 0 != *sb_row_parsed);
 
             int32_t sb_row = sb_row_in_tile + sb_row_tile_start;
 
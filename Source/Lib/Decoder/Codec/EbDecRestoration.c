@@ -256,9 +256,8 @@ void svt_aom_dec_av1_loop_restoration_filter_row(EbDecHandle *dec_handle, int32_
     int32_t sb_row_idx = (is_mt == 0) ? 0 : sb_row;
     int32_t index      = lr_ctxt->is_thread_min ? thread_cnt : sb_row_idx;
 
+    DecMtFrameData *dec_mt_frame_data = &dec_handle->main_frame_buf.cur_frame_bufs[0].dec_mt_frame_data;
     if (is_mt) {
-        DecMtFrameData *dec_mt_frame_data = &dec_handle->main_frame_buf.cur_frame_bufs[0].dec_mt_frame_data;
-
         if (sb_row) {
             sb_lr_completed_in_prev_row = (volatile int32_t *)&dec_mt_frame_data->sb_lr_completed_in_row[sb_row - 1];
         }
@@ -275,8 +274,7 @@ void svt_aom_dec_av1_loop_restoration_filter_row(EbDecHandle *dec_handle, int32_
             if (sb_row) {
                 if (col_y >= tile_w_y - w_y)
                     nsync = 0;
-                while (*sb_lr_completed_in_prev_row < (sb_col_y + nsync))
-                    ;
+                DEC_WAIT_PROGRESS(&dec_mt_frame_data->lr_progress, *sb_lr_completed_in_prev_row >= (sb_col_y + nsync));
             }
         }
         int      sx = 0, sy = 0;
@@ -422,6 +420,7 @@ void svt_aom_dec_av1_loop_restoration_filter_row(EbDecHandle *dec_handle, int32_
 
         if (is_mt) {
             *sb_lr_completed_in_row = sb_col_y;
+            svt_add_cond_var(&dec_mt_frame_data->lr_progress, 1);
         }
     }
 }
@@ -76,6 +76,7 @@ enum {
 
 int         svt_aom_get_qindex(SegmentationParams *seg_params, int segment_id, int base_q_idx);
 void        svt_setup_motion_field(EbDecHandle *dec_handle, DecThreadCtxt *thread_ctxt);
+void        svt_wait_motion_field_rows(EbDecHandle *dec_handle, uint32_t mi_row);
 EbErrorType svt_aom_decode_multiple_obu(EbDecHandle *dec_handle_ptr, uint8_t **data, size_t data_size,
                                         uint32_t is_annexb);
 
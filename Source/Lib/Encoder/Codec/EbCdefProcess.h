@@ -20,6 +20,6 @@
  **************************************/
 extern EbErrorType svt_aom_cdef_context_ctor(EbThreadContext *thread_ctx, const EbEncHandle *enc_handle_ptr, int index);
 
-extern void *svt_aom_cdef_kernel(void *input_ptr);
+extern void svt_aom_cdef_task(void *input_ptr, EbObjectWrapper *in_wrapper_ptr);
 
 #endif
@@ -1679,6 +1679,78 @@ static void prepare_input_picture(SequenceControlSet *scs, PictureControlSet *pc
 *   Coefficient Samples
 *
 *******************************************/
+/*
+ * Save the coded blocks of the mode decision of the SB, so that a recode of the frame at a close qindex can replay
+ * them with svt_aom_recode_restore_md() instead of running PD0/PD1 again.
+ */
+EB_EXTERN void svt_aom_recode_save_md(SequenceControlSet *scs, PictureControlSet *pcs, SuperBlock *sb_ptr,
+                                      uint32_t sb_addr, ModeDecisionContext *md_ctx) {
+    uint32_t recode_blk_itr = 0;
+    uint32_t blk_it         = 0;
+    while (blk_it < scs->max_block_cnt) {
+        const BlkStruct *blk_ptr  = &md_ctx->md_blk_arr_nsq[blk_it];
+        const BlockGeom *blk_geom = get_blk_geom_mds(blk_it);
+        if (blk_ptr->part == PARTITION_SPLIT) {
+            blk_it += blk_geom->d1_depth_offset;
+            continue;
+        }
+        uint32_t d1_start_blk = blk_it +
+            (blk_geom->sq_size == 128 ? ns_blk_offset_128[blk_ptr->part] : ns_blk_offset[blk_ptr->part]);
+        uint32_t num_d1_block = ns_blk_num[blk_ptr->part];
+        for (uint32_t d1_itr = d1_start_blk; d1_itr < (d1_start_blk + num_d1_block); d1_itr++) {
+            if (!pcs->ppcs->sb_geom[sb_addr].block_is_allowed[d1_itr])
+                continue;
+            sb_ptr->recode_blk_arr[recode_blk_itr]  = md_ctx->md_blk_arr_nsq[d1_itr];
+            sb_ptr->recode_xd_arr[recode_blk_itr++] = *md_ctx->md_blk_arr_nsq[d1_itr].av1xd;
+        }
+        blk_it += blk_geom->ns_depth_offset;
+    }
+    sb_ptr->recode_pd1_level = md_ctx->lpd1_ctrls.pd1_level;
+}
+
+/*
+ * Restore the coded blocks saved by svt_aom_recode_save_md() to the mode decision context, ready for the encode pass
+ * at the qindex of the recode. The partitioning is read from the SB, which holds the one of the saved mode decision.
+ */
+EB_EXTERN void svt_aom_recode_restore_md(SequenceControlSet *scs, PictureControlSet *pcs, SuperBlock *sb_ptr,
+                                         uint32_t sb_addr, ModeDecisionContext *md_ctx) {
+    uint32_t recode_blk_itr = 0;
+    uint32_t blk_it         = 0;
+    while (blk_it < scs->max_block_cnt) {
+        BlkStruct       *blk_ptr  = &md_ctx->md_blk_arr_nsq[blk_it];
+        const BlockGeom *blk_geom = get_blk_geom_mds(blk_it);
+        blk_ptr->part             = sb_ptr->cu_partition_array[blk_it];
+        if (blk_ptr->part == PARTITION_SPLIT) {
+            blk_it += blk_geom->d1_depth_offset;
+            continue;
+        }
+        uint32_t d1_start_blk = blk_it +
+            (blk_geom->sq_size == 128 ? ns_blk_offset_128[blk_ptr->part] : ns_blk_offset[blk_ptr->part]);
+        uint32_t num_d1_block = ns_blk_num[blk_ptr->part];
+        for (uint32_t d1_itr = d1_start_blk; d1_itr < (d1_start_blk + num_d1_block); d1_itr++) {
+            if (!pcs->ppcs->sb_geom[sb_addr].block_is_allowed[d1_itr])
+                continue;
+            BlkStruct      *dst     = &md_ctx->md_blk_arr_nsq[d1_itr];
+            const BlkStruct ctx_blk = *dst;
+            *dst                    = sb_ptr->recode_blk_arr[recode_blk_itr];
+            *ctx_blk.av1xd          = sb_ptr->recode_xd_arr[recode_blk_itr++];
+            // Keep the buffers of the mode decision context running the recode
+            dst->av1xd = ctx_blk.av1xd;
+            for (int plane = 0; plane < 3; plane++) {
+                dst->neigh_left_recon[plane]       = ctx_blk.neigh_left_recon[plane];
+                dst->neigh_top_recon[plane]        = ctx_blk.neigh_top_recon[plane];
+                dst->neigh_left_recon_16bit[plane] = ctx_blk.neigh_left_recon_16bit[plane];
+                dst->neigh_top_recon_16bit[plane]  = ctx_blk.neigh_top_recon_16bit[plane];
+            }
+            dst->coeff_tmp    = ctx_blk.coeff_tmp;
+            dst->recon_tmp    = ctx_blk.recon_tmp;
+            dst->palette_info = ctx_blk.palette_info;
+            dst->palette_mem  = ctx_blk.palette_mem;
+            dst->qindex       = md_ctx->qp_index;
+        }
+        blk_it += blk_geom->ns_depth_offset;
+    }
+}
 EB_EXTERN void svt_aom_encode_decode(SequenceControlSet *scs, PictureControlSet *pcs, SuperBlock *sb_ptr,
                                      uint32_t sb_addr, uint32_t sb_org_x, uint32_t sb_org_y, EncDecContext *ctx) {
     Bool                 is_16bit = ctx->is_16bit;
@@ -1909,9 +1981,6 @@ EB_EXTERN EbErrorType svt_aom_encdec_update(SequenceControlSet *scs, PictureCont
                 pcs->sb_skip[sb_addr] = 0;
             }
             pcs->sb_count_nz_coeffs[sb_addr] += md_ctx->blk_ptr->cnt_nz_coeff;
-            svt_block_on_mutex(pcs->ppcs->pcs_total_rate_mutex);
-            pcs->ppcs->pcs_total_rate += blk_ptr->total_rate;
-            svt_release_mutex(pcs->ppcs->pcs_total_rate_mutex);
             // Copy recon to EncDec buffers if EncDec was bypassed;  if used pred depth only and NSQ is OFF data was copied directly to EncDec buffers in MD
             if (md_ctx->bypass_encdec && !(md_ctx->fixed_partition)) {
                 if (md_ctx->encoder_bit_depth > EB_EIGHT_BIT) {
@@ -1996,7 +2065,8 @@ EB_EXTERN EbErrorType svt_aom_encdec_update(SequenceControlSet *scs, PictureCont
             } // END COPY RECON
 
             // Loop over TX units only if needed
-            if (pcs->cdf_ctrl.update_coef || (md_ctx->bypass_encdec && !(md_ctx->fixed_partition))) {
+            if (pcs->cdf_ctrl.update_coef || pcs->recode_reuse_md ||
+                (md_ctx->bypass_encdec && !(md_ctx->fixed_partition))) {
                 ctx->is_inter = (blk_ptr->prediction_mode_flag == INTER_MODE || blk_ptr->use_intrabc);
 
                 // Initialize the Transform Loop
@@ -2008,6 +2078,7 @@ EB_EXTERN EbErrorType svt_aom_encdec_update(SequenceControlSet *scs, PictureCont
                 EbPictureBufferDesc *coeff_buffer_sb  = pcs->ppcs->enc_dec_ptr->quantized_coeff[sb_addr];
                 uint32_t             txb_1d_offset    = 0;
                 uint32_t             txb_1d_offset_uv = 0;
+                uint64_t             coeff_rate       = 0;
 
                 for (uint16_t tu_it = 0; tu_it < tot_tu; tu_it++) {
                     uint8_t uv_pass       = blk_ptr->tx_depth && tu_it ? 0 : 1; //NM: 128x128 exeption
@@ -2049,8 +2120,9 @@ EB_EXTERN EbErrorType svt_aom_encdec_update(SequenceControlSet *scs, PictureCont
                         }
                     } // END COPY COEFFS
 
-                    // Perform CDF update (MD feature) if enabled
-                    if (pcs->cdf_ctrl.update_coef) {
+                    // Perform CDF update (MD feature) if enabled, re-estimate the coefficients rate of a recode
+                    // without mode decision
+                    if (pcs->cdf_ctrl.update_coef || pcs->recode_reuse_md) {
                         md_ctx->luma_txb_skip_context = 0;
                         md_ctx->luma_dc_sign_context  = 0;
                         svt_aom_get_txb_ctx(pcs,
@@ -2098,10 +2170,13 @@ EB_EXTERN EbErrorType svt_aom_encdec_update(SequenceControlSet *scs, PictureCont
                         // Rate estimation function uses the values from CandidatePtr. The right values are copied from blk_ptr to CandidatePtr
                         cand_bf->cand->pred_mode         = blk_ptr->pred_mode;
                         cand_bf->cand->filter_intra_mode = blk_ptr->filter_intra_mode;
-                        if (blk_ptr->block_has_coeff)
+                        // The coefficients are rated with the CDFs left as they are, the CDF update returning no rate
+                        for (uint8_t update_cdf = !pcs->recode_reuse_md;
+                             blk_ptr->block_has_coeff && update_cdf <= pcs->cdf_ctrl.update_coef;
+                             update_cdf++) {
                             svt_aom_txb_estimate_coeff_bits(
                                 md_ctx,
-                                1, //allow_update_cdf,
+                                update_cdf, //allow_update_cdf,
                                 &pcs->ec_ctx_array[sb_addr],
                                 pcs,
                                 cand_bf,
@@ -2119,6 +2194,10 @@ EB_EXTERN EbErrorType svt_aom_encdec_update(SequenceControlSet *scs, PictureCont
                                 blk_ptr->tx_type[ctx->txb_itr],
                                 blk_ptr->tx_type_uv,
                                 (blk_geom->has_uv && uv_pass) ? COMPONENT_ALL : COMPONENT_LUMA);
+                            if (!update_cdf)
+                                coeff_rate += y_txb_coeff_bits +
+                                    ((blk_geom->has_uv && uv_pass) ? cb_txb_coeff_bits + cr_txb_coeff_bits : 0);
+                        }
 
                         // Update the luma DC Sign Level Coeff Neighbor Array
                         uint8_t dc_sign_level_coeff = (uint8_t)blk_ptr->quant_dc.y[ctx->txb_itr];
@@ -2169,7 +2248,13 @@ EB_EXTERN EbErrorType svt_aom_encdec_update(SequenceControlSet *scs, PictureCont
                         ctx->coded_area_sb_uv += blk_geom->tx_width_uv[blk_ptr->tx_depth] *
                             blk_geom->tx_height_uv[blk_ptr->tx_depth];
                 }
+                // The coefficients of a recode without mode decision are not the ones rated by the mode decision
+                if (pcs->recode_reuse_md)
+                    blk_ptr->total_rate = blk_ptr->total_rate - blk_ptr->coeff_rate + coeff_rate;
             }
+            svt_block_on_mutex(pcs->ppcs->pcs_total_rate_mutex);
+            pcs->ppcs->pcs_total_rate += blk_ptr->total_rate;
+            svt_release_mutex(pcs->ppcs->pcs_total_rate_mutex);
             if (!md_ctx->bypass_encdec) {
                 md_ctx->blk_org_x = ctx->blk_org_x;
                 md_ctx->blk_org_y = ctx->blk_org_y;
@@ -32,6 +32,10 @@ void svt_aom_mode_decision_sb(SequenceControlSet *scs, PictureControlSet *pcs, M
                               const MdcSbData *const mdcResultTbPtr);
 extern void svt_aom_encode_decode(SequenceControlSet *scs, PictureControlSet *pcs, SuperBlock *sb_ptr, uint32_t sb_addr,
                                   uint32_t sb_origin_x, uint32_t sb_origin_y, EncDecContext *ed_ctx);
+extern void svt_aom_recode_save_md(SequenceControlSet *scs, PictureControlSet *pcs, SuperBlock *sb_ptr,
+                                   uint32_t sb_addr, ModeDecisionContext *md_ctx);
+extern void svt_aom_recode_restore_md(SequenceControlSet *scs, PictureControlSet *pcs, SuperBlock *sb_ptr,
+                                      uint32_t sb_addr, ModeDecisionContext *md_ctx);
 extern EbErrorType svt_aom_encdec_update(SequenceControlSet *scs, PictureControlSet *pcs, SuperBlock *sb_ptr,
                                          uint32_t sb_addr, uint32_t sb_origin_x, uint32_t sb_origin_y,
                                          EncDecContext *ed_ctx);
@@ -21,6 +21,8 @@ void svt_aom_largest_coding_unit_dctor(EbPtr p) {
     EB_FREE_ARRAY(obj->av1xd);
     EB_FREE_ARRAY(obj->final_blk_arr);
     EB_FREE_ARRAY(obj->cu_partition_array);
+    EB_FREE_ARRAY(obj->recode_blk_arr);
+    EB_FREE_ARRAY(obj->recode_xd_arr);
 }
 /*
 Tasks & Questions
@@ -33,7 +35,7 @@ Tasks & Questions
 */
 EbErrorType svt_aom_largest_coding_unit_ctor(SuperBlock *larget_coding_unit_ptr, uint8_t sb_size_pix,
                                              uint16_t sb_origin_x, uint16_t sb_origin_y, uint16_t sb_index,
-                                             EncMode enc_mode, uint16_t max_block_cnt,
+                                             EncMode enc_mode, uint16_t max_block_cnt, Bool recode_reuse_md,
                                              PictureControlSet *picture_control_set)
 
 {
@@ -86,5 +88,9 @@ EbErrorType svt_aom_largest_coding_unit_ctor(SuperBlock *larget_coding_unit_ptr,
     // Malloc maximum but only initialize it only when actually used.
     // This will help to same actually memory usage
     EB_MALLOC_ARRAY(larget_coding_unit_ptr->cu_partition_array, max_block_cnt);
+    if (recode_reuse_md) {
+        EB_MALLOC_ARRAY(larget_coding_unit_ptr->recode_blk_arr, tot_blk_num);
+        EB_MALLOC_ARRAY(larget_coding_unit_ptr->recode_xd_arr, tot_blk_num);
+    }
     return EB_ErrorNone;
 }
@@ -198,6 +198,8 @@ typedef struct BlkStruct {
     // svt_aom_d2_inter_depth_block_decision()
     uint64_t     default_cost;
     uint64_t     total_rate;
+    // Rate of the coefficients within total_rate
+    uint64_t     coeff_rate;
     uint32_t     full_dist;
     QuantDcData  quant_dc;
     EobData      eob;
@@ -342,11 +344,15 @@ typedef struct SuperBlock {
     uint8_t        qindex;
     TileInfo       tile_info;
     uint16_t       final_blk_cnt; // number of block(s) posted from EncDec to EC
+    // Coded blocks of the last mode decision of the SB, in coding order, replayed by a recode of the frame
+    BlkStruct     *recode_blk_arr;
+    MacroBlockD   *recode_xd_arr;
+    uint8_t        recode_pd1_level; // PD1 level of the last mode decision of the SB
 } SuperBlock;
 
 extern EbErrorType svt_aom_largest_coding_unit_ctor(SuperBlock *larget_coding_unit_ptr, uint8_t sb_size,
                                                     uint16_t sb_origin_x, uint16_t sb_origin_y, uint16_t sb_index,
-                                                    EncMode enc_mode, uint16_t max_block_cnt,
+                                                    EncMode enc_mode, uint16_t max_block_cnt, Bool recode_reuse_md,
 
                                                     struct PictureControlSet *picture_control_set);
 
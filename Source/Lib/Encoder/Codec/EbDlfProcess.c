@@ -11,11 +11,13 @@
 */
 
 #include <stdlib.h>
+#include <string.h>
 #include "EbEncHandle.h"
 #include "EbDlfProcess.h"
 #include "EbEncDecResults.h"
 #include "EbReferenceObject.h"
 #include "EbDeblockingFilter.h"
+#include "EbCdef.h"
 #include "EbDefinitions.h"
 #include "EbSequenceControlSet.h"
 #include "EbPictureControlSet.h"
@@ -49,10 +51,125 @@ EbErrorType svt_aom_dlf_context_ctor(EbThreadContext *thread_ctx, const EbEncHan
     return EB_ErrorNone;
 }
 
+// Sets the recon and source planes the CDEF search reads
+static void set_cdef_input(PictureControlSet *pcs, Bool is_16bit) {
+    EbPictureBufferDesc *recon_pic;
+    svt_aom_get_recon_pic(pcs, &recon_pic, is_16bit);
+    const uint32_t offset_y  = recon_pic->org_x + recon_pic->org_y * recon_pic->stride_y;
+    pcs->cdef_input_recon[0] = recon_pic->buffer_y + (offset_y << is_16bit);
+    const uint32_t offset_cb = (recon_pic->org_x + recon_pic->org_y * recon_pic->stride_cb) >> 1;
+    pcs->cdef_input_recon[1] = recon_pic->buffer_cb + (offset_cb << is_16bit);
+    const uint32_t offset_cr = (recon_pic->org_x + recon_pic->org_y * recon_pic->stride_cr) >> 1;
+    pcs->cdef_input_recon[2] = recon_pic->buffer_cr + (offset_cr << is_16bit);
+
+    EbPictureBufferDesc *input_pic      = is_16bit ? pcs->input_frame16bit : pcs->ppcs->enhanced_pic;
+    const uint32_t       input_offset_y = input_pic->org_x + input_pic->org_y * input_pic->stride_y;
+    pcs->cdef_input_source[0]           = input_pic->buffer_y + (input_offset_y << is_16bit);
+    const uint32_t input_offset_cb      = (input_pic->org_x + input_pic->org_y * input_pic->stride_cb) >> 1;
+    pcs->cdef_input_source[1]           = input_pic->buffer_cb + (input_offset_cb << is_16bit);
+    const uint32_t input_offset_cr      = (input_pic->org_x + input_pic->org_y * input_pic->stride_cr) >> 1;
+    pcs->cdef_input_source[2]           = input_pic->buffer_cr + (input_offset_cr << is_16bit);
+}
+
+// Posts the CDEF segments of the segment rows [first_row, end_row)
+static void post_cdef_segments(PictureControlSet *pcs, EbObjectWrapper *pcs_wrapper, EbFifo *dlf_output_fifo_ptr,
+                               uint32_t first_row, uint32_t end_row) {
+    for (uint32_t segment_index = first_row * pcs->cdef_segments_column_count;
+         segment_index < end_row * pcs->cdef_segments_column_count;
+         ++segment_index) {
+        EbObjectWrapper *dlf_results_wrapper;
+        // Get Empty DLF Results to Cdef
+        svt_get_empty_object(dlf_output_fifo_ptr, &dlf_results_wrapper);
+        DlfResults *dlf_results    = (DlfResults *)dlf_results_wrapper->object_ptr;
+        dlf_results->pcs_wrapper   = pcs_wrapper;
+        dlf_results->segment_index = segment_index;
+        // Post DLF Results
+        svt_post_full_object(dlf_results_wrapper);
+    }
+}
+
+/******************************************************
+ * svt_aom_cdef_row_sync_init
+ *   Decides if the CDEF search of the picture starts while the enc-dec
+ *   is still coding it. The search reads the deblocked recon and the
+ *   source only, and the recon is final SB row after SB row when the
+ *   deblocking runs per SB in the enc-dec. Pictures that may be re-encoded
+ *   and pictures whose CDEF input is prepared by the DLF task keep the
+ *   picture level hand-off. The segments are one row of 64x64 blocks high.
+ ******************************************************/
+void svt_aom_cdef_row_sync_init(PictureControlSet *pcs, Bool superres_recode) {
+    PictureParentControlSet *ppcs       = pcs->ppcs;
+    SequenceControlSet      *scs        = pcs->scs;
+    const Bool               is_16bit   = scs->is_16bit_pipeline;
+    const uint16_t           tg_count   = ppcs->tile_group_cols * ppcs->tile_group_rows;
+    const Bool               may_recode = superres_recode || ppcs->superres_total_recode_loop ||
+        ((scs->static_config.rate_control_mode == SVT_AV1_RC_MODE_VBR || scs->static_config.max_bit_rate != 0) &&
+         scs->enc_ctx->recode_loop != DISALLOW_RECODE);
+
+    pcs->cdef_row_sync = scs->cdef_segment_row_count > 1 && tg_count == 1 && !may_recode &&
+        scs->seq_header.cdef_level && ppcs->cdef_level && !ppcs->cdef_ctrls.use_reference_cdef_fs &&
+        (!ppcs->dlf_ctrls.enabled || ppcs->dlf_ctrls.sb_based_dlf) &&
+        !(is_16bit && scs->static_config.encoder_bit_depth == EB_EIGHT_BIT) && !svt_aom_is_pic_skipped(ppcs);
+    if (!pcs->cdef_row_sync)
+        return;
+
+    set_cdef_input(pcs, is_16bit);
+    const uint32_t b64_pic_height   = (ppcs->aligned_height + 64 - 1) / 64;
+    const uint16_t pic_height_in_sb = (ppcs->aligned_height + scs->sb_size - 1) / scs->sb_size;
+    pcs->cdef_segments_column_count = scs->cdef_segment_column_count;
+    pcs->cdef_segments_row_count    = (uint8_t)MIN(b64_pic_height, UINT8_MAX);
+    pcs->cdef_segments_total_count  = (uint16_t)(pcs->cdef_segments_column_count * pcs->cdef_segments_row_count);
+    pcs->tot_seg_searched_cdef      = 0;
+    memset(pcs->enc_dec_row_coded_sb_count, 0, sizeof(*pcs->enc_dec_row_coded_sb_count) * pic_height_in_sb);
+    pcs->enc_dec_coded_sb_rows     = 0;
+    pcs->cdef_row_sync_posted_rows = 0;
+}
+
+// Returns TRUE when the recon read by the CDEF search of the segment row is final. The lines of an
+// SB row are deblocked when the SB row is coded, except the bottom ones filtered with the next SB row.
+static Bool cdef_segment_row_ready(PictureControlSet *pcs, uint32_t segment_row, uint16_t pic_height_in_sb) {
+    const uint32_t sb_size        = pcs->scs->sb_size;
+    const uint32_t b64_pic_height = (pcs->ppcs->aligned_height + 64 - 1) / 64;
+    const uint32_t b64_end_idx    = SEGMENT_END_IDX(segment_row, b64_pic_height, pcs->cdef_segments_row_count);
+    // one more 64x64 row for the 64x128 blocks of 128x128 SBs, and the border read by the filter
+    const uint32_t y_end   = MIN(pcs->ppcs->aligned_height, (b64_end_idx + (sb_size == 128)) * 64 + CDEF_VBORDER);
+    const uint32_t y_last  = y_end - 1;
+    const uint32_t sb_rows = MIN(pic_height_in_sb, y_last / sb_size + 1 + (y_last % sb_size >= sb_size - 8));
+    return pcs->enc_dec_coded_sb_rows >= sb_rows;
+}
+
+/******************************************************
+ * svt_aom_cdef_row_sync_sb_done
+ *   Called by the enc-dec once an SB is coded. Posts the CDEF segments
+ *   that became ready. The last row of segments is always posted by the
+ *   DLF task, so the frame level CDEF and restoration work that follows
+ *   the search runs after the DLF prep.
+ ******************************************************/
+void svt_aom_cdef_row_sync_sb_done(PictureControlSet *pcs, EbObjectWrapper *pcs_wrapper, EbFifo *dlf_output_fifo_ptr,
+                                   uint32_t sb_origin_y) {
+    const uint32_t sb_size          = pcs->scs->sb_size;
+    const uint16_t pic_width_in_sb  = (pcs->ppcs->aligned_width + sb_size - 1) / sb_size;
+    const uint16_t pic_height_in_sb = (pcs->ppcs->aligned_height + sb_size - 1) / sb_size;
+
+    svt_block_on_mutex(pcs->cdef_row_sync_mutex);
+    pcs->enc_dec_row_coded_sb_count[sb_origin_y / sb_size]++;
+    while (pcs->enc_dec_coded_sb_rows < pic_height_in_sb &&
+           pcs->enc_dec_row_coded_sb_count[pcs->enc_dec_coded_sb_rows] == pic_width_in_sb)
+        pcs->enc_dec_coded_sb_rows++;
+    const uint32_t first_row = pcs->cdef_row_sync_posted_rows;
+    uint32_t       end_row   = first_row;
+    while (end_row + 1 < pcs->cdef_segments_row_count && cdef_segment_row_ready(pcs, end_row, pic_height_in_sb))
+        end_row++;
+    pcs->cdef_row_sync_posted_rows = (uint16_t)end_row;
+    svt_release_mutex(pcs->cdef_row_sync_mutex);
+
+    post_cdef_segments(pcs, pcs_wrapper, dlf_output_fifo_ptr, first_row, end_row);
+}
+
 /******************************************************
  * Dlf Kernel
  ******************************************************/
-void *svt_aom_dlf_kernel(void *input_ptr) {
+void svt_aom_dlf_task(void *input_ptr, EbObjectWrapper *enc_dec_results_wrapper) {
     // Context & SCS & PCS
     EbThreadContext    *thread_ctx  = (EbThreadContext *)input_ptr;
     DlfContext         *context_ptr = (DlfContext *)thread_ctx->priv;
@@ -60,101 +177,76 @@ void *svt_aom_dlf_kernel(void *input_ptr) {
     SequenceControlSet *scs;
 
     //// Input
-    EbObjectWrapper *enc_dec_results_wrapper;
-    EncDecResults   *enc_dec_results;
-
-    //// Output
-    EbObjectWrapper   *dlf_results_wrapper;
-    struct DlfResults *dlf_results;
+    EncDecResults *enc_dec_results;
 
     // SB Loop variables
-    for (;;) {
-        // Get EncDec Results
-        EB_GET_FULL_OBJECT(context_ptr->dlf_input_fifo_ptr, &enc_dec_results_wrapper);
-
-        enc_dec_results               = (EncDecResults *)enc_dec_results_wrapper->object_ptr;
-        pcs                           = (PictureControlSet *)enc_dec_results->pcs_wrapper->object_ptr;
-        PictureParentControlSet *ppcs = pcs->ppcs;
-        scs                           = pcs->scs;
-
-        Bool is_16bit = scs->is_16bit_pipeline;
-        if (is_16bit && scs->static_config.encoder_bit_depth == EB_EIGHT_BIT) {
-            svt_convert_pic_8bit_to_16bit(pcs->ppcs->enhanced_pic,
-                                          pcs->input_frame16bit,
-                                          pcs->ppcs->scs->subsampling_x,
-                                          pcs->ppcs->scs->subsampling_y);
-            // convert 8-bit recon to 16-bit for it bypass encdec process
-            if (pcs->pic_bypass_encdec) {
-                EbPictureBufferDesc *recon_pic;
-                EbPictureBufferDesc *recon_picture_16bit_ptr;
-                svt_aom_get_recon_pic(pcs, &recon_pic, 0);
-                svt_aom_get_recon_pic(pcs, &recon_picture_16bit_ptr, 1);
-                svt_convert_pic_8bit_to_16bit(
-                    recon_pic, recon_picture_16bit_ptr, pcs->ppcs->scs->subsampling_x, pcs->ppcs->scs->subsampling_y);
-            }
-        }
-        Bool           dlf_enable_flag = (Bool)pcs->ppcs->dlf_ctrls.enabled;
-        const uint16_t tg_count        = pcs->ppcs->tile_group_cols * pcs->ppcs->tile_group_rows;
-        // Move sb level lf to here if tile_parallel
-        if ((dlf_enable_flag && !pcs->ppcs->dlf_ctrls.sb_based_dlf) ||
-            (dlf_enable_flag && pcs->ppcs->dlf_ctrls.sb_based_dlf && tg_count > 1)) {
-            EbPictureBufferDesc *recon_buffer;
-            svt_aom_get_recon_pic(pcs, &recon_buffer, is_16bit);
-            svt_av1_loop_filter_init(pcs);
-            svt_av1_pick_filter_level((EbPictureBufferDesc *)pcs->ppcs->enhanced_pic, pcs, LPF_PICK_FROM_FULL_IMAGE);
-
-            svt_av1_loop_filter_frame(recon_buffer, pcs, 0, 3);
+    enc_dec_results               = (EncDecResults *)enc_dec_results_wrapper->object_ptr;
+    pcs                           = (PictureControlSet *)enc_dec_results->pcs_wrapper->object_ptr;
+    PictureParentControlSet *ppcs = pcs->ppcs;
+    scs                           = pcs->scs;
+
+    Bool is_16bit = scs->is_16bit_pipeline;
+    if (is_16bit && scs->static_config.encoder_bit_depth == EB_EIGHT_BIT) {
+        svt_convert_pic_8bit_to_16bit(pcs->ppcs->enhanced_pic,
+                                      pcs->input_frame16bit,
+                                      pcs->ppcs->scs->subsampling_x,
+                                      pcs->ppcs->scs->subsampling_y);
+        // convert 8-bit recon to 16-bit for it bypass encdec process
+        if (pcs->pic_bypass_encdec) {
+            EbPictureBufferDesc *recon_pic;
+            EbPictureBufferDesc *recon_picture_16bit_ptr;
+            svt_aom_get_recon_pic(pcs, &recon_pic, 0);
+            svt_aom_get_recon_pic(pcs, &recon_picture_16bit_ptr, 1);
+            svt_convert_pic_8bit_to_16bit(
+                recon_pic, recon_picture_16bit_ptr, pcs->ppcs->scs->subsampling_x, pcs->ppcs->scs->subsampling_y);
         }
+    }
+    Bool           dlf_enable_flag = (Bool)pcs->ppcs->dlf_ctrls.enabled;
+    const uint16_t tg_count        = pcs->ppcs->tile_group_cols * pcs->ppcs->tile_group_rows;
+    // Move sb level lf to here if tile_parallel
+    if ((dlf_enable_flag && !pcs->ppcs->dlf_ctrls.sb_based_dlf) ||
+        (dlf_enable_flag && pcs->ppcs->dlf_ctrls.sb_based_dlf && tg_count > 1)) {
+        EbPictureBufferDesc *recon_buffer;
+        svt_aom_get_recon_pic(pcs, &recon_buffer, is_16bit);
+        svt_av1_loop_filter_init(pcs);
+        svt_av1_pick_filter_level((EbPictureBufferDesc *)pcs->ppcs->enhanced_pic, pcs, LPF_PICK_FROM_FULL_IMAGE);
+
+        svt_av1_loop_filter_frame(recon_buffer, pcs, 0, 3);
+    }
 
-        //pre-cdef prep
-        {
-            EbPictureBufferDesc *recon_pic;
-            svt_aom_get_recon_pic(pcs, &recon_pic, is_16bit);
-
-            Av1Common *cm = pcs->ppcs->av1_cm;
-            if (ppcs->enable_restoration) {
-                svt_aom_link_eb_to_aom_buffer_desc(
-                    recon_pic, cm->frame_to_show, scs->max_input_pad_right, scs->max_input_pad_bottom, is_16bit);
-                svt_av1_loop_restoration_save_boundary_lines(cm->frame_to_show, cm, 0);
-            }
-
-            if (scs->seq_header.cdef_level && pcs->ppcs->cdef_level) {
-                const uint32_t offset_y  = recon_pic->org_x + recon_pic->org_y * recon_pic->stride_y;
-                pcs->cdef_input_recon[0] = recon_pic->buffer_y + (offset_y << is_16bit);
-                const uint32_t offset_cb = (recon_pic->org_x + recon_pic->org_y * recon_pic->stride_cb) >> 1;
-                pcs->cdef_input_recon[1] = recon_pic->buffer_cb + (offset_cb << is_16bit);
-                const uint32_t offset_cr = (recon_pic->org_x + recon_pic->org_y * recon_pic->stride_cr) >> 1;
-                pcs->cdef_input_recon[2] = recon_pic->buffer_cr + (offset_cr << is_16bit);
-
-                EbPictureBufferDesc *input_pic      = is_16bit ? pcs->input_frame16bit : pcs->ppcs->enhanced_pic;
-                const uint32_t       input_offset_y = input_pic->org_x + input_pic->org_y * input_pic->stride_y;
-                pcs->cdef_input_source[0]           = input_pic->buffer_y + (input_offset_y << is_16bit);
-                const uint32_t input_offset_cb      = (input_pic->org_x + input_pic->org_y * input_pic->stride_cb) >> 1;
-                pcs->cdef_input_source[1]           = input_pic->buffer_cb + (input_offset_cb << is_16bit);
-                const uint32_t input_offset_cr      = (input_pic->org_x + input_pic->org_y * input_pic->stride_cr) >> 1;
-                pcs->cdef_input_source[2]           = input_pic->buffer_cr + (input_offset_cr << is_16bit);
-            }
+    //pre-cdef prep
+    {
+        EbPictureBufferDesc *recon_pic;
+        svt_aom_get_recon_pic(pcs, &recon_pic, is_16bit);
+
+        Av1Common *cm = pcs->ppcs->av1_cm;
+        if (ppcs->enable_restoration) {
+            svt_aom_link_eb_to_aom_buffer_desc(
+                recon_pic, cm->frame_to_show, scs->max_input_pad_right, scs->max_input_pad_bottom, is_16bit);
+            svt_av1_loop_restoration_save_boundary_lines(cm->frame_to_show, cm, 0);
         }
 
+        // the CDEF input is set before the enc-dec when the search follows it by SB rows
+        if (scs->seq_header.cdef_level && pcs->ppcs->cdef_level && !pcs->cdef_row_sync)
+            set_cdef_input(pcs, is_16bit);
+    }
+
+    if (pcs->cdef_row_sync) {
+        // Post the segments left by the enc-dec
+        post_cdef_segments(pcs,
+                           enc_dec_results->pcs_wrapper,
+                           context_ptr->dlf_output_fifo_ptr,
+                           pcs->cdef_row_sync_posted_rows,
+                           pcs->cdef_segments_row_count);
+    } else {
         pcs->cdef_segments_column_count = scs->cdef_segment_column_count;
         pcs->cdef_segments_row_count    = scs->cdef_segment_row_count;
         pcs->cdef_segments_total_count  = (uint16_t)(pcs->cdef_segments_column_count * pcs->cdef_segments_row_count);
         pcs->tot_seg_searched_cdef      = 0;
-        uint32_t segment_index;
-
-        for (segment_index = 0; segment_index < pcs->cdef_segments_total_count; ++segment_index) {
-            // Get Empty DLF Results to Cdef
-            svt_get_empty_object(context_ptr->dlf_output_fifo_ptr, &dlf_results_wrapper);
-            dlf_results                = (struct DlfResults *)dlf_results_wrapper->object_ptr;
-            dlf_results->pcs_wrapper   = enc_dec_results->pcs_wrapper;
-            dlf_results->segment_index = segment_index;
-            // Post DLF Results
-            svt_post_full_object(dlf_results_wrapper);
-        }
-
-        // Release EncDec Results
-        svt_release_object(enc_dec_results_wrapper);
+        post_cdef_segments(
+            pcs, enc_dec_results->pcs_wrapper, context_ptr->dlf_output_fifo_ptr, 0, pcs->cdef_segments_row_count);
     }
 
-    return NULL;
+    // Release EncDec Results
+    svt_release_object(enc_dec_results_wrapper);
 }
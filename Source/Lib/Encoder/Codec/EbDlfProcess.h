@@ -30,6 +30,10 @@ typedef struct DlfContext {
  **************************************/
 extern EbErrorType svt_aom_dlf_context_ctor(EbThreadContext *thread_ctx, const EbEncHandle *enc_handle_ptr, int index);
 
-extern void *svt_aom_dlf_kernel(void *input_ptr);
+extern void svt_aom_dlf_task(void *input_ptr, EbObjectWrapper *in_wrapper_ptr);
+// SB row pipelining of the CDEF search with the enc-dec
+extern void svt_aom_cdef_row_sync_init(PictureControlSet *pcs, Bool superres_recode);
+extern void svt_aom_cdef_row_sync_sb_done(PictureControlSet *pcs, EbObjectWrapper *pcs_wrapper,
+                                          EbFifo *dlf_output_fifo_ptr, uint32_t sb_origin_y);
 
 #endif // EbEntropyCodingProcess_h
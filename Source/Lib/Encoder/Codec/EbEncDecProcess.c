@@ -15,6 +15,7 @@
 #include "EbEncHandle.h"
 #include "EbEncDecTasks.h"
 #include "EbEncDecResults.h"
+#include "EbDlfProcess.h"
 #include "EbCodingLoop.h"
 #include "EbSvtAv1ErrorCodes.h"
 #include "EbUtility.h"
@@ -69,6 +70,10 @@ EbErrorType svt_aom_enc_dec_context_ctor(EbThreadContext *thread_ctx, const EbEn
         enc_handle_ptr->enc_dec_results_resource_ptr, index);
     ed_ctx->enc_dec_feedback_fifo_ptr = svt_system_resource_get_producer_fifo(
         enc_handle_ptr->enc_dec_tasks_resource_ptr, tasks_index);
+    // the enc-dec producers follow the DLF ones
+    ed_ctx->dlf_output_fifo_ptr = svt_system_resource_get_producer_fifo(
+        enc_handle_ptr->dlf_results_resource_ptr,
+        enc_handle_ptr->scs_instance_array[0]->scs->dlf_process_init_count + index);
 
     // Prediction Buffer
     ed_ctx->input_sample16bit_buffer = NULL;
@@ -1753,35 +1758,9 @@ void pad_ref_and_set_flags(PictureControlSet *pcs, SequenceControlSet *scs) {
     // set up the Slice Type
     ref_object->slice_type = pcs->ppcs->slice_type;
     ref_object->r0         = pcs->ppcs->r0;
-    if (pcs->ppcs->gm_ctrls.enabled && pcs->ppcs->gm_ctrls.use_ref_info) {
-        bool gm_need_full, gm_need_quart, gm_need_sixteen;
-
-        svt_aom_get_gm_needed_resolutions(
-            +pcs->ppcs->gm_ctrls.downsample_level, &gm_need_full, &gm_need_quart, &gm_need_sixteen);
-
-        if (gm_need_full) {
-            EbPictureBufferDesc *inp = pcs->ppcs->enhanced_pic;
-            uint8_t             *src = inp->buffer_y + inp->org_x + inp->org_y * inp->stride_y;
-
-            EbPictureBufferDesc *ref = ref_object->input_picture;
-            uint8_t             *dst = ref->buffer_y + ref->org_x + ref->org_y * ref->stride_y;
-
-            svt_aom_assert_err(inp->max_height == ref->max_height, "ERR BUF");
-            svt_aom_assert_err(inp->max_width == ref->max_width, "ERR BUF");
-            for (int j = 0; j < inp->max_height; j++)
-                memcpy(dst + j * ref->stride_y, src + j * inp->stride_y, inp->max_width);
-        }
-        if (gm_need_quart) {
-            EbPictureBufferDesc *ref = ref_object->quarter_reference_picture;
-            svt_aom_assert_err(pcs->ppcs->quarter_src_pic->luma_size == ref->luma_size, "ERR BUF");
-            memcpy(ref->buffer_y, pcs->ppcs->quarter_src_pic->buffer_y, ref->luma_size);
-        }
-        if (gm_need_sixteen) {
-            EbPictureBufferDesc *ref = ref_object->sixteenth_reference_picture;
-            svt_aom_assert_err(pcs->ppcs->sixteenth_src_pic->luma_size == ref->luma_size, "ERR BUF");
-            memcpy(ref->buffer_y, pcs->ppcs->sixteenth_src_pic->buffer_y, ref->luma_size);
-        }
-    }
+    // The global motion ref info reads the source planes of the PA reference object, shared rather than copied
+    if (pcs->ppcs->gm_pa_ref_wrapper)
+        svt_aom_reference_object_hold_gm_src(ref_object, pcs->ppcs);
 }
 /*
  * Generate depth removal settings
@@ -2717,6 +2696,26 @@ void svt_aom_sb_qp_derivation_tpl_la(PictureControlSet *pcs);
 void mode_decision_configuration_init_qp_update(PictureControlSet *pcs);
 void svt_aom_init_enc_dec_segement(PictureParentControlSet *ppcs);
 
+/* Whether the mode decision of an encoding of the frame can be replayed by a recode of the frame */
+static Bool recode_md_reusable(SequenceControlSet *scs, PictureControlSet *pcs) {
+    return scs->recode_ctrls.reuse_md && !pcs->ppcs->palette_level && !pcs->ppcs->frm_hdr.allow_intrabc &&
+        (scs->enc_ctx->recode_loop != ALLOW_RECODE_KFMAXBW || pcs->ppcs->frm_hdr.frame_type == KEY_FRAME);
+}
+
+/* Set up the SB for the encode pass of a recode replaying the saved mode decision */
+static void recode_replay_md(SequenceControlSet *scs, PictureControlSet *pcs, ModeDecisionContext *md_ctx,
+                             SuperBlock *sb_ptr, uint16_t sb_index) {
+    md_ctx->pd_pass              = PD_PASS_1;
+    md_ctx->lpd1_ctrls.pd1_level = sb_ptr->recode_pd1_level;
+    if (md_ctx->lpd1_ctrls.pd1_level > REGULAR_PD1)
+        svt_aom_sig_deriv_enc_dec_light_pd1(pcs, md_ctx);
+    else
+        svt_aom_sig_deriv_enc_dec(scs, pcs, md_ctx);
+    // The blocks are quantized and reconstructed at the new qindex by the encode pass
+    md_ctx->bypass_encdec = 0;
+    svt_aom_recode_restore_md(scs, pcs, sb_ptr, sb_index, md_ctx);
+}
+
 static void recode_loop_decision_maker(PictureControlSet *pcs, SequenceControlSet *scs, Bool *do_recode) {
     PictureParentControlSet *ppcs    = pcs->ppcs;
     EncodeContext *const     enc_ctx = ppcs->scs->enc_ctx;
@@ -2750,11 +2749,17 @@ static void recode_loop_decision_maker(PictureControlSet *pcs, SequenceControlSe
 
     if (*do_recode) {
         ppcs->loop_count++;
+        if (!pcs->recode_reuse_md)
+            pcs->recode_md_qindex = frm_hdr->quantization_params.base_q_idx;
 
         frm_hdr->quantization_params.base_q_idx = (uint8_t)CLIP3(
             (int32_t)quantizer_to_qindex[scs->static_config.min_qp_allowed],
             (int32_t)quantizer_to_qindex[scs->static_config.max_qp_allowed],
             q);
+        // Keep the partitioning and modes while the qindex stays close to the one of the mode decision
+        pcs->recode_reuse_md = recode_md_reusable(scs, pcs) &&
+            ABS((int32_t)frm_hdr->quantization_params.base_q_idx - (int32_t)pcs->recode_md_qindex) <=
+                scs->recode_ctrls.reuse_md_max_qindex_delta;
 
         ppcs->picture_qp = (uint8_t)CLIP3((int32_t)scs->static_config.min_qp_allowed,
                                           (int32_t)scs->static_config.max_qp_allowed,
@@ -2772,7 +2777,8 @@ static void recode_loop_decision_maker(PictureControlSet *pcs, SequenceControlSe
             }
         }
     } else {
-        ppcs->loop_count = 0;
+        ppcs->loop_count     = 0;
+        pcs->recode_reuse_md = 0;
     }
 }
 
@@ -3183,13 +3189,12 @@ static void lpd0_detector(PictureControlSet *pcs, ModeDecisionContext *md_ctx, u
  *appropriate syntax elements to be sent to the entropy coding engine
  *
  ********************************************************************************/
-void *svt_aom_mode_decision_kernel(void *input_ptr) {
+void svt_aom_mode_decision_task(void *input_ptr, EbObjectWrapper *enc_dec_tasks_wrapper) {
     // Context & SCS & PCS
     EbThreadContext *thread_ctx = (EbThreadContext *)input_ptr;
     EncDecContext   *ed_ctx     = (EncDecContext *)thread_ctx->priv;
 
     // Input
-    EbObjectWrapper *enc_dec_tasks_wrapper;
 
     // Output
     EbObjectWrapper *enc_dec_results_wrapper;
@@ -3217,198 +3222,199 @@ void *svt_aom_mode_decision_kernel(void *input_ptr) {
 
     segment_index = 0;
 
-    for (;;) {
-        // Get Mode Decision Results
-        EB_GET_FULL_OBJECT(ed_ctx->mode_decision_input_fifo_ptr, &enc_dec_tasks_wrapper);
-
-        EncDecTasks                    *enc_dec_tasks = (EncDecTasks *)enc_dec_tasks_wrapper->object_ptr;
-        PictureControlSet              *pcs           = (PictureControlSet *)enc_dec_tasks->pcs_wrapper->object_ptr;
-        SequenceControlSet             *scs           = pcs->scs;
-        ModeDecisionContext            *md_ctx        = ed_ctx->md_ctx;
-        struct PictureParentControlSet *ppcs          = pcs->ppcs;
-        md_ctx->encoder_bit_depth                     = (uint8_t)scs->static_config.encoder_bit_depth;
-        md_ctx->corrupted_mv_check                    = (pcs->ppcs->aligned_width >= (1 << (MV_IN_USE_BITS - 3))) ||
-            (pcs->ppcs->aligned_height >= (1 << (MV_IN_USE_BITS - 3)));
-        ed_ctx->tile_group_index = enc_dec_tasks->tile_group_index;
-        ed_ctx->coded_sb_count   = 0;
-        segments_ptr             = pcs->enc_dec_segment_ctrl[ed_ctx->tile_group_index];
-        // SB Constants
-        uint8_t  sb_size                = (uint8_t)scs->sb_size;
-        uint8_t  sb_size_log2           = (uint8_t)svt_log2f(sb_size);
-        uint32_t pic_width_in_sb        = (pcs->ppcs->aligned_width + sb_size - 1) >> sb_size_log2;
-        uint16_t tile_group_width_in_sb = pcs->ppcs->tile_group_info[ed_ctx->tile_group_index].tile_group_width_in_sb;
-        ed_ctx->tot_intra_coded_area    = 0;
-        ed_ctx->tot_skip_coded_area     = 0;
-        ed_ctx->tot_hp_coded_area       = 0;
-        // Bypass encdec for the first pass
-        if (svt_aom_is_pic_skipped(pcs->ppcs)) {
-            svt_release_object(pcs->ppcs->me_data_wrapper);
-            pcs->ppcs->me_data_wrapper = (EbObjectWrapper *)NULL;
-            pcs->ppcs->pa_me_data      = NULL;
-            // Get Empty EncDec Results
-            svt_get_empty_object(ed_ctx->enc_dec_output_fifo_ptr, &enc_dec_results_wrapper);
-            enc_dec_results              = (EncDecResults *)enc_dec_results_wrapper->object_ptr;
-            enc_dec_results->pcs_wrapper = enc_dec_tasks->pcs_wrapper;
-
-            // Post EncDec Results
-            svt_post_full_object(enc_dec_results_wrapper);
-        } else {
-            if (enc_dec_tasks->input_type == ENCDEC_TASKS_SUPERRES_INPUT) {
-                // do as dorecode do
-                pcs->enc_dec_coded_sb_count = 0;
-                // re-init mode decision configuration for qp update for re-encode frame
-                mode_decision_configuration_init_qp_update(pcs);
-                // init segment for re-encode frame
-                svt_aom_init_enc_dec_segement(pcs->ppcs);
-
-                // post tile based encdec task
-                EbObjectWrapper *enc_dec_re_encode_tasks_wrapper;
-                uint16_t         tg_count = pcs->ppcs->tile_group_cols * pcs->ppcs->tile_group_rows;
-                for (uint16_t tile_group_idx = 0; tile_group_idx < tg_count; tile_group_idx++) {
-                    svt_get_empty_object(ed_ctx->enc_dec_feedback_fifo_ptr, &enc_dec_re_encode_tasks_wrapper);
-
-                    EncDecTasks *enc_dec_re_encode_tasks_ptr = (EncDecTasks *)
-                                                                   enc_dec_re_encode_tasks_wrapper->object_ptr;
-                    enc_dec_re_encode_tasks_ptr->pcs_wrapper      = enc_dec_tasks->pcs_wrapper;
-                    enc_dec_re_encode_tasks_ptr->input_type       = ENCDEC_TASKS_MDC_INPUT;
-                    enc_dec_re_encode_tasks_ptr->tile_group_index = tile_group_idx;
-
-                    // Post the Full Results Object
-                    svt_post_full_object(enc_dec_re_encode_tasks_wrapper);
-                }
-
-                svt_release_object(enc_dec_tasks_wrapper);
-                continue;
+    EncDecTasks                    *enc_dec_tasks = (EncDecTasks *)enc_dec_tasks_wrapper->object_ptr;
+    PictureControlSet              *pcs           = (PictureControlSet *)enc_dec_tasks->pcs_wrapper->object_ptr;
+    SequenceControlSet             *scs           = pcs->scs;
+    ModeDecisionContext            *md_ctx        = ed_ctx->md_ctx;
+    struct PictureParentControlSet *ppcs          = pcs->ppcs;
+    md_ctx->encoder_bit_depth                     = (uint8_t)scs->static_config.encoder_bit_depth;
+    md_ctx->corrupted_mv_check                    = (pcs->ppcs->aligned_width >= (1 << (MV_IN_USE_BITS - 3))) ||
+        (pcs->ppcs->aligned_height >= (1 << (MV_IN_USE_BITS - 3)));
+    ed_ctx->tile_group_index = enc_dec_tasks->tile_group_index;
+    ed_ctx->coded_sb_count   = 0;
+    segments_ptr             = pcs->enc_dec_segment_ctrl[ed_ctx->tile_group_index];
+    // SB Constants
+    uint8_t  sb_size                = (uint8_t)scs->sb_size;
+    uint8_t  sb_size_log2           = (uint8_t)svt_log2f(sb_size);
+    uint32_t pic_width_in_sb        = (pcs->ppcs->aligned_width + sb_size - 1) >> sb_size_log2;
+    uint16_t tile_group_width_in_sb = pcs->ppcs->tile_group_info[ed_ctx->tile_group_index].tile_group_width_in_sb;
+    ed_ctx->tot_intra_coded_area    = 0;
+    ed_ctx->tot_skip_coded_area     = 0;
+    ed_ctx->tot_hp_coded_area       = 0;
+    // Bypass encdec for the first pass
+    if (svt_aom_is_pic_skipped(pcs->ppcs)) {
+        svt_release_object(pcs->ppcs->me_data_wrapper);
+        pcs->ppcs->me_data_wrapper = (EbObjectWrapper *)NULL;
+        pcs->ppcs->pa_me_data      = NULL;
+        // Get Empty EncDec Results
+        svt_get_empty_object(ed_ctx->enc_dec_output_fifo_ptr, &enc_dec_results_wrapper);
+        enc_dec_results              = (EncDecResults *)enc_dec_results_wrapper->object_ptr;
+        enc_dec_results->pcs_wrapper = enc_dec_tasks->pcs_wrapper;
+
+        // Post EncDec Results
+        svt_post_full_object(enc_dec_results_wrapper);
+    } else {
+        if (enc_dec_tasks->input_type == ENCDEC_TASKS_SUPERRES_INPUT) {
+            // do as dorecode do
+            pcs->enc_dec_coded_sb_count = 0;
+            // re-init mode decision configuration for qp update for re-encode frame
+            mode_decision_configuration_init_qp_update(pcs);
+            // init segment for re-encode frame
+            svt_aom_init_enc_dec_segement(pcs->ppcs);
+
+            // post tile based encdec task
+            EbObjectWrapper *enc_dec_re_encode_tasks_wrapper;
+            uint16_t         tg_count = pcs->ppcs->tile_group_cols * pcs->ppcs->tile_group_rows;
+            for (uint16_t tile_group_idx = 0; tile_group_idx < tg_count; tile_group_idx++) {
+                svt_get_empty_object(ed_ctx->enc_dec_feedback_fifo_ptr, &enc_dec_re_encode_tasks_wrapper);
+
+                EncDecTasks *enc_dec_re_encode_tasks_ptr = (EncDecTasks *)
+                                                               enc_dec_re_encode_tasks_wrapper->object_ptr;
+                enc_dec_re_encode_tasks_ptr->pcs_wrapper      = enc_dec_tasks->pcs_wrapper;
+                enc_dec_re_encode_tasks_ptr->input_type       = ENCDEC_TASKS_MDC_INPUT;
+                enc_dec_re_encode_tasks_ptr->tile_group_index = tile_group_idx;
+
+                // Post the Full Results Object
+                svt_post_full_object(enc_dec_re_encode_tasks_wrapper);
             }
 
-            if (pcs->cdf_ctrl.enabled) {
-                if (!pcs->cdf_ctrl.update_mv)
-                    copy_mv_rate(pcs, ed_ctx->md_ctx->rate_est_table);
-                if (!pcs->cdf_ctrl.update_se)
-
-                    svt_aom_estimate_syntax_rate(ed_ctx->md_ctx->rate_est_table,
-                                                 pcs->slice_type == I_SLICE ? TRUE : FALSE,
-                                                 scs->seq_header.filter_intra_level,
-                                                 pcs->ppcs->frm_hdr.allow_screen_content_tools,
-                                                 pcs->ppcs->enable_restoration,
-                                                 pcs->ppcs->frm_hdr.allow_intrabc,
-                                                 &pcs->md_frame_context);
-                if (!pcs->cdf_ctrl.update_coef)
-                    svt_aom_estimate_coefficients_rate(ed_ctx->md_ctx->rate_est_table, &pcs->md_frame_context);
-            }
-            // Segment-loop
-            while (assign_enc_dec_segments(
-                       segments_ptr, &segment_index, enc_dec_tasks, ed_ctx->enc_dec_feedback_fifo_ptr) == TRUE) {
-                x_sb_start_index = segments_ptr->x_start_array[segment_index];
-                y_sb_start_index = segments_ptr->y_start_array[segment_index];
-                sb_start_index   = y_sb_start_index * tile_group_width_in_sb + x_sb_start_index;
-                sb_segment_count = segments_ptr->valid_sb_count_array[segment_index];
-
-                segment_row_index  = segment_index / segments_ptr->segment_band_count;
-                segment_band_index = segment_index - segment_row_index * segments_ptr->segment_band_count;
-                segment_band_size  = (segments_ptr->sb_band_count * (segment_band_index + 1) +
-                                     segments_ptr->segment_band_count - 1) /
-                    segments_ptr->segment_band_count;
-
-                // Reset Coding Loop State
-                svt_aom_reset_mode_decision(scs, ed_ctx->md_ctx, pcs, ed_ctx->tile_group_index, segment_index);
-
-                // Reset EncDec Coding State
-                reset_enc_dec( // HT done
-                    ed_ctx,
-                    pcs,
-                    scs,
-                    segment_index);
-                for (y_sb_index = y_sb_start_index, sb_segment_index = sb_start_index;
+            svt_release_object(enc_dec_tasks_wrapper);
+            return;
+        }
+
+        if (pcs->cdf_ctrl.enabled) {
+            if (!pcs->cdf_ctrl.update_mv)
+                copy_mv_rate(pcs, ed_ctx->md_ctx->rate_est_table);
+            if (!pcs->cdf_ctrl.update_se)
+
+                svt_aom_estimate_syntax_rate(ed_ctx->md_ctx->rate_est_table,
+                                             pcs->slice_type == I_SLICE ? TRUE : FALSE,
+                                             scs->seq_header.filter_intra_level,
+                                             pcs->ppcs->frm_hdr.allow_screen_content_tools,
+                                             pcs->ppcs->enable_restoration,
+                                             pcs->ppcs->frm_hdr.allow_intrabc,
+                                             &pcs->md_frame_context);
+            if (!pcs->cdf_ctrl.update_coef)
+                svt_aom_estimate_coefficients_rate(ed_ctx->md_ctx->rate_est_table, &pcs->md_frame_context);
+        }
+        // Segment-loop
+        while (assign_enc_dec_segments(
+                   segments_ptr, &segment_index, enc_dec_tasks, ed_ctx->enc_dec_feedback_fifo_ptr) == TRUE) {
+            x_sb_start_index = segments_ptr->x_start_array[segment_index];
+            y_sb_start_index = segments_ptr->y_start_array[segment_index];
+            sb_start_index   = y_sb_start_index * tile_group_width_in_sb + x_sb_start_index;
+            sb_segment_count = segments_ptr->valid_sb_count_array[segment_index];
+
+            segment_row_index  = segment_index / segments_ptr->segment_band_count;
+            segment_band_index = segment_index - segment_row_index * segments_ptr->segment_band_count;
+            segment_band_size  = (segments_ptr->sb_band_count * (segment_band_index + 1) +
+                                 segments_ptr->segment_band_count - 1) /
+                segments_ptr->segment_band_count;
+
+            // Reset Coding Loop State
+            svt_aom_reset_mode_decision(scs, ed_ctx->md_ctx, pcs, ed_ctx->tile_group_index, segment_index);
+
+            // Reset EncDec Coding State
+            reset_enc_dec( // HT done
+                ed_ctx,
+                pcs,
+                scs,
+                segment_index);
+            for (y_sb_index = y_sb_start_index, sb_segment_index = sb_start_index;
+                 sb_segment_index < sb_start_index + sb_segment_count;
+                 ++y_sb_index) {
+                for (x_sb_index = x_sb_start_index;
+                     x_sb_index < tile_group_width_in_sb && (x_sb_index + y_sb_index < segment_band_size) &&
                      sb_segment_index < sb_start_index + sb_segment_count;
-                     ++y_sb_index) {
-                    for (x_sb_index = x_sb_start_index;
-                         x_sb_index < tile_group_width_in_sb && (x_sb_index + y_sb_index < segment_band_size) &&
-                         sb_segment_index < sb_start_index + sb_segment_count;
-                         ++x_sb_index, ++sb_segment_index) {
-                        uint16_t tile_group_y_sb_start =
-                            pcs->ppcs->tile_group_info[ed_ctx->tile_group_index].tile_group_sb_start_y;
-                        uint16_t tile_group_x_sb_start =
-                            pcs->ppcs->tile_group_info[ed_ctx->tile_group_index].tile_group_sb_start_x;
-                        sb_index = ed_ctx->md_ctx->sb_index = (uint16_t)((y_sb_index + tile_group_y_sb_start) *
-                                                                             pic_width_in_sb +
-                                                                         x_sb_index + tile_group_x_sb_start);
-                        sb_ptr = ed_ctx->md_ctx->sb_ptr = pcs->sb_ptr_array[sb_index];
-                        sb_origin_x                     = (x_sb_index + tile_group_x_sb_start) << sb_size_log2;
-                        sb_origin_y                     = (y_sb_index + tile_group_y_sb_start) << sb_size_log2;
-                        //printf("[%ld]:ED sb index %d, (%d, %d), encoded total sb count %d, ctx coded sb count %d\n",
-                        //        pcs->picture_number,
-                        //        sb_index, sb_origin_x, sb_origin_y,
-                        //        pcs->enc_dec_coded_sb_count,
-                        //        context_ptr->coded_sb_count);
-                        ed_ctx->tile_index          = sb_ptr->tile_info.tile_rs_index;
-                        ed_ctx->md_ctx->tile_index  = sb_ptr->tile_info.tile_rs_index;
-                        ed_ctx->md_ctx->sb_origin_x = sb_origin_x;
-                        ed_ctx->md_ctx->sb_origin_y = sb_origin_y;
-                        mdc_ptr                     = &(ed_ctx->md_ctx->mdc_sb_array);
-                        ed_ctx->sb_index            = sb_index;
-                        if (pcs->cdf_ctrl.enabled) {
-                            if (scs->seq_header.pic_based_rate_est &&
-                                scs->enc_dec_segment_row_count_array[pcs->temporal_layer_index] == 1 &&
-                                scs->enc_dec_segment_col_count_array[pcs->temporal_layer_index] == 1) {
-                                if (sb_index == 0)
-                                    pcs->ec_ctx_array[sb_index] = pcs->md_frame_context;
-                                else
-                                    pcs->ec_ctx_array[sb_index] = pcs->ec_ctx_array[sb_index - 1];
-                            } else {
-                                // Use the latest available CDF for the current SB
-                                // Use the weighted average of left (3x) and top right (1x) if available.
-                                int8_t top_right_available = ((int32_t)(sb_origin_y >> MI_SIZE_LOG2) >
-                                                              sb_ptr->tile_info.mi_row_start) &&
-                                    ((int32_t)((sb_origin_x + (1 << sb_size_log2)) >> MI_SIZE_LOG2) <
-                                     sb_ptr->tile_info.mi_col_end);
-
-                                int8_t left_available = ((int32_t)(sb_origin_x >> MI_SIZE_LOG2) >
-                                                         sb_ptr->tile_info.mi_col_start);
-
-                                if (!left_available && !top_right_available)
-                                    pcs->ec_ctx_array[sb_index] = pcs->md_frame_context;
-                                else if (!left_available)
-                                    pcs->ec_ctx_array[sb_index] = pcs->ec_ctx_array[sb_index - pic_width_in_sb + 1];
-                                else if (!top_right_available)
-                                    pcs->ec_ctx_array[sb_index] = pcs->ec_ctx_array[sb_index - 1];
-                                else {
-                                    pcs->ec_ctx_array[sb_index] = pcs->ec_ctx_array[sb_index - 1];
-                                    avg_cdf_symbols(&pcs->ec_ctx_array[sb_index],
-                                                    &pcs->ec_ctx_array[sb_index - pic_width_in_sb + 1],
-                                                    AVG_CDF_WEIGHT_LEFT,
-                                                    AVG_CDF_WEIGHT_TOP);
-                                }
+                     ++x_sb_index, ++sb_segment_index) {
+                    uint16_t tile_group_y_sb_start =
+                        pcs->ppcs->tile_group_info[ed_ctx->tile_group_index].tile_group_sb_start_y;
+                    uint16_t tile_group_x_sb_start =
+                        pcs->ppcs->tile_group_info[ed_ctx->tile_group_index].tile_group_sb_start_x;
+                    sb_index = ed_ctx->md_ctx->sb_index = (uint16_t)((y_sb_index + tile_group_y_sb_start) *
+                                                                         pic_width_in_sb +
+                                                                     x_sb_index + tile_group_x_sb_start);
+                    sb_ptr = ed_ctx->md_ctx->sb_ptr = pcs->sb_ptr_array[sb_index];
+                    sb_origin_x                     = (x_sb_index + tile_group_x_sb_start) << sb_size_log2;
+                    sb_origin_y                     = (y_sb_index + tile_group_y_sb_start) << sb_size_log2;
+                    //printf("[%ld]:ED sb index %d, (%d, %d), encoded total sb count %d, ctx coded sb count %d\n",
+                    //        pcs->picture_number,
+                    //        sb_index, sb_origin_x, sb_origin_y,
+                    //        pcs->enc_dec_coded_sb_count,
+                    //        context_ptr->coded_sb_count);
+                    ed_ctx->tile_index          = sb_ptr->tile_info.tile_rs_index;
+                    ed_ctx->md_ctx->tile_index  = sb_ptr->tile_info.tile_rs_index;
+                    ed_ctx->md_ctx->sb_origin_x = sb_origin_x;
+                    ed_ctx->md_ctx->sb_origin_y = sb_origin_y;
+                    mdc_ptr                     = &(ed_ctx->md_ctx->mdc_sb_array);
+                    ed_ctx->sb_index            = sb_index;
+                    if (pcs->cdf_ctrl.enabled) {
+                        if (scs->seq_header.pic_based_rate_est &&
+                            scs->enc_dec_segment_row_count_array[pcs->temporal_layer_index] == 1 &&
+                            scs->enc_dec_segment_col_count_array[pcs->temporal_layer_index] == 1) {
+                            if (sb_index == 0)
+                                pcs->ec_ctx_array[sb_index] = pcs->md_frame_context;
+                            else
+                                pcs->ec_ctx_array[sb_index] = pcs->ec_ctx_array[sb_index - 1];
+                        } else {
+                            // Use the latest available CDF for the current SB
+                            // Use the weighted average of left (3x) and top right (1x) if available.
+                            int8_t top_right_available = ((int32_t)(sb_origin_y >> MI_SIZE_LOG2) >
+                                                          sb_ptr->tile_info.mi_row_start) &&
+                                ((int32_t)((sb_origin_x + (1 << sb_size_log2)) >> MI_SIZE_LOG2) <
+                                 sb_ptr->tile_info.mi_col_end);
+
+                            int8_t left_available = ((int32_t)(sb_origin_x >> MI_SIZE_LOG2) >
+                                                     sb_ptr->tile_info.mi_col_start);
+
+                            if (!left_available && !top_right_available)
+                                pcs->ec_ctx_array[sb_index] = pcs->md_frame_context;
+                            else if (!left_available)
+                                pcs->ec_ctx_array[sb_index] = pcs->ec_ctx_array[sb_index - pic_width_in_sb + 1];
+                            else if (!top_right_available)
+                                pcs->ec_ctx_array[sb_index] = pcs->ec_ctx_array[sb_index - 1];
+                            else {
+                                pcs->ec_ctx_array[sb_index] = pcs->ec_ctx_array[sb_index - 1];
+                                avg_cdf_symbols(&pcs->ec_ctx_array[sb_index],
+                                                &pcs->ec_ctx_array[sb_index - pic_width_in_sb + 1],
+                                                AVG_CDF_WEIGHT_LEFT,
+                                                AVG_CDF_WEIGHT_TOP);
                             }
-                            // Initial Rate Estimation of the syntax elements
-                            if (pcs->cdf_ctrl.update_se)
-                                svt_aom_estimate_syntax_rate(ed_ctx->md_ctx->rate_est_table,
-                                                             pcs->slice_type == I_SLICE,
-                                                             scs->seq_header.filter_intra_level,
-                                                             pcs->ppcs->frm_hdr.allow_screen_content_tools,
-                                                             pcs->ppcs->enable_restoration,
-                                                             pcs->ppcs->frm_hdr.allow_intrabc,
-                                                             &pcs->ec_ctx_array[sb_index]);
-                            // Initial Rate Estimation of the Motion vectors
-                            if (pcs->cdf_ctrl.update_mv)
-                                svt_aom_estimate_mv_rate(
-                                    pcs, ed_ctx->md_ctx->rate_est_table, &pcs->ec_ctx_array[sb_index]);
-
-                            if (pcs->cdf_ctrl.update_coef)
-                                svt_aom_estimate_coefficients_rate(ed_ctx->md_ctx->rate_est_table,
-                                                                   &pcs->ec_ctx_array[sb_index]);
-                            ed_ctx->md_ctx->md_rate_est_ctx = ed_ctx->md_ctx->rate_est_table;
                         }
-                        // Configure the SB
-                        svt_aom_mode_decision_configure_sb(
-                            ed_ctx->md_ctx,
-                            pcs,
-                            sb_ptr->qindex,
-                            svt_aom_get_me_qindex(pcs, sb_ptr, scs->seq_header.sb_size == BLOCK_128X128));
-
-                        // signals set once per SB (i.e. not per PD)
-                        svt_aom_sig_deriv_enc_dec_common(scs, pcs, ed_ctx->md_ctx);
-
+                        // Initial Rate Estimation of the syntax elements, only of the CDFs updated since the
+                        // previous SB of the thread. The restoration rates are read from the picture table only.
+                        if (pcs->cdf_ctrl.update_se)
+                            svt_aom_estimate_syntax_rate(ed_ctx->md_ctx->rate_est_table,
+                                                         pcs->slice_type == I_SLICE,
+                                                         scs->seq_header.filter_intra_level,
+                                                         pcs->ppcs->frm_hdr.allow_screen_content_tools,
+                                                         0,
+                                                         pcs->ppcs->frm_hdr.allow_intrabc,
+                                                         &pcs->ec_ctx_array[sb_index]);
+                        // Initial Rate Estimation of the Motion vectors
+                        if (pcs->cdf_ctrl.update_mv)
+                            svt_aom_estimate_mv_rate(
+                                pcs, ed_ctx->md_ctx->rate_est_table, &pcs->ec_ctx_array[sb_index]);
+
+                        if (pcs->cdf_ctrl.update_coef)
+                            svt_aom_estimate_coefficients_rate(ed_ctx->md_ctx->rate_est_table,
+                                                               &pcs->ec_ctx_array[sb_index]);
+                        ed_ctx->md_ctx->md_rate_est_ctx = ed_ctx->md_ctx->rate_est_table;
+                    }
+                    // Configure the SB
+                    svt_aom_mode_decision_configure_sb(
+                        ed_ctx->md_ctx,
+                        pcs,
+                        sb_ptr->qindex,
+                        svt_aom_get_me_qindex(pcs, sb_ptr, scs->seq_header.sb_size == BLOCK_128X128));
+
+                    // signals set once per SB (i.e. not per PD)
+                    svt_aom_sig_deriv_enc_dec_common(scs, pcs, ed_ctx->md_ctx);
+
+                    if (pcs->recode_reuse_md) {
+                        // Recode of the frame at a close qindex: replay the mode decision of the previous encoding
+                        recode_replay_md(scs, pcs, md_ctx, sb_ptr, sb_index);
+                    } else {
                         if (pcs->ppcs->palette_level)
                             // Status of palette info alloc
                             for (int i = 0; i < scs->max_block_cnt; ++i)
@@ -3480,8 +3486,9 @@ void *svt_aom_mode_decision_kernel(void *input_ptr) {
 
                                 // Build the t=0 cand_block_array
                                 build_cand_block_array(scs, pcs, md_ctx, true);
-                                // PD0 MD Tool(s) : ME_MV(s) as INTER candidate(s), DC as INTRA candidate, luma only, Frequency domain SSE,
-                                // no fast rate (no MVP table generation), MDS0 then MDS3, reduced NIC(s), 1 ref per list,..
+                                // PD0 MD Tool(s) : ME_MV(s) as INTER candidate(s), DC as INTRA candidate, luma only,
+                                // Frequency domain SSE, no fast rate (no MVP table generation), MDS0 then MDS3,
+                                // reduced NIC(s), 1 ref per list,..
                                 svt_aom_mode_decision_sb(scs, pcs, ed_ctx->md_ctx, mdc_ptr);
                                 // Re-build mdc_blk_ptr for the 2nd PD Pass [PD_PASS_1]
                                 // Reset neighnor information to current SB @ position (0,0)
@@ -3536,118 +3543,122 @@ void *svt_aom_mode_decision_kernel(void *input_ptr) {
                             svt_aom_mode_decision_sb_light_pd1(scs, pcs, ed_ctx->md_ctx, mdc_ptr);
                         else
                             svt_aom_mode_decision_sb(scs, pcs, ed_ctx->md_ctx, mdc_ptr);
-                        // if (/*ppcs->is_ref &&*/ md_ctx->hbd_md == 0 &&
-                        // scs->static_config.encoder_bit_depth > EB_EIGHT_BIT)
-                        //     md_ctx->bypass_encdec = 0;
-                        //  Encode Pass
-                        if (!ed_ctx->md_ctx->bypass_encdec) {
-                            svt_aom_encode_decode(scs, pcs, sb_ptr, sb_index, sb_origin_x, sb_origin_y, ed_ctx);
-                        }
-                        svt_aom_encdec_update(scs, pcs, sb_ptr, sb_index, sb_origin_x, sb_origin_y, ed_ctx);
-
-                        ed_ctx->coded_sb_count++;
+                        if (recode_md_reusable(scs, pcs))
+                            svt_aom_recode_save_md(scs, pcs, sb_ptr, sb_index, md_ctx);
+                    }
+                    // if (/*ppcs->is_ref &&*/ md_ctx->hbd_md == 0 &&
+                    // scs->static_config.encoder_bit_depth > EB_EIGHT_BIT)
+                    //     md_ctx->bypass_encdec = 0;
+                    //  Encode Pass
+                    if (!ed_ctx->md_ctx->bypass_encdec) {
+                        svt_aom_encode_decode(scs, pcs, sb_ptr, sb_index, sb_origin_x, sb_origin_y, ed_ctx);
                     }
-                    x_sb_start_index = (x_sb_start_index > 0) ? x_sb_start_index - 1 : 0;
+                    svt_aom_encdec_update(scs, pcs, sb_ptr, sb_index, sb_origin_x, sb_origin_y, ed_ctx);
+                    if (pcs->cdef_row_sync)
+                        svt_aom_cdef_row_sync_sb_done(
+                            pcs, enc_dec_tasks->pcs_wrapper, ed_ctx->dlf_output_fifo_ptr, sb_origin_y);
+
+                    ed_ctx->coded_sb_count++;
                 }
+                x_sb_start_index = (x_sb_start_index > 0) ? x_sb_start_index - 1 : 0;
             }
+        }
 
-            svt_block_on_mutex(pcs->intra_mutex);
-            pcs->intra_coded_area += (uint32_t)ed_ctx->tot_intra_coded_area;
-            pcs->skip_coded_area += (uint32_t)ed_ctx->tot_skip_coded_area;
-            pcs->hp_coded_area += (uint32_t)ed_ctx->tot_hp_coded_area;
-            // Accumulate block selection
-            pcs->enc_dec_coded_sb_count += (uint32_t)ed_ctx->coded_sb_count;
-            Bool last_sb_flag = (pcs->sb_total_count == pcs->enc_dec_coded_sb_count);
-            svt_release_mutex(pcs->intra_mutex);
-
-            if (last_sb_flag) {
-                Bool do_recode = FALSE;
-                if ((scs->static_config.rate_control_mode == SVT_AV1_RC_MODE_VBR ||
-                     scs->static_config.max_bit_rate != 0) &&
-                    scs->enc_ctx->recode_loop != DISALLOW_RECODE) {
-                    recode_loop_decision_maker(pcs, scs, &do_recode);
-                }
+        svt_block_on_mutex(pcs->intra_mutex);
+        pcs->intra_coded_area += (uint32_t)ed_ctx->tot_intra_coded_area;
+        pcs->skip_coded_area += (uint32_t)ed_ctx->tot_skip_coded_area;
+        pcs->hp_coded_area += (uint32_t)ed_ctx->tot_hp_coded_area;
+        // Accumulate block selection
+        pcs->enc_dec_coded_sb_count += (uint32_t)ed_ctx->coded_sb_count;
+        Bool last_sb_flag = (pcs->sb_total_count == pcs->enc_dec_coded_sb_count);
+        svt_release_mutex(pcs->intra_mutex);
+
+        if (last_sb_flag) {
+            Bool do_recode = FALSE;
+            if ((scs->static_config.rate_control_mode == SVT_AV1_RC_MODE_VBR ||
+                 scs->static_config.max_bit_rate != 0) &&
+                scs->enc_ctx->recode_loop != DISALLOW_RECODE) {
+                recode_loop_decision_maker(pcs, scs, &do_recode);
+            }
 
-                if (do_recode) {
-                    // Deallocate the palette data
-                    for (sb_index = 0; sb_index < pcs->enc_dec_coded_sb_count; ++sb_index) {
-                        sb_ptr = pcs->sb_ptr_array[sb_index];
-                        for (uint16_t blk_cnt = 0; blk_cnt < sb_ptr->final_blk_cnt; blk_cnt++) {
-                            EcBlkStruct *final_blk_arr = &(sb_ptr->final_blk_arr[blk_cnt]);
-                            if (final_blk_arr->palette_info != NULL) {
-                                assert(final_blk_arr->palette_info->color_idx_map != NULL && "free palette:Null");
-                                EB_FREE(final_blk_arr->palette_info->color_idx_map);
-                                final_blk_arr->palette_info->color_idx_map = NULL;
-                                EB_FREE(final_blk_arr->palette_info);
-                            }
+            if (do_recode) {
+                // Deallocate the palette data
+                for (sb_index = 0; sb_index < pcs->enc_dec_coded_sb_count; ++sb_index) {
+                    sb_ptr = pcs->sb_ptr_array[sb_index];
+                    for (uint16_t blk_cnt = 0; blk_cnt < sb_ptr->final_blk_cnt; blk_cnt++) {
+                        EcBlkStruct *final_blk_arr = &(sb_ptr->final_blk_arr[blk_cnt]);
+                        if (final_blk_arr->palette_info != NULL) {
+                            assert(final_blk_arr->palette_info->color_idx_map != NULL && "free palette:Null");
+                            EB_FREE(final_blk_arr->palette_info->color_idx_map);
+                            final_blk_arr->palette_info->color_idx_map = NULL;
+                            EB_FREE(final_blk_arr->palette_info);
                         }
                     }
-                    pcs->enc_dec_coded_sb_count = 0;
-                    // re-init mode decision configuration for qp update for re-encode frame
-                    mode_decision_configuration_init_qp_update(pcs);
-                    // init segment for re-encode frame
-                    svt_aom_init_enc_dec_segement(pcs->ppcs);
-                    EbObjectWrapper *enc_dec_re_encode_tasks_wrapper;
-                    uint16_t         tg_count = pcs->ppcs->tile_group_cols * pcs->ppcs->tile_group_rows;
-                    for (uint16_t tile_group_idx = 0; tile_group_idx < tg_count; tile_group_idx++) {
-                        svt_get_empty_object(ed_ctx->enc_dec_feedback_fifo_ptr, &enc_dec_re_encode_tasks_wrapper);
-
-                        EncDecTasks *enc_dec_re_encode_tasks_ptr = (EncDecTasks *)
-                                                                       enc_dec_re_encode_tasks_wrapper->object_ptr;
-                        enc_dec_re_encode_tasks_ptr->pcs_wrapper      = enc_dec_tasks->pcs_wrapper;
-                        enc_dec_re_encode_tasks_ptr->input_type       = ENCDEC_TASKS_MDC_INPUT;
-                        enc_dec_re_encode_tasks_ptr->tile_group_index = tile_group_idx;
-
-                        // Post the Full Results Object
-                        svt_post_full_object(enc_dec_re_encode_tasks_wrapper);
-                    }
+                }
+                pcs->enc_dec_coded_sb_count = 0;
+                // re-init mode decision configuration for qp update for re-encode frame
+                mode_decision_configuration_init_qp_update(pcs);
+                // init segment for re-encode frame
+                svt_aom_init_enc_dec_segement(pcs->ppcs);
+                EbObjectWrapper *enc_dec_re_encode_tasks_wrapper;
+                uint16_t         tg_count = pcs->ppcs->tile_group_cols * pcs->ppcs->tile_group_rows;
+                for (uint16_t tile_group_idx = 0; tile_group_idx < tg_count; tile_group_idx++) {
+                    svt_get_empty_object(ed_ctx->enc_dec_feedback_fifo_ptr, &enc_dec_re_encode_tasks_wrapper);
 
-                } else {
-                    EB_FREE_ARRAY(pcs->ec_ctx_array);
-                    // Copy film grain data from parent picture set to the reference object for
-                    // further reference
-                    if (scs->seq_header.film_grain_params_present) {
-                        if (pcs->ppcs->is_ref == TRUE && pcs->ppcs->ref_pic_wrapper) {
-                            ((EbReferenceObject *)pcs->ppcs->ref_pic_wrapper->object_ptr)->film_grain_params =
-                                pcs->ppcs->frm_hdr.film_grain_params;
-                        }
-                    }
-                    // Force each frame to update their data so future frames can use it,
-                    // even if the current frame did not use it.  This enables REF frames to
-                    // have the feature off, while NREF frames can have it on.  Used for
-                    // multi-threading.
-                    if (pcs->ppcs->is_ref == TRUE && pcs->ppcs->ref_pic_wrapper)
-                        for (int frame = LAST_FRAME; frame <= ALTREF_FRAME; ++frame)
-                            ((EbReferenceObject *)pcs->ppcs->ref_pic_wrapper->object_ptr)->global_motion[frame] =
-                                pcs->ppcs->global_motion[frame];
-                    svt_memcpy(pcs->ppcs->av1x->sgrproj_restore_cost,
-                               pcs->md_rate_est_ctx->sgrproj_restore_fac_bits,
-                               2 * sizeof(int32_t));
-                    svt_memcpy(pcs->ppcs->av1x->switchable_restore_cost,
-                               pcs->md_rate_est_ctx->switchable_restore_fac_bits,
-                               3 * sizeof(int32_t));
-                    svt_memcpy(pcs->ppcs->av1x->wiener_restore_cost,
-                               pcs->md_rate_est_ctx->wiener_restore_fac_bits,
-                               2 * sizeof(int32_t));
-                    pcs->ppcs->av1x->rdmult =
-                        ed_ctx->pic_full_lambda[(ed_ctx->bit_depth == EB_TEN_BIT) ? EB_10_BIT_MD : EB_8_BIT_MD];
-                    if (pcs->ppcs->superres_total_recode_loop == 0) {
-                        svt_release_object(pcs->ppcs->me_data_wrapper);
-                        pcs->ppcs->me_data_wrapper = (EbObjectWrapper *)NULL;
-                        pcs->ppcs->pa_me_data      = NULL;
-                    }
-                    // Get Empty EncDec Results
-                    svt_get_empty_object(ed_ctx->enc_dec_output_fifo_ptr, &enc_dec_results_wrapper);
-                    enc_dec_results              = (EncDecResults *)enc_dec_results_wrapper->object_ptr;
-                    enc_dec_results->pcs_wrapper = enc_dec_tasks->pcs_wrapper;
+                    EncDecTasks *enc_dec_re_encode_tasks_ptr = (EncDecTasks *)
+                                                                   enc_dec_re_encode_tasks_wrapper->object_ptr;
+                    enc_dec_re_encode_tasks_ptr->pcs_wrapper      = enc_dec_tasks->pcs_wrapper;
+                    enc_dec_re_encode_tasks_ptr->input_type       = ENCDEC_TASKS_MDC_INPUT;
+                    enc_dec_re_encode_tasks_ptr->tile_group_index = tile_group_idx;
+
+                    // Post the Full Results Object
+                    svt_post_full_object(enc_dec_re_encode_tasks_wrapper);
+                }
 
-                    // Post EncDec Results
-                    svt_post_full_object(enc_dec_results_wrapper);
+            } else {
+                EB_FREE_ARRAY(pcs->ec_ctx_array);
+                // Copy film grain data from parent picture set to the reference object for
+                // further reference
+                if (scs->seq_header.film_grain_params_present) {
+                    if (pcs->ppcs->is_ref == TRUE && pcs->ppcs->ref_pic_wrapper) {
+                        ((EbReferenceObject *)pcs->ppcs->ref_pic_wrapper->object_ptr)->film_grain_params =
+                            pcs->ppcs->frm_hdr.film_grain_params;
+                    }
                 }
+                // Force each frame to update their data so future frames can use it,
+                // even if the current frame did not use it.  This enables REF frames to
+                // have the feature off, while NREF frames can have it on.  Used for
+                // multi-threading.
+                if (pcs->ppcs->is_ref == TRUE && pcs->ppcs->ref_pic_wrapper)
+                    for (int frame = LAST_FRAME; frame <= ALTREF_FRAME; ++frame)
+                        ((EbReferenceObject *)pcs->ppcs->ref_pic_wrapper->object_ptr)->global_motion[frame] =
+                            pcs->ppcs->global_motion[frame];
+                svt_memcpy(pcs->ppcs->av1x->sgrproj_restore_cost,
+                           pcs->md_rate_est_ctx->sgrproj_restore_fac_bits,
+                           2 * sizeof(int32_t));
+                svt_memcpy(pcs->ppcs->av1x->switchable_restore_cost,
+                           pcs->md_rate_est_ctx->switchable_restore_fac_bits,
+                           3 * sizeof(int32_t));
+                svt_memcpy(pcs->ppcs->av1x->wiener_restore_cost,
+                           pcs->md_rate_est_ctx->wiener_restore_fac_bits,
+                           2 * sizeof(int32_t));
+                pcs->ppcs->av1x->rdmult =
+                    ed_ctx->pic_full_lambda[(ed_ctx->bit_depth == EB_TEN_BIT) ? EB_10_BIT_MD : EB_8_BIT_MD];
+                if (pcs->ppcs->superres_total_recode_loop == 0) {
+                    svt_release_object(pcs->ppcs->me_data_wrapper);
+                    pcs->ppcs->me_data_wrapper = (EbObjectWrapper *)NULL;
+                    pcs->ppcs->pa_me_data      = NULL;
+                }
+                // Get Empty EncDec Results
+                svt_get_empty_object(ed_ctx->enc_dec_output_fifo_ptr, &enc_dec_results_wrapper);
+                enc_dec_results              = (EncDecResults *)enc_dec_results_wrapper->object_ptr;
+                enc_dec_results->pcs_wrapper = enc_dec_tasks->pcs_wrapper;
+
+                // Post EncDec Results
+                svt_post_full_object(enc_dec_results_wrapper);
             }
         }
-        // Release Mode Decision Results
-        svt_release_object(enc_dec_tasks_wrapper);
     }
-    return NULL;
+    // Release Mode Decision Results
+    svt_release_object(enc_dec_tasks_wrapper);
 }
@@ -37,6 +37,7 @@ typedef struct EncDecContext {
     EbFifo              *mode_decision_input_fifo_ptr;
     EbFifo              *enc_dec_output_fifo_ptr;
     EbFifo              *enc_dec_feedback_fifo_ptr;
+    EbFifo              *dlf_output_fifo_ptr; // CDEF segments posted by SB rows
     EbFifo              *picture_demux_output_fifo_ptr; // to picture-manager
     ModeDecisionContext *md_ctx;
     const BlockGeom     *blk_geom;
@@ -88,7 +89,7 @@ typedef struct EncDecContext {
 extern EbErrorType svt_aom_enc_dec_context_ctor(EbThreadContext *thread_ctx, const EbEncHandle *enc_handle_ptr,
                                                 int index, int tasks_index);
 
-extern void *svt_aom_mode_decision_kernel(void *input_ptr);
+extern void svt_aom_mode_decision_task(void *input_ptr, EbObjectWrapper *in_wrapper_ptr);
 
 #ifdef __cplusplus
 }
@@ -12,6 +12,7 @@
 #include <stdlib.h>
 
 #include "EbEncodeContext.h"
+#include "EbLadderGroup.h"
 #include "EbSvtAv1ErrorCodes.h"
 #include "EbThreads.h"
 
@@ -60,6 +61,7 @@ static void encode_context_dctor(EbPtr p) {
     EB_DESTROY_MUTEX(obj->sc_buffer_mutex);
     EB_DESTROY_MUTEX(obj->stat_file_mutex);
     EB_DESTROY_MUTEX(obj->frame_updated_mutex);
+    EB_DESTROY_MUTEX(obj->tile_group_output_mutex);
     EB_DELETE(obj->prediction_structure_group_ptr);
     EB_DELETE_PTR_ARRAY(obj->picture_decision_reorder_queue, PICTURE_DECISION_REORDER_QUEUE_MAX_DEPTH);
     EB_FREE(obj->pre_assignment_buffer);
@@ -75,6 +77,7 @@ static void encode_context_dctor(EbPtr p) {
     EB_DELETE_PTR_ARRAY(obj->initial_rate_control_reorder_queue, INITIAL_RATE_CONTROL_REORDER_QUEUE_MAX_DEPTH);
     EB_DELETE_PTR_ARRAY(obj->packetization_reorder_queue, PACKETIZATION_REORDER_QUEUE_MAX_DEPTH);
     EB_FREE(obj->stats_out.stat);
+    EB_FREE_ARRAY(obj->rc_stats_chunk);
     destroy_stats_buffer(&obj->stats_buf_context, obj->frame_stats_buffer);
     EB_DELETE_PTR_ARRAY(obj->rc.coded_frames_stat_queue, CODED_FRAMES_STAT_QUEUE_MAX_DEPTH);
 
@@ -82,6 +85,7 @@ static void encode_context_dctor(EbPtr p) {
         EB_FREE_2D(obj->rc_param_queue);
     EB_DESTROY_MUTEX(obj->rc_param_queue_mutex);
     EB_DESTROY_MUTEX(obj->rc.rc_mutex);
+    EB_DELETE(obj->ladder_member);
 }
 
 EbErrorType svt_aom_encode_context_ctor(EncodeContext *enc_ctx, EbPtr object_init_data_ptr) {
@@ -135,6 +139,7 @@ EbErrorType svt_aom_encode_context_ctor(EncodeContext *enc_ctx, EbPtr object_ini
     EB_CREATE_MUTEX(enc_ctx->total_number_of_shown_frames_mutex);
     EB_CREATE_MUTEX(enc_ctx->ref_pic_list_mutex);
 #endif
+    EB_CREATE_MUTEX(enc_ctx->tile_group_output_mutex);
 
     enc_ctx->initial_picture = TRUE;
 
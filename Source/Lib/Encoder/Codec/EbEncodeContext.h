@@ -141,6 +141,11 @@ typedef struct EncodeContext {
     PacketizationReorderEntry **packetization_reorder_queue;
     uint32_t                    packetization_reorder_queue_head_index;
 
+    // Tile group output. Only the frame that follows the last frame output may
+    // output its tile groups, the mutex orders them with the packetization
+    EbHandle tile_group_output_mutex;
+    uint64_t tile_group_output_decode_order;
+
     // GOP Counters
     uint32_t intra_period_position; // Current position in intra period
     uint32_t pred_struct_position; // Current position within a prediction structure
@@ -185,6 +190,10 @@ typedef struct EncodeContext {
     int               num_lap_buffers;
     STATS_BUFFER_CTX  stats_buf_context;
     SvtAv1FixedBuf    rc_stats_buffer; // replaced oxcf->two_pass_cfg.stats_in in aom
+    // Chunk of a chunked two-pass encode: statistics of its frames followed by the
+    // slot of the totals, and its share of the bit budget of the whole input
+    FIRSTPASS_STATS *rc_stats_chunk;
+    int64_t          rc_stats_chunk_bits;
     FirstPassStatsOut stats_out;
     RecodeLoopType    recode_loop;
     // This feature controls the tolerence vs target used in deciding whether to
@@ -204,6 +213,8 @@ typedef struct EncodeContext {
     Dequants         deq_bd; // follows input bit depth
     Quants           quants_8bit; // 8bit
     Dequants         deq_8bit; // 8bit
+    // Membership in the ladder group of the instance, NULL when the instance is in none
+    struct LadderMember *ladder_member;
 } EncodeContext;
 
 typedef struct EncodeContextInitData {
@@ -2574,8 +2574,13 @@ static void write_tile_info(const PictureParentControlSet *const pcs,
 
         // Number of bytes in tile size - 1
         uint32_t max_tile_size = 0;
-        for (int tile_idx = 0; tile_idx < tile_cnt - 1; tile_idx++) {
-            max_tile_size = AOMMAX(max_tile_size, pcs->child_pcs->ec_info[tile_idx]->ec->ec_writer.pos);
+        if (pcs->child_pcs->tile_group_output) {
+            // The header may be written before the tiles are coded, use the largest size field
+            max_tile_size = 1 << 24;
+        } else {
+            for (int tile_idx = 0; tile_idx < tile_cnt - 1; tile_idx++) {
+                max_tile_size = AOMMAX(max_tile_size, pcs->child_pcs->ec_info[tile_idx]->ec->ec_writer.pos);
+            }
         }
         if (max_tile_size >> 24 != 0)
             pcs->child_pcs->tile_size_bytes_minus_1 = 3;
@@ -3505,8 +3510,13 @@ static void write_uncompressed_header_obu(SequenceControlSet *scs /*Av1Comp *cpi
         svt_aom_wb_write_bit(wb, frm_hdr->delta_q_params.delta_q_present);
         if (frm_hdr->delta_q_params.delta_q_present) {
             svt_aom_wb_write_literal(wb, OD_ILOG_NZ(frm_hdr->delta_q_params.delta_q_res) - 1, 2);
-            for (uint16_t tile_idx = 0; tile_idx < tile_cnt; tile_idx++) {
-                pcs->prev_qindex[tile_idx] = frm_hdr->quantization_params.base_q_idx;
+            // With tile group output the header is written while the last tiles are coded,
+            // their delta state is reset at the start of the entropy coding of the frame
+            const Bool reset_delta_state = !pcs->child_pcs->tile_group_output;
+            if (reset_delta_state) {
+                for (uint16_t tile_idx = 0; tile_idx < tile_cnt; tile_idx++) {
+                    pcs->prev_qindex[tile_idx] = frm_hdr->quantization_params.base_q_idx;
+                }
             }
             if (frm_hdr->allow_intrabc)
                 assert(frm_hdr->delta_lf_params.delta_lf_present == 0);
@@ -3514,10 +3524,12 @@ static void write_uncompressed_header_obu(SequenceControlSet *scs /*Av1Comp *cpi
                 svt_aom_wb_write_bit(wb, frm_hdr->delta_lf_params.delta_lf_present);
             if (frm_hdr->delta_lf_params.delta_lf_present) {
                 svt_aom_wb_write_literal(wb, OD_ILOG_NZ(frm_hdr->delta_lf_params.delta_lf_res) - 1, 2);
-                pcs->prev_delta_lf_from_base = 0;
                 svt_aom_wb_write_bit(wb, frm_hdr->delta_lf_params.delta_lf_multi);
-                const int32_t frame_lf_count = pcs->monochrome == 0 ? FRAME_LF_COUNT : FRAME_LF_COUNT - 2;
-                for (int32_t lf_id = 0; lf_id < frame_lf_count; ++lf_id) pcs->prev_delta_lf[lf_id] = 0;
+                if (reset_delta_state) {
+                    pcs->prev_delta_lf_from_base = 0;
+                    const int32_t frame_lf_count = pcs->monochrome == 0 ? FRAME_LF_COUNT : FRAME_LF_COUNT - 2;
+                    for (int32_t lf_id = 0; lf_id < frame_lf_count; ++lf_id) pcs->prev_delta_lf[lf_id] = 0;
+                }
             }
         }
     }
@@ -3763,6 +3775,36 @@ EbErrorType svt_aom_write_metadata_av1(Bitstream *bitstream_ptr, SvtMetadataArra
     return return_error;
 }
 
+// Copies the tiles start_tile to end_tile of the EC streams, each but the last preceded by its size,
+// at data + curr_data_size. Returns the updated size, data is updated if the buffer is reallocated
+static int32_t write_tiles(OutputBitstreamUnit *output_bitstream_ptr, PictureControlSet *pcs, uint8_t **data,
+                           int32_t curr_data_size, uint16_t start_tile, uint16_t end_tile) {
+    // Add data from EC stream to Picture Stream.
+    for (uint16_t tile_idx = start_tile; tile_idx <= end_tile; tile_idx++) {
+        const int32_t tile_size       = pcs->ec_info[tile_idx]->ec->ec_writer.pos;
+        uint8_t       tile_size_bytes = 0;
+        if (tile_idx != end_tile) {
+            tile_size_bytes = pcs->tile_size_bytes_minus_1 + 1;
+            mem_put_varsize(*data + curr_data_size, tile_size_bytes, tile_size - 1);
+        }
+        OutputBitstreamUnit *ec_output_bitstream_ptr =
+            (OutputBitstreamUnit *)pcs->ec_info[tile_idx]->ec->ec_output_bitstream_ptr;
+        assert(output_bitstream_ptr->buffer_av1 >= output_bitstream_ptr->buffer_begin_av1);
+        // Size of the buffer needed to store all data; if buffer is too small, increase buffer
+        // size
+        uint32_t data_size = (uint32_t)tile_size + curr_data_size + tile_size_bytes + 10 /*MAX length_field_size*/ +
+            (uint32_t)(output_bitstream_ptr->buffer_av1 - output_bitstream_ptr->buffer_begin_av1);
+        if (output_bitstream_ptr->size < data_size) {
+            svt_realloc_output_bitstream_unit(output_bitstream_ptr,
+                                              data_size + 1); // plus one for good measure
+            *data = output_bitstream_ptr->buffer_av1;
+        }
+        svt_memcpy(*data + curr_data_size + tile_size_bytes, ec_output_bitstream_ptr->buffer_begin_av1, tile_size);
+        curr_data_size += (tile_size + tile_size_bytes);
+    }
+    return curr_data_size;
+}
+
 /**************************************************
 * EncodeFrameHeaderHeader
 **************************************************/
@@ -3795,32 +3837,8 @@ EbErrorType svt_aom_write_frame_header_av1(Bitstream *bitstream_ptr, SequenceCon
     curr_data_size += write_tile_group_header(
         data + curr_data_size, 0, 0, n_log2_tiles, tile_start_and_end_present_flag);
 
-    if (!show_existing) {
-        // Add data from EC stream to Picture Stream.
-        for (int tile_idx = 0; tile_idx < tile_cnt; tile_idx++) {
-            const int32_t tile_size       = pcs->ec_info[tile_idx]->ec->ec_writer.pos;
-            uint8_t       tile_size_bytes = 0;
-            // tile_size += (tile_idx != tile_cnt - 1) ? 4 : 0;
-            if (tile_idx != tile_cnt - 1 && tile_cnt > 1) {
-                tile_size_bytes = pcs->tile_size_bytes_minus_1 + 1;
-                mem_put_varsize(data + curr_data_size, tile_size_bytes, tile_size - 1);
-            }
-            OutputBitstreamUnit *ec_output_bitstream_ptr =
-                (OutputBitstreamUnit *)pcs->ec_info[tile_idx]->ec->ec_output_bitstream_ptr;
-            assert(output_bitstream_ptr->buffer_av1 >= output_bitstream_ptr->buffer_begin_av1);
-            // Size of the buffer needed to store all data; if buffer is too small, increase buffer
-            // size
-            uint32_t data_size = (uint32_t)tile_size + curr_data_size + tile_size_bytes + 10 /*MAX length_field_size*/ +
-                (uint32_t)(output_bitstream_ptr->buffer_av1 - output_bitstream_ptr->buffer_begin_av1);
-            if (output_bitstream_ptr->size < data_size) {
-                svt_realloc_output_bitstream_unit(output_bitstream_ptr,
-                                                  data_size + 1); // plus one for good measure
-                data = output_bitstream_ptr->buffer_av1;
-            }
-            svt_memcpy(data + curr_data_size + tile_size_bytes, ec_output_bitstream_ptr->buffer_begin_av1, tile_size);
-            curr_data_size += (tile_size + tile_size_bytes);
-        }
-    }
+    if (!show_existing)
+        curr_data_size = write_tiles(output_bitstream_ptr, pcs, &data, curr_data_size, 0, tile_cnt - 1);
     const uint32_t obu_payload_size  = curr_data_size - obu_header_size;
     const size_t   length_field_size = obu_mem_move(obu_header_size, obu_payload_size, data);
     if (write_uleb_obu_size(obu_header_size, obu_payload_size, data) != AOM_CODEC_OK) {
@@ -3833,6 +3851,56 @@ EbErrorType svt_aom_write_frame_header_av1(Bitstream *bitstream_ptr, SequenceCon
     return return_error;
 }
 
+/**************************************************
+* svt_aom_write_frame_header_obu_av1
+*   Writes the frame header as an OBU_FRAME_HEADER, the
+*   tiles follow in OBU_TILE_GROUPs
+**************************************************/
+EbErrorType svt_aom_write_frame_header_obu_av1(Bitstream *bitstream_ptr, SequenceControlSet *scs,
+                                               PictureControlSet *pcs) {
+    OutputBitstreamUnit *output_bitstream_ptr = (OutputBitstreamUnit *)bitstream_ptr->output_bitstream_ptr;
+    uint8_t             *data                 = output_bitstream_ptr->buffer_av1;
+
+    const uint32_t obu_header_size = write_obu_header(OBU_FRAME_HEADER, 0, data);
+    int32_t curr_data_size = obu_header_size + write_frame_header_obu(scs, pcs->ppcs, data + obu_header_size, 0, 1);
+
+    const uint32_t obu_payload_size  = curr_data_size - obu_header_size;
+    const size_t   length_field_size = obu_mem_move(obu_header_size, obu_payload_size, data);
+    if (write_uleb_obu_size(obu_header_size, obu_payload_size, data) != AOM_CODEC_OK) {
+        assert(0);
+    }
+    curr_data_size += (int32_t)length_field_size;
+
+    output_bitstream_ptr->buffer_av1 = data + curr_data_size;
+    return EB_ErrorNone;
+}
+
+/**************************************************
+* svt_aom_write_tile_group_av1
+*   Writes the tiles start_tile to end_tile as an OBU_TILE_GROUP
+**************************************************/
+EbErrorType svt_aom_write_tile_group_av1(Bitstream *bitstream_ptr, PictureControlSet *pcs, uint16_t start_tile,
+                                         uint16_t end_tile) {
+    OutputBitstreamUnit *output_bitstream_ptr = (OutputBitstreamUnit *)bitstream_ptr->output_bitstream_ptr;
+    Av1Common *const     cm                   = pcs->ppcs->av1_cm;
+    uint8_t             *data                 = output_bitstream_ptr->buffer_av1;
+
+    const uint32_t obu_header_size = write_obu_header(OBU_TILE_GROUP, 0, data);
+    int32_t        curr_data_size  = obu_header_size +
+        write_tile_group_header(data + obu_header_size, start_tile, end_tile, cm->log2_tile_rows + cm->log2_tile_cols, 1);
+    curr_data_size = write_tiles(output_bitstream_ptr, pcs, &data, curr_data_size, start_tile, end_tile);
+
+    const uint32_t obu_payload_size  = curr_data_size - obu_header_size;
+    const size_t   length_field_size = obu_mem_move(obu_header_size, obu_payload_size, data);
+    if (write_uleb_obu_size(obu_header_size, obu_payload_size, data) != AOM_CODEC_OK) {
+        assert(0);
+    }
+    curr_data_size += (int32_t)length_field_size;
+
+    output_bitstream_ptr->buffer_av1 = data + curr_data_size;
+    return EB_ErrorNone;
+}
+
 /**************************************************
 * svt_aom_encode_sps_av1
 **************************************************/
@@ -183,6 +183,10 @@ extern EbErrorType svt_aom_write_metadata_av1(Bitstream *bitstream_ptr, SvtMetad
 extern EbErrorType svt_aom_write_frame_header_av1(Bitstream *bitstream_ptr, SequenceControlSet *scs,
                                                   PictureControlSet *pcs, uint8_t show_existing);
 extern EbErrorType svt_aom_encode_td_av1(uint8_t *bitstream_ptr);
+extern EbErrorType svt_aom_write_frame_header_obu_av1(Bitstream *bitstream_ptr, SequenceControlSet *scs,
+                                                      PictureControlSet *pcs);
+extern EbErrorType svt_aom_write_tile_group_av1(Bitstream *bitstream_ptr, PictureControlSet *pcs, uint16_t start_tile,
+                                                uint16_t end_tile);
 extern EbErrorType svt_aom_encode_sps_av1(Bitstream *bitstream_ptr, SequenceControlSet *scs);
 
 //*******************************************************************************************//
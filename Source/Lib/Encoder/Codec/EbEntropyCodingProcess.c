@@ -14,6 +14,7 @@
 #include <stdio.h>
 #include "EbEncHandle.h"
 #include "EbEntropyCodingProcess.h"
+#include "EbPacketizationProcess.h"
 #include "EbEncDecResults.h"
 #include "EbEntropyCodingResults.h"
 #include "EbRateControlTasks.h"
@@ -205,123 +206,124 @@ static void reset_entropy_coding_picture(EntropyCodingContext *ctx, PictureContr
  *  Bitstream for each block
  *
  ********************************************************************************/
-void *svt_aom_entropy_coding_kernel(void *input_ptr) {
+void svt_aom_entropy_coding_task(void *input_ptr, EbObjectWrapper *rest_results_wrapper) {
     // Context & SCS & PCS
     EbThreadContext      *thread_ctx  = (EbThreadContext *)input_ptr;
     EntropyCodingContext *context_ptr = (EntropyCodingContext *)thread_ctx->priv;
 
     // Input
-    EbObjectWrapper *rest_results_wrapper;
 
     // Output
     EbObjectWrapper      *entropy_coding_results_wrapper_ptr;
     EntropyCodingResults *entropy_coding_results_ptr;
 
-    for (;;) {
-        // Get Mode Decision Results
-        EB_GET_FULL_OBJECT(context_ptr->enc_dec_input_fifo_ptr, &rest_results_wrapper);
-
-        RestResults        *rest_results = (RestResults *)rest_results_wrapper->object_ptr;
-        PictureControlSet  *pcs          = (PictureControlSet *)rest_results->pcs_wrapper->object_ptr;
-        SequenceControlSet *scs          = pcs->scs;
-        // SB Constants
-
-        uint8_t sb_size = (uint8_t)scs->sb_size;
-
-        uint8_t          sb_size_log2    = (uint8_t)svt_log2f(sb_size);
-        uint32_t         pic_width_in_sb = (pcs->ppcs->aligned_width + sb_size - 1) >> sb_size_log2;
-        uint16_t         tile_idx        = rest_results->tile_index;
-        Av1Common *const cm              = pcs->ppcs->av1_cm;
-        const uint16_t   tile_cnt        = cm->tiles_info.tile_rows * cm->tiles_info.tile_cols;
-        const uint16_t   tile_col        = tile_idx % cm->tiles_info.tile_cols;
-        const uint16_t   tile_row        = tile_idx / cm->tiles_info.tile_cols;
-        const uint16_t   tile_sb_start_x = cm->tiles_info.tile_col_start_mi[tile_col] >> scs->seq_header.sb_size_log2;
-        const uint16_t   tile_sb_start_y = cm->tiles_info.tile_row_start_mi[tile_row] >> scs->seq_header.sb_size_log2;
-
-        uint16_t tile_width_in_sb = (cm->tiles_info.tile_col_start_mi[tile_col + 1] -
-                                     cm->tiles_info.tile_col_start_mi[tile_col]) >>
-            scs->seq_header.sb_size_log2;
-        uint16_t tile_height_in_sb = (cm->tiles_info.tile_row_start_mi[tile_row + 1] -
-                                      cm->tiles_info.tile_row_start_mi[tile_row]) >>
-            scs->seq_header.sb_size_log2;
-
-        Bool frame_entropy_done = FALSE;
-
-        svt_block_on_mutex(pcs->entropy_coding_pic_mutex);
-        if (pcs->entropy_coding_pic_reset_flag) {
-            pcs->entropy_coding_pic_reset_flag = FALSE;
-
-            reset_entropy_coding_picture(context_ptr, pcs, scs);
-        }
-        svt_release_mutex(pcs->entropy_coding_pic_mutex);
-        if (!svt_aom_is_pic_skipped(pcs->ppcs)) {
-            for (uint32_t y_sb_index = 0; y_sb_index < tile_height_in_sb; ++y_sb_index) {
-                for (uint32_t x_sb_index = 0; x_sb_index < tile_width_in_sb; ++x_sb_index) {
-                    uint16_t    sb_index = (uint16_t)((x_sb_index + tile_sb_start_x) +
-                                                   (y_sb_index + tile_sb_start_y) * pic_width_in_sb);
-                    SuperBlock *sb_ptr   = pcs->sb_ptr_array[sb_index];
-
-                    context_ptr->sb_origin_x = (x_sb_index + tile_sb_start_x) << sb_size_log2;
-                    context_ptr->sb_origin_y = (y_sb_index + tile_sb_start_y) << sb_size_log2;
-                    if (x_sb_index == 0 && y_sb_index == 0) {
-                        svt_av1_reset_loop_restoration(pcs, tile_idx);
-                        context_ptr->tok = pcs->tile_tok[tile_row][tile_col];
-                    }
-
-                    EbPictureBufferDesc *coeff_picture_ptr = pcs->ppcs->enc_dec_ptr->quantized_coeff[sb_index];
-                    svt_aom_write_sb(context_ptr, sb_ptr, pcs, tile_idx, pcs->ec_info[tile_idx]->ec, coeff_picture_ptr);
+    RestResults        *rest_results = (RestResults *)rest_results_wrapper->object_ptr;
+    PictureControlSet  *pcs          = (PictureControlSet *)rest_results->pcs_wrapper->object_ptr;
+    SequenceControlSet *scs          = pcs->scs;
+    // SB Constants
+
+    uint8_t sb_size = (uint8_t)scs->sb_size;
+
+    uint8_t          sb_size_log2    = (uint8_t)svt_log2f(sb_size);
+    uint32_t         pic_width_in_sb = (pcs->ppcs->aligned_width + sb_size - 1) >> sb_size_log2;
+    uint16_t         tile_idx        = rest_results->tile_index;
+    Av1Common *const cm              = pcs->ppcs->av1_cm;
+    const uint16_t   tile_cnt        = cm->tiles_info.tile_rows * cm->tiles_info.tile_cols;
+    const uint16_t   tile_col        = tile_idx % cm->tiles_info.tile_cols;
+    const uint16_t   tile_row        = tile_idx / cm->tiles_info.tile_cols;
+    const uint16_t   tile_sb_start_x = cm->tiles_info.tile_col_start_mi[tile_col] >> scs->seq_header.sb_size_log2;
+    const uint16_t   tile_sb_start_y = cm->tiles_info.tile_row_start_mi[tile_row] >> scs->seq_header.sb_size_log2;
+
+    uint16_t tile_width_in_sb = (cm->tiles_info.tile_col_start_mi[tile_col + 1] -
+                                 cm->tiles_info.tile_col_start_mi[tile_col]) >>
+        scs->seq_header.sb_size_log2;
+    uint16_t tile_height_in_sb = (cm->tiles_info.tile_row_start_mi[tile_row + 1] -
+                                  cm->tiles_info.tile_row_start_mi[tile_row]) >>
+        scs->seq_header.sb_size_log2;
+
+    Bool frame_entropy_done = FALSE;
+
+    svt_block_on_mutex(pcs->entropy_coding_pic_mutex);
+    if (pcs->entropy_coding_pic_reset_flag) {
+        pcs->entropy_coding_pic_reset_flag = FALSE;
+
+        reset_entropy_coding_picture(context_ptr, pcs, scs);
+    }
+    svt_release_mutex(pcs->entropy_coding_pic_mutex);
+    if (!svt_aom_is_pic_skipped(pcs->ppcs)) {
+        for (uint32_t y_sb_index = 0; y_sb_index < tile_height_in_sb; ++y_sb_index) {
+            for (uint32_t x_sb_index = 0; x_sb_index < tile_width_in_sb; ++x_sb_index) {
+                uint16_t    sb_index = (uint16_t)((x_sb_index + tile_sb_start_x) +
+                                               (y_sb_index + tile_sb_start_y) * pic_width_in_sb);
+                SuperBlock *sb_ptr   = pcs->sb_ptr_array[sb_index];
+
+                context_ptr->sb_origin_x = (x_sb_index + tile_sb_start_x) << sb_size_log2;
+                context_ptr->sb_origin_y = (y_sb_index + tile_sb_start_y) << sb_size_log2;
+                if (x_sb_index == 0 && y_sb_index == 0) {
+                    svt_av1_reset_loop_restoration(pcs, tile_idx);
+                    context_ptr->tok = pcs->tile_tok[tile_row][tile_col];
                 }
-            }
-        }
-        Bool pic_ready = TRUE;
 
-        // Current tile ready
-        svt_aom_encode_slice_finish(pcs->ec_info[tile_idx]->ec);
-
-        svt_block_on_mutex(pcs->entropy_coding_pic_mutex);
-        pcs->ec_info[tile_idx]->entropy_coding_tile_done = TRUE;
-        for (uint16_t i = 0; i < tile_cnt; i++) {
-            if (pcs->ec_info[i]->entropy_coding_tile_done == FALSE) {
-                pic_ready = FALSE;
-                break;
+                EbPictureBufferDesc *coeff_picture_ptr = pcs->ppcs->enc_dec_ptr->quantized_coeff[sb_index];
+                svt_aom_write_sb(context_ptr, sb_ptr, pcs, tile_idx, pcs->ec_info[tile_idx]->ec, coeff_picture_ptr);
             }
         }
-        svt_release_mutex(pcs->entropy_coding_pic_mutex);
-        if (pic_ready) {
-            if (pcs->ppcs->superres_total_recode_loop == 0) {
-                // Release the List 0 Reference Pictures
-                for (uint32_t ref_idx = 0; ref_idx < pcs->ppcs->ref_list0_count; ++ref_idx) {
-                    if (pcs->ref_pic_ptr_array[0][ref_idx] != NULL) {
-                        svt_release_object(pcs->ref_pic_ptr_array[0][ref_idx]);
-                    }
+    }
+    Bool pic_ready = TRUE;
+
+    // Current tile ready
+    svt_aom_encode_slice_finish(pcs->ec_info[tile_idx]->ec);
+
+    // Held until the tiles are output so the packetization can't release the picture meanwhile
+    if (pcs->tile_group_output)
+        svt_block_on_mutex(scs->enc_ctx->tile_group_output_mutex);
+    svt_block_on_mutex(pcs->entropy_coding_pic_mutex);
+    pcs->ec_info[tile_idx]->entropy_coding_tile_done = TRUE;
+    for (uint16_t i = 0; i < tile_cnt; i++) {
+        if (pcs->ec_info[i]->entropy_coding_tile_done == FALSE) {
+            pic_ready = FALSE;
+            break;
+        }
+    }
+    svt_release_mutex(pcs->entropy_coding_pic_mutex);
+    if (pcs->tile_group_output) {
+        // Once all the tiles are coded the packetization outputs the ones left
+        if (!pic_ready)
+            svt_aom_tile_group_output(pcs);
+        svt_release_mutex(scs->enc_ctx->tile_group_output_mutex);
+    }
+    if (pic_ready) {
+        if (pcs->ppcs->superres_total_recode_loop == 0) {
+            // Release the List 0 Reference Pictures
+            for (uint32_t ref_idx = 0; ref_idx < pcs->ppcs->ref_list0_count; ++ref_idx) {
+                if (pcs->ref_pic_ptr_array[0][ref_idx] != NULL) {
+                    svt_release_object(pcs->ref_pic_ptr_array[0][ref_idx]);
                 }
-                // Release the List 1 Reference Pictures
-                for (uint32_t ref_idx = 0; ref_idx < pcs->ppcs->ref_list1_count; ++ref_idx) {
-                    if (pcs->ref_pic_ptr_array[1][ref_idx] != NULL) {
-                        svt_release_object(pcs->ref_pic_ptr_array[1][ref_idx]);
-                    }
+            }
+            // Release the List 1 Reference Pictures
+            for (uint32_t ref_idx = 0; ref_idx < pcs->ppcs->ref_list1_count; ++ref_idx) {
+                if (pcs->ref_pic_ptr_array[1][ref_idx] != NULL) {
+                    svt_release_object(pcs->ref_pic_ptr_array[1][ref_idx]);
                 }
-
-                //free palette data
-                if (pcs->tile_tok[0][0])
-                    EB_FREE_ARRAY(pcs->tile_tok[0][0]);
             }
-            frame_entropy_done = TRUE;
-        }
 
-        if (frame_entropy_done) {
-            // Get Empty Entropy Coding Results
-            svt_get_empty_object(context_ptr->entropy_coding_output_fifo_ptr, &entropy_coding_results_wrapper_ptr);
-            entropy_coding_results_ptr = (EntropyCodingResults *)entropy_coding_results_wrapper_ptr->object_ptr;
-            entropy_coding_results_ptr->pcs_wrapper = rest_results->pcs_wrapper;
-
-            // Post EntropyCoding Results
-            svt_post_full_object(entropy_coding_results_wrapper_ptr);
+            //free palette data
+            if (pcs->tile_tok[0][0])
+                EB_FREE_ARRAY(pcs->tile_tok[0][0]);
         }
+        frame_entropy_done = TRUE;
+    }
+
+    if (frame_entropy_done) {
+        // Get Empty Entropy Coding Results
+        svt_get_empty_object(context_ptr->entropy_coding_output_fifo_ptr, &entropy_coding_results_wrapper_ptr);
+        entropy_coding_results_ptr = (EntropyCodingResults *)entropy_coding_results_wrapper_ptr->object_ptr;
+        entropy_coding_results_ptr->pcs_wrapper = rest_results->pcs_wrapper;
 
-        // Release Mode Decision Results
-        svt_release_object(rest_results_wrapper);
+        // Post EntropyCoding Results
+        svt_post_full_object(entropy_coding_results_wrapper_ptr);
     }
 
-    return NULL;
+    // Release Mode Decision Results
+    svt_release_object(rest_results_wrapper);
 }
@@ -71,6 +71,6 @@ typedef struct EntropyCodingContext {
 extern EbErrorType svt_aom_entropy_coding_context_ctor(EbThreadContext *thread_ctx, const EbEncHandle *enc_handle_ptr,
                                                        int index, int rate_control_index);
 
-extern void *svt_aom_entropy_coding_kernel(void *input_ptr);
+extern void svt_aom_entropy_coding_task(void *input_ptr, EbObjectWrapper *in_wrapper_ptr);
 
 #endif // EbEntropyCodingProcess_h
@@ -135,10 +135,6 @@ void svt_aom_global_motion_estimation(PictureParentControlSet *pcs, EbPictureBuf
     sixteenth_picture_ptr = (EbPictureBufferDesc *)pa_reference_object->sixteenth_downsampled_picture_ptr;
     PictureControlSet *cpcs;
     cpcs = pcs->child_pcs;
-    if (pcs->gm_ctrls.use_ref_info) {
-        quarter_picture_ptr   = pcs->quarter_src_pic;
-        sixteenth_picture_ptr = pcs->sixteenth_src_pic;
-    }
     uint32_t num_of_list_to_search = (pcs->slice_type == P_SLICE) ? 1 /*List 0 only*/ : 2 /*List 0 + 1*/;
     // Initilize global motion to be OFF for all references frames.
     memset(pcs->is_global_motion, FALSE, MAX_NUM_OF_REF_PIC_LIST * REF_LIST_MAX_DEPTH);
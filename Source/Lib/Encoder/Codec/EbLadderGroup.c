@@ -0,0 +1,387 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "EbLadderGroup.h"
+#include "EbSequenceControlSet.h"
+#include "EbThreads.h"
+#include "EbLog.h"
+#include "EbUtility.h"
+
+// TPL costs of a block, the ones r0, beta and the rdmult scaling factors derive from
+typedef struct LadderTplCost {
+    int64_t recrf_dist;
+    int64_t mc_dep_rate;
+    int64_t mc_dep_dist;
+} LadderTplCost;
+
+typedef struct LadderTplFrame {
+    uint64_t picture_number;
+    // Luma size of the picture and TPL grid of the costs
+    uint16_t       width;
+    uint16_t       height;
+    uint16_t       blk_size;
+    uint16_t       cols;
+    uint16_t       rows;
+    LadderTplCost *cost;
+} LadderTplFrame;
+
+// TPL costs published by the leader for the TPL group of a base picture
+typedef struct LadderTplEntry {
+    struct LadderTplEntry *next;
+    uint64_t               picture_number;
+    // FALSE when the leader did not run its TPL model for the picture
+    Bool tpl_done;
+    // Followers that did not pass the picture yet
+    uint32_t       pending_count;
+    uint32_t       frame_count;
+    LadderTplFrame frame_array[MAX_TPL_LA_SW];
+} LadderTplEntry;
+
+struct LadderGroup {
+    LadderGroup  *next;
+    uint32_t      id;
+    LadderMember *member_list;
+    LadderMember *leader;
+    // Published entries, by increasing picture number
+    LadderTplEntry *entry_list;
+    Bool            published;
+    uint64_t        last_picture_number;
+    Bool            end_of_sequence;
+    // Bumped on each change a follower may be waiting for
+    CondVar update;
+};
+
+// Groups of the process, guarded by ladder_mutex
+static LadderGroup *ladder_group_list;
+static EbHandle     ladder_mutex;
+
+static void ladder_mutex_cleanup(void) { svt_destroy_mutex(ladder_mutex); }
+static void create_ladder_mutex(void) {
+    ladder_mutex = svt_create_mutex();
+    atexit(ladder_mutex_cleanup);
+}
+
+#ifdef _WIN32
+
+#include <windows.h>
+
+static INIT_ONCE ladder_once = INIT_ONCE_STATIC_INIT;
+
+static BOOL CALLBACK create_ladder_mutex_wrapper(PINIT_ONCE InitOnce, PVOID Parameter, PVOID *lpContext) {
+    (void)InitOnce;
+    (void)Parameter;
+    (void)lpContext;
+    create_ladder_mutex();
+    return TRUE;
+}
+
+static EbHandle get_ladder_mutex(void) {
+    InitOnceExecuteOnce(&ladder_once, create_ladder_mutex_wrapper, NULL, NULL);
+    return ladder_mutex;
+}
+#else
+#include <pthread.h>
+
+static pthread_once_t ladder_once = PTHREAD_ONCE_INIT;
+
+static EbHandle get_ladder_mutex(void) {
+    pthread_once(&ladder_once, create_ladder_mutex);
+    return ladder_mutex;
+}
+#endif // _WIN32
+
+static void ladder_entry_free(LadderTplEntry *entry) {
+    for (uint32_t i = 0; i < entry->frame_count; i++) EB_FREE_ARRAY(entry->frame_array[i].cost);
+    EB_FREE(entry);
+}
+
+// TPL grid of the picture, as laid out by the TPL dispenser
+static void get_tpl_grid(const PictureParentControlSet *pcs, uint16_t *cols, uint16_t *rows) {
+    const uint16_t width  = pcs->enhanced_pic->width;
+    const uint16_t height = pcs->enhanced_pic->height;
+    if (pcs->tpl_ctrls.synth_blk_size == 8) {
+        *cols = ((width + 15) / 16) << 1;
+        *rows = ((height + 15) / 16) << 1;
+    } else if (pcs->tpl_ctrls.synth_blk_size == 32) {
+        *cols = (width + 31) / 32;
+        *rows = (height + 31) / 32;
+    } else {
+        *cols = (width + 15) / 16;
+        *rows = (height + 15) / 16;
+    }
+}
+
+// Mark the entries up to picture_number as passed by member, and free the ones passed by all followers
+static void ladder_pass_locked(LadderGroup *group, LadderMember *member, uint64_t picture_number) {
+    if (picture_number < member->next_picture_number)
+        return;
+    LadderTplEntry **link = &group->entry_list;
+    while (*link) {
+        LadderTplEntry *entry = *link;
+        if (entry->picture_number >= member->next_picture_number && entry->picture_number <= picture_number)
+            entry->pending_count--;
+        if (!entry->pending_count) {
+            *link = entry->next;
+            ladder_entry_free(entry);
+        } else
+            link = &entry->next;
+    }
+    member->next_picture_number = picture_number + 1;
+}
+
+static Bool ladder_settings_match(const LadderMember *member, const LadderMember *leader) {
+    return member->hierarchical_levels == leader->hierarchical_levels &&
+        member->intra_period_length == leader->intra_period_length && member->lad_mg == leader->lad_mg;
+}
+
+static void ladder_member_dctor(EbPtr p) {
+    LadderMember *obj   = (LadderMember *)p;
+    LadderGroup  *group = obj->group;
+    if (!group)
+        return;
+    EbHandle mutex = get_ladder_mutex();
+    svt_block_on_mutex(mutex);
+    if (obj->leader)
+        group->leader = NULL;
+    else
+        ladder_pass_locked(group, obj, (uint64_t)~0);
+    LadderMember **member_link = &group->member_list;
+    while (*member_link != obj) member_link = &(*member_link)->next;
+    *member_link = obj->next;
+    if (!group->member_list) {
+        LadderGroup **group_link = &ladder_group_list;
+        while (*group_link != group) group_link = &(*group_link)->next;
+        *group_link = group->next;
+        while (group->entry_list) {
+            LadderTplEntry *entry = group->entry_list;
+            group->entry_list     = entry->next;
+            ladder_entry_free(entry);
+        }
+        EB_FREE(group);
+    } else {
+        // Followers waiting for the leader run their own TPL model from now on
+        svt_add_cond_var(&group->update, 1);
+    }
+    svt_release_mutex(mutex);
+}
+
+EbErrorType svt_aom_ladder_member_ctor(LadderMember *member, uint32_t group_id, Bool leader,
+                                       const struct SequenceControlSet *scs) {
+    EbErrorType return_error    = EB_ErrorNone;
+    member->dctor               = ladder_member_dctor;
+    member->leader              = leader;
+    member->hierarchical_levels = scs->static_config.hierarchical_levels;
+    member->intra_period_length = scs->static_config.intra_period_length;
+    member->lad_mg              = scs->lad_mg;
+
+    EbHandle mutex = get_ladder_mutex();
+    svt_block_on_mutex(mutex);
+    LadderGroup *group = ladder_group_list;
+    while (group && group->id != group_id) group = group->next;
+    if (!group) {
+        EB_NO_THROW_CALLOC(group, 1, sizeof(*group));
+        if (group) {
+            group->id = group_id;
+            svt_create_cond_var(&group->update);
+            group->next       = ladder_group_list;
+            ladder_group_list = group;
+        } else
+            return_error = EB_ErrorInsufficientResources;
+    } else if (leader && group->leader) {
+        SVT_ERROR("Ladder group %u already has a leader\n", group_id);
+        return_error = EB_ErrorBadParameter;
+    }
+    if (return_error == EB_ErrorNone) {
+        member->group               = group;
+        member->next                = group->member_list;
+        group->member_list          = member;
+        member->next_picture_number = group->published ? group->last_picture_number + 1 : 0;
+        if (leader) {
+            group->leader          = member;
+            group->end_of_sequence = FALSE;
+        }
+    }
+    svt_release_mutex(mutex);
+    return return_error;
+}
+
+EbErrorType svt_aom_ladder_publish_tpl(LadderMember *member, PictureParentControlSet *pcs, Bool tpl_done) {
+    LadderGroup    *group        = member->group;
+    EbHandle        mutex        = get_ladder_mutex();
+    LadderTplEntry *entry        = NULL;
+    Bool            has_follower = FALSE;
+
+    svt_block_on_mutex(mutex);
+    for (LadderMember *m = group->member_list; m; m = m->next) has_follower |= !m->leader;
+    svt_release_mutex(mutex);
+
+    if (has_follower) {
+        EB_NO_THROW_CALLOC(entry, 1, sizeof(*entry));
+        if (entry) {
+            entry->picture_number = pcs->picture_number;
+            entry->tpl_done       = tpl_done;
+        }
+    }
+    if (entry && tpl_done) {
+        const uint32_t frames_in_sw = MIN(MAX_TPL_LA_SW, pcs->tpl_group_size);
+        for (uint32_t frame_idx = 0; frame_idx < frames_in_sw; frame_idx++) {
+            PictureParentControlSet *frame_pcs = pcs->tpl_group[frame_idx];
+            LadderTplFrame          *frame     = &entry->frame_array[entry->frame_count];
+            if (!pcs->tpl_valid_pic[frame_idx])
+                continue;
+            frame->picture_number = frame_pcs->picture_number;
+            frame->width          = frame_pcs->enhanced_pic->width;
+            frame->height         = frame_pcs->enhanced_pic->height;
+            frame->blk_size       = frame_pcs->tpl_ctrls.synth_blk_size;
+            get_tpl_grid(frame_pcs, &frame->cols, &frame->rows);
+            EB_NO_THROW_MALLOC(frame->cost, sizeof(*frame->cost) * frame->cols * frame->rows);
+            if (!frame->cost) {
+                ladder_entry_free(entry);
+                entry = NULL;
+                break;
+            }
+            for (uint32_t i = 0; i < (uint32_t)(frame->cols * frame->rows); i++) {
+                const TplStats *tpl_stats_ptr = frame_pcs->pa_me_data->tpl_stats[i];
+                frame->cost[i].recrf_dist     = tpl_stats_ptr->recrf_dist;
+                frame->cost[i].mc_dep_rate    = tpl_stats_ptr->mc_dep_rate;
+                frame->cost[i].mc_dep_dist    = tpl_stats_ptr->mc_dep_dist;
+            }
+            entry->frame_count++;
+        }
+    }
+
+    svt_block_on_mutex(mutex);
+    if (entry) {
+        // Followers that already passed the picture (e.g. running their own TPL model) never pass it again
+        for (LadderMember *m = group->member_list; m; m = m->next)
+            entry->pending_count += !m->leader && m->next_picture_number <= entry->picture_number;
+        if (entry->pending_count) {
+            LadderTplEntry **link = &group->entry_list;
+            while (*link) link = &(*link)->next;
+            *link = entry;
+        } else
+            ladder_entry_free(entry);
+    }
+    group->published           = TRUE;
+    group->last_picture_number = pcs->picture_number;
+    svt_add_cond_var(&group->update, 1);
+    svt_release_mutex(mutex);
+    // A follower missing the costs of the picture runs its own TPL model
+    return has_follower && !entry ? EB_ErrorInsufficientResources : EB_ErrorNone;
+}
+
+void svt_aom_ladder_end_of_sequence(LadderMember *member) {
+    EbHandle mutex = get_ladder_mutex();
+    svt_block_on_mutex(mutex);
+    member->group->end_of_sequence = TRUE;
+    svt_add_cond_var(&member->group->update, 1);
+    svt_release_mutex(mutex);
+}
+
+// Average of the leader blocks centered in the area of each follower block, normalized to the follower block size
+static void resample_tpl_costs(const LadderTplFrame *src, PictureParentControlSet *pcs) {
+    const uint32_t width    = pcs->enhanced_pic->width;
+    const uint32_t height   = pcs->enhanced_pic->height;
+    const uint32_t blk_size = pcs->tpl_ctrls.synth_blk_size;
+    const int64_t  area_num = (int64_t)blk_size * blk_size;
+    const int64_t  area_den = (int64_t)src->blk_size * src->blk_size;
+    uint16_t       cols, rows;
+    get_tpl_grid(pcs, &cols, &rows);
+
+    for (uint32_t row = 0; row < rows; row++) {
+        // Leader blocks whose center is in the follower block, at least the one under its center
+        const uint32_t y0 = (row * blk_size * src->height / height + src->blk_size / 2) / src->blk_size;
+        const uint32_t y1 = ((row + 1) * blk_size * src->height / height + src->blk_size / 2) / src->blk_size;
+        const uint32_t r0 = MIN(y0, (uint32_t)src->rows - 1);
+        const uint32_t r1 = MIN(MAX(y1, r0 + 1), (uint32_t)src->rows);
+        for (uint32_t col = 0; col < cols; col++) {
+            const uint32_t x0 = (col * blk_size * src->width / width + src->blk_size / 2) / src->blk_size;
+            const uint32_t x1 = ((col + 1) * blk_size * src->width / width + src->blk_size / 2) / src->blk_size;
+            const uint32_t c0 = MIN(x0, (uint32_t)src->cols - 1);
+            const uint32_t c1 = MIN(MAX(x1, c0 + 1), (uint32_t)src->cols);
+            int64_t        recrf_dist = 0, mc_dep_rate = 0, mc_dep_dist = 0;
+            for (uint32_t r = r0; r < r1; r++) {
+                for (uint32_t c = c0; c < c1; c++) {
+                    const LadderTplCost *cost = &src->cost[r * src->cols + c];
+                    recrf_dist += cost->recrf_dist;
+                    mc_dep_rate += cost->mc_dep_rate;
+                    mc_dep_dist += cost->mc_dep_dist;
+                }
+            }
+            const int64_t den           = area_den * (r1 - r0) * (c1 - c0);
+            TplStats     *tpl_stats_ptr = pcs->pa_me_data->tpl_stats[row * cols + col];
+            tpl_stats_ptr->recrf_dist   = recrf_dist * area_num / den;
+            tpl_stats_ptr->mc_dep_rate  = mc_dep_rate * area_num / den;
+            tpl_stats_ptr->mc_dep_dist  = mc_dep_dist * area_num / den;
+        }
+    }
+}
+
+Bool svt_aom_ladder_import_tpl(LadderMember *member, PictureParentControlSet *pcs) {
+    if (member->leader || member->disabled)
+        return FALSE;
+    LadderGroup          *group          = member->group;
+    EbHandle              mutex          = get_ladder_mutex();
+    const uint64_t        picture_number = pcs->picture_number;
+    const LadderTplEntry *entry          = NULL;
+    for (;;) {
+        const int32_t update = svt_get_cond_var(&group->update);
+        Bool          wait   = FALSE;
+        svt_block_on_mutex(mutex);
+        if (group->leader && !ladder_settings_match(member, group->leader)) {
+            SVT_WARN("Ladder group %u: mini-GOP settings differ from the leader ones, running the TPL model\n",
+                     group->id);
+            member->disabled = TRUE;
+        } else if (picture_number >= member->next_picture_number) {
+            for (const LadderTplEntry *e = group->entry_list; e && !entry; e = e->next)
+                if (e->picture_number == picture_number)
+                    entry = e;
+            // The leader publishes the base pictures in order
+            wait = !entry && group->leader && !group->end_of_sequence &&
+                (!group->published || group->last_picture_number < picture_number);
+        }
+        svt_release_mutex(mutex);
+        if (!wait)
+            break;
+        svt_wait_cond_var(&group->update, update);
+    }
+    // The entry is kept until the member passes the picture
+    if (!entry || !entry->tpl_done)
+        return FALSE;
+
+    const uint32_t frames_in_sw = MIN(MAX_TPL_LA_SW, pcs->tpl_group_size);
+    for (uint32_t frame_idx = 0; frame_idx < frames_in_sw; frame_idx++) {
+        PictureParentControlSet *frame_pcs = pcs->tpl_group[frame_idx];
+        const LadderTplFrame    *src       = NULL;
+        uint16_t                 cols, rows;
+        for (uint32_t i = 0; i < entry->frame_count && !src; i++)
+            if (entry->frame_array[i].picture_number == frame_pcs->picture_number)
+                src = &entry->frame_array[i];
+        get_tpl_grid(frame_pcs, &cols, &rows);
+        for (uint32_t i = 0; i < (uint32_t)(cols * rows); i++)
+            memset(frame_pcs->pa_me_data->tpl_stats[i], 0, sizeof(TplStats));
+        if (src && pcs->tpl_valid_pic[frame_idx])
+            resample_tpl_costs(src, frame_pcs);
+    }
+    return TRUE;
+}
+
+void svt_aom_ladder_pass(LadderMember *member, uint64_t picture_number) {
+    if (member->leader)
+        return;
+    EbHandle mutex = get_ladder_mutex();
+    svt_block_on_mutex(mutex);
+    ladder_pass_locked(member->group, member, picture_number);
+    svt_release_mutex(mutex);
+}
@@ -0,0 +1,75 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbLadderGroup_h
+#define EbLadderGroup_h
+
+#include "EbDefinitions.h"
+#include "EbObject.h"
+#include "EbPictureControlSet.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************************************************************
+ * Ladder Group
+ *   Encoder instances of the process encoding the same source at several
+ *   resolutions or bitrates (the renditions of an ABR ladder) join the
+ *   same ladder group. The leader instance runs the TPL model and
+ *   publishes the propagated costs of the pictures of each TPL group. The
+ *   other instances of the group, the followers, skip their TPL dispenser
+ *   and synthesizer and resample the leader costs on their own TPL grid.
+ *   r0, beta and the rdmult scaling factors are then derived from the
+ *   imported costs with the follower picture size and QP.
+ *
+ *   A follower falls back to its own TPL model when the leader has no TPL
+ *   costs for a picture (e.g. TPL is off for the leader preset), when the
+ *   leader mini-GOP settings differ or once the leader reached the end of
+ *   its sequence. Followers wait for the leader, so the renditions must be
+ *   fed with the same pictures in lockstep, the leader first.
+ *********************************************************************/
+typedef struct LadderGroup LadderGroup;
+
+typedef struct LadderMember {
+    EbDctor              dctor;
+    LadderGroup         *group;
+    struct LadderMember *next;
+    Bool                 leader;
+    // Set once the member found the leader mini-GOP settings to differ from its own
+    Bool disabled;
+    // First base picture the member did not pass yet
+    uint64_t next_picture_number;
+    // Mini-GOP settings the member and the leader must agree on
+    uint32_t hierarchical_levels;
+    int32_t  intra_period_length;
+    uint32_t lad_mg;
+} LadderMember;
+
+EbErrorType svt_aom_ladder_member_ctor(LadderMember *member, uint32_t group_id, Bool leader,
+                                       const struct SequenceControlSet *scs);
+/* Leader: publish the TPL costs of the TPL group of the base picture pcs, or
+ * that the picture has none when its TPL group was not processed */
+EbErrorType svt_aom_ladder_publish_tpl(LadderMember *member, PictureParentControlSet *pcs, Bool tpl_done);
+/* Leader: no picture is published after the ones already published */
+void svt_aom_ladder_end_of_sequence(LadderMember *member);
+/* Follower: wait for the leader costs of the TPL group of the base picture pcs
+ * and copy them to the tpl_stats of the pictures of the group. Returns FALSE
+ * when the follower must run its own TPL model */
+Bool svt_aom_ladder_import_tpl(LadderMember *member, PictureParentControlSet *pcs);
+/* Follower: the costs published up to the base picture picture_number are not
+ * needed by the member anymore */
+void svt_aom_ladder_pass(LadderMember *member, uint64_t picture_number);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbLadderGroup_h
@@ -63,6 +63,24 @@ void svt_aom_get_syntax_rate_from_cdf(int32_t *costs, const AomCdfProb *cdf, con
             break;
     }
 }
+/*************************************************************
+ * rate_cdf_dirty()
+ * Returns TRUE when the CDFs at offset of fc differ from the ones the rates
+ * were last estimated from, which are then updated to the ones of fc
+ **************************************************************/
+static INLINE Bool rate_cdf_dirty(FRAME_CONTEXT *rate_fc, const FRAME_CONTEXT *fc, size_t offset, size_t size) {
+    if (!rate_fc)
+        return TRUE;
+    uint8_t       *prev = (uint8_t *)rate_fc + offset;
+    const uint8_t *cdf  = (const uint8_t *)fc + offset;
+    if (!memcmp(prev, cdf, size))
+        return FALSE;
+    memcpy(prev, cdf, size);
+    return TRUE;
+}
+// md_rate_est_ctx and fc are the ones of the estimation function
+#define CDF_DIRTY(f) rate_cdf_dirty(md_rate_est_ctx->rate_fc, fc, offsetof(FRAME_CONTEXT, f), sizeof(fc->f))
+
 /*************************************************************
  * svt_aom_estimate_syntax_rate()
  * Estimate the rate for each syntax elements and for
@@ -74,121 +92,153 @@ void svt_aom_estimate_syntax_rate(MdRateEstimationContext *md_rate_est_ctx, Bool
     int32_t i, j;
 
     md_rate_est_ctx->initialized = 1;
-    for (i = 0; i < PARTITION_CONTEXTS; ++i) {
-        svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->partition_fac_bits[i], fc->partition_cdf[i], NULL);
-
-        AomCdfProb cdf[CDF_SIZE(2)];
-        // The cdf will be updated differently for BLOCK_128X128 vs. all other blocks sizes.
-        // therefore, we must compute the syntax rate for two cases: 128x128 blocks and all other
-        // blocks.
-
-        // Vert alike rate (128x128 and all other blocks)
-        partition_gather_vert_alike(cdf, fc->partition_cdf[i], BLOCK_8X8);
-        // inverse map only needs 2 entries b/c cdf only has 2 active entries
-        static const int bot_inv_map[2] = {PARTITION_HORZ, PARTITION_SPLIT};
-        svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->partition_vert_alike_fac_bits[i], cdf, bot_inv_map);
-
-        partition_gather_vert_alike(cdf, fc->partition_cdf[i], BLOCK_128X128);
-        svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->partition_vert_alike_128x128_fac_bits[i], cdf, bot_inv_map);
-
-        // Horz alike rate (128x128 and all other blocks)
-        partition_gather_horz_alike(cdf, fc->partition_cdf[i], BLOCK_8X8);
-        static const int rhs_inv_map[2] = {PARTITION_VERT, PARTITION_SPLIT};
-        svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->partition_horz_alike_fac_bits[i], cdf, rhs_inv_map);
-
-        partition_gather_horz_alike(cdf, fc->partition_cdf[i], BLOCK_128X128);
-        svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->partition_horz_alike_128x128_fac_bits[i], cdf, rhs_inv_map);
-    }
-
-    for (i = 0; i < SKIP_CONTEXTS; ++i)
-        svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->skip_mode_fac_bits[i], fc->skip_mode_cdfs[i], NULL);
-
-    for (i = 0; i < SKIP_CONTEXTS; ++i)
-        svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->skip_fac_bits[i], fc->skip_cdfs[i], NULL);
-    for (i = 0; i < KF_MODE_CONTEXTS; ++i)
-        for (j = 0; j < KF_MODE_CONTEXTS; ++j)
-            svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->y_mode_fac_bits[i][j], fc->kf_y_cdf[i][j], NULL);
+    if (CDF_DIRTY(partition_cdf)) {
+        for (i = 0; i < PARTITION_CONTEXTS; ++i) {
+            svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->partition_fac_bits[i], fc->partition_cdf[i], NULL);
+
+            AomCdfProb cdf[CDF_SIZE(2)];
+            // The cdf will be updated differently for BLOCK_128X128 vs. all other blocks sizes.
+            // therefore, we must compute the syntax rate for two cases: 128x128 blocks and all other
+            // blocks.
+
+            // Vert alike rate (128x128 and all other blocks)
+            partition_gather_vert_alike(cdf, fc->partition_cdf[i], BLOCK_8X8);
+            // inverse map only needs 2 entries b/c cdf only has 2 active entries
+            static const int bot_inv_map[2] = {PARTITION_HORZ, PARTITION_SPLIT};
+            svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->partition_vert_alike_fac_bits[i], cdf, bot_inv_map);
+
+            partition_gather_vert_alike(cdf, fc->partition_cdf[i], BLOCK_128X128);
+            svt_aom_get_syntax_rate_from_cdf(
+                md_rate_est_ctx->partition_vert_alike_128x128_fac_bits[i], cdf, bot_inv_map);
 
-    for (i = 0; i < BlockSize_GROUPS; ++i)
-        svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->mb_mode_fac_bits[i], fc->y_mode_cdf[i], NULL);
+            // Horz alike rate (128x128 and all other blocks)
+            partition_gather_horz_alike(cdf, fc->partition_cdf[i], BLOCK_8X8);
+            static const int rhs_inv_map[2] = {PARTITION_VERT, PARTITION_SPLIT};
+            svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->partition_horz_alike_fac_bits[i], cdf, rhs_inv_map);
 
-    for (i = 0; i < CFL_ALLOWED_TYPES; ++i) {
-        for (j = 0; j < INTRA_MODES; ++j)
+            partition_gather_horz_alike(cdf, fc->partition_cdf[i], BLOCK_128X128);
             svt_aom_get_syntax_rate_from_cdf(
-                md_rate_est_ctx->intra_uv_mode_fac_bits[i][j], fc->uv_mode_cdf[i][j], NULL);
+                md_rate_est_ctx->partition_horz_alike_128x128_fac_bits[i], cdf, rhs_inv_map);
+        }
     }
-    if (pic_filter_intra_level) {
-        svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->filter_intra_mode_fac_bits, fc->filter_intra_mode_cdf, NULL);
-        for (i = 0; i < BlockSizeS_ALL; ++i) {
-            if (svt_aom_filter_intra_allowed_bsize(1, i))
+
+    if (CDF_DIRTY(skip_mode_cdfs))
+        for (i = 0; i < SKIP_CONTEXTS; ++i)
+            svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->skip_mode_fac_bits[i], fc->skip_mode_cdfs[i], NULL);
+
+    if (CDF_DIRTY(skip_cdfs))
+        for (i = 0; i < SKIP_CONTEXTS; ++i)
+            svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->skip_fac_bits[i], fc->skip_cdfs[i], NULL);
+    if (CDF_DIRTY(kf_y_cdf))
+        for (i = 0; i < KF_MODE_CONTEXTS; ++i)
+            for (j = 0; j < KF_MODE_CONTEXTS; ++j)
+                svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->y_mode_fac_bits[i][j], fc->kf_y_cdf[i][j], NULL);
+
+    if (CDF_DIRTY(y_mode_cdf))
+        for (i = 0; i < BlockSize_GROUPS; ++i)
+            svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->mb_mode_fac_bits[i], fc->y_mode_cdf[i], NULL);
+
+    if (CDF_DIRTY(uv_mode_cdf)) {
+        for (i = 0; i < CFL_ALLOWED_TYPES; ++i) {
+            for (j = 0; j < INTRA_MODES; ++j)
                 svt_aom_get_syntax_rate_from_cdf(
-                    md_rate_est_ctx->filter_intra_fac_bits[i], fc->filter_intra_cdfs[i], NULL);
+                    md_rate_est_ctx->intra_uv_mode_fac_bits[i][j], fc->uv_mode_cdf[i][j], NULL);
         }
     }
-    for (i = 0; i < SWITCHABLE_FILTER_CONTEXTS; ++i)
-        svt_aom_get_syntax_rate_from_cdf(
-            md_rate_est_ctx->switchable_interp_fac_bitss[i], fc->switchable_interp_cdf[i], NULL);
-    if (allow_screen_content_tools) {
-        for (i = 0; i < PALATTE_BSIZE_CTXS; ++i) {
-            svt_aom_get_syntax_rate_from_cdf(
-                md_rate_est_ctx->palette_ysize_fac_bits[i], fc->palette_y_size_cdf[i], NULL);
+    if (pic_filter_intra_level) {
+        if (CDF_DIRTY(filter_intra_mode_cdf))
             svt_aom_get_syntax_rate_from_cdf(
-                md_rate_est_ctx->palette_uv_size_fac_bits[i], fc->palette_uv_size_cdf[i], NULL);
-            for (j = 0; j < PALETTE_Y_MODE_CONTEXTS; ++j)
-                svt_aom_get_syntax_rate_from_cdf(
-                    md_rate_est_ctx->palette_ymode_fac_bits[i][j], fc->palette_y_mode_cdf[i][j], NULL);
+                md_rate_est_ctx->filter_intra_mode_fac_bits, fc->filter_intra_mode_cdf, NULL);
+        if (CDF_DIRTY(filter_intra_cdfs)) {
+            for (i = 0; i < BlockSizeS_ALL; ++i) {
+                if (svt_aom_filter_intra_allowed_bsize(1, i))
+                    svt_aom_get_syntax_rate_from_cdf(
+                        md_rate_est_ctx->filter_intra_fac_bits[i], fc->filter_intra_cdfs[i], NULL);
+            }
         }
-
-        for (i = 0; i < PALETTE_UV_MODE_CONTEXTS; ++i)
+    }
+    if (CDF_DIRTY(switchable_interp_cdf))
+        for (i = 0; i < SWITCHABLE_FILTER_CONTEXTS; ++i)
             svt_aom_get_syntax_rate_from_cdf(
-                md_rate_est_ctx->palette_uv_mode_fac_bits[i], fc->palette_uv_mode_cdf[i], NULL);
-        for (i = 0; i < PALETTE_SIZES; ++i) {
-            for (j = 0; j < PALETTE_COLOR_INDEX_CONTEXTS; ++j) {
+                md_rate_est_ctx->switchable_interp_fac_bitss[i], fc->switchable_interp_cdf[i], NULL);
+    if (allow_screen_content_tools) {
+        if (CDF_DIRTY(palette_y_size_cdf))
+            for (i = 0; i < PALATTE_BSIZE_CTXS; ++i)
                 svt_aom_get_syntax_rate_from_cdf(
-                    md_rate_est_ctx->palette_ycolor_fac_bitss[i][j], fc->palette_y_color_index_cdf[i][j], NULL);
+                    md_rate_est_ctx->palette_ysize_fac_bits[i], fc->palette_y_size_cdf[i], NULL);
+        if (CDF_DIRTY(palette_uv_size_cdf))
+            for (i = 0; i < PALATTE_BSIZE_CTXS; ++i)
                 svt_aom_get_syntax_rate_from_cdf(
-                    md_rate_est_ctx->palette_uv_color_fac_bits[i][j], fc->palette_uv_color_index_cdf[i][j], NULL);
-            }
-        }
+                    md_rate_est_ctx->palette_uv_size_fac_bits[i], fc->palette_uv_size_cdf[i], NULL);
+        if (CDF_DIRTY(palette_y_mode_cdf))
+            for (i = 0; i < PALATTE_BSIZE_CTXS; ++i)
+                for (j = 0; j < PALETTE_Y_MODE_CONTEXTS; ++j)
+                    svt_aom_get_syntax_rate_from_cdf(
+                        md_rate_est_ctx->palette_ymode_fac_bits[i][j], fc->palette_y_mode_cdf[i][j], NULL);
+
+        if (CDF_DIRTY(palette_uv_mode_cdf))
+            for (i = 0; i < PALETTE_UV_MODE_CONTEXTS; ++i)
+                svt_aom_get_syntax_rate_from_cdf(
+                    md_rate_est_ctx->palette_uv_mode_fac_bits[i], fc->palette_uv_mode_cdf[i], NULL);
+        if (CDF_DIRTY(palette_y_color_index_cdf))
+            for (i = 0; i < PALETTE_SIZES; ++i)
+                for (j = 0; j < PALETTE_COLOR_INDEX_CONTEXTS; ++j)
+                    svt_aom_get_syntax_rate_from_cdf(
+                        md_rate_est_ctx->palette_ycolor_fac_bitss[i][j], fc->palette_y_color_index_cdf[i][j], NULL);
+        if (CDF_DIRTY(palette_uv_color_index_cdf))
+            for (i = 0; i < PALETTE_SIZES; ++i)
+                for (j = 0; j < PALETTE_COLOR_INDEX_CONTEXTS; ++j)
+                    svt_aom_get_syntax_rate_from_cdf(
+                        md_rate_est_ctx->palette_uv_color_fac_bits[i][j], fc->palette_uv_color_index_cdf[i][j], NULL);
     }
-    int32_t sign_fac_bits[CFL_JOINT_SIGNS];
-    svt_aom_get_syntax_rate_from_cdf(sign_fac_bits, fc->cfl_sign_cdf, NULL);
-    for (int32_t joint_sign = 0; joint_sign < CFL_JOINT_SIGNS; joint_sign++) {
-        int32_t *fac_bits_u = md_rate_est_ctx->cfl_alpha_fac_bits[joint_sign][CFL_PRED_U];
-        int32_t *fac_bits_v = md_rate_est_ctx->cfl_alpha_fac_bits[joint_sign][CFL_PRED_V];
-        if (CFL_SIGN_U(joint_sign) == CFL_SIGN_ZERO)
-            memset(fac_bits_u, 0, CFL_ALPHABET_SIZE * sizeof(*fac_bits_u));
-        else {
-            const AomCdfProb *cdf_u = fc->cfl_alpha_cdf[CFL_CONTEXT_U(joint_sign)];
-            svt_aom_get_syntax_rate_from_cdf(fac_bits_u, cdf_u, NULL);
-        }
-        if (CFL_SIGN_V(joint_sign) == CFL_SIGN_ZERO)
-            memset(fac_bits_v, 0, CFL_ALPHABET_SIZE * sizeof(*fac_bits_v));
-        else {
-            assert((CFL_CONTEXT_V(joint_sign) < CFL_ALPHA_CONTEXTS) && (CFL_CONTEXT_V(joint_sign) >= 0));
-            const AomCdfProb *cdf_v = fc->cfl_alpha_cdf[CFL_CONTEXT_V(joint_sign)];
-            svt_aom_get_syntax_rate_from_cdf(fac_bits_v, cdf_v, NULL);
+    // Both CDFs are checked so that both are up to date for the next call
+    if (CDF_DIRTY(cfl_sign_cdf) | CDF_DIRTY(cfl_alpha_cdf)) {
+        int32_t sign_fac_bits[CFL_JOINT_SIGNS];
+        svt_aom_get_syntax_rate_from_cdf(sign_fac_bits, fc->cfl_sign_cdf, NULL);
+        for (int32_t joint_sign = 0; joint_sign < CFL_JOINT_SIGNS; joint_sign++) {
+            int32_t *fac_bits_u = md_rate_est_ctx->cfl_alpha_fac_bits[joint_sign][CFL_PRED_U];
+            int32_t *fac_bits_v = md_rate_est_ctx->cfl_alpha_fac_bits[joint_sign][CFL_PRED_V];
+            if (CFL_SIGN_U(joint_sign) == CFL_SIGN_ZERO)
+                memset(fac_bits_u, 0, CFL_ALPHABET_SIZE * sizeof(*fac_bits_u));
+            else {
+                const AomCdfProb *cdf_u = fc->cfl_alpha_cdf[CFL_CONTEXT_U(joint_sign)];
+                svt_aom_get_syntax_rate_from_cdf(fac_bits_u, cdf_u, NULL);
+            }
+            if (CFL_SIGN_V(joint_sign) == CFL_SIGN_ZERO)
+                memset(fac_bits_v, 0, CFL_ALPHABET_SIZE * sizeof(*fac_bits_v));
+            else {
+                assert((CFL_CONTEXT_V(joint_sign) < CFL_ALPHA_CONTEXTS) && (CFL_CONTEXT_V(joint_sign) >= 0));
+                const AomCdfProb *cdf_v = fc->cfl_alpha_cdf[CFL_CONTEXT_V(joint_sign)];
+                svt_aom_get_syntax_rate_from_cdf(fac_bits_v, cdf_v, NULL);
+            }
+            for (int32_t u = 0; u < CFL_ALPHABET_SIZE; u++) fac_bits_u[u] += sign_fac_bits[joint_sign];
         }
-        for (int32_t u = 0; u < CFL_ALPHABET_SIZE; u++) fac_bits_u[u] += sign_fac_bits[joint_sign];
     }
 
-    for (i = 0; i < MAX_TX_CATS; ++i)
-        for (j = 0; j < TX_SIZE_CONTEXTS; ++j)
-            svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->tx_size_fac_bits[i][j], fc->tx_size_cdf[i][j], NULL);
+    if (CDF_DIRTY(tx_size_cdf))
+        for (i = 0; i < MAX_TX_CATS; ++i)
+            for (j = 0; j < TX_SIZE_CONTEXTS; ++j)
+                svt_aom_get_syntax_rate_from_cdf(
+                    md_rate_est_ctx->tx_size_fac_bits[i][j], fc->tx_size_cdf[i][j], NULL);
 
-    for (i = 0; i < TXFM_PARTITION_CONTEXTS; ++i) {
-        svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->txfm_partition_fac_bits[i], fc->txfm_partition_cdf[i], NULL);
+    if (CDF_DIRTY(txfm_partition_cdf)) {
+        for (i = 0; i < TXFM_PARTITION_CONTEXTS; ++i) {
+            svt_aom_get_syntax_rate_from_cdf(
+                md_rate_est_ctx->txfm_partition_fac_bits[i], fc->txfm_partition_cdf[i], NULL);
+        }
     }
 
+    const Bool inter_ext_tx_dirty = CDF_DIRTY(inter_ext_tx_cdf);
+    const Bool intra_ext_tx_dirty = CDF_DIRTY(intra_ext_tx_cdf);
     for (i = TX_4X4; i < EXT_TX_SIZES; ++i) {
         int32_t s;
-        for (s = 1; s < EXT_TX_SETS_INTER; ++s) {
+        for (s = 1; s < EXT_TX_SETS_INTER && inter_ext_tx_dirty; ++s) {
             if (use_inter_ext_tx_for_txsize[s][i])
                 svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->inter_tx_type_fac_bits[s][i],
                                                  fc->inter_ext_tx_cdf[s][i],
                                                  av1_ext_tx_inv[av1_ext_tx_set_idx_to_type[1][s]]);
         }
-        for (s = 1; s < EXT_TX_SETS_INTRA; ++s) {
+        for (s = 1; s < EXT_TX_SETS_INTRA && intra_ext_tx_dirty; ++s) {
             if (use_intra_ext_tx_for_txsize[s][i]) {
                 for (j = 0; j < INTRA_MODES; ++j)
                     svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->intra_tx_type_fac_bits[s][i][j],
@@ -197,85 +247,122 @@ void svt_aom_estimate_syntax_rate(MdRateEstimationContext *md_rate_est_ctx, Bool
             }
         }
     }
-    for (i = 0; i < DIRECTIONAL_MODES; ++i)
-        svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->angle_delta_fac_bits[i], fc->angle_delta_cdf[i], NULL);
+    if (CDF_DIRTY(angle_delta_cdf))
+        for (i = 0; i < DIRECTIONAL_MODES; ++i)
+            svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->angle_delta_fac_bits[i], fc->angle_delta_cdf[i], NULL);
     if (enable_restoration) {
-        svt_aom_get_syntax_rate_from_cdf(
-            md_rate_est_ctx->switchable_restore_fac_bits, fc->switchable_restore_cdf, NULL);
-        svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->wiener_restore_fac_bits, fc->wiener_restore_cdf, NULL);
-        svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->sgrproj_restore_fac_bits, fc->sgrproj_restore_cdf, NULL);
+        if (CDF_DIRTY(switchable_restore_cdf))
+            svt_aom_get_syntax_rate_from_cdf(
+                md_rate_est_ctx->switchable_restore_fac_bits, fc->switchable_restore_cdf, NULL);
+        if (CDF_DIRTY(wiener_restore_cdf))
+            svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->wiener_restore_fac_bits, fc->wiener_restore_cdf, NULL);
+        if (CDF_DIRTY(sgrproj_restore_cdf))
+            svt_aom_get_syntax_rate_from_cdf(
+                md_rate_est_ctx->sgrproj_restore_fac_bits, fc->sgrproj_restore_cdf, NULL);
     }
-    if (allow_intrabc) {
+    if (allow_intrabc && CDF_DIRTY(intrabc_cdf)) {
         svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->intrabc_fac_bits, fc->intrabc_cdf, NULL);
     }
 
     if (!is_i_slice) { // NM - Hardcoded to true
-        for (i = 0; i < COMP_INTER_CONTEXTS; ++i)
-            svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->comp_inter_fac_bits[i], fc->comp_inter_cdf[i], NULL);
-        for (i = 0; i < REF_CONTEXTS; ++i) {
-            for (j = 0; j < SINGLE_REFS - 1; ++j)
+        if (CDF_DIRTY(comp_inter_cdf))
+            for (i = 0; i < COMP_INTER_CONTEXTS; ++i)
                 svt_aom_get_syntax_rate_from_cdf(
-                    md_rate_est_ctx->single_ref_fac_bits[i][j], fc->single_ref_cdf[i][j], NULL);
+                    md_rate_est_ctx->comp_inter_fac_bits[i], fc->comp_inter_cdf[i], NULL);
+        if (CDF_DIRTY(single_ref_cdf)) {
+            for (i = 0; i < REF_CONTEXTS; ++i) {
+                for (j = 0; j < SINGLE_REFS - 1; ++j)
+                    svt_aom_get_syntax_rate_from_cdf(
+                        md_rate_est_ctx->single_ref_fac_bits[i][j], fc->single_ref_cdf[i][j], NULL);
+            }
         }
 
-        for (i = 0; i < COMP_REF_TYPE_CONTEXTS; ++i)
-            svt_aom_get_syntax_rate_from_cdf(
-                md_rate_est_ctx->comp_ref_type_fac_bits[i], fc->comp_ref_type_cdf[i], NULL);
-        for (i = 0; i < UNI_COMP_REF_CONTEXTS; ++i) {
-            for (j = 0; j < UNIDIR_COMP_REFS - 1; ++j)
+        if (CDF_DIRTY(comp_ref_type_cdf))
+            for (i = 0; i < COMP_REF_TYPE_CONTEXTS; ++i)
                 svt_aom_get_syntax_rate_from_cdf(
-                    md_rate_est_ctx->uni_comp_ref_fac_bits[i][j], fc->uni_comp_ref_cdf[i][j], NULL);
+                    md_rate_est_ctx->comp_ref_type_fac_bits[i], fc->comp_ref_type_cdf[i], NULL);
+        if (CDF_DIRTY(uni_comp_ref_cdf)) {
+            for (i = 0; i < UNI_COMP_REF_CONTEXTS; ++i) {
+                for (j = 0; j < UNIDIR_COMP_REFS - 1; ++j)
+                    svt_aom_get_syntax_rate_from_cdf(
+                        md_rate_est_ctx->uni_comp_ref_fac_bits[i][j], fc->uni_comp_ref_cdf[i][j], NULL);
+            }
         }
 
-        for (i = 0; i < REF_CONTEXTS; ++i) {
-            for (j = 0; j < FWD_REFS - 1; ++j)
-                svt_aom_get_syntax_rate_from_cdf(
-                    md_rate_est_ctx->comp_ref_fac_bits[i][j], fc->comp_ref_cdf[i][j], NULL);
+        if (CDF_DIRTY(comp_ref_cdf)) {
+            for (i = 0; i < REF_CONTEXTS; ++i) {
+                for (j = 0; j < FWD_REFS - 1; ++j)
+                    svt_aom_get_syntax_rate_from_cdf(
+                        md_rate_est_ctx->comp_ref_fac_bits[i][j], fc->comp_ref_cdf[i][j], NULL);
+            }
         }
 
-        for (i = 0; i < REF_CONTEXTS; ++i) {
-            for (j = 0; j < BWD_REFS - 1; ++j)
-                svt_aom_get_syntax_rate_from_cdf(
-                    md_rate_est_ctx->comp_bwd_ref_fac_bits[i][j], fc->comp_bwdref_cdf[i][j], NULL);
+        if (CDF_DIRTY(comp_bwdref_cdf)) {
+            for (i = 0; i < REF_CONTEXTS; ++i) {
+                for (j = 0; j < BWD_REFS - 1; ++j)
+                    svt_aom_get_syntax_rate_from_cdf(
+                        md_rate_est_ctx->comp_bwd_ref_fac_bits[i][j], fc->comp_bwdref_cdf[i][j], NULL);
+            }
         }
 
-        for (i = 0; i < INTRA_INTER_CONTEXTS; ++i)
-            svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->intra_inter_fac_bits[i], fc->intra_inter_cdf[i], NULL);
-        for (i = 0; i < NEWMV_MODE_CONTEXTS; ++i)
-            svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->new_mv_mode_fac_bits[i], fc->newmv_cdf[i], NULL);
-        for (i = 0; i < GLOBALMV_MODE_CONTEXTS; ++i)
-            svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->zero_mv_mode_fac_bits[i], fc->zeromv_cdf[i], NULL);
-        for (i = 0; i < REFMV_MODE_CONTEXTS; ++i)
-            svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->ref_mv_mode_fac_bits[i], fc->refmv_cdf[i], NULL);
-        for (i = 0; i < DRL_MODE_CONTEXTS; ++i)
-            svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->drl_mode_fac_bits[i], fc->drl_cdf[i], NULL);
-        for (i = 0; i < INTER_MODE_CONTEXTS; ++i)
-            svt_aom_get_syntax_rate_from_cdf(
-                md_rate_est_ctx->inter_compound_mode_fac_bits[i], fc->inter_compound_mode_cdf[i], NULL);
-        for (i = 0; i < BlockSizeS_ALL; ++i)
-            svt_aom_get_syntax_rate_from_cdf(
-                md_rate_est_ctx->compound_type_fac_bits[i], fc->compound_type_cdf[i], NULL);
-        for (i = 0; i < BlockSizeS_ALL; ++i) {
-            if (get_interinter_wedge_bits((BlockSize)i))
-                svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->wedge_idx_fac_bits[i], fc->wedge_idx_cdf[i], NULL);
-        }
-        for (i = 0; i < BlockSize_GROUPS; ++i) {
-            svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->inter_intra_fac_bits[i], fc->interintra_cdf[i], NULL);
-            svt_aom_get_syntax_rate_from_cdf(
-                md_rate_est_ctx->inter_intra_mode_fac_bits[i], fc->interintra_mode_cdf[i], NULL);
+        if (CDF_DIRTY(intra_inter_cdf))
+            for (i = 0; i < INTRA_INTER_CONTEXTS; ++i)
+                svt_aom_get_syntax_rate_from_cdf(
+                    md_rate_est_ctx->intra_inter_fac_bits[i], fc->intra_inter_cdf[i], NULL);
+        if (CDF_DIRTY(newmv_cdf))
+            for (i = 0; i < NEWMV_MODE_CONTEXTS; ++i)
+                svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->new_mv_mode_fac_bits[i], fc->newmv_cdf[i], NULL);
+        if (CDF_DIRTY(zeromv_cdf))
+            for (i = 0; i < GLOBALMV_MODE_CONTEXTS; ++i)
+                svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->zero_mv_mode_fac_bits[i], fc->zeromv_cdf[i], NULL);
+        if (CDF_DIRTY(refmv_cdf))
+            for (i = 0; i < REFMV_MODE_CONTEXTS; ++i)
+                svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->ref_mv_mode_fac_bits[i], fc->refmv_cdf[i], NULL);
+        if (CDF_DIRTY(drl_cdf))
+            for (i = 0; i < DRL_MODE_CONTEXTS; ++i)
+                svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->drl_mode_fac_bits[i], fc->drl_cdf[i], NULL);
+        if (CDF_DIRTY(inter_compound_mode_cdf))
+            for (i = 0; i < INTER_MODE_CONTEXTS; ++i)
+                svt_aom_get_syntax_rate_from_cdf(
+                    md_rate_est_ctx->inter_compound_mode_fac_bits[i], fc->inter_compound_mode_cdf[i], NULL);
+        if (CDF_DIRTY(compound_type_cdf))
+            for (i = 0; i < BlockSizeS_ALL; ++i)
+                svt_aom_get_syntax_rate_from_cdf(
+                    md_rate_est_ctx->compound_type_fac_bits[i], fc->compound_type_cdf[i], NULL);
+        if (CDF_DIRTY(wedge_idx_cdf)) {
+            for (i = 0; i < BlockSizeS_ALL; ++i) {
+                if (get_interinter_wedge_bits((BlockSize)i))
+                    svt_aom_get_syntax_rate_from_cdf(
+                        md_rate_est_ctx->wedge_idx_fac_bits[i], fc->wedge_idx_cdf[i], NULL);
+            }
         }
-        for (i = 0; i < BlockSizeS_ALL; ++i)
-            svt_aom_get_syntax_rate_from_cdf(
-                md_rate_est_ctx->wedge_inter_intra_fac_bits[i], fc->wedge_interintra_cdf[i], NULL);
-        for (i = BLOCK_8X8; i < BlockSizeS_ALL; i++)
-            svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->motion_mode_fac_bits[i], fc->motion_mode_cdf[i], NULL);
-        for (i = BLOCK_8X8; i < BlockSizeS_ALL; i++)
-            svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->motion_mode_fac_bits1[i], fc->obmc_cdf[i], NULL);
-        for (i = 0; i < COMP_INDEX_CONTEXTS; ++i)
-            svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->comp_idx_fac_bits[i], fc->compound_index_cdf[i], NULL);
-        for (i = 0; i < COMP_GROUP_IDX_CONTEXTS; ++i)
-            svt_aom_get_syntax_rate_from_cdf(
-                md_rate_est_ctx->comp_group_idx_fac_bits[i], fc->comp_group_idx_cdf[i], NULL);
+        if (CDF_DIRTY(interintra_cdf))
+            for (i = 0; i < BlockSize_GROUPS; ++i)
+                svt_aom_get_syntax_rate_from_cdf(
+                    md_rate_est_ctx->inter_intra_fac_bits[i], fc->interintra_cdf[i], NULL);
+        if (CDF_DIRTY(interintra_mode_cdf))
+            for (i = 0; i < BlockSize_GROUPS; ++i)
+                svt_aom_get_syntax_rate_from_cdf(
+                    md_rate_est_ctx->inter_intra_mode_fac_bits[i], fc->interintra_mode_cdf[i], NULL);
+        if (CDF_DIRTY(wedge_interintra_cdf))
+            for (i = 0; i < BlockSizeS_ALL; ++i)
+                svt_aom_get_syntax_rate_from_cdf(
+                    md_rate_est_ctx->wedge_inter_intra_fac_bits[i], fc->wedge_interintra_cdf[i], NULL);
+        if (CDF_DIRTY(motion_mode_cdf))
+            for (i = BLOCK_8X8; i < BlockSizeS_ALL; i++)
+                svt_aom_get_syntax_rate_from_cdf(
+                    md_rate_est_ctx->motion_mode_fac_bits[i], fc->motion_mode_cdf[i], NULL);
+        if (CDF_DIRTY(obmc_cdf))
+            for (i = BLOCK_8X8; i < BlockSizeS_ALL; i++)
+                svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->motion_mode_fac_bits1[i], fc->obmc_cdf[i], NULL);
+        if (CDF_DIRTY(compound_index_cdf))
+            for (i = 0; i < COMP_INDEX_CONTEXTS; ++i)
+                svt_aom_get_syntax_rate_from_cdf(
+                    md_rate_est_ctx->comp_idx_fac_bits[i], fc->compound_index_cdf[i], NULL);
+        if (CDF_DIRTY(comp_group_idx_cdf))
+            for (i = 0; i < COMP_GROUP_IDX_CONTEXTS; ++i)
+                svt_aom_get_syntax_rate_from_cdf(
+                    md_rate_est_ctx->comp_group_idx_fac_bits[i], fc->comp_group_idx_cdf[i], NULL);
     }
 }
 
@@ -338,6 +425,7 @@ void svt_aom_estimate_mv_rate(PictureControlSet *pcs, MdRateEstimationContext *m
         memset(pcs->ppcs->scs->nmv_costs, 0, sizeof(int32_t) * MV_VALS * 2);
         md_rate_est_ctx->nmvcoststack[0] = &pcs->ppcs->scs->nmv_costs[0][MV_MAX];
         md_rate_est_ctx->nmvcoststack[1] = &pcs->ppcs->scs->nmv_costs[1][MV_MAX];
+        md_rate_est_ctx->rate_fc_mv_hp   = -1;
         return;
     }
     int32_t     *nmvcost[2];
@@ -350,10 +438,15 @@ void svt_aom_estimate_mv_rate(PictureControlSet *pcs, MdRateEstimationContext *m
     nmvcost_hp[1]                   = &md_rate_est_ctx->nmv_costs_hp[1][MV_MAX];
     uint8_t allow_high_precision_mv = pcs->ppcs->bypass_cost_table_gen ? 0 : frm_hdr->allow_high_precision_mv;
     if (!pcs->ppcs->bypass_cost_table_gen) {
-        svt_av1_build_nmv_cost_table(md_rate_est_ctx->nmv_vec_cost, // out
-                                     allow_high_precision_mv ? nmvcost_hp : nmvcost, // out
-                                     &fc->nmvc,
-                                     allow_high_precision_mv);
+        // The table of the precision is built again when it was not built from the MV CDFs checked
+        const Bool mv_dirty = CDF_DIRTY(nmvc);
+        if (mv_dirty || md_rate_est_ctx->rate_fc_mv_hp != allow_high_precision_mv) {
+            md_rate_est_ctx->rate_fc_mv_hp = allow_high_precision_mv;
+            svt_av1_build_nmv_cost_table(md_rate_est_ctx->nmv_vec_cost, // out
+                                         allow_high_precision_mv ? nmvcost_hp : nmvcost, // out
+                                         &fc->nmvc,
+                                         allow_high_precision_mv);
+        }
         md_rate_est_ctx->nmvcoststack[0] = allow_high_precision_mv ? &md_rate_est_ctx->nmv_costs_hp[0][MV_MAX]
                                                                    : &md_rate_est_ctx->nmv_costs[0][MV_MAX];
         md_rate_est_ctx->nmvcoststack[1] = allow_high_precision_mv ? &md_rate_est_ctx->nmv_costs_hp[1][MV_MAX]
@@ -369,6 +462,7 @@ void svt_aom_estimate_mv_rate(PictureControlSet *pcs, MdRateEstimationContext *m
         memcpy(md_rate_est_ctx->nmv_costs, pcs->ppcs->scs->nmv_costs, sizeof(int32_t) * MV_VALS * 2);
         md_rate_est_ctx->nmvcoststack[0] = &md_rate_est_ctx->nmv_costs[0][MV_MAX];
         md_rate_est_ctx->nmvcoststack[1] = &md_rate_est_ctx->nmv_costs[1][MV_MAX];
+        md_rate_est_ctx->rate_fc_mv_hp   = -1;
     }
     if (frm_hdr->allow_intrabc) {
         int32_t *dvcost[2] = {&md_rate_est_ctx->dv_cost[0][MV_MAX], &md_rate_est_ctx->dv_cost[1][MV_MAX]};
@@ -379,6 +473,7 @@ void copy_mv_rate(PictureControlSet *pcs, MdRateEstimationContext *dst_rate) {
     FrameHeader *frm_hdr = &pcs->ppcs->frm_hdr;
 
     memcpy(dst_rate->nmv_vec_cost, pcs->md_rate_est_ctx->nmv_vec_cost, MV_JOINTS * sizeof(int32_t));
+    dst_rate->rate_fc_mv_hp = -1;
 
     if (frm_hdr->allow_high_precision_mv) {
         memcpy(dst_rate->nmv_costs_hp, pcs->md_rate_est_ctx->nmv_costs_hp, 2 * MV_VALS * sizeof(int32_t));
@@ -405,7 +500,24 @@ void svt_aom_estimate_coefficients_rate(MdRateEstimationContext *md_rate_est_ctx
     const int32_t num_planes = 3; // NM - Hardcoded to 3
     const int32_t nplanes    = AOMMIN(num_planes, PLANE_TYPES);
 
+    // All the CDFs are checked before the estimation as the rates of several transform sizes share them
+    const Bool eob_flag_dirty[7] = {CDF_DIRTY(eob_flag_cdf16),
+                                    CDF_DIRTY(eob_flag_cdf32),
+                                    CDF_DIRTY(eob_flag_cdf64),
+                                    CDF_DIRTY(eob_flag_cdf128),
+                                    CDF_DIRTY(eob_flag_cdf256),
+                                    CDF_DIRTY(eob_flag_cdf512),
+                                    CDF_DIRTY(eob_flag_cdf1024)};
+    const Bool txb_skip_dirty       = CDF_DIRTY(txb_skip_cdf);
+    const Bool coeff_base_eob_dirty = CDF_DIRTY(coeff_base_eob_cdf);
+    const Bool coeff_base_dirty     = CDF_DIRTY(coeff_base_cdf);
+    const Bool eob_extra_dirty      = CDF_DIRTY(eob_extra_cdf);
+    const Bool dc_sign_dirty        = CDF_DIRTY(dc_sign_cdf);
+    const Bool coeff_br_dirty       = CDF_DIRTY(coeff_br_cdf);
+
     for (int eob_multi_size = 0; eob_multi_size < 7; ++eob_multi_size) {
+        if (!eob_flag_dirty[eob_multi_size])
+            continue;
         for (int plane = 0; plane < nplanes; ++plane) {
             LvMapEobCost *pcost = &md_rate_est_ctx->eob_frac_bits[eob_multi_size][plane];
             for (int ctx = 0; ctx < 2; ++ctx) {
@@ -428,27 +540,38 @@ void svt_aom_estimate_coefficients_rate(MdRateEstimationContext *md_rate_est_ctx
         for (int plane = 0; plane < nplanes; ++plane) {
             LvMapCoeffCost *pcost = &md_rate_est_ctx->coeff_fac_bits[tx_size][plane];
 
-            for (int ctx = 0; ctx < TXB_SKIP_CONTEXTS; ++ctx)
-                svt_aom_get_syntax_rate_from_cdf(pcost->txb_skip_cost[ctx], fc->txb_skip_cdf[tx_size][ctx], NULL);
-
-            for (int ctx = 0; ctx < SIG_COEF_CONTEXTS_EOB; ++ctx)
-                svt_aom_get_syntax_rate_from_cdf(
-                    pcost->base_eob_cost[ctx], fc->coeff_base_eob_cdf[tx_size][plane][ctx], NULL);
-            for (int ctx = 0; ctx < SIG_COEF_CONTEXTS; ++ctx)
-                svt_aom_get_syntax_rate_from_cdf(pcost->base_cost[ctx], fc->coeff_base_cdf[tx_size][plane][ctx], NULL);
-            for (int ctx = 0; ctx < SIG_COEF_CONTEXTS; ++ctx) {
-                pcost->base_cost[ctx][4] = 0;
-                pcost->base_cost[ctx][5] = pcost->base_cost[ctx][1] + av1_cost_literal(1) - pcost->base_cost[ctx][0];
-                pcost->base_cost[ctx][6] = pcost->base_cost[ctx][2] - pcost->base_cost[ctx][1];
-                pcost->base_cost[ctx][7] = pcost->base_cost[ctx][3] - pcost->base_cost[ctx][2];
+            if (txb_skip_dirty)
+                for (int ctx = 0; ctx < TXB_SKIP_CONTEXTS; ++ctx)
+                    svt_aom_get_syntax_rate_from_cdf(
+                        pcost->txb_skip_cost[ctx], fc->txb_skip_cdf[tx_size][ctx], NULL);
+
+            if (coeff_base_eob_dirty)
+                for (int ctx = 0; ctx < SIG_COEF_CONTEXTS_EOB; ++ctx)
+                    svt_aom_get_syntax_rate_from_cdf(
+                        pcost->base_eob_cost[ctx], fc->coeff_base_eob_cdf[tx_size][plane][ctx], NULL);
+            if (coeff_base_dirty) {
+                for (int ctx = 0; ctx < SIG_COEF_CONTEXTS; ++ctx)
+                    svt_aom_get_syntax_rate_from_cdf(
+                        pcost->base_cost[ctx], fc->coeff_base_cdf[tx_size][plane][ctx], NULL);
+                for (int ctx = 0; ctx < SIG_COEF_CONTEXTS; ++ctx) {
+                    pcost->base_cost[ctx][4] = 0;
+                    pcost->base_cost[ctx][5] = pcost->base_cost[ctx][1] + av1_cost_literal(1) -
+                        pcost->base_cost[ctx][0];
+                    pcost->base_cost[ctx][6] = pcost->base_cost[ctx][2] - pcost->base_cost[ctx][1];
+                    pcost->base_cost[ctx][7] = pcost->base_cost[ctx][3] - pcost->base_cost[ctx][2];
+                }
             }
-            for (int ctx = 0; ctx < EOB_COEF_CONTEXTS; ++ctx)
-                svt_aom_get_syntax_rate_from_cdf(
-                    pcost->eob_extra_cost[ctx], fc->eob_extra_cdf[tx_size][plane][ctx], NULL);
+            if (eob_extra_dirty)
+                for (int ctx = 0; ctx < EOB_COEF_CONTEXTS; ++ctx)
+                    svt_aom_get_syntax_rate_from_cdf(
+                        pcost->eob_extra_cost[ctx], fc->eob_extra_cdf[tx_size][plane][ctx], NULL);
 
-            for (int ctx = 0; ctx < DC_SIGN_CONTEXTS; ++ctx)
-                svt_aom_get_syntax_rate_from_cdf(pcost->dc_sign_cost[ctx], fc->dc_sign_cdf[plane][ctx], NULL);
+            if (dc_sign_dirty)
+                for (int ctx = 0; ctx < DC_SIGN_CONTEXTS; ++ctx)
+                    svt_aom_get_syntax_rate_from_cdf(pcost->dc_sign_cost[ctx], fc->dc_sign_cdf[plane][ctx], NULL);
 
+            if (!coeff_br_dirty)
+                continue;
             for (int ctx = 0; ctx < LEVEL_CONTEXTS; ++ctx) {
                 int32_t br_rate[BR_CDF_SIZE];
                 int32_t prev_cost = 0;
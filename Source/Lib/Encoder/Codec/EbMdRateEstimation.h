@@ -133,6 +133,11 @@ extern "C" {
         int32_t inter_tx_type_fac_bits[EXT_TX_SETS_INTER][EXT_TX_SIZES][CDF_SIZE(TX_TYPES)];
         int32_t switchable_interp_fac_bitss[SWITCHABLE_FILTER_CONTEXTS][SWITCHABLE_FILTERS];
         int32_t initialized;
+        // CDFs the rates above were last estimated from, so that only the rates of the CDFs
+        // updated since are estimated again (NULL: all the rates are estimated at each call)
+        FRAME_CONTEXT *rate_fc;
+        // MV precision the MV rates were estimated from rate_fc->nmvc for, -1 when not
+        int8_t rate_fc_mv_hp;
     } MdRateEstimationContext;
     /***************************************************************************
     * AV1 Probability table
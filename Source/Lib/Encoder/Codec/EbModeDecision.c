@@ -4739,6 +4739,7 @@ void svt_aom_product_full_mode_decision_light_pd1(
 {
     ModeDecisionCandidate* cand = cand_bf->cand;
     blk_ptr->total_rate = cand_bf->total_rate;
+    blk_ptr->coeff_rate = cand_bf->coeff_rate;
 
     // Set common signals (INTER/INTRA)
     blk_ptr->prediction_mode_flag = is_inter_mode(cand->pred_mode) ? INTER_MODE : INTRA_MODE;
@@ -4973,6 +4974,7 @@ uint32_t svt_aom_product_full_mode_decision(
     ModeDecisionCandidateBuffer* cand_bf = buffer_ptr_array[lowest_cost_index];
     ModeDecisionCandidate* cand = cand_bf->cand;
     blk_ptr->total_rate = cand_bf->total_rate;
+    blk_ptr->coeff_rate = cand_bf->coeff_rate;
     if (!(ctx->pd_pass == PD_PASS_1 && ctx->fixed_partition)) {
         if (ctx->blk_lambda_tuning) {
             // When lambda tuning is on, lambda of each block is set separately, however at interdepth decision the sb lambda is used
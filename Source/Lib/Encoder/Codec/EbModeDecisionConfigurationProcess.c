@@ -29,6 +29,7 @@
 #include "EbInvTransforms.h"
 #include "EncModeConfig.h"
 #include "EbGlobalMotionEstimation.h"
+#include "EbDlfProcess.h"
 #include "aom_dsp_rtcd.h"
 #define MAX_MESH_SPEED 5 // Max speed setting for mesh motion method
 static MeshPattern good_quality_mesh_patterns[MAX_MESH_SPEED + 1][MAX_MESH_STEP] = {
@@ -564,319 +565,313 @@ static void set_frame_coeff_lvl(PictureControlSet *pcs) {
  *  Initializations for various flags and variables
  *
  ********************************************************************************/
-void *svt_aom_mode_decision_configuration_kernel(void *input_ptr) {
+void svt_aom_mode_decision_configuration_task(void *input_ptr, EbObjectWrapper *rc_results_wrapper) {
     // Context & SCS & PCS
     EbThreadContext                  *thread_ctx  = (EbThreadContext *)input_ptr;
     ModeDecisionConfigurationContext *context_ptr = (ModeDecisionConfigurationContext *)thread_ctx->priv;
     // Input
-    EbObjectWrapper *rc_results_wrapper;
 
     // Output
     EbObjectWrapper *enc_dec_tasks_wrapper;
 
-    for (;;) {
-        // Get RateControl Results
-        EB_GET_FULL_OBJECT(context_ptr->rate_control_input_fifo_ptr, &rc_results_wrapper);
-
-        RateControlResults *rc_results = (RateControlResults *)rc_results_wrapper->object_ptr;
-        PictureControlSet  *pcs        = (PictureControlSet *)rc_results->pcs_wrapper->object_ptr;
-        SequenceControlSet *scs        = pcs->scs;
-        pcs->min_me_clpx               = 0;
-        pcs->max_me_clpx               = 0;
-        pcs->avg_me_clpx               = 0;
-        if (pcs->slice_type != I_SLICE) {
-            uint32_t b64_idx;
-            uint64_t avg_me_clpx = 0;
-            uint64_t min_dist    = (uint64_t)~0;
-            uint64_t max_dist    = 0;
-
-            for (b64_idx = 0; b64_idx < pcs->ppcs->b64_total_count; ++b64_idx) {
-                avg_me_clpx += pcs->ppcs->me_8x8_cost_variance[b64_idx];
-                min_dist = MIN(pcs->ppcs->me_8x8_cost_variance[b64_idx], min_dist);
-                max_dist = MAX(pcs->ppcs->me_8x8_cost_variance[b64_idx], max_dist);
-            }
-            pcs->min_me_clpx = min_dist;
-            pcs->max_me_clpx = max_dist;
-            pcs->avg_me_clpx = avg_me_clpx / pcs->ppcs->b64_total_count;
+    RateControlResults *rc_results = (RateControlResults *)rc_results_wrapper->object_ptr;
+    PictureControlSet  *pcs        = (PictureControlSet *)rc_results->pcs_wrapper->object_ptr;
+    SequenceControlSet *scs        = pcs->scs;
+    pcs->min_me_clpx               = 0;
+    pcs->max_me_clpx               = 0;
+    pcs->avg_me_clpx               = 0;
+    if (pcs->slice_type != I_SLICE) {
+        uint32_t b64_idx;
+        uint64_t avg_me_clpx = 0;
+        uint64_t min_dist    = (uint64_t)~0;
+        uint64_t max_dist    = 0;
+
+        for (b64_idx = 0; b64_idx < pcs->ppcs->b64_total_count; ++b64_idx) {
+            avg_me_clpx += pcs->ppcs->me_8x8_cost_variance[b64_idx];
+            min_dist = MIN(pcs->ppcs->me_8x8_cost_variance[b64_idx], min_dist);
+            max_dist = MAX(pcs->ppcs->me_8x8_cost_variance[b64_idx], max_dist);
         }
-        pcs->coeff_lvl = INVALID_LVL;
+        pcs->min_me_clpx = min_dist;
+        pcs->max_me_clpx = max_dist;
+        pcs->avg_me_clpx = avg_me_clpx / pcs->ppcs->b64_total_count;
+    }
+    pcs->coeff_lvl = INVALID_LVL;
 
-        if (pcs->slice_type != I_SLICE && !pcs->ppcs->sc_class1) {
-            set_frame_coeff_lvl(pcs);
+    if (pcs->slice_type != I_SLICE && !pcs->ppcs->sc_class1) {
+        set_frame_coeff_lvl(pcs);
+    }
+    // -------
+    // Scale references if resolution of the reference is different than the input
+    // super-res reference frame size is same as original input size, only check current frame scaled flag;
+    // reference scaling resizes reference frame to different size, need check each reference frame for scaling
+    // -------
+    if ((pcs->ppcs->frame_superres_enabled == 1 || scs->static_config.resize_mode != RESIZE_NONE) &&
+        pcs->slice_type != I_SLICE) {
+        if (pcs->ppcs->is_ref == TRUE && pcs->ppcs->ref_pic_wrapper != NULL) {
+            // update mi_rows and mi_cols for the reference pic wrapper (used in mfmv for other
+            // pictures)
+            EbReferenceObject *ref_object = pcs->ppcs->ref_pic_wrapper->object_ptr;
+            ref_object->mi_rows           = pcs->ppcs->aligned_height >> MI_SIZE_LOG2;
+            ref_object->mi_cols           = pcs->ppcs->aligned_width >> MI_SIZE_LOG2;
         }
-        // -------
-        // Scale references if resolution of the reference is different than the input
-        // super-res reference frame size is same as original input size, only check current frame scaled flag;
-        // reference scaling resizes reference frame to different size, need check each reference frame for scaling
-        // -------
-        if ((pcs->ppcs->frame_superres_enabled == 1 || scs->static_config.resize_mode != RESIZE_NONE) &&
-            pcs->slice_type != I_SLICE) {
-            if (pcs->ppcs->is_ref == TRUE && pcs->ppcs->ref_pic_wrapper != NULL) {
-                // update mi_rows and mi_cols for the reference pic wrapper (used in mfmv for other
-                // pictures)
-                EbReferenceObject *ref_object = pcs->ppcs->ref_pic_wrapper->object_ptr;
-                ref_object->mi_rows           = pcs->ppcs->aligned_height >> MI_SIZE_LOG2;
-                ref_object->mi_cols           = pcs->ppcs->aligned_width >> MI_SIZE_LOG2;
-            }
 
-            svt_aom_scale_rec_references(pcs, pcs->ppcs->enhanced_pic, pcs->hbd_md);
-        }
+        svt_aom_scale_rec_references(pcs, pcs->ppcs->enhanced_pic, pcs->hbd_md);
+    }
 
-        FrameHeader *frm_hdr = &pcs->ppcs->frm_hdr;
-        pcs->rtc_tune        = (scs->static_config.pred_structure == SVT_AV1_PRED_LOW_DELAY_B) ? true : false;
-        // Mode Decision Configuration Kernel Signal(s) derivation
-        svt_aom_sig_deriv_mode_decision_config(scs, pcs);
-
-        if (pcs->slice_type != I_SLICE && scs->mfmv_enabled)
-            av1_setup_motion_field(pcs->ppcs->av1_cm, pcs);
-
-        pcs->intra_coded_area = 0;
-        pcs->skip_coded_area  = 0;
-        pcs->hp_coded_area    = 0;
-        // Init block selection
-        // Set reference sg ep
-        set_reference_sg_ep(pcs);
-        if (pcs->ppcs->gm_ctrls.use_ref_info) {
-            assert(pcs->slice_type != I_SLICE);
-            svt_aom_global_motion_estimation(pcs->ppcs, pcs->ppcs->enhanced_pic);
-        }
-        set_global_motion_field(pcs);
+    FrameHeader *frm_hdr = &pcs->ppcs->frm_hdr;
+    pcs->rtc_tune        = (scs->static_config.pred_structure == SVT_AV1_PRED_LOW_DELAY_B) ? true : false;
+    // Mode Decision Configuration Kernel Signal(s) derivation
+    svt_aom_sig_deriv_mode_decision_config(scs, pcs);
 
-        svt_av1_qm_init(pcs->ppcs);
-        MdRateEstimationContext *md_rate_est_ctx;
+    if (pcs->slice_type != I_SLICE && scs->mfmv_enabled)
+        av1_setup_motion_field(pcs->ppcs->av1_cm, pcs);
+
+    pcs->intra_coded_area = 0;
+    pcs->skip_coded_area  = 0;
+    pcs->hp_coded_area    = 0;
+    // Init block selection
+    // Set reference sg ep
+    set_reference_sg_ep(pcs);
+    if (pcs->ppcs->gm_ctrls.use_ref_info) {
+        assert(pcs->slice_type != I_SLICE);
+        svt_aom_global_motion_estimation(pcs->ppcs, pcs->ppcs->enhanced_pic);
+    }
+    set_global_motion_field(pcs);
 
-        // QP
-        context_ptr->qp = pcs->picture_qp;
+    svt_av1_qm_init(pcs->ppcs);
+    MdRateEstimationContext *md_rate_est_ctx;
 
-        // QP Index
-        context_ptr->qp_index = (uint8_t)frm_hdr->quantization_params.base_q_idx;
+    // QP
+    context_ptr->qp = pcs->picture_qp;
 
-        md_rate_est_ctx = pcs->md_rate_est_ctx;
-        if (pcs->ppcs->frm_hdr.primary_ref_frame != PRIMARY_REF_NONE)
-            memcpy(&pcs->md_frame_context,
-                   &pcs->ref_frame_context[pcs->ppcs->frm_hdr.primary_ref_frame],
-                   sizeof(FRAME_CONTEXT));
-        else {
-            svt_av1_default_coef_probs(&pcs->md_frame_context, frm_hdr->quantization_params.base_q_idx);
-            svt_aom_init_mode_probs(&pcs->md_frame_context);
+    // QP Index
+    context_ptr->qp_index = (uint8_t)frm_hdr->quantization_params.base_q_idx;
+
+    md_rate_est_ctx = pcs->md_rate_est_ctx;
+    if (pcs->ppcs->frm_hdr.primary_ref_frame != PRIMARY_REF_NONE)
+        memcpy(&pcs->md_frame_context,
+               &pcs->ref_frame_context[pcs->ppcs->frm_hdr.primary_ref_frame],
+               sizeof(FRAME_CONTEXT));
+    else {
+        svt_av1_default_coef_probs(&pcs->md_frame_context, frm_hdr->quantization_params.base_q_idx);
+        svt_aom_init_mode_probs(&pcs->md_frame_context);
+    }
+    // Initial Rate Estimation of the syntax elements
+    svt_aom_estimate_syntax_rate(md_rate_est_ctx,
+                                 pcs->slice_type == I_SLICE ? TRUE : FALSE,
+                                 scs->seq_header.filter_intra_level,
+                                 pcs->ppcs->frm_hdr.allow_screen_content_tools,
+                                 pcs->ppcs->enable_restoration,
+                                 pcs->ppcs->frm_hdr.allow_intrabc,
+                                 &pcs->md_frame_context);
+    // Initial Rate Estimation of the Motion vectors
+    svt_aom_estimate_mv_rate(pcs, md_rate_est_ctx, &pcs->md_frame_context);
+    // Initial Rate Estimation of the quantized coefficients
+    svt_aom_estimate_coefficients_rate(md_rate_est_ctx, &pcs->md_frame_context);
+    if (frm_hdr->allow_intrabc) {
+        int            i;
+        int            speed = 1;
+        SpeedFeatures *sf    = &pcs->sf;
+
+        const int mesh_speed           = AOMMIN(speed, MAX_MESH_SPEED);
+        sf->exhaustive_searches_thresh = (1 << 25);
+        if (mesh_speed > 0)
+            sf->exhaustive_searches_thresh = sf->exhaustive_searches_thresh << 1;
+
+        for (i = 0; i < MAX_MESH_STEP; ++i) {
+            sf->mesh_patterns[i].range    = good_quality_mesh_patterns[mesh_speed][i].range;
+            sf->mesh_patterns[i].interval = good_quality_mesh_patterns[mesh_speed][i].interval;
         }
-        // Initial Rate Estimation of the syntax elements
-        svt_aom_estimate_syntax_rate(md_rate_est_ctx,
-                                     pcs->slice_type == I_SLICE ? TRUE : FALSE,
-                                     scs->seq_header.filter_intra_level,
-                                     pcs->ppcs->frm_hdr.allow_screen_content_tools,
-                                     pcs->ppcs->enable_restoration,
-                                     pcs->ppcs->frm_hdr.allow_intrabc,
-                                     &pcs->md_frame_context);
-        // Initial Rate Estimation of the Motion vectors
-        svt_aom_estimate_mv_rate(pcs, md_rate_est_ctx, &pcs->md_frame_context);
-        // Initial Rate Estimation of the quantized coefficients
-        svt_aom_estimate_coefficients_rate(md_rate_est_ctx, &pcs->md_frame_context);
-        if (frm_hdr->allow_intrabc) {
-            int            i;
-            int            speed = 1;
-            SpeedFeatures *sf    = &pcs->sf;
-
-            const int mesh_speed           = AOMMIN(speed, MAX_MESH_SPEED);
-            sf->exhaustive_searches_thresh = (1 << 25);
-            if (mesh_speed > 0)
-                sf->exhaustive_searches_thresh = sf->exhaustive_searches_thresh << 1;
 
+        if (pcs->slice_type == I_SLICE) {
             for (i = 0; i < MAX_MESH_STEP; ++i) {
-                sf->mesh_patterns[i].range    = good_quality_mesh_patterns[mesh_speed][i].range;
-                sf->mesh_patterns[i].interval = good_quality_mesh_patterns[mesh_speed][i].interval;
+                sf->mesh_patterns[i].range    = intrabc_mesh_patterns[mesh_speed][i].range;
+                sf->mesh_patterns[i].interval = intrabc_mesh_patterns[mesh_speed][i].interval;
             }
+        }
 
-            if (pcs->slice_type == I_SLICE) {
-                for (i = 0; i < MAX_MESH_STEP; ++i) {
-                    sf->mesh_patterns[i].range    = intrabc_mesh_patterns[mesh_speed][i].range;
-                    sf->mesh_patterns[i].interval = intrabc_mesh_patterns[mesh_speed][i].interval;
-                }
-            }
+        {
+            // add to hash table
+            const int pic_width  = pcs->ppcs->aligned_width;
+            const int pic_height = pcs->ppcs->aligned_height;
 
-            {
-                // add to hash table
-                const int pic_width  = pcs->ppcs->aligned_width;
-                const int pic_height = pcs->ppcs->aligned_height;
-
-                uint32_t *block_hash_values[2][2];
-                int8_t   *is_block_same[2][3];
-                int       k, j;
-
-                for (k = 0; k < 2; k++) {
-                    for (j = 0; j < 2; j++)
-                        block_hash_values[k][j] = rtime_alloc_block_hash_block_is_same(sizeof(uint32_t) * pic_width *
-                                                                                       pic_height);
-                    for (j = 0; j < 3; j++)
-                        is_block_same[k][j] = rtime_alloc_block_hash_block_is_same(sizeof(int8_t) * pic_width *
+            uint32_t *block_hash_values[2][2];
+            int8_t   *is_block_same[2][3];
+            int       k, j;
+
+            for (k = 0; k < 2; k++) {
+                for (j = 0; j < 2; j++)
+                    block_hash_values[k][j] = rtime_alloc_block_hash_block_is_same(sizeof(uint32_t) * pic_width *
                                                                                    pic_height);
+                for (j = 0; j < 3; j++)
+                    is_block_same[k][j] = rtime_alloc_block_hash_block_is_same(sizeof(int8_t) * pic_width *
+                                                                               pic_height);
+            }
+            svt_aom_rtime_alloc_svt_av1_hash_table_create(&pcs->hash_table);
+            Yv12BufferConfig cpi_source;
+            svt_aom_link_eb_to_aom_buffer_desc_8bit(pcs->ppcs->enhanced_pic, &cpi_source);
+
+            svt_av1_crc_calculator_init(&pcs->crc_calculator1, 24, 0x5D6DCB);
+            svt_av1_crc_calculator_init(&pcs->crc_calculator2, 24, 0x864CFB);
+
+            svt_av1_generate_block_2x2_hash_value(&cpi_source, block_hash_values[0], is_block_same[0], pcs);
+            uint8_t       src_idx     = 0;
+            const uint8_t max_sb_size = pcs->ppcs->intraBC_ctrls.max_block_size_hash;
+            for (int size = 4; size <= max_sb_size; size <<= 1, src_idx = !src_idx) {
+                const uint8_t dst_idx = !src_idx;
+                svt_av1_generate_block_hash_value(&cpi_source,
+                                                  size,
+                                                  block_hash_values[src_idx],
+                                                  block_hash_values[dst_idx],
+                                                  is_block_same[src_idx],
+                                                  is_block_same[dst_idx],
+                                                  pcs);
+                if (size != 4 || pcs->ppcs->intraBC_ctrls.hash_4x4_blocks)
+                    svt_aom_rtime_alloc_svt_av1_add_to_hash_map_by_row_with_precal_data(&pcs->hash_table,
+                                                                                        block_hash_values[dst_idx],
+                                                                                        is_block_same[dst_idx][2],
+                                                                                        pic_width,
+                                                                                        pic_height,
+                                                                                        size);
+            }
+            for (k = 0; k < 2; k++) {
+                for (j = 0; j < 2; j++) free(block_hash_values[k][j]);
+                for (j = 0; j < 3; j++) free(is_block_same[k][j]);
+            }
+        }
+
+        svt_av1_init3smotion_compensation(&pcs->ss_cfg, pcs->ppcs->enhanced_pic->stride_y);
+    }
+    CdefControls *cdef_ctrls = &pcs->ppcs->cdef_ctrls;
+    uint8_t       skip_perc  = pcs->ref_skip_percentage;
+    if ((skip_perc > 75 && cdef_ctrls->use_skip_detector) ||
+        (scs->vq_ctrls.sharpness_ctrls.cdef && pcs->ppcs->is_noise_level))
+        pcs->ppcs->cdef_level = 0;
+    else {
+        if (cdef_ctrls->use_reference_cdef_fs) {
+            if (pcs->slice_type != I_SLICE) {
+                uint8_t lowest_sg  = TOTAL_STRENGTHS - 1;
+                uint8_t highest_sg = 0;
+                // Determine luma pred filter
+                // Add filter from list0
+                EbReferenceObject *ref_obj_l0 =
+                    (EbReferenceObject *)pcs->ref_pic_ptr_array[REF_LIST_0][0]->object_ptr;
+                for (uint8_t fs = 0; fs < ref_obj_l0->ref_cdef_strengths_num; fs++) {
+                    if (ref_obj_l0->ref_cdef_strengths[0][fs] < lowest_sg)
+                        lowest_sg = ref_obj_l0->ref_cdef_strengths[0][fs];
+                    if (ref_obj_l0->ref_cdef_strengths[0][fs] > highest_sg)
+                        highest_sg = ref_obj_l0->ref_cdef_strengths[0][fs];
                 }
-                svt_aom_rtime_alloc_svt_av1_hash_table_create(&pcs->hash_table);
-                Yv12BufferConfig cpi_source;
-                svt_aom_link_eb_to_aom_buffer_desc_8bit(pcs->ppcs->enhanced_pic, &cpi_source);
-
-                svt_av1_crc_calculator_init(&pcs->crc_calculator1, 24, 0x5D6DCB);
-                svt_av1_crc_calculator_init(&pcs->crc_calculator2, 24, 0x864CFB);
-
-                svt_av1_generate_block_2x2_hash_value(&cpi_source, block_hash_values[0], is_block_same[0], pcs);
-                uint8_t       src_idx     = 0;
-                const uint8_t max_sb_size = pcs->ppcs->intraBC_ctrls.max_block_size_hash;
-                for (int size = 4; size <= max_sb_size; size <<= 1, src_idx = !src_idx) {
-                    const uint8_t dst_idx = !src_idx;
-                    svt_av1_generate_block_hash_value(&cpi_source,
-                                                      size,
-                                                      block_hash_values[src_idx],
-                                                      block_hash_values[dst_idx],
-                                                      is_block_same[src_idx],
-                                                      is_block_same[dst_idx],
-                                                      pcs);
-                    if (size != 4 || pcs->ppcs->intraBC_ctrls.hash_4x4_blocks)
-                        svt_aom_rtime_alloc_svt_av1_add_to_hash_map_by_row_with_precal_data(&pcs->hash_table,
-                                                                                            block_hash_values[dst_idx],
-                                                                                            is_block_same[dst_idx][2],
-                                                                                            pic_width,
-                                                                                            pic_height,
-                                                                                            size);
+                if (pcs->slice_type == B_SLICE) {
+                    // Add filter from list1
+                    EbReferenceObject *ref_obj_l1 =
+                        (EbReferenceObject *)pcs->ref_pic_ptr_array[REF_LIST_1][0]->object_ptr;
+                    for (uint8_t fs = 0; fs < ref_obj_l1->ref_cdef_strengths_num; fs++) {
+                        if (ref_obj_l1->ref_cdef_strengths[0][fs] < lowest_sg)
+                            lowest_sg = ref_obj_l1->ref_cdef_strengths[0][fs];
+                        if (ref_obj_l1->ref_cdef_strengths[0][fs] > highest_sg)
+                            highest_sg = ref_obj_l1->ref_cdef_strengths[0][fs];
+                    }
                 }
-                for (k = 0; k < 2; k++) {
-                    for (j = 0; j < 2; j++) free(block_hash_values[k][j]);
-                    for (j = 0; j < 3; j++) free(is_block_same[k][j]);
+                if (pcs->rtc_tune) {
+                    int8_t mid_filter     = MIN(63, MAX(0, MAX(lowest_sg, highest_sg)));
+                    cdef_ctrls->pred_y_f  = mid_filter;
+                    cdef_ctrls->pred_uv_f = 0;
+                } else {
+                    int8_t mid_filter     = MIN(63, MAX(0, (lowest_sg + highest_sg) / 2));
+                    cdef_ctrls->pred_y_f  = mid_filter;
+                    cdef_ctrls->pred_uv_f = 0;
                 }
+                cdef_ctrls->first_pass_fs_num          = 0;
+                cdef_ctrls->default_second_pass_fs_num = 0;
+                // Set cdef to off if pred is.
+                if ((cdef_ctrls->pred_y_f == 0) && (cdef_ctrls->pred_uv_f == 0))
+                    pcs->ppcs->cdef_level = 0;
             }
-
-            svt_av1_init3smotion_compensation(&pcs->ss_cfg, pcs->ppcs->enhanced_pic->stride_y);
-        }
-        CdefControls *cdef_ctrls = &pcs->ppcs->cdef_ctrls;
-        uint8_t       skip_perc  = pcs->ref_skip_percentage;
-        if ((skip_perc > 75 && cdef_ctrls->use_skip_detector) ||
-            (scs->vq_ctrls.sharpness_ctrls.cdef && pcs->ppcs->is_noise_level))
-            pcs->ppcs->cdef_level = 0;
-        else {
-            if (cdef_ctrls->use_reference_cdef_fs) {
-                if (pcs->slice_type != I_SLICE) {
-                    uint8_t lowest_sg  = TOTAL_STRENGTHS - 1;
-                    uint8_t highest_sg = 0;
-                    // Determine luma pred filter
-                    // Add filter from list0
-                    EbReferenceObject *ref_obj_l0 =
-                        (EbReferenceObject *)pcs->ref_pic_ptr_array[REF_LIST_0][0]->object_ptr;
-                    for (uint8_t fs = 0; fs < ref_obj_l0->ref_cdef_strengths_num; fs++) {
-                        if (ref_obj_l0->ref_cdef_strengths[0][fs] < lowest_sg)
-                            lowest_sg = ref_obj_l0->ref_cdef_strengths[0][fs];
-                        if (ref_obj_l0->ref_cdef_strengths[0][fs] > highest_sg)
-                            highest_sg = ref_obj_l0->ref_cdef_strengths[0][fs];
-                    }
-                    if (pcs->slice_type == B_SLICE) {
-                        // Add filter from list1
-                        EbReferenceObject *ref_obj_l1 =
-                            (EbReferenceObject *)pcs->ref_pic_ptr_array[REF_LIST_1][0]->object_ptr;
-                        for (uint8_t fs = 0; fs < ref_obj_l1->ref_cdef_strengths_num; fs++) {
-                            if (ref_obj_l1->ref_cdef_strengths[0][fs] < lowest_sg)
-                                lowest_sg = ref_obj_l1->ref_cdef_strengths[0][fs];
-                            if (ref_obj_l1->ref_cdef_strengths[0][fs] > highest_sg)
-                                highest_sg = ref_obj_l1->ref_cdef_strengths[0][fs];
-                        }
-                    }
-                    if (pcs->rtc_tune) {
-                        int8_t mid_filter     = MIN(63, MAX(0, MAX(lowest_sg, highest_sg)));
-                        cdef_ctrls->pred_y_f  = mid_filter;
-                        cdef_ctrls->pred_uv_f = 0;
-                    } else {
-                        int8_t mid_filter     = MIN(63, MAX(0, (lowest_sg + highest_sg) / 2));
-                        cdef_ctrls->pred_y_f  = mid_filter;
-                        cdef_ctrls->pred_uv_f = 0;
-                    }
-                    cdef_ctrls->first_pass_fs_num          = 0;
-                    cdef_ctrls->default_second_pass_fs_num = 0;
-                    // Set cdef to off if pred is.
-                    if ((cdef_ctrls->pred_y_f == 0) && (cdef_ctrls->pred_uv_f == 0))
-                        pcs->ppcs->cdef_level = 0;
+        } else if (cdef_ctrls->search_best_ref_fs) {
+            if (pcs->slice_type != I_SLICE) {
+                cdef_ctrls->first_pass_fs_num          = 1;
+                cdef_ctrls->default_second_pass_fs_num = 0;
+
+                // Add filter from list0, if not the same as the default
+                EbReferenceObject *ref_obj_l0 =
+                    (EbReferenceObject *)pcs->ref_pic_ptr_array[REF_LIST_0][0]->object_ptr;
+                if (ref_obj_l0->ref_cdef_strengths[0][0] != cdef_ctrls->default_first_pass_fs[0]) {
+                    cdef_ctrls->default_first_pass_fs[1] = ref_obj_l0->ref_cdef_strengths[0][0];
+                    (cdef_ctrls->first_pass_fs_num)++;
                 }
-            } else if (cdef_ctrls->search_best_ref_fs) {
-                if (pcs->slice_type != I_SLICE) {
-                    cdef_ctrls->first_pass_fs_num          = 1;
-                    cdef_ctrls->default_second_pass_fs_num = 0;
-
-                    // Add filter from list0, if not the same as the default
-                    EbReferenceObject *ref_obj_l0 =
-                        (EbReferenceObject *)pcs->ref_pic_ptr_array[REF_LIST_0][0]->object_ptr;
-                    if (ref_obj_l0->ref_cdef_strengths[0][0] != cdef_ctrls->default_first_pass_fs[0]) {
-                        cdef_ctrls->default_first_pass_fs[1] = ref_obj_l0->ref_cdef_strengths[0][0];
+
+                if (pcs->slice_type == B_SLICE) {
+                    EbReferenceObject *ref_obj_l1 =
+                        (EbReferenceObject *)pcs->ref_pic_ptr_array[REF_LIST_1][0]->object_ptr;
+                    // Add filter from list1, if different from default filter and list0 filter
+                    if (ref_obj_l1->ref_cdef_strengths[0][0] != cdef_ctrls->default_first_pass_fs[0] &&
+                        ref_obj_l1->ref_cdef_strengths[0][0] !=
+                            cdef_ctrls->default_first_pass_fs[cdef_ctrls->first_pass_fs_num - 1]) {
+                        cdef_ctrls->default_first_pass_fs[cdef_ctrls->first_pass_fs_num] =
+                            ref_obj_l1->ref_cdef_strengths[0][0];
                         (cdef_ctrls->first_pass_fs_num)++;
-                    }
 
-                    if (pcs->slice_type == B_SLICE) {
-                        EbReferenceObject *ref_obj_l1 =
-                            (EbReferenceObject *)pcs->ref_pic_ptr_array[REF_LIST_1][0]->object_ptr;
-                        // Add filter from list1, if different from default filter and list0 filter
-                        if (ref_obj_l1->ref_cdef_strengths[0][0] != cdef_ctrls->default_first_pass_fs[0] &&
-                            ref_obj_l1->ref_cdef_strengths[0][0] !=
-                                cdef_ctrls->default_first_pass_fs[cdef_ctrls->first_pass_fs_num - 1]) {
-                            cdef_ctrls->default_first_pass_fs[cdef_ctrls->first_pass_fs_num] =
-                                ref_obj_l1->ref_cdef_strengths[0][0];
-                            (cdef_ctrls->first_pass_fs_num)++;
-
-                            // Chroma
-                            if (ref_obj_l0->ref_cdef_strengths[1][0] == cdef_ctrls->default_first_pass_fs_uv[0] &&
-                                ref_obj_l1->ref_cdef_strengths[1][0] == cdef_ctrls->default_first_pass_fs_uv[0]) {
-                                cdef_ctrls->default_first_pass_fs_uv[0] = -1;
-                                cdef_ctrls->default_first_pass_fs_uv[1] = -1;
-                            }
-                        }
-                        // if list0/list1 filters are the same, skip CDEF search, and use the filter selected by the ref frames
-                        else if (cdef_ctrls->first_pass_fs_num == 2 &&
-                                 ref_obj_l0->ref_cdef_strengths[0][0] == ref_obj_l1->ref_cdef_strengths[0][0]) {
-                            cdef_ctrls->use_reference_cdef_fs = 1;
-
-                            cdef_ctrls->pred_y_f  = ref_obj_l0->ref_cdef_strengths[0][0];
-                            cdef_ctrls->pred_uv_f = MIN(
-                                63,
-                                MAX(0,
-                                    (ref_obj_l0->ref_cdef_strengths[1][0] + ref_obj_l1->ref_cdef_strengths[1][0]) / 2));
-                            cdef_ctrls->first_pass_fs_num          = 0;
-                            cdef_ctrls->default_second_pass_fs_num = 0;
+                        // Chroma
+                        if (ref_obj_l0->ref_cdef_strengths[1][0] == cdef_ctrls->default_first_pass_fs_uv[0] &&
+                            ref_obj_l1->ref_cdef_strengths[1][0] == cdef_ctrls->default_first_pass_fs_uv[0]) {
+                            cdef_ctrls->default_first_pass_fs_uv[0] = -1;
+                            cdef_ctrls->default_first_pass_fs_uv[1] = -1;
                         }
                     }
-                    // Chroma
-                    else if (ref_obj_l0->ref_cdef_strengths[1][0] == cdef_ctrls->default_first_pass_fs_uv[0]) {
-                        cdef_ctrls->default_first_pass_fs_uv[0] = -1;
-                        cdef_ctrls->default_first_pass_fs_uv[1] = -1;
+                    // if list0/list1 filters are the same, skip CDEF search, and use the filter selected by the ref frames
+                    else if (cdef_ctrls->first_pass_fs_num == 2 &&
+                             ref_obj_l0->ref_cdef_strengths[0][0] == ref_obj_l1->ref_cdef_strengths[0][0]) {
+                        cdef_ctrls->use_reference_cdef_fs = 1;
+
+                        cdef_ctrls->pred_y_f  = ref_obj_l0->ref_cdef_strengths[0][0];
+                        cdef_ctrls->pred_uv_f = MIN(
+                            63,
+                            MAX(0,
+                                (ref_obj_l0->ref_cdef_strengths[1][0] + ref_obj_l1->ref_cdef_strengths[1][0]) / 2));
+                        cdef_ctrls->first_pass_fs_num          = 0;
+                        cdef_ctrls->default_second_pass_fs_num = 0;
                     }
-
-                    // Set cdef to off if pred luma is.
-                    if (cdef_ctrls->first_pass_fs_num == 1)
-                        pcs->ppcs->cdef_level = 0;
                 }
+                // Chroma
+                else if (ref_obj_l0->ref_cdef_strengths[1][0] == cdef_ctrls->default_first_pass_fs_uv[0]) {
+                    cdef_ctrls->default_first_pass_fs_uv[0] = -1;
+                    cdef_ctrls->default_first_pass_fs_uv[1] = -1;
+                }
+
+                // Set cdef to off if pred luma is.
+                if (cdef_ctrls->first_pass_fs_num == 1)
+                    pcs->ppcs->cdef_level = 0;
             }
         }
+    }
 
-        if (scs->vq_ctrls.sharpness_ctrls.restoration && pcs->ppcs->is_noise_level) {
-            pcs->ppcs->enable_restoration = 0;
-        }
+    if (scs->vq_ctrls.sharpness_ctrls.restoration && pcs->ppcs->is_noise_level) {
+        pcs->ppcs->enable_restoration = 0;
+    }
 
-        // Post the results to the MD processes
-        uint16_t tg_count = pcs->ppcs->tile_group_cols * pcs->ppcs->tile_group_rows;
-        for (uint16_t tile_group_idx = 0; tile_group_idx < tg_count; tile_group_idx++) {
-            svt_get_empty_object(context_ptr->mode_decision_configuration_output_fifo_ptr, &enc_dec_tasks_wrapper);
+    svt_aom_cdef_row_sync_init(pcs, rc_results->superres_recode);
 
-            EncDecTasks *enc_dec_tasks      = (EncDecTasks *)enc_dec_tasks_wrapper->object_ptr;
-            enc_dec_tasks->pcs_wrapper      = rc_results->pcs_wrapper;
-            enc_dec_tasks->input_type       = rc_results->superres_recode ? ENCDEC_TASKS_SUPERRES_INPUT
-                                                                          : ENCDEC_TASKS_MDC_INPUT;
-            enc_dec_tasks->tile_group_index = tile_group_idx;
+    // Post the results to the MD processes
+    uint16_t tg_count = pcs->ppcs->tile_group_cols * pcs->ppcs->tile_group_rows;
+    for (uint16_t tile_group_idx = 0; tile_group_idx < tg_count; tile_group_idx++) {
+        svt_get_empty_object(context_ptr->mode_decision_configuration_output_fifo_ptr, &enc_dec_tasks_wrapper);
 
-            // Post the Full Results Object
-            svt_post_full_object(enc_dec_tasks_wrapper);
+        EncDecTasks *enc_dec_tasks      = (EncDecTasks *)enc_dec_tasks_wrapper->object_ptr;
+        enc_dec_tasks->pcs_wrapper      = rc_results->pcs_wrapper;
+        enc_dec_tasks->input_type       = rc_results->superres_recode ? ENCDEC_TASKS_SUPERRES_INPUT
+                                                                      : ENCDEC_TASKS_MDC_INPUT;
+        enc_dec_tasks->tile_group_index = tile_group_idx;
 
-            if (rc_results->superres_recode) {
-                // for superres input, only send one task
-                break;
-            }
-        }
+        // Post the Full Results Object
+        svt_post_full_object(enc_dec_tasks_wrapper);
 
-        // Release Rate Control Results
-        svt_release_object(rc_results_wrapper);
+        if (rc_results->superres_recode) {
+            // for superres input, only send one task
+            break;
+        }
     }
 
-    return NULL;
+    // Release Rate Control Results
+    svt_release_object(rc_results_wrapper);
 }
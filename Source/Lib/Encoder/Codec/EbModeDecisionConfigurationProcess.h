@@ -51,7 +51,7 @@ EbErrorType svt_aom_mode_decision_configuration_context_ctor(EbThreadContext   *
                                                              const EbEncHandle *enc_handle_ptr, int input_index,
                                                              int output_index);
 
-extern void *svt_aom_mode_decision_configuration_kernel(void *input_ptr);
+extern void svt_aom_mode_decision_configuration_task(void *input_ptr, EbObjectWrapper *in_wrapper_ptr);
 
 #ifdef __cplusplus
 }
@@ -77,8 +77,10 @@ static void mode_decision_context_dctor(EbPtr p) {
     EB_FREE_ARRAY(obj->avail_blk_flag);
     EB_FREE_ARRAY(obj->cost_avail);
     EB_FREE_ARRAY(obj->md_blk_arr_nsq);
-    if (obj->rate_est_table)
+    if (obj->rate_est_table) {
+        EB_FREE_ARRAY(obj->rate_est_table->rate_fc);
         EB_FREE_ARRAY(obj->rate_est_table);
+    }
 
     for (int i = 0; i < NEAREST_NEAR_MV_CNT; i++) {
         if (obj->cmp_store.pred0_buf[i])
@@ -201,9 +203,14 @@ EbErrorType svt_aom_mode_decision_context_ctor(ModeDecisionContext *ctx, EbColor
             use_update_cdf |= svt_aom_get_update_cdf_level(enc_mode, is_islice, is_base);
         }
     }
-    if (use_update_cdf)
+    if (use_update_cdf) {
         EB_CALLOC_ARRAY(ctx->rate_est_table, 1);
-    else
+        // The table is estimated from the CDFs of each SB, mostly the same as the ones of the previous SB:
+        // invalid CDFs are set so that all the rates are estimated at the first call
+        EB_MALLOC_ARRAY(ctx->rate_est_table->rate_fc, 1);
+        memset(ctx->rate_est_table->rate_fc, 0xFF, sizeof(*ctx->rate_est_table->rate_fc));
+        ctx->rate_est_table->rate_fc_mv_hp = -1;
+    } else
         ctx->rate_est_table = NULL;
     // Allocate buffer for inter-inter compound prediction
     if (get_inter_compound_level(enc_mode)) {
@@ -776,6 +776,70 @@ static void open_loop_me_get_search_point_results_block(
                                         &p_sad32x32[0]);
 }
 
+// Position of the 8x8 blocks of a 64x64 block, in the order of p_best_sad_8x8
+static const uint8_t me_8x8_pos_x[64] = {
+    0,  8,  0,  8,  16, 24, 16, 24, 0,  8,  0,  8,  16, 24, 16, 24, 32, 40, 32, 40, 48, 56,
+    48, 56, 32, 40, 32, 40, 48, 56, 48, 56, 0,  8,  0,  8,  16, 24, 16, 24, 0,  8,  0,  8,
+    16, 24, 16, 24, 32, 40, 32, 40, 48, 56, 48, 56, 32, 40, 32, 40, 48, 56, 48, 56};
+static const uint8_t me_8x8_pos_y[64] = {
+    0,  0,  8,  8,  0,  0,  8,  8,  16, 16, 24, 24, 16, 16, 24, 24, 0,  0,  8,  8,  0,  0,
+    8,  8,  16, 16, 24, 24, 16, 16, 24, 24, 32, 32, 40, 40, 32, 32, 40, 40, 48, 48, 56, 56,
+    48, 48, 56, 56, 32, 32, 40, 40, 32, 32, 40, 40, 48, 48, 56, 56, 48, 48, 56, 56};
+
+/*
+ * Sum the left and right halves of the rows of the sub-sampled SAD (rows 0, 2, 4 and 6) of each 8x8 block of the
+ * source 64x64 block.
+ */
+static void sea_generate_src_sum_4x1(MeContext *me_ctx) {
+    const uint32_t stride = me_ctx->b64_src_stride;
+    for (uint32_t i = 0; i < 64; i++) {
+        const uint8_t *src = me_ctx->b64_src_ptr + me_8x8_pos_y[i] * stride + me_8x8_pos_x[i];
+        for (uint32_t j = 0; j < 8; j++) {
+            const uint8_t *row = src + (j >> 1) * 2 * stride + (j & 1) * 4;
+            me_ctx->me_sum_4x1_src[i][j] = row[0] + row[1] + row[2] + row[3];
+        }
+    }
+}
+
+/*
+ * Successive elimination: the sum of |sum(src) - sum(ref)| over the 4x1 pieces of the sub-sampled rows is a lower
+ * bound of their SAD, so a group of 8 search points can only update a best SAD when the bound of one of its 8x8
+ * blocks, or of the sum of the bounds of a 16x16, 32x32 or 64x64 block, is below the best SAD of the block. The best
+ * SADs only decrease within the group, and are updated when strictly lower, so skipping the others is exact.
+ */
+static Bool sea_eight_search_points_may_improve(const MeContext *me_ctx, const uint16_t *ref_sum, uint32_t ref_stride,
+                                                const uint32_t *offset) {
+    for (uint32_t search_index = 0; search_index < 8; search_index++) {
+        uint32_t lb_64x64 = 0;
+        for (uint32_t i32 = 0; i32 < 4; i32++) {
+            uint32_t lb_32x32 = 0;
+            for (uint32_t i16 = i32 * 4; i16 < i32 * 4 + 4; i16++) {
+                uint32_t lb_16x16 = 0;
+                for (uint32_t i8 = i16 * 4; i8 < i16 * 4 + 4; i8++) {
+                    const uint16_t *src = me_ctx->me_sum_4x1_src[i8];
+                    const uint16_t *ref = ref_sum + offset[i8] + search_index;
+                    uint32_t        lb  = 0;
+                    for (uint32_t j = 0; j < 8; j++)
+                        lb += ABS((int32_t)src[j] - (int32_t)ref[(j >> 1) * 2 * ref_stride + (j & 1) * 4]);
+                    lb <<= 1;
+                    if (lb < me_ctx->p_best_sad_8x8[i8])
+                        return TRUE;
+                    lb_16x16 += lb;
+                }
+                if (lb_16x16 < me_ctx->p_best_sad_16x16[i16])
+                    return TRUE;
+                lb_32x32 += lb_16x16;
+            }
+            if (lb_32x32 < me_ctx->p_best_sad_32x32[i32])
+                return TRUE;
+            lb_64x64 += lb_32x32;
+        }
+        if (lb_64x64 < me_ctx->p_best_sad_64x64[0])
+            return TRUE;
+    }
+    return FALSE;
+}
+
 /*******************************************
  * open_loop_me_fullpel_search_sblock
  *******************************************/
@@ -787,9 +851,21 @@ static void open_loop_me_fullpel_search_sblock(MeContext *me_ctx, uint32_t list_
     uint32_t x_search_index, y_search_index;
     uint32_t search_area_width_rest_8 = search_area_width & 7;
     uint32_t search_area_width_mult_8 = search_area_width - search_area_width_rest_8;
+    const uint32_t ref_stride = me_ctx->interpolated_full_stride[list_index][ref_pic_index];
+    const uint16_t *sea_sum = search_area_width_mult_8 ? me_ctx->me_sum_4x1[list_index][ref_pic_index] : NULL;
+    uint32_t        sea_offset[64];
+    if (sea_sum) {
+        sea_sum += (ME_FILTER_TAP >> 1) * ref_stride + (ME_FILTER_TAP >> 1);
+        for (uint32_t i = 0; i < 64; i++)
+            sea_offset[i] = me_8x8_pos_y[i] * ref_stride + me_8x8_pos_x[i];
+    }
 
     for (y_search_index = 0; y_search_index < search_area_height; y_search_index++) {
         for (x_search_index = 0; x_search_index < search_area_width_mult_8; x_search_index += 8) {
+            if (sea_sum &&
+                !sea_eight_search_points_may_improve(
+                    me_ctx, sea_sum + y_search_index * ref_stride + x_search_index, ref_stride, sea_offset))
+                continue;
             // this function will do:  x_search_index, +1, +2, ..., +7
             open_loop_me_get_eight_search_point_results_block(
                 me_ctx,
@@ -1274,6 +1350,10 @@ static void integer_search_b64(PictureParentControlSet *pcs, uint32_t b64_index,
     int16_t              y_search_center = 0;
     EbPictureBufferDesc *ref_pic_ptr;
     num_of_list_to_search = me_ctx->num_of_list_to_search;
+    const Bool sea        = me_ctx->me_sea && me_ctx->me_type == ME_OPEN_LOOP &&
+        me_ctx->me_search_method == SUB_SAD_SEARCH;
+    if (sea)
+        sea_generate_src_sum_4x1(me_ctx);
 
     // Uni-Prediction motion estimation loop
     // List Loop
@@ -1565,6 +1645,14 @@ static void integer_search_b64(PictureParentControlSet *pcs, uint32_t b64_index,
                 ref_pic_ptr->buffer_y[search_region_index]);
             me_ctx->interpolated_full_stride[list_index][ref_pic_index] =
                 ref_pic_ptr->stride_y;
+            me_ctx->me_sum_4x1[list_index][ref_pic_index] = NULL;
+            if (sea) {
+                EbPaReferenceObject *ref_obj =
+                    (EbPaReferenceObject *)pcs->ref_pa_pic_ptr_array[list_index][ref_pic_index]->object_ptr;
+                // the sums are of the full resolution PA reference only
+                if (ref_obj->input_padded_pic == ref_pic_ptr && ref_obj->me_sum_4x1_stride == ref_pic_ptr->stride_y)
+                    me_ctx->me_sum_4x1[list_index][ref_pic_index] = ref_obj->me_sum_4x1 + search_region_index;
+            }
 
             // Move to the top left of the search region
             x_top_left_search_region = (int16_t)(ref_pic_ptr->org_x + b64_origin_x) + x_search_area_origin;
@@ -1964,6 +2052,62 @@ static void get_worst_quadrant( MeContext *me_ctx,uint32_t list_index,uint32_t r
 
 }
 
+/*
+ * Use the MV temporal filtering found for the current 64x64 block and reference picture as the HME level 0
+ * search centre of all the search regions, when it matches at least as well as the zero MV.
+ * Returns TRUE when the level 0 search can be skipped.
+ */
+static Bool tf_mv_seed_level0(PictureParentControlSet *pcs, MeContext *me_ctx, uint32_t org_x, uint32_t org_y,
+                              uint8_t list_index, uint8_t ref_pic_index, EbPictureBufferDesc *input_ptr,
+                              EbPictureBufferDesc *sixteenth_ref_pic) {
+    if (pcs->frame_superres_enabled || pcs->frame_resize_enabled)
+        return FALSE;
+    const uint32_t b64_index = (org_y / BLOCK_SIZE_64) * ((input_ptr->width + BLOCK_SIZE_64 - 1) / BLOCK_SIZE_64) +
+        org_x / BLOCK_SIZE_64;
+    Mv mv;
+    if (!svt_aom_get_tf_mv((EbPaReferenceObject *)pcs->pa_ref_pic_wrapper->object_ptr,
+                           (EbPaReferenceObject *)pcs->ref_pa_pic_ptr_array[list_index][ref_pic_index]->object_ptr,
+                           b64_index,
+                           &mv))
+        return FALSE;
+    const int16_t block_width  = (int16_t)(me_ctx->b64_width >> 2);
+    const int16_t block_height = (int16_t)(me_ctx->b64_height >> 2);
+    const int16_t x            = (int16_t)(org_x >> 2);
+    const int16_t y            = (int16_t)(org_y >> 2);
+    // keep the block inside the padded sixteenth reference
+    const int16_t pad_width  = (int16_t)sixteenth_ref_pic->org_x;
+    const int16_t pad_height = (int16_t)sixteenth_ref_pic->org_y;
+    const int16_t mv_x       = CLIP3(-pad_width - x,
+                               (int16_t)sixteenth_ref_pic->width + pad_width - block_width - x,
+                               (int16_t)(mv.x / 4));
+    const int16_t mv_y       = CLIP3(-pad_height - y,
+                               (int16_t)sixteenth_ref_pic->height + pad_height - block_height - y,
+                               (int16_t)(mv.y / 4));
+    uint8_t *ref = sixteenth_ref_pic->buffer_y + (sixteenth_ref_pic->org_y + y) * sixteenth_ref_pic->stride_y +
+        sixteenth_ref_pic->org_x + x;
+    const uint32_t zz_sad  = svt_nxm_sad_kernel(me_ctx->sixteenth_b64_buffer,
+                                               me_ctx->sixteenth_b64_buffer_stride,
+                                               ref,
+                                               sixteenth_ref_pic->stride_y,
+                                               block_height,
+                                               block_width);
+    const uint32_t tf_sad = svt_nxm_sad_kernel(me_ctx->sixteenth_b64_buffer,
+                                               me_ctx->sixteenth_b64_buffer_stride,
+                                               ref + mv_y * sixteenth_ref_pic->stride_y + mv_x,
+                                               sixteenth_ref_pic->stride_y,
+                                               block_height,
+                                               block_width);
+    if (tf_sad > zz_sad)
+        return FALSE;
+    for (uint32_t sr_idx_y = 0; sr_idx_y < me_ctx->num_hme_sa_h; sr_idx_y++) {
+        for (uint32_t sr_idx_x = 0; sr_idx_x < me_ctx->num_hme_sa_w; sr_idx_x++) {
+            me_ctx->x_hme_level0_search_center[list_index][ref_pic_index][sr_idx_x][sr_idx_y] = mv_x * 4;
+            me_ctx->y_hme_level0_search_center[list_index][ref_pic_index][sr_idx_x][sr_idx_y] = mv_y * 4;
+            me_ctx->hme_level0_sad[list_index][ref_pic_index][sr_idx_x][sr_idx_y]             = tf_sad;
+        }
+    }
+    return TRUE;
+}
 /*******************************************
  * performs hierarchical ME level 0 for one 64x64 block (uni-prediction only)
  *******************************************/
@@ -2036,6 +2180,10 @@ static void hme_level0_b64(PictureParentControlSet *pcs, uint32_t org_x, uint32_
                 pcs, me_ctx, list_index, ref_pic_index, 0, &dist, input_ptr->width, input_ptr->height);
 
             if (me_ctx->temporal_layer_index > 0 || list_index == 0) {
+                if (me_ctx->tf_mv_seed && me_ctx->me_type == ME_OPEN_LOOP &&
+                    tf_mv_seed_level0(
+                        pcs, me_ctx, org_x, org_y, list_index, ref_pic_index, input_ptr, sixteenth_ref_pic))
+                    continue;
                 // Get the HME L0 search dimensions for the current frame
                 int16_t sa_width = 0, sa_height = 0;
                 get_hme_l0_search_area(me_ctx, list_index, ref_pic_index, dist, &sa_width, &sa_height);
@@ -496,6 +496,14 @@ typedef struct MeContext {
     uint32_t     b64_height;
     uint8_t      performed_phme[MAX_NUM_OF_REF_PIC_LIST][REF_LIST_MAX_DEPTH][2];
     uint32_t     prev_me_stage_based_exit_th;
+    // Use the MVs of temporal filtering for the same pair of pictures as HME level 0 search centre
+    uint8_t tf_mv_seed;
+    // Successive elimination of the full-pel search positions (open-loop ME with sub-sampled SAD)
+    uint8_t me_sea;
+    // 4x1 sums of the reference at the search region origin, NULL when not available
+    uint16_t *me_sum_4x1[MAX_NUM_OF_REF_PIC_LIST][MAX_REF_IDX];
+    // 4x1 sums of the rows of the sub-sampled SAD of each 8x8 block of the source, in the order of p_best_sad_8x8
+    uint16_t me_sum_4x1_src[64][8];
 } MeContext;
 
 typedef uint64_t (*EB_ME_DISTORTION_FUNC)(uint8_t *src, uint32_t src_stride, uint8_t *ref, uint32_t ref_stride,
@@ -43,7 +43,7 @@ typedef struct InLoopMeContext {
 EbErrorType svt_aom_motion_estimation_context_ctor(EbThreadContext *thread_ctx, const EbEncHandle *enc_handle_ptr,
                                                    int index);
 
-extern void *svt_aom_motion_estimation_kernel(void *input_ptr);
+extern void svt_aom_motion_estimation_task(void *input_ptr, EbObjectWrapper *in_wrapper_ptr);
 
 void svt_aom_gm_pre_processor(PictureParentControlSet *pcs, PictureParentControlSet **pcs_list);
 
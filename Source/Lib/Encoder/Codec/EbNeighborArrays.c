@@ -69,11 +69,16 @@ static void neighbor_array_unit_dctor(EbPtr p) {
     EB_FREE(obj->top_left_array);
 }
 
-EbErrorType svt_aom_neighbor_array_unit_ctor(NeighborArrayUnit *na_unit_ptr, uint32_t max_picture_width,
-                                             uint32_t max_picture_height, uint32_t unit_size,
-                                             uint8_t granularity_normal, uint8_t granularity_top_left,
-                                             uint8_t type_mask) {
-    na_unit_ptr->dctor                     = neighbor_array_unit_dctor;
+/*************************************************
+ * Neighbor Array Unit Ctor
+ *   The arrays come from arena when it is not NULL,
+ *   the unit is then released with the arena.
+ *************************************************/
+EbErrorType svt_aom_neighbor_array_unit_ctor(NeighborArrayUnit *na_unit_ptr, EbArena *arena,
+                                             uint32_t max_picture_width, uint32_t max_picture_height,
+                                             uint32_t unit_size, uint8_t granularity_normal,
+                                             uint8_t granularity_top_left, uint8_t type_mask) {
+    na_unit_ptr->dctor                     = arena ? NULL : neighbor_array_unit_dctor;
     na_unit_ptr->unit_size                 = (uint8_t)(unit_size);
     na_unit_ptr->granularity_normal        = granularity_normal;
     na_unit_ptr->granularity_normal_log2   = (uint8_t)(svt_log2f(na_unit_ptr->granularity_normal));
@@ -93,6 +98,15 @@ EbErrorType svt_aom_neighbor_array_unit_ctor(NeighborArrayUnit *na_unit_ptr, uin
                                                           na_unit_ptr->granularity_top_left_log2
                                                       : 0);
 
+    if (arena) {
+        if (na_unit_ptr->left_array_size)
+            EB_ARENA_MALLOC_ARRAY(arena, na_unit_ptr->left_array, unit_size * na_unit_ptr->left_array_size);
+        if (na_unit_ptr->top_array_size)
+            EB_ARENA_MALLOC_ARRAY(arena, na_unit_ptr->top_array, unit_size * na_unit_ptr->top_array_size);
+        if (na_unit_ptr->top_left_array_size)
+            EB_ARENA_MALLOC_ARRAY(arena, na_unit_ptr->top_left_array, unit_size * na_unit_ptr->top_left_array_size);
+        return EB_ErrorNone;
+    }
     if (na_unit_ptr->left_array_size) {
         EB_MALLOC(na_unit_ptr->left_array, na_unit_ptr->unit_size * na_unit_ptr->left_array_size);
     }
@@ -15,6 +15,7 @@
 #include "EbDefinitions.h"
 #include "EbMotionVectorUnit.h"
 #include "EbObject.h"
+#include "EbArena.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -77,10 +78,10 @@ extern EbErrorType svt_aom_neighbor_array_unit_ctor32(NeighborArrayUnit32 *na_un
                                                       uint8_t granularity_normal, uint8_t granularity_top_left,
                                                       uint8_t type_mask);
 
-extern EbErrorType svt_aom_neighbor_array_unit_ctor(NeighborArrayUnit *na_unit_ptr, uint32_t max_picture_width,
-                                                    uint32_t max_picture_height, uint32_t unit_size,
-                                                    uint8_t granularity_normal, uint8_t granularity_top_left,
-                                                    uint8_t type_mask);
+extern EbErrorType svt_aom_neighbor_array_unit_ctor(NeighborArrayUnit *na_unit_ptr, EbArena *arena,
+                                                    uint32_t max_picture_width, uint32_t max_picture_height,
+                                                    uint32_t unit_size, uint8_t granularity_normal,
+                                                    uint8_t granularity_top_left, uint8_t type_mask);
 
 extern void svt_aom_neighbor_array_unit_reset(NeighborArrayUnit *na_unit_ptr);
 
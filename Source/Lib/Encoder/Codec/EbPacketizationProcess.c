@@ -309,7 +309,10 @@ static void collect_frames_info(PacketizationContext *context_ptr, const EncodeC
 // a tu start with a td, + 0 more not displable frame, + 1 display frame
 static EbErrorType encode_tu(EncodeContext *enc_ctx, int frames, uint32_t total_bytes,
                              EbBufferHeaderType *output_stream_ptr) {
-    total_bytes += TD_SIZE;
+    // the TD went out with the leading tile groups of the first frame
+    const Bool has_td = !get_reorder_queue_entry(enc_ctx, 0)->tile_groups_sent;
+    if (has_td)
+        total_bytes += TD_SIZE;
     if (total_bytes > output_stream_ptr->n_alloc_len) {
         uint8_t *pbuff;
         EB_MALLOC(pbuff, total_bytes);
@@ -345,10 +348,12 @@ static EbErrorType encode_tu(EncodeContext *enc_ctx, int frames, uint32_t total_
     }
     if (frames > 1)
         sort_undisplayed_frame(enc_ctx);
-    dst -= TD_SIZE;
-    svt_aom_encode_td_av1(dst);
+    if (has_td) {
+        dst -= TD_SIZE;
+        svt_aom_encode_td_av1(dst);
+        output_stream_ptr->flags |= EB_BUFFERFLAG_HAS_TD;
+    }
     output_stream_ptr->n_filled_len = total_bytes;
-    output_stream_ptr->flags |= EB_BUFFERFLAG_HAS_TD;
     return EB_ErrorNone;
 }
 
@@ -466,6 +471,100 @@ static EbErrorType realloc_output_bitstream(Bitstream *bitstream_ptr, uint32_t s
     }
     return EB_ErrorNone;
 }
+// Writes the sequence header and the HDR static metadata of a key frame
+static void write_key_frame_headers(SequenceControlSet *scs, PictureControlSet *pcs) {
+    if (pcs->ppcs->frm_hdr.frame_type != KEY_FRAME)
+        return;
+    if (scs->static_config.mastering_display.max_luma)
+        svt_add_metadata(pcs->ppcs->input_ptr,
+                         EB_AV1_METADATA_TYPE_HDR_MDCV,
+                         (const uint8_t *)&scs->static_config.mastering_display,
+                         sizeof(scs->static_config.mastering_display));
+    if (scs->static_config.content_light_level.max_cll)
+        svt_add_metadata(pcs->ppcs->input_ptr,
+                         EB_AV1_METADATA_TYPE_HDR_CLL,
+                         (const uint8_t *)&scs->static_config.content_light_level,
+                         sizeof(scs->static_config.content_light_level));
+    svt_aom_encode_sps_av1(pcs->bitstream_ptr, scs);
+    // Add CLL and MDCV meta when frame is keyframe and SPS is written
+    svt_aom_write_metadata_av1(pcs->bitstream_ptr, pcs->ppcs->input_ptr->metadata, EB_AV1_METADATA_TYPE_HDR_CLL);
+    svt_aom_write_metadata_av1(pcs->bitstream_ptr, pcs->ppcs->input_ptr->metadata, EB_AV1_METADATA_TYPE_HDR_MDCV);
+}
+
+/*********************************************************************
+ * svt_aom_tile_group_output
+ *   Outputs the consecutive coded tiles that follow the ones already
+ *   output in a partial packet, as a tile group. The first packet of the
+ *   frame also carries the TD, the sequence header of a key frame, the
+ *   metadata and the frame header. The last tile is left to the
+ *   packetization, which outputs the packet closing the frame.
+ *
+ *   Called by the entropy coding with tile_group_output_mutex held. Only
+ *   the frame next to be output in decode order outputs its tiles, so the
+ *   packets of different frames are never interleaved.
+ *********************************************************************/
+void svt_aom_tile_group_output(PictureControlSet *pcs) {
+    SequenceControlSet      *scs      = pcs->scs;
+    EncodeContext           *enc_ctx  = scs->enc_ctx;
+    PictureParentControlSet *ppcs     = pcs->ppcs;
+    Av1Common *const         cm       = ppcs->av1_cm;
+    const uint16_t           tile_cnt = cm->tiles_info.tile_rows * cm->tiles_info.tile_cols;
+    const uint16_t           start    = pcs->tile_group_output_count;
+    uint16_t                 end      = start;
+
+    if (pcs->tile_group_output_closed || ppcs->decode_order != enc_ctx->tile_group_output_decode_order)
+        return;
+    svt_block_on_mutex(pcs->entropy_coding_pic_mutex);
+    while (end < tile_cnt - 1 && pcs->ec_info[end]->entropy_coding_tile_done) end++;
+    svt_release_mutex(pcs->entropy_coding_pic_mutex);
+    if (end == start)
+        return;
+
+    svt_aom_bitstream_reset(pcs->bitstream_ptr);
+    if (start == 0) {
+        write_key_frame_headers(scs, pcs);
+        // Add HDR10+ dynamic metadata, tile group output frames are all shown
+        svt_aom_write_metadata_av1(pcs->bitstream_ptr, ppcs->input_ptr->metadata, EB_AV1_METADATA_TYPE_ITUT_T35);
+        svt_metadata_array_free(&ppcs->input_ptr->metadata);
+        svt_aom_write_frame_header_obu_av1(pcs->bitstream_ptr, scs, pcs);
+    }
+    svt_aom_write_tile_group_av1(pcs->bitstream_ptr, pcs, start, end - 1);
+
+    EbObjectWrapper *output_stream_wrapper_ptr;
+    svt_get_empty_object(enc_ctx->stream_output_fifo_ptr, &output_stream_wrapper_ptr);
+    EbBufferHeaderType *output_stream_ptr = (EbBufferHeaderType *)output_stream_wrapper_ptr->object_ptr;
+    const uint32_t      size              = (uint32_t)svt_aom_bitstream_get_bytes_count(pcs->bitstream_ptr);
+
+    output_stream_ptr->flags         = EB_BUFFERFLAG_PARTIAL_FRAME;
+    output_stream_ptr->n_filled_len  = 0;
+    output_stream_ptr->pts           = ppcs->input_ptr->pts;
+    output_stream_ptr->dts           = output_stream_ptr->pts;
+    output_stream_ptr->pic_type      = ppcs->is_ref ? ppcs->idr_flag ? EB_AV1_KEY_PICTURE : (EbAv1PictureType)pcs->slice_type
+                                                    : EB_AV1_NON_REF_PICTURE;
+    output_stream_ptr->p_app_private = NULL;
+    output_stream_ptr->qp            = ppcs->picture_qp;
+    output_stream_ptr->luma_sse      = 0;
+    output_stream_ptr->cr_sse        = 0;
+    output_stream_ptr->cb_sse        = 0;
+    output_stream_ptr->luma_ssim     = 0;
+    output_stream_ptr->cr_ssim       = 0;
+    output_stream_ptr->cb_ssim       = 0;
+    output_stream_ptr->n_alloc_len   = size + TD_SIZE;
+    malloc_p_buffer(output_stream_ptr);
+    assert(output_stream_ptr->p_buffer != NULL && "bit-stream memory allocation failure");
+    if (start == 0) {
+        svt_aom_encode_td_av1(output_stream_ptr->p_buffer);
+        output_stream_ptr->n_filled_len = TD_SIZE;
+        output_stream_ptr->flags |= EB_BUFFERFLAG_HAS_TD;
+    }
+    svt_aom_bitstream_copy(pcs->bitstream_ptr, output_stream_ptr->p_buffer + output_stream_ptr->n_filled_len, size);
+    output_stream_ptr->n_filled_len += size;
+    svt_post_full_object(output_stream_wrapper_ptr);
+
+    pcs->tile_group_output_count = end;
+    pcs->tile_group_output_bytes += size;
+}
+
 void *svt_aom_packetization_kernel(void *input_ptr) {
     // Context
     EbThreadContext      *thread_ctx  = (EbThreadContext *)input_ptr;
@@ -701,18 +800,13 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
         EbObjectWrapper    *output_stream_wrapper_ptr = pcs->ppcs->output_stream_wrapper_ptr;
         EbBufferHeaderType *output_stream_ptr         = (EbBufferHeaderType *)output_stream_wrapper_ptr->object_ptr;
 
-        if (frm_hdr->frame_type == KEY_FRAME) {
-            if (scs->static_config.mastering_display.max_luma)
-                svt_add_metadata(pcs->ppcs->input_ptr,
-                                 EB_AV1_METADATA_TYPE_HDR_MDCV,
-                                 (const uint8_t *)&scs->static_config.mastering_display,
-                                 sizeof(scs->static_config.mastering_display));
-            if (scs->static_config.content_light_level.max_cll)
-                svt_add_metadata(pcs->ppcs->input_ptr,
-                                 EB_AV1_METADATA_TYPE_HDR_CLL,
-                                 (const uint8_t *)&scs->static_config.content_light_level,
-                                 sizeof(scs->static_config.content_light_level));
+        // Stop the tile group output, the tiles left go in the packet of the frame
+        if (pcs->tile_group_output) {
+            svt_block_on_mutex(enc_ctx->tile_group_output_mutex);
+            pcs->tile_group_output_closed = TRUE;
+            svt_release_mutex(enc_ctx->tile_group_output_mutex);
         }
+        queue_entry_ptr->tile_groups_sent = pcs->tile_group_output && pcs->tile_group_output_count;
 
         output_stream_ptr->flags = 0;
 #if !OPT_LD_LATENCY2
@@ -779,32 +873,31 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
 
         size_t metadata_sz = 0;
 
-        // Code the SPS
-        if (frm_hdr->frame_type == KEY_FRAME) {
-            svt_aom_encode_sps_av1(pcs->bitstream_ptr, scs);
-            // Add CLL and MDCV meta when frame is keyframe and SPS is written
-            svt_aom_write_metadata_av1(
-                pcs->bitstream_ptr, pcs->ppcs->input_ptr->metadata, EB_AV1_METADATA_TYPE_HDR_CLL);
-            svt_aom_write_metadata_av1(
-                pcs->bitstream_ptr, pcs->ppcs->input_ptr->metadata, EB_AV1_METADATA_TYPE_HDR_MDCV);
-        }
-
-        if (frm_hdr->show_frame) {
-            // Add HDR10+ dynamic metadata when show frame flag is enabled
-            svt_aom_write_metadata_av1(
-                pcs->bitstream_ptr, pcs->ppcs->input_ptr->metadata, EB_AV1_METADATA_TYPE_ITUT_T35);
-            svt_metadata_array_free(&pcs->ppcs->input_ptr->metadata);
+        if (queue_entry_ptr->tile_groups_sent) {
+            // The headers and the metadata went out with the leading tile groups
+            svt_aom_write_tile_group_av1(pcs->bitstream_ptr, pcs, pcs->tile_group_output_count, tile_cnt - 1);
         } else {
-            // Copy metadata pointer to the queue entry related to current frame number
-            uint64_t                   current_picture_number = pcs->picture_number;
-            PacketizationReorderEntry *temp_entry =
-                enc_ctx->packetization_reorder_queue[current_picture_number % PACKETIZATION_REORDER_QUEUE_MAX_DEPTH];
-            temp_entry->metadata           = pcs->ppcs->input_ptr->metadata;
-            pcs->ppcs->input_ptr->metadata = NULL;
-            metadata_sz                    = svt_metadata_size(temp_entry->metadata, EB_AV1_METADATA_TYPE_ITUT_T35);
-        }
+            // Code the SPS
+            write_key_frame_headers(scs, pcs);
+
+            if (frm_hdr->show_frame) {
+                // Add HDR10+ dynamic metadata when show frame flag is enabled
+                svt_aom_write_metadata_av1(
+                    pcs->bitstream_ptr, pcs->ppcs->input_ptr->metadata, EB_AV1_METADATA_TYPE_ITUT_T35);
+                svt_metadata_array_free(&pcs->ppcs->input_ptr->metadata);
+            } else {
+                // Copy metadata pointer to the queue entry related to current frame number
+                uint64_t                   current_picture_number = pcs->picture_number;
+                PacketizationReorderEntry *temp_entry =
+                    enc_ctx
+                        ->packetization_reorder_queue[current_picture_number % PACKETIZATION_REORDER_QUEUE_MAX_DEPTH];
+                temp_entry->metadata           = pcs->ppcs->input_ptr->metadata;
+                pcs->ppcs->input_ptr->metadata = NULL;
+                metadata_sz = svt_metadata_size(temp_entry->metadata, EB_AV1_METADATA_TYPE_ITUT_T35);
+            }
 
-        svt_aom_write_frame_header_av1(pcs->bitstream_ptr, scs, pcs, 0);
+            svt_aom_write_frame_header_av1(pcs->bitstream_ptr, scs, pcs, 0);
+        }
 
         output_stream_ptr->n_alloc_len = (uint32_t)(svt_aom_bitstream_get_bytes_count(pcs->bitstream_ptr) + TD_SIZE +
                                                     metadata_sz);
@@ -835,7 +928,9 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
         }
 
         // Send the number of bytes per frame to RC
-        pcs->ppcs->total_num_bits = output_stream_ptr->n_filled_len << 3;
+        pcs->ppcs->total_num_bits = (uint64_t)(output_stream_ptr->n_filled_len +
+                                               (queue_entry_ptr->tile_groups_sent ? pcs->tile_group_output_bytes : 0))
+            << 3;
         if (scs->passes == 2 && scs->static_config.pass == ENC_FIRST_PASS) {
             StatStruct stat_struct;
             stat_struct.poc = pcs->picture_number;
@@ -946,6 +1041,13 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
                 }
             }
 
+            if (scs->static_config.enable_tile_group_output) {
+                // The next frame in decode order may now output its tile groups
+                svt_block_on_mutex(enc_ctx->tile_group_output_mutex);
+                enc_ctx->tile_group_output_decode_order += frames;
+                svt_release_mutex(enc_ctx->tile_group_output_mutex);
+            }
+
             if (queue_entry_ptr->show_frame)
                 enc_ctx->total_number_of_shown_frames++;
             if (queue_entry_ptr->has_show_existing)
@@ -24,6 +24,8 @@ EbErrorType svt_aom_packetization_context_ctor(EbThreadContext *thread_ctx, cons
                                                int rate_control_index, int demux_index, int me_port_index);
 
 extern void *svt_aom_packetization_kernel(void *input_ptr);
+// Output the leading coded tiles of a frame in a partial packet, tile group output only
+extern void svt_aom_tile_group_output(PictureControlSet *pcs);
 #if OPT_LD_LATENCY2
 // Release the pd_dpb and ref_pic_list at the end of the sequence
 extern void release_references_eos(SequenceControlSet *scs);
@@ -50,6 +50,8 @@ typedef struct PacketizationReorderEntry {
     int64_t                  next_pts;
     uint8_t                  is_alt_ref;
     struct SvtMetadataArray *metadata;
+    // the TD and the leading tile groups were output in partial packets
+    Bool tile_groups_sent;
 } PacketizationReorderEntry;
 
 extern EbErrorType svt_aom_packetization_reorder_entry_ctor(PacketizationReorderEntry *entry_ptr,
@@ -2147,13 +2147,12 @@ void svt_aom_pad_input_pictures(SequenceControlSet *scs, EbPictureBufferDesc *in
  *then used to compute statistics
  *
  ********************************************************************************/
-void *svt_aom_picture_analysis_kernel(void *input_ptr) {
+void svt_aom_picture_analysis_task(void *input_ptr, EbObjectWrapper *in_results_wrapper_ptr) {
     EbThreadContext         *thread_ctx = (EbThreadContext *)input_ptr;
     PictureAnalysisContext  *pa_ctx     = (PictureAnalysisContext *)thread_ctx->priv;
     PictureParentControlSet *pcs;
     SequenceControlSet      *scs;
 
-    EbObjectWrapper             *in_results_wrapper_ptr;
     ResourceCoordinationResults *in_results_ptr;
     EbObjectWrapper             *out_results_wrapper;
     EbPaReferenceObject         *pa_ref_obj_;
@@ -2161,99 +2160,94 @@ void *svt_aom_picture_analysis_kernel(void *input_ptr) {
     EbPictureBufferDesc *input_padded_pic;
     EbPictureBufferDesc *input_pic;
 
-    for (;;) {
-        // Get Input Full Object
-        EB_GET_FULL_OBJECT(pa_ctx->resource_coordination_results_input_fifo_ptr, &in_results_wrapper_ptr);
-
-        in_results_ptr = (ResourceCoordinationResults *)in_results_wrapper_ptr->object_ptr;
-        pcs            = (PictureParentControlSet *)in_results_ptr->pcs_wrapper->object_ptr;
-        scs            = pcs->scs;
-
-        // Mariana : save enhanced picture ptr, move this from here
-        pcs->enhanced_unscaled_pic                    = pcs->enhanced_pic;
-        pcs->enhanced_unscaled_pic->is_16bit_pipeline = scs->is_16bit_pipeline;
-
-        // There is no need to do processing for overlay picture. Overlay and AltRef share the same
-        // results.
-        if (!pcs->is_overlay) {
-            input_pic = pcs->enhanced_pic;
-            {
-                // Padding for input pictures
-                svt_aom_pad_input_pictures(scs, input_pic);
-
-                // Pre processing operations performed on the input picture
-                svt_aom_picture_pre_processing_operations(pcs, scs);
-
-                if (input_pic->color_format >= EB_YUV422) {
-                    // Jing: Do the conversion of 422/444=>420 here since it's multi-threaded kernel
-                    //       Reuse the Y, only add cb/cr in the newly created buffer desc
-                    //       NOTE: since denoise may change the src, so this part is after svt_aom_picture_pre_processing_operations()
-                    pcs->chroma_downsampled_pic->buffer_y = input_pic->buffer_y;
-                    svt_aom_down_sample_chroma(input_pic, pcs->chroma_downsampled_pic);
-                } else
-                    pcs->chroma_downsampled_pic = input_pic;
-
-                //not passing through the DS pool, so 1/4 and 1/16 are not used
-                pcs->ds_pics.picture_ptr           = input_pic;
-                pcs->ds_pics.quarter_picture_ptr   = NULL;
-                pcs->ds_pics.sixteenth_picture_ptr = NULL;
-                pcs->ds_pics.picture_number        = pcs->picture_number;
-
-                // Original path
-                // Get PA ref, copy 8bit luma to pa_ref->input_padded_pic
-                pa_ref_obj_                 = (EbPaReferenceObject *)pcs->pa_ref_pic_wrapper->object_ptr;
-                pa_ref_obj_->picture_number = pcs->picture_number;
-                input_padded_pic            = (EbPictureBufferDesc *)pa_ref_obj_->input_padded_pic;
-
-                // 1/4 & 1/16 input picture downsampling through filtering
-                if (scs->down_sampling_method_me_search == ME_FILTERED_DOWNSAMPLED) {
-                    svt_aom_downsample_filtering_input_picture(
-                        pcs,
-                        input_padded_pic,
-                        (EbPictureBufferDesc *)pa_ref_obj_->quarter_downsampled_picture_ptr,
-                        (EbPictureBufferDesc *)pa_ref_obj_->sixteenth_downsampled_picture_ptr);
-                } else {
-                    svt_aom_downsample_decimation_input_picture(
-                        pcs,
-                        input_padded_pic,
-                        (EbPictureBufferDesc *)pa_ref_obj_->quarter_downsampled_picture_ptr,
-                        (EbPictureBufferDesc *)pa_ref_obj_->sixteenth_downsampled_picture_ptr);
-                }
-
-                pcs->ds_pics.quarter_picture_ptr   = pa_ref_obj_->quarter_downsampled_picture_ptr;
-                pcs->ds_pics.sixteenth_picture_ptr = pa_ref_obj_->sixteenth_downsampled_picture_ptr;
+    in_results_ptr = (ResourceCoordinationResults *)in_results_wrapper_ptr->object_ptr;
+    pcs            = (PictureParentControlSet *)in_results_ptr->pcs_wrapper->object_ptr;
+    scs            = pcs->scs;
+
+    // Mariana : save enhanced picture ptr, move this from here
+    pcs->enhanced_unscaled_pic                    = pcs->enhanced_pic;
+    pcs->enhanced_unscaled_pic->is_16bit_pipeline = scs->is_16bit_pipeline;
+
+    // There is no need to do processing for overlay picture. Overlay and AltRef share the same
+    // results.
+    if (!pcs->is_overlay) {
+        input_pic = pcs->enhanced_pic;
+        {
+            // Padding for input pictures
+            svt_aom_pad_input_pictures(scs, input_pic);
+
+            // Pre processing operations performed on the input picture
+            svt_aom_picture_pre_processing_operations(pcs, scs);
+
+            if (input_pic->color_format >= EB_YUV422) {
+                // Jing: Do the conversion of 422/444=>420 here since it's multi-threaded kernel
+                //       Reuse the Y, only add cb/cr in the newly created buffer desc
+                //       NOTE: since denoise may change the src, so this part is after svt_aom_picture_pre_processing_operations()
+                pcs->chroma_downsampled_pic->buffer_y = input_pic->buffer_y;
+                svt_aom_down_sample_chroma(input_pic, pcs->chroma_downsampled_pic);
+            } else
+                pcs->chroma_downsampled_pic = input_pic;
+
+            //not passing through the DS pool, so 1/4 and 1/16 are not used
+            pcs->ds_pics.picture_ptr           = input_pic;
+            pcs->ds_pics.quarter_picture_ptr   = NULL;
+            pcs->ds_pics.sixteenth_picture_ptr = NULL;
+            pcs->ds_pics.picture_number        = pcs->picture_number;
+
+            // Original path
+            // Get PA ref, copy 8bit luma to pa_ref->input_padded_pic
+            pa_ref_obj_                 = (EbPaReferenceObject *)pcs->pa_ref_pic_wrapper->object_ptr;
+            pa_ref_obj_->picture_number = pcs->picture_number;
+            input_padded_pic            = (EbPictureBufferDesc *)pa_ref_obj_->input_padded_pic;
+
+            // 1/4 & 1/16 input picture downsampling through filtering
+            if (scs->down_sampling_method_me_search == ME_FILTERED_DOWNSAMPLED) {
+                svt_aom_downsample_filtering_input_picture(
+                    pcs,
+                    input_padded_pic,
+                    (EbPictureBufferDesc *)pa_ref_obj_->quarter_downsampled_picture_ptr,
+                    (EbPictureBufferDesc *)pa_ref_obj_->sixteenth_downsampled_picture_ptr);
+            } else {
+                svt_aom_downsample_decimation_input_picture(
+                    pcs,
+                    input_padded_pic,
+                    (EbPictureBufferDesc *)pa_ref_obj_->quarter_downsampled_picture_ptr,
+                    (EbPictureBufferDesc *)pa_ref_obj_->sixteenth_downsampled_picture_ptr);
             }
-            // Gathering statistics of input picture, including Variance Calculation, Histogram Bins
-            {
-                svt_aom_gathering_picture_statistics(
-                    scs, pcs, input_padded_pic, (EbPictureBufferDesc *)pa_ref_obj_->sixteenth_downsampled_picture_ptr);
+            svt_aom_generate_me_sum_4x1(pa_ref_obj_);
 
-                pa_ref_obj_->avg_luma = pcs->avg_luma;
-            }
-            // If running multi-threaded mode, perform SC detection in svt_aom_picture_analysis_kernel, else in svt_aom_picture_decision_kernel
-            if (scs->static_config.logical_processors != 1) {
-                if (scs->static_config.screen_content_mode == 2) { // auto detect
-                    // SC Detection is OFF for 4K and higher
-                    if (scs->input_resolution <= INPUT_SIZE_1080p_RANGE)
-                        svt_aom_is_screen_content(pcs);
-                    else
-                        pcs->sc_class0 = pcs->sc_class1 = pcs->sc_class2 = 0;
-
-                } else // off / on
-                    pcs->sc_class0 = pcs->sc_class1 = pcs->sc_class2 = scs->static_config.screen_content_mode;
-            }
+            pcs->ds_pics.quarter_picture_ptr   = pa_ref_obj_->quarter_downsampled_picture_ptr;
+            pcs->ds_pics.sixteenth_picture_ptr = pa_ref_obj_->sixteenth_downsampled_picture_ptr;
         }
-        // Get Empty Results Object
-        svt_get_empty_object(pa_ctx->picture_analysis_results_output_fifo_ptr, &out_results_wrapper);
+        // Gathering statistics of input picture, including Variance Calculation, Histogram Bins
+        {
+            svt_aom_gathering_picture_statistics(
+                scs, pcs, input_padded_pic, (EbPictureBufferDesc *)pa_ref_obj_->sixteenth_downsampled_picture_ptr);
 
-        PictureAnalysisResults *out_results = (PictureAnalysisResults *)out_results_wrapper->object_ptr;
-        out_results->pcs_wrapper            = in_results_ptr->pcs_wrapper;
+            pa_ref_obj_->avg_luma = pcs->avg_luma;
+        }
+        // If running multi-threaded mode, perform SC detection in svt_aom_picture_analysis_kernel, else in svt_aom_picture_decision_kernel
+        if (scs->static_config.logical_processors != 1) {
+            if (scs->static_config.screen_content_mode == 2) { // auto detect
+                // SC Detection is OFF for 4K and higher
+                if (scs->input_resolution <= INPUT_SIZE_1080p_RANGE)
+                    svt_aom_is_screen_content(pcs);
+                else
+                    pcs->sc_class0 = pcs->sc_class1 = pcs->sc_class2 = 0;
+
+            } else // off / on
+                pcs->sc_class0 = pcs->sc_class1 = pcs->sc_class2 = scs->static_config.screen_content_mode;
+        }
+    }
+    // Get Empty Results Object
+    svt_get_empty_object(pa_ctx->picture_analysis_results_output_fifo_ptr, &out_results_wrapper);
 
-        // Release the Input Results
-        svt_release_object(in_results_wrapper_ptr);
+    PictureAnalysisResults *out_results = (PictureAnalysisResults *)out_results_wrapper->object_ptr;
+    out_results->pcs_wrapper            = in_results_ptr->pcs_wrapper;
 
-        // Post the Full Results Object
-        svt_post_full_object(out_results_wrapper);
-    }
-    return NULL;
+    // Release the Input Results
+    svt_release_object(in_results_wrapper_ptr);
+
+    // Post the Full Results Object
+    svt_post_full_object(out_results_wrapper);
 }
@@ -95,8 +95,11 @@ void svt_aom_get_max_allocated_me_refs(uint8_t ref_count_used_list0, uint8_t ref
         (ref_count_used_list0 - 1) + (ref_count_used_list1 == 3 ? 1 : 0);
 }
 
-EbErrorType svt_aom_me_sb_results_ctor(MeSbResults *obj_ptr, PictureControlSetInitData *init_data_ptr) {
-    obj_ptr->dctor = me_sb_results_dctor;
+/*
+  The me results of an SB are released with arena when it is not NULL
+*/
+EbErrorType svt_aom_me_sb_results_ctor(MeSbResults *obj_ptr, EbArena *arena, PictureControlSetInitData *init_data_ptr) {
+    obj_ptr->dctor = arena ? NULL : me_sb_results_dctor;
 
     uint8_t max_ref_to_alloc, max_cand_to_alloc;
     svt_aom_get_max_allocated_me_refs(init_data_ptr->ref_count_used_list0,
@@ -111,6 +114,12 @@ EbErrorType svt_aom_me_sb_results_ctor(MeSbResults *obj_ptr, PictureControlSetIn
             : MAX_SB64_PU_COUNT_NO_8X8
         : MAX_SB64_PU_COUNT_WO_16X16;
 
+    if (arena) {
+        EB_ARENA_MALLOC_ARRAY(arena, obj_ptr->me_mv_array, number_of_pus * max_ref_to_alloc);
+        EB_ARENA_MALLOC_ARRAY(arena, obj_ptr->me_candidate_array, number_of_pus * max_cand_to_alloc);
+        EB_ARENA_MALLOC_ARRAY(arena, obj_ptr->total_me_candidate_index, number_of_pus);
+        return EB_ErrorNone;
+    }
     EB_MALLOC_ARRAY(obj_ptr->me_mv_array, number_of_pus * max_ref_to_alloc);
     EB_MALLOC_ARRAY(obj_ptr->me_candidate_array, number_of_pus * max_cand_to_alloc);
 
@@ -130,54 +139,12 @@ void recon_coef_dctor(EbPtr p) {
 static void picture_control_set_dctor(EbPtr p) {
     PictureControlSet *obj      = (PictureControlSet *)p;
     uint16_t           tile_cnt = obj->tile_row_count * obj->tile_column_count;
-    uint8_t            depth;
     svt_av1_hash_table_destroy(&obj->hash_table);
     EB_FREE_ALIGNED_ARRAY(obj->tpl_mvs);
     EB_DELETE_PTR_ARRAY(obj->enc_dec_segment_ctrl, tile_cnt);
-    EB_DELETE_PTR_ARRAY(obj->ep_luma_recon_na, tile_cnt);
-    EB_DELETE_PTR_ARRAY(obj->ep_cb_recon_na, tile_cnt);
-    EB_DELETE_PTR_ARRAY(obj->ep_cr_recon_na, tile_cnt);
-    EB_DELETE_PTR_ARRAY(obj->ep_luma_dc_sign_level_coeff_na, tile_cnt);
-    EB_DELETE_PTR_ARRAY(obj->ep_cb_dc_sign_level_coeff_na, tile_cnt);
-    EB_DELETE_PTR_ARRAY(obj->ep_cr_dc_sign_level_coeff_na, tile_cnt);
-    EB_DELETE_PTR_ARRAY(obj->ep_luma_dc_sign_level_coeff_na_update, tile_cnt);
-    EB_DELETE_PTR_ARRAY(obj->ep_cb_dc_sign_level_coeff_na_update, tile_cnt);
-    EB_DELETE_PTR_ARRAY(obj->ep_cr_dc_sign_level_coeff_na_update, tile_cnt);
-    EB_DELETE_PTR_ARRAY(obj->partition_context_na, tile_cnt);
-    EB_DELETE_PTR_ARRAY(obj->luma_dc_sign_level_coeff_na, tile_cnt);
-    EB_DELETE_PTR_ARRAY(obj->cr_dc_sign_level_coeff_na, tile_cnt);
-    EB_DELETE_PTR_ARRAY(obj->cb_dc_sign_level_coeff_na, tile_cnt);
-    EB_DELETE_PTR_ARRAY(obj->txfm_context_array, tile_cnt);
-    EB_DELETE_PTR_ARRAY(obj->segmentation_id_pred_array, tile_cnt);
     EB_DELETE(obj->segmentation_neighbor_map); // Jing, double check here
-    EB_DELETE_PTR_ARRAY(obj->ep_luma_recon_na_16bit, tile_cnt);
-    EB_DELETE_PTR_ARRAY(obj->ep_cb_recon_na_16bit, tile_cnt);
-    EB_DELETE_PTR_ARRAY(obj->ep_cr_recon_na_16bit, tile_cnt);
-    // EB_DELETE(obj->ep_partition_context_na); //Jing: Double check here
-    EB_DELETE_PTR_ARRAY(obj->ep_partition_context_na, tile_cnt);
-    EB_DELETE_PTR_ARRAY(obj->ep_txfm_context_na, tile_cnt);
-
-    for (depth = 0; depth < NA_TOT_CNT; depth++) {
-        EB_DELETE_PTR_ARRAY(obj->mdleaf_partition_na[depth], tile_cnt);
-
-        EB_DELETE_PTR_ARRAY(obj->md_luma_recon_na_16bit[depth], tile_cnt);
-        EB_DELETE_PTR_ARRAY(obj->md_tx_depth_1_luma_recon_na_16bit[depth], tile_cnt);
-        EB_DELETE_PTR_ARRAY(obj->md_tx_depth_2_luma_recon_na_16bit[depth], tile_cnt);
-        EB_DELETE_PTR_ARRAY(obj->md_cb_recon_na_16bit[depth], tile_cnt);
-        EB_DELETE_PTR_ARRAY(obj->md_cr_recon_na_16bit[depth], tile_cnt);
-
-        EB_DELETE_PTR_ARRAY(obj->md_luma_recon_na[depth], tile_cnt);
-        EB_DELETE_PTR_ARRAY(obj->md_tx_depth_1_luma_recon_na[depth], tile_cnt);
-        EB_DELETE_PTR_ARRAY(obj->md_tx_depth_2_luma_recon_na[depth], tile_cnt);
-        EB_DELETE_PTR_ARRAY(obj->md_cb_recon_na[depth], tile_cnt);
-        EB_DELETE_PTR_ARRAY(obj->md_cr_recon_na[depth], tile_cnt);
-
-        EB_DELETE_PTR_ARRAY(obj->md_y_dcs_na[depth], tile_cnt);
-        EB_DELETE_PTR_ARRAY(obj->md_tx_depth_1_luma_dc_sign_level_coeff_na[depth], tile_cnt);
-        EB_DELETE_PTR_ARRAY(obj->md_cr_dc_sign_level_coeff_na[depth], tile_cnt);
-        EB_DELETE_PTR_ARRAY(obj->md_cb_dc_sign_level_coeff_na[depth], tile_cnt);
-        EB_DELETE_PTR_ARRAY(obj->md_txfm_context_array[depth], tile_cnt);
-    }
+    // All the neighbor arrays
+    EB_DELETE(obj->na_arena);
     EB_DELETE_PTR_ARRAY(obj->sb_ptr_array, obj->sb_total_count_unscaled);
     EB_FREE_ARRAY(obj->sb_intra);
     EB_FREE_ARRAY(obj->sb_skip);
@@ -210,6 +177,8 @@ static void picture_control_set_dctor(EbPtr p) {
     EB_DESTROY_MUTEX(obj->entropy_coding_pic_mutex);
     EB_DESTROY_MUTEX(obj->intra_mutex);
     EB_DESTROY_MUTEX(obj->cdef_search_mutex);
+    EB_DESTROY_MUTEX(obj->cdef_row_sync_mutex);
+    EB_FREE_ARRAY(obj->enc_dec_row_coded_sb_count);
     EB_DESTROY_MUTEX(obj->rest_search_mutex);
 }
 
@@ -224,16 +193,18 @@ typedef struct InitData {
 } InitData;
 
 #define DIM(array) (sizeof(array) / sizeof(array[0]))
-static EbErrorType create_neighbor_array_units(InitData *data, size_t count) {
+static EbErrorType create_neighbor_array_units(EbArena *arena, InitData *data, size_t count) {
     for (size_t i = 0; i < count; i++) {
-        EB_NEW(*data[i].na_unit_dbl_ptr,
-               svt_aom_neighbor_array_unit_ctor,
-               data[i].max_picture_width,
-               data[i].max_picture_height,
-               data[i].unit_size,
-               data[i].granularity_normal,
-               data[i].granularity_top_left,
-               data[i].type_mask);
+        EB_ARENA_NEW(arena,
+                     *data[i].na_unit_dbl_ptr,
+                     svt_aom_neighbor_array_unit_ctor,
+                     arena,
+                     data[i].max_picture_width,
+                     data[i].max_picture_height,
+                     data[i].unit_size,
+                     data[i].granularity_normal,
+                     data[i].granularity_top_left,
+                     data[i].type_mask);
     }
     return EB_ErrorNone;
 }
@@ -562,6 +533,7 @@ static EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr
                (uint16_t)sb_index,
                init_data_ptr->enc_mode,
                init_data_ptr->init_max_block_cnt,
+               init_data_ptr->recode_reuse_md,
                object_ptr);
         // Increment the Order in coding order (Raster Scan Order)
         sb_origin_y = (sb_origin_x == picture_sb_w - 1) ? sb_origin_y + 1 : sb_origin_y;
@@ -575,27 +547,29 @@ static EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr
     else
         object_ptr->hbd_md = init_data_ptr->hbd_md;
     // Mode Decision Neighbor Arrays
-    uint8_t depth;
+    EB_NEW(object_ptr->na_arena, svt_arena_ctor, init_data_ptr->na_arena_stats, ARENA_DEFAULT_BLOCK_SIZE);
+    EbArena *na_arena = object_ptr->na_arena;
+    uint8_t  depth;
     for (depth = 0; depth < NA_TOT_CNT; depth++) {
-        EB_ALLOC_PTR_ARRAY(object_ptr->mdleaf_partition_na[depth], total_tile_cnt);
-        EB_ALLOC_PTR_ARRAY(object_ptr->md_y_dcs_na[depth], total_tile_cnt);
-        EB_ALLOC_PTR_ARRAY(object_ptr->md_tx_depth_1_luma_dc_sign_level_coeff_na[depth], total_tile_cnt);
-        EB_ALLOC_PTR_ARRAY(object_ptr->md_cr_dc_sign_level_coeff_na[depth], total_tile_cnt);
-        EB_ALLOC_PTR_ARRAY(object_ptr->md_cb_dc_sign_level_coeff_na[depth], total_tile_cnt);
-        EB_ALLOC_PTR_ARRAY(object_ptr->md_txfm_context_array[depth], total_tile_cnt);
+        EB_ARENA_CALLOC_ARRAY(na_arena, object_ptr->mdleaf_partition_na[depth], total_tile_cnt);
+        EB_ARENA_CALLOC_ARRAY(na_arena, object_ptr->md_y_dcs_na[depth], total_tile_cnt);
+        EB_ARENA_CALLOC_ARRAY(na_arena, object_ptr->md_tx_depth_1_luma_dc_sign_level_coeff_na[depth], total_tile_cnt);
+        EB_ARENA_CALLOC_ARRAY(na_arena, object_ptr->md_cr_dc_sign_level_coeff_na[depth], total_tile_cnt);
+        EB_ARENA_CALLOC_ARRAY(na_arena, object_ptr->md_cb_dc_sign_level_coeff_na[depth], total_tile_cnt);
+        EB_ARENA_CALLOC_ARRAY(na_arena, object_ptr->md_txfm_context_array[depth], total_tile_cnt);
         if (init_data_ptr->hbd_md != EB_10_BIT_MD) {
-            EB_ALLOC_PTR_ARRAY(object_ptr->md_luma_recon_na[depth], total_tile_cnt);
-            EB_ALLOC_PTR_ARRAY(object_ptr->md_tx_depth_1_luma_recon_na[depth], total_tile_cnt);
-            EB_ALLOC_PTR_ARRAY(object_ptr->md_tx_depth_2_luma_recon_na[depth], total_tile_cnt);
-            EB_ALLOC_PTR_ARRAY(object_ptr->md_cb_recon_na[depth], total_tile_cnt);
-            EB_ALLOC_PTR_ARRAY(object_ptr->md_cr_recon_na[depth], total_tile_cnt);
+            EB_ARENA_CALLOC_ARRAY(na_arena, object_ptr->md_luma_recon_na[depth], total_tile_cnt);
+            EB_ARENA_CALLOC_ARRAY(na_arena, object_ptr->md_tx_depth_1_luma_recon_na[depth], total_tile_cnt);
+            EB_ARENA_CALLOC_ARRAY(na_arena, object_ptr->md_tx_depth_2_luma_recon_na[depth], total_tile_cnt);
+            EB_ARENA_CALLOC_ARRAY(na_arena, object_ptr->md_cb_recon_na[depth], total_tile_cnt);
+            EB_ARENA_CALLOC_ARRAY(na_arena, object_ptr->md_cr_recon_na[depth], total_tile_cnt);
         }
         if (init_data_ptr->hbd_md > EB_8_BIT_MD) {
-            EB_ALLOC_PTR_ARRAY(object_ptr->md_luma_recon_na_16bit[depth], total_tile_cnt);
-            EB_ALLOC_PTR_ARRAY(object_ptr->md_tx_depth_1_luma_recon_na_16bit[depth], total_tile_cnt);
-            EB_ALLOC_PTR_ARRAY(object_ptr->md_tx_depth_2_luma_recon_na_16bit[depth], total_tile_cnt);
-            EB_ALLOC_PTR_ARRAY(object_ptr->md_cb_recon_na_16bit[depth], total_tile_cnt);
-            EB_ALLOC_PTR_ARRAY(object_ptr->md_cr_recon_na_16bit[depth], total_tile_cnt);
+            EB_ARENA_CALLOC_ARRAY(na_arena, object_ptr->md_luma_recon_na_16bit[depth], total_tile_cnt);
+            EB_ARENA_CALLOC_ARRAY(na_arena, object_ptr->md_tx_depth_1_luma_recon_na_16bit[depth], total_tile_cnt);
+            EB_ARENA_CALLOC_ARRAY(na_arena, object_ptr->md_tx_depth_2_luma_recon_na_16bit[depth], total_tile_cnt);
+            EB_ARENA_CALLOC_ARRAY(na_arena, object_ptr->md_cb_recon_na_16bit[depth], total_tile_cnt);
+            EB_ARENA_CALLOC_ARRAY(na_arena, object_ptr->md_cr_recon_na_16bit[depth], total_tile_cnt);
         }
     }
 
@@ -664,7 +638,7 @@ static EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr
                     NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
                 },
             };
-            return_error = create_neighbor_array_units(data0, DIM(data0));
+            return_error = create_neighbor_array_units(na_arena, data0, DIM(data0));
             if (return_error == EB_ErrorInsufficientResources)
                 return EB_ErrorInsufficientResources;
             if (init_data_ptr->hbd_md != EB_10_BIT_MD) {
@@ -717,7 +691,7 @@ static EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr
                     }
 
                 };
-                return_error = create_neighbor_array_units(data, DIM(data));
+                return_error = create_neighbor_array_units(na_arena, data, DIM(data));
                 if (return_error == EB_ErrorInsufficientResources)
                     return EB_ErrorInsufficientResources;
             }
@@ -767,7 +741,7 @@ static EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr
                                        SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
                                        NEIGHBOR_ARRAY_UNIT_FULL_MASK,
                                    }};
-                return_error    = create_neighbor_array_units(data, DIM(data));
+                return_error    = create_neighbor_array_units(na_arena, data, DIM(data));
                 if (return_error == EB_ErrorInsufficientResources)
                     return EB_ErrorInsufficientResources;
             }
@@ -775,28 +749,28 @@ static EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr
     }
     // EncDec Neighbor
     //EncDec
-    EB_ALLOC_PTR_ARRAY(object_ptr->ep_luma_recon_na, total_tile_cnt);
-    EB_ALLOC_PTR_ARRAY(object_ptr->ep_cb_recon_na, total_tile_cnt);
-    EB_ALLOC_PTR_ARRAY(object_ptr->ep_cr_recon_na, total_tile_cnt);
-    EB_ALLOC_PTR_ARRAY(object_ptr->ep_luma_dc_sign_level_coeff_na, total_tile_cnt);
-    EB_ALLOC_PTR_ARRAY(object_ptr->ep_cb_dc_sign_level_coeff_na, total_tile_cnt);
-    EB_ALLOC_PTR_ARRAY(object_ptr->ep_cr_dc_sign_level_coeff_na, total_tile_cnt);
-    EB_ALLOC_PTR_ARRAY(object_ptr->ep_luma_dc_sign_level_coeff_na_update, total_tile_cnt);
-    EB_ALLOC_PTR_ARRAY(object_ptr->ep_cb_dc_sign_level_coeff_na_update, total_tile_cnt);
-    EB_ALLOC_PTR_ARRAY(object_ptr->ep_cr_dc_sign_level_coeff_na_update, total_tile_cnt);
-    EB_ALLOC_PTR_ARRAY(object_ptr->ep_partition_context_na, total_tile_cnt);
-    EB_ALLOC_PTR_ARRAY(object_ptr->ep_txfm_context_na, total_tile_cnt);
+    EB_ARENA_CALLOC_ARRAY(na_arena, object_ptr->ep_luma_recon_na, total_tile_cnt);
+    EB_ARENA_CALLOC_ARRAY(na_arena, object_ptr->ep_cb_recon_na, total_tile_cnt);
+    EB_ARENA_CALLOC_ARRAY(na_arena, object_ptr->ep_cr_recon_na, total_tile_cnt);
+    EB_ARENA_CALLOC_ARRAY(na_arena, object_ptr->ep_luma_dc_sign_level_coeff_na, total_tile_cnt);
+    EB_ARENA_CALLOC_ARRAY(na_arena, object_ptr->ep_cb_dc_sign_level_coeff_na, total_tile_cnt);
+    EB_ARENA_CALLOC_ARRAY(na_arena, object_ptr->ep_cr_dc_sign_level_coeff_na, total_tile_cnt);
+    EB_ARENA_CALLOC_ARRAY(na_arena, object_ptr->ep_luma_dc_sign_level_coeff_na_update, total_tile_cnt);
+    EB_ARENA_CALLOC_ARRAY(na_arena, object_ptr->ep_cb_dc_sign_level_coeff_na_update, total_tile_cnt);
+    EB_ARENA_CALLOC_ARRAY(na_arena, object_ptr->ep_cr_dc_sign_level_coeff_na_update, total_tile_cnt);
+    EB_ARENA_CALLOC_ARRAY(na_arena, object_ptr->ep_partition_context_na, total_tile_cnt);
+    EB_ARENA_CALLOC_ARRAY(na_arena, object_ptr->ep_txfm_context_na, total_tile_cnt);
     // Entropy
-    EB_ALLOC_PTR_ARRAY(object_ptr->partition_context_na, total_tile_cnt);
-    EB_ALLOC_PTR_ARRAY(object_ptr->luma_dc_sign_level_coeff_na, total_tile_cnt);
-    EB_ALLOC_PTR_ARRAY(object_ptr->cr_dc_sign_level_coeff_na, total_tile_cnt);
-    EB_ALLOC_PTR_ARRAY(object_ptr->cb_dc_sign_level_coeff_na, total_tile_cnt);
-    EB_ALLOC_PTR_ARRAY(object_ptr->txfm_context_array, total_tile_cnt);
-    EB_ALLOC_PTR_ARRAY(object_ptr->segmentation_id_pred_array, total_tile_cnt);
+    EB_ARENA_CALLOC_ARRAY(na_arena, object_ptr->partition_context_na, total_tile_cnt);
+    EB_ARENA_CALLOC_ARRAY(na_arena, object_ptr->luma_dc_sign_level_coeff_na, total_tile_cnt);
+    EB_ARENA_CALLOC_ARRAY(na_arena, object_ptr->cr_dc_sign_level_coeff_na, total_tile_cnt);
+    EB_ARENA_CALLOC_ARRAY(na_arena, object_ptr->cb_dc_sign_level_coeff_na, total_tile_cnt);
+    EB_ARENA_CALLOC_ARRAY(na_arena, object_ptr->txfm_context_array, total_tile_cnt);
+    EB_ARENA_CALLOC_ARRAY(na_arena, object_ptr->segmentation_id_pred_array, total_tile_cnt);
     if ((is_16bit) || (init_data_ptr->is_16bit_pipeline)) {
-        EB_ALLOC_PTR_ARRAY(object_ptr->ep_luma_recon_na_16bit, total_tile_cnt);
-        EB_ALLOC_PTR_ARRAY(object_ptr->ep_cb_recon_na_16bit, total_tile_cnt);
-        EB_ALLOC_PTR_ARRAY(object_ptr->ep_cr_recon_na_16bit, total_tile_cnt);
+        EB_ARENA_CALLOC_ARRAY(na_arena, object_ptr->ep_luma_recon_na_16bit, total_tile_cnt);
+        EB_ARENA_CALLOC_ARRAY(na_arena, object_ptr->ep_cb_recon_na_16bit, total_tile_cnt);
+        EB_ARENA_CALLOC_ARRAY(na_arena, object_ptr->ep_cr_recon_na_16bit, total_tile_cnt);
     }
 
     for (tile_idx = 0; tile_idx < total_tile_cnt; tile_idx++) {
@@ -968,7 +942,7 @@ static EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr
                 NEIGHBOR_ARRAY_UNIT_FULL_MASK,
             },
         };
-        return_error = create_neighbor_array_units(data0, DIM(data0));
+        return_error = create_neighbor_array_units(na_arena, data0, DIM(data0));
         if (return_error == EB_ErrorInsufficientResources)
             return EB_ErrorInsufficientResources;
 
@@ -1002,7 +976,7 @@ static EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr
                     NEIGHBOR_ARRAY_UNIT_FULL_MASK,
                 },
             };
-            return_error = create_neighbor_array_units(data, DIM(data));
+            return_error = create_neighbor_array_units(na_arena, data, DIM(data));
             if (return_error == EB_ErrorInsufficientResources)
                 return EB_ErrorInsufficientResources;
         } else {
@@ -1034,6 +1008,9 @@ static EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr
     EB_CREATE_MUTEX(object_ptr->intra_mutex);
 
     EB_CREATE_MUTEX(object_ptr->cdef_search_mutex);
+    EB_CREATE_MUTEX(object_ptr->cdef_row_sync_mutex);
+    // sized in 64x64 rows, an upper bound of the SB rows
+    EB_MALLOC_ARRAY(object_ptr->enc_dec_row_coded_sb_count, picture_sb_height);
 
     //object_ptr->mse_seg[0] = (uint64_t(*)[64])svt_aom_malloc(sizeof(**object_ptr->mse_seg) *  picture_sb_width * picture_sb_height);
     // object_ptr->mse_seg[1] = (uint64_t(*)[64])svt_aom_malloc(sizeof(**object_ptr->mse_seg) *  picture_sb_width * picture_sb_height);
@@ -1179,8 +1156,6 @@ static void picture_parent_control_set_dctor(EbPtr ptr) {
     EB_DESTROY_MUTEX(obj->pcs_total_rate_mutex);
     if (obj->dg_detector)
         EB_DELETE(obj->dg_detector);
-    EB_DELETE(obj->quarter_src_pic);
-    EB_DELETE(obj->sixteenth_src_pic);
 }
 /*
 ppcs_update_param: update the parameters in PictureParentControlSet for changing the resolution on the fly
@@ -1222,34 +1197,6 @@ EbErrorType ppcs_update_param(PictureParentControlSet *ppcs) {
     ppcs->render_width   = scs->max_input_luma_width;
     ppcs->render_height  = scs->max_input_luma_height;
 
-    if (svt_aom_need_gm_ref_info(scs->static_config.enc_mode, scs->static_config.resize_mode == RESIZE_NONE)) {
-        EbPictureBufferDescInitData input_pic_buf_desc_init_data;
-        input_pic_buf_desc_init_data.max_width          = scs->max_input_luma_width >> 1;
-        input_pic_buf_desc_init_data.max_height         = scs->max_input_luma_height >> 1;
-        input_pic_buf_desc_init_data.bit_depth          = 8; //Should be 8bit
-        input_pic_buf_desc_init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_LUMA_MASK;
-        input_pic_buf_desc_init_data.left_padding       = 32;
-        input_pic_buf_desc_init_data.right_padding      = 32;
-        input_pic_buf_desc_init_data.top_padding        = 32;
-        input_pic_buf_desc_init_data.bot_padding        = 32;
-        input_pic_buf_desc_init_data.color_format       = EB_YUV420;
-        input_pic_buf_desc_init_data.split_mode         = FALSE;
-
-        svt_picture_buffer_desc_update(ppcs->quarter_src_pic, (EbPtr)(&input_pic_buf_desc_init_data));
-
-        input_pic_buf_desc_init_data.max_width          = scs->max_input_luma_width >> 2;
-        input_pic_buf_desc_init_data.max_height         = scs->max_input_luma_height >> 2;
-        input_pic_buf_desc_init_data.bit_depth          = 8; //Should be 8bit
-        input_pic_buf_desc_init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_LUMA_MASK;
-        input_pic_buf_desc_init_data.left_padding       = 16;
-        input_pic_buf_desc_init_data.right_padding      = 16;
-        input_pic_buf_desc_init_data.top_padding        = 16;
-        input_pic_buf_desc_init_data.bot_padding        = 16;
-        input_pic_buf_desc_init_data.color_format       = EB_YUV420;
-        input_pic_buf_desc_init_data.split_mode         = FALSE;
-
-        svt_picture_buffer_desc_update(ppcs->sixteenth_src_pic, (EbPtr)(&input_pic_buf_desc_init_data));
-    }
 
     return return_error;
 }
@@ -1424,40 +1371,12 @@ static EbErrorType picture_parent_control_set_ctor(PictureParentControlSet *obje
         : 0;
     EB_NEW(object_ptr->dg_detector, svt_aom_dg_detector_seg_ctor);
 
-    if (svt_aom_need_gm_ref_info(init_data_ptr->enc_mode, init_data_ptr->static_config.resize_mode == RESIZE_NONE)) {
-        EbPictureBufferDescInitData input_pic_buf_desc_init_data;
-        input_pic_buf_desc_init_data.max_width          = init_data_ptr->picture_width >> 1;
-        input_pic_buf_desc_init_data.max_height         = init_data_ptr->picture_height >> 1;
-        input_pic_buf_desc_init_data.bit_depth          = 8; //Should be 8bit
-        input_pic_buf_desc_init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_LUMA_MASK;
-        input_pic_buf_desc_init_data.left_padding       = 32;
-        input_pic_buf_desc_init_data.right_padding      = 32;
-        input_pic_buf_desc_init_data.top_padding        = 32;
-        input_pic_buf_desc_init_data.bot_padding        = 32;
-        input_pic_buf_desc_init_data.color_format       = EB_YUV420;
-        input_pic_buf_desc_init_data.split_mode         = FALSE;
-
-        EB_NEW(object_ptr->quarter_src_pic, svt_picture_buffer_desc_ctor, (EbPtr)(&input_pic_buf_desc_init_data));
-
-        input_pic_buf_desc_init_data.max_width          = init_data_ptr->picture_width >> 2;
-        input_pic_buf_desc_init_data.max_height         = init_data_ptr->picture_height >> 2;
-        input_pic_buf_desc_init_data.bit_depth          = 8; //Should be 8bit
-        input_pic_buf_desc_init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_LUMA_MASK;
-        input_pic_buf_desc_init_data.left_padding       = 16;
-        input_pic_buf_desc_init_data.right_padding      = 16;
-        input_pic_buf_desc_init_data.top_padding        = 16;
-        input_pic_buf_desc_init_data.bot_padding        = 16;
-        input_pic_buf_desc_init_data.color_format       = EB_YUV420;
-        input_pic_buf_desc_init_data.split_mode         = FALSE;
-
-        EB_NEW(object_ptr->sixteenth_src_pic, svt_picture_buffer_desc_ctor, (EbPtr)(&input_pic_buf_desc_init_data));
-    }
 
     return return_error;
 }
 static void me_dctor(EbPtr p) {
     MotionEstimationData *obj = (MotionEstimationData *)p;
-    EB_DELETE_PTR_ARRAY(obj->me_results, obj->init_b64_total_count);
+    EB_DELETE(obj->arena);
     if (obj->ois_mb_results)
         EB_FREE_2D(obj->ois_mb_results);
     if (obj->tpl_stats)
@@ -1496,10 +1415,16 @@ static EbErrorType me_ctor(MotionEstimationData *object_ptr, EbPtr object_init_d
     object_ptr->b64_total_count      = sb_total_count;
     object_ptr->init_b64_total_count = sb_total_count;
 
-    EB_ALLOC_PTR_ARRAY(object_ptr->me_results, sb_total_count);
+    // The per SB results are many small buffers, all taken from one arena
+    EB_NEW(object_ptr->arena, svt_arena_ctor, init_data_ptr->me_arena_stats, ARENA_DEFAULT_BLOCK_SIZE);
+    EB_ARENA_MALLOC_ARRAY(object_ptr->arena, object_ptr->me_results, sb_total_count);
 
     for (sb_index = 0; sb_index < sb_total_count; ++sb_index) {
-        EB_NEW(object_ptr->me_results[sb_index], svt_aom_me_sb_results_ctor, init_data_ptr);
+        EB_ARENA_NEW(object_ptr->arena,
+                     object_ptr->me_results[sb_index],
+                     svt_aom_me_sb_results_ctor,
+                     object_ptr->arena,
+                     init_data_ptr);
     }
 
     if (init_data_ptr->enable_tpl_la) {
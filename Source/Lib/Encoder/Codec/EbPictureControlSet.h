@@ -25,6 +25,7 @@
 #include "EbEncDecSegments.h"
 #include "EbRestoration.h"
 #include "EbObject.h"
+#include "EbArena.h"
 #include "noise_model.h"
 #include "EbSegmentationParams.h"
 #include "EbAv1Structs.h"
@@ -254,6 +255,11 @@ typedef struct PictureControlSet {
     EbHandle          entropy_coding_pic_mutex;
     Bool              entropy_coding_pic_reset_flag;
     uint8_t           tile_size_bytes_minus_1;
+    // Tile group output: leading tiles returned in partial packets as they are coded
+    Bool              tile_group_output;
+    Bool              tile_group_output_closed;
+    uint16_t          tile_group_output_count;
+    uint32_t          tile_group_output_bytes;
     EbHandle          intra_mutex;
     uint32_t          intra_coded_area;
     uint64_t          skip_coded_area;
@@ -264,6 +270,12 @@ typedef struct PictureControlSet {
     uint16_t cdef_segments_total_count;
     uint8_t  cdef_segments_column_count;
     uint8_t  cdef_segments_row_count;
+    // SB row pipelining: the enc-dec posts the CDEF segments as the SB rows they read are final
+    Bool      cdef_row_sync;
+    EbHandle  cdef_row_sync_mutex;
+    uint16_t *enc_dec_row_coded_sb_count; // coded SBs per SB row
+    uint16_t  enc_dec_coded_sb_rows; // leading SB rows fully coded
+    uint16_t  cdef_row_sync_posted_rows; // leading CDEF segment rows posted
 
     uint64_t (*mse_seg[2])[TOTAL_STRENGTHS];
     uint8_t     *skip_cdef_seg;
@@ -295,8 +307,10 @@ typedef struct PictureControlSet {
     uint8_t     *sb_64x64_mvp;
     uint32_t    *sb_count_nz_coeffs;
     // qindex per 64x64 using ME distortions (to be used for lambda modulation only; not at Q/Q-1)
-    // Mode Decision Neighbor Arrays
     uint8_t            *b64_me_qindex;
+    // Owns all the neighbor arrays below, released at once with the pcs
+    EbArena            *na_arena;
+    // Mode Decision Neighbor Arrays
     NeighborArrayUnit **md_luma_recon_na[NA_TOT_CNT];
     NeighborArrayUnit **md_tx_depth_1_luma_recon_na[NA_TOT_CNT];
     NeighborArrayUnit **md_tx_depth_2_luma_recon_na[NA_TOT_CNT];
@@ -388,6 +402,10 @@ typedef struct PictureControlSet {
     uint8_t          pic_lpd0_lvl; // lpd0_lvl signal set at the picture level
     uint8_t          pic_lpd1_lvl; // lpd1_lvl signal set at the picture level
     Bool             pic_bypass_encdec;
+    // The current encoding of the frame is a recode replaying the mode decision saved in the SBs (no PD0/PD1)
+    uint8_t          recode_reuse_md;
+    // base_q_idx of the last encoding of the frame that ran the mode decision
+    uint8_t          recode_md_qindex;
     EncMode          enc_mode;
     InputCoeffLvl    coeff_lvl;
     int32_t          cdef_preset[MAX_TILE_CNTS][4];
@@ -486,6 +504,7 @@ typedef struct TileGroupInfo {
 } TileGroupInfo;
 typedef struct MotionEstimationData {
     EbDctor        dctor;
+    EbArena       *arena; // owns me_results
     MeSbResults  **me_results;
     uint16_t       b64_total_count;
     uint16_t       init_b64_total_count;
@@ -803,8 +822,9 @@ typedef struct PictureParentControlSet {
     double                                  luma_ssim;
     double                                  cr_ssim;
     double                                  cb_ssim;
-    EbPictureBufferDesc                    *quarter_src_pic;
-    EbPictureBufferDesc                    *sixteenth_src_pic;
+    // PA reference object and 8 bit luma held for the global motion ref info, until handed to the reference object
+    EbObjectWrapper                        *gm_pa_ref_wrapper;
+    EbObjectWrapper                        *gm_y8b_wrapper;
     // Pointer array for down scaled pictures
     EbObjectWrapper            *downscaled_pic_wrapper;
     EbDownScaledBufDescPtrArray ds_pics;
@@ -1189,6 +1209,7 @@ typedef struct PictureControlSetInitData {
     uint32_t   rate_control_mode;
     Av1Common *av1_cm;
     uint16_t   init_max_block_cnt;
+    uint8_t    recode_reuse_md; // allocate the SB storage of the mode decision replayed by a recode
     uint8_t    ref_count_used_list0;
     uint8_t    ref_count_used_list1;
 
@@ -1200,6 +1221,9 @@ typedef struct PictureControlSetInitData {
     uint8_t calculate_variance;
     Bool    is_scale;
     bool    rtc_tune;
+    // Statistics of the neighbor array and ME results arenas of the pool
+    EbArenaStats *na_arena_stats;
+    EbArenaStats *me_arena_stats;
 } PictureControlSetInitData;
 
 typedef struct Av1Comp {
@@ -1216,7 +1240,7 @@ EbErrorType svt_aom_picture_control_set_creator(EbPtr *object_dbl_ptr, EbPtr obj
 EbErrorType svt_aom_recon_coef_creator(EbPtr *object_dbl_ptr, EbPtr object_init_data_ptr);
 EbErrorType svt_aom_picture_parent_control_set_creator(EbPtr *object_dbl_ptr, EbPtr object_init_data_ptr);
 EbErrorType svt_aom_me_creator(EbPtr *object_dbl_ptr, EbPtr object_init_data_ptr);
-EbErrorType svt_aom_me_sb_results_ctor(MeSbResults *obj_ptr, PictureControlSetInitData *init_data_ptr);
+EbErrorType svt_aom_me_sb_results_ctor(MeSbResults *obj_ptr, EbArena *arena, PictureControlSetInitData *init_data_ptr);
 EbErrorType ppcs_update_param(PictureParentControlSet *ppcs);
 EbErrorType pcs_update_param(PictureControlSet *pcs);
 EbErrorType me_update_param(MotionEstimationData *me_data, struct SequenceControlSet *scs);
@@ -2738,6 +2738,7 @@ static void  av1_generate_rps_info(
                 (EbPictureBufferDesc*)pa_ref_obj_->quarter_downsampled_picture_ptr,
                 (EbPictureBufferDesc*)pa_ref_obj_->sixteenth_downsampled_picture_ptr);
         }
+        svt_aom_generate_me_sum_4x1(pa_ref_obj_);
         // Gathering statistics of input picture, including Variance Calculation, Histogram Bins
         svt_aom_gathering_picture_statistics(
             scs,
@@ -3534,6 +3535,18 @@ static void send_picture_out(
     bool super_res_off = pcs->frame_superres_enabled == FALSE &&
         scs->static_config.resize_mode == RESIZE_NONE;
     svt_aom_set_gm_controls(pcs, svt_aom_derive_gm_level(pcs, super_res_off));
+    // Keep the source planes of the reference pictures for the global motion of the pictures referencing them;
+    // handed to the reference object at EncDec, released with it
+    pcs->gm_pa_ref_wrapper = NULL;
+    pcs->gm_y8b_wrapper    = NULL;
+    if (pcs->is_ref && pcs->gm_ctrls.enabled && pcs->gm_ctrls.use_ref_info) {
+        pcs->gm_pa_ref_wrapper = pcs->pa_ref_pic_wrapper;
+        svt_object_inc_live_count(pcs->gm_pa_ref_wrapper, 1);
+        if (pcs->y8b_wrapper) {
+            pcs->gm_y8b_wrapper = pcs->y8b_wrapper;
+            svt_object_inc_live_count(pcs->gm_y8b_wrapper, 1);
+        }
+    }
     pcs->me_processed_b64_count = 0;
 
     // NB: overlay frames should be non-ref
@@ -204,6 +204,12 @@ void svt_aom_init_enc_dec_segement(PictureParentControlSet *ppcs) {
             ppcs->child_pcs->entropy_coding_pic_reset_flag = TRUE;
         }
     }
+    // Frames going through the super-resolution recode loop are entropy coded more than once
+    ppcs->child_pcs->tile_group_output = scs->static_config.enable_tile_group_output && tile_cols * tile_rows > 1 &&
+        ppcs->superres_total_recode_loop == 0;
+    ppcs->child_pcs->tile_group_output_closed = FALSE;
+    ppcs->child_pcs->tile_group_output_count  = 0;
+    ppcs->child_pcs->tile_group_output_bytes  = 0;
 }
 
 void superres_setup_child_pcs(SequenceControlSet *entry_scs_ptr, PictureParentControlSet *entry_ppcs) {
@@ -235,6 +241,7 @@ void superres_setup_child_pcs(SequenceControlSet *entry_scs_ptr, PictureParentCo
                                              (uint16_t)sb_index,
                                              child_pcs->enc_mode,
                                              entry_scs_ptr->max_block_cnt,
+                                             entry_scs_ptr->recode_ctrls.reuse_md,
                                              child_pcs);
             // Increment the Order in coding order (Raster Scan Order)
             sb_origin_y = (sb_origin_x == pic_width_in_sb - 1) ? sb_origin_y + 1 : sb_origin_y;
@@ -567,7 +574,9 @@ void *svt_aom_picture_manager_kernel(void *input_ptr) {
                         if (entry_ppcs->is_ref) {
                             EbObjectWrapper *ref_pic_wrapper;
                             // Get Empty Reference Picture Object
-                            svt_get_empty_object(scs->enc_ctx->reference_picture_pool_fifo_ptr, &ref_pic_wrapper);
+                            svt_get_empty_picture_object(scs->enc_ctx->reference_picture_pool_fifo_ptr,
+                                                         entry_ppcs->picture_number,
+                                                         &ref_pic_wrapper);
                             entry_ppcs->ref_pic_wrapper = ref_pic_wrapper;
                             // reset reference object in case of its members are altered by superres
                             // tool
@@ -713,6 +722,7 @@ void *svt_aom_picture_manager_kernel(void *input_ptr) {
                                                                  (uint16_t)sb_index,
                                                                  child_pcs->enc_mode,
                                                                  scs->max_block_cnt,
+                                                                 scs->recode_ctrls.reuse_md,
                                                                  child_pcs);
                                 // Increment the Order in coding order (Raster Scan Order)
                                 sb_origin_y = (sb_origin_x == pic_width_in_sb - 1) ? sb_origin_y + 1 : sb_origin_y;
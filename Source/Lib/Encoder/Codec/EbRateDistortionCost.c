@@ -1634,6 +1634,7 @@ void svt_aom_full_cost(PictureControlSet *pcs, ModeDecisionContext *ctx, struct
     // Assign full cost
     *(cand_bf->full_cost) = mode_cost;
     cand_bf->total_rate   = mode_rate;
+    cand_bf->coeff_rate   = cand_bf->block_has_coeff ? *y_coeff_bits + *cb_coeff_bits + *cr_coeff_bits : 0;
     cand_bf->full_dist    = (uint32_t)mode_distortion;
     if (update_full_cost_ssim) {
         assert(ctx->pd_pass == PD_PASS_1);
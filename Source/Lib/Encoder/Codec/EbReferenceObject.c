@@ -87,9 +87,6 @@ static void svt_reference_object_dctor(EbPtr p) {
             EB_DESTROY_MUTEX(obj->resize_mutex[sr_denom_idx][resize_denom_idx]);
         }
     }
-    EB_DELETE(obj->quarter_reference_picture);
-    EB_DELETE(obj->sixteenth_reference_picture);
-    EB_DELETE(obj->input_picture);
     EB_DELETE(obj->quarter_input_picture);
     EB_DELETE(obj->sixteenth_input_picture);
 }
@@ -139,40 +136,6 @@ EbErrorType svt_reference_param_update(EbReferenceObject *ref_object, SequenceCo
         initialize_samples_neighboring_reference_picture(
             ref_object, &picture_buffer_desc_init_data_ptr, picture_buffer_desc_init_data_ptr.bit_depth);
     }
-    const bool gm_ref_info = svt_aom_need_gm_ref_info(scs->static_config.enc_mode,
-                                                      scs->static_config.resize_mode == RESIZE_NONE);
-    if (gm_ref_info)
-        svt_picture_buffer_desc_update(ref_object->input_picture, (EbPtr)&picture_buffer_desc_init_data_ptr);
-
-    if (gm_ref_info) {
-        EbPictureBufferDescInitData buf_desc;
-        buf_desc.max_width          = picture_buffer_desc_init_data_ptr.max_width >> 1;
-        buf_desc.max_height         = picture_buffer_desc_init_data_ptr.max_height >> 1;
-        buf_desc.bit_depth          = 8;
-        buf_desc.buffer_enable_mask = PICTURE_BUFFER_DESC_LUMA_MASK;
-        buf_desc.left_padding       = 32;
-        buf_desc.right_padding      = 32;
-        buf_desc.top_padding        = 32;
-        buf_desc.bot_padding        = 32;
-        buf_desc.color_format       = EB_YUV420;
-        buf_desc.split_mode         = FALSE;
-
-        svt_picture_buffer_desc_update(ref_object->quarter_reference_picture, (EbPtr)&buf_desc);
-
-        buf_desc.max_width          = picture_buffer_desc_init_data_ptr.max_width >> 2;
-        buf_desc.max_height         = picture_buffer_desc_init_data_ptr.max_height >> 2;
-        buf_desc.bit_depth          = 8;
-        buf_desc.buffer_enable_mask = PICTURE_BUFFER_DESC_LUMA_MASK;
-        buf_desc.left_padding       = 16;
-        buf_desc.right_padding      = 16;
-        buf_desc.top_padding        = 16;
-        buf_desc.bot_padding        = 16;
-        buf_desc.color_format       = EB_YUV420;
-        buf_desc.split_mode         = FALSE;
-
-        svt_picture_buffer_desc_update(ref_object->sixteenth_reference_picture, (EbPtr)&buf_desc);
-    }
-
     ref_object->mi_rows = ref_object->reference_picture->height >> MI_SIZE_LOG2;
     ref_object->mi_cols = ref_object->reference_picture->width >> MI_SIZE_LOG2;
     return EB_ErrorNone;
@@ -207,10 +170,6 @@ EbErrorType svt_reference_object_ctor(EbReferenceObject *ref_object, EbPtr objec
             ref_object, picture_buffer_desc_init_data_ptr, picture_buffer_desc_init_data_16bit_ptr.bit_depth);
     }
     ref_object->input_picture = NULL;
-    const bool gm_ref_info    = svt_aom_need_gm_ref_info(ref_init_ptr->static_config->enc_mode,
-                                                      ref_init_ptr->static_config->resize_mode == RESIZE_NONE);
-    if (gm_ref_info)
-        EB_NEW(ref_object->input_picture, svt_picture_buffer_desc_ctor, (EbPtr)picture_buffer_desc_init_data_ptr);
     uint32_t mi_rows = ref_object->reference_picture->height >> MI_SIZE_LOG2;
     uint32_t mi_cols = ref_object->reference_picture->width >> MI_SIZE_LOG2;
     // there should be one unit info per plane and per rest unit
@@ -223,34 +182,8 @@ EbErrorType svt_reference_object_ctor(EbReferenceObject *ref_object, EbPtr objec
     }
     ref_object->quarter_reference_picture   = NULL;
     ref_object->sixteenth_reference_picture = NULL;
-    if (gm_ref_info) {
-        EbPictureBufferDescInitData buf_desc;
-        buf_desc.max_width          = picture_buffer_desc_init_data_ptr->max_width >> 1;
-        buf_desc.max_height         = picture_buffer_desc_init_data_ptr->max_height >> 1;
-        buf_desc.bit_depth          = 8; //Should be 8bit
-        buf_desc.buffer_enable_mask = PICTURE_BUFFER_DESC_LUMA_MASK;
-        buf_desc.left_padding       = 32;
-        buf_desc.right_padding      = 32;
-        buf_desc.top_padding        = 32;
-        buf_desc.bot_padding        = 32;
-        buf_desc.color_format       = EB_YUV420;
-        buf_desc.split_mode         = FALSE;
-
-        EB_NEW(ref_object->quarter_reference_picture, svt_picture_buffer_desc_ctor, (EbPtr)&buf_desc);
-
-        buf_desc.max_width          = picture_buffer_desc_init_data_ptr->max_width >> 2;
-        buf_desc.max_height         = picture_buffer_desc_init_data_ptr->max_height >> 2;
-        buf_desc.bit_depth          = 8; //Should be 8bit
-        buf_desc.buffer_enable_mask = PICTURE_BUFFER_DESC_LUMA_MASK;
-        buf_desc.left_padding       = 16;
-        buf_desc.right_padding      = 16;
-        buf_desc.top_padding        = 16;
-        buf_desc.bot_padding        = 16;
-        buf_desc.color_format       = EB_YUV420;
-        buf_desc.split_mode         = FALSE;
-
-        EB_NEW(ref_object->sixteenth_reference_picture, svt_picture_buffer_desc_ctor, (EbPtr)&buf_desc);
-    }
+    ref_object->gm_pa_ref_wrapper           = NULL;
+    ref_object->gm_y8b_wrapper              = NULL;
     ref_object->ds_pics.picture_ptr           = ref_object->reference_picture;
     ref_object->ds_pics.quarter_picture_ptr   = ref_object->quarter_reference_picture;
     ref_object->ds_pics.sixteenth_picture_ptr = ref_object->sixteenth_reference_picture;
@@ -295,6 +228,8 @@ static void svt_pa_reference_object_dctor(EbPtr p) {
     EbPaReferenceObject *obj = (EbPaReferenceObject *)p;
     if (obj->dummy_obj)
         return;
+    EB_FREE_ARRAY(obj->tf_mv_field.mv);
+    EB_FREE_ARRAY(obj->me_sum_4x1);
     EB_DELETE(obj->input_padded_pic);
     EB_DELETE(obj->quarter_downsampled_picture_ptr);
     EB_DELETE(obj->sixteenth_downsampled_picture_ptr);
@@ -418,6 +353,20 @@ EbErrorType svt_pa_reference_object_ctor(EbPaReferenceObject *pa_ref_obj_, EbPtr
             EB_CREATE_MUTEX(pa_ref_obj_->resize_mutex[sr_down_idx][resize_down_idx]);
         }
     }
+    const uint32_t tf_mv_field_b64_count =
+        ((EbPaReferenceObjectDescInitData *)object_init_data_ptr)->tf_mv_field_b64_count;
+    pa_ref_obj_->tf_mv_field.src_poc   = (uint64_t)~0;
+    pa_ref_obj_->tf_mv_field.b64_count = tf_mv_field_b64_count;
+    pa_ref_obj_->tf_mv_field.mv        = NULL;
+    if (tf_mv_field_b64_count)
+        EB_MALLOC_ARRAY(pa_ref_obj_->tf_mv_field.mv, TF_MV_FIELD_REFS * tf_mv_field_b64_count);
+    pa_ref_obj_->me_sum_4x1        = NULL;
+    pa_ref_obj_->me_sum_4x1_size   = 0;
+    pa_ref_obj_->me_sum_4x1_stride = 0;
+    if (((EbPaReferenceObjectDescInitData *)object_init_data_ptr)->me_sum_4x1) {
+        pa_ref_obj_->me_sum_4x1_size = pa_ref_obj_->input_padded_pic->luma_size;
+        EB_MALLOC_ARRAY(pa_ref_obj_->me_sum_4x1, pa_ref_obj_->me_sum_4x1_size);
+    }
 
     return EB_ErrorNone;
 }
@@ -529,3 +478,103 @@ void svt_aom_release_pa_reference_objects(SequenceControlSet *scs, PictureParent
     pcs->reference_released = 1;
     return;
 }
+
+/*
+ * Hand the PA reference object and 8 bit luma held by the picture to its reference object: the
+ * global motion ref info points to their planes instead of copies
+ */
+void svt_aom_reference_object_hold_gm_src(EbReferenceObject *ref_object, PictureParentControlSet *pcs) {
+    svt_aom_release_reference_gm_src(NULL, ref_object);
+
+    EbPaReferenceObject *pa_ref_obj         = (EbPaReferenceObject *)pcs->gm_pa_ref_wrapper->object_ptr;
+    ref_object->gm_pa_ref_wrapper           = pcs->gm_pa_ref_wrapper;
+    ref_object->gm_y8b_wrapper              = pcs->gm_y8b_wrapper;
+    ref_object->input_picture               = pa_ref_obj->input_padded_pic;
+    ref_object->quarter_reference_picture   = pa_ref_obj->quarter_downsampled_picture_ptr;
+    ref_object->sixteenth_reference_picture = pa_ref_obj->sixteenth_downsampled_picture_ptr;
+    ref_object->ds_pics.quarter_picture_ptr   = ref_object->quarter_reference_picture;
+    ref_object->ds_pics.sixteenth_picture_ptr = ref_object->sixteenth_reference_picture;
+    pcs->gm_pa_ref_wrapper                  = NULL;
+    pcs->gm_y8b_wrapper                     = NULL;
+}
+
+/*
+ * Release the source planes held for the global motion ref info; set as the release callback of
+ * the reference picture pool
+ */
+void svt_aom_release_reference_gm_src(void *ctx, void *object_ptr) {
+    (void)ctx;
+    EbReferenceObject *ref_object = (EbReferenceObject *)object_ptr;
+    if (ref_object->gm_pa_ref_wrapper) {
+        svt_release_object(ref_object->gm_pa_ref_wrapper);
+        if (ref_object->gm_y8b_wrapper)
+            svt_release_object(ref_object->gm_y8b_wrapper);
+    }
+    ref_object->gm_pa_ref_wrapper             = NULL;
+    ref_object->gm_y8b_wrapper                = NULL;
+    ref_object->input_picture                 = NULL;
+    ref_object->quarter_reference_picture     = NULL;
+    ref_object->sixteenth_reference_picture   = NULL;
+    ref_object->ds_pics.quarter_picture_ptr   = NULL;
+    ref_object->ds_pics.sixteenth_picture_ptr = NULL;
+}
+
+/*
+ * Get the MV temporal filtering found for a 64x64 block of src_obj in ref_obj: from the field of src_obj
+ * when it was filtered with ref_obj as neighbour, else reversed from the field of ref_obj.
+ * Returns FALSE when the pair was not searched.
+ */
+Bool svt_aom_get_tf_mv(EbPaReferenceObject *src_obj, EbPaReferenceObject *ref_obj, uint32_t b64_index, Mv *mv) {
+    TfMvField *field = &src_obj->tf_mv_field;
+    if (field->src_poc == src_obj->picture_number && b64_index < field->b64_count) {
+        for (int i = 0; i < TF_MV_FIELD_REFS; i++) {
+            if (field->ref_poc[i] == ref_obj->picture_number) {
+                *mv = field->mv[i * field->b64_count + b64_index];
+                return mv->as_int != INVALID_MV;
+            }
+        }
+    }
+    field = &ref_obj->tf_mv_field;
+    if (field->src_poc == ref_obj->picture_number && b64_index < field->b64_count) {
+        for (int i = 0; i < TF_MV_FIELD_REFS; i++) {
+            if (field->ref_poc[i] == src_obj->picture_number) {
+                const Mv ref_mv = field->mv[i * field->b64_count + b64_index];
+                if (ref_mv.as_int == INVALID_MV)
+                    return FALSE;
+                mv->x = -ref_mv.x;
+                mv->y = -ref_mv.y;
+                return TRUE;
+            }
+        }
+    }
+    return FALSE;
+}
+
+/*
+ * Generate the 4x1 sums of input_padded_pic used by the successive elimination of the full-pel ME: at each position,
+ * the sum of the pixel and of the 3 pixels on its right.
+ */
+void svt_aom_generate_me_sum_4x1(EbPaReferenceObject *pa_ref_obj) {
+    pa_ref_obj->me_sum_4x1_stride = 0;
+    if (!pa_ref_obj->me_sum_4x1)
+        return;
+    const EbPictureBufferDesc *pic    = pa_ref_obj->input_padded_pic;
+    const uint32_t             stride = pic->stride_y;
+    const uint32_t             rows   = pic->org_y + pic->height + pic->origin_bot_y;
+    // zero copy input pictures may come with a wider stride than allocated for
+    if (stride < 4 || stride * rows > pa_ref_obj->me_sum_4x1_size)
+        return;
+    uint16_t *sum = pa_ref_obj->me_sum_4x1;
+    for (uint32_t y = 0; y < rows; y++) {
+        const uint8_t *src = pic->buffer_y + y * stride;
+        uint16_t      *dst = sum + y * stride;
+        uint16_t       acc = 0;
+        for (uint32_t x = 0; x < 4; x++) acc += src[x];
+        dst[0] = acc;
+        for (uint32_t x = 1; x + 4 <= stride; x++) {
+            acc += src[x + 3] - src[x - 1];
+            dst[x] = acc;
+        }
+    }
+    pa_ref_obj->me_sum_4x1_stride = stride;
+}
@@ -21,6 +21,8 @@
 typedef struct EbReferenceObject {
     EbDctor                     dctor;
     EbPictureBufferDesc        *reference_picture;
+    // Source planes used by the global motion of the pictures referencing this one (ref info),
+    // planes of gm_pa_ref_wrapper: not owned
     EbPictureBufferDesc        *quarter_reference_picture;
     EbPictureBufferDesc        *sixteenth_reference_picture;
     EbDownScaledBufDescPtrArray ds_pics; // Pointer array for down scaled pictures
@@ -62,6 +64,10 @@ typedef struct EbReferenceObject {
     int32_t              mi_cols;
     int32_t              mi_rows;
     WienerUnitInfo     **unit_info; // per plane, per rest. unit; used for fwding wiener info to future frames
+    // PA reference object of the picture, and the 8 bit luma it shares with the input, held for the
+    // global motion ref info until the reference object is released
+    EbObjectWrapper *gm_pa_ref_wrapper;
+    EbObjectWrapper *gm_y8b_wrapper;
 } EbReferenceObject;
 
 typedef struct EbReferenceObjectDescInitData {
@@ -70,6 +76,17 @@ typedef struct EbReferenceObjectDescInitData {
     EbSvtAv1EncConfiguration   *static_config;
 } EbReferenceObjectDescInitData;
 
+// Neighbours of a temporally filtered picture whose motion field is kept: the 4 closest past and future ones
+#define TF_MV_FIELD_REFS 8
+/* Full-pel MVs of the 64x64 blocks found by the motion search of temporal filtering, from the filtered
+ * picture to its neighbours, for the open-loop ME of the same pairs of pictures */
+typedef struct TfMvField {
+    uint64_t src_poc; // picture the field was searched from, ~0 until the filtering is done
+    uint64_t ref_poc[TF_MV_FIELD_REFS]; // ~0 for an unused slot
+    uint32_t b64_count;
+    Mv      *mv; // [TF_MV_FIELD_REFS][b64_count], INVALID_MV where the block was not searched
+} TfMvField;
+
 typedef struct EbPaReferenceObject {
     EbDctor              dctor;
     EbPictureBufferDesc *input_padded_pic;
@@ -83,15 +100,23 @@ typedef struct EbPaReferenceObject {
     uint64_t             downscaled_picture_number[NUM_SR_SCALES + 1]
                                       [NUM_RESIZE_SCALES + 1]; // save the picture_number for each denom
     EbHandle resize_mutex[NUM_SR_SCALES + 1][NUM_RESIZE_SCALES + 1];
-    uint64_t picture_number;
-    uint64_t avg_luma;
-    uint8_t  dummy_obj;
+    uint64_t  picture_number;
+    uint64_t  avg_luma;
+    uint8_t   dummy_obj;
+    TfMvField tf_mv_field;
+    // Sum of the 4 pixels starting at each position of input_padded_pic, for the successive elimination of the
+    // full-pel ME. NULL when not allocated.
+    uint16_t *me_sum_4x1;
+    uint32_t  me_sum_4x1_size; // allocated number of positions
+    uint32_t  me_sum_4x1_stride; // stride of input_padded_pic the sums were generated with, 0 when not generated
 } EbPaReferenceObject;
 
 typedef struct EbPaReferenceObjectDescInitData {
     EbPictureBufferDescInitData reference_picture_desc_init_data;
     EbPictureBufferDescInitData quarter_picture_desc_init_data;
     EbPictureBufferDescInitData sixteenth_picture_desc_init_data;
+    uint32_t                    tf_mv_field_b64_count; // 0 when no picture is temporally filtered
+    uint8_t                     me_sum_4x1; // allocate the 4x1 sums of the full-pel ME
 } EbPaReferenceObjectDescInitData;
 
 typedef struct EbTplReferenceObject {
@@ -115,5 +140,10 @@ void               svt_aom_release_pa_reference_objects(SequenceControlSet *scs,
 extern EbErrorType svt_pa_reference_param_update(EbPaReferenceObject *pa_ref_obj_, SequenceControlSet *scs);
 extern EbErrorType svt_tpl_reference_param_update(EbTplReferenceObject *tpl_ref_obj, SequenceControlSet *scs);
 extern EbErrorType svt_reference_param_update(EbReferenceObject *ref_object, SequenceControlSet *scs);
+void               svt_aom_reference_object_hold_gm_src(EbReferenceObject *ref_object, PictureParentControlSet *pcs);
+void               svt_aom_release_reference_gm_src(void *ctx, void *object_ptr);
+Bool               svt_aom_get_tf_mv(EbPaReferenceObject *src_obj, EbPaReferenceObject *ref_obj, uint32_t b64_index,
+                                     Mv *mv);
+void               svt_aom_generate_me_sum_4x1(EbPaReferenceObject *pa_ref_obj);
 
 #endif //EbReferenceObject_h
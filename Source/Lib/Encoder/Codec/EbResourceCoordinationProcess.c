@@ -466,6 +466,13 @@ static EbErrorType copy_frame_buffer_overlay(SequenceControlSet *scs, uint8_t *d
             (dst_picture_ptr->stride_cr * (scs->top_padding >> 1) + (scs->left_padding >> 1)) << is_16bit_input;
         uint16_t luma_stride   = dst_picture_ptr->stride_y << is_16bit_input;
         uint16_t chroma_stride = dst_picture_ptr->stride_cb << is_16bit_input;
+        // the source may be a zero copy input picture with the application strides
+        uint32_t src_luma_buffer_offset = (src_picture_ptr->stride_y * scs->top_padding + scs->left_padding)
+            << is_16bit_input;
+        uint32_t src_chroma_buffer_offset =
+            (src_picture_ptr->stride_cr * (scs->top_padding >> 1) + (scs->left_padding >> 1)) << is_16bit_input;
+        uint16_t src_luma_stride   = src_picture_ptr->stride_y << is_16bit_input;
+        uint16_t src_chroma_stride = src_picture_ptr->stride_cb << is_16bit_input;
         uint16_t luma_width    = (uint16_t)(dst_picture_ptr->width - scs->max_input_pad_right) << is_16bit_input;
         uint16_t chroma_width  = (luma_width >> 1) << is_16bit_input;
         uint16_t luma_height   = (uint16_t)(dst_picture_ptr->height - scs->max_input_pad_bottom);
@@ -474,21 +481,21 @@ static EbErrorType copy_frame_buffer_overlay(SequenceControlSet *scs, uint8_t *d
         // Y
         for (input_row_index = 0; input_row_index < luma_height; input_row_index++) {
             svt_memcpy((dst_picture_ptr->buffer_y + luma_buffer_offset + luma_stride * input_row_index),
-                       (src_picture_ptr->buffer_y + luma_buffer_offset + luma_stride * input_row_index),
+                       (src_picture_ptr->buffer_y + src_luma_buffer_offset + src_luma_stride * input_row_index),
                        luma_width);
         }
 
         // U
         for (input_row_index = 0; input_row_index < (luma_height >> 1); input_row_index++) {
             svt_memcpy((dst_picture_ptr->buffer_cb + chroma_buffer_offset + chroma_stride * input_row_index),
-                       (src_picture_ptr->buffer_cb + chroma_buffer_offset + chroma_stride * input_row_index),
+                       (src_picture_ptr->buffer_cb + src_chroma_buffer_offset + src_chroma_stride * input_row_index),
                        chroma_width);
         }
 
         // V
         for (input_row_index = 0; input_row_index < (luma_height >> 1); input_row_index++) {
             svt_memcpy((dst_picture_ptr->buffer_cr + chroma_buffer_offset + chroma_stride * input_row_index),
-                       (src_picture_ptr->buffer_cr + chroma_buffer_offset + chroma_stride * input_row_index),
+                       (src_picture_ptr->buffer_cr + src_chroma_buffer_offset + src_chroma_stride * input_row_index),
                        chroma_width);
         }
     } else { // 10bit packed
@@ -536,10 +543,64 @@ static void copy_input_buffer_overlay(SequenceControlSet *sequenceControlSet, Eb
 /******************************************************
  * Read Stat from File
  ******************************************************/
+/* Total bits the first pass spent on the frames of stats, of the frames from start
+ * to end on in chunk_bits, with the bits of the frames not coded filled in the way
+ * the final pass does */
+static uint64_t sum_stats_bits(const FIRSTPASS_STATS *stats, uint64_t count, uint64_t start, uint64_t end,
+                               uint64_t *chunk_bits) {
+    uint64_t previous_num_bits[MAX_TEMPORAL_LAYERS] = {0};
+    uint64_t total_bits                             = 0;
+    *chunk_bits                                     = 0;
+    for (uint64_t i = 0; i < count; i++) {
+        const int layer    = MAX((int)stats[i].stat_struct.temporal_layer_index, 0);
+        uint64_t  num_bits = stats[i].stat_struct.total_num_bits;
+        if (num_bits == 0)
+            num_bits = previous_num_bits[layer];
+        previous_num_bits[layer] = num_bits;
+        total_bits += num_bits;
+        if (i >= start && i < end)
+            *chunk_bits += num_bits;
+    }
+    return total_bits;
+}
+/* Chunk of a chunked two-pass encode: copies the statistics of the frames of the
+ * chunk out of those of the whole input, and gives the chunk the share of the bit
+ * budget of the input its frames earned in the first pass */
+static void read_stat_chunk(SequenceControlSet *scs) {
+    EncodeContext         *enc_ctx = scs->enc_ctx;
+    const FIRSTPASS_STATS *stats   = (const FIRSTPASS_STATS *)scs->static_config.rc_stats_buffer.buf;
+    const uint64_t         packets = scs->static_config.rc_stats_buffer.sz / sizeof(FIRSTPASS_STATS);
+    const uint64_t         start   = scs->static_config.rc_stats_chunk_start;
+    const uint64_t         frames  = scs->static_config.rc_stats_chunk_frames;
+
+    // The last packet holds the totals of the first pass
+    if (packets < 2 || start + frames > packets - 1) {
+        SVT_WARN("The chunk of frames %llu to %llu is not in the first-pass statistics, using them as is\n",
+                 (unsigned long long)start,
+                 (unsigned long long)(start + frames - 1));
+        return;
+    }
+    EB_NO_THROW_MALLOC(enc_ctx->rc_stats_chunk, sizeof(FIRSTPASS_STATS) * (frames + 1));
+    if (!enc_ctx->rc_stats_chunk)
+        return;
+    memcpy(enc_ctx->rc_stats_chunk, stats + start, sizeof(FIRSTPASS_STATS) * frames);
+    svt_av1_twopass_zero_stats(enc_ctx->rc_stats_chunk + frames);
+    enc_ctx->rc_stats_buffer.buf = enc_ctx->rc_stats_chunk;
+    enc_ctx->rc_stats_buffer.sz  = sizeof(FIRSTPASS_STATS) * (frames + 1);
+
+    double duration = 0;
+    for (uint64_t i = 0; i < packets - 1; i++) duration += stats[i].duration;
+    uint64_t       chunk_bits;
+    const uint64_t total_bits = sum_stats_bits(stats, packets - 1, start, start + frames, &chunk_bits);
+    const double   share      = total_bits ? (double)chunk_bits / total_bits : (double)frames / (packets - 1);
+    enc_ctx->rc_stats_chunk_bits = (int64_t)(duration * scs->static_config.target_bit_rate / 10000000.0 * share);
+}
 void svt_aom_read_stat(SequenceControlSet *scs) {
     EncodeContext *enc_ctx = scs->enc_ctx;
 
     enc_ctx->rc_stats_buffer = scs->static_config.rc_stats_buffer;
+    if (scs->static_config.rc_stats_chunk_frames)
+        read_stat_chunk(scs);
 }
 void svt_aom_setup_two_pass(SequenceControlSet *scs) {
     EncodeContext *enc_ctx     = scs->enc_ctx;
@@ -1115,7 +1176,8 @@ void *svt_aom_resource_coordination_kernel(void *input_ptr) {
             scs->enc_ctx->initial_picture = FALSE;
 
             // Get Empty Reference Picture Object
-            svt_get_empty_object(scs->enc_ctx->pa_reference_picture_pool_fifo_ptr, &ref_pic_wrapper);
+            svt_get_empty_picture_object(
+                scs->enc_ctx->pa_reference_picture_pool_fifo_ptr, pcs->picture_number, &ref_pic_wrapper);
 
             pcs->pa_ref_pic_wrapper = ref_pic_wrapper;
             // make pa_ref full sample buffer access the luma8bit part from the y8b Pool
@@ -1126,6 +1188,8 @@ void *svt_aom_resource_coordination_kernel(void *input_ptr) {
                 svt_pa_reference_param_update(pa_ref_obj, scs);
             EbPictureBufferDesc *input_padded_pic = (EbPictureBufferDesc *)pa_ref_obj->input_padded_pic;
             input_padded_pic->buffer_y            = buff_y8b;
+            // zero copy input pictures come with the application stride
+            input_padded_pic->stride_y = ((EbPictureBufferDesc *)y8b_header->p_buffer)->stride_y;
             svt_object_inc_live_count(pcs->pa_ref_pic_wrapper, 1);
             if (pcs->y8b_wrapper) {
                 // y8b follows longest life cycle of pa ref and input. so it needs to build on top of live count of pa ref
@@ -520,7 +520,7 @@ static void copy_statistics_to_ref_obj_ect(PictureControlSet *pcs, SequenceContr
 /******************************************************
  * Rest Kernel
  ******************************************************/
-void *svt_aom_rest_kernel(void *input_ptr) {
+void svt_aom_rest_task(void *input_ptr, EbObjectWrapper *cdef_results_wrapper) {
     // Context & SCS & PCS
     EbThreadContext    *thread_ctx  = (EbThreadContext *)input_ptr;
     RestContext        *context_ptr = (RestContext *)thread_ctx->priv;
@@ -528,7 +528,6 @@ void *svt_aom_rest_kernel(void *input_ptr) {
     SequenceControlSet *scs;
 
     //// Input
-    EbObjectWrapper *cdef_results_wrapper;
     CdefResults     *cdef_results;
 
     //// Output
@@ -542,231 +541,224 @@ void *svt_aom_rest_kernel(void *input_ptr) {
 
     Bool superres_recode = FALSE;
 
-    for (;;) {
-        // Get Cdef Results
-        EB_GET_FULL_OBJECT(context_ptr->rest_input_fifo_ptr, &cdef_results_wrapper);
-
-        cdef_results                  = (CdefResults *)cdef_results_wrapper->object_ptr;
-        pcs                           = (PictureControlSet *)cdef_results->pcs_wrapper->object_ptr;
-        PictureParentControlSet *ppcs = pcs->ppcs;
-        scs                           = pcs->scs;
-        FrameHeader *frm_hdr          = &pcs->ppcs->frm_hdr;
-        Bool         is_16bit         = scs->is_16bit_pipeline;
-        Av1Common   *cm               = pcs->ppcs->av1_cm;
-        if (ppcs->enable_restoration && frm_hdr->allow_intrabc == 0) {
-            // If using boundaries during the filter search, copy the recon pic to a new buffer (to
-            // avoid race condition from many threads modifying the same recon pic).
-            //
-            // If not using boundaries during the filter search, copy the input recon picture
-            // location to be used in restoration search (save cycles/memory of copying pic to a new
-            // buffer). The recon pic should not be modified during the search, otherwise there will
-            // be a race condition between threads.
-            EbPictureBufferDesc *recon_pic = get_own_recon(scs, pcs, context_ptr, is_16bit);
-            EbPictureBufferDesc *input_pic = is_16bit ? pcs->input_frame16bit : pcs->ppcs->enhanced_unscaled_pic;
-
-            EbPictureBufferDesc *scaled_input_pic = NULL;
-            // downscale input picture if recon is resized
-            Bool is_resized = recon_pic->width != input_pic->width || recon_pic->height != input_pic->height;
-            if (is_resized) {
-                scaled_input_pic = pcs->scaled_input_pic;
-                input_pic        = scaled_input_pic;
-            }
+    cdef_results                  = (CdefResults *)cdef_results_wrapper->object_ptr;
+    pcs                           = (PictureControlSet *)cdef_results->pcs_wrapper->object_ptr;
+    PictureParentControlSet *ppcs = pcs->ppcs;
+    scs                           = pcs->scs;
+    FrameHeader *frm_hdr          = &pcs->ppcs->frm_hdr;
+    Bool         is_16bit         = scs->is_16bit_pipeline;
+    Av1Common   *cm               = pcs->ppcs->av1_cm;
+    if (ppcs->enable_restoration && frm_hdr->allow_intrabc == 0) {
+        // If using boundaries during the filter search, copy the recon pic to a new buffer (to
+        // avoid race condition from many threads modifying the same recon pic).
+        //
+        // If not using boundaries during the filter search, copy the input recon picture
+        // location to be used in restoration search (save cycles/memory of copying pic to a new
+        // buffer). The recon pic should not be modified during the search, otherwise there will
+        // be a race condition between threads.
+        EbPictureBufferDesc *recon_pic = get_own_recon(scs, pcs, context_ptr, is_16bit);
+        EbPictureBufferDesc *input_pic = is_16bit ? pcs->input_frame16bit : pcs->ppcs->enhanced_unscaled_pic;
+
+        EbPictureBufferDesc *scaled_input_pic = NULL;
+        // downscale input picture if recon is resized
+        Bool is_resized = recon_pic->width != input_pic->width || recon_pic->height != input_pic->height;
+        if (is_resized) {
+            scaled_input_pic = pcs->scaled_input_pic;
+            input_pic        = scaled_input_pic;
+        }
 
-            // there are padding pixels if input pics are not 8 pixel aligned
-            // but there is no extra padding after input pics are resized for
-            // reference scaling
-            Yv12BufferConfig cpi_source;
-            svt_aom_link_eb_to_aom_buffer_desc(input_pic,
-                                               &cpi_source,
-                                               is_resized ? 0 : scs->max_input_pad_right,
-                                               is_resized ? 0 : scs->max_input_pad_bottom,
-                                               is_16bit);
-
-            Yv12BufferConfig trial_frame_rst;
-            svt_aom_link_eb_to_aom_buffer_desc(context_ptr->trial_frame_rst,
-                                               &trial_frame_rst,
-                                               is_resized ? 0 : scs->max_input_pad_right,
-                                               is_resized ? 0 : scs->max_input_pad_bottom,
-                                               is_16bit);
-
-            Yv12BufferConfig org_fts;
-            svt_aom_link_eb_to_aom_buffer_desc(recon_pic,
-                                               &org_fts,
-                                               is_resized ? 0 : scs->max_input_pad_right,
-                                               is_resized ? 0 : scs->max_input_pad_bottom,
-                                               is_16bit);
-
-            if (pcs->ppcs->slice_type != I_SLICE && cm->wn_filter_ctrls.enabled &&
-                cm->wn_filter_ctrls.use_prev_frame_coeffs) {
-                EbReferenceObject *ref_obj_l0 = (EbReferenceObject *)pcs->ref_pic_ptr_array[REF_LIST_0][0]->object_ptr;
-                for (int32_t plane = 0; plane < MAX_MB_PLANE; ++plane) {
-                    int32_t ntiles = pcs->rst_info[plane].units_per_tile;
-                    for (int32_t u = 0; u < ntiles; ++u) {
-                        pcs->rst_info[plane].unit_info[u].restoration_type =
-                            ref_obj_l0->unit_info[plane][u].restoration_type;
-                        if (ref_obj_l0->unit_info[plane][u].restoration_type == RESTORE_WIENER)
-                            pcs->rst_info[plane].unit_info[u].wiener_info = ref_obj_l0->unit_info[plane][u].wiener_info;
-                    }
+        // there are padding pixels if input pics are not 8 pixel aligned
+        // but there is no extra padding after input pics are resized for
+        // reference scaling
+        Yv12BufferConfig cpi_source;
+        svt_aom_link_eb_to_aom_buffer_desc(input_pic,
+                                           &cpi_source,
+                                           is_resized ? 0 : scs->max_input_pad_right,
+                                           is_resized ? 0 : scs->max_input_pad_bottom,
+                                           is_16bit);
+
+        Yv12BufferConfig trial_frame_rst;
+        svt_aom_link_eb_to_aom_buffer_desc(context_ptr->trial_frame_rst,
+                                           &trial_frame_rst,
+                                           is_resized ? 0 : scs->max_input_pad_right,
+                                           is_resized ? 0 : scs->max_input_pad_bottom,
+                                           is_16bit);
+
+        Yv12BufferConfig org_fts;
+        svt_aom_link_eb_to_aom_buffer_desc(recon_pic,
+                                           &org_fts,
+                                           is_resized ? 0 : scs->max_input_pad_right,
+                                           is_resized ? 0 : scs->max_input_pad_bottom,
+                                           is_16bit);
+
+        if (pcs->ppcs->slice_type != I_SLICE && cm->wn_filter_ctrls.enabled &&
+            cm->wn_filter_ctrls.use_prev_frame_coeffs) {
+            EbReferenceObject *ref_obj_l0 = (EbReferenceObject *)pcs->ref_pic_ptr_array[REF_LIST_0][0]->object_ptr;
+            for (int32_t plane = 0; plane < MAX_MB_PLANE; ++plane) {
+                int32_t ntiles = pcs->rst_info[plane].units_per_tile;
+                for (int32_t u = 0; u < ntiles; ++u) {
+                    pcs->rst_info[plane].unit_info[u].restoration_type =
+                        ref_obj_l0->unit_info[plane][u].restoration_type;
+                    if (ref_obj_l0->unit_info[plane][u].restoration_type == RESTORE_WIENER)
+                        pcs->rst_info[plane].unit_info[u].wiener_info = ref_obj_l0->unit_info[plane][u].wiener_info;
                 }
             }
-            restoration_seg_search(
-                context_ptr->rst_tmpbuf, &org_fts, &cpi_source, &trial_frame_rst, pcs, cdef_results->segment_index);
         }
+        restoration_seg_search(
+            context_ptr->rst_tmpbuf, &org_fts, &cpi_source, &trial_frame_rst, pcs, cdef_results->segment_index);
+    }
 
-        //all seg based search is done. update total processed segments. if all done, finish the search and perfrom application.
-        svt_block_on_mutex(pcs->rest_search_mutex);
-
-        pcs->tot_seg_searched_rest++;
-        if (pcs->tot_seg_searched_rest == pcs->rest_segments_total_count) {
-            if (ppcs->enable_restoration && frm_hdr->allow_intrabc == 0) {
-                rest_finish_search(pcs);
+    //all seg based search is done. update total processed segments. if all done, finish the search and perfrom application.
+    svt_block_on_mutex(pcs->rest_search_mutex);
 
-                // Only need recon if REF pic or recon is output
-                if (pcs->ppcs->is_ref || scs->static_config.recon_enabled) {
-                    if (pcs->rst_info[0].frame_restoration_type != RESTORE_NONE ||
-                        pcs->rst_info[1].frame_restoration_type != RESTORE_NONE ||
-                        pcs->rst_info[2].frame_restoration_type != RESTORE_NONE) {
-                        svt_av1_loop_restoration_filter_frame(context_ptr->rst_tmpbuf, cm->frame_to_show, cm, 0);
-                    }
+    pcs->tot_seg_searched_rest++;
+    if (pcs->tot_seg_searched_rest == pcs->rest_segments_total_count) {
+        if (ppcs->enable_restoration && frm_hdr->allow_intrabc == 0) {
+            rest_finish_search(pcs);
+
+            // Only need recon if REF pic or recon is output
+            if (pcs->ppcs->is_ref || scs->static_config.recon_enabled) {
+                if (pcs->rst_info[0].frame_restoration_type != RESTORE_NONE ||
+                    pcs->rst_info[1].frame_restoration_type != RESTORE_NONE ||
+                    pcs->rst_info[2].frame_restoration_type != RESTORE_NONE) {
+                    svt_av1_loop_restoration_filter_frame(context_ptr->rst_tmpbuf, cm->frame_to_show, cm, 0);
                 }
+            }
 
-                if (cm->sg_filter_ctrls.enabled) {
-                    uint8_t best_ep_cnt = 0;
-                    uint8_t best_ep     = 0;
-                    for (uint8_t i = 0; i < SGRPROJ_PARAMS; i++) {
-                        if (cm->sg_frame_ep_cnt[i] > best_ep_cnt) {
-                            best_ep     = i;
-                            best_ep_cnt = cm->sg_frame_ep_cnt[i];
-                        }
+            if (cm->sg_filter_ctrls.enabled) {
+                uint8_t best_ep_cnt = 0;
+                uint8_t best_ep     = 0;
+                for (uint8_t i = 0; i < SGRPROJ_PARAMS; i++) {
+                    if (cm->sg_frame_ep_cnt[i] > best_ep_cnt) {
+                        best_ep     = i;
+                        best_ep_cnt = cm->sg_frame_ep_cnt[i];
                     }
-                    cm->sg_frame_ep = best_ep;
                 }
-            } else {
-                pcs->rst_info[0].frame_restoration_type = RESTORE_NONE;
-                pcs->rst_info[1].frame_restoration_type = RESTORE_NONE;
-                pcs->rst_info[2].frame_restoration_type = RESTORE_NONE;
+                cm->sg_frame_ep = best_ep;
             }
+        } else {
+            pcs->rst_info[0].frame_restoration_type = RESTORE_NONE;
+            pcs->rst_info[1].frame_restoration_type = RESTORE_NONE;
+            pcs->rst_info[2].frame_restoration_type = RESTORE_NONE;
+        }
 
-            // delete scaled_input_pic after lr finished
-            EB_DELETE(pcs->scaled_input_pic);
-            if (pcs->ppcs->ref_pic_wrapper != NULL) {
-                // copy stat to ref object (intra_coded_area, Luminance, Scene change detection
-                // flags)
-                copy_statistics_to_ref_obj_ect(pcs, scs);
-            }
+        // delete scaled_input_pic after lr finished
+        EB_DELETE(pcs->scaled_input_pic);
+        if (pcs->ppcs->ref_pic_wrapper != NULL) {
+            // copy stat to ref object (intra_coded_area, Luminance, Scene change detection
+            // flags)
+            copy_statistics_to_ref_obj_ect(pcs, scs);
+        }
 
-            superres_recode = pcs->ppcs->superres_total_recode_loop > 0 ? TRUE : FALSE;
-
-            // Pad the reference picture and set ref POC
-            {
-                if (pcs->ppcs->is_ref == TRUE)
-                    pad_ref_and_set_flags(pcs, scs);
-                else {
-                    // convert non-reference frame buffer from 16-bit to 8-bit, to export recon and
-                    // psnr/ssim calculation
-                    if (is_16bit && scs->static_config.encoder_bit_depth == EB_EIGHT_BIT) {
-                        EbPictureBufferDesc *ref_pic_ptr       = pcs->ppcs->enc_dec_ptr->recon_pic;
-                        EbPictureBufferDesc *ref_pic_16bit_ptr = pcs->ppcs->enc_dec_ptr->recon_pic_16bit;
-                        // Y
-                        uint16_t *buf_16bit = (uint16_t *)(ref_pic_16bit_ptr->buffer_y);
-                        uint8_t  *buf_8bit  = ref_pic_ptr->buffer_y;
-                        svt_convert_16bit_to_8bit(buf_16bit,
-                                                  ref_pic_16bit_ptr->stride_y,
-                                                  buf_8bit,
-                                                  ref_pic_ptr->stride_y,
-                                                  ref_pic_16bit_ptr->width + (ref_pic_ptr->org_x << 1),
-                                                  ref_pic_16bit_ptr->height + (ref_pic_ptr->org_y << 1));
-
-                        //CB
-                        buf_16bit = (uint16_t *)(ref_pic_16bit_ptr->buffer_cb);
-                        buf_8bit  = ref_pic_ptr->buffer_cb;
-                        svt_convert_16bit_to_8bit(
-                            buf_16bit,
-                            ref_pic_16bit_ptr->stride_cb,
-                            buf_8bit,
-                            ref_pic_ptr->stride_cb,
-                            (ref_pic_16bit_ptr->width + (ref_pic_ptr->org_x << 1)) >> scs->subsampling_x,
-                            (ref_pic_16bit_ptr->height + (ref_pic_ptr->org_y << 1)) >> scs->subsampling_y);
-
-                        //CR
-                        buf_16bit = (uint16_t *)(ref_pic_16bit_ptr->buffer_cr);
-                        buf_8bit  = ref_pic_ptr->buffer_cr;
-                        svt_convert_16bit_to_8bit(
-                            buf_16bit,
-                            ref_pic_16bit_ptr->stride_cr,
-                            buf_8bit,
-                            ref_pic_ptr->stride_cr,
-                            (ref_pic_16bit_ptr->width + (ref_pic_ptr->org_x << 1)) >> scs->subsampling_x,
-                            (ref_pic_16bit_ptr->height + (ref_pic_ptr->org_y << 1)) >> scs->subsampling_y);
-                    }
+        superres_recode = pcs->ppcs->superres_total_recode_loop > 0 ? TRUE : FALSE;
+
+        // Pad the reference picture and set ref POC
+        {
+            if (pcs->ppcs->is_ref == TRUE)
+                pad_ref_and_set_flags(pcs, scs);
+            else {
+                // convert non-reference frame buffer from 16-bit to 8-bit, to export recon and
+                // psnr/ssim calculation
+                if (is_16bit && scs->static_config.encoder_bit_depth == EB_EIGHT_BIT) {
+                    EbPictureBufferDesc *ref_pic_ptr       = pcs->ppcs->enc_dec_ptr->recon_pic;
+                    EbPictureBufferDesc *ref_pic_16bit_ptr = pcs->ppcs->enc_dec_ptr->recon_pic_16bit;
+                    // Y
+                    uint16_t *buf_16bit = (uint16_t *)(ref_pic_16bit_ptr->buffer_y);
+                    uint8_t  *buf_8bit  = ref_pic_ptr->buffer_y;
+                    svt_convert_16bit_to_8bit(buf_16bit,
+                                              ref_pic_16bit_ptr->stride_y,
+                                              buf_8bit,
+                                              ref_pic_ptr->stride_y,
+                                              ref_pic_16bit_ptr->width + (ref_pic_ptr->org_x << 1),
+                                              ref_pic_16bit_ptr->height + (ref_pic_ptr->org_y << 1));
+
+                    //CB
+                    buf_16bit = (uint16_t *)(ref_pic_16bit_ptr->buffer_cb);
+                    buf_8bit  = ref_pic_ptr->buffer_cb;
+                    svt_convert_16bit_to_8bit(
+                        buf_16bit,
+                        ref_pic_16bit_ptr->stride_cb,
+                        buf_8bit,
+                        ref_pic_ptr->stride_cb,
+                        (ref_pic_16bit_ptr->width + (ref_pic_ptr->org_x << 1)) >> scs->subsampling_x,
+                        (ref_pic_16bit_ptr->height + (ref_pic_ptr->org_y << 1)) >> scs->subsampling_y);
+
+                    //CR
+                    buf_16bit = (uint16_t *)(ref_pic_16bit_ptr->buffer_cr);
+                    buf_8bit  = ref_pic_ptr->buffer_cr;
+                    svt_convert_16bit_to_8bit(
+                        buf_16bit,
+                        ref_pic_16bit_ptr->stride_cr,
+                        buf_8bit,
+                        ref_pic_ptr->stride_cr,
+                        (ref_pic_16bit_ptr->width + (ref_pic_ptr->org_x << 1)) >> scs->subsampling_x,
+                        (ref_pic_16bit_ptr->height + (ref_pic_ptr->org_y << 1)) >> scs->subsampling_y);
                 }
             }
+        }
 
-            // PSNR and SSIM Calculation.
-            if (superres_recode) { // superres needs psnr to compute rdcost
-                // Note: if superres recode is actived, memory needs to be freed in packetization process by calling free_temporal_filtering_buffer()
-                EbErrorType return_error = psnr_calculations(pcs, scs, FALSE);
-                if (return_error != EB_ErrorNone) {
-                    svt_aom_assert_err(0,
-                                       "Couldn't allocate memory for uncompressed 10bit buffers for PSNR "
-                                       "calculations");
-                }
-            } else if (scs->static_config.stat_report) {
-                // Note: if temporal_filtering is used, memory needs to be freed in the last of these calls
-                EbErrorType return_error = psnr_calculations(pcs, scs, FALSE);
-                if (return_error != EB_ErrorNone) {
-                    svt_aom_assert_err(0,
-                                       "Couldn't allocate memory for uncompressed 10bit buffers for PSNR "
-                                       "calculations");
-                }
-                return_error = svt_aom_ssim_calculations(pcs, scs, TRUE /* free memory here */);
-                if (return_error != EB_ErrorNone) {
-                    svt_aom_assert_err(0,
-                                       "Couldn't allocate memory for uncompressed 10bit buffers for SSIM "
-                                       "calculations");
-                }
+        // PSNR and SSIM Calculation.
+        if (superres_recode) { // superres needs psnr to compute rdcost
+            // Note: if superres recode is actived, memory needs to be freed in packetization process by calling free_temporal_filtering_buffer()
+            EbErrorType return_error = psnr_calculations(pcs, scs, FALSE);
+            if (return_error != EB_ErrorNone) {
+                svt_aom_assert_err(0,
+                                   "Couldn't allocate memory for uncompressed 10bit buffers for PSNR "
+                                   "calculations");
             }
-
-            if (!superres_recode) {
-                if (scs->static_config.recon_enabled) {
-                    svt_aom_recon_output(pcs, scs);
-                }
-                // post reference picture task in packetization process if it's superres_recode
-                if (pcs->ppcs->is_ref) {
-                    // Get Empty PicMgr Results
-                    svt_get_empty_object(context_ptr->picture_demux_fifo_ptr, &picture_demux_results_wrapper_ptr);
-
-                    picture_demux_results_rtr = (PictureDemuxResults *)picture_demux_results_wrapper_ptr->object_ptr;
-                    picture_demux_results_rtr->ref_pic_wrapper = pcs->ppcs->ref_pic_wrapper;
-                    picture_demux_results_rtr->scs             = pcs->scs;
-                    picture_demux_results_rtr->picture_number  = pcs->picture_number;
-                    picture_demux_results_rtr->picture_type    = EB_PIC_REFERENCE;
-
-                    // Post Reference Picture
-                    svt_post_full_object(picture_demux_results_wrapper_ptr);
-                }
+        } else if (scs->static_config.stat_report) {
+            // Note: if temporal_filtering is used, memory needs to be freed in the last of these calls
+            EbErrorType return_error = psnr_calculations(pcs, scs, FALSE);
+            if (return_error != EB_ErrorNone) {
+                svt_aom_assert_err(0,
+                                   "Couldn't allocate memory for uncompressed 10bit buffers for PSNR "
+                                   "calculations");
             }
+            return_error = svt_aom_ssim_calculations(pcs, scs, TRUE /* free memory here */);
+            if (return_error != EB_ErrorNone) {
+                svt_aom_assert_err(0,
+                                   "Couldn't allocate memory for uncompressed 10bit buffers for SSIM "
+                                   "calculations");
+            }
+        }
 
-            tile_cols = pcs->ppcs->av1_cm->tiles_info.tile_cols;
-            tile_rows = pcs->ppcs->av1_cm->tiles_info.tile_rows;
-
-            for (int tile_row_idx = 0; tile_row_idx < tile_rows; tile_row_idx++) {
-                for (int tile_col_idx = 0; tile_col_idx < tile_cols; tile_col_idx++) {
-                    const int tile_idx = tile_row_idx * tile_cols + tile_col_idx;
-                    svt_get_empty_object(context_ptr->rest_output_fifo_ptr, &rest_results_wrapper);
-                    rest_results              = (struct RestResults *)rest_results_wrapper->object_ptr;
-                    rest_results->pcs_wrapper = cdef_results->pcs_wrapper;
-                    rest_results->tile_index  = tile_idx;
-                    // Post Rest Results
-                    svt_post_full_object(rest_results_wrapper);
-                }
+        if (!superres_recode) {
+            if (scs->static_config.recon_enabled) {
+                svt_aom_recon_output(pcs, scs);
+            }
+            // post reference picture task in packetization process if it's superres_recode
+            if (pcs->ppcs->is_ref) {
+                // Get Empty PicMgr Results
+                svt_get_empty_object(context_ptr->picture_demux_fifo_ptr, &picture_demux_results_wrapper_ptr);
+
+                picture_demux_results_rtr = (PictureDemuxResults *)picture_demux_results_wrapper_ptr->object_ptr;
+                picture_demux_results_rtr->ref_pic_wrapper = pcs->ppcs->ref_pic_wrapper;
+                picture_demux_results_rtr->scs             = pcs->scs;
+                picture_demux_results_rtr->picture_number  = pcs->picture_number;
+                picture_demux_results_rtr->picture_type    = EB_PIC_REFERENCE;
+
+                // Post Reference Picture
+                svt_post_full_object(picture_demux_results_wrapper_ptr);
             }
         }
-        svt_release_mutex(pcs->rest_search_mutex);
 
-        // Release input Results
-        svt_release_object(cdef_results_wrapper);
+        tile_cols = pcs->ppcs->av1_cm->tiles_info.tile_cols;
+        tile_rows = pcs->ppcs->av1_cm->tiles_info.tile_rows;
+
+        for (int tile_row_idx = 0; tile_row_idx < tile_rows; tile_row_idx++) {
+            for (int tile_col_idx = 0; tile_col_idx < tile_cols; tile_col_idx++) {
+                const int tile_idx = tile_row_idx * tile_cols + tile_col_idx;
+                svt_get_empty_object(context_ptr->rest_output_fifo_ptr, &rest_results_wrapper);
+                rest_results              = (struct RestResults *)rest_results_wrapper->object_ptr;
+                rest_results->pcs_wrapper = cdef_results->pcs_wrapper;
+                rest_results->tile_index  = tile_idx;
+                // Post Rest Results
+                svt_post_full_object(rest_results_wrapper);
+            }
+        }
     }
+    svt_release_mutex(pcs->rest_search_mutex);
 
-    return NULL;
+    // Release input Results
+    svt_release_object(cdef_results_wrapper);
 }
@@ -20,6 +20,6 @@
 extern EbErrorType svt_aom_rest_context_ctor(EbThreadContext *thread_ctx, const EbEncHandle *enc_handle_ptr,
                                              EbPtr object_init_data_ptr, int index, int demux_index);
 
-extern void *svt_aom_rest_kernel(void *input_ptr);
+extern void svt_aom_rest_task(void *input_ptr, EbObjectWrapper *in_wrapper_ptr);
 
 #endif
@@ -44,6 +44,14 @@ typedef struct List0OnlyBase {
     uint8_t list0_only_base_th;
 } List0OnlyBase;
 
+typedef struct RecodeCtrls {
+    // Specifies whether a recode of the frame reuses the partitioning and modes of the previous encoding, redoing
+    // only the quantization, the reconstruction and the rate estimation (0: OFF, 1: ON)
+    uint8_t reuse_md;
+    // Maximum qindex change from the encoding that ran the mode decision; a recode beyond it re-runs the mode decision
+    uint8_t reuse_md_max_qindex_delta;
+} RecodeCtrls;
+
 /************************************
      * Sequence Control Set
      ************************************/
@@ -84,6 +92,9 @@ typedef struct SequenceControlSet {
     /*!< Down-sampling method @ ME and alt-ref temporal filtering
         (The signal changes per preset; 0: filtering, 1: decimation) Default is 0. */
     uint8_t  down_sampling_method_me_search;
+    /*!< Successive elimination of the full-pel open-loop ME positions using the 4x1 sums kept with the PA
+        references (The signal changes per preset; 0: OFF, 1: ON) */
+    uint8_t  me_sea;
     uint32_t svt_aom_geom_idx; //geometry type
 
     /*  1..15    | 17..31  | 33..47  |
@@ -386,6 +397,7 @@ typedef struct SequenceControlSet {
     // Enable low latency KF coding for RTC
     bool          low_latency_kf;
     List0OnlyBase list0_only_base_ctrls;
+    RecodeCtrls   recode_ctrls;
 } SequenceControlSet;
 typedef struct EbSequenceControlSetInstance {
     EbDctor             dctor;
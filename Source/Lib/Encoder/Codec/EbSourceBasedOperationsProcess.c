@@ -34,6 +34,7 @@
 #include "av1me.h"
 #include "EbEncInterPrediction.h"
 #include "EbResize.h"
+#include "EbLadderGroup.h"
 /**************************************
  * Context
  **************************************/
@@ -1342,15 +1343,9 @@ static Bool assign_tpl_segments(EncDecSegments *segmentPtr, uint16_t *segmentInO
 }
 
 /************************************************
- * Genrate TPL MC Flow Dispenser  Based on Lookahead
- ** LAD Window: sliding window size
+ * TPL qindex of a picture, derived from the input QP
  ************************************************/
-
-static void tpl_mc_flow_dispenser(EncodeContext *enc_ctx, SequenceControlSet *scs, int32_t *base_rdmult,
-                                  PictureParentControlSet *pcs, int32_t frame_idx,
-                                  SourceBasedOperationsContext *context_ptr) {
-    EbPictureBufferDesc *recon_pic = enc_ctx->mc_flow_rec_picture_buffer[frame_idx];
-
+static int32_t get_tpl_qindex(SequenceControlSet *scs, PictureParentControlSet *pcs) {
     int32_t qIndex = quantizer_to_qindex[(uint8_t)scs->static_config.qp];
     if (pcs->tpl_ctrls.enable_tpl_qps) {
         const double delta_rate_new[7][6] = {
@@ -1371,7 +1366,21 @@ static void tpl_mc_flow_dispenser(EncodeContext *enc_ctx, SequenceControlSet *sc
                 q_val, q_val * delta_rate_new[pcs->hierarchical_levels][pcs->tpl_data.tpl_temporal_layer_index], 8);
         qIndex = (qIndex + delta_qindex);
     }
-    *base_rdmult = svt_aom_compute_rd_mult_based_on_qindex((EbBitDepth)8, pcs->update_type, qIndex) /
+    return qIndex;
+}
+
+/************************************************
+ * Genrate TPL MC Flow Dispenser  Based on Lookahead
+ ** LAD Window: sliding window size
+ ************************************************/
+
+static void tpl_mc_flow_dispenser(EncodeContext *enc_ctx, SequenceControlSet *scs, int32_t *base_rdmult,
+                                  PictureParentControlSet *pcs, int32_t frame_idx,
+                                  SourceBasedOperationsContext *context_ptr) {
+    EbPictureBufferDesc *recon_pic = enc_ctx->mc_flow_rec_picture_buffer[frame_idx];
+
+    int32_t qIndex = get_tpl_qindex(scs, pcs);
+    *base_rdmult   = svt_aom_compute_rd_mult_based_on_qindex((EbBitDepth)8, pcs->update_type, qIndex) /
         TPL_RDMULT_SCALING_FACTOR;
 
     {
@@ -1803,7 +1812,21 @@ static EbErrorType tpl_mc_flow(EncodeContext *enc_ctx, SequenceControlSet *scs,
     TplRefList tpl_ref_list[REF_FRAMES + 1]; // Buffer for each ref pic and current pic
     memset(tpl_ref_list, 0, sizeof(tpl_ref_list[0]) * (REF_FRAMES + 1));
 
-    if (pcs->tpl_group[0]->tpl_data.tpl_temporal_layer_index == 0) {
+    // Ladder follower: take the costs of the leader TPL model instead of running the dispenser and synthesizer
+    Bool imported = FALSE;
+    if (enc_ctx->ladder_member && pcs->tpl_group[0]->tpl_data.tpl_temporal_layer_index == 0) {
+        imported = svt_aom_ladder_import_tpl(enc_ctx->ladder_member, pcs);
+        for (int32_t frame_idx = 0; imported && frame_idx < frames_in_sw; frame_idx++) {
+            PictureParentControlSet *frame_pcs = pcs->tpl_group[frame_idx];
+            const int32_t            q_index   = get_tpl_qindex(scs, frame_pcs);
+            if (pcs->tpl_valid_pic[frame_idx])
+                frame_pcs->pa_me_data->base_rdmult = svt_aom_compute_rd_mult_based_on_qindex(
+                                                         (EbBitDepth)8, frame_pcs->update_type, q_index) /
+                    TPL_RDMULT_SCALING_FACTOR;
+        }
+    }
+
+    if (!imported && pcs->tpl_group[0]->tpl_data.tpl_temporal_layer_index == 0) {
         // no Tiles path
         if (scs->static_config.tile_rows == 0 && scs->static_config.tile_columns == 0)
             init_tpl_segments(scs, pcs, pcs->tpl_group, frames_in_sw);
@@ -1816,7 +1839,9 @@ static EbErrorType tpl_mc_flow(EncodeContext *enc_ctx, SequenceControlSet *scs,
             // NREF need recon buffer for intra pred
             EbObjectWrapper *ref_pic_wrapper;
             // Get Empty Reference Picture Object
-            svt_get_empty_object(scs->enc_ctx->tpl_reference_picture_pool_fifo_ptr, &ref_pic_wrapper);
+            svt_get_empty_picture_object(scs->enc_ctx->tpl_reference_picture_pool_fifo_ptr,
+                                         pcs->tpl_group[frame_idx]->picture_number,
+                                         &ref_pic_wrapper);
             // if resolution has changed, and the tpl_reference_picture settings do not match scs settings, update tpl reference params
             if (((EbTplReferenceObject *)ref_pic_wrapper->object_ptr)->ref_picture_ptr->max_width !=
                     scs->max_input_luma_width ||
@@ -1937,6 +1962,10 @@ static EbErrorType tpl_mc_flow(EncodeContext *enc_ctx, SequenceControlSet *scs,
         }
     }
 
+    if (enc_ctx->ladder_member && enc_ctx->ladder_member->leader)
+        svt_aom_ladder_publish_tpl(
+            enc_ctx->ladder_member, pcs, pcs->tpl_group[0]->tpl_data.tpl_temporal_layer_index == 0);
+
     // When super-res recode is actived, don't release pa_ref_objs until final loop is finished
     // Although tpl-la won't be enabled in super-res FIXED or RANDOM mode, here we use the condition to align with that in initial rate control process
     Bool release_pa_ref = (scs->static_config.superres_mode <= SUPERRES_RANDOM) ? TRUE : FALSE;
@@ -1962,126 +1991,119 @@ static EbErrorType tpl_mc_flow(EncodeContext *enc_ctx, SequenceControlSet *scs,
    process one picture of TPL group
 */
 
-void *svt_aom_tpl_disp_kernel(void *input_ptr) {
+void svt_aom_tpl_disp_task(void *input_ptr, EbObjectWrapper *in_results_wrapper_ptr) {
     EbThreadContext     *thread_ctx  = (EbThreadContext *)input_ptr;
     TplDispenserContext *context_ptr = (TplDispenserContext *)thread_ctx->priv;
-    EbObjectWrapper     *in_results_wrapper_ptr;
     TplDispResults      *in_results_ptr;
-    for (;;) {
-        // Get Input Full Object
-        EB_GET_FULL_OBJECT(context_ptr->tpl_disp_input_fifo_ptr, &in_results_wrapper_ptr);
-
-        in_results_ptr = (TplDispResults *)in_results_wrapper_ptr->object_ptr;
-
-        PictureParentControlSet *pcs = in_results_ptr->pcs;
-
-        SequenceControlSet *scs = (SequenceControlSet *)pcs->scs;
-
-        int32_t frame_idx           = in_results_ptr->frame_index;
-        context_ptr->coded_sb_count = 0;
-
-        uint16_t tile_group_width_in_sb = pcs->tile_group_info[0 /*context_ptr->tile_group_index*/] //  1 tile
-                                              .tile_group_width_in_sb;
-        EncDecSegments *segments_ptr;
-
-        segments_ptr = pcs->tpl_disp_segment_ctrl[0 /*context_ptr->tile_group_index*/]; //  1 tile
-        // Segments
-        uint16_t segment_index;
-
-        uint8_t  b64_size        = (uint8_t)scs->b64_size;
-        uint8_t  sb_size_log2    = (uint8_t)svt_log2f(b64_size);
-        uint32_t pic_width_in_sb = (pcs->aligned_width + b64_size - 1) >> sb_size_log2;
-
-        segment_index = 0;
-        // no Tiles path
-        if (scs->static_config.tile_rows == 0 && scs->static_config.tile_columns == 0) {
-            // segments loop
-            while (assign_tpl_segments(
-                       segments_ptr, &segment_index, in_results_ptr, frame_idx, context_ptr->tpl_disp_fb_fifo_ptr) ==
-                   TRUE) {
-                uint32_t x_sb_start_index;
-                uint32_t y_sb_start_index;
-                uint32_t sb_start_index;
-                uint32_t sb_segment_count;
-                uint32_t sb_segment_index;
-                uint32_t segment_row_index;
-                uint32_t segment_band_index;
-                uint32_t segment_band_size;
-                // SB Loop variables
-                uint32_t x_sb_index;
-                uint32_t y_sb_index;
-
-                x_sb_start_index = segments_ptr->x_start_array[segment_index];
-                y_sb_start_index = segments_ptr->y_start_array[segment_index];
-                sb_start_index   = y_sb_start_index * tile_group_width_in_sb + x_sb_start_index;
-                sb_segment_count = segments_ptr->valid_sb_count_array[segment_index];
-
-                segment_row_index  = segment_index / segments_ptr->segment_band_count;
-                segment_band_index = segment_index - segment_row_index * segments_ptr->segment_band_count;
-                segment_band_size  = (segments_ptr->sb_band_count * (segment_band_index + 1) +
-                                     segments_ptr->segment_band_count - 1) /
-                    segments_ptr->segment_band_count;
-
-                for (y_sb_index = y_sb_start_index, sb_segment_index = sb_start_index;
+    in_results_ptr = (TplDispResults *)in_results_wrapper_ptr->object_ptr;
+
+    PictureParentControlSet *pcs = in_results_ptr->pcs;
+
+    SequenceControlSet *scs = (SequenceControlSet *)pcs->scs;
+
+    int32_t frame_idx           = in_results_ptr->frame_index;
+    context_ptr->coded_sb_count = 0;
+
+    uint16_t tile_group_width_in_sb = pcs->tile_group_info[0 /*context_ptr->tile_group_index*/] //  1 tile
+                                          .tile_group_width_in_sb;
+    EncDecSegments *segments_ptr;
+
+    segments_ptr = pcs->tpl_disp_segment_ctrl[0 /*context_ptr->tile_group_index*/]; //  1 tile
+    // Segments
+    uint16_t segment_index;
+
+    uint8_t  b64_size        = (uint8_t)scs->b64_size;
+    uint8_t  sb_size_log2    = (uint8_t)svt_log2f(b64_size);
+    uint32_t pic_width_in_sb = (pcs->aligned_width + b64_size - 1) >> sb_size_log2;
+
+    segment_index = 0;
+    // no Tiles path
+    if (scs->static_config.tile_rows == 0 && scs->static_config.tile_columns == 0) {
+        // segments loop
+        while (assign_tpl_segments(
+                   segments_ptr, &segment_index, in_results_ptr, frame_idx, context_ptr->tpl_disp_fb_fifo_ptr) ==
+               TRUE) {
+            uint32_t x_sb_start_index;
+            uint32_t y_sb_start_index;
+            uint32_t sb_start_index;
+            uint32_t sb_segment_count;
+            uint32_t sb_segment_index;
+            uint32_t segment_row_index;
+            uint32_t segment_band_index;
+            uint32_t segment_band_size;
+            // SB Loop variables
+            uint32_t x_sb_index;
+            uint32_t y_sb_index;
+
+            x_sb_start_index = segments_ptr->x_start_array[segment_index];
+            y_sb_start_index = segments_ptr->y_start_array[segment_index];
+            sb_start_index   = y_sb_start_index * tile_group_width_in_sb + x_sb_start_index;
+            sb_segment_count = segments_ptr->valid_sb_count_array[segment_index];
+
+            segment_row_index  = segment_index / segments_ptr->segment_band_count;
+            segment_band_index = segment_index - segment_row_index * segments_ptr->segment_band_count;
+            segment_band_size  = (segments_ptr->sb_band_count * (segment_band_index + 1) +
+                                 segments_ptr->segment_band_count - 1) /
+                segments_ptr->segment_band_count;
+
+            for (y_sb_index = y_sb_start_index, sb_segment_index = sb_start_index;
+                 sb_segment_index < sb_start_index + sb_segment_count;
+                 ++y_sb_index) {
+                for (x_sb_index = x_sb_start_index;
+                     x_sb_index < tile_group_width_in_sb && (x_sb_index + y_sb_index < segment_band_size) &&
                      sb_segment_index < sb_start_index + sb_segment_count;
-                     ++y_sb_index) {
-                    for (x_sb_index = x_sb_start_index;
-                         x_sb_index < tile_group_width_in_sb && (x_sb_index + y_sb_index < segment_band_size) &&
-                         sb_segment_index < sb_start_index + sb_segment_count;
-                         ++x_sb_index, ++sb_segment_index) {
-                        uint16_t tile_group_y_sb_start =
-                            pcs->tile_group_info[0 /*context_ptr->tile_group_index*/] //  1 tile
-                                .tile_group_sb_start_y;
-                        uint16_t tile_group_x_sb_start =
-                            pcs->tile_group_info[0 /*context_ptr->tile_group_index*/] //  1 tile
-                                .tile_group_sb_start_x;
-
-                        context_ptr->sb_index = (uint16_t)((y_sb_index + tile_group_y_sb_start) * pic_width_in_sb +
-                                                           x_sb_index + tile_group_x_sb_start);
-
-                        // TPL dispenser per SB (64)
-                        B64Geom *b64_geom = &scs->b64_geom[context_ptr->sb_index];
-                        tpl_mc_flow_dispenser_sb_generic(pcs->scs->enc_ctx,
-                                                         scs,
-                                                         pcs,
-                                                         frame_idx,
-                                                         context_ptr->sb_index,
-                                                         in_results_ptr->qIndex,
-                                                         (b64_geom->width == 64 && b64_geom->height == 64)
-                                                             ? pcs->tpl_ctrls.dispenser_search_level
-                                                             : 0);
-                        context_ptr->coded_sb_count++;
-                    }
-
-                    x_sb_start_index = (x_sb_start_index > 0) ? x_sb_start_index - 1 : 0;
+                     ++x_sb_index, ++sb_segment_index) {
+                    uint16_t tile_group_y_sb_start =
+                        pcs->tile_group_info[0 /*context_ptr->tile_group_index*/] //  1 tile
+                            .tile_group_sb_start_y;
+                    uint16_t tile_group_x_sb_start =
+                        pcs->tile_group_info[0 /*context_ptr->tile_group_index*/] //  1 tile
+                            .tile_group_sb_start_x;
+
+                    context_ptr->sb_index = (uint16_t)((y_sb_index + tile_group_y_sb_start) * pic_width_in_sb +
+                                                       x_sb_index + tile_group_x_sb_start);
+
+                    // TPL dispenser per SB (64)
+                    B64Geom *b64_geom = &scs->b64_geom[context_ptr->sb_index];
+                    tpl_mc_flow_dispenser_sb_generic(pcs->scs->enc_ctx,
+                                                     scs,
+                                                     pcs,
+                                                     frame_idx,
+                                                     context_ptr->sb_index,
+                                                     in_results_ptr->qIndex,
+                                                     (b64_geom->width == 64 && b64_geom->height == 64)
+                                                         ? pcs->tpl_ctrls.dispenser_search_level
+                                                         : 0);
+                    context_ptr->coded_sb_count++;
                 }
+
+                x_sb_start_index = (x_sb_start_index > 0) ? x_sb_start_index - 1 : 0;
             }
+        }
 
-            svt_block_on_mutex(pcs->tpl_disp_mutex);
-            pcs->tpl_disp_coded_sb_count += (uint32_t)context_ptr->coded_sb_count;
-            Bool last_sb_flag = (pcs->b64_total_count == pcs->tpl_disp_coded_sb_count);
+        svt_block_on_mutex(pcs->tpl_disp_mutex);
+        pcs->tpl_disp_coded_sb_count += (uint32_t)context_ptr->coded_sb_count;
+        Bool last_sb_flag = (pcs->b64_total_count == pcs->tpl_disp_coded_sb_count);
 
-            svt_release_mutex(pcs->tpl_disp_mutex);
-            if (last_sb_flag)
-                svt_post_semaphore(pcs->tpl_disp_done_semaphore);
-        } else {
-            // Tiles path does not suupport segments
-            for (uint32_t sb_index = 0; sb_index < pcs->b64_total_count; ++sb_index) {
-                B64Geom *b64_geom = &scs->b64_geom[sb_index];
-                tpl_mc_flow_dispenser_sb_generic(
-                    pcs->scs->enc_ctx,
-                    scs,
-                    pcs,
-                    frame_idx,
-                    sb_index,
-                    in_results_ptr->qIndex,
-                    (b64_geom->width == 64 && b64_geom->height == 64) ? pcs->tpl_ctrls.dispenser_search_level : 0);
-            }
+        svt_release_mutex(pcs->tpl_disp_mutex);
+        if (last_sb_flag)
             svt_post_semaphore(pcs->tpl_disp_done_semaphore);
+    } else {
+        // Tiles path does not suupport segments
+        for (uint32_t sb_index = 0; sb_index < pcs->b64_total_count; ++sb_index) {
+            B64Geom *b64_geom = &scs->b64_geom[sb_index];
+            tpl_mc_flow_dispenser_sb_generic(
+                pcs->scs->enc_ctx,
+                scs,
+                pcs,
+                frame_idx,
+                sb_index,
+                in_results_ptr->qIndex,
+                (b64_geom->width == 64 && b64_geom->height == 64) ? pcs->tpl_ctrls.dispenser_search_level : 0);
         }
-        svt_release_object(in_results_wrapper_ptr);
+        svt_post_semaphore(pcs->tpl_disp_done_semaphore);
     }
-    return NULL;
+    svt_release_object(in_results_wrapper_ptr);
 }
 
 static void sbo_send_picture_out(SourceBasedOperationsContext *context_ptr, PictureParentControlSet *pcs,
@@ -2231,11 +2253,13 @@ void *svt_aom_source_based_operations_kernel(void *input_ptr) {
         }
 
         // Get TPL ME
+        Bool tpl_run = FALSE;
         if (pcs->tpl_ctrls.enable) {
             // tpl ME can be performed on unscaled frames in super-res q-threshold and auto mode
             if (!pcs->frame_superres_enabled && pcs->temporal_layer_index == 0) {
                 tpl_prep_info(pcs);
                 tpl_mc_flow(scs->enc_ctx, scs, pcs, context_ptr);
+                tpl_run = TRUE;
             }
             Bool release_pa_ref = (scs->static_config.superres_mode <= SUPERRES_RANDOM) ? TRUE : FALSE;
             // Release Pa Ref if lad_mg is 0 and P slice and not flat struct (not belonging to any TPL group)
@@ -2244,6 +2268,15 @@ void *svt_aom_source_based_operations_kernel(void *input_ptr) {
                 // printf ("\n PIC \t %d\n",pcs->picture_number);
             }
         }
+        // Let the ladder followers go past the base pictures the leader has no TPL costs for
+        LadderMember *ladder_member = scs->enc_ctx->ladder_member;
+        if (ladder_member && pcs->temporal_layer_index == 0) {
+            if (ladder_member->leader && !tpl_run)
+                svt_aom_ladder_publish_tpl(ladder_member, pcs, FALSE);
+            svt_aom_ladder_pass(ladder_member, pcs->picture_number);
+        }
+        if (ladder_member && ladder_member->leader && pcs->end_of_sequence_flag)
+            svt_aom_ladder_end_of_sequence(ladder_member);
         /*********************************************Picture-based operations**********************************************************/
         if (scs->static_config.tune == 2) {
             aom_av1_set_mb_ssim_rdmult_scaling(pcs);
@@ -20,7 +20,7 @@
  ***************************************/
 EbErrorType  svt_aom_tpl_disp_context_ctor(EbThreadContext *thread_ctx, const EbEncHandle *enc_handle_ptr, int index,
                                            int tasks_index);
-extern void *svt_aom_tpl_disp_kernel(void *input_ptr);
+extern void svt_aom_tpl_disp_task(void *input_ptr, EbObjectWrapper *in_wrapper_ptr);
 void         generate_lambda_scaling_factor(PictureParentControlSet *pcs, int64_t mc_dep_cost_base);
 void         svt_aom_generate_r0beta(PictureParentControlSet *pcs);
 EbErrorType svt_aom_source_based_operations_context_ctor(EbThreadContext *thread_ctx, const EbEncHandle *enc_handle_ptr,
@@ -2731,6 +2731,53 @@ static void convert_64x64_info_to_32x32_info(
         }
     }
 }
+/*
+ * Prepare the motion field of the centre picture: slots for its closest neighbours, no block searched yet
+ */
+static void tf_mv_field_init(PictureParentControlSet **pcs_list, PictureParentControlSet *centre_pcs) {
+    TfMvField *field = &((EbPaReferenceObject *)centre_pcs->pa_ref_pic_wrapper->object_ptr)->tf_mv_field;
+
+    field->src_poc = (uint64_t)~0;
+    if (!field->mv)
+        return;
+    const int index_center = centre_pcs->past_altref_nframes;
+    int       slot         = 0;
+    for (int dist = 1;
+         slot < TF_MV_FIELD_REFS &&
+         (dist <= centre_pcs->past_altref_nframes || dist <= centre_pcs->future_altref_nframes);
+         dist++) {
+        if (dist <= centre_pcs->past_altref_nframes)
+            field->ref_poc[slot++] = pcs_list[index_center - dist]->picture_number;
+        if (dist <= centre_pcs->future_altref_nframes && slot < TF_MV_FIELD_REFS)
+            field->ref_poc[slot++] = pcs_list[index_center + dist]->picture_number;
+    }
+    for (; slot < TF_MV_FIELD_REFS; slot++) field->ref_poc[slot] = (uint64_t)~0;
+    for (uint32_t i = 0; i < TF_MV_FIELD_REFS * field->b64_count; i++) field->mv[i].as_int = INVALID_MV;
+}
+
+/*
+ * Keep the full-pel 64x64 MV found for the current block, the one the 64x64 sub-pel search starts from
+ */
+static void tf_mv_field_store(PictureParentControlSet *centre_pcs, PictureParentControlSet *ref_pcs, MeContext *me_ctx,
+                              uint32_t b64_index) {
+    TfMvField *field = &((EbPaReferenceObject *)centre_pcs->pa_ref_pic_wrapper->object_ptr)->tf_mv_field;
+    if (!field->mv || b64_index >= field->b64_count)
+        return;
+    for (int i = 0; i < TF_MV_FIELD_REFS; i++) {
+        if (field->ref_poc[i] == ref_pcs->picture_number) {
+            Mv *mv = &field->mv[i * field->b64_count + b64_index];
+            if (me_ctx->tf_use_pred_64x64_only_th == (uint8_t)~0) {
+                mv->x = me_ctx->search_results[0][0].hme_sc_x;
+                mv->y = me_ctx->search_results[0][0].hme_sc_y;
+            } else {
+                mv->x = _MVXT(me_ctx->p_best_mv64x64[0]);
+                mv->y = _MVYT(me_ctx->p_best_mv64x64[0]);
+            }
+            return;
+        }
+    }
+}
+
 static void set_hme_search_params_mctf(MeContext *ctx, uint8_t hme_search_level) {
 
     switch (hme_search_level) {
@@ -3069,6 +3116,7 @@ static EbErrorType produce_temporally_filtered_pic(
                         (uint32_t)blk_row * BH, // y block
                         ctx,
                         input_picture_ptr_central); // source picture
+                    tf_mv_field_store(centre_pcs, pcs_list[frame_index], ctx, (uint32_t)blk_row * blk_cols + blk_col);
 
 
                     if (ctx->tf_use_pred_64x64_only_th &&
@@ -3772,6 +3820,7 @@ void pad_and_decimate_filtered_pic(PictureParentControlSet *centre_pcs) {
                                             src_object->quarter_downsampled_picture_ptr,
                                             src_object->sixteenth_downsampled_picture_ptr);
     }
+    svt_aom_generate_me_sum_4x1(src_object);
 }
 
 // save original enchanced_picture_ptr buffer in a separate buffer (to be replaced by the temporally filtered pic)
@@ -4007,6 +4056,7 @@ EbErrorType svt_av1_init_temporal_filtering(
 
         centre_pcs->do_tf =
             TRUE; // set temporal filtering flag ON for current picture
+        tf_mv_field_init(pcs_list, centre_pcs);
 
         // save original source picture (to be replaced by the temporally filtered pic)
         // if stat_report is enabled for PSNR computation
@@ -4125,6 +4175,10 @@ EbErrorType svt_av1_init_temporal_filtering(
 
         // padding + decimation: even if highbd src, this is only performed on the 8 bit buffer (excluding the LSBs)
         pad_and_decimate_filtered_pic(centre_pcs);
+        // the motion field can be used by the ME of the pictures once all the segments are done
+        EbPaReferenceObject *pa_ref_obj = (EbPaReferenceObject *)centre_pcs->pa_ref_pic_wrapper->object_ptr;
+        if (pa_ref_obj->tf_mv_field.mv)
+            pa_ref_obj->tf_mv_field.src_poc = centre_pcs->picture_number;
         if (centre_pcs->slice_type == I_SLICE)
         {
 
@@ -743,6 +743,8 @@ void svt_aom_sig_deriv_me(SequenceControlSet *scs, PictureParentControlSet *pcs,
     } else {
         me_ctx->prev_me_stage_based_exit_th = 0;
     }
+    me_ctx->tf_mv_seed = getenv("TFS") ? atoi(getenv("TFS")) : 1;
+    me_ctx->me_sea     = scs->me_sea;
 };
 /******************************************************
 * Derive ME Settings for OQ for Altref Temporal Filtering
@@ -792,6 +794,8 @@ void svt_aom_sig_deriv_me_tf(PictureParentControlSet *pcs, MeContext *me_ctx) {
     me_ctx->prev_me_stage_based_exit_th = enc_mode <= ENC_M7 || resolution <= INPUT_SIZE_720p_RANGE
         ? 0
         : BLOCK_SIZE_64 * BLOCK_SIZE_64 * 4;
+    me_ctx->tf_mv_seed = 0;
+    me_ctx->me_sea     = 0;
 };
 static void set_cdef_controls(PictureParentControlSet *pcs, uint8_t cdef_level, Bool fast_decode) {
     CdefControls *cdef_ctrls = &pcs->cdef_ctrls;
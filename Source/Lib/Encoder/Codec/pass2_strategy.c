@@ -1281,6 +1281,9 @@ void svt_av1_init_second_pass(SequenceControlSet *scs) {
     // first pass.
     svt_av1_new_framerate(scs, frame_rate);
     twopass->bits_left = (int64_t)(stats->duration * (int64_t)scs->static_config.target_bit_rate / 10000000.0);
+    // A chunk of a chunked encode gets the share of the budget of the whole input its frames earned
+    if (enc_ctx->rc_stats_chunk)
+        twopass->bits_left = enc_ctx->rc_stats_chunk_bits;
     read_stat_from_file(scs);
 
     // Scan the first pass file and calculate a modified total error based upon
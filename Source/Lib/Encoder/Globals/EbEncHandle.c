@@ -21,6 +21,9 @@
 
 #include "EbVersion.h"
 #include "EbThreads.h"
+#include "EbTaskScheduler.h"
+#include "EbLadderGroup.h"
+#include "EbPipelineProfiler.h"
 #include "EbUtility.h"
 #include "EbEncHandle.h"
 #include "EbEncSettings.h"
@@ -96,6 +99,7 @@
 #define EB_PictureManagerProcessInitCount               1
 #define EB_RateControlProcessInitCount                  1
 #define EB_PacketizationProcessInitCount                1
+#define EB_TaskSchedulerTaskTypeCount                   9
 
 // Output Buffer Transfer Parameters
 #define TPL_INPUT_PORT_SOP                                0
@@ -734,6 +738,9 @@ static EbErrorType load_default_buffer_configuration_settings(
         scs->me_pool_init_count = clamp(max_me, min_me, max_me);
         scs->overlay_input_picture_buffer_init_count = min_overlay;
     }
+    // the reference objects hold the PA reference of their picture for the global motion ref info
+    if (svt_aom_need_gm_ref_info(scs->static_config.enc_mode, scs->static_config.resize_mode == RESIZE_NONE))
+        scs->pa_reference_picture_buffer_init_count += scs->reference_picture_buffer_init_count;
 
     //#====================== Inter process Fifos ======================
     scs->resource_coordination_fifo_init_count       = 300;
@@ -1003,62 +1010,279 @@ static void lib_svt_encoder_send_error_exit(
     EbPtr                    hComponent,
     uint32_t                 error_code);
 
+/**********************************
+* Task scheduler worker creation, the workers are pinned like the stage threads
+**********************************/
+static EbErrorType enc_create_worker_thread(EbHandle *thread_handle, void *thread_function(void *),
+    void *thread_context)
+{
+    EB_CREATE_THREAD(*thread_handle, thread_function, thread_context);
+    return EB_ErrorNone;
+}
+
+/**********************************
+* Task affinities, the stages of a picture are routed by picture number
+**********************************/
+static uint64_t picture_analysis_affinity(EbObjectWrapper *wrapper_ptr) {
+    ResourceCoordinationResults *results = (ResourceCoordinationResults *)wrapper_ptr->object_ptr;
+    return ((PictureParentControlSet *)results->pcs_wrapper->object_ptr)->picture_number;
+}
+static uint64_t motion_estimation_affinity(EbObjectWrapper *wrapper_ptr) {
+    PictureDecisionResults *results = (PictureDecisionResults *)wrapper_ptr->object_ptr;
+    return ((PictureParentControlSet *)results->pcs_wrapper->object_ptr)->picture_number;
+}
+static uint64_t tpl_disp_affinity(EbObjectWrapper *wrapper_ptr) {
+    return ((TplDispResults *)wrapper_ptr->object_ptr)->pcs->picture_number;
+}
+static uint64_t mode_decision_configuration_affinity(EbObjectWrapper *wrapper_ptr) {
+    RateControlResults *results = (RateControlResults *)wrapper_ptr->object_ptr;
+    return ((PictureControlSet *)results->pcs_wrapper->object_ptr)->picture_number;
+}
+static uint64_t enc_dec_affinity(EbObjectWrapper *wrapper_ptr) {
+    EncDecTasks *tasks = (EncDecTasks *)wrapper_ptr->object_ptr;
+    return ((PictureControlSet *)tasks->pcs_wrapper->object_ptr)->picture_number;
+}
+static uint64_t dlf_affinity(EbObjectWrapper *wrapper_ptr) {
+    EncDecResults *results = (EncDecResults *)wrapper_ptr->object_ptr;
+    return ((PictureControlSet *)results->pcs_wrapper->object_ptr)->picture_number;
+}
+static uint64_t cdef_affinity(EbObjectWrapper *wrapper_ptr) {
+    DlfResults *results = (DlfResults *)wrapper_ptr->object_ptr;
+    return ((PictureControlSet *)results->pcs_wrapper->object_ptr)->picture_number;
+}
+static uint64_t rest_affinity(EbObjectWrapper *wrapper_ptr) {
+    CdefResults *results = (CdefResults *)wrapper_ptr->object_ptr;
+    return ((PictureControlSet *)results->pcs_wrapper->object_ptr)->picture_number;
+}
+static uint64_t entropy_coding_affinity(EbObjectWrapper *wrapper_ptr) {
+    RestResults *results = (RestResults *)wrapper_ptr->object_ptr;
+    return ((PictureControlSet *)results->pcs_wrapper->object_ptr)->picture_number;
+}
+
+/**********************************
+* Pipeline profiler, one stage per process input SystemResource
+**********************************/
+typedef enum EbPipelineStage {
+    PIPELINE_STAGE_RESOURCE_COORDINATION,
+    PIPELINE_STAGE_PICTURE_ANALYSIS,
+    PIPELINE_STAGE_PICTURE_DECISION,
+    PIPELINE_STAGE_MOTION_ESTIMATION,
+    PIPELINE_STAGE_INITIAL_RATE_CONTROL,
+    PIPELINE_STAGE_SOURCE_BASED_OPERATIONS,
+    PIPELINE_STAGE_TPL_DISPENSER,
+    PIPELINE_STAGE_PICTURE_MANAGER,
+    PIPELINE_STAGE_RATE_CONTROL,
+    PIPELINE_STAGE_MODE_DECISION_CONFIGURATION,
+    PIPELINE_STAGE_ENC_DEC,
+    PIPELINE_STAGE_DLF,
+    PIPELINE_STAGE_CDEF,
+    PIPELINE_STAGE_REST,
+    PIPELINE_STAGE_ENTROPY_CODING,
+    PIPELINE_STAGE_PACKETIZATION,
+    PIPELINE_STAGE_COUNT
+} EbPipelineStage;
+
+static const char *const pipeline_stage_names[PIPELINE_STAGE_COUNT] = {
+    "RSC", "PA", "PD", "ME", "IRC", "SBO", "TPL", "PM", "RC", "MDC", "ENCDEC", "DLF", "CDEF", "REST", "EC", "PAK"};
+
+// Picture number of the objects of each stage, the pcs_wrapper of the results
+// points to the PictureParentControlSet up to the Picture Manager and to the
+// PictureControlSet past it
+static uint64_t picture_analysis_results_picture_number(void *object_ptr) {
+    EbObjectWrapper *pcs_wrapper = ((PictureAnalysisResults *)object_ptr)->pcs_wrapper;
+    return pcs_wrapper ? ((PictureParentControlSet *)pcs_wrapper->object_ptr)->picture_number : PIPELINE_NO_PICTURE;
+}
+static uint64_t enc_dec_results_picture_number(void *object_ptr) {
+    EbObjectWrapper *pcs_wrapper = ((EncDecResults *)object_ptr)->pcs_wrapper;
+    return pcs_wrapper ? ((PictureControlSet *)pcs_wrapper->object_ptr)->picture_number : PIPELINE_NO_PICTURE;
+}
+static uint64_t resource_coordination_results_picture_number(void *object_ptr) {
+    EbObjectWrapper *pcs_wrapper = ((ResourceCoordinationResults *)object_ptr)->pcs_wrapper;
+    return pcs_wrapper ? ((PictureParentControlSet *)pcs_wrapper->object_ptr)->picture_number : PIPELINE_NO_PICTURE;
+}
+static uint64_t picture_decision_results_picture_number(void *object_ptr) {
+    EbObjectWrapper *pcs_wrapper = ((PictureDecisionResults *)object_ptr)->pcs_wrapper;
+    return pcs_wrapper ? ((PictureParentControlSet *)pcs_wrapper->object_ptr)->picture_number : PIPELINE_NO_PICTURE;
+}
+static uint64_t motion_estimation_results_picture_number(void *object_ptr) {
+    EbObjectWrapper *pcs_wrapper = ((MotionEstimationResults *)object_ptr)->pcs_wrapper;
+    return pcs_wrapper ? ((PictureParentControlSet *)pcs_wrapper->object_ptr)->picture_number : PIPELINE_NO_PICTURE;
+}
+static uint64_t initial_rate_control_results_picture_number(void *object_ptr) {
+    EbObjectWrapper *pcs_wrapper = ((InitialRateControlResults *)object_ptr)->pcs_wrapper;
+    return pcs_wrapper ? ((PictureParentControlSet *)pcs_wrapper->object_ptr)->picture_number : PIPELINE_NO_PICTURE;
+}
+static uint64_t tpl_disp_results_picture_number(void *object_ptr) {
+    PictureParentControlSet *pcs = ((TplDispResults *)object_ptr)->pcs;
+    return pcs ? pcs->picture_number : PIPELINE_NO_PICTURE;
+}
+static uint64_t picture_demux_results_picture_number(void *object_ptr) {
+    PictureDemuxResults *results = (PictureDemuxResults *)object_ptr;
+    if (results->picture_type == EB_PIC_INPUT)
+        return results->pcs_wrapper ? ((PictureParentControlSet *)results->pcs_wrapper->object_ptr)->picture_number
+                                    : PIPELINE_NO_PICTURE;
+    return results->picture_number;
+}
+static uint64_t rate_control_tasks_picture_number(void *object_ptr) {
+    RateControlTasks *tasks = (RateControlTasks *)object_ptr;
+    if (!tasks->pcs_wrapper)
+        return PIPELINE_NO_PICTURE;
+    // The packetization feedback carries the parent, the inputs the child
+    if (tasks->task_type == RC_PACKETIZATION_FEEDBACK_RESULT)
+        return ((PictureParentControlSet *)tasks->pcs_wrapper->object_ptr)->picture_number;
+    return ((PictureControlSet *)tasks->pcs_wrapper->object_ptr)->picture_number;
+}
+static uint64_t rate_control_results_picture_number(void *object_ptr) {
+    EbObjectWrapper *pcs_wrapper = ((RateControlResults *)object_ptr)->pcs_wrapper;
+    return pcs_wrapper ? ((PictureControlSet *)pcs_wrapper->object_ptr)->picture_number : PIPELINE_NO_PICTURE;
+}
+static uint64_t enc_dec_tasks_picture_number(void *object_ptr) {
+    EbObjectWrapper *pcs_wrapper = ((EncDecTasks *)object_ptr)->pcs_wrapper;
+    return pcs_wrapper ? ((PictureControlSet *)pcs_wrapper->object_ptr)->picture_number : PIPELINE_NO_PICTURE;
+}
+static uint64_t dlf_results_picture_number(void *object_ptr) {
+    EbObjectWrapper *pcs_wrapper = ((DlfResults *)object_ptr)->pcs_wrapper;
+    return pcs_wrapper ? ((PictureControlSet *)pcs_wrapper->object_ptr)->picture_number : PIPELINE_NO_PICTURE;
+}
+static uint64_t cdef_results_picture_number(void *object_ptr) {
+    EbObjectWrapper *pcs_wrapper = ((CdefResults *)object_ptr)->pcs_wrapper;
+    return pcs_wrapper ? ((PictureControlSet *)pcs_wrapper->object_ptr)->picture_number : PIPELINE_NO_PICTURE;
+}
+static uint64_t rest_results_picture_number(void *object_ptr) {
+    EbObjectWrapper *pcs_wrapper = ((RestResults *)object_ptr)->pcs_wrapper;
+    return pcs_wrapper ? ((PictureControlSet *)pcs_wrapper->object_ptr)->picture_number : PIPELINE_NO_PICTURE;
+}
+static uint64_t entropy_coding_results_picture_number(void *object_ptr) {
+    EbObjectWrapper *pcs_wrapper = ((EntropyCodingResults *)object_ptr)->pcs_wrapper;
+    return pcs_wrapper ? ((PictureControlSet *)pcs_wrapper->object_ptr)->picture_number : PIPELINE_NO_PICTURE;
+}
+
+static void enc_profile_stage(EbEncHandle *enc_handle_ptr, EbSystemResource *resource_ptr, EbPipelineStage stage,
+    uint64_t (*picture_number_cb)(void *object_ptr))
+{
+    resource_ptr->profiler_ptr             = enc_handle_ptr->pipeline_profiler_ptr;
+    resource_ptr->profiler_stage           = stage;
+    resource_ptr->object_picture_number_cb = picture_number_cb;
+}
+
+static EbErrorType enc_create_pipeline_profiler(EbEncHandle *enc_handle_ptr, const char *trace_file)
+{
+    EB_NEW(enc_handle_ptr->pipeline_profiler_ptr, svt_pipeline_profiler_ctor, trace_file, pipeline_stage_names,
+        PIPELINE_STAGE_COUNT);
+
+    enc_profile_stage(enc_handle_ptr, enc_handle_ptr->input_cmd_resource_ptr,
+        PIPELINE_STAGE_RESOURCE_COORDINATION, NULL);
+    enc_profile_stage(enc_handle_ptr, enc_handle_ptr->resource_coordination_results_resource_ptr,
+        PIPELINE_STAGE_PICTURE_ANALYSIS, resource_coordination_results_picture_number);
+    enc_profile_stage(enc_handle_ptr, enc_handle_ptr->picture_analysis_results_resource_ptr,
+        PIPELINE_STAGE_PICTURE_DECISION, picture_analysis_results_picture_number);
+    enc_profile_stage(enc_handle_ptr, enc_handle_ptr->picture_decision_results_resource_ptr,
+        PIPELINE_STAGE_MOTION_ESTIMATION, picture_decision_results_picture_number);
+    enc_profile_stage(enc_handle_ptr, enc_handle_ptr->motion_estimation_results_resource_ptr,
+        PIPELINE_STAGE_INITIAL_RATE_CONTROL, motion_estimation_results_picture_number);
+    enc_profile_stage(enc_handle_ptr, enc_handle_ptr->initial_rate_control_results_resource_ptr,
+        PIPELINE_STAGE_SOURCE_BASED_OPERATIONS, initial_rate_control_results_picture_number);
+    enc_profile_stage(enc_handle_ptr, enc_handle_ptr->tpl_disp_res_srm,
+        PIPELINE_STAGE_TPL_DISPENSER, tpl_disp_results_picture_number);
+    enc_profile_stage(enc_handle_ptr, enc_handle_ptr->picture_demux_results_resource_ptr,
+        PIPELINE_STAGE_PICTURE_MANAGER, picture_demux_results_picture_number);
+    enc_profile_stage(enc_handle_ptr, enc_handle_ptr->rate_control_tasks_resource_ptr,
+        PIPELINE_STAGE_RATE_CONTROL, rate_control_tasks_picture_number);
+    enc_profile_stage(enc_handle_ptr, enc_handle_ptr->rate_control_results_resource_ptr,
+        PIPELINE_STAGE_MODE_DECISION_CONFIGURATION, rate_control_results_picture_number);
+    enc_profile_stage(enc_handle_ptr, enc_handle_ptr->enc_dec_tasks_resource_ptr,
+        PIPELINE_STAGE_ENC_DEC, enc_dec_tasks_picture_number);
+    enc_profile_stage(enc_handle_ptr, enc_handle_ptr->enc_dec_results_resource_ptr,
+        PIPELINE_STAGE_DLF, enc_dec_results_picture_number);
+    enc_profile_stage(enc_handle_ptr, enc_handle_ptr->dlf_results_resource_ptr,
+        PIPELINE_STAGE_CDEF, dlf_results_picture_number);
+    enc_profile_stage(enc_handle_ptr, enc_handle_ptr->cdef_results_resource_ptr,
+        PIPELINE_STAGE_REST, cdef_results_picture_number);
+    enc_profile_stage(enc_handle_ptr, enc_handle_ptr->rest_results_resource_ptr,
+        PIPELINE_STAGE_ENTROPY_CODING, rest_results_picture_number);
+    enc_profile_stage(enc_handle_ptr, enc_handle_ptr->entropy_coding_results_resource_ptr,
+        PIPELINE_STAGE_PACKETIZATION, entropy_coding_results_picture_number);
+    return EB_ErrorNone;
+}
+
 static void svt_enc_handle_stop_threads(EbEncHandle *enc_handle_ptr)
 {
     SequenceControlSet*  control_set_ptr = enc_handle_ptr->scs_instance_array[0]->scs;
     // Resource Coordination
     EB_DESTROY_THREAD(enc_handle_ptr->resource_coordination_thread_handle);
-    EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->picture_analysis_thread_handle_array,control_set_ptr->picture_analysis_process_init_count);
 
     // Picture Decision
     EB_DESTROY_THREAD(enc_handle_ptr->picture_decision_thread_handle);
 
-    // Motion Estimation
-    EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->motion_estimation_thread_handle_array, control_set_ptr->motion_estimation_process_init_count);
-
     // Initial Rate Control
     EB_DESTROY_THREAD(enc_handle_ptr->initial_rate_control_thread_handle);
 
     // Source Based Oprations
     EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->source_based_operations_thread_handle_array, control_set_ptr->source_based_operations_process_init_count);
 
-    // TPL dispenser ME
-    EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->tpl_disp_thread_handle_array, control_set_ptr->tpl_disp_process_init_count);
-
     // Picture Manager
     EB_DESTROY_THREAD(enc_handle_ptr->picture_manager_thread_handle);
 
     // Rate Control
     EB_DESTROY_THREAD(enc_handle_ptr->rate_control_thread_handle);
 
-    // Mode Decision Configuration Process
-    EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->mode_decision_configuration_thread_handle_array, control_set_ptr->mode_decision_configuration_process_init_count);
-
-    // EncDec Process
-    EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->enc_dec_thread_handle_array, control_set_ptr->enc_dec_process_init_count);
-
-    // Dlf Process
-    EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->dlf_thread_handle_array, control_set_ptr->dlf_process_init_count);
-
-    // Cdef Process
-    EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->cdef_thread_handle_array, control_set_ptr->cdef_process_init_count);
-
-    // Rest Process
-    EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->rest_thread_handle_array, control_set_ptr->rest_process_init_count);
-
-    // Entropy Coding Process
-    EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->entropy_coding_thread_handle_array, control_set_ptr->entropy_coding_process_init_count);
+    // Picture Analysis, Motion Estimation, TPL dispenser, Mode Decision Configuration,
+    // EncDec, Dlf, Cdef, Rest and Entropy Coding workers
+    EB_DELETE(enc_handle_ptr->task_scheduler_ptr);
 
     // Packetization
     EB_DESTROY_THREAD(enc_handle_ptr->packetization_thread_handle);
+
+    // Exports the trace once no stage runs anymore
+    EB_DELETE(enc_handle_ptr->pipeline_profiler_ptr);
 }
 /**********************************
 * Encoder Library Handle Deonstructor
 **********************************/
+/* Prints the buffers of a picture pool spread over NUMA nodes, per node, and how
+   often a picture got a buffer of its node */
+static void numa_picture_pool_report(const char *name, const EbSystemResource *resource_ptr) {
+    if (!resource_ptr || !resource_ptr->node_count)
+        return;
+    for (uint32_t node_slot = 0; node_slot < resource_ptr->node_count; ++node_slot) {
+        uint32_t object_count = 0;
+        for (uint32_t w_i = 0; w_i < resource_ptr->object_total_count; ++w_i)
+            object_count += resource_ptr->wrapper_ptr_pool[w_i]->node_id == resource_ptr->node_array[node_slot];
+        SVT_INFO("%s pool: node %u: %u buffers, %.1f MB bound\n",
+                 name,
+                 resource_ptr->node_array[node_slot],
+                 object_count,
+                 resource_ptr->node_bytes[node_slot] / (1024.0 * 1024.0));
+    }
+    SVT_INFO("%s pool: %.1f MB unbound, %d buffers handed out on the picture node, %d on another node\n",
+             name,
+             resource_ptr->unbound_bytes / (1024.0 * 1024.0),
+             resource_ptr->node_local_count,
+             resource_ptr->node_remote_count);
+}
+
 static void svt_enc_handle_dctor(EbPtr p)
 {
     EbEncHandle *enc_handle_ptr = (EbEncHandle *)p;
     svt_enc_handle_stop_threads(enc_handle_ptr);
+    svt_arena_stats_report(&enc_handle_ptr->na_arena_stats);
+    svt_arena_stats_report(&enc_handle_ptr->me_arena_stats);
+    if (enc_handle_ptr->numa_node_count) {
+        numa_picture_pool_report("input", enc_handle_ptr->input_buffer_resource_ptr);
+        numa_picture_pool_report("input luma", enc_handle_ptr->input_y8b_buffer_resource_ptr);
+        for (uint32_t instance_index = 0; instance_index < enc_handle_ptr->encode_instance_total_count;
+             ++instance_index) {
+            if (enc_handle_ptr->pa_reference_picture_pool_ptr_array)
+                numa_picture_pool_report("pa reference",
+                                         enc_handle_ptr->pa_reference_picture_pool_ptr_array[instance_index]);
+            if (enc_handle_ptr->tpl_reference_picture_pool_ptr_array)
+                numa_picture_pool_report("tpl reference",
+                                         enc_handle_ptr->tpl_reference_picture_pool_ptr_array[instance_index]);
+            if (enc_handle_ptr->reference_picture_pool_ptr_array)
+                numa_picture_pool_report("reference",
+                                         enc_handle_ptr->reference_picture_pool_ptr_array[instance_index]);
+        }
+    }
     EB_FREE_PTR_ARRAY(enc_handle_ptr->app_callback_ptr_array, enc_handle_ptr->encode_instance_total_count);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->scs_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->picture_parent_control_set_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
@@ -1071,6 +1295,12 @@ static void svt_enc_handle_dctor(EbPtr p)
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->tpl_reference_picture_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->overlay_input_picture_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
     EB_DELETE(enc_handle_ptr->input_cmd_resource_ptr);
+    // hand back the zero copy input pictures still held by the library
+    if (enc_handle_ptr->input_y8b_buffer_resource_ptr && enc_handle_ptr->input_y8b_buffer_resource_ptr->object_release_cb) {
+        EbSystemResource *resource_ptr = enc_handle_ptr->input_y8b_buffer_resource_ptr;
+        for (uint32_t w_i = 0; w_i < resource_ptr->object_total_count; ++w_i)
+            resource_ptr->object_release_cb(resource_ptr->object_release_ctx, resource_ptr->wrapper_ptr_pool[w_i]->object_ptr);
+    }
     EB_DELETE(enc_handle_ptr->input_y8b_buffer_resource_ptr);
 
     //all buffer_y have been redirected to y8b location that just got released.
@@ -1148,6 +1378,9 @@ static EbErrorType svt_enc_handle_ctor(
     EB_ALLOC_PTR_ARRAY(enc_handle_ptr->scs_instance_array, enc_handle_ptr->encode_instance_total_count);
     EB_NEW(enc_handle_ptr->scs_instance_array[0], svt_sequence_control_set_instance_ctor);
 
+    enc_handle_ptr->na_arena_stats.name = "Neighbor array";
+    enc_handle_ptr->me_arena_stats.name = "ME results";
+
     enc_handle_ptr->eos_received = false;
     enc_handle_ptr->eos_sent = false;
     enc_handle_ptr->frame_received = false;
@@ -1177,6 +1410,7 @@ void svt_output_buffer_header_destroyer(    EbPtr p);
 
 EbErrorType svt_input_y8b_creator(EbPtr *object_dbl_ptr, EbPtr  object_init_data_ptr);
 void svt_input_y8b_destroyer(EbPtr p);
+static void release_zero_copy_input(void *ctx, void *object_ptr);
 
 static EbErrorType in_cmd_ctor(
     InputCommand *context_ptr,
@@ -1365,9 +1599,19 @@ static int create_pa_ref_buf_descs(EbEncHandle *enc_handle_ptr, uint32_t instanc
         eb_pa_ref_obj_ect_desc_init_data_structure.reference_picture_desc_init_data = ref_pic_buf_desc_init_data;
         eb_pa_ref_obj_ect_desc_init_data_structure.quarter_picture_desc_init_data = quart_pic_buf_desc_init_data;
         eb_pa_ref_obj_ect_desc_init_data_structure.sixteenth_picture_desc_init_data = sixteenth_pic_buf_desc_init_data;
+        // motion field of the temporal filtering, reused by the open-loop ME (not searched in low delay)
+        eb_pa_ref_obj_ect_desc_init_data_structure.tf_mv_field_b64_count =
+            (scs->tf_params_per_type[0].enabled || scs->tf_params_per_type[1].enabled ||
+             scs->tf_params_per_type[2].enabled) && scs->static_config.pred_structure != SVT_AV1_PRED_LOW_DELAY_B
+            ? ((scs->max_input_luma_width + BLOCK_SIZE_64 - 1) / BLOCK_SIZE_64) *
+                ((scs->max_input_luma_height + BLOCK_SIZE_64 - 1) / BLOCK_SIZE_64)
+            : 0;
+        eb_pa_ref_obj_ect_desc_init_data_structure.me_sum_4x1 = scs->me_sea;
         // Reference Picture Buffers
         EB_NEW(enc_handle_ptr->pa_reference_picture_pool_ptr_array[instance_index],
-            svt_system_resource_ctor,
+            svt_system_resource_numa_ctor,
+            enc_handle_ptr->numa_node_count,
+            enc_handle_ptr->numa_node_array,
             scs->pa_reference_picture_buffer_init_count,
             EB_PictureDecisionProcessInitCount,
             0,
@@ -1414,7 +1658,9 @@ static int create_tpl_ref_buf_descs(EbEncHandle *enc_handle_ptr, uint32_t instan
     eb_tpl_ref_obj_ect_desc_init_data_structure.reference_picture_desc_init_data = ref_pic_buf_desc_init_data;
     // Reference Picture Buffers
     EB_NEW(enc_handle_ptr->tpl_reference_picture_pool_ptr_array[instance_index],
-        svt_system_resource_ctor,
+        svt_system_resource_numa_ctor,
+        enc_handle_ptr->numa_node_count,
+        enc_handle_ptr->numa_node_array,
         scs->tpl_reference_picture_buffer_init_count,
         EB_PictureDecisionProcessInitCount,
         0,
@@ -1470,13 +1716,18 @@ static int create_ref_buf_descs(EbEncHandle *enc_handle_ptr, uint32_t instance_i
     // Reference Picture Buffers
     EB_NEW(
             enc_handle_ptr->reference_picture_pool_ptr_array[instance_index],
-            svt_system_resource_ctor,
+            svt_system_resource_numa_ctor,
+            enc_handle_ptr->numa_node_count,
+            enc_handle_ptr->numa_node_array,
             scs->reference_picture_buffer_init_count,//enc_handle_ptr->ref_pic_pool_total_count,
             EB_PictureManagerProcessInitCount,
             0,
             svt_reference_object_creator,
             &(eb_ref_obj_ect_desc_init_data_structure),
             NULL);
+    // reference objects give back the source planes held for the global motion ref info when recycled
+    enc_handle_ptr->reference_picture_pool_ptr_array[instance_index]->object_release_cb =
+        svt_aom_release_reference_gm_src;
 
     // Create reference list for Picture Manager
     // When decode-order is not enforced at pic mgr, each reference picture must have an allocated reference buffer (for at least one mini-gop) so the
@@ -1538,6 +1789,19 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
     svt_av1_init_me_luts();
     init_fn_ptr();
     svt_av1_init_wedge_masks();
+    // NUMA nodes the picture pools are spread over
+    if (enc_handle_ptr->scs_instance_array[0]->scs->static_config.numa_picture_pools) {
+        EbCpuTopology *topology_ptr;
+        EB_NEW(topology_ptr, svt_cpu_topology_ctor, NULL);
+        if (topology_ptr->node_count > 1) {
+            enc_handle_ptr->numa_node_count = topology_ptr->node_count;
+            memcpy(enc_handle_ptr->numa_node_array,
+                   topology_ptr->node_array,
+                   topology_ptr->node_count * sizeof(topology_ptr->node_array[0]));
+        } else
+            SVT_INFO("numa picture pools: single NUMA node, pools not spread\n");
+        EB_DELETE(topology_ptr);
+    }
     /************************************
      * Sequence Control Set
      ************************************/
@@ -1618,6 +1882,8 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
                               enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.resize_mode > RESIZE_NONE;
         input_data.rtc_tune = (enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.pred_structure == SVT_AV1_PRED_LOW_DELAY_B) ? true : false;
         input_data.static_config = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config;
+        input_data.na_arena_stats = NULL;
+        input_data.me_arena_stats = &enc_handle_ptr->me_arena_stats;
         EB_NEW(
             enc_handle_ptr->picture_parent_control_set_pool_ptr_array[instance_index],
             svt_system_resource_ctor,
@@ -1726,6 +1992,7 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             }
 
             input_data.init_max_block_cnt = enc_handle_ptr->scs_instance_array[instance_index]->scs->max_block_cnt;
+            input_data.recode_reuse_md = enc_handle_ptr->scs_instance_array[instance_index]->scs->recode_ctrls.reuse_md;
             input_data.picture_width = enc_handle_ptr->scs_instance_array[instance_index]->scs->max_input_luma_width;
             input_data.picture_height = enc_handle_ptr->scs_instance_array[instance_index]->scs->max_input_luma_height;
             input_data.left_padding = enc_handle_ptr->scs_instance_array[instance_index]->scs->left_padding;
@@ -1748,6 +2015,8 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             input_data.av1_cm = parent_pcs->av1_cm;
             input_data.enc_mode = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.enc_mode;
             input_data.static_config = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config;
+            input_data.na_arena_stats = &enc_handle_ptr->na_arena_stats;
+            input_data.me_arena_stats = NULL;
 
             input_data.input_resolution = enc_handle_ptr->scs_instance_array[instance_index]->scs->input_resolution;
             input_data.is_scale = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.superres_mode > SUPERRES_NONE ||
@@ -1835,7 +2104,9 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
     //Picture Buffer SRM to hold (uv8b + yuv2b)
     EB_NEW(
         enc_handle_ptr->input_buffer_resource_ptr,
-        svt_system_resource_ctor,
+        svt_system_resource_numa_ctor,
+        enc_handle_ptr->numa_node_count,
+        enc_handle_ptr->numa_node_array,
         enc_handle_ptr->scs_instance_array[0]->scs->input_buffer_fifo_init_count,
         1,
         0, //1/2 SRM; no consumer FIFO
@@ -1847,7 +2118,9 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
     //Picture Buffer SRM to hold y8b to be shared by Pcs->enhanced and Pa_ref
     EB_NEW(
         enc_handle_ptr->input_y8b_buffer_resource_ptr,
-        svt_system_resource_ctor,
+        svt_system_resource_numa_ctor,
+        enc_handle_ptr->numa_node_count,
+        enc_handle_ptr->numa_node_array,
         MAX(enc_handle_ptr->scs_instance_array[0]->scs->input_buffer_fifo_init_count, enc_handle_ptr->scs_instance_array[0]->scs->pa_reference_picture_buffer_init_count),
         1,
         0, //1/2 SRM; no consumer FIFO
@@ -1859,6 +2132,10 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
     enc_handle_ptr->input_y8b_buffer_resource_ptr->empty_queue->log = 1;
 #endif
     enc_handle_ptr->input_y8b_buffer_producer_fifo_ptr = svt_system_resource_get_producer_fifo(enc_handle_ptr->input_y8b_buffer_resource_ptr, 0);
+    if (enc_handle_ptr->scs_instance_array[0]->scs->static_config.zero_copy_input) {
+        enc_handle_ptr->input_y8b_buffer_resource_ptr->object_release_cb  = release_zero_copy_input;
+        enc_handle_ptr->input_y8b_buffer_resource_ptr->object_release_ctx = enc_handle_ptr->scs_instance_array[0]->scs;
+    }
 
     // EbBufferHeaderType Output Stream
     EB_ALLOC_PTR_ARRAY(enc_handle_ptr->output_stream_buffer_resource_ptr_array, enc_handle_ptr->encode_instance_total_count);
@@ -2075,7 +2352,8 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             enc_handle_ptr->dlf_results_resource_ptr,
             svt_system_resource_ctor,
             enc_handle_ptr->scs_instance_array[0]->scs->dlf_fifo_init_count,
-            enc_handle_ptr->scs_instance_array[0]->scs->dlf_process_init_count,
+            enc_handle_ptr->scs_instance_array[0]->scs->dlf_process_init_count +
+                enc_handle_ptr->scs_instance_array[0]->scs->enc_dec_process_init_count,
             enc_handle_ptr->scs_instance_array[0]->scs->cdef_process_init_count,
             dlf_results_creator,
             &delf_result_init_data,
@@ -2315,20 +2593,18 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
 
     control_set_ptr = enc_handle_ptr->scs_instance_array[0]->scs;
 
+    if (config_ptr->pipeline_trace_file) {
+        return_error = enc_create_pipeline_profiler(enc_handle_ptr, config_ptr->pipeline_trace_file);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+    }
+
     // Resource Coordination
     EB_CREATE_THREAD(enc_handle_ptr->resource_coordination_thread_handle, svt_aom_resource_coordination_kernel, enc_handle_ptr->resource_coordination_context_ptr);
-    EB_CREATE_THREAD_ARRAY(enc_handle_ptr->picture_analysis_thread_handle_array,control_set_ptr->picture_analysis_process_init_count,
-        svt_aom_picture_analysis_kernel,
-        enc_handle_ptr->picture_analysis_context_ptr_array);
 
     // Picture Decision
     EB_CREATE_THREAD(enc_handle_ptr->picture_decision_thread_handle, svt_aom_picture_decision_kernel, enc_handle_ptr->picture_decision_context_ptr);
 
-    // Motion Estimation
-    EB_CREATE_THREAD_ARRAY(enc_handle_ptr->motion_estimation_thread_handle_array, control_set_ptr->motion_estimation_process_init_count,
-        svt_aom_motion_estimation_kernel,
-        enc_handle_ptr->motion_estimation_context_ptr_array);
-
         // Initial Rate Control
         EB_CREATE_THREAD(enc_handle_ptr->initial_rate_control_thread_handle, svt_aom_initial_rate_control_kernel, enc_handle_ptr->initial_rate_control_context_ptr);
 
@@ -2337,45 +2613,117 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             svt_aom_source_based_operations_kernel,
             enc_handle_ptr->source_based_operations_context_ptr_array);
 
-        // TPL dispenser
-        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->tpl_disp_thread_handle_array, control_set_ptr->tpl_disp_process_init_count,
-            svt_aom_tpl_disp_kernel,//TODOOMK
-            enc_handle_ptr->tpl_disp_context_ptr_array);
         // Picture Manager
         EB_CREATE_THREAD(enc_handle_ptr->picture_manager_thread_handle, svt_aom_picture_manager_kernel, enc_handle_ptr->picture_manager_context_ptr);
         // Rate Control
         EB_CREATE_THREAD(enc_handle_ptr->rate_control_thread_handle, svt_aom_rate_control_kernel, enc_handle_ptr->rate_control_context_ptr);
 
-        // Mode Decision Configuration Process
-        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->mode_decision_configuration_thread_handle_array, control_set_ptr->mode_decision_configuration_process_init_count,
-            svt_aom_mode_decision_configuration_kernel,
-            enc_handle_ptr->mode_decision_configuration_context_ptr_array);
-
-
-        // EncDec Process
-        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->enc_dec_thread_handle_array, control_set_ptr->enc_dec_process_init_count,
-            svt_aom_mode_decision_kernel,
-            enc_handle_ptr->enc_dec_context_ptr_array);
-
-        // Dlf Process
-        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->dlf_thread_handle_array, control_set_ptr->dlf_process_init_count,
-            svt_aom_dlf_kernel,
-            enc_handle_ptr->dlf_context_ptr_array);
-
-        // Cdef Process
-        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->cdef_thread_handle_array, control_set_ptr->cdef_process_init_count,
-            svt_aom_cdef_kernel,
-            enc_handle_ptr->cdef_context_ptr_array);
-
-        // Rest Process
-        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->rest_thread_handle_array, control_set_ptr->rest_process_init_count,
-            svt_aom_rest_kernel,
-            enc_handle_ptr->rest_context_ptr_array);
-
-        // Entropy Coding Process
-        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->entropy_coding_thread_handle_array, control_set_ptr->entropy_coding_process_init_count,
-            svt_aom_entropy_coding_kernel,
-            enc_handle_ptr->entropy_coding_context_ptr_array);
+    // The parallel stages run on core_count workers, in pipeline order
+    EB_NEW(enc_handle_ptr->task_scheduler_ptr, svt_task_scheduler_ctor, control_set_ptr->core_count, EB_TaskSchedulerTaskTypeCount);
+    // Picture Analysis
+    return_error = svt_task_scheduler_add_task_type(enc_handle_ptr->task_scheduler_ptr, enc_handle_ptr->resource_coordination_results_resource_ptr,
+        svt_aom_picture_analysis_task,
+        (EbPtr *)enc_handle_ptr->picture_analysis_context_ptr_array, control_set_ptr->picture_analysis_process_init_count);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    // Motion Estimation
+    return_error = svt_task_scheduler_add_task_type(enc_handle_ptr->task_scheduler_ptr, enc_handle_ptr->picture_decision_results_resource_ptr,
+        svt_aom_motion_estimation_task,
+        (EbPtr *)enc_handle_ptr->motion_estimation_context_ptr_array, control_set_ptr->motion_estimation_process_init_count);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    // TPL dispenser
+    return_error = svt_task_scheduler_add_task_type(enc_handle_ptr->task_scheduler_ptr, enc_handle_ptr->tpl_disp_res_srm,
+        svt_aom_tpl_disp_task,
+        (EbPtr *)enc_handle_ptr->tpl_disp_context_ptr_array, control_set_ptr->tpl_disp_process_init_count);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    // Mode Decision Configuration Process
+    return_error = svt_task_scheduler_add_task_type(enc_handle_ptr->task_scheduler_ptr, enc_handle_ptr->rate_control_results_resource_ptr,
+        svt_aom_mode_decision_configuration_task,
+        (EbPtr *)enc_handle_ptr->mode_decision_configuration_context_ptr_array, control_set_ptr->mode_decision_configuration_process_init_count);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    // EncDec Process
+    return_error = svt_task_scheduler_add_task_type(enc_handle_ptr->task_scheduler_ptr, enc_handle_ptr->enc_dec_tasks_resource_ptr,
+        svt_aom_mode_decision_task,
+        (EbPtr *)enc_handle_ptr->enc_dec_context_ptr_array, control_set_ptr->enc_dec_process_init_count);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    // Dlf Process
+    return_error = svt_task_scheduler_add_task_type(enc_handle_ptr->task_scheduler_ptr, enc_handle_ptr->enc_dec_results_resource_ptr,
+        svt_aom_dlf_task,
+        (EbPtr *)enc_handle_ptr->dlf_context_ptr_array, control_set_ptr->dlf_process_init_count);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    // Cdef Process
+    return_error = svt_task_scheduler_add_task_type(enc_handle_ptr->task_scheduler_ptr, enc_handle_ptr->dlf_results_resource_ptr,
+        svt_aom_cdef_task,
+        (EbPtr *)enc_handle_ptr->cdef_context_ptr_array, control_set_ptr->cdef_process_init_count);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    // Rest Process
+    return_error = svt_task_scheduler_add_task_type(enc_handle_ptr->task_scheduler_ptr, enc_handle_ptr->cdef_results_resource_ptr,
+        svt_aom_rest_task,
+        (EbPtr *)enc_handle_ptr->rest_context_ptr_array, control_set_ptr->rest_process_init_count);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    // Entropy Coding Process
+    return_error = svt_task_scheduler_add_task_type(enc_handle_ptr->task_scheduler_ptr, enc_handle_ptr->rest_results_resource_ptr,
+        svt_aom_entropy_coding_task,
+        (EbPtr *)enc_handle_ptr->entropy_coding_context_ptr_array, control_set_ptr->entropy_coding_process_init_count);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    // The workers are the instance ones, or the ones of the pool shared by the instances of the process
+    if (control_set_ptr->static_config.shared_thread_pool) {
+        const uint32_t pool_worker_count = control_set_ptr->static_config.thread_pool_workers
+            ? control_set_ptr->static_config.thread_pool_workers : get_num_processors();
+        svt_task_scheduler_share(enc_handle_ptr->task_scheduler_ptr, control_set_ptr->static_config.thread_pool_weight,
+            pool_worker_count);
+    }
+    // Workers bound to cache domains, the stages of a picture running in the domain of the picture
+    if (control_set_ptr->static_config.cache_domain_placement) {
+        EbTaskScheduler *scheduler_ptr = enc_handle_ptr->task_scheduler_ptr;
+        return_error = svt_task_scheduler_set_affinity(scheduler_ptr, enc_handle_ptr->resource_coordination_results_resource_ptr,
+            picture_analysis_affinity);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+        return_error = svt_task_scheduler_set_affinity(scheduler_ptr, enc_handle_ptr->picture_decision_results_resource_ptr,
+            motion_estimation_affinity);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+        return_error = svt_task_scheduler_set_affinity(scheduler_ptr, enc_handle_ptr->tpl_disp_res_srm, tpl_disp_affinity);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+        return_error = svt_task_scheduler_set_affinity(scheduler_ptr, enc_handle_ptr->rate_control_results_resource_ptr,
+            mode_decision_configuration_affinity);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+        return_error = svt_task_scheduler_set_affinity(scheduler_ptr, enc_handle_ptr->enc_dec_tasks_resource_ptr, enc_dec_affinity);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+        return_error = svt_task_scheduler_set_affinity(scheduler_ptr, enc_handle_ptr->enc_dec_results_resource_ptr, dlf_affinity);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+        return_error = svt_task_scheduler_set_affinity(scheduler_ptr, enc_handle_ptr->dlf_results_resource_ptr, cdef_affinity);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+        return_error = svt_task_scheduler_set_affinity(scheduler_ptr, enc_handle_ptr->cdef_results_resource_ptr, rest_affinity);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+        return_error = svt_task_scheduler_set_affinity(scheduler_ptr, enc_handle_ptr->rest_results_resource_ptr,
+            entropy_coding_affinity);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+        svt_task_scheduler_place(scheduler_ptr);
+    }
+    // Instances of a ladder group share the TPL model of the group leader
+    if (control_set_ptr->static_config.ladder_group)
+        EB_NEW(enc_handle_ptr->scs_instance_array[0]->enc_ctx->ladder_member, svt_aom_ladder_member_ctor,
+            control_set_ptr->static_config.ladder_group, control_set_ptr->static_config.ladder_leader, control_set_ptr);
+    return_error = svt_task_scheduler_start(enc_handle_ptr->task_scheduler_ptr, enc_create_worker_thread);
+    if (return_error != EB_ErrorNone)
+        return return_error;
 
     // Packetization
     EB_CREATE_THREAD(enc_handle_ptr->packetization_thread_handle, svt_aom_packetization_kernel, enc_handle_ptr->packetization_context_ptr);
@@ -3362,6 +3710,27 @@ static void set_list0_only_base(SequenceControlSet* scs, uint8_t list0_only_base
     default: assert(0); break;
     }
 }
+/*
+ * Derive the recode loop Params
+ */
+static void set_recode_ctrls(SequenceControlSet* scs, uint8_t recode_level) {
+    RecodeCtrls* ctrls = &scs->recode_ctrls;
+
+    switch (recode_level) {
+    case 0:
+        ctrls->reuse_md = 0;
+        break;
+    case 1:
+        ctrls->reuse_md = 1;
+        ctrls->reuse_md_max_qindex_delta = 16;
+        break;
+    case 2:
+        ctrls->reuse_md = 1;
+        ctrls->reuse_md_max_qindex_delta = 32;
+        break;
+    default: assert(0); break;
+    }
+}
 /*
  * Set the MRP control
  */
@@ -4085,6 +4454,8 @@ static void set_param_based_on_input(SequenceControlSet *scs)
     // 1                            1: decimation
 
     scs->down_sampling_method_me_search = ME_FILTERED_DOWNSAMPLED;
+    // Successive elimination of the full-pel ME positions, for the presets with a wide search area
+    scs->me_sea = scs->static_config.enc_mode <= ENC_M4 ? 1 : 0;
 
     // Enforce starting frame in decode order (at PicMgr)
     // Does not wait for feedback from PKT
@@ -4125,6 +4496,15 @@ static void set_param_based_on_input(SequenceControlSet *scs)
         list0_only_base_lvl = 4;
     set_list0_only_base(scs, list0_only_base_lvl);
 
+    uint8_t recode_lvl = 0;
+    if (scs->static_config.recode_loop == DISALLOW_RECODE)
+        recode_lvl = 0;
+    else if (scs->static_config.enc_mode <= ENC_M2)
+        recode_lvl = 1;
+    else
+        recode_lvl = 2;
+    set_recode_ctrls(scs, recode_lvl);
+
     if (scs->static_config.rate_control_mode == SVT_AV1_RC_MODE_VBR || scs->static_config.rate_control_mode == SVT_AV1_RC_MODE_CBR ||
         scs->input_resolution >= INPUT_SIZE_4K_RANGE ||
         scs->static_config.fast_decode == 1 ||
@@ -4562,6 +4942,27 @@ static void copy_api_from_app(
 
     scs->static_config.startup_mg_size = config_struct->startup_mg_size;
     scs->static_config.enable_roi_map = config_struct->enable_roi_map;
+
+    // Zero copy input
+    scs->static_config.zero_copy_input = config_struct->zero_copy_input;
+    scs->static_config.release_input_picture = config_struct->release_input_picture;
+    scs->static_config.release_input_picture_priv = config_struct->release_input_picture_priv;
+
+    scs->static_config.pipeline_trace_file = config_struct->pipeline_trace_file;
+    scs->static_config.enable_tile_group_output = config_struct->enable_tile_group_output;
+
+    // Shared thread pool
+    scs->static_config.shared_thread_pool = config_struct->shared_thread_pool;
+    scs->static_config.thread_pool_weight = config_struct->thread_pool_weight;
+    scs->static_config.thread_pool_workers = config_struct->thread_pool_workers;
+
+    // Ladder group
+    scs->static_config.ladder_group = config_struct->ladder_group;
+    scs->static_config.ladder_leader = config_struct->ladder_leader;
+    scs->static_config.cache_domain_placement = config_struct->cache_domain_placement;
+    scs->static_config.numa_picture_pools     = config_struct->numa_picture_pools;
+    scs->static_config.rc_stats_chunk_start   = config_struct->rc_stats_chunk_start;
+    scs->static_config.rc_stats_chunk_frames  = config_struct->rc_stats_chunk_frames;
     return;
 }
 
@@ -4982,6 +5383,96 @@ static EbErrorType copy_frame_buffer(
     return return_error;
 }
 
+/*
+ Wrap the input buffer from the sample application
+in the library buffers (zero copy input)
+*/
+static void wrap_frame_buffer(
+    SequenceControlSet            *scs,
+    EbBufferHeaderType            *destination,
+    EbBufferHeaderType            *destination_y8b,
+    EbBufferHeaderType            *source)
+{
+    EbPictureBufferDesc *input_pic             = (EbPictureBufferDesc*)destination->p_buffer;
+    EbPictureBufferDesc *y8b_input_picture_ptr = (EbPictureBufferDesc*)destination_y8b->p_buffer;
+    EbSvtIOFormat       *input_ptr             = (EbSvtIOFormat*)source->p_buffer;
+    uint16_t             luma_stride           = (uint16_t)input_ptr->y_stride;
+    uint16_t             chroma_stride         = (uint16_t)input_ptr->cb_stride;
+    uint32_t             luma_buffer_offset    = y8b_input_picture_ptr->org_y * luma_stride + y8b_input_picture_ptr->org_x;
+    uint32_t             chroma_buffer_offset  = (y8b_input_picture_ptr->org_y >> scs->subsampling_y) * chroma_stride +
+        (y8b_input_picture_ptr->org_x >> scs->subsampling_x);
+
+    // The borders of the application planes hold the padding
+    y8b_input_picture_ptr->stride_y  = luma_stride;
+    y8b_input_picture_ptr->stride_cb = chroma_stride;
+    y8b_input_picture_ptr->stride_cr = chroma_stride;
+    y8b_input_picture_ptr->buffer_y  = input_ptr->luma - luma_buffer_offset;
+    y8b_input_picture_ptr->buffer_cb = input_ptr->cb - chroma_buffer_offset;
+    y8b_input_picture_ptr->buffer_cr = input_ptr->cr - chroma_buffer_offset;
+
+    y8b_input_picture_ptr->luma_size   = luma_stride *
+        (y8b_input_picture_ptr->height + y8b_input_picture_ptr->org_y + y8b_input_picture_ptr->origin_bot_y);
+    y8b_input_picture_ptr->chroma_size = chroma_stride *
+        ((y8b_input_picture_ptr->height + scs->subsampling_y + y8b_input_picture_ptr->org_y +
+          y8b_input_picture_ptr->origin_bot_y) >> scs->subsampling_y);
+
+    input_pic->stride_y    = luma_stride;
+    input_pic->stride_cb   = chroma_stride;
+    input_pic->stride_cr   = chroma_stride;
+    input_pic->luma_size   = y8b_input_picture_ptr->luma_size;
+    input_pic->chroma_size = y8b_input_picture_ptr->chroma_size;
+    input_pic->buffer_cb   = y8b_input_picture_ptr->buffer_cb;
+    input_pic->buffer_cr   = y8b_input_picture_ptr->buffer_cr;
+
+    // The y8b buffer lives the longest, it hands the planes back to the application
+    destination_y8b->pts         = source->pts;
+    destination_y8b->wrapper_ptr = source->wrapper_ptr;
+}
+
+/*
+ Hand the planes of a zero copy input picture back
+to the application once its y8b buffer is released
+*/
+static void release_zero_copy_input(void *ctx, void *object_ptr)
+{
+    SequenceControlSet  *scs                   = (SequenceControlSet*)ctx;
+    EbBufferHeaderType  *y8b_header            = (EbBufferHeaderType*)object_ptr;
+    EbPictureBufferDesc *y8b_input_picture_ptr = (EbPictureBufferDesc*)y8b_header->p_buffer;
+
+    // e.g. the EOS buffer
+    if (y8b_input_picture_ptr->buffer_y == NULL)
+        return;
+
+    uint32_t luma_buffer_offset   = y8b_input_picture_ptr->org_y * y8b_input_picture_ptr->stride_y +
+        y8b_input_picture_ptr->org_x;
+    uint32_t chroma_buffer_offset = (y8b_input_picture_ptr->org_y >> scs->subsampling_y) * y8b_input_picture_ptr->stride_cb +
+        (y8b_input_picture_ptr->org_x >> scs->subsampling_x);
+
+    EbSvtIOFormat planes;
+    memset(&planes, 0, sizeof(planes));
+    planes.luma      = y8b_input_picture_ptr->buffer_y + luma_buffer_offset;
+    planes.cb        = y8b_input_picture_ptr->buffer_cb + chroma_buffer_offset;
+    planes.cr        = y8b_input_picture_ptr->buffer_cr + chroma_buffer_offset;
+    planes.y_stride  = y8b_input_picture_ptr->stride_y;
+    planes.cb_stride = y8b_input_picture_ptr->stride_cb;
+    planes.cr_stride = y8b_input_picture_ptr->stride_cr;
+    planes.color_fmt = (EbColorFormat)scs->static_config.encoder_color_format;
+    planes.bit_depth = EB_EIGHT_BIT;
+
+    EbBufferHeaderType header;
+    memset(&header, 0, sizeof(header));
+    header.size        = sizeof(header);
+    header.p_buffer    = (uint8_t*)&planes;
+    header.pts         = y8b_header->pts;
+    header.wrapper_ptr = y8b_header->wrapper_ptr;
+
+    y8b_input_picture_ptr->buffer_y  = NULL;
+    y8b_input_picture_ptr->buffer_cb = NULL;
+    y8b_input_picture_ptr->buffer_cr = NULL;
+
+    scs->static_config.release_input_picture(scs->static_config.release_input_picture_priv, &header);
+}
+
 static EbErrorType copy_private_data_list(EbBufferHeaderType* dst, EbBufferHeaderType* src) {
     EbErrorType return_error = EB_ErrorNone;
     EbPrivDataNode* p_src_node = (EbPrivDataNode*)src->p_app_private;
@@ -5049,7 +5540,8 @@ EbErrorType svt_input_buffer_header_update(
 
     input_pic_buf_desc_init_data.split_mode = is_16bit ? TRUE : FALSE;
 
-    input_pic_buf_desc_init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_FULL_MASK;
+    // in zero copy input mode the planes are the application ones
+    input_pic_buf_desc_init_data.buffer_enable_mask = noy8b && config->zero_copy_input ? 0 : PICTURE_BUFFER_DESC_FULL_MASK;
     input_pic_buf_desc_init_data.is_16bit_pipeline = 0;
 
     // Enhanced Picture Buffer
@@ -5096,7 +5588,8 @@ EbErrorType svt_input_y8b_update(
 
     input_pic_buf_desc_init_data.split_mode = is_16bit ? TRUE : FALSE;
 
-    input_pic_buf_desc_init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_LUMA_MASK; //allocate for 8bit Luma only
+    //allocate for 8bit Luma only, nothing in zero copy input mode
+    input_pic_buf_desc_init_data.buffer_enable_mask = config->zero_copy_input ? 0 : PICTURE_BUFFER_DESC_LUMA_MASK;
     input_pic_buf_desc_init_data.is_16bit_pipeline = 0;
 
     // Enhanced Picture Buffer
@@ -5201,7 +5694,10 @@ static void copy_input_buffer(SequenceControlSet* scs, EbBufferHeaderType* dst,
         // Bypass copy for the unecessary picture in IPPP pass
         // Copy the picture buffer
         if (src->p_buffer != NULL) {
-            copy_frame_buffer(scs, dst->p_buffer, dst_y8b->p_buffer, src->p_buffer, pass);
+            if (scs->static_config.zero_copy_input)
+                wrap_frame_buffer(scs, dst, dst_y8b, src);
+            else
+                copy_frame_buffer(scs, dst->p_buffer, dst_y8b->p_buffer, src->p_buffer, pass);
             // Copy the metadata array
             if (svt_aom_copy_metadata_buffer(dst, src->metadata) != EB_ErrorNone)
                 dst->metadata = NULL;
@@ -5329,6 +5825,20 @@ static EbErrorType validate_on_the_fly_settings(EbBufferHeaderType *input_ptr, S
     }
     return EB_ErrorNone;
 }
+/*
+  check the planes of a zero copy input picture
+*/
+static Bool zero_copy_input_valid(SequenceControlSet *scs, EbSvtIOFormat *input_ptr) {
+    uint32_t luma_width   = scs->max_input_luma_width + 2 * SVT_AV1_ENC_INPUT_BORDER;
+    uint32_t chroma_width = luma_width >> scs->subsampling_x;
+
+    if (input_ptr->luma == NULL || input_ptr->cb == NULL || input_ptr->cr == NULL)
+        return FALSE;
+    if (input_ptr->cb_stride != input_ptr->cr_stride)
+        return FALSE;
+    return input_ptr->y_stride >= luma_width && input_ptr->y_stride <= UINT16_MAX &&
+        input_ptr->cb_stride >= chroma_width && input_ptr->cb_stride <= UINT16_MAX;
+}
 /**********************************
 * Empty This Buffer
 **********************************/
@@ -5351,10 +5861,19 @@ EB_API EbErrorType svt_av1_enc_send_picture(
         SVT_ERROR("Invalid API input buffer size detected. Please ignore the output stream\n");
     }
 
+    // The wrapped planes must leave room for the padding
+    if (enc_handle_ptr->scs_instance_array[0]->scs->static_config.zero_copy_input && p_buffer->p_buffer != NULL &&
+        !zero_copy_input_valid(enc_handle_ptr->scs_instance_array[0]->scs, (EbSvtIOFormat*)p_buffer->p_buffer)) {
+        SVT_ERROR("Invalid zero copy input picture: missing planes or borders smaller than SVT_AV1_ENC_INPUT_BORDER\n");
+        return EB_ErrorBadParameter;
+    }
+
     // Get new Luma-8b buffer & a new (Chroma-8b + Luma-Chroma-2bit) buffers; Lib will release once done.
     EbObjectWrapper  *y8b_wrapper;
-    svt_get_empty_object(
+    const uint64_t    input_picture_number = enc_handle_ptr->input_picture_count++;
+    svt_get_empty_picture_object(
         enc_handle_ptr->input_y8b_buffer_producer_fifo_ptr,
+        input_picture_number,
         &y8b_wrapper);
     // Update the input picture definitions: resolution of the sequence
     if(validate_on_the_fly_settings(p_buffer, enc_handle_ptr->scs_instance_array[0]->scs, enc_handle_ptr->scs_instance_array[0]->config_mutex)){
@@ -5369,8 +5888,9 @@ EB_API EbErrorType svt_av1_enc_send_picture(
 
    // svt_object_inc_live_count(y8b_wrapper, 1);
 
-    svt_get_empty_object(
+    svt_get_empty_picture_object(
         enc_handle_ptr->input_buffer_producer_fifo_ptr,
+        input_picture_number,
         &eb_wrapper_ptr);
     // if resolution has changed, and the input_buffer settings do not match scs settings, update input_buffer settings
     if (buffer_update_needed((EbBufferHeaderType*)eb_wrapper_ptr->object_ptr, enc_handle_ptr->scs_instance_array[0]->scs))
@@ -5394,7 +5914,7 @@ EB_API EbErrorType svt_av1_enc_send_picture(
         Bool is_16bit_input = (Bool)(config->encoder_bit_depth > EB_EIGHT_BIT);
         size_t read_size = (size_t)SIZE_OF_ONE_FRAME_IN_BYTES(
             input_pic->width - scs->max_input_pad_right, input_pic->height - scs->max_input_pad_bottom, config->encoder_color_format, is_16bit_input);
-        if (app_hdr->p_buffer != NULL && read_size > app_hdr->n_filled_len) {
+        if (app_hdr->p_buffer != NULL && !config->zero_copy_input && read_size > app_hdr->n_filled_len) {
 
             // memset the library input buffer(s) if the API input buffer is not large enough
             // this operation is necessary to avoid a potential crash when processing an invalid input
@@ -5492,7 +6012,7 @@ EB_API EbErrorType svt_av1_enc_get_packet(
 
     if (eb_wrapper_ptr) {
         packet = (EbBufferHeaderType*)eb_wrapper_ptr->object_ptr;
-        if ( packet->flags & 0xfffffff0 )
+        if ( packet->flags & EB_BUFFERFLAG_ERROR_MASK )
             return_error = EB_ErrorMax;
         // return the output stream buffer
         *p_buffer = packet;
@@ -5670,7 +6190,8 @@ static EbErrorType allocate_frame_buffer(
 
     input_pic_buf_desc_init_data.split_mode = is_16bit ? TRUE : FALSE;
 
-    input_pic_buf_desc_init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_FULL_MASK;
+    // in zero copy input mode the planes are the application ones
+    input_pic_buf_desc_init_data.buffer_enable_mask = noy8b && config->zero_copy_input ? 0 : PICTURE_BUFFER_DESC_FULL_MASK;
     input_pic_buf_desc_init_data.is_16bit_pipeline = 0;
 
     // Enhanced Picture Buffer
@@ -5726,7 +6247,8 @@ static EbErrorType allocate_y8b_frame_buffer(
 
     input_pic_buf_desc_init_data.split_mode = is_16bit ? TRUE : FALSE;
 
-    input_pic_buf_desc_init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_LUMA_MASK; //allocate for 8bit Luma only
+    //allocate for 8bit Luma only, nothing in zero copy input mode
+    input_pic_buf_desc_init_data.buffer_enable_mask = config->zero_copy_input ? 0 : PICTURE_BUFFER_DESC_LUMA_MASK;
     input_pic_buf_desc_init_data.is_16bit_pipeline = 0;
 
 
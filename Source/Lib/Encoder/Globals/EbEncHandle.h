@@ -18,6 +18,8 @@
 #include "EbSystemResourceManager.h"
 #include "EbSequenceControlSet.h"
 #include "EbObject.h"
+#include "EbArena.h"
+#include "EbCpuTopology.h"
 
 struct _EbThreadContext {
     EbDctor dctor;
@@ -49,6 +51,9 @@ struct _EbEncHandle {
     //ParentControlSet
     EbSystemResource **picture_parent_control_set_pool_ptr_array;
     EbSystemResource **me_pool_ptr_array;
+    // Arenas of the neighbor arrays (child pcs) and ME results (me pool)
+    EbArenaStats na_arena_stats;
+    EbArenaStats me_arena_stats;
     // Picture Buffers
     EbSystemResource **reference_picture_pool_ptr_array;
     EbSystemResource **tpl_reference_picture_pool_ptr_array;
@@ -59,23 +64,20 @@ struct _EbEncHandle {
 
     // Thread Handles
     EbHandle  resource_coordination_thread_handle;
-    EbHandle *picture_analysis_thread_handle_array;
     EbHandle  picture_decision_thread_handle;
-    EbHandle *motion_estimation_thread_handle_array;
     EbHandle  initial_rate_control_thread_handle;
     EbHandle *source_based_operations_thread_handle_array;
-    EbHandle *tpl_disp_thread_handle_array;
     EbHandle  picture_manager_thread_handle;
     EbHandle  rate_control_thread_handle;
-    EbHandle *mode_decision_configuration_thread_handle_array;
-    EbHandle *enc_dec_thread_handle_array;
-    EbHandle *entropy_coding_thread_handle_array;
-    EbHandle *dlf_thread_handle_array;
-    EbHandle *cdef_thread_handle_array;
-    EbHandle *rest_thread_handle_array;
 
     EbHandle packetization_thread_handle;
 
+    // Workers of the parallel stages
+    struct EbTaskScheduler *task_scheduler_ptr;
+
+    // Per-stage timings, when a pipeline trace file is set
+    struct EbPipelineProfiler *pipeline_profiler_ptr;
+
     // Contexts
     EbThreadContext  *resource_coordination_context_ptr;
     EbThreadContext **picture_analysis_context_ptr_array;
@@ -130,6 +132,12 @@ struct _EbEncHandle {
     bool eos_sent; // used to signal we sent the EOS to the app
     bool frame_received; // used to signal we received any frame from the app
     bool is_prev_valid; // whether the previous input is valid or not
+
+    // NUMA nodes the picture pools are spread over, none unless several nodes
+    uint32_t numa_node_count;
+    uint32_t numa_node_array[EB_CPU_TOPOLOGY_MAX_NODES];
+    // Pictures sent so far, the node of an input picture follows its number
+    uint64_t input_picture_count;
 };
 void set_segments_numbers(SequenceControlSet *scs);
 #endif // EbEncHandle_h
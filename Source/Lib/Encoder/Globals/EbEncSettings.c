@@ -871,6 +871,59 @@ EbErrorType svt_av1_verify_settings(SequenceControlSet *scs) {
         return_error = EB_ErrorBadParameter;
     }
 
+    if (config->zero_copy_input) {
+        if (config->encoder_bit_depth != EB_EIGHT_BIT) {
+            SVT_ERROR("Instance %u: Zero copy input is only supported for 8-bit input\n", channel_number + 1);
+            return_error = EB_ErrorBadParameter;
+        }
+        if (config->encoder_color_format != EB_YUV420) {
+            SVT_ERROR("Instance %u: Zero copy input is only supported for 4:2:0 input\n", channel_number + 1);
+            return_error = EB_ErrorBadParameter;
+        }
+        if (config->pass == ENC_FIRST_PASS) {
+            SVT_ERROR("Instance %u: Zero copy input is not supported in the first pass\n", channel_number + 1);
+            return_error = EB_ErrorBadParameter;
+        }
+        if (config->release_input_picture == NULL) {
+            SVT_ERROR("Instance %u: Zero copy input requires a release_input_picture callback\n",
+                      channel_number + 1);
+            return_error = EB_ErrorBadParameter;
+        }
+    }
+
+    if (config->enable_tile_group_output) {
+        if (config->pred_structure != SVT_AV1_PRED_LOW_DELAY_B) {
+            SVT_ERROR("Instance %u: Tile group output is only supported with the low delay prediction structure\n",
+                      channel_number + 1);
+            return_error = EB_ErrorBadParameter;
+        }
+        if (config->pass == ENC_FIRST_PASS) {
+            SVT_ERROR("Instance %u: Tile group output is not supported in the first pass\n", channel_number + 1);
+            return_error = EB_ErrorBadParameter;
+        }
+        if (config->enable_overlays) {
+            SVT_ERROR("Instance %u: Tile group output is not supported with overlays\n", channel_number + 1);
+            return_error = EB_ErrorBadParameter;
+        }
+    }
+
+    if (config->shared_thread_pool && (config->thread_pool_weight < 1 || config->thread_pool_weight > 64)) {
+        SVT_ERROR("Instance %u: Invalid thread pool weight %u, it must be [1 - 64]\n",
+                  channel_number + 1,
+                  config->thread_pool_weight);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->ladder_leader && !config->ladder_group) {
+        SVT_ERROR("Instance %u: The ladder leader must be given a ladder group\n", channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->rc_stats_chunk_frames && !config->rc_stats_buffer.sz) {
+        SVT_ERROR("Instance %u: The chunk of the first-pass statistics needs the statistics in\n", channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
     return return_error;
 }
 
@@ -1016,6 +1069,20 @@ EbErrorType svt_av1_set_default_params(EbSvtAv1EncConfiguration *config_ptr) {
     config_ptr->frame_scale_evts.resize_kf_denoms = NULL;
     config_ptr->frame_scale_evts.start_frame_nums = NULL;
     config_ptr->enable_roi_map                    = false;
+    config_ptr->zero_copy_input                   = FALSE;
+    config_ptr->pipeline_trace_file               = NULL;
+    config_ptr->enable_tile_group_output          = FALSE;
+    config_ptr->shared_thread_pool                = FALSE;
+    config_ptr->thread_pool_weight                = 1;
+    config_ptr->thread_pool_workers               = 0;
+    config_ptr->ladder_group                      = 0;
+    config_ptr->ladder_leader                     = FALSE;
+    config_ptr->cache_domain_placement            = FALSE;
+    config_ptr->numa_picture_pools                = FALSE;
+    config_ptr->rc_stats_chunk_start              = 0;
+    config_ptr->rc_stats_chunk_frames             = 0;
+    config_ptr->release_input_picture             = NULL;
+    config_ptr->release_input_picture_priv        = NULL;
     return return_error;
 }
 
@@ -1910,6 +1977,9 @@ EB_API EbErrorType svt_av1_enc_parse_parameter(EbSvtAv1EncConfiguration *config_
         {"level", &config_struct->level},
         {"lp", &config_struct->logical_processors},
         {"pin", &config_struct->pin_threads},
+        {"thread-pool-weight", &config_struct->thread_pool_weight},
+        {"thread-pool-workers", &config_struct->thread_pool_workers},
+        {"ladder-group", &config_struct->ladder_group},
         {"fps-num", &config_struct->frame_rate_numerator},
         {"fps-denom", &config_struct->frame_rate_denominator},
         {"lookahead", &config_struct->look_ahead_distance},
@@ -2064,6 +2134,11 @@ EB_API EbErrorType svt_av1_enc_parse_parameter(EbSvtAv1EncConfiguration *config_
         {"enable-qm", &config_struct->enable_qm},
         {"enable-dg", &config_struct->enable_dg},
         {"gop-constraint-rc", &config_struct->gop_constraint_rc},
+        {"tile-group-output", &config_struct->enable_tile_group_output},
+        {"shared-thread-pool", &config_struct->shared_thread_pool},
+        {"ladder-leader", &config_struct->ladder_leader},
+        {"cache-domain-placement", &config_struct->cache_domain_placement},
+        {"numa-picture-pools", &config_struct->numa_picture_pools},
     };
     const size_t bool_opts_size = sizeof(bool_opts) / sizeof(bool_opts[0]);
 
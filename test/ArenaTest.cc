@@ -0,0 +1,89 @@
+/*
+ * Copyright(c) 2019 Netflix, Inc.
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file ArenaTest.cc
+ *
+ * @brief Unit test for the EbArena bump allocator:
+ * - alignment and independence of the allocations
+ * - growth past the first block
+ * - high-water mark sizing of the next arenas of a type
+ *
+ ******************************************************************************/
+
+#include <stdint.h>
+#include "gtest/gtest.h"
+#include "EbArena.h"
+
+namespace {
+
+static EbArena *create_arena(EbArenaStats *stats, size_t block_size) {
+    EbArena *arena = (EbArena *)calloc(1, sizeof(EbArena));
+    EXPECT_EQ(svt_arena_ctor(arena, stats, block_size), EB_ErrorNone);
+    return arena;
+}
+
+static void delete_arena(EbArena *arena) {
+    arena->dctor(arena);
+    free(arena);
+}
+
+TEST(ArenaTest, AllocationsAreAlignedAndDisjoint) {
+    EbArena *arena = create_arena(NULL, 1024);
+    uint8_t *prev  = NULL;
+    size_t   prev_size = 0;
+    for (size_t size = 1; size < 100; size += 7) {
+        uint8_t *p = (uint8_t *)svt_arena_alloc(arena, size);
+        ASSERT_NE(p, nullptr);
+        EXPECT_EQ((uintptr_t)p % ARENA_ALIGNMENT, 0u);
+        memset(p, (int)size, size);
+        if (prev) {
+            // the previous allocation is left untouched
+            for (size_t i = 0; i < prev_size; i++) ASSERT_EQ(prev[i], (uint8_t)prev_size);
+        }
+        prev      = p;
+        prev_size = size;
+    }
+    delete_arena(arena);
+}
+
+TEST(ArenaTest, GrowsPastTheFirstBlock) {
+    EbArenaStats stats = {"test", 0, 0, 0, 0, 0};
+    EbArena     *arena = create_arena(&stats, 256);
+    for (int i = 0; i < 64; i++) ASSERT_NE(svt_arena_alloc(arena, 48), nullptr);
+    // larger than a block
+    uint8_t *big = (uint8_t *)svt_arena_alloc(arena, 4096);
+    ASSERT_NE(big, nullptr);
+    memset(big, 0, 4096);
+    EXPECT_GT(stats.block_count, 1u);
+    EXPECT_EQ(stats.alloc_count, 65u);
+    EXPECT_EQ(stats.high_water, 64u * 48 + 4096);
+    delete_arena(arena);
+}
+
+TEST(ArenaTest, HighWaterSizesTheNextArenas) {
+    EbArenaStats stats = {"test", 0, 0, 0, 0, 0};
+    EbArena     *first = create_arena(&stats, 64);
+    for (int i = 0; i < 100; i++) ASSERT_NE(svt_arena_alloc(first, 100), nullptr);
+    const uint32_t first_blocks = stats.block_count;
+    EXPECT_GT(first_blocks, 1u);
+
+    // the same allocations fit in the single block of the next arena
+    EbArena *second = create_arena(&stats, 64);
+    for (int i = 0; i < 100; i++) ASSERT_NE(svt_arena_alloc(second, 100), nullptr);
+    EXPECT_EQ(stats.block_count, first_blocks + 1);
+    EXPECT_EQ(stats.arena_count, 2u);
+    delete_arena(first);
+    delete_arena(second);
+}
+
+}  // namespace
@@ -0,0 +1,188 @@
+/*
+ * Copyright(c) 2019 Intel Corporation
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file EntropyDecoderTest.cc
+ *
+ * @brief Unit test for the daala entropy decoder kernels:
+ * - svt_od_ec_find_symbol_{sse2,avx2}
+ * - svt_od_ec_update_cdf_{sse2,avx2}
+ *
+ * Test strategy:
+ * Check the kernels against their C versions on random CDFs of every
+ * alphabet size, including the CDF entries around the array that must not be
+ * written, then decode random bitstreams symbol by symbol through the reader
+ * with the C and the SIMD kernels and compare the symbols and the adapted
+ * CDFs.
+ *
+ ******************************************************************************/
+#include <algorithm>
+#include <functional>
+#include <stdlib.h>
+#include <string.h>
+#include "gtest/gtest.h"
+#if defined(CHAR_BIT)
+#undef CHAR_BIT  // defined in clang/9.1.0/include/limits.h
+#endif
+#include "EbDefinitions.h"
+#include "EbDecBitReader.h"
+#include "common_dsp_rtcd.h"
+#include "random.h"
+#include "util.h"
+
+using svt_av1_test_tool::SVTRandom;
+
+namespace {
+
+typedef int (*FindSymbolFunc)(const uint16_t *icdf, int nsyms, uint32_t c,
+                              uint32_t r);
+typedef void (*UpdateCdfFunc)(uint16_t *cdf, int val, int nsyms);
+
+typedef std::tuple<FindSymbolFunc, UpdateCdfFunc, uint64_t> EntropyDecParam;
+
+// CDF_SIZE(16) plus guard entries on both sides
+static const int kGuard = 8;
+static const int kCdfBufSize = kGuard + CDF_SIZE(16) + kGuard;
+static const uint16_t kGuardVal = 0xA5A5;
+
+class EntropyDecoderTest : public ::testing::TestWithParam<EntropyDecParam> {
+  public:
+    EntropyDecoderTest()
+        : find_func_(TEST_GET_PARAM(0)),
+          update_func_(TEST_GET_PARAM(1)),
+          cpu_flags_(TEST_GET_PARAM(2)),
+          rnd_(0, 32767) {
+    }
+
+    void TearDown() override {
+        svt_aom_setup_common_rtcd_internal(0);
+    }
+
+  protected:
+    // A valid inverse CDF: non-increasing, below 32768, icdf[nsyms - 1] == 0,
+    // followed by the adaptation counter.
+    void random_cdf(uint16_t *icdf, int nsyms) {
+        for (int i = 0; i < nsyms - 1; ++i)
+            icdf[i] = (uint16_t)rnd_.random();
+        std::sort(icdf, icdf + nsyms - 1, std::greater<uint16_t>());
+        icdf[nsyms - 1] = 0;
+        icdf[nsyms] = (uint16_t)(rnd_.random() % 33);
+    }
+
+    void run_kernel_test() {
+        DECLARE_ALIGNED(32, uint16_t, ref[kCdfBufSize]);
+        DECLARE_ALIGNED(32, uint16_t, tst[kCdfBufSize]);
+        SVTRandom rng_gen(0, 32767);
+        for (int nsyms = 2; nsyms <= 16; ++nsyms) {
+            for (int iter = 0; iter < 20000; ++iter) {
+                std::fill(ref, ref + kCdfBufSize, kGuardVal);
+                // vary the alignment of the CDF within the buffer
+                uint16_t *icdf = ref + kGuard - (iter & 7);
+                random_cdf(icdf, nsyms);
+
+                const uint32_t r = 32768 + rng_gen.random();
+                const uint32_t c = (uint32_t)rnd_.random() * 2 % r;
+                ASSERT_EQ(svt_od_ec_find_symbol_c(icdf, nsyms, c, r),
+                          find_func_(icdf, nsyms, c, r))
+                    << "nsyms " << nsyms << " c " << c << " r " << r;
+
+                const int val = rnd_.random() % nsyms;
+                memcpy(tst, ref, sizeof(ref));
+                svt_od_ec_update_cdf_c(icdf, val, nsyms);
+                update_func_(tst + (icdf - ref), val, nsyms);
+                ASSERT_EQ(0, memcmp(ref, tst, sizeof(ref)))
+                    << "nsyms " << nsyms << " val " << val;
+            }
+        }
+    }
+
+    // Decodes a random buffer with a random sequence of alphabet sizes and
+    // returns the symbols; the CDFs are adapted in place.
+    void decode(const uint8_t *buf, int size, const int *sizes, int count,
+                uint16_t (*cdfs)[CDF_SIZE(16)], int *symbols) {
+        SvtReader br;
+        memset(&br, 0, sizeof(br));
+        svt_reader_init(&br, buf, size);
+        br.allow_update_cdf = 1;
+        for (int i = 0; i < count; ++i) {
+            if (sizes[i] == 0)
+                symbols[i] = svt_read_literal(&br, 5, nullptr);
+            else
+                symbols[i] = svt_read_symbol(
+                    &br, cdfs[sizes[i]], sizes[i], nullptr);
+        }
+    }
+
+    void run_reader_test() {
+        const int size = 4096, count = 8000;
+        uint8_t buf[size];
+        int sizes[count], sym_ref[count], sym_tst[count];
+        uint16_t cdf_init[17][CDF_SIZE(16)];
+        uint16_t cdf_ref[17][CDF_SIZE(16)], cdf_tst[17][CDF_SIZE(16)];
+        SVTRandom byte_gen(0, 255), size_gen(0, 16);
+
+        for (int run = 0; run < 10; ++run) {
+            for (int i = 0; i < size; ++i)
+                buf[i] = (uint8_t)byte_gen.random();
+            // 0 is an equiprobable literal, 1 is left out as it is no alphabet
+            for (int i = 0; i < count; ++i) {
+                const int s = size_gen.random();
+                sizes[i] = s == 1 ? 2 : s;
+            }
+            memset(cdf_init, 0, sizeof(cdf_init));
+            for (int nsyms = 2; nsyms <= 16; ++nsyms)
+                random_cdf(cdf_init[nsyms], nsyms);
+
+            memcpy(cdf_ref, cdf_init, sizeof(cdf_init));
+            svt_aom_setup_common_rtcd_internal(0);
+            decode(buf, size, sizes, count, cdf_ref, sym_ref);
+
+            memcpy(cdf_tst, cdf_init, sizeof(cdf_init));
+            svt_aom_setup_common_rtcd_internal(cpu_flags_);
+            decode(buf, size, sizes, count, cdf_tst, sym_tst);
+
+            for (int i = 0; i < count; ++i)
+                ASSERT_EQ(sym_ref[i], sym_tst[i])
+                    << "run " << run << " symbol " << i << " nsyms "
+                    << sizes[i];
+            ASSERT_EQ(0, memcmp(cdf_ref, cdf_tst, sizeof(cdf_ref)))
+                << "run " << run;
+        }
+    }
+
+    FindSymbolFunc find_func_;
+    UpdateCdfFunc update_func_;
+    uint64_t cpu_flags_;
+    SVTRandom rnd_;
+};
+
+TEST_P(EntropyDecoderTest, MatchKernels) {
+    run_kernel_test();
+}
+
+TEST_P(EntropyDecoderTest, MatchReader) {
+    run_reader_test();
+}
+
+INSTANTIATE_TEST_CASE_P(
+    SSE2, EntropyDecoderTest,
+    ::testing::Values(EntropyDecParam(svt_od_ec_find_symbol_sse2,
+                                      svt_od_ec_update_cdf_sse2,
+                                      EB_CPU_FLAGS_SSE2)));
+
+INSTANTIATE_TEST_CASE_P(
+    AVX2, EntropyDecoderTest,
+    ::testing::Values(EntropyDecParam(svt_od_ec_find_symbol_avx2,
+                                      svt_od_ec_update_cdf_avx2,
+                                      EB_CPU_FLAGS_AVX2)));
+
+}  // namespace
@@ -0,0 +1,220 @@
+/*
+ * Copyright(c) 2019 Intel Corporation
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file FilmGrainAsmTest.cc
+ *
+ * @brief Unit test for the film grain blending kernels:
+ * - svt_av1_fgn_add_noise_luma_avx2
+ * - svt_av1_fgn_add_noise_luma_hbd_avx2
+ * - svt_av1_fgn_add_noise_chroma_avx2
+ * - svt_av1_fgn_add_noise_chroma_hbd_avx2
+ *
+ * Test strategy:
+ * Check the kernels against their C versions on random samples, grain,
+ * scaling LUTs and blending constants, for every chroma subsampling and
+ * widths that are not multiples of the SIMD width.
+ *
+ ******************************************************************************/
+#include <string.h>
+#include "gtest/gtest.h"
+#include "EbDefinitions.h"
+#include "common_dsp_rtcd.h"
+#include "random.h"
+#include "util.h"
+
+using svt_av1_test_tool::SVTRandom;
+
+namespace {
+
+static const int kMaxWidth = 48;
+static const int kMaxHeight = 16;
+static const int kStride = 2 * kMaxWidth + 8;
+static const int kGrainStride = kMaxWidth + 3;
+
+class FilmGrainAsmTest : public ::testing::TestWithParam<int> {
+  public:
+    FilmGrainAsmTest() : bit_depth_(GetParam()), rnd_(0, 65535) {
+    }
+
+  protected:
+    int rand(int lo, int hi) {
+        return lo + (int)(rnd_.random() % (hi - lo + 1));
+    }
+
+    void prepare(FgnPlaneParams *pp, bool chroma) {
+        const int shift = bit_depth_ - 8;
+        const int max_pel = (256 << shift) - 1;
+        for (int i = 0; i < 256; ++i)
+            lut_[i] = rand(0, 255);
+        for (int i = 0; i < kMaxHeight * kGrainStride; ++i)
+            grain_[i] = rand(-(128 << shift), 127 << shift);
+        for (int i = 0; i < 2 * kMaxHeight * kStride; ++i) {
+            luma_[i] = (uint16_t)rand(0, max_pel);
+            chroma_ref_[i] = chroma_tst_[i] = (uint16_t)rand(0, max_pel);
+        }
+        pp->scaling_lut = lut_;
+        pp->scaling_shift = rand(8, 11);
+        if (rand(0, 1)) {
+            pp->min_val = 16 << shift;
+            pp->max_val = (chroma ? 240 : 235) << shift;
+        } else {
+            pp->min_val = 0;
+            pp->max_val = max_pel;
+        }
+        if (chroma && rand(0, 1)) {
+            // chroma_scaling_from_luma
+            pp->mult = 0;
+            pp->luma_mult = 64;
+            pp->offset = 0;
+        } else {
+            pp->mult = rand(0, 255) - 128;
+            pp->luma_mult = rand(0, 255) - 128;
+            pp->offset = (rand(0, 511) << shift) - (256 << shift);
+        }
+    }
+
+    void run_luma_test() {
+        FgnPlaneParams pp;
+        for (int iter = 0; iter < 2000; ++iter) {
+            prepare(&pp, false);
+            const int width = rand(1, kMaxWidth);
+            const int height = rand(1, kMaxHeight);
+            if (bit_depth_ == 8) {
+                uint8_t ref[kMaxHeight * kStride], tst[kMaxHeight * kStride];
+                for (int i = 0; i < kMaxHeight * kStride; ++i)
+                    ref[i] = tst[i] = (uint8_t)luma_[i];
+                svt_av1_fgn_add_noise_luma_c(
+                    ref, kStride, grain_, kGrainStride, width, height, &pp);
+                svt_av1_fgn_add_noise_luma_avx2(
+                    tst, kStride, grain_, kGrainStride, width, height, &pp);
+                ASSERT_EQ(0, memcmp(ref, tst, sizeof(ref)))
+                    << "width " << width << " height " << height;
+            } else {
+                svt_av1_fgn_add_noise_luma_hbd_c(chroma_ref_,
+                                                 kStride,
+                                                 grain_,
+                                                 kGrainStride,
+                                                 width,
+                                                 height,
+                                                 bit_depth_,
+                                                 &pp);
+                svt_av1_fgn_add_noise_luma_hbd_avx2(chroma_tst_,
+                                                    kStride,
+                                                    grain_,
+                                                    kGrainStride,
+                                                    width,
+                                                    height,
+                                                    bit_depth_,
+                                                    &pp);
+                ASSERT_EQ(0,
+                          memcmp(chroma_ref_, chroma_tst_, sizeof(chroma_ref_)))
+                    << "width " << width << " height " << height;
+            }
+        }
+    }
+
+    void run_chroma_test() {
+        // 4:2:0, 4:2:2 and 4:4:4
+        static const int subsamp[3][2] = {{1, 1}, {1, 0}, {0, 0}};
+        FgnPlaneParams pp;
+        for (int iter = 0; iter < 3000; ++iter) {
+            prepare(&pp, true);
+            const int ss_x = subsamp[iter % 3][0];
+            const int ss_y = subsamp[iter % 3][1];
+            const int width = rand(1, kMaxWidth);
+            const int height = rand(1, kMaxHeight);
+            if (bit_depth_ == 8) {
+                uint8_t luma[2 * kMaxHeight * kStride];
+                uint8_t ref[kMaxHeight * kStride], tst[kMaxHeight * kStride];
+                for (int i = 0; i < 2 * kMaxHeight * kStride; ++i)
+                    luma[i] = (uint8_t)luma_[i];
+                for (int i = 0; i < kMaxHeight * kStride; ++i)
+                    ref[i] = tst[i] = (uint8_t)chroma_ref_[i];
+                svt_av1_fgn_add_noise_chroma_c(ref,
+                                               kStride,
+                                               luma,
+                                               kStride,
+                                               grain_,
+                                               kGrainStride,
+                                               width,
+                                               height,
+                                               ss_x,
+                                               ss_y,
+                                               &pp);
+                svt_av1_fgn_add_noise_chroma_avx2(tst,
+                                                  kStride,
+                                                  luma,
+                                                  kStride,
+                                                  grain_,
+                                                  kGrainStride,
+                                                  width,
+                                                  height,
+                                                  ss_x,
+                                                  ss_y,
+                                                  &pp);
+                ASSERT_EQ(0, memcmp(ref, tst, sizeof(ref)))
+                    << "width " << width << " height " << height
+                    << " subsamp " << ss_x << ss_y;
+            } else {
+                svt_av1_fgn_add_noise_chroma_hbd_c(chroma_ref_,
+                                                   kStride,
+                                                   luma_,
+                                                   kStride,
+                                                   grain_,
+                                                   kGrainStride,
+                                                   width,
+                                                   height,
+                                                   ss_x,
+                                                   ss_y,
+                                                   bit_depth_,
+                                                   &pp);
+                svt_av1_fgn_add_noise_chroma_hbd_avx2(chroma_tst_,
+                                                      kStride,
+                                                      luma_,
+                                                      kStride,
+                                                      grain_,
+                                                      kGrainStride,
+                                                      width,
+                                                      height,
+                                                      ss_x,
+                                                      ss_y,
+                                                      bit_depth_,
+                                                      &pp);
+                ASSERT_EQ(0,
+                          memcmp(chroma_ref_, chroma_tst_, sizeof(chroma_ref_)))
+                    << "width " << width << " height " << height
+                    << " subsamp " << ss_x << ss_y;
+            }
+        }
+    }
+
+    int bit_depth_;
+    SVTRandom rnd_;
+    int32_t lut_[256];
+    int32_t grain_[kMaxHeight * kGrainStride];
+    uint16_t luma_[2 * kMaxHeight * kStride];
+    uint16_t chroma_ref_[2 * kMaxHeight * kStride];
+    uint16_t chroma_tst_[2 * kMaxHeight * kStride];
+};
+
+TEST_P(FilmGrainAsmTest, MatchLuma) {
+    run_luma_test();
+}
+
+TEST_P(FilmGrainAsmTest, MatchChroma) {
+    run_chroma_test();
+}
+
+INSTANTIATE_TEST_CASE_P(AVX2, FilmGrainAsmTest, ::testing::Values(8, 10, 12));
+
+}  // namespace
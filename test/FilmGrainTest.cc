@@ -271,6 +271,35 @@ TEST_F(AddFilmGrainTest, MatchTest) {
     }
 }
 
+// The block rows grained band by band, last band first, give the same
+// picture as the whole picture at once
+TEST_F(AddFilmGrainTest, MatchBandsTest) {
+    for (int i = 0; i < 3; ++i) {
+        FilmGrainSynth synth;
+        const int rows = svt_av1_film_grain_block_rows(kHeight);
+        for (int num_bands = 2; num_bands <= rows; ++num_bands) {
+            init_data();
+            svt_av1_film_grain_synth_init(
+                &synth, film_grain_test_vectors + i, 1, 1);
+            for (int band = num_bands - 1; band >= 0; --band)
+                svt_av1_add_film_grain_rows(&synth,
+                                            luma_,
+                                            cb_,
+                                            cr_,
+                                            kHeight,
+                                            kWidth,
+                                            kWidth,
+                                            kWidth / 2,
+                                            0,
+                                            rows * band / num_bands,
+                                            rows * (band + 1) / num_bands);
+            svt_av1_film_grain_synth_free(&synth);
+            check_output(i);
+            ASSERT_FALSE(HasFailure()) << "bands " << num_bands;
+        }
+    }
+}
+
 extern "C" {
 #include "EbPictureControlSet.h"
 #include "EbPictureBufferDesc.h"
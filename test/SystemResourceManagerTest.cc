@@ -0,0 +1,328 @@
+/*
+ * Copyright(c) 2019 Netflix, Inc.
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file SystemResourceManagerTest.cc
+ *
+ * @brief Unit test for the lock-free EbSystemResource queues:
+ * - svt_get_empty_object / svt_post_full_object
+ * - svt_get_full_object / svt_release_object
+ * - svt_shutdown_process
+ *
+ * The speed test compares them with the mutex and semaphore based queues
+ * they replaced.
+ *
+ ******************************************************************************/
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "EbSystemResourceManager.h"
+#include "EbThreads.h"
+#include "EbTime.h"
+
+namespace {
+
+typedef struct TestObject {
+    EbDctor  dctor;
+    uint32_t producer;
+    uint32_t sequence;
+} TestObject;
+
+static EbErrorType test_object_creator(EbPtr *object_dbl_ptr, EbPtr object_init_data_ptr) {
+    (void)object_init_data_ptr;
+    *object_dbl_ptr = calloc(1, sizeof(TestObject));
+    return *object_dbl_ptr ? EB_ErrorNone : EB_ErrorInsufficientResources;
+}
+
+static EbSystemResource *create_resource(uint32_t object_count, uint32_t producer_count,
+                                         uint32_t consumer_count) {
+    EbSystemResource *resource = (EbSystemResource *)calloc(1, sizeof(EbSystemResource));
+    if (svt_system_resource_ctor(
+            resource, object_count, producer_count, consumer_count, test_object_creator, NULL, NULL) !=
+        EB_ErrorNone) {
+        resource->dctor(resource);
+        free(resource);
+        return NULL;
+    }
+    return resource;
+}
+
+static void destroy_resource(EbSystemResource *resource) {
+    resource->dctor(resource);
+    free(resource);
+}
+
+/**
+ * @brief Mutex and semaphore based muxing queue, as used by the
+ * EbSystemResource before the lock-free queues. Only used as reference in
+ * the speed test.
+ */
+class LegacyQueue {
+  public:
+    LegacyQueue(uint32_t object_count, uint32_t process_count)
+        : objects_(object_count + 1), processes_(process_count + 1), fifos_(process_count) {
+        mutex_ = svt_create_mutex();
+        for (LegacyFifo &fifo : fifos_) {
+            fifo.mutex = svt_create_mutex();
+            fifo.semaphore = svt_create_semaphore(0, object_count + process_count);
+            fifo.quit = false;
+        }
+    }
+    ~LegacyQueue() {
+        for (LegacyFifo &fifo : fifos_) {
+            svt_destroy_semaphore(fifo.semaphore);
+            svt_destroy_mutex(fifo.mutex);
+        }
+        svt_destroy_mutex(mutex_);
+    }
+
+    void push(void *object) {
+        svt_block_on_mutex(mutex_);
+        objects_.push(object);
+        assign();
+        svt_release_mutex(mutex_);
+    }
+
+    // returns NULL once the process is shut down
+    void *pop(uint32_t process) {
+        LegacyFifo &fifo = fifos_[process];
+        svt_block_on_mutex(mutex_);
+        processes_.push(&fifo);
+        assign();
+        svt_release_mutex(mutex_);
+
+        svt_block_on_semaphore(fifo.semaphore);
+        svt_block_on_mutex(fifo.mutex);
+        void *object = NULL;
+        if (!fifo.quit) {
+            object = fifo.list.front();
+            fifo.list.erase(fifo.list.begin());
+        }
+        svt_release_mutex(fifo.mutex);
+        return object;
+    }
+
+    void shutdown() {
+        for (LegacyFifo &fifo : fifos_) {
+            svt_block_on_mutex(fifo.mutex);
+            fifo.quit = true;
+            svt_release_mutex(fifo.mutex);
+            svt_post_semaphore(fifo.semaphore);
+        }
+    }
+
+  private:
+    struct LegacyFifo {
+        EbHandle            mutex;
+        EbHandle            semaphore;
+        std::vector<void *> list;
+        bool                quit;
+    };
+
+    template <typename T>
+    struct Ring {
+        explicit Ring(size_t size) : array(size), head(0), tail(0) {
+        }
+        bool empty() const {
+            return head == tail;
+        }
+        void push(T v) {
+            array[tail] = v;
+            tail = (tail + 1) % array.size();
+        }
+        T pop() {
+            T v = array[head];
+            head = (head + 1) % array.size();
+            return v;
+        }
+        std::vector<T> array;
+        size_t         head, tail;
+    };
+
+    void assign() {
+        while (!objects_.empty() && !processes_.empty()) {
+            LegacyFifo *fifo = processes_.pop();
+            void *object = objects_.pop();
+            svt_block_on_mutex(fifo->mutex);
+            fifo->list.push_back(object);
+            svt_release_mutex(fifo->mutex);
+            svt_post_semaphore(fifo->semaphore);
+        }
+    }
+
+    EbHandle                mutex_;
+    Ring<void *>            objects_;
+    Ring<LegacyFifo *>      processes_;
+    std::vector<LegacyFifo> fifos_;
+};
+
+typedef std::tuple<uint32_t, /**< number of producer threads */
+                   uint32_t> /**< number of consumer threads */
+    SrmParam;
+
+static const uint32_t object_count = 16;
+
+/**
+ * @brief Moves objects from producer threads to consumer threads through an
+ * EbSystemResource, in the way of a pipeline stage: producers take empty
+ * objects and post them full, consumers take full objects and release them.
+ *
+ * Expected result:
+ * Every posted object is received exactly once and the objects of a
+ * producer come out in order when there is a single consumer; consumers
+ * quit on svt_shutdown_process and all objects are back in the empty queue.
+ *
+ * Test coverage:
+ * 1, 2, 4 and 8 producers and consumers
+ */
+class SystemResourceTest : public ::testing::TestWithParam<SrmParam> {
+  public:
+    SystemResourceTest()
+        : producer_count_(std::get<0>(GetParam())), consumer_count_(std::get<1>(GetParam())) {
+    }
+
+  protected:
+    double run_srm(uint32_t objects_per_producer, bool check) {
+        EbSystemResource *resource = create_resource(object_count, producer_count_, consumer_count_);
+        EXPECT_NE(resource, nullptr);
+        if (!resource)
+            return 0;
+
+        const uint64_t           total = (uint64_t)objects_per_producer * producer_count_;
+        std::atomic<uint64_t>    received(0);
+        std::atomic<uint64_t>    checksum(0);
+        std::atomic<uint32_t>    out_of_order(0);
+        std::vector<std::thread> threads;
+        uint64_t start_s, start_us, finish_s, finish_us;
+
+        svt_av1_get_time(&start_s, &start_us);
+        for (uint32_t c = 0; c < consumer_count_; c++) {
+            threads.emplace_back([&, c]() {
+                EbFifo *fifo = svt_system_resource_get_consumer_fifo(resource, c);
+                std::vector<uint32_t> next(producer_count_, 0);
+                for (;;) {
+                    EbObjectWrapper *wrapper;
+                    if (svt_get_full_object(fifo, &wrapper) == EB_NoErrorFifoShutdown)
+                        break;
+                    TestObject *obj = (TestObject *)wrapper->object_ptr;
+                    if (check) {
+                        if (obj->sequence < next[obj->producer])
+                            out_of_order++;
+                        next[obj->producer] = obj->sequence + 1;
+                        checksum += obj->sequence;
+                    }
+                    svt_release_object(wrapper);
+                    received++;
+                }
+            });
+        }
+        for (uint32_t p = 0; p < producer_count_; p++) {
+            threads.emplace_back([&, p]() {
+                EbFifo *fifo = svt_system_resource_get_producer_fifo(resource, p);
+                for (uint32_t i = 0; i < objects_per_producer; i++) {
+                    EbObjectWrapper *wrapper;
+                    svt_get_empty_object(fifo, &wrapper);
+                    TestObject *obj = (TestObject *)wrapper->object_ptr;
+                    obj->producer = p;
+                    obj->sequence = i;
+                    svt_post_full_object(wrapper);
+                }
+            });
+        }
+        while (received.load() < total) std::this_thread::yield();
+        svt_av1_get_time(&finish_s, &finish_us);
+
+        svt_shutdown_process(resource);
+        for (std::thread &t : threads) t.join();
+
+        if (check) {
+            EXPECT_EQ(received.load(), total);
+            EXPECT_EQ(checksum.load(),
+                      (uint64_t)producer_count_ * objects_per_producer * (objects_per_producer - 1) / 2);
+            if (consumer_count_ == 1)
+                EXPECT_EQ(out_of_order.load(), 0u);
+            // all the objects are back in the empty queue
+            EXPECT_EQ(resource->empty_queue->available, (int32_t)object_count);
+        }
+        destroy_resource(resource);
+        return svt_av1_compute_overall_elapsed_time_ms(start_s, start_us, finish_s, finish_us);
+    }
+
+    double run_legacy(uint32_t objects_per_producer) {
+        LegacyQueue              empty(object_count, producer_count_);
+        LegacyQueue              full(object_count, consumer_count_);
+        std::vector<TestObject>  objects(object_count);
+        const uint64_t           total = (uint64_t)objects_per_producer * producer_count_;
+        std::atomic<uint64_t>    received(0);
+        std::vector<std::thread> threads;
+        uint64_t start_s, start_us, finish_s, finish_us;
+
+        for (TestObject &obj : objects) empty.push(&obj);
+
+        svt_av1_get_time(&start_s, &start_us);
+        for (uint32_t c = 0; c < consumer_count_; c++) {
+            threads.emplace_back([&, c]() {
+                void *obj;
+                while ((obj = full.pop(c)) != NULL) {
+                    empty.push(obj);
+                    received++;
+                }
+            });
+        }
+        for (uint32_t p = 0; p < producer_count_; p++) {
+            threads.emplace_back([&, p]() {
+                for (uint32_t i = 0; i < objects_per_producer; i++) {
+                    TestObject *obj = (TestObject *)empty.pop(p);
+                    obj->producer = p;
+                    obj->sequence = i;
+                    full.push(obj);
+                }
+            });
+        }
+        while (received.load() < total) std::this_thread::yield();
+        svt_av1_get_time(&finish_s, &finish_us);
+
+        full.shutdown();
+        for (std::thread &t : threads) t.join();
+        return svt_av1_compute_overall_elapsed_time_ms(start_s, start_us, finish_s, finish_us);
+    }
+
+    const uint32_t producer_count_;
+    const uint32_t consumer_count_;
+};
+
+TEST_P(SystemResourceTest, PostAndGet) {
+    run_srm(20000, true);
+}
+
+TEST_P(SystemResourceTest, DISABLED_Speed) {
+    const uint32_t objects_per_producer = 200000;
+    const double   time_legacy = run_legacy(objects_per_producer);
+    const double   time_srm = run_srm(objects_per_producer, false);
+
+    printf("%u producers, %u consumers, %u objects\n",
+           producer_count_,
+           consumer_count_,
+           objects_per_producer * producer_count_);
+    printf("    mutex queues     : %8.2f ms\n", time_legacy);
+    printf("    lock-free queues : %8.2f ms   (Comparison: %5.2fx)\n",
+           time_srm,
+           time_legacy / time_srm);
+}
+
+INSTANTIATE_TEST_CASE_P(SRM, SystemResourceTest,
+                        ::testing::Combine(::testing::Values(1, 2, 4, 8),
+                                           ::testing::Values(1, 2, 4, 8)));
+
+}  // namespace
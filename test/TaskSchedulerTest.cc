@@ -0,0 +1,283 @@
+/*
+ * Copyright(c) 2019 Netflix, Inc.
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file TaskSchedulerTest.cc
+ *
+ * @brief Unit test for the task scheduler running the pipeline stages on a
+ * worker pool:
+ * - svt_task_scheduler_add_task_type / svt_task_scheduler_start
+ * - tasks blocking on their output, svt_task_scheduler_block_begin / end
+ * - svt_task_scheduler_share
+ *
+ ******************************************************************************/
+
+#include <atomic>
+#include <memory>
+#include <string.h>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "EbSystemResourceManager.h"
+#include "EbTaskScheduler.h"
+#include "EbThreads.h"
+
+namespace {
+
+typedef struct TestObject {
+    EbDctor  dctor;
+    uint32_t sequence;
+} TestObject;
+
+static EbErrorType test_object_creator(EbPtr *object_dbl_ptr, EbPtr object_init_data_ptr) {
+    (void)object_init_data_ptr;
+    *object_dbl_ptr = calloc(1, sizeof(TestObject));
+    return *object_dbl_ptr ? EB_ErrorNone : EB_ErrorInsufficientResources;
+}
+
+static EbErrorType create_worker_thread(EbHandle *thread_handle, void *thread_function(void *),
+                                        void *thread_context) {
+    *thread_handle = svt_create_thread(thread_function, thread_context);
+    return *thread_handle ? EB_ErrorNone : EB_ErrorInsufficientResources;
+}
+
+// Objects of the stage inputs, few enough for the tasks to block on their output
+static const uint32_t object_count = 2;
+
+/**
+ * @brief A pipeline of stage_count task types run by one scheduler. The
+ * input of each stage is an EbSystemResource whose producers are the
+ * contexts of the previous stage, the last stage counts the objects.
+ */
+class TestPipeline {
+  public:
+    struct StageContext {
+        TestPipeline     *pipeline;
+        EbFifo           *output_fifo; /**< NULL in the last stage */
+        std::atomic<bool> busy;
+    };
+
+    TestPipeline(uint32_t stage_count, uint32_t context_count)
+        : stage_count_(stage_count),
+          context_count_(context_count),
+          scheduler_(nullptr),
+          received_(0),
+          checksum_(0),
+          overlaps_(0) {
+    }
+
+    ~TestPipeline() {
+        stop();
+        for (EbSystemResource *resource : resources_) {
+            resource->dctor(resource);
+            free(resource);
+        }
+    }
+
+    /** Creates the stages, the pool workers are created by start */
+    EbErrorType init(uint32_t worker_count) {
+        scheduler_ = (EbTaskScheduler *)calloc(1, sizeof(EbTaskScheduler));
+        if (!scheduler_)
+            return EB_ErrorInsufficientResources;
+        EbErrorType return_error = svt_task_scheduler_ctor(scheduler_, worker_count, stage_count_);
+        for (uint32_t stage = 0; stage < stage_count_ && return_error == EB_ErrorNone; stage++) {
+            EbSystemResource *resource = (EbSystemResource *)calloc(1, sizeof(EbSystemResource));
+            if (!resource)
+                return EB_ErrorInsufficientResources;
+            resources_.push_back(resource);
+            return_error = svt_system_resource_ctor(
+                resource, object_count, stage ? context_count_ : 1, 1, test_object_creator, NULL, NULL);
+        }
+        for (uint32_t stage = 0; stage < stage_count_ && return_error == EB_ErrorNone; stage++) {
+            contexts_.emplace_back(new StageContext[context_count_]);
+            context_ptrs_.emplace_back(context_count_);
+            for (uint32_t c = 0; c < context_count_; c++) {
+                StageContext *context = &contexts_[stage][c];
+                context->pipeline = this;
+                context->output_fifo = stage + 1 < stage_count_
+                    ? svt_system_resource_get_producer_fifo(resources_[stage + 1], c)
+                    : NULL;
+                context->busy = false;
+                context_ptrs_[stage][c] = context;
+            }
+            return_error = svt_task_scheduler_add_task_type(
+                scheduler_, resources_[stage], stage_task, context_ptrs_[stage].data(), context_count_);
+        }
+        return return_error;
+    }
+
+    /** Posts the objects to the first stage, from the calling thread */
+    void feed(uint32_t count) {
+        EbFifo *fifo = svt_system_resource_get_producer_fifo(resources_[0], 0);
+        for (uint32_t i = 0; i < count; i++) {
+            EbObjectWrapper *wrapper;
+            svt_get_empty_object(fifo, &wrapper);
+            ((TestObject *)wrapper->object_ptr)->sequence = i;
+            svt_post_full_object(wrapper);
+        }
+    }
+
+    /** Waits for the count objects fed to come out of the last stage */
+    void wait(uint32_t count) {
+        while (received_.load() < count) std::this_thread::yield();
+    }
+
+    /** Detaches the scheduler from its pool once its tasks in flight return */
+    void stop() {
+        if (scheduler_) {
+            scheduler_->dctor(scheduler_);
+            free(scheduler_);
+            scheduler_ = nullptr;
+        }
+    }
+
+    /** Expects each object once out of the last stage, the contexts run by
+     * one worker at a time and all the objects back in the empty queues,
+     * once stopped */
+    void check(uint32_t count) {
+        EXPECT_EQ(received_.load(), count);
+        EXPECT_EQ(checksum_.load(), (uint64_t)count * (count - 1) / 2);
+        EXPECT_EQ(overlaps_.load(), 0u);
+        for (EbSystemResource *resource : resources_)
+            EXPECT_EQ(resource->empty_queue->available, (int32_t)object_count);
+    }
+
+    EbTaskScheduler *scheduler() {
+        return scheduler_;
+    }
+
+  private:
+    static void stage_task(void *context_ptr, EbObjectWrapper *wrapper_ptr) {
+        StageContext *context = (StageContext *)context_ptr;
+        TestPipeline *pipeline = context->pipeline;
+        const uint32_t sequence = ((TestObject *)wrapper_ptr->object_ptr)->sequence;
+
+        if (context->busy.exchange(true))
+            pipeline->overlaps_++;
+        if (context->output_fifo) {
+            // blocks until the next stage releases one of its inputs
+            EbObjectWrapper *output_ptr;
+            svt_get_empty_object(context->output_fifo, &output_ptr);
+            ((TestObject *)output_ptr->object_ptr)->sequence = sequence;
+            svt_post_full_object(output_ptr);
+        } else {
+            pipeline->checksum_ += sequence;
+            pipeline->received_++;
+        }
+        context->busy = false;
+        svt_release_object(wrapper_ptr);
+    }
+
+    const uint32_t                                stage_count_;
+    const uint32_t                                context_count_;
+    EbTaskScheduler                              *scheduler_;
+    std::vector<EbSystemResource *>               resources_;
+    std::vector<std::unique_ptr<StageContext[]>>  contexts_;
+    std::vector<std::vector<EbPtr>>               context_ptrs_;
+    std::atomic<uint64_t>                         received_;
+    std::atomic<uint64_t>                         checksum_;
+    std::atomic<uint32_t>                         overlaps_;
+};
+
+typedef std::tuple<uint32_t, /**< number of workers */
+                   uint32_t> /**< number of contexts per stage */
+    TaskSchedulerParam;
+
+static const uint32_t stage_count = 4;
+static const uint32_t objects_per_pipeline = 5000;
+
+/**
+ * @brief Runs pipelines of stage_count task types on the worker pool of a
+ * scheduler, or on a pool shared by two schedulers. The stage inputs only
+ * have object_count objects, so the tasks block on their output and the
+ * blocked workers hand their slot over to other workers.
+ *
+ * Expected result:
+ * Every object goes through all the stages exactly once without deadlock,
+ * a context is never run by two workers at a time, and all the objects are
+ * back in the empty queues.
+ *
+ * Test coverage:
+ * 1, 2 and 4 workers, 1 and 3 contexts per stage
+ */
+class TaskSchedulerTest : public ::testing::TestWithParam<TaskSchedulerParam> {
+  public:
+    TaskSchedulerTest()
+        : worker_count_(std::get<0>(GetParam())), context_count_(std::get<1>(GetParam())) {
+    }
+
+  protected:
+    const uint32_t worker_count_;
+    const uint32_t context_count_;
+};
+
+TEST_P(TaskSchedulerTest, RunStages) {
+    TestPipeline pipeline(stage_count, context_count_);
+    ASSERT_EQ(pipeline.init(worker_count_), EB_ErrorNone);
+    ASSERT_EQ(svt_task_scheduler_start(pipeline.scheduler(), create_worker_thread), EB_ErrorNone);
+
+    pipeline.feed(objects_per_pipeline);
+    pipeline.wait(objects_per_pipeline);
+    pipeline.stop();
+    pipeline.check(objects_per_pipeline);
+}
+
+TEST_P(TaskSchedulerTest, SharedPool) {
+    TestPipeline first(stage_count, context_count_);
+    TestPipeline second(stage_count, context_count_);
+    ASSERT_EQ(first.init(worker_count_), EB_ErrorNone);
+    ASSERT_EQ(second.init(worker_count_), EB_ErrorNone);
+    svt_task_scheduler_share(first.scheduler(), 1, worker_count_);
+    svt_task_scheduler_share(second.scheduler(), 4, worker_count_);
+    ASSERT_EQ(svt_task_scheduler_start(first.scheduler(), create_worker_thread), EB_ErrorNone);
+    ASSERT_EQ(svt_task_scheduler_start(second.scheduler(), create_worker_thread), EB_ErrorNone);
+    // a single pool runs the tasks of both schedulers
+    EXPECT_EQ(first.scheduler()->pool_ptr, second.scheduler()->pool_ptr);
+
+    std::thread feeder([&]() { second.feed(objects_per_pipeline); });
+    first.feed(objects_per_pipeline);
+    feeder.join();
+    first.wait(objects_per_pipeline);
+    second.wait(objects_per_pipeline);
+    second.stop();
+    first.stop();
+    first.check(objects_per_pipeline);
+    second.check(objects_per_pipeline);
+}
+
+TEST(TaskSchedulerSetupTest, RejectsInvalidTaskTypes) {
+    TestPipeline pipeline(1, 1);
+    ASSERT_EQ(pipeline.init(1), EB_ErrorNone);
+    EbPtr            context = NULL;
+    EbSystemResource resource;
+    memset(&resource, 0, sizeof(resource));
+    ASSERT_EQ(svt_system_resource_ctor(&resource, object_count, 1, 1, test_object_creator, NULL, NULL),
+              EB_ErrorNone);
+
+    // no room left for a task type, and a task type without context
+    EXPECT_EQ(svt_task_scheduler_add_task_type(pipeline.scheduler(), &resource, NULL, &context, 1),
+              EB_ErrorBadParameter);
+    EbTaskScheduler *scheduler = (EbTaskScheduler *)calloc(1, sizeof(EbTaskScheduler));
+    ASSERT_EQ(svt_task_scheduler_ctor(scheduler, 1, 1), EB_ErrorNone);
+    EXPECT_EQ(svt_task_scheduler_add_task_type(scheduler, &resource, NULL, &context, 0), EB_ErrorBadParameter);
+    // nothing to run, and an affinity on an input that is not a task type one
+    EXPECT_EQ(svt_task_scheduler_start(scheduler, create_worker_thread), EB_ErrorBadParameter);
+    EXPECT_EQ(svt_task_scheduler_set_affinity(scheduler, &resource, NULL), EB_ErrorBadParameter);
+    scheduler->dctor(scheduler);
+    free(scheduler);
+    resource.dctor(&resource);
+}
+
+INSTANTIATE_TEST_CASE_P(TaskScheduler, TaskSchedulerTest,
+                        ::testing::Combine(::testing::Values(1, 2, 4), ::testing::Values(1, 3)));
+
+}  // namespace
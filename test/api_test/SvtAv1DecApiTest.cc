@@ -0,0 +1,554 @@
+/*
+ * Copyright(c) 2019 Netflix, Inc.
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file SvtAv1DecApiTest.cc
+ *
+ * @brief SVT-AV1 decoder api test, check the output modes against the copy
+ * output
+ *
+ ******************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include <map>
+#include <vector>
+#include "EbSvtAv1Dec.h"
+#include "gtest/gtest.h"
+#include "SvtAv1TestStream.h"
+
+using namespace svt_av1_test;
+
+namespace {
+
+const uint32_t test_width = 176;
+const uint32_t test_height = 144;
+const uint32_t test_pictures = 24;
+
+/** DecodedPicture holds the visible samples of a picture, plane after plane */
+typedef std::vector<uint8_t> DecodedPicture;
+
+static DecodedPicture read_picture(const EbSvtIOFormat *picture) {
+    const uint32_t bytes = picture->bit_depth == EB_EIGHT_BIT ? 1 : 2;
+    const uint32_t chroma_w = (picture->width + 1) >> 1;
+    const uint32_t chroma_h = (picture->height + 1) >> 1;
+    DecodedPicture samples;
+
+    for (uint32_t y = 0; y < picture->height; y++) {
+        const uint8_t *row = picture->luma + y * picture->y_stride * bytes;
+        samples.insert(samples.end(), row, row + picture->width * bytes);
+    }
+    for (uint32_t y = 0; y < chroma_h; y++) {
+        const uint8_t *row = picture->cb + y * picture->cb_stride * bytes;
+        samples.insert(samples.end(), row, row + chroma_w * bytes);
+    }
+    for (uint32_t y = 0; y < chroma_h; y++) {
+        const uint8_t *row = picture->cr + y * picture->cr_stride * bytes;
+        samples.insert(samples.end(), row, row + chroma_w * bytes);
+    }
+    return samples;
+}
+
+/** FrameBufferPool is the external frame buffer allocator of the tests, it
+ * tracks the buffers the decoder holds */
+typedef struct {
+    /** buffers allocated and not released, and their size */
+    std::map<uint8_t *, uint32_t> live;
+    uint32_t num_alloc;
+    uint32_t num_bad_release; /**< releases of unknown buffers */
+    bool fail; /**< fail the allocations */
+    uint32_t shortfall; /**< bytes missing from the allocated buffers */
+} FrameBufferPool;
+
+static int allocate_frame_buffer(EbExtFrameBuf *frame_buf, uint32_t min_size,
+                                 void *private_data) {
+    FrameBufferPool *pool = (FrameBufferPool *)private_data;
+    if (pool->fail)
+        return -1;
+    frame_buf->buffer = (uint8_t *)malloc(min_size);
+    if (frame_buf->buffer == nullptr)
+        return -1;
+    frame_buf->buffer_size = min_size - pool->shortfall;
+    frame_buf->private_data = pool;
+    pool->live[frame_buf->buffer] = min_size;
+    pool->num_alloc++;
+    return 0;
+}
+
+static int release_frame_buffer(EbExtFrameBuf *frame_buf, void *private_data) {
+    FrameBufferPool *pool = (FrameBufferPool *)private_data;
+    if (frame_buf->private_data != pool ||
+        pool->live.erase(frame_buf->buffer) == 0) {
+        pool->num_bad_release++;
+        return -1;
+    }
+    free(frame_buf->buffer);
+    return 0;
+}
+
+/** Returns true if the planes of the picture lie in a buffer of the pool */
+static bool in_frame_buffer(const FrameBufferPool *pool,
+                            const EbSvtIOFormat *picture) {
+    for (auto &buffer : pool->live) {
+        uint8_t *end = buffer.first + buffer.second;
+        if (picture->luma >= buffer.first && picture->luma < end &&
+            picture->cb >= buffer.first && picture->cb < end &&
+            picture->cr >= buffer.first && picture->cr < end)
+            return true;
+    }
+    return false;
+}
+
+/** DecTestParam is the threading and pipeline setup of the decoder */
+typedef struct {
+    uint32_t num_p_frames;
+    Bool is_16bit_pipeline;
+} DecTestParam;
+
+/** DecOutputTest decodes the same stream in copy output mode and in the
+ * mode under test and compares the pictures
+ */
+class DecOutputTest : public ::testing::TestWithParam<DecTestParam> {
+  public:
+    static void SetUpTestCase() {
+        stream_ = new TestStream;
+        ASSERT_EQ(EB_ErrorNone,
+                  encode_test_stream(
+                      test_width, test_height, test_pictures, stream_));
+        ASSERT_FALSE(stream_->empty());
+    }
+
+    static void TearDownTestCase() {
+        delete stream_;
+        stream_ = nullptr;
+    }
+
+  protected:
+    void SetUp() override {
+        handle_ = nullptr;
+        pool_.live.clear();
+        pool_.num_alloc = 0;
+        pool_.num_bad_release = 0;
+        pool_.fail = false;
+        pool_.shortfall = 0;
+        use_pool_ = false;
+    }
+
+    void TearDown() override {
+        if (handle_ != nullptr)
+            deinit_decoder();
+        // buffers refused by the decoder
+        for (auto &buffer : pool_.live) free(buffer.first);
+    }
+
+    /** Creates the decoder under test, with the decoders of the same process
+     * created one at a time */
+    void init_decoder(Bool zero_copy_output) {
+        ASSERT_EQ(EB_ErrorNone,
+                  svt_av1_dec_init_handle(&handle_, nullptr, &config_));
+        config_.max_picture_width = test_width;
+        config_.max_picture_height = test_height;
+        config_.num_p_frames = GetParam().num_p_frames;
+        config_.is_16bit_pipeline = GetParam().is_16bit_pipeline;
+        config_.zero_copy_output = zero_copy_output;
+        if (use_pool_) {
+            config_.allocate_frame_buffer = allocate_frame_buffer;
+            config_.release_frame_buffer = release_frame_buffer;
+            config_.frame_buffer_priv = &pool_;
+        }
+        ASSERT_EQ(EB_ErrorNone, svt_av1_dec_set_parameter(handle_, &config_));
+        ASSERT_EQ(EB_ErrorNone, svt_av1_dec_init(handle_));
+    }
+
+    void deinit_decoder() {
+        EXPECT_EQ(EB_ErrorNone, svt_av1_dec_deinit(handle_));
+        EXPECT_EQ(EB_ErrorNone, svt_av1_dec_deinit_handle(handle_));
+        handle_ = nullptr;
+    }
+
+    /** Decodes temporal unit tu, the flush of frame parallel decoding once
+     * tu reaches the size of the stream */
+    EbErrorType decode_tu(size_t tu) {
+        if (tu < stream_->size())
+            return svt_av1_dec_frame(
+                handle_, (*stream_)[tu].data(), (*stream_)[tu].size(), 0);
+        return svt_av1_dec_frame(handle_, nullptr, 0, 0);
+    }
+
+    size_t num_tus() const {
+        return stream_->size() + (config_.num_p_frames > 1 ? 1 : 0);
+    }
+
+    EbErrorType get_picture(EbBufferHeaderType *header,
+                            EbSvtIOFormat *picture) {
+        EbAV1StreamInfo stream_info;
+        EbAV1FrameInfo frame_info;
+        memset(header, 0, sizeof(*header));
+        header->size = sizeof(*header);
+        header->p_buffer = (uint8_t *)picture;
+        return svt_av1_dec_get_picture(
+            handle_, header, &stream_info, &frame_info);
+    }
+
+    /** Reference pictures, decoded in copy output mode with the decoder
+     * allocating the pictures */
+    void decode_reference(std::vector<DecodedPicture> *pictures) {
+        const bool use_pool = use_pool_;
+        use_pool_ = false;
+        init_decoder(FALSE);
+        use_pool_ = use_pool;
+        EbSvtIOFormat picture;
+        memset(&picture, 0, sizeof(picture));
+        for (size_t tu = 0; tu < num_tus(); tu++) {
+            ASSERT_EQ(EB_ErrorNone, decode_tu(tu));
+            EbBufferHeaderType header;
+            if (get_picture(&header, &picture) == EB_ErrorNone)
+                pictures->push_back(read_picture(&picture));
+        }
+        free(picture.luma);
+        free(picture.cb);
+        free(picture.cr);
+        deinit_decoder();
+        ASSERT_EQ(test_pictures, pictures->size());
+    }
+
+    static TestStream *stream_;
+    EbComponentType *handle_;
+    EbSvtAv1DecConfiguration config_;
+    FrameBufferPool pool_;
+    bool use_pool_; /**< allocate the pictures with pool_ */
+};
+
+TestStream *DecOutputTest::stream_ = nullptr;
+
+/** @brief zero_copy_output_matches_copy is a api test case
+ * DecOutputTest.zero_copy_output_matches_copy checks the pictures returned
+ * in zero copy output mode
+ *
+ * Test strategy: <br>
+ * Decode the stream in zero copy output mode, releasing each picture once it
+ * is read. <br>
+ *
+ * Expected result: <br>
+ * The pictures are the ones of the copy output mode. <br>
+ *
+ * Test coverage:
+ * svt_av1_dec_get_picture, svt_av1_dec_release_picture.
+ */
+TEST_P(DecOutputTest, zero_copy_output_matches_copy) {
+    std::vector<DecodedPicture> reference;
+    decode_reference(&reference);
+
+    init_decoder(TRUE);
+    size_t num_out = 0;
+    for (size_t tu = 0; tu < num_tus(); tu++) {
+        ASSERT_EQ(EB_ErrorNone, decode_tu(tu));
+        EbBufferHeaderType header;
+        EbSvtIOFormat picture;
+        memset(&picture, 0, sizeof(picture));
+        EbErrorType ret = get_picture(&header, &picture);
+        if (ret == EB_DecNoOutputPicture)
+            continue;
+        ASSERT_EQ(EB_ErrorNone, ret);
+        ASSERT_LT(num_out, reference.size());
+        EXPECT_TRUE(read_picture(&picture) == reference[num_out])
+            << "picture " << num_out << " differs from the copy output";
+        num_out++;
+        ASSERT_EQ(EB_ErrorNone, svt_av1_dec_release_picture(handle_, &header));
+        EXPECT_EQ(nullptr, header.wrapper_ptr);
+    }
+    EXPECT_EQ(reference.size(), num_out);
+}
+
+/** @brief held_pictures_limit is a api test case
+ * DecOutputTest.held_pictures_limit checks that the application can hold up
+ * to SVT_AV1_DEC_MAX_HELD_PICTURES pictures and release them in any order
+ *
+ * Test strategy: <br>
+ * Decode the stream in zero copy output mode, holding the pictures until the
+ * limit is reached, then release one of the held pictures, alternately the
+ * oldest, the newest and one in between, and get the picture again. Release
+ * the last held pictures newest first. <br>
+ *
+ * Expected result: <br>
+ * svt_av1_dec_get_picture returns EB_ErrorInsufficientResources while the
+ * limit is reached, and the picture once one is released. The held pictures
+ * are not overwritten by the decoding of the next ones. <br>
+ *
+ * Test coverage:
+ * svt_av1_dec_get_picture, svt_av1_dec_release_picture.
+ */
+TEST_P(DecOutputTest, held_pictures_limit) {
+    std::vector<DecodedPicture> reference;
+    decode_reference(&reference);
+
+    init_decoder(TRUE);
+
+    struct HeldPicture {
+        EbBufferHeaderType header;
+        EbSvtIOFormat picture;
+        size_t index;
+    };
+    std::vector<HeldPicture *> held;
+    size_t num_out = 0, num_rejected = 0;
+
+    auto release = [&](size_t pos) {
+        HeldPicture *pic = held[pos];
+        EXPECT_TRUE(read_picture(&pic->picture) == reference[pic->index])
+            << "held picture " << pic->index << " was overwritten";
+        EXPECT_EQ(EB_ErrorNone,
+                  svt_av1_dec_release_picture(handle_, &pic->header));
+        held.erase(held.begin() + pos);
+        delete pic;
+    };
+
+    for (size_t tu = 0; tu < num_tus(); tu++) {
+        ASSERT_EQ(EB_ErrorNone, decode_tu(tu));
+        HeldPicture *pic = new HeldPicture;
+        memset(&pic->picture, 0, sizeof(pic->picture));
+        EbErrorType ret = get_picture(&pic->header, &pic->picture);
+        if (ret == EB_ErrorInsufficientResources) {
+            ASSERT_EQ((size_t)SVT_AV1_DEC_MAX_HELD_PICTURES, held.size());
+            const size_t order[3] = {
+                0, held.size() - 1, held.size() / 2};
+            release(order[num_rejected++ % 3]);
+            ret = get_picture(&pic->header, &pic->picture);
+        }
+        if (ret == EB_DecNoOutputPicture) {
+            delete pic;
+            continue;
+        }
+        ASSERT_EQ(EB_ErrorNone, ret);
+        ASSERT_LT(num_out, reference.size());
+        pic->index = num_out++;
+        held.push_back(pic);
+    }
+    while (!held.empty()) release(held.size() - 1);
+
+    EXPECT_EQ(reference.size(), num_out);
+    EXPECT_GT(num_rejected, 0u);
+}
+
+/** @brief release_invalid_picture is a api test case
+ * DecOutputTest.release_invalid_picture checks the pictures
+ * svt_av1_dec_release_picture rejects
+ *
+ * Test strategy: <br>
+ * Release a header without picture, release a picture twice, and release a
+ * picture of a decoder in copy output mode. <br>
+ *
+ * Expected result: <br>
+ * svt_av1_dec_release_picture returns EB_ErrorBadParameter. <br>
+ *
+ * Test coverage:
+ * svt_av1_dec_release_picture.
+ */
+TEST_P(DecOutputTest, release_invalid_picture) {
+    init_decoder(TRUE);
+
+    EbBufferHeaderType header;
+    EbSvtIOFormat picture;
+    memset(&picture, 0, sizeof(picture));
+    memset(&header, 0, sizeof(header));
+    EXPECT_EQ(EB_ErrorBadParameter,
+              svt_av1_dec_release_picture(handle_, &header));
+    EXPECT_EQ(EB_ErrorBadParameter,
+              svt_av1_dec_release_picture(handle_, nullptr));
+
+    EbErrorType ret = EB_DecNoOutputPicture;
+    for (size_t tu = 0; tu < num_tus() && ret == EB_DecNoOutputPicture; tu++) {
+        ASSERT_EQ(EB_ErrorNone, decode_tu(tu));
+        ret = get_picture(&header, &picture);
+    }
+    ASSERT_EQ(EB_ErrorNone, ret);
+    EbBufferHeaderType copy = header;
+    EXPECT_EQ(EB_ErrorNone, svt_av1_dec_release_picture(handle_, &header));
+    EXPECT_EQ(EB_ErrorBadParameter,
+              svt_av1_dec_release_picture(handle_, &header));
+    EXPECT_EQ(EB_ErrorBadParameter,
+              svt_av1_dec_release_picture(handle_, &copy));
+
+    // copy output mode: there is no picture to release
+    deinit_decoder();
+    init_decoder(FALSE);
+    ASSERT_EQ(EB_ErrorNone, decode_tu(0));
+    EXPECT_EQ(EB_ErrorBadParameter,
+              svt_av1_dec_release_picture(handle_, &copy));
+}
+
+/** @brief frame_buffers_match_copy is a api test case
+ * DecOutputTest.frame_buffers_match_copy checks the decoding into frame
+ * buffers of the application
+ *
+ * Test strategy: <br>
+ * Decode the stream with the external frame buffer callbacks set, in copy
+ * output mode. <br>
+ *
+ * Expected result: <br>
+ * The pictures are the ones decoded into pictures allocated by the decoder.
+ * Each frame buffer is released once, and all of them are released at
+ * deinit. <br>
+ *
+ * Test coverage:
+ * allocate_frame_buffer, release_frame_buffer.
+ */
+TEST_P(DecOutputTest, frame_buffers_match_copy) {
+    std::vector<DecodedPicture> reference;
+    decode_reference(&reference);
+
+    use_pool_ = true;
+    init_decoder(FALSE);
+    EbSvtIOFormat picture;
+    memset(&picture, 0, sizeof(picture));
+    size_t num_out = 0;
+    for (size_t tu = 0; tu < num_tus(); tu++) {
+        ASSERT_EQ(EB_ErrorNone, decode_tu(tu));
+        EbBufferHeaderType header;
+        EbErrorType ret = get_picture(&header, &picture);
+        if (ret == EB_DecNoOutputPicture)
+            continue;
+        ASSERT_EQ(EB_ErrorNone, ret);
+        ASSERT_LT(num_out, reference.size());
+        EXPECT_TRUE(read_picture(&picture) == reference[num_out])
+            << "picture " << num_out << " differs from the decoder pictures";
+        num_out++;
+    }
+    free(picture.luma);
+    free(picture.cb);
+    free(picture.cr);
+    EXPECT_EQ(reference.size(), num_out);
+    EXPECT_GE(pool_.num_alloc, num_out);
+
+    deinit_decoder();
+    EXPECT_TRUE(pool_.live.empty());
+    EXPECT_EQ(0u, pool_.num_bad_release);
+}
+
+/** @brief frame_buffers_held_pictures is a api test case
+ * DecOutputTest.frame_buffers_held_pictures checks that the frame buffers of
+ * the pictures held in zero copy output mode are kept
+ *
+ * Test strategy: <br>
+ * Decode the stream with the external frame buffer callbacks set, in zero
+ * copy output mode, holding SVT_AV1_DEC_MAX_HELD_PICTURES pictures and
+ * releasing the oldest. <br>
+ *
+ * Expected result: <br>
+ * The planes of the held pictures lie in frame buffers not released yet, and
+ * the pictures are the ones decoded into pictures allocated by the decoder.
+ * All the frame buffers are released at deinit. <br>
+ *
+ * Test coverage:
+ * allocate_frame_buffer, release_frame_buffer, svt_av1_dec_release_picture.
+ */
+TEST_P(DecOutputTest, frame_buffers_held_pictures) {
+    std::vector<DecodedPicture> reference;
+    decode_reference(&reference);
+
+    use_pool_ = true;
+    init_decoder(TRUE);
+    struct HeldPicture {
+        EbBufferHeaderType header;
+        EbSvtIOFormat picture;
+        size_t index;
+    };
+    std::vector<HeldPicture> held;
+    size_t num_out = 0;
+    for (size_t tu = 0; tu < num_tus(); tu++) {
+        ASSERT_EQ(EB_ErrorNone, decode_tu(tu));
+        for (HeldPicture &pic : held) {
+            EXPECT_TRUE(GetParam().is_16bit_pipeline ||
+                        in_frame_buffer(&pool_, &pic.picture))
+                << "frame buffer of held picture " << pic.index
+                << " released";
+            EXPECT_TRUE(read_picture(&pic.picture) == reference[pic.index])
+                << "held picture " << pic.index << " was overwritten";
+        }
+        if (held.size() == SVT_AV1_DEC_MAX_HELD_PICTURES) {
+            EXPECT_EQ(EB_ErrorNone,
+                      svt_av1_dec_release_picture(handle_, &held[0].header));
+            held.erase(held.begin());
+        }
+        HeldPicture pic;
+        memset(&pic.picture, 0, sizeof(pic.picture));
+        EbErrorType ret = get_picture(&pic.header, &pic.picture);
+        if (ret == EB_DecNoOutputPicture)
+            continue;
+        ASSERT_EQ(EB_ErrorNone, ret);
+        ASSERT_LT(num_out, reference.size());
+        pic.index = num_out++;
+        held.push_back(pic);
+    }
+    for (HeldPicture &pic : held)
+        EXPECT_EQ(EB_ErrorNone,
+                  svt_av1_dec_release_picture(handle_, &pic.header));
+    EXPECT_EQ(reference.size(), num_out);
+
+    deinit_decoder();
+    EXPECT_TRUE(pool_.live.empty());
+    EXPECT_EQ(0u, pool_.num_bad_release);
+}
+
+/** @brief frame_buffer_allocation_failure is a api test case
+ * DecOutputTest.frame_buffer_allocation_failure checks the frame buffers
+ * the decoder refuses
+ *
+ * Test strategy: <br>
+ * Set only one of the external frame buffer callbacks, then both, then decode
+ * with an allocator failing, and with an allocator returning buffers smaller than
+ * requested. <br>
+ *
+ * Expected result: <br>
+ * svt_av1_dec_set_parameter returns EB_ErrorBadParameter for a single
+ * callback and accepts both on the same handle, svt_av1_dec_frame returns EB_ErrorInsufficientResources when no
+ * frame buffer is available. <br>
+ *
+ * Test coverage:
+ * svt_av1_dec_set_parameter, svt_av1_dec_frame, allocate_frame_buffer.
+ */
+TEST_P(DecOutputTest, frame_buffer_allocation_failure) {
+    ASSERT_EQ(EB_ErrorNone,
+              svt_av1_dec_init_handle(&handle_, nullptr, &config_));
+    config_.allocate_frame_buffer = allocate_frame_buffer;
+    config_.frame_buffer_priv = &pool_;
+    EXPECT_EQ(EB_ErrorBadParameter,
+              svt_av1_dec_set_parameter(handle_, &config_));
+    // the handle stays usable once both callbacks are set
+    config_.release_frame_buffer = release_frame_buffer;
+    ASSERT_EQ(EB_ErrorNone, svt_av1_dec_set_parameter(handle_, &config_));
+    ASSERT_EQ(EB_ErrorNone, svt_av1_dec_init(handle_));
+    EXPECT_EQ(EB_ErrorNone, decode_tu(0));
+    deinit_decoder();
+    EXPECT_TRUE(pool_.live.empty());
+    pool_.num_alloc = 0;
+
+    use_pool_ = true;
+    pool_.fail = true;
+    init_decoder(FALSE);
+    EXPECT_EQ(EB_ErrorInsufficientResources, decode_tu(0));
+    deinit_decoder();
+    EXPECT_EQ(0u, pool_.num_alloc);
+
+    pool_.fail = false;
+    pool_.shortfall = 1;
+    init_decoder(FALSE);
+    EXPECT_EQ(EB_ErrorInsufficientResources, decode_tu(0));
+    deinit_decoder();
+    EXPECT_EQ(0u, pool_.num_bad_release);
+}
+
+static const DecTestParam dec_test_params[] = {
+    {1, FALSE}, {1, TRUE}, {2, FALSE}};
+
+INSTANTIATE_TEST_CASE_P(DecApiTest, DecOutputTest,
+                        ::testing::ValuesIn(dec_test_params));
+
+}  // namespace
@@ -13,14 +13,20 @@
 /******************************************************************************
  * @file SvtAv1EncApiTest.cc
  *
- * @brief SVT-AV1 encoder api test, check invalid input
+ * @brief SVT-AV1 encoder api test, check invalid input and the zero copy
+ * input against the copy input
  *
  * @author Cidana-Edmond, Cidana-Ryan, Cidana-Wenyao
  *
  ******************************************************************************/
+#include <string.h>
+#include <algorithm>
+#include <mutex>
+#include <vector>
 #include "EbSvtAv1Enc.h"
 #include "gtest/gtest.h"
 #include "SvtAv1EncApiTest.h"
+#include "SvtAv1TestStream.h"
 
 using namespace svt_av1_test;
 
@@ -203,4 +209,255 @@ TEST(EncApiTest, DISABLED_repeat_normal_setup) {
     }
 }
 
+const uint32_t test_width = 176;
+const uint32_t test_height = 144;
+const uint32_t test_pictures = 24;
+
+/** ZeroCopyInput owns the bordered planes of the pictures sent in zero copy
+ * input mode and records the pictures the encoder hands back */
+typedef struct {
+    std::vector<std::vector<uint8_t>> buffers; /**< one per picture */
+    std::vector<EbSvtIOFormat> pictures; /**< planes sent, indexed by pts */
+    std::vector<int64_t> released; /**< pts, in release order */
+    uint32_t num_bad_release; /**< releases of planes never sent */
+    std::mutex mutex; /**< the encoder threads release the pictures */
+} ZeroCopyInput;
+
+static void release_input_picture(void *priv, EbBufferHeaderType *header) {
+    ZeroCopyInput *input = (ZeroCopyInput *)priv;
+    const EbSvtIOFormat *planes = (const EbSvtIOFormat *)header->p_buffer;
+    std::lock_guard<std::mutex> lock(input->mutex);
+
+    if (header->pts < 0 || (size_t)header->pts >= input->pictures.size()) {
+        input->num_bad_release++;
+        return;
+    }
+    EbSvtIOFormat *sent = &input->pictures[(size_t)header->pts];
+    if (planes->luma != sent->luma || planes->cb != sent->cb ||
+        planes->cr != sent->cr || planes->y_stride != sent->y_stride ||
+        planes->cb_stride != sent->cb_stride ||
+        planes->cr_stride != sent->cr_stride) {
+        input->num_bad_release++;
+        return;
+    }
+    input->released.push_back(header->pts);
+    // the encoder must not read the planes any more
+    std::vector<uint8_t> &buffer = input->buffers[(size_t)header->pts];
+    memset(buffer.data(), 0x55, buffer.size());
+}
+
+/** EncZeroCopyInputTest encodes the synthetic source in zero copy input mode
+ * and compares the stream against the copy input
+ */
+class EncZeroCopyInputTest : public ::testing::Test {
+  public:
+    static void SetUpTestCase() {
+        stream_ = new TestStream;
+        ASSERT_EQ(EB_ErrorNone,
+                  encode_test_stream(
+                      test_width, test_height, test_pictures, stream_));
+        ASSERT_FALSE(stream_->empty());
+    }
+
+    static void TearDownTestCase() {
+        delete stream_;
+        stream_ = nullptr;
+    }
+
+  protected:
+    void SetUp() override {
+        handle_ = nullptr;
+        input_.num_bad_release = 0;
+    }
+
+    void TearDown() override {
+        if (handle_ != nullptr)
+            deinit_encoder();
+    }
+
+    /** Creates the encoder with the setup of encode_test_stream */
+    void init_encoder() {
+        memset(&config_, 0, sizeof(config_));
+        ASSERT_EQ(EB_ErrorNone,
+                  svt_av1_enc_init_handle(&handle_, nullptr, &config_));
+        config_.source_width = test_width;
+        config_.source_height = test_height;
+        config_.enc_mode = 12;
+        config_.zero_copy_input = TRUE;
+        config_.release_input_picture = release_input_picture;
+        config_.release_input_picture_priv = &input_;
+        ASSERT_EQ(EB_ErrorNone, svt_av1_enc_set_parameter(handle_, &config_));
+        ASSERT_EQ(EB_ErrorNone, svt_av1_enc_init(handle_));
+    }
+
+    void deinit_encoder() {
+        EXPECT_EQ(EB_ErrorNone, svt_av1_enc_deinit(handle_));
+        EXPECT_EQ(EB_ErrorNone, svt_av1_enc_deinit_handle(handle_));
+        handle_ = nullptr;
+    }
+
+    /** Allocates the planes of picture index surrounded by a border of
+     * border luma samples, returns them in picture */
+    void alloc_picture(uint32_t index, uint32_t border,
+                       EbSvtIOFormat *picture) {
+        const uint32_t y_stride = test_width + 2 * border;
+        const uint32_t c_stride = y_stride >> 1;
+        const uint32_t luma_size = y_stride * (test_height + 2 * border);
+        const uint32_t chroma_size = c_stride * ((test_height >> 1) + border);
+        std::vector<uint8_t> &buffer = input_.buffers[index];
+
+        buffer.assign(luma_size + 2 * chroma_size, 0);
+        memset(picture, 0, sizeof(*picture));
+        picture->luma = buffer.data() + border * y_stride + border;
+        picture->cb = buffer.data() + luma_size + (border >> 1) * c_stride +
+                      (border >> 1);
+        picture->cr = picture->cb + chroma_size;
+        picture->y_stride = y_stride;
+        picture->cb_stride = c_stride;
+        picture->cr_stride = c_stride;
+        picture->width = test_width;
+        picture->height = test_height;
+        picture->color_fmt = EB_YUV420;
+        picture->bit_depth = EB_EIGHT_BIT;
+    }
+
+    EbErrorType send_picture(EbSvtIOFormat *picture, int64_t pts) {
+        EbBufferHeaderType header;
+        memset(&header, 0, sizeof(header));
+        header.size = sizeof(header);
+        header.pic_type = EB_AV1_INVALID_PICTURE;
+        header.p_buffer = (uint8_t *)picture;
+        header.pts = pts;
+        return svt_av1_enc_send_picture(handle_, &header);
+    }
+
+    /** Sends the end of stream and reads the packets up to it */
+    void flush(TestStream *stream) {
+        EbBufferHeaderType header;
+        memset(&header, 0, sizeof(header));
+        header.size = sizeof(header);
+        header.pic_type = EB_AV1_INVALID_PICTURE;
+        header.flags = EB_BUFFERFLAG_EOS;
+        ASSERT_EQ(EB_ErrorNone, svt_av1_enc_send_picture(handle_, &header));
+        for (bool eos = false; !eos;) {
+            EbBufferHeaderType *packet = nullptr;
+            ASSERT_EQ(EB_ErrorNone,
+                      svt_av1_enc_get_packet(handle_, &packet, 1));
+            eos = (packet->flags & EB_BUFFERFLAG_EOS) != 0;
+            if (packet->n_filled_len)
+                stream->emplace_back(packet->p_buffer,
+                                     packet->p_buffer + packet->n_filled_len);
+            svt_av1_enc_release_out_buffer(&packet);
+        }
+    }
+
+    static TestStream *stream_;
+    EbComponentType *handle_;
+    EbSvtAv1EncConfiguration config_;
+    ZeroCopyInput input_;
+};
+
+TestStream *EncZeroCopyInputTest::stream_ = nullptr;
+
+/** @brief zero_copy_input_matches_copy is a api test case
+ * EncZeroCopyInputTest.zero_copy_input_matches_copy checks the stream encoded
+ * from wrapped input pictures and the release of the pictures
+ *
+ * Test strategy: <br>
+ * Encode the synthetic source from planes with the smallest border allowed,
+ * overwrite the planes of each picture once it is released. <br>
+ *
+ * Expected result: <br>
+ * The stream matches the copy input stream, every picture is released once
+ * with the planes and the pts it was sent with, and all of them are released
+ * once the encoder is deinitialized. <br>
+ *
+ * Test coverage:
+ * svt_av1_enc_send_picture, release_input_picture.
+ */
+TEST_F(EncZeroCopyInputTest, zero_copy_input_matches_copy) {
+    init_encoder();
+    input_.buffers.resize(test_pictures);
+    input_.pictures.resize(test_pictures);
+    for (uint32_t i = 0; i < test_pictures; i++) {
+        alloc_picture(i, SVT_AV1_ENC_INPUT_BORDER, &input_.pictures[i]);
+        fill_test_picture(i, test_width, test_height, &input_.pictures[i]);
+    }
+    for (uint32_t i = 0; i < test_pictures; i++)
+        ASSERT_EQ(EB_ErrorNone, send_picture(&input_.pictures[i], i));
+
+    TestStream stream;
+    flush(&stream);
+    deinit_encoder();
+
+    EXPECT_EQ(0u, input_.num_bad_release);
+    std::vector<int64_t> released = input_.released;
+    std::sort(released.begin(), released.end());
+    ASSERT_EQ(test_pictures, released.size());
+    for (uint32_t i = 0; i < test_pictures; i++)
+        EXPECT_EQ((int64_t)i, released[i]) << "picture " << i;
+    EXPECT_TRUE(stream == *stream_);
+}
+
+/** @brief invalid_planes_rejected is a api test case
+ * EncZeroCopyInputTest.invalid_planes_rejected checks the wrapped input
+ * pictures the encoder refuses
+ *
+ * Test strategy: <br>
+ * Send pictures with a missing plane, a border smaller than
+ * SVT_AV1_ENC_INPUT_BORDER, different chroma strides or a stride too large,
+ * then a valid picture. <br>
+ *
+ * Expected result: <br>
+ * svt_av1_enc_send_picture returns EB_ErrorBadParameter without keeping the
+ * invalid pictures, and encodes the valid picture. <br>
+ *
+ * Test coverage:
+ * svt_av1_enc_send_picture, svt_av1_enc_set_parameter.
+ */
+TEST_F(EncZeroCopyInputTest, invalid_planes_rejected) {
+    // zero copy input needs the release callback
+    memset(&config_, 0, sizeof(config_));
+    ASSERT_EQ(EB_ErrorNone,
+              svt_av1_enc_init_handle(&handle_, nullptr, &config_));
+    config_.source_width = test_width;
+    config_.source_height = test_height;
+    config_.zero_copy_input = TRUE;
+    EXPECT_EQ(EB_ErrorBadParameter,
+              svt_av1_enc_set_parameter(handle_, &config_));
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_deinit_handle(handle_));
+    handle_ = nullptr;
+
+    init_encoder();
+    input_.buffers.resize(2);
+    input_.pictures.resize(1);
+    EbSvtIOFormat &valid = input_.pictures[0];
+    alloc_picture(0, SVT_AV1_ENC_INPUT_BORDER, &valid);
+    fill_test_picture(0, test_width, test_height, &valid);
+
+    EbSvtIOFormat picture = valid;
+    picture.cb = nullptr;
+    EXPECT_EQ(EB_ErrorBadParameter, send_picture(&picture, 0));
+    picture = valid;
+    picture.cr_stride += 2;
+    EXPECT_EQ(EB_ErrorBadParameter, send_picture(&picture, 0));
+    picture = valid;
+    picture.cb_stride = picture.cr_stride = (valid.y_stride >> 1) - 2;
+    EXPECT_EQ(EB_ErrorBadParameter, send_picture(&picture, 0));
+    picture = valid;
+    picture.y_stride = UINT16_MAX + 1;
+    EXPECT_EQ(EB_ErrorBadParameter, send_picture(&picture, 0));
+    alloc_picture(1, SVT_AV1_ENC_INPUT_BORDER - 16, &picture);
+    EXPECT_EQ(EB_ErrorBadParameter, send_picture(&picture, 0));
+
+    EXPECT_EQ(EB_ErrorNone, send_picture(&valid, 0));
+    TestStream stream;
+    flush(&stream);
+    deinit_encoder();
+    EXPECT_FALSE(stream.empty());
+    EXPECT_EQ(0u, input_.num_bad_release);
+    ASSERT_EQ(1u, input_.released.size());
+    EXPECT_EQ(0, input_.released[0]);
+}
+
 }  // namespace
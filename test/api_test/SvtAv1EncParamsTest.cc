@@ -131,6 +131,9 @@ class EncParamTestBase : public ::testing::Test {
             }
         } else if (!param_name_str_.compare("target_bit_rate")) {
             ctxt_.enc_params.rate_control_mode = SVT_AV1_RC_MODE_VBR;
+        } else if (!param_name_str_.compare("thread_pool_weight")) {
+            /** the weight is only used by the shared thread pool */
+            ctxt_.enc_params.shared_thread_pool = TRUE;
         }
     }
 
@@ -139,9 +142,19 @@ class EncParamTestBase : public ::testing::Test {
     std::string param_name_str_; /**< name of parameter for test */
 };
 
+/** Printable value of a parameter, strings are printed as is */
+template <typename T>
+static int param_value(T p) {
+    return (int)p;
+}
+static const char *param_value(const char *p) {
+    return p ? p : "NULL";
+}
+
 /** Marcro defininition of printing parameter name when in failed */
-#define PRINT_PARAM_FATAL(p) \
-    << "svt_av1_enc_set_parameter " << #p << ": " << (int)(p) << " failed"
+#define PRINT_PARAM_FATAL(p)                                        \
+    << "svt_av1_enc_set_parameter " << #p << ": " << param_value(p) \
+    << " failed"
 
 /** Marcro defininition of printing 2 parameters name when in failed */
 #define PRINT_2PARAM_FATAL(p1, p2)                                       \
@@ -357,4 +370,53 @@ PARAM_TEST(EncParamTransferCharacteristicsTest);
 DEFINE_PARAM_TEST_CLASS(EncParamMatrixCoefficientsTest, matrix_coefficients);
 PARAM_TEST(EncParamMatrixCoefficientsTest);
 
+/** Test case for zero_copy_input*/
+DEFINE_PARAM_TEST_CLASS(EncParamZeroCopyInputTest, zero_copy_input);
+PARAM_TEST(EncParamZeroCopyInputTest);
+
+/** Test case for pipeline_trace_file*/
+DEFINE_PARAM_TEST_CLASS(EncParamPipelineTraceFileTest, pipeline_trace_file);
+PARAM_TEST(EncParamPipelineTraceFileTest);
+
+/** Test case for enable_tile_group_output*/
+DEFINE_PARAM_TEST_CLASS(EncParamTileGroupOutputTest, enable_tile_group_output);
+PARAM_TEST(EncParamTileGroupOutputTest);
+
+/** Test case for shared_thread_pool*/
+DEFINE_PARAM_TEST_CLASS(EncParamSharedThreadPoolTest, shared_thread_pool);
+PARAM_TEST(EncParamSharedThreadPoolTest);
+
+/** Test case for thread_pool_weight*/
+DEFINE_PARAM_TEST_CLASS(EncParamThreadPoolWeightTest, thread_pool_weight);
+PARAM_TEST(EncParamThreadPoolWeightTest);
+
+/** Test case for thread_pool_workers*/
+DEFINE_PARAM_TEST_CLASS(EncParamThreadPoolWorkersTest, thread_pool_workers);
+PARAM_TEST(EncParamThreadPoolWorkersTest);
+
+/** Test case for ladder_group*/
+DEFINE_PARAM_TEST_CLASS(EncParamLadderGroupTest, ladder_group);
+PARAM_TEST(EncParamLadderGroupTest);
+
+/** Test case for ladder_leader*/
+DEFINE_PARAM_TEST_CLASS(EncParamLadderLeaderTest, ladder_leader);
+PARAM_TEST(EncParamLadderLeaderTest);
+
+/** Test case for cache_domain_placement*/
+DEFINE_PARAM_TEST_CLASS(EncParamCacheDomainPlacementTest,
+                        cache_domain_placement);
+PARAM_TEST(EncParamCacheDomainPlacementTest);
+
+/** Test case for numa_picture_pools*/
+DEFINE_PARAM_TEST_CLASS(EncParamNumaPicturePoolsTest, numa_picture_pools);
+PARAM_TEST(EncParamNumaPicturePoolsTest);
+
+/** Test case for rc_stats_chunk_start*/
+DEFINE_PARAM_TEST_CLASS(EncParamRcStatsChunkStartTest, rc_stats_chunk_start);
+PARAM_TEST(EncParamRcStatsChunkStartTest);
+
+/** Test case for rc_stats_chunk_frames*/
+DEFINE_PARAM_TEST_CLASS(EncParamRcStatsChunkFramesTest, rc_stats_chunk_frames);
+PARAM_TEST(EncParamRcStatsChunkFramesTest);
+
 }  // namespace
@@ -0,0 +1,114 @@
+/*
+ * Copyright(c) 2019 Netflix, Inc.
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file SvtAv1TestStream.cc
+ *
+ * @brief Synthetic source pictures and AV1 streams for the api tests.
+ *
+ ******************************************************************************/
+#include <string.h>
+#include "SvtAv1TestStream.h"
+
+namespace svt_av1_test {
+
+void fill_test_picture(uint32_t index, uint32_t width, uint32_t height,
+                       EbSvtIOFormat *picture) {
+    const uint32_t square = width / 4;
+    const uint32_t sq_x = (index * 3) % (width - square);
+    const uint32_t sq_y = (index * 2) % (height - square);
+
+    for (uint32_t y = 0; y < height; y++) {
+        uint8_t *row = picture->luma + y * picture->y_stride;
+        for (uint32_t x = 0; x < width; x++) {
+            const bool in_square = x >= sq_x && x < sq_x + square &&
+                                   y >= sq_y && y < sq_y + square;
+            row[x] = in_square ? (uint8_t)(200 - ((x - sq_x) ^ (y - sq_y)))
+                               : (uint8_t)((x + y + index) & 0x7f);
+        }
+    }
+    for (uint32_t y = 0; y < height / 2; y++) {
+        uint8_t *cb_row = picture->cb + y * picture->cb_stride;
+        uint8_t *cr_row = picture->cr + y * picture->cr_stride;
+        for (uint32_t x = 0; x < width / 2; x++) {
+            cb_row[x] = (uint8_t)(96 + ((x + index) & 0x3f));
+            cr_row[x] = (uint8_t)(160 - ((y + index) & 0x3f));
+        }
+    }
+}
+
+EbErrorType encode_test_stream(uint32_t width, uint32_t height,
+                               uint32_t num_pictures, TestStream *stream) {
+    EbComponentType *handle = nullptr;
+    EbSvtAv1EncConfiguration config;
+    memset(&config, 0, sizeof(config));
+    EbErrorType ret = svt_av1_enc_init_handle(&handle, nullptr, &config);
+    if (ret != EB_ErrorNone)
+        return ret;
+    config.source_width = width;
+    config.source_height = height;
+    config.enc_mode = 12;
+    ret = svt_av1_enc_set_parameter(handle, &config);
+    if (ret == EB_ErrorNone)
+        ret = svt_av1_enc_init(handle);
+    if (ret != EB_ErrorNone) {
+        svt_av1_enc_deinit_handle(handle);
+        return ret;
+    }
+
+    std::vector<uint8_t> planes(width * height * 3 / 2);
+    EbSvtIOFormat picture;
+    memset(&picture, 0, sizeof(picture));
+    picture.luma = planes.data();
+    picture.cb = picture.luma + width * height;
+    picture.cr = picture.cb + width * height / 4;
+    picture.y_stride = width;
+    picture.cb_stride = width / 2;
+    picture.cr_stride = width / 2;
+    picture.width = width;
+    picture.height = height;
+    picture.color_fmt = EB_YUV420;
+    picture.bit_depth = EB_EIGHT_BIT;
+
+    for (uint32_t i = 0; i <= num_pictures && ret == EB_ErrorNone; i++) {
+        EbBufferHeaderType header;
+        memset(&header, 0, sizeof(header));
+        header.size = sizeof(header);
+        header.pic_type = EB_AV1_INVALID_PICTURE;
+        if (i < num_pictures) {
+            fill_test_picture(i, width, height, &picture);
+            header.p_buffer = (uint8_t *)&picture;
+            header.n_filled_len = (uint32_t)planes.size();
+            header.pts = i;
+        } else
+            header.flags = EB_BUFFERFLAG_EOS;
+        ret = svt_av1_enc_send_picture(handle, &header);
+    }
+
+    for (bool eos = false; !eos && ret == EB_ErrorNone;) {
+        EbBufferHeaderType *packet = nullptr;
+        ret = svt_av1_enc_get_packet(handle, &packet, 1);
+        if (ret != EB_ErrorNone)
+            break;
+        eos = (packet->flags & EB_BUFFERFLAG_EOS) != 0;
+        if (packet->n_filled_len)
+            stream->emplace_back(packet->p_buffer,
+                                 packet->p_buffer + packet->n_filled_len);
+        svt_av1_enc_release_out_buffer(&packet);
+    }
+
+    EbErrorType deinit_ret = svt_av1_enc_deinit(handle);
+    svt_av1_enc_deinit_handle(handle);
+    return ret != EB_ErrorNone ? ret : deinit_ret;
+}
+
+}  // namespace svt_av1_test
@@ -0,0 +1,43 @@
+/*
+ * Copyright(c) 2019 Netflix, Inc.
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file SvtAv1TestStream.h
+ *
+ * @brief Synthetic source pictures and AV1 streams for the api tests.
+ *
+ ******************************************************************************/
+#ifndef _SVT_AV1_TEST_STREAM_H_
+#define _SVT_AV1_TEST_STREAM_H_
+
+#include <stdint.h>
+#include <vector>
+#include "EbSvtAv1Enc.h"
+
+namespace svt_av1_test {
+
+/** TestStream holds the temporal units of an encoded stream */
+typedef std::vector<std::vector<uint8_t>> TestStream;
+
+/** Fills the planes of picture index of a synthetic 8-bit 4:2:0 source, made
+ * of gradients and a square moving from one picture to the next */
+void fill_test_picture(uint32_t index, uint32_t width, uint32_t height,
+                       EbSvtIOFormat *picture);
+
+/** Encodes num_pictures pictures of the synthetic source at preset 12 into
+ * stream, returns EB_ErrorNone on success */
+EbErrorType encode_test_stream(uint32_t width, uint32_t height,
+                               uint32_t num_pictures, TestStream *stream);
+
+}  // namespace svt_av1_test
+
+#endif  // _SVT_AV1_TEST_STREAM_H_
@@ -1015,6 +1015,148 @@ static const vector<EbMatrixCoefficients> invalid_matrix_coefficients = {
     EB_CICP_MC_IDENTITY,  // not actually invalid, but requires 4:4:4
 };
 
+/* Zero copy input
+ */
+static const vector<Bool> default_zero_copy_input = {
+    FALSE,
+};
+static const vector<Bool> valid_zero_copy_input = {
+    FALSE,
+};
+static const vector<Bool> invalid_zero_copy_input = {
+    TRUE,  // not actually invalid, but requires a release_input_picture
+};
+
+/* Pipeline trace file
+ */
+static const vector<const char *> default_pipeline_trace_file = {
+    NULL,
+};
+static const vector<const char *> valid_pipeline_trace_file = {
+    NULL,
+    "pipeline_trace.json",
+};
+static const vector<const char *> invalid_pipeline_trace_file = {/*none*/};
+
+/* Tile group output
+ */
+static const vector<Bool> default_enable_tile_group_output = {
+    FALSE,
+};
+static const vector<Bool> valid_enable_tile_group_output = {
+    FALSE,
+};
+static const vector<Bool> invalid_enable_tile_group_output = {
+    TRUE,  // not actually invalid, but requires the low delay structure
+};
+
+/* Shared thread pool
+ */
+static const vector<Bool> default_shared_thread_pool = {
+    FALSE,
+};
+static const vector<Bool> valid_shared_thread_pool = {
+    FALSE,
+    TRUE,
+};
+static const vector<Bool> invalid_shared_thread_pool = {/*none*/};
+
+/* Thread pool weight, checked with the shared thread pool enabled
+ */
+static const vector<uint32_t> default_thread_pool_weight = {
+    1,
+};
+static const vector<uint32_t> valid_thread_pool_weight = {
+    1,
+    4,
+    64,
+};
+static const vector<uint32_t> invalid_thread_pool_weight = {
+    0,
+    65,
+};
+
+/* Thread pool workers
+ */
+static const vector<uint32_t> default_thread_pool_workers = {
+    0,
+};
+static const vector<uint32_t> valid_thread_pool_workers = {
+    0,
+    1,
+    16,
+};
+static const vector<uint32_t> invalid_thread_pool_workers = {/*none*/};
+
+/* Ladder group
+ */
+static const vector<uint32_t> default_ladder_group = {
+    0,
+};
+static const vector<uint32_t> valid_ladder_group = {
+    0,
+    1,
+    100,
+};
+static const vector<uint32_t> invalid_ladder_group = {/*none*/};
+
+/* Ladder leader
+ */
+static const vector<Bool> default_ladder_leader = {
+    FALSE,
+};
+static const vector<Bool> valid_ladder_leader = {
+    FALSE,
+};
+static const vector<Bool> invalid_ladder_leader = {
+    TRUE,  // not actually invalid, but requires a ladder group
+};
+
+/* Cache domain placement
+ */
+static const vector<Bool> default_cache_domain_placement = {
+    FALSE,
+};
+static const vector<Bool> valid_cache_domain_placement = {
+    FALSE,
+    TRUE,
+};
+static const vector<Bool> invalid_cache_domain_placement = {/*none*/};
+
+/* NUMA picture pools
+ */
+static const vector<Bool> default_numa_picture_pools = {
+    FALSE,
+};
+static const vector<Bool> valid_numa_picture_pools = {
+    FALSE,
+    TRUE,
+};
+static const vector<Bool> invalid_numa_picture_pools = {/*none*/};
+
+/* First frame of the chunk of a chunked two-pass encode
+ */
+static const vector<uint32_t> default_rc_stats_chunk_start = {
+    0,
+};
+static const vector<uint32_t> valid_rc_stats_chunk_start = {
+    0,
+    100,
+};
+static const vector<uint32_t> invalid_rc_stats_chunk_start = {/*none*/};
+
+/* Frames of the chunk of a chunked two-pass encode
+ */
+static const vector<uint32_t> default_rc_stats_chunk_frames = {
+    0,
+};
+static const vector<uint32_t> valid_rc_stats_chunk_frames = {
+    0,
+};
+static const vector<uint32_t> invalid_rc_stats_chunk_frames = {
+    30,  // not actually invalid, but requires the first-pass statistics
+};
+
 }  // namespace svt_av1_test_params
 
 /** @} */  // end of svt_av1_test_params